@@ -0,0 +1,98 @@
+using System;
+using System.IO;
+using System.Security.Cryptography;
+using System.Threading.Tasks;
+using BenchmarkDotNet.Attributes;
+
+namespace SlimLO.Benchmarks;
+
+/// <summary>
+/// One small document converted through a worker process against the same
+/// conversion in-process. BenchmarkDotNet runs every case in its own process,
+/// so each gets a fresh LibreOffice (one in-process instance per process).
+/// </summary>
+[MemoryDiagnoser]
+public class InProcessBenchmarks
+{
+    private byte[] _docx = Array.Empty<byte>();
+    private PdfConverter? _worker;
+    private InProcessConverter? _inProcess;
+
+    [GlobalSetup(Targets = new[] { nameof(Worker_Buffer), nameof(Worker_Pooled) })]
+    public async Task SetupWorker()
+    {
+        _docx = LoadDocument();
+        _worker = PdfConverter.Create(new PdfConverterOptions { WarmUp = true });
+        // First conversion loads fonts and filters; keep it out of the measurements
+        (await _worker.ConvertAsync(_docx, DocumentFormat.Docx)).ThrowIfFailed();
+    }
+
+    [GlobalSetup(Targets = new[] { nameof(InProcess_Buffer), nameof(InProcess_Pooled), nameof(InProcess_Borrowed) })]
+    public async Task SetupInProcess()
+    {
+        _docx = LoadDocument();
+        _inProcess = InProcessConverter.Create();
+        (await _inProcess.ConvertAsync(_docx, DocumentFormat.Docx)).ThrowIfFailed();
+    }
+
+    [GlobalCleanup]
+    public void Cleanup()
+    {
+        _worker?.Dispose();
+        _inProcess?.Dispose();
+    }
+
+    [Benchmark(Baseline = true)]
+    public async Task<int> Worker_Buffer()
+    {
+        var result = await _worker!.ConvertAsync(_docx, DocumentFormat.Docx);
+        return result.Data!.Length;
+    }
+
+    [Benchmark]
+    public async Task<int> Worker_Pooled()
+    {
+        var result = await _worker!.ConvertToPooledAsync(_docx, DocumentFormat.Docx);
+        using var pdf = result.Data!;
+        return pdf.Memory.Length;
+    }
+
+    [Benchmark]
+    public async Task<int> InProcess_Buffer()
+    {
+        var result = await _inProcess!.ConvertAsync(_docx, DocumentFormat.Docx);
+        return result.Data!.Length;
+    }
+
+    [Benchmark]
+    public async Task<int> InProcess_Pooled()
+    {
+        var result = await _inProcess!.ConvertToPooledAsync(_docx, DocumentFormat.Docx);
+        using var pdf = result.Data!;
+        return pdf.Memory.Length;
+    }
+
+    /// <summary>Hashes the PDF where LibreOffice wrote it: no managed copy of the PDF.</summary>
+    [Benchmark]
+    public async Task<int> InProcess_Borrowed()
+    {
+        var result = await _inProcess!.ConvertAsync(
+            _docx, DocumentFormat.Docx, pdf => SHA256.HashData(pdf)[0]);
+        return result.Data;
+    }
+
+    private static byte[] LoadDocument()
+    {
+        var path = Environment.GetEnvironmentVariable("SLIMLO_BENCH_DOCX");
+        if (string.IsNullOrEmpty(path))
+        {
+            var dir = AppContext.BaseDirectory;
+            while (dir != null && !File.Exists(Path.Combine(dir, "tests", "fixtures", "rich_formatting.docx")))
+                dir = Path.GetDirectoryName(dir);
+            path = dir != null
+                ? Path.Combine(dir, "tests", "fixtures", "rich_formatting.docx")
+                : throw new FileNotFoundException("Set SLIMLO_BENCH_DOCX to the document to convert.");
+        }
+        return File.ReadAllBytes(path);
+    }
+}
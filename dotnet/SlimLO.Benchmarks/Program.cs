@@ -0,0 +1,13 @@
+using BenchmarkDotNet.Running;
+
+namespace SlimLO.Benchmarks;
+
+// dotnet run -c Release -- --filter '*'
+// Needs SLIMLO_RESOURCE_PATH (and SLIMLO_WORKER_PATH for the worker cases);
+// SLIMLO_BENCH_DOCX picks the document (default: tests/fixtures/rich_formatting.docx).
+// The *Simulated* suites need only SLIMLO_WORKER_PATH: their workers run with SLIMLO_SIMULATE.
+public static class Program
+{
+    public static void Main(string[] args) =>
+        BenchmarkSwitcher.FromAssembly(typeof(Program).Assembly).Run(args);
+}
@@ -0,0 +1,148 @@
+using System;
+using System.Buffers;
+using System.IO;
+using System.Threading.Tasks;
+using BenchmarkDotNet.Attributes;
+
+namespace SlimLO.Benchmarks;
+
+/// <summary>
+/// Workers started with SLIMLO_SIMULATE: the full worker protocol with no
+/// LibreOffice behind it, so these suites run without a LibreOffice build and
+/// measure the SDK rather than the conversion.
+/// </summary>
+internal static class Simulation
+{
+    /// <summary>Set before the first worker starts; workers inherit the environment.</summary>
+    public static PdfConverter CreateConverter(string defaultSpec, int maxWorkers)
+    {
+        var spec = Environment.GetEnvironmentVariable("SLIMLO_BENCH_SIMULATE");
+        Environment.SetEnvironmentVariable("SLIMLO_SIMULATE", string.IsNullOrEmpty(spec) ? defaultSpec : spec);
+
+        return PdfConverter.Create(new PdfConverterOptions
+        {
+            // The simulated worker never opens the resource directory
+            ResourcePath = Environment.GetEnvironmentVariable("SLIMLO_RESOURCE_PATH") ?? Path.GetTempPath(),
+            MaxWorkers = maxWorkers,
+            MinWorkers = maxWorkers,
+            WarmUp = true,
+        });
+    }
+
+    /// <summary>Input bytes; the simulated worker only needs them to be non-empty.</summary>
+    public static byte[] Document(int size)
+    {
+        var data = new byte[size];
+        new Random(42).NextBytes(data);
+        return data;
+    }
+}
+
+/// <summary>
+/// Per-request SDK cost: one worker, no simulated latency, so the time and
+/// allocations measured are dispatch, framing and result handling alone.
+/// </summary>
+[MemoryDiagnoser]
+public class SimulatedOverheadBenchmarks
+{
+    private byte[] _docx = Array.Empty<byte>();
+    private PdfConverter? _converter;
+    private ArrayBufferWriter<byte>? _writer;
+
+    /// <summary>PDF size the simulated worker returns, in bytes.</summary>
+    [Params(4 * 1024, 256 * 1024, 4 * 1024 * 1024)]
+    public int PdfSize { get; set; }
+
+    [GlobalSetup]
+    public async Task Setup()
+    {
+        _docx = Simulation.Document(16 * 1024);
+        _converter = Simulation.CreateConverter($"latency=0,size={PdfSize}", maxWorkers: 1);
+        _writer = new ArrayBufferWriter<byte>(PdfSize);
+        (await _converter.ConvertAsync(_docx, DocumentFormat.Docx)).ThrowIfFailed();
+    }
+
+    [GlobalCleanup]
+    public void Cleanup() => _converter?.Dispose();
+
+    [Benchmark(Baseline = true)]
+    public async Task<int> Buffer()
+    {
+        var result = await _converter!.ConvertAsync(_docx, DocumentFormat.Docx);
+        return result.Data!.Length;
+    }
+
+    [Benchmark]
+    public async Task<int> Pooled()
+    {
+        var result = await _converter!.ConvertToPooledAsync(_docx, DocumentFormat.Docx);
+        using var pdf = result.Data!;
+        return pdf.Memory.Length;
+    }
+
+    /// <summary>Into a reused writer: nothing allocated in proportion to the PDF.</summary>
+    [Benchmark]
+    public async Task<int> BufferWriter()
+    {
+        _writer!.Clear();
+        var result = await _converter!.ConvertAsync(_docx, _writer, DocumentFormat.Docx);
+        result.ThrowIfFailed();
+        return _writer.WrittenCount;
+    }
+}
+
+/// <summary>
+/// Pool throughput: a fixed batch of requests from 1 to 256 concurrent callers
+/// against a fixed pool, with simulated conversion latency. Reported time is
+/// per request; ideal scaling levels off at latency / workers once callers
+/// outnumber workers, and anything above that is queueing and dispatch cost.
+/// </summary>
+[MemoryDiagnoser]
+public class SimulatedPoolBenchmarks
+{
+    private const int Requests = 256;
+
+    private byte[] _docx = Array.Empty<byte>();
+    private PdfConverter? _converter;
+
+    [Params(1, 4, 16, 64, 256)]
+    public int Callers { get; set; }
+
+    /// <summary>Pool size (SLIMLO_BENCH_WORKERS, default 4).</summary>
+    public static int Workers =>
+        int.TryParse(Environment.GetEnvironmentVariable("SLIMLO_BENCH_WORKERS"), out var n) && n > 0 ? n : 4;
+
+    [GlobalSetup]
+    public async Task Setup()
+    {
+        _docx = Simulation.Document(16 * 1024);
+        _converter = Simulation.CreateConverter("latency=lognormal:5:0.5,size=lognormal:65536:1", Workers);
+        (await _converter.ConvertAsync(_docx, DocumentFormat.Docx)).ThrowIfFailed();
+    }
+
+    [GlobalCleanup]
+    public void Cleanup() => _converter?.Dispose();
+
+    [Benchmark(OperationsPerInvoke = Requests)]
+    public async Task Throughput()
+    {
+        var callers = new Task[Callers];
+        for (int i = 0; i < callers.Length; i++)
+        {
+            // Spread the batch: the first Requests % Callers callers take one more
+            int count = Requests / Callers + (i < Requests % Callers ? 1 : 0);
+            callers[i] = RunCaller(count);
+        }
+        await Task.WhenAll(callers);
+    }
+
+    private async Task RunCaller(int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            var result = await _converter!.ConvertToPooledAsync(_docx, DocumentFormat.Docx).ConfigureAwait(false);
+            result.ThrowIfFailed();
+            result.Data!.Dispose();
+        }
+    }
+}
@@ -1,8 +1,11 @@
 using System;
+using System.Buffers;
 using System.Buffers.Binary;
 using System.Collections.Generic;
+using System.Diagnostics.Metrics;
 using System.IO;
 using System.Linq;
+using System.Net.Sockets;
 using System.Text;
 using System.Text.Json;
 using System.Threading;
@@ -383,6 +386,11 @@ public class ConversionOptionsTests
         Assert.False(opts.TaggedPdf);
         Assert.Null(opts.PageRange);
         Assert.Null(opts.Password);
+        Assert.Equal(PdfPreset.None, opts.Preset);
+        Assert.Null(opts.FilterProperties);
+        Assert.Null(opts.Progress);
+        Assert.False(opts.LazyLayout);
+        Assert.False(opts.SkipFieldUpdate);
     }
 
     [Fact]
@@ -447,6 +455,15 @@ public class PdfConverterOptionsTests
         Assert.Equal(1, opts.MaxWorkers);
         Assert.Equal(0, opts.MaxConversionsPerWorker);
         Assert.False(opts.WarmUp);
+        Assert.Null(opts.StallTimeout);
+        Assert.Equal(0, opts.ThreadsPerWorker);
+        Assert.Equal(2, opts.QuarantineAfterCrashes);
+        Assert.Equal(1024, opts.QuarantineCapacity);
+        Assert.False(opts.IsolateSuspectDocuments);
+        Assert.Equal(0, opts.MinWorkers);
+        Assert.Null(opts.IdleTimeout);
+        Assert.Null(opts.MemoryBudget);
+        Assert.False(opts.CoalesceDuplicates);
     }
 
     [Fact]
@@ -535,6 +552,27 @@ public class EnumTests
         Assert.Equal(expected, (int)version);
     }
 
+    [Theory]
+    [InlineData(PdfPreset.None, 0)]
+    [InlineData(PdfPreset.Fast, 1)]
+    [InlineData(PdfPreset.Small, 2)]
+    [InlineData(PdfPreset.Archival, 3)]
+    [InlineData(PdfPreset.Print, 4)]
+    public void PdfPreset_ValuesMatchNative(PdfPreset preset, int expected)
+    {
+        Assert.Equal(expected, (int)preset);
+    }
+
+    [Theory]
+    [InlineData(ConversionPhase.Load, 1)]
+    [InlineData(ConversionPhase.Layout, 2)]
+    [InlineData(ConversionPhase.Export, 3)]
+    [InlineData(ConversionPhase.Done, 4)]
+    public void ConversionPhase_ValuesMatchNative(ConversionPhase phase, int expected)
+    {
+        Assert.Equal(expected, (int)phase);
+    }
+
     [Theory]
     [InlineData(SlimLOErrorCode.Ok, 0)]
     [InlineData(SlimLOErrorCode.InitFailed, 1)]
@@ -547,6 +585,8 @@ public class EnumTests
     [InlineData(SlimLOErrorCode.AlreadyInitialized, 8)]
     [InlineData(SlimLOErrorCode.NotInitialized, 9)]
     [InlineData(SlimLOErrorCode.InvalidArgument, 10)]
+    [InlineData(SlimLOErrorCode.Quarantined, 11)]
+    [InlineData(SlimLOErrorCode.DeadlineExceeded, 12)]
     [InlineData(SlimLOErrorCode.Unknown, 99)]
     public void SlimLOErrorCode_ValuesMatchNative(SlimLOErrorCode code, int expected)
     {
@@ -756,6 +796,33 @@ public class ProtocolTests
         Assert.False(doc.RootElement.TryGetProperty("options", out _));
     }
 
+    [Fact]
+    public void Serialize_ConvertRequest_WithInputs_IsCombineRequest()
+    {
+        var request = new ConvertRequest
+        {
+            Id = 7,
+            Inputs = new[]
+            {
+                new CombineRequestPart { Input = "/a.docx", Bookmark = "Contract" },
+                new CombineRequestPart { Input = "/b.docx" }
+            },
+            Output = "/out.pdf",
+            Format = 1
+        };
+        var bytes = Protocol.Serialize(request);
+        var json = Encoding.UTF8.GetString(bytes);
+
+        using var doc = JsonDocument.Parse(json);
+        Assert.Equal("combine", doc.RootElement.GetProperty("type").GetString());
+        Assert.False(doc.RootElement.TryGetProperty("input", out _));
+        var inputs = doc.RootElement.GetProperty("inputs");
+        Assert.Equal(2, inputs.GetArrayLength());
+        Assert.Equal("/a.docx", inputs[0].GetProperty("input").GetString());
+        Assert.Equal("Contract", inputs[0].GetProperty("bookmark").GetString());
+        Assert.False(inputs[1].TryGetProperty("bookmark", out _));
+    }
+
     [Fact]
     public void Serialize_QuitRequest()
     {
@@ -805,6 +872,354 @@ public class ProtocolTests
         Assert.Equal("pass123", mapped.Password);
     }
 
+    [Fact]
+    public void ConvertRequestOptions_FromConversionOptions_MapsPresetAndFilterProperties()
+    {
+        var opts = new ConversionOptions
+        {
+            Preset = PdfPreset.Small,
+            FilterProperties = new Dictionary<string, string> { ["ExportBookmarks"] = "false" }
+        };
+        var mapped = ConvertRequestOptions.FromConversionOptions(opts)!;
+
+        Assert.Equal(2, mapped.Preset);
+        Assert.NotNull(mapped.FilterProperties);
+        Assert.Equal("false", mapped.FilterProperties!["ExportBookmarks"]);
+    }
+
+    [Fact]
+    public void Serialize_ConvertRequestOptions_PresetAndFilterProperties()
+    {
+        var options = ConvertRequestOptions.FromConversionOptions(new ConversionOptions
+        {
+            Preset = PdfPreset.Archival,
+            FilterProperties = new Dictionary<string, string>
+            {
+                ["ExportNotes"] = "true",
+                ["Quality"] = "70"
+            }
+        });
+        var bytes = Protocol.Serialize(new ConvertRequest
+        {
+            Id = 1, Input = "/in.docx", Output = "/out.pdf", Format = 1, Options = options
+        });
+
+        using var doc = JsonDocument.Parse(Encoding.UTF8.GetString(bytes));
+        var opts = doc.RootElement.GetProperty("options");
+        Assert.Equal(3, opts.GetProperty("preset").GetInt32());
+        var props = opts.GetProperty("filter_properties");
+        Assert.Equal("true", props.GetProperty("ExportNotes").GetString());
+        Assert.Equal("70", props.GetProperty("Quality").GetString());
+    }
+
+    [Fact]
+    public void Serialize_ConvertRequestOptions_EmptyFilterProperties_OmitsField()
+    {
+        var options = ConvertRequestOptions.FromConversionOptions(new ConversionOptions
+        {
+            FilterProperties = new Dictionary<string, string>()
+        });
+        var bytes = Protocol.Serialize(new ConvertRequest
+        {
+            Id = 1, Input = "/in.docx", Output = "/out.pdf", Format = 1, Options = options
+        });
+
+        using var doc = JsonDocument.Parse(Encoding.UTF8.GetString(bytes));
+        var opts = doc.RootElement.GetProperty("options");
+        Assert.Equal(0, opts.GetProperty("preset").GetInt32());
+        Assert.False(opts.TryGetProperty("filter_properties", out _));
+    }
+
+    [Fact]
+    public void Serialize_ConvertRequestOptions_LazyLayout_EmittedOnlyWhenSet()
+    {
+        static JsonElement SerializeOptions(ConversionOptions options)
+        {
+            var bytes = Protocol.Serialize(new ConvertRequest
+            {
+                Id = 1, Input = "/in.docx", Output = "/out.pdf", Format = 1,
+                Options = ConvertRequestOptions.FromConversionOptions(options)
+            });
+            return JsonDocument.Parse(Encoding.UTF8.GetString(bytes)).RootElement.GetProperty("options").Clone();
+        }
+
+        var lazy = SerializeOptions(new ConversionOptions { PageRange = "1", LazyLayout = true });
+        Assert.True(lazy.GetProperty("lazy_layout").GetBoolean());
+        Assert.Equal("1", lazy.GetProperty("page_range").GetString());
+
+        var full = SerializeOptions(new ConversionOptions { PageRange = "1" });
+        Assert.False(full.TryGetProperty("lazy_layout", out _));
+    }
+
+    [Fact]
+    public void ConvertRequestOptions_FromConversionOptions_MapsSkipFieldUpdate()
+    {
+        var mapped = ConvertRequestOptions.FromConversionOptions(
+            new ConversionOptions { SkipFieldUpdate = true })!;
+        Assert.True(mapped.SkipFieldUpdate);
+
+        var bytes = Protocol.Serialize(new ConvertRequest
+        {
+            Id = 1, Input = "/in.docx", Output = "/out.pdf", Format = 1, Options = mapped
+        });
+        using var doc = JsonDocument.Parse(Encoding.UTF8.GetString(bytes));
+        Assert.True(doc.RootElement.GetProperty("options").GetProperty("skip_field_update").GetBoolean());
+    }
+
+    [Fact]
+    public void Serialize_ConvertRequest_Progress_EmitsFlagOnlyWhenSet()
+    {
+        var withProgress = Protocol.Serialize(new ConvertRequest
+        {
+            Id = 1, Input = "/in.docx", Output = "/out.pdf", Format = 1, Progress = true
+        });
+        var without = Protocol.Serialize(new ConvertRequest
+        {
+            Id = 1, Input = "/in.docx", Output = "/out.pdf", Format = 1
+        });
+
+        using var doc1 = JsonDocument.Parse(Encoding.UTF8.GetString(withProgress));
+        Assert.True(doc1.RootElement.GetProperty("progress").GetBoolean());
+        using var doc2 = JsonDocument.Parse(Encoding.UTF8.GetString(without));
+        Assert.False(doc2.RootElement.TryGetProperty("progress", out _));
+    }
+
+    [Fact]
+    public void ParseProgress_ReadsAllFields()
+    {
+        using var doc = JsonDocument.Parse(
+            "{\"type\":\"progress\",\"id\":7,\"phase\":\"export\",\"percent\":40," +
+            "\"pages_laid_out\":10,\"pages_exported\":4,\"bytes_written\":0}");
+        var progress = WorkerProcess.ParseProgress(doc.RootElement);
+
+        Assert.Equal(ConversionPhase.Export, progress.Phase);
+        Assert.Equal(40, progress.Percent);
+        Assert.Equal(10, progress.PagesLaidOut);
+        Assert.Equal(4, progress.PagesExported);
+        Assert.Equal(0, progress.BytesWritten);
+    }
+
+    [Fact]
+    public void ParseProgress_UnknownPhaseAndMissingFields_DefaultToZero()
+    {
+        using var doc = JsonDocument.Parse("{\"type\":\"progress\",\"phase\":\"future\"}");
+        var progress = WorkerProcess.ParseProgress(doc.RootElement);
+
+        Assert.Equal(ConversionPhase.Unknown, progress.Phase);
+        Assert.Equal(0, progress.Percent);
+        Assert.Equal(0, progress.PagesLaidOut);
+        Assert.Equal(0L, progress.BytesWritten);
+    }
+
+    [Fact]
+    public void Serialize_InfoRequest_FileMode_OmitsDataSize()
+    {
+        var bytes = Protocol.Serialize(new InfoRequest { Id = 3, Input = "/in.docx", Format = 1 });
+
+        using var doc = JsonDocument.Parse(Encoding.UTF8.GetString(bytes));
+        var root = doc.RootElement;
+        Assert.Equal("info", root.GetProperty("type").GetString());
+        Assert.Equal(3, root.GetProperty("id").GetInt32());
+        Assert.Equal("/in.docx", root.GetProperty("input").GetString());
+        Assert.False(root.TryGetProperty("data_size", out _));
+    }
+
+    [Fact]
+    public void Serialize_InfoRequest_BufferMode_OmitsInput()
+    {
+        var bytes = Protocol.Serialize(new InfoRequest { Id = 4, Format = 1, DataSize = 1234 });
+
+        using var doc = JsonDocument.Parse(Encoding.UTF8.GetString(bytes));
+        var root = doc.RootElement;
+        Assert.Equal(1234, root.GetProperty("data_size").GetInt64());
+        Assert.False(root.TryGetProperty("input", out _));
+    }
+
+    [Fact]
+    public void Serialize_AddFontsRequest_ListsPaths()
+    {
+        var bytes = Protocol.Serialize(new AddFontsRequest { Id = 5, Paths = new[] { "/fonts/a", "/fonts/b" } });
+
+        using var doc = JsonDocument.Parse(Encoding.UTF8.GetString(bytes));
+        var root = doc.RootElement;
+        Assert.Equal("add_fonts", root.GetProperty("type").GetString());
+        Assert.Equal(5, root.GetProperty("id").GetInt32());
+        Assert.Equal(new[] { "/fonts/a", "/fonts/b" },
+            root.GetProperty("paths").EnumerateArray().Select(p => p.GetString()!).ToArray());
+    }
+
+    [Fact]
+    public void PendingFonts_ReturnsNewDirectoriesInOrder()
+    {
+        var registered = new[] { "/fonts/a" };
+
+        Assert.Empty(WorkerProcess.PendingFonts(registered, registered));
+        Assert.Empty(WorkerProcess.PendingFonts(registered, new[] { "/fonts/a" }));
+        Assert.Equal(new[] { "/fonts/c", "/fonts/b" },
+            WorkerProcess.PendingFonts(registered, new[] { "/fonts/c", "/fonts/a", "/fonts/b", "/fonts/c" }).ToArray());
+    }
+
+    [Fact]
+    public void ParseDocumentInfo_ReadsAllFields()
+    {
+        using var doc = JsonDocument.Parse(
+            "{\"type\":\"info_result\",\"id\":1,\"success\":true,\"page_count\":2," +
+            "\"pages\":[{\"width\":595.3,\"height\":841.9},{\"width\":841.9,\"height\":595.3}]," +
+            "\"section_count\":1,\"image_count\":3,\"word_count\":120," +
+            "\"fonts\":[\"Calibri\",\"Liberation Serif\"],\"missing_fonts\":[\"Calibri\"]}");
+        var info = WorkerProcess.ParseDocumentInfo(doc.RootElement);
+
+        Assert.Equal(2, info.PageCount);
+        Assert.Equal(new PageSize(595.3, 841.9), info.Pages[0]);
+        Assert.Equal(841.9, info.Pages[1].Width);
+        Assert.Equal(1, info.SectionCount);
+        Assert.Equal(3, info.ImageCount);
+        Assert.Equal(120, info.WordCount);
+        Assert.Equal(new[] { "Calibri", "Liberation Serif" }, info.Fonts);
+        Assert.Equal(new[] { "Calibri" }, info.MissingFonts);
+    }
+
+    [Fact]
+    public void ParseDocumentInfo_MissingFields_DefaultToEmpty()
+    {
+        using var doc = JsonDocument.Parse("{\"type\":\"info_result\",\"success\":true}");
+        var info = WorkerProcess.ParseDocumentInfo(doc.RootElement);
+
+        Assert.Equal(0, info.PageCount);
+        Assert.Empty(info.Pages);
+        Assert.Empty(info.Fonts);
+        Assert.Empty(info.MissingFonts);
+    }
+
+    [Fact]
+    public void Serialize_ConvertRequest_WithPageImages_IncludesRender()
+    {
+        var request = new ConvertRequest
+        {
+            Id = 5,
+            Input = "/in.docx",
+            Output = "/out.pdf",
+            Format = 1,
+            Render = RenderRequestOptions.FromRenderOptions(
+                new RenderOptions { Format = PageImageFormat.Rgba, Width = 128, PageRange = "1-2" })
+        };
+        var bytes = Protocol.Serialize(request);
+
+        using var doc = JsonDocument.Parse(Encoding.UTF8.GetString(bytes));
+        var render = doc.RootElement.GetProperty("render");
+        Assert.Equal(1, render.GetProperty("format").GetInt32());
+        Assert.Equal(128, render.GetProperty("width").GetInt32());
+        Assert.Equal("1-2", render.GetProperty("page_range").GetString());
+    }
+
+    [Fact]
+    public void Serialize_ConvertBufferRequest_NoPageImages_OmitsRender()
+    {
+        var bytes = Protocol.Serialize(new ConvertBufferRequest { Id = 6, Format = 1, DataSize = 10 });
+
+        using var doc = JsonDocument.Parse(Encoding.UTF8.GetString(bytes));
+        Assert.False(doc.RootElement.TryGetProperty("render", out _));
+    }
+
+    [Fact]
+    public void Serialize_ConvertBufferRequest_ChunkedOnlyWhenSet()
+    {
+        using var plain = JsonDocument.Parse(Protocol.Serialize(new ConvertBufferRequest { Id = 1, DataSize = 10 }));
+        Assert.False(plain.RootElement.TryGetProperty("chunked", out _));
+
+        using var chunked = JsonDocument.Parse(Protocol.Serialize(new ConvertBufferRequest { Id = 2, Chunked = true }));
+        Assert.True(chunked.RootElement.GetProperty("chunked").GetBoolean());
+    }
+
+    [Fact]
+    public void Serialize_RenderRequest_DefaultOptions()
+    {
+        var request = new RenderRequest
+        {
+            Id = 7,
+            Format = 1,
+            DataSize = 99,
+            Render = RenderRequestOptions.FromRenderOptions(new RenderOptions())
+        };
+        var bytes = Protocol.Serialize(request);
+
+        using var doc = JsonDocument.Parse(Encoding.UTF8.GetString(bytes));
+        var root = doc.RootElement;
+        Assert.Equal("render", root.GetProperty("type").GetString());
+        Assert.Equal(99, root.GetProperty("data_size").GetInt64());
+        Assert.False(root.TryGetProperty("input", out _));
+        Assert.Equal(0, root.GetProperty("render").GetProperty("format").GetInt32());
+        Assert.False(root.GetProperty("render").TryGetProperty("page_range", out _));
+    }
+
+    [Fact]
+    public void ParsePageImage_ReadsMetadata()
+    {
+        using var doc = JsonDocument.Parse(
+            "{\"page\":3,\"width\":256,\"height\":362,\"format\":1,\"size\":4}");
+        var image = WorkerProcess.ParsePageImage(doc.RootElement, new byte[] { 1, 2, 3, 4 });
+
+        Assert.Equal(3, image.PageNumber);
+        Assert.Equal(256, image.Width);
+        Assert.Equal(362, image.Height);
+        Assert.Equal(PageImageFormat.Rgba, image.Format);
+        Assert.Equal(4, image.Data.Length);
+    }
+
+    [Fact]
+    public void Serialize_ConvertRequest_WithPageText_IncludesText()
+    {
+        var request = new ConvertRequest
+        {
+            Id = 8,
+            Input = "/in.docx",
+            Output = "/out.pdf",
+            Format = 1,
+            Text = TextRequestOptions.FromTextOptions(new TextOptions { IncludeWords = true })
+        };
+        var bytes = Protocol.Serialize(request);
+
+        using var doc = JsonDocument.Parse(Encoding.UTF8.GetString(bytes));
+        var text = doc.RootElement.GetProperty("text");
+        Assert.True(text.GetProperty("words").GetBoolean());
+        Assert.False(text.TryGetProperty("page_range", out _));
+    }
+
+    [Fact]
+    public void ParsePageText_ReadsPagesAndWords()
+    {
+        using var doc = JsonDocument.Parse(
+            "{\"success\":true,\"text\":[" +
+            "{\"page\":1,\"width\":595.3,\"height\":841.9,\"text\":\"Hello world\\nNext\"," +
+            "\"words\":[[72,70.5,30.2,14,\"Hello\"],[105.1,70.5,33,14,\"world\"]]}," +
+            "{\"page\":2,\"width\":595.3,\"height\":841.9,\"text\":\"\"}]}");
+        var pages = WorkerProcess.ParsePageText(doc.RootElement);
+
+        Assert.Equal(2, pages.Count);
+        Assert.Equal(1, pages[0].PageNumber);
+        Assert.Equal(new PageSize(595.3, 841.9), pages[0].Size);
+        Assert.Equal("Hello world\nNext", pages[0].Text);
+        Assert.Equal(2, pages[0].Words.Count);
+        Assert.Equal("world", pages[0].Words[1].Text);
+        Assert.Equal(105.1, pages[0].Words[1].X);
+        Assert.Equal(14, pages[0].Words[1].Height);
+        Assert.Empty(pages[1].Words);
+    }
+
+    [Fact]
+    public void ParsePageText_NoTextArray_IsEmpty()
+    {
+        using var doc = JsonDocument.Parse("{\"success\":true}");
+        Assert.Empty(WorkerProcess.ParsePageText(doc.RootElement));
+    }
+
+    [Fact]
+    public void ConversionResult_WithoutPageImages_IsEmpty()
+    {
+        Assert.Empty(ConversionResult.Ok(null).PageImages);
+        Assert.Empty(ConversionResult<byte[]>.Ok(new byte[1], null).AsBase().PageImages);
+    }
+
     [Fact]
     public void Serialize_InitRequest_NoFontPaths_OmitsField()
     {
@@ -817,6 +1232,27 @@ public class ProtocolTests
 
         using var doc = JsonDocument.Parse(json);
         Assert.False(doc.RootElement.TryGetProperty("font_paths", out _));
+        Assert.False(doc.RootElement.TryGetProperty("threads", out _));
+    }
+
+    [Fact]
+    public void Serialize_InitRequest_Threads()
+    {
+        var bytes = Protocol.Serialize(new InitRequest { ResourcePath = "/opt/slimlo", Threads = 2 });
+
+        using var doc = JsonDocument.Parse(Encoding.UTF8.GetString(bytes));
+        Assert.Equal(2, doc.RootElement.GetProperty("threads").GetInt32());
+    }
+
+    [Fact]
+    public void Serialize_InitRequest_CpusOnlyWhenPinned()
+    {
+        var pinned = Protocol.Serialize(new InitRequest { ResourcePath = "/opt/slimlo", Cpus = new[] { 4, 5 } });
+        using var doc = JsonDocument.Parse(Encoding.UTF8.GetString(pinned));
+        Assert.Equal("[4,5]", doc.RootElement.GetProperty("cpus").GetRawText());
+
+        var unpinned = Protocol.Serialize(new InitRequest { ResourcePath = "/opt/slimlo" });
+        Assert.DoesNotContain("cpus", Encoding.UTF8.GetString(unpinned));
     }
 
     [Fact]
@@ -911,74 +1347,320 @@ public class ProtocolTests
         Assert.Empty(result);
     }
 
-    // --- Snake-case JSON verification tests ---
-    // These verify that [JsonPropertyName] attributes produce correct snake_case
-    // on both net8.0 (source generator) and net6.0 (reflection-based).
+    // --- Pooled and buffer-writer reads ---
 
     [Fact]
-    public void Serialize_InitRequest_AllFieldsSnakeCase()
+    public async Task ReadPooledMessage_RoundTripsAndReturnsArrayOnDispose()
     {
-        var request = new InitRequest
-        {
-            ResourcePath = "/test",
-            FontPaths = new[] { "/fonts" }
-        };
-        var bytes = Protocol.Serialize(request);
-        var json = Encoding.UTF8.GetString(bytes);
+        var ms = new MemoryStream();
+        var payload = new byte[1024 * 1024];
+        Random.Shared.NextBytes(payload);
+        await Protocol.WriteMessageAsync(ms, payload.AsMemory(), CancellationToken.None);
+        ms.Position = 0;
 
-        // Must use snake_case, not PascalCase
-        Assert.Contains("\"resource_path\"", json);
-        Assert.Contains("\"font_paths\"", json);
-        Assert.DoesNotContain("ResourcePath", json);
-        Assert.DoesNotContain("FontPaths", json);
+        var result = await Protocol.ReadPooledMessageAsync(ms, CancellationToken.None);
+        Assert.NotNull(result);
+        Assert.True(result!.Memory.Span.SequenceEqual(payload));
+        result.Dispose();
+        Assert.Throws<ObjectDisposedException>(() => result.Memory);
+        result.Dispose(); // idempotent
     }
 
     [Fact]
-    public void Serialize_ConvertRequest_AllFieldsSnakeCase()
+    public async Task ReadPooledMessage_TruncatedFrame_ReturnsNull()
     {
-        var request = new ConvertRequest
-        {
-            Id = 1,
-            Input = "/in",
-            Output = "/out",
-            Format = 1,
-            Options = new ConvertRequestOptions
-            {
-                PdfVersion = 1,
-                JpegQuality = 85,
-                Dpi = 300,
-                TaggedPdf = true,
-                PageRange = "1-5",
-                Password = "pwd"
-            }
-        };
-        var bytes = Protocol.Serialize(request);
-        var json = Encoding.UTF8.GetString(bytes);
+        var header = new byte[4];
+        BinaryPrimitives.WriteUInt32LittleEndian(header, 100);
+        var ms = new MemoryStream(header.Concat(new byte[10]).ToArray());
 
-        Assert.Contains("\"pdf_version\"", json);
-        Assert.Contains("\"jpeg_quality\"", json);
-        Assert.Contains("\"tagged_pdf\"", json);
-        Assert.Contains("\"page_range\"", json);
-        Assert.DoesNotContain("PdfVersion", json);
-        Assert.DoesNotContain("JpegQuality", json);
-        Assert.DoesNotContain("TaggedPdf", json);
-        Assert.DoesNotContain("PageRange", json);
+        Assert.Null(await Protocol.ReadPooledMessageAsync(ms, CancellationToken.None));
     }
 
     [Fact]
-    public void Serialize_ConvertBufferRequest_AllFieldsSnakeCase()
+    public async Task ReadMessageInto_WritesFrameIntoBufferWriter()
     {
-        var request = new ConvertBufferRequest
-        {
-            Id = 1,
-            Format = 1,
-            DataSize = 1024
-        };
-        var bytes = Protocol.Serialize(request);
-        var json = Encoding.UTF8.GetString(bytes);
+        var ms = new MemoryStream();
+        var payload = Encoding.UTF8.GetBytes("%PDF-1.7 partial reads into a caller's writer");
+        await Protocol.WriteMessageAsync(ms, payload, CancellationToken.None);
+        await Protocol.WriteMessageAsync(ms, new byte[] { 0x42 }, CancellationToken.None);
 
-        Assert.Contains("\"data_size\"", json);
-        Assert.DoesNotContain("DataSize", json);
+        var stream = new SlowReadStream(ms.ToArray());
+        var writer = new ArrayBufferWriter<byte>();
+        Assert.True(await Protocol.ReadMessageIntoAsync(stream, writer, CancellationToken.None));
+        Assert.True(writer.WrittenSpan.SequenceEqual(payload));
+
+        // The next frame is left untouched
+        var next = await Protocol.ReadMessageAsync(stream, CancellationToken.None);
+        Assert.Equal(new byte[] { 0x42 }, next);
+    }
+
+    [Fact]
+    public async Task ReadMessageInto_TruncatedFrame_ReturnsFalse()
+    {
+        var header = new byte[4];
+        BinaryPrimitives.WriteUInt32LittleEndian(header, 100);
+        var ms = new MemoryStream(header.Concat(new byte[10]).ToArray());
+
+        var writer = new ArrayBufferWriter<byte>();
+        Assert.False(await Protocol.ReadMessageIntoAsync(ms, writer, CancellationToken.None));
+        Assert.Equal(10, writer.WrittenCount);
+    }
+
+    [Fact]
+    public async Task PooledAndWriterReads_DoNotAllocatePerFrame()
+    {
+        // A MemoryStream completes synchronously, so each measured call runs on this thread
+        const int size = 4 * 1024 * 1024;
+        var payload = new byte[size];
+        var ms = new MemoryStream();
+        await Protocol.WriteMessageAsync(ms, payload, CancellationToken.None);
+        var writer = new ArrayBufferWriter<byte>(size);
+
+        async Task<long> Measure(Func<Task> run)
+        {
+            ms.Position = 0;
+            await run(); // warm up: JIT, first rent from the pool
+            ms.Position = 0;
+            long before = GC.GetAllocatedBytesForCurrentThread();
+            await run();
+            return GC.GetAllocatedBytesForCurrentThread() - before;
+        }
+
+        long array = await Measure(() => Protocol.ReadMessageAsync(ms, CancellationToken.None));
+        long pooled = await Measure(async () =>
+        {
+            using var pdf = await Protocol.ReadPooledMessageAsync(ms, CancellationToken.None);
+        });
+        long intoWriter = await Measure(async () =>
+        {
+            writer.Clear();
+            await Protocol.ReadMessageIntoAsync(ms, writer, CancellationToken.None);
+        });
+        long write = await Measure(() => Protocol.WriteMessageAsync(Stream.Null, payload, CancellationToken.None));
+
+        Assert.True(array >= size, $"byte[] read allocated {array} bytes");
+        Assert.True(pooled < 16 * 1024, $"pooled read allocated {pooled} bytes");
+        Assert.True(intoWriter < 16 * 1024, $"buffer-writer read allocated {intoWriter} bytes");
+        Assert.True(write < 16 * 1024, $"frame write allocated {write} bytes");
+    }
+
+    // --- Chunked bodies ---
+
+    [Fact]
+    public async Task WriteChunked_ReadChunked_RoundTripsInSeveralFrames()
+    {
+        var payload = new byte[600 * 1024];
+        Random.Shared.NextBytes(payload);
+        var ms = new MemoryStream();
+        long sent = await Protocol.WriteChunkedAsync(ms, new SlowReadStream(payload), CancellationToken.None);
+        await Protocol.WriteMessageAsync(ms, new byte[] { 0x42 }, CancellationToken.None);
+        Assert.Equal(payload.Length, sent);
+
+        // Count the frames: three data frames, then the terminator
+        ms.Position = 0;
+        var sizes = new List<int>();
+        while (true)
+        {
+            var frame = await Protocol.ReadMessageAsync(ms, CancellationToken.None);
+            sizes.Add(frame!.Length);
+            if (frame.Length == 0) break;
+        }
+        Assert.Equal("262144,262144,90112,0", string.Join(",", sizes));
+
+        ms.Position = 0;
+        var output = new MemoryStream();
+        Assert.True(await Protocol.ReadChunkedAsync(ms, output, CancellationToken.None));
+        Assert.True(output.ToArray().AsSpan().SequenceEqual(payload));
+
+        // The next frame is left untouched
+        Assert.Equal(new byte[] { 0x42 }, await Protocol.ReadMessageAsync(ms, CancellationToken.None));
+    }
+
+    [Fact]
+    public async Task WriteChunked_EmptySource_SendsOnlyTerminator()
+    {
+        var ms = new MemoryStream();
+        Assert.Equal(0, await Protocol.WriteChunkedAsync(ms, new MemoryStream(), CancellationToken.None));
+        Assert.Equal(new byte[4], ms.ToArray());
+
+        ms.Position = 0;
+        var output = new MemoryStream();
+        Assert.True(await Protocol.ReadChunkedAsync(ms, output, CancellationToken.None));
+        Assert.Equal(0, output.Length);
+    }
+
+    [Fact]
+    public async Task ReadChunked_MissingTerminator_ReturnsFalse()
+    {
+        var ms = new MemoryStream();
+        await Protocol.WriteMessageAsync(ms, new byte[] { 1, 2, 3 }, CancellationToken.None);
+        ms.Position = 0;
+
+        var output = new MemoryStream();
+        Assert.False(await Protocol.ReadChunkedAsync(ms, output, CancellationToken.None));
+        Assert.Equal(3, output.Length); // chunks already received were passed on
+    }
+
+    // --- Metrics ---
+
+    [Fact]
+    public void PoolMetrics_RecordConversion_PublishesPhasesBytesAndFontFallbacks()
+    {
+        using var metrics = new PoolMetrics(() => 0, () => Array.Empty<Measurement<long>>());
+        var recorded = new List<string>();
+        using var listener = Listen(metrics, recorded);
+
+        using var doc = JsonDocument.Parse(
+            "{\"type\":\"result\",\"success\":true,\"metrics\":{\"load_ms\":120.5,\"export_ms\":30," +
+            "\"total_ms\":150.5,\"input_bytes\":2048,\"output_bytes\":4096,\"rss_bytes\":1000000}}");
+        var diagnostics = new[]
+        {
+            new ConversionDiagnostic(DiagnosticSeverity.Warning, DiagnosticCategory.Font, "missing", "Foo", "Bar"),
+            new ConversionDiagnostic(DiagnosticSeverity.Info, DiagnosticCategory.Layout, "layout"),
+        };
+        metrics.RecordConversion(doc.RootElement, diagnostics);
+
+        Assert.Contains("slimlo.font.fallbacks=1", recorded);
+        Assert.Contains("slimlo.conversion.duration=120.5 phase=load", recorded);
+        Assert.Contains("slimlo.conversion.duration=30 phase=export", recorded);
+        Assert.Contains("slimlo.conversion.duration=150.5 phase=total", recorded);
+        Assert.Contains("slimlo.conversion.bytes_in=2048", recorded);
+        Assert.Contains("slimlo.conversion.bytes_out=4096", recorded);
+        Assert.Equal(1000000L, PoolMetrics.ResidentBytes(doc.RootElement));
+    }
+
+    [Fact]
+    public void PoolMetrics_ResultWithoutMetrics_RecordsNothing()
+    {
+        using var metrics = new PoolMetrics(() => 0, () => Array.Empty<Measurement<long>>());
+        var recorded = new List<string>();
+        using var listener = Listen(metrics, recorded);
+
+        using var doc = JsonDocument.Parse("{\"type\":\"result\",\"success\":false}");
+        metrics.RecordConversion(doc.RootElement, Array.Empty<ConversionDiagnostic>());
+
+        Assert.Empty(recorded);
+        Assert.Null(PoolMetrics.ResidentBytes(doc.RootElement));
+    }
+
+    [Fact]
+    public void PoolMetrics_WorkerEventsAndGauges_AreTagged()
+    {
+        using var metrics = new PoolMetrics(() => 3, () => new[]
+        {
+            new Measurement<long>(512, new KeyValuePair<string, object?>("worker", 1)),
+        });
+        var recorded = new List<string>();
+        using var listener = Listen(metrics, recorded);
+
+        metrics.RecordWorkerStart();
+        metrics.RecordRecycle("idle");
+        metrics.RecordCrash();
+        metrics.RecordTimeout(stalled: true);
+        listener.RecordObservableInstruments();
+
+        Assert.Contains("slimlo.worker.starts=1", recorded);
+        Assert.Contains("slimlo.worker.recycles=1 reason=idle", recorded);
+        Assert.Contains("slimlo.worker.crashes=1", recorded);
+        Assert.Contains("slimlo.worker.timeouts=1 kind=stall", recorded);
+        Assert.Contains("slimlo.queue.depth=3", recorded);
+        Assert.Contains("slimlo.worker.memory=512 worker=1", recorded);
+    }
+
+    /// <summary>Collect "name=value tag=value" lines from one pool's instruments.</summary>
+    private static MeterListener Listen(PoolMetrics metrics, List<string> recorded)
+    {
+        var listener = new MeterListener
+        {
+            InstrumentPublished = (instrument, l) =>
+            {
+                if (instrument.Meter == metrics.Meter)
+                    l.EnableMeasurementEvents(instrument);
+            },
+        };
+        void Record<T>(Instrument instrument, T value, ReadOnlySpan<KeyValuePair<string, object?>> tags, object? state)
+        {
+            var line = new StringBuilder($"{instrument.Name}={Convert.ToString(value, System.Globalization.CultureInfo.InvariantCulture)}");
+            foreach (var tag in tags)
+                line.Append(' ').Append(tag.Key).Append('=').Append(tag.Value);
+            lock (recorded)
+                recorded.Add(line.ToString());
+        }
+        listener.SetMeasurementEventCallback<long>(Record);
+        listener.SetMeasurementEventCallback<int>(Record);
+        listener.SetMeasurementEventCallback<double>(Record);
+        listener.Start();
+        return listener;
+    }
+
+    // --- Snake-case JSON verification tests ---
+    // These verify that [JsonPropertyName] attributes produce correct snake_case
+    // on both net8.0 (source generator) and net6.0 (reflection-based).
+
+    [Fact]
+    public void Serialize_InitRequest_AllFieldsSnakeCase()
+    {
+        var request = new InitRequest
+        {
+            ResourcePath = "/test",
+            FontPaths = new[] { "/fonts" }
+        };
+        var bytes = Protocol.Serialize(request);
+        var json = Encoding.UTF8.GetString(bytes);
+
+        // Must use snake_case, not PascalCase
+        Assert.Contains("\"resource_path\"", json);
+        Assert.Contains("\"font_paths\"", json);
+        Assert.DoesNotContain("ResourcePath", json);
+        Assert.DoesNotContain("FontPaths", json);
+    }
+
+    [Fact]
+    public void Serialize_ConvertRequest_AllFieldsSnakeCase()
+    {
+        var request = new ConvertRequest
+        {
+            Id = 1,
+            Input = "/in",
+            Output = "/out",
+            Format = 1,
+            Options = new ConvertRequestOptions
+            {
+                PdfVersion = 1,
+                JpegQuality = 85,
+                Dpi = 300,
+                TaggedPdf = true,
+                PageRange = "1-5",
+                Password = "pwd"
+            }
+        };
+        var bytes = Protocol.Serialize(request);
+        var json = Encoding.UTF8.GetString(bytes);
+
+        Assert.Contains("\"pdf_version\"", json);
+        Assert.Contains("\"jpeg_quality\"", json);
+        Assert.Contains("\"tagged_pdf\"", json);
+        Assert.Contains("\"page_range\"", json);
+        Assert.DoesNotContain("PdfVersion", json);
+        Assert.DoesNotContain("JpegQuality", json);
+        Assert.DoesNotContain("TaggedPdf", json);
+        Assert.DoesNotContain("PageRange", json);
+    }
+
+    [Fact]
+    public void Serialize_ConvertBufferRequest_AllFieldsSnakeCase()
+    {
+        var request = new ConvertBufferRequest
+        {
+            Id = 1,
+            Format = 1,
+            DataSize = 1024
+        };
+        var bytes = Protocol.Serialize(request);
+        var json = Encoding.UTF8.GetString(bytes);
+
+        Assert.Contains("\"data_size\"", json);
+        Assert.DoesNotContain("DataSize", json);
     }
 
     // --- Partial read test ---
@@ -1110,174 +1792,1356 @@ internal sealed class SlowReadStream : Stream
 }
 
 // ===========================================================================
-// StderrDiagnosticParser tests
+// CrashQuarantine tests
 // ===========================================================================
 
-public class StderrDiagnosticParserTests
+public class CrashQuarantineTests
 {
-    private static JsonElement ParseJson(string json)
+    [Fact]
+    public void RecordCrash_QuarantinesAtThreshold()
     {
-        using var doc = JsonDocument.Parse(json);
-        return doc.RootElement.Clone();
+        var q = new CrashQuarantine(threshold: 2, capacity: 8);
+        var key = CrashQuarantine.KeyOf(new byte[] { 1, 2, 3 });
+
+        Assert.False(q.IsQuarantined(key));
+        Assert.Equal(1, q.RecordCrash(key));
+        Assert.False(q.IsQuarantined(key));
+        Assert.Equal(2, q.RecordCrash(key));
+        Assert.True(q.IsQuarantined(key));
     }
 
     [Fact]
-    public void ParseFromJson_EmptyArray_ReturnsEmpty()
+    public void RecordCrash_EvictsLeastRecentlySeen()
     {
-        var element = ParseJson("[]");
-        var result = StderrDiagnosticParser.ParseFromJson(element);
-        Assert.Empty(result);
+        var q = new CrashQuarantine(threshold: 1, capacity: 2);
+        q.RecordCrash("a");
+        q.RecordCrash("b");
+        q.RecordCrash("a");  // "b" is now the oldest
+        q.RecordCrash("c");
+
+        Assert.Equal(2, q.Count);
+        Assert.True(q.IsQuarantined("a"));
+        Assert.False(q.IsQuarantined("b"));
+        Assert.True(q.IsQuarantined("c"));
     }
 
     [Fact]
-    public void ParseFromJson_NonArray_ReturnsEmpty()
+    public void KeyOf_SameContent_SameKey()
     {
-        var element = ParseJson("\"not an array\"");
-        var result = StderrDiagnosticParser.ParseFromJson(element);
-        Assert.Empty(result);
+        var data = Encoding.UTF8.GetBytes("PK\x03\x04 not really a docx");
+        var other = Encoding.UTF8.GetBytes("PK\x03\x04 another document");
+        Assert.Equal(CrashQuarantine.KeyOf(data), CrashQuarantine.KeyOf((byte[])data.Clone()));
+        Assert.NotEqual(CrashQuarantine.KeyOf(data), CrashQuarantine.KeyOf(other));
+        Assert.Equal(64, CrashQuarantine.KeyOf(data).Length);
     }
 
     [Fact]
-    public void ParseFromJson_NullValueKind_ReturnsEmpty()
+    public void KeyOfFile_MatchesBufferKey()
     {
-        var element = ParseJson("null");
-        var result = StderrDiagnosticParser.ParseFromJson(element);
-        Assert.Empty(result);
+        var data = Encoding.UTF8.GetBytes("attachment bytes");
+        var path = Path.GetTempFileName();
+        try
+        {
+            File.WriteAllBytes(path, data);
+            Assert.Equal(CrashQuarantine.KeyOf(data), CrashQuarantine.KeyOfFile(path));
+        }
+        finally
+        {
+            File.Delete(path);
+        }
     }
 
     [Fact]
-    public void ParseFromJson_FontWarning_FullProperties()
+    public void KeyOfFile_MissingFile_ReturnsNull()
     {
-        var json = "[{\"severity\":\"warning\",\"category\":\"font\"," +
-            "\"message\":\"Could not find font 'Arial Narrow'\"," +
-            "\"font\":\"Arial Narrow\",\"substituted_with\":\"Liberation Sans\"}]";
-        var element = ParseJson(json);
-        var result = StderrDiagnosticParser.ParseFromJson(element);
+        Assert.Null(CrashQuarantine.KeyOfFile(
+            Path.Combine(Path.GetTempPath(), Guid.NewGuid().ToString("N") + ".docx")));
+    }
 
-        Assert.Single(result);
-        Assert.Equal(DiagnosticSeverity.Warning, result[0].Severity);
-        Assert.Equal(DiagnosticCategory.Font, result[0].Category);
-        Assert.Equal("Could not find font 'Arial Narrow'", result[0].Message);
-        Assert.Equal("Arial Narrow", result[0].FontName);
-        Assert.Equal("Liberation Sans", result[0].SubstitutedWith);
+    [Fact]
+    public async Task Pool_FailsQuarantinedDocument_WithoutStartingWorker()
+    {
+        // The worker path does not exist: reaching a worker would fail with InitFailed
+        await using var pool = new WorkerPool(new WorkerPoolSettings
+        {
+            WorkerPath = "/nonexistent/slimlo_worker",
+            ResourcePath = "/nonexistent",
+            Timeout = TimeSpan.FromSeconds(5),
+            QuarantineAfterCrashes = 2,
+            QuarantineCapacity = 16,
+        });
+        var data = new byte[] { 0x50, 0x4B, 0x03, 0x04, 0xFF };
+        var key = CrashQuarantine.KeyOf(data);
+        pool.Quarantine!.RecordCrash(key);
+        pool.Quarantine.RecordCrash(key);
+
+        var result = await pool.ExecuteBufferAsync(
+            new ConvertBufferRequest { Id = 1, DataSize = data.Length }, data, null,
+            AdmissionQueue.NoDeadline, null, CancellationToken.None);
+
+        Assert.False(result.Success);
+        Assert.Equal(SlimLOErrorCode.Quarantined, result.ErrorCode);
     }
 
     [Fact]
-    public void ParseFromJson_InfoSeverity()
+    public void Pool_QuarantineDisabled_WhenThresholdZero()
     {
-        var json = "[{\"severity\":\"info\",\"category\":\"general\",\"message\":\"Info message\"}]";
-        var element = ParseJson(json);
-        var result = StderrDiagnosticParser.ParseFromJson(element);
+        var pool = new WorkerPool(new WorkerPoolSettings
+        {
+            WorkerPath = "/nonexistent/slimlo_worker",
+            ResourcePath = "/nonexistent",
+            Timeout = TimeSpan.FromSeconds(5),
+        });
+        Assert.Null(pool.Quarantine);
+    }
+}
 
-        Assert.Single(result);
-        Assert.Equal(DiagnosticSeverity.Info, result[0].Severity);
-        Assert.Equal(DiagnosticCategory.General, result[0].Category);
+// ===========================================================================
+// AdmissionQueue tests
+// ===========================================================================
+
+public class AdmissionQueueTests
+{
+    private static long In(TimeSpan t) => AdmissionQueue.DeadlineAfter(t);
+
+    [Fact]
+    public async Task AdmitsUpToSlots_ThenQueues()
+    {
+        using var queue = new AdmissionQueue(2);
+        Assert.True(await queue.WaitAsync(null, AdmissionQueue.NoDeadline, CancellationToken.None));
+        Assert.True(await queue.WaitAsync(null, AdmissionQueue.NoDeadline, CancellationToken.None));
+
+        var third = queue.WaitAsync(null, AdmissionQueue.NoDeadline, CancellationToken.None);
+        Assert.False(third.IsCompleted);
+        Assert.Equal(1, queue.QueueLength);
+
+        queue.Release(null);
+        Assert.True(await third);
+        Assert.Equal(0, queue.QueueLength);
+    }
+
+    [Fact]
+    public async Task AdmitsEarliestDeadlineFirst()
+    {
+        using var queue = new AdmissionQueue(1);
+        Assert.True(await queue.WaitAsync(null, AdmissionQueue.NoDeadline, CancellationToken.None));
+
+        var none = queue.WaitAsync(null, AdmissionQueue.NoDeadline, CancellationToken.None);
+        var late = queue.WaitAsync(null, In(TimeSpan.FromMinutes(10)), CancellationToken.None);
+        var soon = queue.WaitAsync(null, In(TimeSpan.FromMinutes(1)), CancellationToken.None);
+
+        queue.Release(null);
+        Assert.True(await soon);
+        Assert.False(late.IsCompleted);
+        queue.Release(null);
+        Assert.True(await late);
+        Assert.False(none.IsCompleted);
+        queue.Release(null);
+        Assert.True(await none);
+    }
+
+    [Fact]
+    public async Task ShedsExpiredDeadline_WithoutTakingSlot()
+    {
+        using var queue = new AdmissionQueue(1);
+        Assert.False(await queue.WaitAsync(null, In(TimeSpan.Zero), CancellationToken.None));
+        Assert.Equal(1, queue.ShedCount);
+        Assert.True(await queue.WaitAsync(null, AdmissionQueue.NoDeadline, CancellationToken.None));
+    }
+
+    [Fact]
+    public async Task ShedsRequest_WhenRecentServiceTimesExceedDeadline()
+    {
+        using var queue = new AdmissionQueue(1);
+        queue.RecordServiceTime(System.Diagnostics.Stopwatch.Frequency * 10); // 10 s
+        Assert.NotNull(queue.EstimatedServiceTime);
+
+        Assert.False(await queue.WaitAsync(null, In(TimeSpan.FromSeconds(1)), CancellationToken.None));
+        Assert.True(await queue.WaitAsync(null, In(TimeSpan.FromMinutes(1)), CancellationToken.None));
+        Assert.Equal(1, queue.ShedCount);
+    }
+
+    [Fact]
+    public async Task ShedsQueuedRequest_WhenDeadlinePasses()
+    {
+        using var queue = new AdmissionQueue(1);
+        Assert.True(await queue.WaitAsync(null, AdmissionQueue.NoDeadline, CancellationToken.None));
+
+        var waiting = queue.WaitAsync(null, In(TimeSpan.FromMilliseconds(50)), CancellationToken.None);
+        Assert.False(await waiting);
+        Assert.Equal(0, queue.QueueLength);
+        Assert.Equal(1, queue.ShedCount);
+    }
+
+    [Fact]
+    public async Task Cancellation_RemovesWaiter()
+    {
+        using var queue = new AdmissionQueue(1);
+        Assert.True(await queue.WaitAsync(null, AdmissionQueue.NoDeadline, CancellationToken.None));
+
+        using var cts = new CancellationTokenSource();
+        var waiting = queue.WaitAsync(null, AdmissionQueue.NoDeadline, cts.Token);
+        cts.Cancel();
+        await Assert.ThrowsAnyAsync<OperationCanceledException>(() => waiting);
+        Assert.Equal(0, queue.QueueLength);
+
+        // The slot goes back to the pool, not to the cancelled waiter
+        queue.Release(null);
+        Assert.True(await queue.WaitAsync(null, AdmissionQueue.NoDeadline, CancellationToken.None));
+    }
+
+    [Fact]
+    public async Task SharesSlotsAcrossTenants_ByWeight()
+    {
+        using var queue = new AdmissionQueue(1, new Dictionary<string, int> { ["interactive"] = 3 });
+        Assert.True(await queue.WaitAsync("bulk", AdmissionQueue.NoDeadline, CancellationToken.None));
+
+        // Bulk queued first; interactive still gets three admissions per bulk one
+        var bulk = Enumerable.Range(0, 8)
+            .Select(_ => queue.WaitAsync("bulk", AdmissionQueue.NoDeadline, CancellationToken.None)).ToList();
+        var interactive = Enumerable.Range(0, 6)
+            .Select(_ => queue.WaitAsync("interactive", AdmissionQueue.NoDeadline, CancellationToken.None)).ToList();
+
+        var waiting = bulk.Select(t => (tenant: "bulk", t))
+            .Concat(interactive.Select(t => (tenant: "interactive", t))).ToList();
+        var order = new List<string>();
+        string holder = "bulk";
+        for (int i = 0; i < 8; i++)
+        {
+            queue.Release(holder);
+            var admitted = waiting.Single(w => w.t.IsCompleted);
+            waiting.Remove(admitted);
+            holder = admitted.tenant;
+            order.Add(holder);
+        }
+
+        Assert.Equal(
+            "interactive,interactive,interactive,bulk,interactive,interactive,interactive,bulk",
+            string.Join(",", order));
+    }
+
+    [Fact]
+    public async Task TenantCap_LeavesSlotsForOthers()
+    {
+        using var queue = new AdmissionQueue(3, maxPerTenant: 2);
+        Assert.True(await queue.WaitAsync("bulk", AdmissionQueue.NoDeadline, CancellationToken.None));
+        Assert.True(await queue.WaitAsync("bulk", AdmissionQueue.NoDeadline, CancellationToken.None));
+
+        // A free slot exists, but bulk is at its cap
+        var third = queue.WaitAsync("bulk", AdmissionQueue.NoDeadline, CancellationToken.None);
+        Assert.False(third.IsCompleted);
+        Assert.Equal(1, queue.QueueLengthOf("bulk"));
+
+        Assert.True(await queue.WaitAsync("interactive", AdmissionQueue.NoDeadline, CancellationToken.None));
+
+        queue.Release("bulk");
+        Assert.True(await third);
+        Assert.Equal(0, queue.QueueLength);
+    }
+
+    [Fact]
+    public async Task IdleTenant_DoesNotBankCredit()
+    {
+        using var queue = new AdmissionQueue(1);
+        Assert.True(await queue.WaitAsync("a", AdmissionQueue.NoDeadline, CancellationToken.None));
+        var a = Enumerable.Range(0, 4)
+            .Select(_ => queue.WaitAsync("a", AdmissionQueue.NoDeadline, CancellationToken.None)).ToList();
+        for (int i = 0; i < 3; i++)
+        {
+            queue.Release("a");
+            Assert.True(await a[i]);
+        }
+
+        // b arrives after a was served four times: it alternates with a instead of
+        // taking the next four slots
+        var b = Enumerable.Range(0, 2)
+            .Select(_ => queue.WaitAsync("b", AdmissionQueue.NoDeadline, CancellationToken.None)).ToList();
+        queue.Release("a");
+        Assert.True(await b[0]);
+        queue.Release("b");
+        Assert.True(await a[3]);
+        Assert.False(b[1].IsCompleted);
+    }
+
+    /// <summary>
+    /// Fairness benchmark on simulated conversions: a bulk tenant queues a flood,
+    /// then an interactive tenant submits a few single requests. Each is admitted
+    /// within about one service time instead of waiting out the flood, which on a
+    /// single FIFO queue would take flood * service / slots (here 2 s).
+    /// </summary>
+    [Fact]
+    public async Task Fairness_InteractiveLatencyUnderBulkFlood()
+    {
+        const int slots = 2, flood = 400;
+        var service = TimeSpan.FromMilliseconds(10);
+        using var queue = new AdmissionQueue(slots);
+        using var drain = new CancellationTokenSource();
+
+        async Task Convert(string tenant)
+        {
+            Assert.True(await queue.WaitAsync(tenant, AdmissionQueue.NoDeadline, CancellationToken.None));
+            try
+            {
+                if (!drain.IsCancellationRequested)
+                    await Task.Delay(service);
+            }
+            finally
+            {
+                queue.Release(tenant);
+            }
+        }
+
+        var bulk = Enumerable.Range(0, flood).Select(_ => Convert("bulk")).ToList();
+        var waits = new List<TimeSpan>();
+        for (int i = 0; i < 5; i++)
+        {
+            var sw = System.Diagnostics.Stopwatch.StartNew();
+            await Convert("interactive");
+            waits.Add(sw.Elapsed - service);
+        }
+        drain.Cancel();
+        await Task.WhenAll(bulk);
+
+        var worst = waits.Max();
+        Assert.True(worst < TimeSpan.FromMilliseconds(500),
+            $"interactive wait {worst.TotalMilliseconds:F0} ms under a {flood}-request flood");
+    }
+
+    [Fact]
+    public async Task Pool_ShedsExpiredDeadline_WithoutStartingWorker()
+    {
+        // The worker path does not exist: reaching a worker would fail with InitFailed
+        await using var pool = new WorkerPool(new WorkerPoolSettings
+        {
+            WorkerPath = "/nonexistent/slimlo_worker",
+            ResourcePath = "/nonexistent",
+            Timeout = TimeSpan.FromSeconds(5),
+        });
+        var data = new byte[] { 0x50, 0x4B, 0x03, 0x04 };
+
+        var result = await pool.ExecuteBufferAsync(
+            new ConvertBufferRequest { Id = 1, DataSize = data.Length }, data, null,
+            AdmissionQueue.DeadlineAfter(TimeSpan.Zero), null, CancellationToken.None);
+
+        Assert.False(result.Success);
+        Assert.Equal(SlimLOErrorCode.DeadlineExceeded, result.ErrorCode);
+        Assert.Equal(1, pool.ShedCount);
+        Assert.Equal(0, pool.QueueLength);
+    }
+}
+
+// ===========================================================================
+// Elastic pool sizing tests
+// ===========================================================================
+
+public class ElasticPoolTests : IDisposable
+{
+    private readonly string _cgroup =
+        Path.Combine(Path.GetTempPath(), "slimlo-cgroup-" + Guid.NewGuid().ToString("N"));
+
+    public ElasticPoolTests() => Directory.CreateDirectory(_cgroup);
+
+    public void Dispose() => Directory.Delete(_cgroup, recursive: true);
+
+    [Fact]
+    public void NodeMemory_ReadsCgroupV2()
+    {
+        File.WriteAllText(Path.Combine(_cgroup, "memory.max"), "2147483648\n");
+        File.WriteAllText(Path.Combine(_cgroup, "memory.current"), "536870912\n");
+        Assert.Equal(2147483648L, NodeMemory.Limit(_cgroup));
+        Assert.Equal(536870912L, NodeMemory.Usage(_cgroup));
+    }
+
+    [Fact]
+    public void NodeMemory_UnlimitedCgroupV2_IsNull()
+    {
+        File.WriteAllText(Path.Combine(_cgroup, "memory.max"), "max\n");
+        Assert.Null(NodeMemory.Limit(_cgroup));
+    }
+
+    [Fact]
+    public void NodeMemory_ReadsCgroupV1()
+    {
+        Directory.CreateDirectory(Path.Combine(_cgroup, "memory"));
+        File.WriteAllText(Path.Combine(_cgroup, "memory", "memory.limit_in_bytes"), "1073741824\n");
+        File.WriteAllText(Path.Combine(_cgroup, "memory", "memory.usage_in_bytes"), "104857600\n");
+        Assert.Equal(1073741824L, NodeMemory.Limit(_cgroup));
+        Assert.Equal(104857600L, NodeMemory.Usage(_cgroup));
+
+        // v1 reports "no limit" as a huge page-aligned value
+        File.WriteAllText(Path.Combine(_cgroup, "memory", "memory.limit_in_bytes"), "9223372036854771712\n");
+        Assert.Null(NodeMemory.Limit(_cgroup));
+    }
+
+    [Fact]
+    public void NodeMemory_MissingCgroup_IsNull()
+    {
+        Assert.Null(NodeMemory.Limit(_cgroup));
+        Assert.Null(NodeMemory.Usage(_cgroup));
+    }
+
+    [Fact]
+    public void MemoryAllows_EstimatesWorkerFootprintFromGrowth()
+    {
+        const long MB = 1024 * 1024;
+        // No budget: always
+        Assert.True(WorkerPool.MemoryAllows(null, 10_000 * MB, 0, 8));
+        // Two workers grew the group from 100 MB to 700 MB: 300 MB each
+        Assert.True(WorkerPool.MemoryAllows(1000 * MB, 700 * MB, 100 * MB, 2));
+        Assert.False(WorkerPool.MemoryAllows(900 * MB, 700 * MB, 100 * MB, 2));
+        // Without usage figures each worker counts as the default footprint
+        Assert.True(WorkerPool.MemoryAllows(3 * WorkerPool.DefaultWorkerMemory, null, 0, 2));
+        Assert.False(WorkerPool.MemoryAllows(3 * WorkerPool.DefaultWorkerMemory - 1, null, 0, 2));
+    }
+
+    [Fact]
+    public async Task Pool_StartsWithoutWorkers()
+    {
+        await using var pool = new WorkerPool(new WorkerPoolSettings
+        {
+            WorkerPath = "/nonexistent/slimlo_worker",
+            ResourcePath = "/nonexistent",
+            MaxWorkers = 4,
+            Timeout = TimeSpan.FromSeconds(5),
+            MinWorkers = 1,
+            IdleTimeout = TimeSpan.FromMilliseconds(200),
+            MemoryBudget = 1L << 30,
+            MemoryUsage = () => null,
+        });
+        Assert.Equal(0, pool.WorkerCount);
+    }
+}
+
+
+// ===========================================================================
+// Worker CPU placement tests
+// ===========================================================================
+
+public class CpuTopologyTests : IDisposable
+{
+    private readonly string _sys =
+        Path.Combine(Path.GetTempPath(), "slimlo-nodes-" + Guid.NewGuid().ToString("N"));
+
+    public CpuTopologyTests() => Directory.CreateDirectory(_sys);
+
+    public void Dispose() => Directory.Delete(_sys, recursive: true);
+
+    private void WriteNode(int id, string cpuList)
+    {
+        var dir = Path.Combine(_sys, "node" + id);
+        Directory.CreateDirectory(dir);
+        File.WriteAllText(Path.Combine(dir, "cpulist"), cpuList + "\n");
+    }
+
+    private static string Format(IReadOnlyList<int>[] sets) =>
+        string.Join(" | ", sets.Select(s => string.Join(",", s)));
+
+    [Fact]
+    public void ParseCpuList_RangesAndSingles()
+    {
+        Assert.Equal(new[] { 0, 1, 2, 3, 8, 10, 11 }, CpuTopology.ParseCpuList("0-3,8,10-11\n")!.ToArray());
+        Assert.Empty(CpuTopology.ParseCpuList("\n")!);
+        Assert.Null(CpuTopology.ParseCpuList("3-1"));
+        Assert.Null(CpuTopology.ParseCpuList("a-b"));
+    }
+
+    [Fact]
+    public void Nodes_ReadsSysfsRestrictedToAllowedCpus()
+    {
+        WriteNode(1, "4-7");
+        WriteNode(0, "0-3");
+        Directory.CreateDirectory(Path.Combine(_sys, "node2")); // memory-only node: no cpulist
+        var status = Path.Combine(_sys, "status");
+        File.WriteAllText(status, "Name:\tdotnet\nCpus_allowed_list:\t1-6\n");
+
+        var nodes = CpuTopology.Nodes(_sys, status);
+        Assert.Equal(2, nodes.Count);
+        Assert.Equal(new[] { 1, 2, 3 }, nodes[0]);
+        Assert.Equal(new[] { 4, 5, 6 }, nodes[1]);
+    }
+
+    [Fact]
+    public void Nodes_WithoutSysfs_IsOneNodeOfAllCpus()
+    {
+        var nodes = CpuTopology.Nodes(Path.Combine(_sys, "missing"), Path.Combine(_sys, "missing"));
+        Assert.Single(nodes);
+        Assert.Equal(Environment.ProcessorCount, nodes[0].Count);
+    }
+
+    [Fact]
+    public void Partition_AlternatesNodesAndSplitsEachNode()
+    {
+        var nodes = new[] { new[] { 0, 1, 2, 3 }, new[] { 4, 5, 6, 7 } };
+        Assert.Equal("0,1 | 4,5 | 2,3 | 6,7", Format(CpuTopology.Partition(nodes, 4)));
+        // Odd counts: node 0 holds two workers, node 1 one
+        Assert.Equal("0,1 | 4,5,6,7 | 2,3", Format(CpuTopology.Partition(nodes, 3)));
+        Assert.Equal("0,1,2,3", Format(CpuTopology.Partition(nodes, 1)));
+    }
+
+    [Fact]
+    public void Partition_MoreWorkersThanCpus_SharesCpus()
+    {
+        var nodes = new[] { new[] { 0, 1 } };
+        Assert.Equal("0 | 0 | 1 | 1", Format(CpuTopology.Partition(nodes, 4)));
+    }
+}
+
+// ===========================================================================
+// slimlo_server connection tests (a fake server on a Unix socket)
+// ===========================================================================
+
+public class ServerConnectionTests : IDisposable
+{
+    private readonly string _path =
+        Path.Combine(Path.GetTempPath(), "slimlo-" + Guid.NewGuid().ToString("N") + ".sock");
+    private readonly Socket _listener = new(AddressFamily.Unix, SocketType.Stream, ProtocolType.Unspecified);
+
+    public ServerConnectionTests()
+    {
+        _listener.Bind(new UnixDomainSocketEndPoint(_path));
+        _listener.Listen(4);
+    }
+
+    public void Dispose()
+    {
+        _listener.Dispose();
+        File.Delete(_path);
+    }
+
+    private static async Task<JsonElement> ReadJsonAsync(Stream stream)
+    {
+        var bytes = await Protocol.ReadMessageAsync(stream, CancellationToken.None);
+        Assert.NotNull(bytes);
+        using var doc = Protocol.Deserialize(bytes!);
+        return doc.RootElement.Clone();
+    }
+
+    private static Task WriteJsonAsync(Stream stream, string json) =>
+        Protocol.WriteMessageAsync(stream, Encoding.UTF8.GetBytes(json), CancellationToken.None);
+
+    /// <summary>Accept one client and answer its init like slimlo_server.</summary>
+    private async Task<NetworkStream> AcceptAsync()
+    {
+        var client = await _listener.AcceptAsync();
+        var stream = new NetworkStream(client, ownsSocket: true);
+        Assert.Equal("init", (await ReadJsonAsync(stream)).GetProperty("type").GetString());
+        await WriteJsonAsync(stream, "{\"type\":\"ready\",\"version\":\"server-1\"}");
+        return stream;
+    }
+
+    /// <summary>Read a convert_buffer request and echo the document back as the PDF.</summary>
+    private static async Task EchoBufferAsync(Stream stream)
+    {
+        var request = await ReadJsonAsync(stream);
+        Assert.Equal("convert_buffer", request.GetProperty("type").GetString());
+        var data = await Protocol.ReadMessageAsync(stream, CancellationToken.None);
+        await WriteJsonAsync(stream,
+            "{\"type\":\"buffer_result\",\"id\":" + request.GetProperty("id").GetInt32() +
+            ",\"success\":true,\"data_size\":" + data!.Length + ",\"diagnostics\":[]}");
+        await Protocol.WriteMessageAsync(stream, data, CancellationToken.None);
+    }
+
+    [Fact]
+    public void Create_WithEmptyServerSocket_Throws()
+    {
+        Assert.Throws<ArgumentException>(() =>
+            PdfConverter.Create(new PdfConverterOptions { ServerSocket = "" }));
+    }
+
+    [Fact]
+    public async Task ConvertAsync_WithServerSocket_RunsOnTheServer()
+    {
+        var server = Task.Run(async () =>
+        {
+            using var stream = await AcceptAsync();
+            await EchoBufferAsync(stream);
+            Assert.Equal("quit", (await ReadJsonAsync(stream)).GetProperty("type").GetString());
+        });
+
+        var converter = PdfConverter.Create(new PdfConverterOptions { ServerSocket = _path });
+        var result = await converter.ConvertAsync(new byte[] { 1, 2, 3 }, DocumentFormat.Docx);
+        await converter.DisposeAsync();
+        await server;
+
+        Assert.True(result.Success, result.ErrorMessage);
+        Assert.Equal(new byte[] { 1, 2, 3 }, result.Data!);
+    }
+
+    [Fact]
+    public async Task AddFontDirectoryAsync_RegistersWithLiveWorkerOnce()
+    {
+        var fonts = Directory.CreateTempSubdirectory("slimlo-fonts").FullName;
+        try
+        {
+            var server = Task.Run(async () =>
+            {
+                using var stream = await AcceptAsync();
+                await EchoBufferAsync(stream);
+
+                var request = await ReadJsonAsync(stream);
+                Assert.Equal("add_fonts", request.GetProperty("type").GetString());
+                Assert.Equal(fonts, request.GetProperty("paths")[0].GetString());
+                await WriteJsonAsync(stream,
+                    "{\"type\":\"fonts_result\",\"id\":0,\"success\":true,\"diagnostics\":[]}");
+
+                // Up to date: the next request is the conversion itself
+                await EchoBufferAsync(stream);
+            });
+
+            await using var converter = PdfConverter.Create(new PdfConverterOptions
+            {
+                ServerSocket = _path,
+                MaxWorkers = 1
+            });
+            Assert.True((await converter.ConvertAsync(new byte[] { 1 }, DocumentFormat.Docx)).Success);
+            var added = await converter.AddFontDirectoryAsync(fonts);
+            var again = await converter.AddFontDirectoryAsync(fonts);
+            var after = await converter.ConvertAsync(new byte[] { 2 }, DocumentFormat.Docx);
+            await server;
+
+            Assert.True(added.Success, added.ErrorMessage);
+            Assert.True(again.Success, again.ErrorMessage);
+            Assert.True(after.Success, after.ErrorMessage);
+        }
+        finally
+        {
+            Directory.Delete(fonts);
+        }
+    }
+
+    [Fact]
+    public async Task Convert_FontCatchUpRejected_ReportsItAsDiagnostic()
+    {
+        var fonts = Directory.CreateTempSubdirectory("slimlo-fonts").FullName;
+        try
+        {
+            var server = Task.Run(async () =>
+            {
+                using var stream = await AcceptAsync();
+                await EchoBufferAsync(stream);
+
+                Assert.Equal("add_fonts", (await ReadJsonAsync(stream)).GetProperty("type").GetString());
+                await WriteJsonAsync(stream,
+                    "{\"type\":\"fonts_result\",\"id\":0,\"success\":false," +
+                    "\"error_message\":\"no fonts here\",\"error_code\":1,\"diagnostics\":[]}");
+                await EchoBufferAsync(stream);
+            });
+
+            await using var converter = PdfConverter.Create(new PdfConverterOptions
+            {
+                ServerSocket = _path,
+                MaxWorkers = 1
+            });
+            Assert.True((await converter.ConvertAsync(new byte[] { 1 }, DocumentFormat.Docx)).Success);
+            // The broadcast is cancelled, so the worker catches up before its next request
+            using var cancelled = new CancellationTokenSource();
+            cancelled.Cancel();
+            await Assert.ThrowsAnyAsync<OperationCanceledException>(
+                () => converter.AddFontDirectoryAsync(fonts, cancelled.Token));
+            var after = await converter.ConvertAsync(new byte[] { 2 }, DocumentFormat.Docx);
+            await server;
+
+            Assert.True(after.Success, after.ErrorMessage);
+            var warning = Assert.Single(after.Diagnostics);
+            Assert.Equal(DiagnosticCategory.Font, warning.Category);
+            Assert.Contains("no fonts here", warning.Message);
+        }
+        finally
+        {
+            Directory.Delete(fonts);
+        }
+    }
+
+    [Fact]
+    public async Task Convert_WorkerLostInFontCatchUp_RunsOnItsReplacement()
+    {
+        var fonts = Directory.CreateTempSubdirectory("slimlo-fonts").FullName;
+        try
+        {
+            var server = Task.Run(async () =>
+            {
+                using (var stream = await AcceptAsync())
+                {
+                    await EchoBufferAsync(stream);
+                    // Drop the connection mid-exchange, as a crashing worker would
+                    Assert.Equal("add_fonts", (await ReadJsonAsync(stream)).GetProperty("type").GetString());
+                }
+                using var replacement = await AcceptAsync();
+                await EchoBufferAsync(replacement);
+            });
+
+            await using var converter = PdfConverter.Create(new PdfConverterOptions
+            {
+                ServerSocket = _path,
+                MaxWorkers = 1
+            });
+            Assert.True((await converter.ConvertAsync(new byte[] { 1 }, DocumentFormat.Docx)).Success);
+            using var cancelled = new CancellationTokenSource();
+            cancelled.Cancel();
+            await Assert.ThrowsAnyAsync<OperationCanceledException>(
+                () => converter.AddFontDirectoryAsync(fonts, cancelled.Token));
+            var after = await converter.ConvertAsync(new byte[] { 2 }, DocumentFormat.Docx);
+
+            Assert.True(after.Success, after.ErrorMessage);
+            Assert.Equal(new byte[] { 2 }, after.Data!);
+            Assert.Contains("replaced", Assert.Single(after.Diagnostics).Message);
+            await server;
+        }
+        finally
+        {
+            Directory.Delete(fonts);
+        }
+    }
+
+    [Fact]
+    public async Task AddFontDirectoryAsync_MissingDirectory_FailsWithoutWorker()
+    {
+        await using var converter = PdfConverter.Create(new PdfConverterOptions { ServerSocket = _path });
+
+        var result = await converter.AddFontDirectoryAsync("/nonexistent/slimlo-fonts");
+
+        Assert.False(result.Success);
+        Assert.Equal(SlimLOErrorCode.FileNotFound, result.ErrorCode);
+    }
+
+    [Fact]
+    public async Task Pool_CancelledWhileWaitingForSlot_ReleasesItsAdmission()
+    {
+        var release = new TaskCompletionSource<bool>(TaskCreationOptions.RunContinuationsAsynchronously);
+        var server = Task.Run(async () =>
+        {
+            using var stream = await AcceptAsync();
+            await release.Task;
+            await EchoBufferAsync(stream); // the request holding the only worker
+            await EchoBufferAsync(stream); // the one admitted after the cancellation
+        });
+
+        // The budget is spent once one worker runs, so a second request waits for its slot
+        await using var pool = new WorkerPool(new WorkerPoolSettings
+        {
+            MaxWorkers = 2,
+            Timeout = TimeSpan.FromSeconds(30),
+            MemoryBudget = 1,
+            MemoryUsage = () => 1L << 40,
+            ServerSocket = _path,
+        });
+        Task<ConversionResult<byte[]>> Convert(byte value, CancellationToken ct) => pool.ExecuteBufferAsync(
+            new ConvertBufferRequest { Id = value, DataSize = 1 }, new[] { value }, null,
+            AdmissionQueue.NoDeadline, null, ct);
+
+        var holding = Convert(1, CancellationToken.None);
+        for (int i = 0; i < 100 && pool.WorkerCount == 0; i++)
+            await Task.Delay(10);
+        using var cts = new CancellationTokenSource();
+        var waiting = Convert(2, cts.Token);
+        await Task.Delay(50);
+        cts.Cancel();
+        await Assert.ThrowsAnyAsync<OperationCanceledException>(() => waiting);
+
+        // Admitted rather than queued: the cancelled request gave its admission back
+        var next = Convert(3, CancellationToken.None);
+        await Task.Delay(50);
+        Assert.Equal(0, pool.QueueLength);
+
+        release.SetResult(true);
+        Assert.True((await holding).Success);
+        var result = await next;
+        await server;
+        Assert.True(result.Success, result.ErrorMessage);
+        Assert.Equal(new byte[] { 3 }, result.Data!);
+    }
+
+    [Fact]
+    public async Task ConvertAsync_ServerDropsConnection_FailsThenReconnects()
+    {
+        var server = Task.Run(async () =>
+        {
+            // The worker serving the first request "crashes": the server hangs up
+            using (var first = await AcceptAsync())
+            {
+                await ReadJsonAsync(first);
+                await Protocol.ReadMessageAsync(first, CancellationToken.None);
+            }
+            using var second = await AcceptAsync();
+            await EchoBufferAsync(second);
+        });
+
+        await using var converter = PdfConverter.Create(new PdfConverterOptions
+        {
+            ServerSocket = _path,
+            QuarantineAfterCrashes = 0
+        });
+        var crashed = await converter.ConvertAsync(new byte[] { 1 }, DocumentFormat.Docx);
+        var retried = await converter.ConvertAsync(new byte[] { 2 }, DocumentFormat.Docx);
+        await server;
+
+        Assert.False(crashed.Success);
+        Assert.Contains("crashed", crashed.ErrorMessage);
+        Assert.True(retried.Success, retried.ErrorMessage);
+        Assert.Equal(new byte[] { 2 }, retried.Data!);
+    }
+}
+
+// ===========================================================================
+// Single-flight coalescing tests
+// ===========================================================================
+
+public class SingleFlightTests
+{
+    [Fact]
+    public async Task ConcurrentDuplicates_RunOnceAndShareResult()
+    {
+        var flights = new SingleFlight();
+        var release = new TaskCompletionSource<string>(TaskCreationOptions.RunContinuationsAsynchronously);
+        int runs = 0;
+        Task<string> Run(CancellationToken _)
+        {
+            Interlocked.Increment(ref runs);
+            return release.Task;
+        }
+
+        var callers = Enumerable.Range(0, 5)
+            .Select(_ => flights.RunAsync("doc", Run, CancellationToken.None))
+            .ToArray();
+        release.SetResult("pdf");
+        var results = await Task.WhenAll(callers);
+
+        Assert.Equal(1, runs);
+        Assert.All(results, r => Assert.Equal("pdf", r));
+        Assert.Equal(4, flights.CoalescedCount);
+        Assert.Equal(0, flights.Count);
+    }
+
+    [Fact]
+    public async Task ConcurrentDuplicates_WithCopy_EachGetTheirOwnResult()
+    {
+        var flights = new SingleFlight();
+        var release = new TaskCompletionSource<byte[]>(TaskCreationOptions.RunContinuationsAsynchronously);
+        static byte[] Copy(byte[] shared) => (byte[])shared.Clone();
+
+        var callers = Enumerable.Range(0, 3)
+            .Select(_ => flights.RunAsync("doc", _ => release.Task, CancellationToken.None, Copy))
+            .ToArray();
+        var pdf = new byte[] { 1, 2, 3 };
+        release.SetResult(pdf);
+        var results = await Task.WhenAll(callers);
+
+        Assert.All(results, r => Assert.Equal(pdf, r));
+        Assert.All(results, r => Assert.NotSame(pdf, r));
+        Assert.Equal(3, results.Distinct().Count());
+    }
+
+    [Fact]
+    public async Task SingleCaller_WithCopy_GetsTheResultUncopied()
+    {
+        var flights = new SingleFlight();
+        var pdf = new byte[] { 1, 2, 3 };
+        Assert.Same(pdf, await flights.RunAsync("doc", _ => Task.FromResult(pdf), CancellationToken.None,
+            shared => (byte[])shared.Clone()));
+    }
+
+    [Fact]
+    public async Task DistinctKeys_RunSeparately()
+    {
+        var flights = new SingleFlight();
+        var a = flights.RunAsync("a", _ => Task.FromResult(1), CancellationToken.None);
+        var b = flights.RunAsync("b", _ => Task.FromResult(2), CancellationToken.None);
+        Assert.Equal(1, await a);
+        Assert.Equal(2, await b);
+        Assert.Equal(0, flights.CoalescedCount);
+    }
+
+    [Fact]
+    public async Task CompletedFlight_IsNotCached()
+    {
+        var flights = new SingleFlight();
+        int runs = 0;
+        Task<int> Run(CancellationToken _) => Task.FromResult(Interlocked.Increment(ref runs));
+
+        Assert.Equal(1, await flights.RunAsync("doc", Run, CancellationToken.None));
+        Assert.Equal(2, await flights.RunAsync("doc", Run, CancellationToken.None));
+    }
+
+    [Fact]
+    public async Task Exception_ReachesEveryCaller()
+    {
+        var flights = new SingleFlight();
+        var release = new TaskCompletionSource<int>(TaskCreationOptions.RunContinuationsAsynchronously);
+        var first = flights.RunAsync("doc", _ => release.Task, CancellationToken.None);
+        var second = flights.RunAsync("doc", _ => release.Task, CancellationToken.None);
+        release.SetException(new IOException("worker died"));
+
+        await Assert.ThrowsAsync<IOException>(() => first);
+        await Assert.ThrowsAsync<IOException>(() => second);
+    }
+
+    [Fact]
+    public async Task OneCallerCancelling_DoesNotCancelTheOthers()
+    {
+        var flights = new SingleFlight();
+        var release = new TaskCompletionSource<string>(TaskCreationOptions.RunContinuationsAsynchronously);
+        CancellationToken shared = default;
+        Task<string> Run(CancellationToken token)
+        {
+            shared = token;
+            return release.Task;
+        }
+
+        using var cts = new CancellationTokenSource();
+        var leaving = flights.RunAsync("doc", Run, cts.Token);
+        var staying = flights.RunAsync("doc", Run, CancellationToken.None);
+        cts.Cancel();
+        await Assert.ThrowsAnyAsync<OperationCanceledException>(() => leaving);
+
+        await Task.Delay(50);
+        Assert.False(shared.IsCancellationRequested);
+        release.SetResult("pdf");
+        Assert.Equal("pdf", await staying);
+    }
+
+    [Fact]
+    public async Task AllCallersCancelling_CancelsTheOperation()
+    {
+        var flights = new SingleFlight();
+        var started = new TaskCompletionSource<bool>(TaskCreationOptions.RunContinuationsAsynchronously);
+        async Task<string> Run(CancellationToken token)
+        {
+            started.SetResult(true);
+            await Task.Delay(Timeout.Infinite, token);
+            return "pdf";
+        }
+
+        using var cts1 = new CancellationTokenSource();
+        using var cts2 = new CancellationTokenSource();
+        var first = flights.RunAsync("doc", Run, cts1.Token);
+        var second = flights.RunAsync("doc", Run, cts2.Token);
+        await started.Task;
+        cts1.Cancel();
+        cts2.Cancel();
+        await Assert.ThrowsAnyAsync<OperationCanceledException>(() => first);
+        await Assert.ThrowsAnyAsync<OperationCanceledException>(() => second);
+
+        for (int i = 0; i < 100 && flights.Count > 0; i++)
+            await Task.Delay(10);
+        Assert.Equal(0, flights.Count);
+    }
+
+    [Fact]
+    public async Task CallerAfterAllCancelled_RunsItsOwnFlight()
+    {
+        var flights = new SingleFlight();
+        var started = new TaskCompletionSource<bool>(TaskCreationOptions.RunContinuationsAsynchronously);
+        var release = new TaskCompletionSource<bool>(TaskCreationOptions.RunContinuationsAsynchronously);
+        int runs = 0;
+        async Task<string> Abandoned(CancellationToken token)
+        {
+            Interlocked.Increment(ref runs);
+            started.SetResult(true);
+            await release.Task; // still in flight after its token fired
+            token.ThrowIfCancellationRequested();
+            return "stale";
+        }
+        Task<string> Fresh(CancellationToken token)
+        {
+            Interlocked.Increment(ref runs);
+            return Task.FromResult("pdf");
+        }
+
+        using var cts1 = new CancellationTokenSource();
+        using var cts2 = new CancellationTokenSource();
+        var first = flights.RunAsync("doc", Abandoned, cts1.Token);
+        var second = flights.RunAsync("doc", Abandoned, cts2.Token);
+        await started.Task;
+        cts1.Cancel();
+        cts2.Cancel();
+        await Assert.ThrowsAnyAsync<OperationCanceledException>(() => first);
+        await Assert.ThrowsAnyAsync<OperationCanceledException>(() => second);
+
+        var third = flights.RunAsync("doc", Fresh, CancellationToken.None);
+        release.SetResult(true);
+
+        Assert.Equal("pdf", await third);
+        Assert.Equal(2, runs);
+        Assert.Equal(1, flights.CoalescedCount);
+        for (int i = 0; i < 100 && flights.Count > 0; i++)
+            await Task.Delay(10);
+        Assert.Equal(0, flights.Count);
+    }
+}
+
+// ===========================================================================
+// StderrDiagnosticParser tests
+// ===========================================================================
+
+public class StderrDiagnosticParserTests
+{
+    private static JsonElement ParseJson(string json)
+    {
+        using var doc = JsonDocument.Parse(json);
+        return doc.RootElement.Clone();
+    }
+
+    [Fact]
+    public void ParseFromJson_EmptyArray_ReturnsEmpty()
+    {
+        var element = ParseJson("[]");
+        var result = StderrDiagnosticParser.ParseFromJson(element);
+        Assert.Empty(result);
+    }
+
+    [Fact]
+    public void ParseFromJson_NonArray_ReturnsEmpty()
+    {
+        var element = ParseJson("\"not an array\"");
+        var result = StderrDiagnosticParser.ParseFromJson(element);
+        Assert.Empty(result);
+    }
+
+    [Fact]
+    public void ParseFromJson_NullValueKind_ReturnsEmpty()
+    {
+        var element = ParseJson("null");
+        var result = StderrDiagnosticParser.ParseFromJson(element);
+        Assert.Empty(result);
+    }
+
+    [Fact]
+    public void ParseFromJson_FontWarning_FullProperties()
+    {
+        var json = "[{\"severity\":\"warning\",\"category\":\"font\"," +
+            "\"message\":\"Could not find font 'Arial Narrow'\"," +
+            "\"font\":\"Arial Narrow\",\"substituted_with\":\"Liberation Sans\"}]";
+        var element = ParseJson(json);
+        var result = StderrDiagnosticParser.ParseFromJson(element);
+
+        Assert.Single(result);
+        Assert.Equal(DiagnosticSeverity.Warning, result[0].Severity);
+        Assert.Equal(DiagnosticCategory.Font, result[0].Category);
+        Assert.Equal("Could not find font 'Arial Narrow'", result[0].Message);
+        Assert.Equal("Arial Narrow", result[0].FontName);
+        Assert.Equal("Liberation Sans", result[0].SubstitutedWith);
+    }
+
+    [Fact]
+    public void ParseFromJson_InfoSeverity()
+    {
+        var json = "[{\"severity\":\"info\",\"category\":\"general\",\"message\":\"Info message\"}]";
+        var element = ParseJson(json);
+        var result = StderrDiagnosticParser.ParseFromJson(element);
+
+        Assert.Single(result);
+        Assert.Equal(DiagnosticSeverity.Info, result[0].Severity);
+        Assert.Equal(DiagnosticCategory.General, result[0].Category);
+    }
+
+    [Fact]
+    public void ParseFromJson_LayoutCategory()
+    {
+        var json = "[{\"severity\":\"warning\",\"category\":\"layout\",\"message\":\"Layout issue\"}]";
+        var element = ParseJson(json);
+        var result = StderrDiagnosticParser.ParseFromJson(element);
+
+        Assert.Single(result);
+        Assert.Equal(DiagnosticCategory.Layout, result[0].Category);
+    }
+
+    [Fact]
+    public void ParseFromJson_UnknownSeverity_DefaultsToWarning()
+    {
+        var json = "[{\"severity\":\"critical\",\"category\":\"font\",\"message\":\"msg\"}]";
+        var element = ParseJson(json);
+        var result = StderrDiagnosticParser.ParseFromJson(element);
+
+        Assert.Single(result);
+        Assert.Equal(DiagnosticSeverity.Warning, result[0].Severity);
+    }
+
+    [Fact]
+    public void ParseFromJson_UnknownCategory_DefaultsToGeneral()
+    {
+        var json = "[{\"severity\":\"warning\",\"category\":\"network\",\"message\":\"msg\"}]";
+        var element = ParseJson(json);
+        var result = StderrDiagnosticParser.ParseFromJson(element);
+
+        Assert.Single(result);
+        Assert.Equal(DiagnosticCategory.General, result[0].Category);
+    }
+
+    [Fact]
+    public void ParseFromJson_MinimalDiagnostic_MissingOptionalFields()
+    {
+        var json = "[{\"message\":\"just a message\"}]";
+        var element = ParseJson(json);
+        var result = StderrDiagnosticParser.ParseFromJson(element);
+
+        Assert.Single(result);
+        Assert.Equal(DiagnosticSeverity.Warning, result[0].Severity);
+        Assert.Equal(DiagnosticCategory.General, result[0].Category);
+        Assert.Equal("just a message", result[0].Message);
+        Assert.Null(result[0].FontName);
+        Assert.Null(result[0].SubstitutedWith);
+    }
+
+    [Fact]
+    public void ParseFromJson_MultipleDiagnostics()
+    {
+        var json = "[{\"severity\":\"warning\",\"category\":\"font\",\"message\":\"Font 1\",\"font\":\"F1\"}," +
+            "{\"severity\":\"info\",\"category\":\"layout\",\"message\":\"Layout 1\"}," +
+            "{\"severity\":\"warning\",\"category\":\"general\",\"message\":\"General 1\"}]";
+        var element = ParseJson(json);
+        var result = StderrDiagnosticParser.ParseFromJson(element);
+
+        Assert.Equal(3, result.Count);
+        Assert.Equal("Font 1", result[0].Message);
+        Assert.Equal("Layout 1", result[1].Message);
+        Assert.Equal("General 1", result[2].Message);
+    }
+
+    [Fact]
+    public void ParseFromJson_EmptyObject_UsesDefaults()
+    {
+        var json = "[{}]";
+        var element = ParseJson(json);
+        var result = StderrDiagnosticParser.ParseFromJson(element);
+
+        Assert.Single(result);
+        Assert.Equal(DiagnosticSeverity.Warning, result[0].Severity);
+        Assert.Equal(DiagnosticCategory.General, result[0].Category);
+        Assert.Equal("", result[0].Message);
+    }
+}
+
+// ===========================================================================
+// PdfConverter.Create tests (no worker needed for validation tests)
+// ===========================================================================
+
+public class PdfConverterCreateTests
+{
+    [Fact]
+    public void Create_WithZeroMaxWorkers_Throws()
+    {
+        Assert.Throws<ArgumentOutOfRangeException>(() =>
+            PdfConverter.Create(new PdfConverterOptions { MaxWorkers = 0 }));
+    }
+
+    [Fact]
+    public void Create_WithNegativeMaxWorkers_Throws()
+    {
+        Assert.Throws<ArgumentOutOfRangeException>(() =>
+            PdfConverter.Create(new PdfConverterOptions { MaxWorkers = -1 }));
+    }
+
+    [Fact]
+    public void Create_WithNonPositiveStallTimeout_Throws()
+    {
+        Assert.Throws<ArgumentOutOfRangeException>(() =>
+            PdfConverter.Create(new PdfConverterOptions { StallTimeout = TimeSpan.Zero }));
+    }
+
+    [Fact]
+    public void Create_WithMinWorkersAboveMaxWorkers_Throws()
+    {
+        Assert.Throws<ArgumentOutOfRangeException>(() =>
+            PdfConverter.Create(new PdfConverterOptions { MaxWorkers = 2, MinWorkers = 3 }));
+    }
+
+    [Fact]
+    public void Create_WithNonPositiveIdleTimeout_Throws()
+    {
+        Assert.Throws<ArgumentOutOfRangeException>(() =>
+            PdfConverter.Create(new PdfConverterOptions { IdleTimeout = TimeSpan.Zero }));
+    }
+
+    [Fact]
+    public void Create_WithNegativeThreadsPerWorker_Throws()
+    {
+        Assert.Throws<ArgumentOutOfRangeException>(() =>
+            PdfConverter.Create(new PdfConverterOptions { ThreadsPerWorker = -1 }));
+    }
+
+    [Fact]
+    public void Create_WithNegativeQuarantineAfterCrashes_Throws()
+    {
+        Assert.Throws<ArgumentOutOfRangeException>(() =>
+            PdfConverter.Create(new PdfConverterOptions { QuarantineAfterCrashes = -1 }));
+    }
+
+    [Fact]
+    public void Create_WithZeroQuarantineCapacity_Throws()
+    {
+        Assert.Throws<ArgumentOutOfRangeException>(() =>
+            PdfConverter.Create(new PdfConverterOptions { QuarantineCapacity = 0 }));
+    }
+
+    [Fact]
+    public void Version_DoesNotThrow()
+    {
+        // Version uses P/Invoke -- may return null if library not found,
+        // but should never throw
+        var version = PdfConverter.Version;
+        // Can be null if native lib not available; just verify no crash
+    }
+}
+
+// ===========================================================================
+// InProcessConverter tests (native options, LibreOffice thread, validation)
+// ===========================================================================
+
+public class InProcessConverterTests
+{
+    [Fact]
+    public void FilterOptionsString_Null_ReturnsNull()
+    {
+        Assert.Null(NativeOptions.FilterOptionsString(null));
+        Assert.Null(NativeOptions.FilterOptionsString(new Dictionary<string, string>()));
     }
 
     [Fact]
-    public void ParseFromJson_LayoutCategory()
+    public void FilterOptionsString_JoinsPairs_SkipsEmptyKeys()
     {
-        var json = "[{\"severity\":\"warning\",\"category\":\"layout\",\"message\":\"Layout issue\"}]";
-        var element = ParseJson(json);
-        var result = StderrDiagnosticParser.ParseFromJson(element);
+        var properties = new Dictionary<string, string>
+        {
+            ["ExportNotes"] = "true",
+            [""] = "ignored",
+            ["IsSkipEmptyPages"] = "false"
+        };
 
-        Assert.Single(result);
-        Assert.Equal(DiagnosticCategory.Layout, result[0].Category);
+        Assert.Equal("ExportNotes=true,IsSkipEmptyPages=false",
+            NativeOptions.FilterOptionsString(properties));
     }
 
     [Fact]
-    public void ParseFromJson_UnknownSeverity_DefaultsToWarning()
+    public unsafe void FromConversionOptions_MapsFieldsAndStrings()
     {
-        var json = "[{\"severity\":\"critical\",\"category\":\"font\",\"message\":\"msg\"}]";
-        var element = ParseJson(json);
-        var result = StderrDiagnosticParser.ParseFromJson(element);
-
-        Assert.Single(result);
-        Assert.Equal(DiagnosticSeverity.Warning, result[0].Severity);
+        using var strings = new NativeStrings();
+        var native = NativeOptions.FromConversionOptions(new ConversionOptions
+        {
+            Preset = PdfPreset.Archival,
+            PdfVersion = PdfVersion.PdfA2,
+            JpegQuality = 80,
+            Dpi = 150,
+            TaggedPdf = true,
+            PageRange = "1-3",
+            LazyLayout = true,
+            FilterProperties = new Dictionary<string, string> { ["ExportNotes"] = "true" }
+        }, strings);
+
+        Assert.Equal((int)PdfPreset.Archival, native.Preset);
+        Assert.Equal((int)PdfVersion.PdfA2, native.PdfVersion);
+        Assert.Equal(80, native.JpegQuality);
+        Assert.Equal(150, native.Dpi);
+        Assert.Equal(1, native.TaggedPdf);
+        Assert.Equal(1, native.LazyLayout);
+        Assert.Equal(0, native.SkipFieldUpdate);
+        Assert.Equal("1-3", new string((sbyte*)native.PageRange));
+        Assert.Equal("ExportNotes=true", new string((sbyte*)native.FilterOptions));
+        Assert.Equal(IntPtr.Zero, native.Password);
     }
 
     [Fact]
-    public void ParseFromJson_UnknownCategory_DefaultsToGeneral()
+    public async Task LibreOfficeThread_RunsWorkInOrderOnOneThread()
     {
-        var json = "[{\"severity\":\"warning\",\"category\":\"network\",\"message\":\"msg\"}]";
-        var element = ParseJson(json);
-        var result = StderrDiagnosticParser.ParseFromJson(element);
+        using var thread = new LibreOfficeThread("test");
+        var order = new List<int>();
+        var threadIds = new HashSet<int>();
 
-        Assert.Single(result);
-        Assert.Equal(DiagnosticCategory.General, result[0].Category);
+        var tasks = Enumerable.Range(0, 10).Select(i => thread.RunAsync(() =>
+        {
+            order.Add(i);
+            threadIds.Add(Environment.CurrentManagedThreadId);
+            return i;
+        })).ToArray();
+        await Task.WhenAll(tasks);
+
+        Assert.Equal(Enumerable.Range(0, 10).ToList(), order);
+        Assert.Single(threadIds);
+        Assert.NotEqual(Environment.CurrentManagedThreadId, threadIds.First());
     }
 
     [Fact]
-    public void ParseFromJson_MinimalDiagnostic_MissingOptionalFields()
+    public async Task LibreOfficeThread_CancelledBeforeStart_DoesNotRun()
     {
-        var json = "[{\"message\":\"just a message\"}]";
-        var element = ParseJson(json);
-        var result = StderrDiagnosticParser.ParseFromJson(element);
+        using var thread = new LibreOfficeThread("test");
+        using var gate = new ManualResetEventSlim();
+        var blocker = thread.RunAsync(() => gate.Wait(TimeSpan.FromSeconds(10)));
 
-        Assert.Single(result);
-        Assert.Equal(DiagnosticSeverity.Warning, result[0].Severity);
-        Assert.Equal(DiagnosticCategory.General, result[0].Category);
-        Assert.Equal("just a message", result[0].Message);
-        Assert.Null(result[0].FontName);
-        Assert.Null(result[0].SubstitutedWith);
+        using var cts = new CancellationTokenSource();
+        var ran = false;
+        var queued = thread.RunAsync(() => ran = true, cts.Token);
+        cts.Cancel();
+        gate.Set();
+
+        await Assert.ThrowsAnyAsync<OperationCanceledException>(() => queued);
+        await blocker;
+        Assert.False(ran);
     }
 
     [Fact]
-    public void ParseFromJson_MultipleDiagnostics()
+    public async Task LibreOfficeThread_WorkException_FaultsTask()
     {
-        var json = "[{\"severity\":\"warning\",\"category\":\"font\",\"message\":\"Font 1\",\"font\":\"F1\"}," +
-            "{\"severity\":\"info\",\"category\":\"layout\",\"message\":\"Layout 1\"}," +
-            "{\"severity\":\"warning\",\"category\":\"general\",\"message\":\"General 1\"}]";
-        var element = ParseJson(json);
-        var result = StderrDiagnosticParser.ParseFromJson(element);
+        using var thread = new LibreOfficeThread("test");
 
-        Assert.Equal(3, result.Count);
-        Assert.Equal("Font 1", result[0].Message);
-        Assert.Equal("Layout 1", result[1].Message);
-        Assert.Equal("General 1", result[2].Message);
+        await Assert.ThrowsAsync<InvalidOperationException>(() =>
+            thread.RunAsync<int>(() => throw new InvalidOperationException("boom")));
+        Assert.Equal(2, await thread.RunAsync(() => 2));
     }
 
     [Fact]
-    public void ParseFromJson_EmptyObject_UsesDefaults()
+    public void LibreOfficeThread_AfterDispose_Throws()
     {
-        var json = "[{}]";
-        var element = ParseJson(json);
-        var result = StderrDiagnosticParser.ParseFromJson(element);
+        var thread = new LibreOfficeThread("test");
+        thread.Dispose();
 
-        Assert.Single(result);
-        Assert.Equal(DiagnosticSeverity.Warning, result[0].Severity);
-        Assert.Equal(DiagnosticCategory.General, result[0].Category);
-        Assert.Equal("", result[0].Message);
+        Assert.Throws<ObjectDisposedException>(() => thread.RunAsync(() => 1));
     }
-}
-
-// ===========================================================================
-// PdfConverter.Create tests (no worker needed for validation tests)
-// ===========================================================================
 
-public class PdfConverterCreateTests
-{
     [Fact]
-    public void Create_WithZeroMaxWorkers_Throws()
+    public void Create_WithMissingFontDirectory_ThrowsDirectoryNotFound()
     {
-        Assert.Throws<ArgumentOutOfRangeException>(() =>
-            PdfConverter.Create(new PdfConverterOptions { MaxWorkers = 0 }));
+        Assert.Throws<DirectoryNotFoundException>(() =>
+            InProcessConverter.Create(new PdfConverterOptions
+            {
+                ResourcePath = "/nonexistent",
+                FontDirectories = new[] { "/nonexistent/slimlo-fonts" }
+            }));
     }
 
     [Fact]
-    public void Create_WithNegativeMaxWorkers_Throws()
+    public void Create_WithNegativeThreads_Throws()
     {
         Assert.Throws<ArgumentOutOfRangeException>(() =>
-            PdfConverter.Create(new PdfConverterOptions { MaxWorkers = -1 }));
+            InProcessConverter.Create(new PdfConverterOptions { ThreadsPerWorker = -1 }));
     }
 
     [Fact]
-    public void Version_DoesNotThrow()
+    public async Task ConvertAsync_BufferPooledAndBorrowed_Succeed()
     {
-        // Version uses P/Invoke -- may return null if library not found,
-        // but should never throw
-        var version = PdfConverter.Version;
-        // Can be null if native lib not available; just verify no crash
+        if (!TestHelpers.CanRunIntegration()) return;
+        var testDocx = TestHelpers.FindTestDocx();
+        if (testDocx == null) return;
+
+        using var converter = InProcessConverter.Create(new PdfConverterOptions
+        {
+            ResourcePath = TestHelpers.GetResourcePath()
+        });
+        var docxBytes = await File.ReadAllBytesAsync(testDocx);
+
+        var bytes = await converter.ConvertAsync(docxBytes, DocumentFormat.Docx);
+        Assert.True(bytes.Success, $"Conversion failed: {bytes.ErrorMessage}");
+        Assert.Equal("%PDF", Encoding.ASCII.GetString(bytes.Data!, 0, 4));
+
+        var pooled = await converter.ConvertToPooledAsync(docxBytes, DocumentFormat.Docx);
+        Assert.True(pooled.Success, $"Conversion failed: {pooled.ErrorMessage}");
+        using (pooled.Data)
+            Assert.Equal("%PDF", Encoding.ASCII.GetString(pooled.Data!.Memory.Span.Slice(0, 4).ToArray()));
+
+        var length = await converter.ConvertAsync(docxBytes, DocumentFormat.Docx, pdf => pdf.Length);
+        Assert.True(length.Success, $"Conversion failed: {length.ErrorMessage}");
+        Assert.True(length.Data > 100);
+
+        var invalid = await converter.ConvertAsync(new byte[] { 1, 2, 3 }, DocumentFormat.Docx);
+        Assert.False(invalid.Success);
+        Assert.NotNull(invalid.ErrorCode);
     }
 }
 
@@ -1372,6 +3236,226 @@ public class PdfConverterIntegrationTests : IAsyncDisposable
             converter.ConvertAsync("/tmp/in.docx", ""));
     }
 
+    [Fact]
+    public async Task ConvertAsync_WithProgress_ReportsPhasesUpToDone()
+    {
+        var converter = GetOrCreateConverter();
+        if (converter is null) return;
+
+        var testDocx = TestHelpers.FindTestDocx();
+        if (testDocx == null) return;
+
+        var reports = new List<ConversionProgress>();
+        var docxBytes = await File.ReadAllBytesAsync(testDocx);
+        var result = await converter.ConvertAsync(docxBytes.AsMemory(), DocumentFormat.Docx,
+            new ConversionOptions { Progress = new CollectingProgress(reports) });
+
+        Assert.True(result.Success, $"Conversion failed: {result.ErrorMessage}");
+        Assert.NotEmpty(reports);
+        Assert.Equal(ConversionPhase.Load, reports[0].Phase);
+        var done = reports[reports.Count - 1];
+        Assert.Equal(ConversionPhase.Done, done.Phase);
+        Assert.Equal(result.Data!.Length, done.BytesWritten);
+        Assert.True(done.PagesLaidOut > 0);
+    }
+
+    [Fact]
+    public async Task ConvertAsync_ConcurrentDuplicates_AreCoalesced()
+    {
+        if (!TestHelpers.CanRunIntegration()) return;
+        var testDocx = TestHelpers.FindTestDocx();
+        if (testDocx == null) return;
+
+        await using var converter = PdfConverter.Create(new PdfConverterOptions
+        {
+            ResourcePath = TestHelpers.GetResourcePath(),
+            MaxWorkers = 2,
+            CoalesceDuplicates = true
+        });
+        var docxBytes = await File.ReadAllBytesAsync(testDocx);
+
+        var results = await Task.WhenAll(Enumerable.Range(0, 4).Select(_ =>
+            converter.ConvertAsync(docxBytes.AsMemory(), DocumentFormat.Docx)));
+
+        Assert.All(results, r => Assert.True(r.Success, r.ErrorMessage));
+        Assert.All(results, r => Assert.Equal(results[0].Data!.Length, r.Data!.Length));
+        Assert.True(converter.CoalescedCount > 0);
+    }
+
+    [Fact]
+    public async Task GetDocumentInfoAsync_ValidDocx_MatchesConvertedPageCount()
+    {
+        var converter = GetOrCreateConverter();
+        if (converter is null) return;
+
+        var testDocx = TestHelpers.FindTestDocx();
+        if (testDocx == null) return;
+
+        var info = await converter.GetDocumentInfoAsync(testDocx);
+        Assert.True(info.Success, $"Document info failed: {info.ErrorMessage}");
+        Assert.True(info.Data!.PageCount > 0);
+        Assert.Equal(info.Data.PageCount, info.Data.Pages.Count);
+        Assert.True(info.Data.Pages[0].Width > 0 && info.Data.Pages[0].Height > 0);
+
+        var reports = new List<ConversionProgress>();
+        var docxBytes = await File.ReadAllBytesAsync(testDocx);
+        var result = await converter.ConvertAsync(docxBytes.AsMemory(), DocumentFormat.Docx,
+            new ConversionOptions { Progress = new CollectingProgress(reports) });
+        Assert.True(result.Success, $"Conversion failed: {result.ErrorMessage}");
+        Assert.Equal(reports[reports.Count - 1].PagesLaidOut, info.Data.PageCount);
+
+        var fromBuffer = await converter.GetDocumentInfoAsync(docxBytes.AsMemory(), DocumentFormat.Docx);
+        Assert.True(fromBuffer.Success, $"Document info failed: {fromBuffer.ErrorMessage}");
+        Assert.Equal(info.Data.PageCount, fromBuffer.Data!.PageCount);
+    }
+
+    [Fact]
+    public async Task CombineAsync_TwoParts_ProducesOnePdf()
+    {
+        var converter = GetOrCreateConverter();
+        if (converter is null) return;
+
+        var testDocx = TestHelpers.FindTestDocx();
+        if (testDocx == null) return;
+
+        var single = await converter.GetDocumentInfoAsync(testDocx);
+        Assert.True(single.Success, $"Document info failed: {single.ErrorMessage}");
+
+        var outputPdf = Path.Combine(Path.GetTempPath(), $"slimlo_test_{Guid.NewGuid():N}.pdf");
+        try
+        {
+            var result = await converter.CombineAsync(
+                new[] { new CombinePart(testDocx, "First"), new CombinePart(testDocx, "Second") },
+                outputPdf,
+                new ConversionOptions { PageText = new TextOptions() });
+            Assert.True(result.Success, $"Combine failed: {result.ErrorMessage}");
+            Assert.True(File.Exists(outputPdf));
+            Assert.Equal(2 * single.Data!.PageCount, result.PageText.Count);
+        }
+        finally
+        {
+            if (File.Exists(outputPdf)) File.Delete(outputPdf);
+        }
+    }
+
+    [Fact]
+    public async Task CombineAsync_MissingPart_ReturnsFailure()
+    {
+        var converter = GetOrCreateConverter();
+        if (converter is null) return;
+
+        var result = await converter.CombineAsync(
+            new[] { new CombinePart("/nonexistent/input.docx") }, "/tmp/output.pdf");
+
+        Assert.False(result.Success);
+        Assert.Equal(SlimLOErrorCode.FileNotFound, result.ErrorCode);
+        Assert.Contains("Part 1:", result.ErrorMessage!);
+    }
+
+    [Fact]
+    public async Task CombineAsync_NoParts_ReturnsInvalidArgument()
+    {
+        var converter = GetOrCreateConverter();
+        if (converter is null) return;
+
+        var result = await converter.CombineAsync(Array.Empty<CombinePart>(), "/tmp/output.pdf");
+
+        Assert.False(result.Success);
+        Assert.Equal(SlimLOErrorCode.InvalidArgument, result.ErrorCode);
+    }
+
+    [Fact]
+    public async Task GetDocumentInfoAsync_FileNotFound_ReturnsFailure()
+    {
+        var converter = GetOrCreateConverter();
+        if (converter is null) return;
+
+        var result = await converter.GetDocumentInfoAsync("/nonexistent/input.docx");
+
+        Assert.False(result.Success);
+        Assert.Equal(SlimLOErrorCode.FileNotFound, result.ErrorCode);
+        Assert.Null(result.Data);
+    }
+
+    [Fact]
+    public async Task RenderPagesAsync_ValidDocx_ReturnsFirstPagePng()
+    {
+        var converter = GetOrCreateConverter();
+        if (converter is null) return;
+
+        var testDocx = TestHelpers.FindTestDocx();
+        if (testDocx == null) return;
+
+        var result = await converter.RenderPagesAsync(testDocx);
+        Assert.True(result.Success, $"Render failed: {result.ErrorMessage}");
+        var image = Assert.Single(result.PageImages);
+        Assert.Equal(1, image.PageNumber);
+        Assert.Equal(256, image.Width);
+        Assert.True(image.Height > 0);
+        Assert.Equal(new byte[] { 0x89, (byte)'P', (byte)'N', (byte)'G' }, image.Data.AsSpan(0, 4).ToArray());
+    }
+
+    [Fact]
+    public async Task ConvertAsync_BufferWithPageImages_ReturnsPdfAndThumbnail()
+    {
+        var converter = GetOrCreateConverter();
+        if (converter is null) return;
+
+        var testDocx = TestHelpers.FindTestDocx();
+        if (testDocx == null) return;
+
+        var docxBytes = await File.ReadAllBytesAsync(testDocx);
+        var result = await converter.ConvertAsync(docxBytes.AsMemory(), DocumentFormat.Docx,
+            new ConversionOptions
+            {
+                PageImages = new RenderOptions { Format = PageImageFormat.Rgba, Width = 64 }
+            });
+
+        Assert.True(result.Success, $"Conversion failed: {result.ErrorMessage}");
+        Assert.Equal((byte)'%', result.Data![0]);
+        var image = Assert.Single(result.PageImages);
+        Assert.Equal(64 * image.Height * 4, image.Data.Length);
+    }
+
+    [Fact]
+    public async Task ConvertAsync_WithPageText_ReturnsTextForEveryPage()
+    {
+        var converter = GetOrCreateConverter();
+        if (converter is null) return;
+
+        var testDocx = TestHelpers.FindTestDocx();
+        if (testDocx == null) return;
+
+        var docxBytes = await File.ReadAllBytesAsync(testDocx);
+        var result = await converter.ConvertAsync(docxBytes.AsMemory(), DocumentFormat.Docx,
+            new ConversionOptions { PageText = new TextOptions { IncludeWords = true } });
+        Assert.True(result.Success, $"Conversion failed: {result.ErrorMessage}");
+
+        var info = await converter.GetDocumentInfoAsync(testDocx);
+        Assert.True(info.Success, $"Document info failed: {info.ErrorMessage}");
+        Assert.Equal(info.Data!.PageCount, result.PageText.Count);
+        Assert.Contains(result.PageText, page => page.Text.Length > 0);
+        foreach (var page in result.PageText)
+        {
+            foreach (var word in page.Words)
+            {
+                Assert.False(string.IsNullOrEmpty(word.Text));
+                Assert.InRange(word.X + word.Width, 0, page.Size.Width + 1);
+                Assert.InRange(word.Y + word.Height, 0, page.Size.Height + 1);
+            }
+        }
+    }
+
+    private sealed class CollectingProgress : IProgress<ConversionProgress>
+    {
+        private readonly List<ConversionProgress> _reports;
+        public CollectingProgress(List<ConversionProgress> reports) => _reports = reports;
+        public void Report(ConversionProgress value)
+        {
+            lock (_reports) _reports.Add(value);
+        }
+    }
+
     // --- Buffer conversion ---
 
     [Fact]
@@ -1854,6 +3938,25 @@ public class PdfConverterStreamValidationTests
         Assert.Equal(SlimLOErrorCode.InvalidArgument, result.ErrorCode);
     }
 
+    [Fact]
+    public async Task ConvertStreamingAsync_InvalidArguments_ReturnFailure()
+    {
+        if (!TestHelpers.CanRunIntegration()) return;
+        await using var converter = PdfConverter.Create(new PdfConverterOptions
+            { ResourcePath = TestHelpers.GetResourcePath() });
+
+        await Assert.ThrowsAsync<ArgumentNullException>(() =>
+            converter.ConvertStreamingAsync(null!, new MemoryStream(), DocumentFormat.Docx));
+
+        var format = await converter.ConvertStreamingAsync(
+            new MemoryStream(new byte[] { 1 }), new MemoryStream(), DocumentFormat.Unknown);
+        Assert.Equal(SlimLOErrorCode.InvalidFormat, format.ErrorCode);
+
+        var readOnly = await converter.ConvertStreamingAsync(
+            new MemoryStream(new byte[] { 1 }), new MemoryStream(new byte[1], writable: false), DocumentFormat.Docx);
+        Assert.Equal(SlimLOErrorCode.InvalidArgument, readOnly.ErrorCode);
+    }
+
     // -- Stream → File validation --
 
     [Fact]
@@ -2064,6 +4167,29 @@ public class PdfConverterStreamIntegrationTests : IAsyncDisposable
         Assert.Equal((byte)'F', header[3]);
     }
 
+    [Fact]
+    public async Task ConvertStreamingAsync_NonSeekableInput_ProducesPdf()
+    {
+        var converter = GetOrCreateConverter();
+        if (converter is null) return;
+        var testDocx = TestHelpers.FindTestDocx();
+        if (testDocx == null) return;
+
+        // A non-seekable source: chunks are forwarded as they are read
+        var input = new SlowReadStream(await File.ReadAllBytesAsync(testDocx));
+        using var outputMs = new MemoryStream();
+
+        var result = await converter.ConvertStreamingAsync(input, outputMs, DocumentFormat.Docx);
+
+        Assert.True(result.Success, $"Conversion failed: {result.ErrorMessage}");
+        Assert.Equal("%PDF", Encoding.ASCII.GetString(outputMs.ToArray(), 0, 4));
+
+        // The worker stays in sync for the next request
+        var again = await converter.ConvertStreamingAsync(
+            new MemoryStream(await File.ReadAllBytesAsync(testDocx)), new MemoryStream(), DocumentFormat.Docx);
+        Assert.True(again.Success, $"Second conversion failed: {again.ErrorMessage}");
+    }
+
     [Fact]
     public async Task ConvertAsync_StreamToStream_MemoryStreamInput_Works()
     {
@@ -0,0 +1,23 @@
+namespace SlimLO;
+
+/// <summary>
+/// One input of <see cref="PdfConverter.CombineAsync"/>.
+/// </summary>
+public sealed class CombinePart
+{
+    /// <summary>Create a part from a document path and an optional bookmark title.</summary>
+    public CombinePart(string inputPath, string? bookmark = null)
+    {
+        InputPath = inputPath;
+        Bookmark = bookmark;
+    }
+
+    /// <summary>Path to the input document (.docx only).</summary>
+    public string InputPath { get; }
+
+    /// <summary>
+    /// Title of a top-level PDF outline entry pointing at the start of this part,
+    /// with the part's own headings nested below it. Null = no entry.
+    /// </summary>
+    public string? Bookmark { get; }
+}
@@ -1,3 +1,6 @@
+using System;
+using System.Collections.Generic;
+
 namespace SlimLO;
 
 /// <summary>
@@ -5,6 +8,11 @@ namespace SlimLO;
 /// </summary>
 public sealed class ConversionOptions
 {
+    /// <summary>
+    /// Export preset applied before the explicit options below. Default: none.
+    /// </summary>
+    public PdfPreset Preset { get; init; } = PdfPreset.None;
+
     /// <summary>PDF version for the output. Default: PDF 1.7.</summary>
     public PdfVersion PdfVersion { get; init; } = PdfVersion.Default;
 
@@ -20,6 +28,66 @@ public sealed class ConversionOptions
     /// <summary>Page range string, e.g. "1-3" or "1,3,5-7". Null = all pages.</summary>
     public string? PageRange { get; init; }
 
+    /// <summary>
+    /// With a bounded <see cref="PageRange"/> (e.g. "1" or "1-3"), stop layout once the
+    /// range's last page is final instead of formatting the whole document. Page count
+    /// fields then show the number of laid-out pages; a diagnostic reports it.
+    /// </summary>
+    public bool LazyLayout { get; init; }
+
+    /// <summary>
+    /// Keep the field results and linked content cached in the file: no link update on
+    /// load and no field refresh before export. Faster for long reports with tables of
+    /// contents and cross-references; fields edited without being updated stay stale.
+    /// </summary>
+    public bool SkipFieldUpdate { get; init; }
+
+    /// <summary>
+    /// Time from the call within which the conversion must finish to be of any use.
+    /// Waiting requests of a tenant are admitted earliest deadline first; one that cannot
+    /// finish in time — estimated from recent conversion times — fails at once with
+    /// <see cref="SlimLOErrorCode.DeadlineExceeded"/> instead of taking a worker, as
+    /// does one still queued when its deadline passes. A conversion that has started
+    /// is bounded by <see cref="PdfConverterOptions.ConversionTimeout"/> only.
+    /// Null (default) = no deadline; such requests queue behind those with one.
+    /// </summary>
+    public TimeSpan? Deadline { get; init; }
+
+    /// <summary>
+    /// Fair-queuing key, typically the customer this conversion is for. Workers are
+    /// shared across tenants in proportion to <see cref="PdfConverterOptions.TenantWeights"/>,
+    /// so one tenant's bulk submission does not starve the others' conversions.
+    /// Null (default) = the shared default tenant.
+    /// </summary>
+    public string? Tenant { get; init; }
+
     /// <summary>Password for password-protected documents. Null = none.</summary>
     public string? Password { get; init; }
+
+    /// <summary>
+    /// Raw LibreOffice PDF filter properties (e.g. "ExportBookmarks" = "false"),
+    /// applied last so they override both the preset and the explicit options.
+    /// Null = none.
+    /// </summary>
+    public IReadOnlyDictionary<string, string>? FilterProperties { get; init; }
+
+    /// <summary>
+    /// Receives <see cref="ConversionProgress"/> updates while the worker loads,
+    /// lays out and exports the document. Null = no progress reporting.
+    /// </summary>
+    public IProgress<ConversionProgress>? Progress { get; init; }
+
+    /// <summary>
+    /// Also render these pages (e.g. a first-page thumbnail) from the document the
+    /// conversion loads, returned in <see cref="ConversionResult.PageImages"/>.
+    /// Null = no page images.
+    /// </summary>
+    public RenderOptions? PageImages { get; init; }
+
+    /// <summary>
+    /// Also extract the plain text (and optionally word boxes) of these pages from
+    /// the conversion's own layout, returned in <see cref="ConversionResult.PageText"/>.
+    /// Saves a separate parse of the PDF for indexing. Null = no text.
+    /// </summary>
+    public TextOptions? PageText { get; init; }
 }
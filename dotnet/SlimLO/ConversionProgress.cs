@@ -0,0 +1,43 @@
+namespace SlimLO;
+
+/// <summary>
+/// A progress snapshot streamed by the worker during a conversion.
+/// Reported through <see cref="ConversionOptions.Progress"/>.
+/// </summary>
+public sealed class ConversionProgress
+{
+    public ConversionProgress(
+        ConversionPhase phase,
+        int percent,
+        int pagesLaidOut,
+        int pagesExported,
+        long bytesWritten)
+    {
+        Phase = phase;
+        Percent = percent;
+        PagesLaidOut = pagesLaidOut;
+        PagesExported = pagesExported;
+        BytesWritten = bytesWritten;
+    }
+
+    /// <summary>Current conversion phase.</summary>
+    public ConversionPhase Phase { get; }
+
+    /// <summary>Completion of the current phase, 0-100.</summary>
+    public int Percent { get; }
+
+    /// <summary>Pages laid out. 0 until the <see cref="ConversionPhase.Layout"/> phase.</summary>
+    public int PagesLaidOut { get; }
+
+    /// <summary>
+    /// Pages exported. Estimated from the export percentage until
+    /// <see cref="ConversionPhase.Done"/>.
+    /// </summary>
+    public int PagesExported { get; }
+
+    /// <summary>Output size in bytes. 0 until <see cref="ConversionPhase.Done"/>.</summary>
+    public long BytesWritten { get; }
+
+    public override string ToString() =>
+        $"{Phase} {Percent}% (pages {PagesExported}/{PagesLaidOut}, {BytesWritten} bytes)";
+}
@@ -18,12 +18,16 @@ public class ConversionResult
         bool success,
         string? errorMessage,
         SlimLOErrorCode? errorCode,
-        IReadOnlyList<ConversionDiagnostic>? diagnostics)
+        IReadOnlyList<ConversionDiagnostic>? diagnostics,
+        IReadOnlyList<PageImage>? pageImages = null,
+        IReadOnlyList<PageText>? pageText = null)
     {
         Success = success;
         ErrorMessage = errorMessage;
         ErrorCode = errorCode;
         Diagnostics = diagnostics ?? EmptyDiagnostics;
+        PageImages = pageImages ?? Array.Empty<PageImage>();
+        PageText = pageText ?? Array.Empty<PageText>();
     }
 
     /// <summary>Whether the conversion completed successfully.</summary>
@@ -39,7 +43,21 @@ public class ConversionResult
     /// Diagnostics collected during conversion (font warnings, layout issues).
     /// May be non-empty even on success — warnings do not prevent conversion.
     /// </summary>
-    public IReadOnlyList<ConversionDiagnostic> Diagnostics { get; }
+    public IReadOnlyList<ConversionDiagnostic> Diagnostics { get; private set; }
+
+    /// <summary>
+    /// Pages rendered from the loaded document, when requested through
+    /// <see cref="ConversionOptions.PageImages"/> or
+    /// <see cref="PdfConverter.RenderPagesAsync(string, RenderOptions?, System.Threading.CancellationToken)"/>.
+    /// Empty otherwise.
+    /// </summary>
+    public IReadOnlyList<PageImage> PageImages { get; }
+
+    /// <summary>
+    /// Text of each selected page, when requested through
+    /// <see cref="ConversionOptions.PageText"/>. Empty otherwise.
+    /// </summary>
+    public IReadOnlyList<PageText> PageText { get; }
 
     /// <summary>Whether any font substitution warnings were reported.</summary>
     public bool HasFontWarnings
@@ -55,6 +73,25 @@ public class ConversionResult
         }
     }
 
+    /// <summary>
+    /// Set by the worker exchange that produced this result when the worker died or was
+    /// killed during it. A request that found the worker already dead is not flagged.
+    /// </summary>
+    internal bool WorkerLost { get; set; }
+
+    /// <summary>
+    /// Append a diagnostic from work the pool did for this request outside its own
+    /// exchange, such as registering fonts on the worker first.
+    /// </summary>
+    internal void AddDiagnostic(ConversionDiagnostic diagnostic)
+    {
+        var diagnostics = new ConversionDiagnostic[Diagnostics.Count + 1];
+        for (int i = 0; i < Diagnostics.Count; i++)
+            diagnostics[i] = Diagnostics[i];
+        diagnostics[Diagnostics.Count] = diagnostic;
+        Diagnostics = diagnostics;
+    }
+
     /// <summary>Implicit bool conversion: true if conversion succeeded.</summary>
     public static implicit operator bool(ConversionResult result) => result.Success;
 
@@ -71,8 +108,11 @@ public class ConversionResult
         return this;
     }
 
-    internal static ConversionResult Ok(IReadOnlyList<ConversionDiagnostic>? diagnostics) =>
-        new(true, null, null, diagnostics);
+    internal static ConversionResult Ok(
+        IReadOnlyList<ConversionDiagnostic>? diagnostics,
+        IReadOnlyList<PageImage>? pageImages = null,
+        IReadOnlyList<PageText>? pageText = null) =>
+        new(true, null, null, diagnostics, pageImages, pageText);
 
     internal static ConversionResult Fail(
         string errorMessage,
@@ -91,8 +131,10 @@ public sealed class ConversionResult<T> : ConversionResult
         string? errorMessage,
         SlimLOErrorCode? errorCode,
         IReadOnlyList<ConversionDiagnostic>? diagnostics,
-        T? data)
-        : base(success, errorMessage, errorCode, diagnostics)
+        T? data,
+        IReadOnlyList<PageImage>? pageImages = null,
+        IReadOnlyList<PageText>? pageText = null)
+        : base(success, errorMessage, errorCode, diagnostics, pageImages, pageText)
     {
         Data = data;
     }
@@ -101,14 +143,21 @@ public sealed class ConversionResult<T> : ConversionResult
     public T? Data { get; }
 
     /// <summary>Convert to base ConversionResult (drops the data).</summary>
-    internal ConversionResult AsBase() => Success
-        ? ConversionResult.Ok(Diagnostics)
-        : ConversionResult.Fail(ErrorMessage!, ErrorCode!.Value, Diagnostics);
+    internal ConversionResult AsBase()
+    {
+        var result = Success
+            ? ConversionResult.Ok(Diagnostics, PageImages, PageText)
+            : ConversionResult.Fail(ErrorMessage!, ErrorCode!.Value, Diagnostics);
+        result.WorkerLost = WorkerLost;
+        return result;
+    }
 
     internal static ConversionResult<T> Ok(
         T data,
-        IReadOnlyList<ConversionDiagnostic>? diagnostics) =>
-        new(true, null, null, diagnostics, data);
+        IReadOnlyList<ConversionDiagnostic>? diagnostics,
+        IReadOnlyList<PageImage>? pageImages = null,
+        IReadOnlyList<PageText>? pageText = null) =>
+        new(true, null, null, diagnostics, data, pageImages, pageText);
 
     internal static new ConversionResult<T> Fail(
         string errorMessage,
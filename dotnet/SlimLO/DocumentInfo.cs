@@ -0,0 +1,81 @@
+using System;
+using System.Collections.Generic;
+using System.Threading;
+
+namespace SlimLO;
+
+/// <summary>
+/// Document metadata gathered after load and layout, without PDF export.
+/// Returned by <see cref="PdfConverter.GetDocumentInfoAsync(string, CancellationToken)"/>.
+/// </summary>
+public sealed class DocumentInfo
+{
+    public DocumentInfo(
+        int pageCount,
+        IReadOnlyList<PageSize>? pages,
+        int sectionCount,
+        int imageCount,
+        int wordCount,
+        IReadOnlyList<string>? fonts,
+        IReadOnlyList<string>? missingFonts)
+    {
+        PageCount = pageCount;
+        Pages = pages ?? Array.Empty<PageSize>();
+        SectionCount = sectionCount;
+        ImageCount = imageCount;
+        WordCount = wordCount;
+        Fonts = fonts ?? Array.Empty<string>();
+        MissingFonts = missingFonts ?? Array.Empty<string>();
+    }
+
+    /// <summary>Number of pages after full layout.</summary>
+    public int PageCount { get; }
+
+    /// <summary>Size of each page, in document order.</summary>
+    public IReadOnlyList<PageSize> Pages { get; }
+
+    /// <summary>Number of text sections.</summary>
+    public int SectionCount { get; }
+
+    /// <summary>Number of images (inline and floating).</summary>
+    public int ImageCount { get; }
+
+    /// <summary>Word count as computed by the layout engine.</summary>
+    public int WordCount { get; }
+
+    /// <summary>Font families used by the document; these are embedded into the PDF.</summary>
+    public IReadOnlyList<string> Fonts { get; }
+
+    /// <summary>
+    /// Fonts used by the document that are not installed and will be substituted on export.
+    /// </summary>
+    public IReadOnlyList<string> MissingFonts { get; }
+
+    public override string ToString() =>
+        $"{PageCount} pages, {SectionCount} sections, {ImageCount} images, " +
+        $"{Fonts.Count} fonts ({MissingFonts.Count} missing)";
+}
+
+/// <summary>Page size in points (1/72 inch).</summary>
+public readonly struct PageSize : IEquatable<PageSize>
+{
+    public PageSize(double width, double height)
+    {
+        Width = width;
+        Height = height;
+    }
+
+    /// <summary>Page width in points.</summary>
+    public double Width { get; }
+
+    /// <summary>Page height in points.</summary>
+    public double Height { get; }
+
+    public bool Equals(PageSize other) => Width.Equals(other.Width) && Height.Equals(other.Height);
+
+    public override bool Equals(object? obj) => obj is PageSize other && Equals(other);
+
+    public override int GetHashCode() => Width.GetHashCode() * 397 ^ Height.GetHashCode();
+
+    public override string ToString() => $"{Width:0.#}x{Height:0.#} pt";
+}
@@ -32,6 +32,25 @@ public enum PdfVersion
     PdfA3 = 3
 }
 
+/// <summary>
+/// PDF export preset: a bundle of filter settings tuned for a use case.
+/// Values match the native SlimLOPdfPreset enum in slimlo.h.
+/// Explicit <see cref="ConversionOptions"/> fields override the preset.
+/// </summary>
+public enum PdfPreset
+{
+    /// <summary>No preset: LibreOffice defaults plus explicit options.</summary>
+    None = 0,
+    /// <summary>Lowest latency: no bookmarks, tagging, form fields or image processing.</summary>
+    Fast = 1,
+    /// <summary>Smallest output: JPEG quality 60, images downsampled to 150 DPI.</summary>
+    Small = 2,
+    /// <summary>PDF/A-2b, tagged, with bookmarks and all fonts embedded.</summary>
+    Archival = 3,
+    /// <summary>Print fidelity: lossless images at full resolution, all fonts embedded.</summary>
+    Print = 4
+}
+
 /// <summary>
 /// Error codes from the SlimLO native library.
 /// Values match the native SlimLOError enum in slimlo.h.
@@ -49,9 +68,37 @@ public enum SlimLOErrorCode
     AlreadyInitialized = 8,
     NotInitialized = 9,
     InvalidArgument = 10,
+    /// <summary>
+    /// Refused by the worker pool: the document crashed a worker process too many
+    /// times. See <see cref="PdfConverterOptions.QuarantineAfterCrashes"/>.
+    /// </summary>
+    Quarantined = 11,
+    /// <summary>
+    /// Shed by the worker pool: the request could not finish before its
+    /// <see cref="ConversionOptions.Deadline"/>.
+    /// </summary>
+    DeadlineExceeded = 12,
     Unknown = 99
 }
 
+/// <summary>
+/// Phase of a running conversion, as reported by <see cref="ConversionProgress"/>.
+/// Values match the native SlimLOProgressPhase enum in slimlo.h.
+/// </summary>
+public enum ConversionPhase
+{
+    /// <summary>Phase not reported by the worker.</summary>
+    Unknown = 0,
+    /// <summary>Document import and initial layout.</summary>
+    Load = 1,
+    /// <summary>Layout finished; page count known.</summary>
+    Layout = 2,
+    /// <summary>PDF export running.</summary>
+    Export = 3,
+    /// <summary>Output written.</summary>
+    Done = 4
+}
+
 /// <summary>
 /// Severity level for conversion diagnostics.
 /// </summary>
@@ -70,3 +117,29 @@ public enum DiagnosticCategory
     Font,
     Layout
 }
+
+/// <summary>
+/// Raster format of a rendered <see cref="PageImage"/>.
+/// Values match the native SlimLOImageFormat enum in slimlo.h.
+/// </summary>
+public enum PageImageFormat
+{
+    /// <summary>PNG file bytes.</summary>
+    Png = 0,
+    /// <summary>Raw pixels: 4 bytes per pixel (straight alpha), rows top-down, no padding.</summary>
+    Rgba = 1
+}
+
+/// <summary>
+/// How pool workers are placed on the machine's CPUs.
+/// </summary>
+public enum WorkerPlacement
+{
+    /// <summary>The OS scheduler may run and migrate workers on any CPU.</summary>
+    None,
+    /// <summary>
+    /// Each worker is pinned to its own share of the CPUs, taken from one NUMA node
+    /// (workers alternate between nodes), with memory allocated on that node.
+    /// </summary>
+    Pinned
+}
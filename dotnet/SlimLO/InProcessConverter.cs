@@ -0,0 +1,443 @@
+using System;
+using System.Buffers;
+using System.Collections.Generic;
+using System.IO;
+using System.Text;
+using System.Threading;
+using System.Threading.Tasks;
+using SlimLO.Internal;
+
+namespace SlimLO;
+
+/// <summary>
+/// Reads a PDF that is only valid for the duration of the call.
+/// </summary>
+/// <param name="pdf">The PDF bytes, in native memory released when the reader returns.</param>
+public delegate T PdfReader<T>(ReadOnlySpan<byte> pdf);
+
+/// <summary>
+/// Converts documents with LibreOffice loaded into this process, calling the
+/// SlimLO native library directly instead of going through a worker process.
+///
+/// <para><b>Trusted input only.</b> There is no crash isolation: a document that
+/// crashes LibreOffice takes the host process with it, and a conversion that hangs
+/// cannot be timed out or killed. Use <see cref="PdfConverter"/> for documents
+/// from untrusted sources.</para>
+///
+/// <para><b>Why:</b> no process spawn, JSON framing or pipe copies. Input is passed
+/// pinned, and the PDF is written by the native code straight into the managed array
+/// returned to the caller — or lent out as native memory to a <see cref="PdfReader{T}"/>.
+/// For small documents this removes most of the per-conversion overhead.</para>
+///
+/// <para><b>Threading:</b> LibreOffice allows one instance per process, bound to the
+/// thread that created it. The converter owns that thread; every call is queued
+/// onto it and conversions run one at a time in submission order. All methods are
+/// thread-safe. Only one converter may exist per process, and LibreOffice cannot be
+/// started again once it is disposed.</para>
+///
+/// <para>Page rendering, text extraction, progress, deadlines and tenants are
+/// worker-pool features and are ignored here; <see cref="ConversionResult.Diagnostics"/>
+/// is always empty.</para>
+///
+/// <example>
+/// <code>
+/// using var converter = InProcessConverter.Create();
+///
+/// var result = await converter.ConvertAsync(docxBytes, DocumentFormat.Docx);
+/// byte[] pdf = result.Data;
+///
+/// // Borrowed: hash the PDF without copying it out of native memory
+/// var hash = await converter.ConvertAsync(docxBytes, DocumentFormat.Docx,
+///     pdf => Convert.ToHexString(SHA256.HashData(pdf)));
+/// </code>
+/// </example>
+/// </summary>
+public sealed class InProcessConverter : IDisposable
+{
+    private readonly LibreOfficeThread _thread;
+    private readonly IntPtr _handle;
+    private volatile bool _disposed;
+
+    private InProcessConverter(LibreOfficeThread thread, IntPtr handle)
+    {
+        _thread = thread;
+        _handle = handle;
+    }
+
+    /// <summary>
+    /// Load LibreOffice into this process and create the converter.
+    /// </summary>
+    /// <param name="options">
+    /// Converter configuration. Only <see cref="PdfConverterOptions.ResourcePath"/>,
+    /// <see cref="PdfConverterOptions.FontDirectories"/> and
+    /// <see cref="PdfConverterOptions.ThreadsPerWorker"/> (LibreOffice's thread budget)
+    /// apply; pool settings are ignored.
+    /// </param>
+    /// <returns>The converter. Dispose it to shut LibreOffice down.</returns>
+    /// <exception cref="DirectoryNotFoundException">A font directory does not exist.</exception>
+    /// <exception cref="InvalidOperationException">Resource path could not be auto-detected.</exception>
+    /// <exception cref="SlimLOException">
+    /// LibreOffice failed to start, or is already loaded in this process
+    /// (<see cref="SlimLOErrorCode.AlreadyInitialized"/>).
+    /// </exception>
+    public static InProcessConverter Create(PdfConverterOptions? options = null)
+    {
+        options ??= new PdfConverterOptions();
+
+        if (options.ThreadsPerWorker < 0)
+            throw new ArgumentOutOfRangeException(
+                nameof(options), "ThreadsPerWorker must not be negative");
+        // Fonts are registered after startup, like AddFontDirectoryAsync: LibreOffice
+        // in this process does not get the worker's SAL_FONTPATH
+        var fontDirectories = new List<string>();
+        foreach (var directory in options.FontDirectories ?? Array.Empty<string>())
+        {
+            var fullPath = Path.GetFullPath(directory);
+            if (!Directory.Exists(fullPath))
+                throw new DirectoryNotFoundException($"Font directory not found: {fullPath}");
+            fontDirectories.Add(fullPath);
+        }
+
+        var resourcePath = options.ResourcePath ?? WorkerLocator.FindResourcePath();
+        NativeMethods.LibraryDirectory = Path.Combine(resourcePath, "program");
+
+        var thread = new LibreOfficeThread("SlimLO LibreOffice");
+        try
+        {
+            var handle = thread.Run(() => Init(resourcePath, options.ThreadsPerWorker, fontDirectories));
+            return new InProcessConverter(thread, handle);
+        }
+        catch
+        {
+            thread.Dispose();
+            throw;
+        }
+    }
+
+    /// <summary>
+    /// Convert a document file to PDF.
+    /// </summary>
+    /// <param name="inputPath">Path to input document (.docx only).</param>
+    /// <param name="outputPath">Path for output PDF file.</param>
+    /// <param name="options">PDF conversion options. Null for defaults.</param>
+    /// <param name="cancellationToken">Withdraws the conversion if it has not started yet.</param>
+    /// <returns>Conversion result. Check <see cref="ConversionResult.Success"/>.</returns>
+    public Task<ConversionResult> ConvertAsync(
+        string inputPath,
+        string outputPath,
+        ConversionOptions? options = null,
+        CancellationToken cancellationToken = default)
+    {
+        ThrowHelpers.ThrowIfDisposed(_disposed, this);
+        ThrowHelpers.ThrowIfNullOrEmpty(inputPath);
+        ThrowHelpers.ThrowIfNullOrEmpty(outputPath);
+
+        inputPath = Path.GetFullPath(inputPath);
+        outputPath = Path.GetFullPath(outputPath);
+
+        if (!File.Exists(inputPath))
+            return Task.FromResult(ConversionResult.Fail(
+                $"Input file not found: {inputPath}",
+                SlimLOErrorCode.FileNotFound, null));
+
+        var format = PdfConverter.DetectFormat(inputPath);
+        if (!PdfConverter.IsSupportedFormat(format))
+            return Task.FromResult(PdfConverter.InvalidFormatFailure(format, "file conversion"));
+
+        return _thread.RunAsync(
+            () => ConvertFile(inputPath, outputPath, format, options ?? new ConversionOptions()),
+            cancellationToken);
+    }
+
+    /// <summary>
+    /// Convert an in-memory document to PDF bytes.
+    /// </summary>
+    /// <param name="input">Input document bytes.</param>
+    /// <param name="format">Document format (required — cannot auto-detect from bytes).</param>
+    /// <param name="options">PDF conversion options. Null for defaults.</param>
+    /// <param name="cancellationToken">Withdraws the conversion if it has not started yet.</param>
+    /// <returns>
+    /// Conversion result with PDF bytes in <see cref="ConversionResult{T}.Data"/>.
+    /// Data is null if conversion failed.
+    /// </returns>
+    /// <remarks>
+    /// <paramref name="input"/> is pinned for the conversion, not copied. The PDF is
+    /// written straight into the returned array, allocated once at its final size.
+    /// </remarks>
+    public Task<ConversionResult<byte[]>> ConvertAsync(
+        ReadOnlyMemory<byte> input,
+        DocumentFormat format,
+        ConversionOptions? options = null,
+        CancellationToken cancellationToken = default)
+    {
+        ThrowHelpers.ThrowIfDisposed(_disposed, this);
+
+        if (input.IsEmpty)
+            return Task.FromResult(ConversionResult<byte[]>.Fail(
+                "Input data is empty",
+                SlimLOErrorCode.InvalidArgument, null));
+
+        if (!PdfConverter.IsSupportedFormat(format))
+            return Task.FromResult(
+                PdfConverter.InvalidFormatFailure<byte[]>(format, "buffer conversion"));
+
+        return _thread.RunAsync(() =>
+        {
+            using var output = new ArrayOutput();
+            var error = ConvertInto(input, format, options, output);
+            return error == null
+                ? ConversionResult<byte[]>.Ok(output.Array!, null)
+                : ConversionResult<byte[]>.Fail(error.Value.Message, error.Value.Code, null);
+        }, cancellationToken);
+    }
+
+    /// <summary>
+    /// Convert an in-memory document to PDF bytes held in pooled memory.
+    /// </summary>
+    /// <param name="input">Input document bytes.</param>
+    /// <param name="format">Document format (required — cannot auto-detect from bytes).</param>
+    /// <param name="options">PDF conversion options. Null for defaults.</param>
+    /// <param name="cancellationToken">Withdraws the conversion if it has not started yet.</param>
+    /// <returns>
+    /// Conversion result with the PDF in <see cref="ConversionResult{T}.Data"/>; the caller
+    /// must dispose it to return the memory. Data is null if conversion failed.
+    /// </returns>
+    /// <remarks>
+    /// As <see cref="ConvertAsync(ReadOnlyMemory{byte}, DocumentFormat, ConversionOptions?, CancellationToken)"/>,
+    /// but the PDF is written into an array rented from <see cref="ArrayPool{T}.Shared"/>.
+    /// </remarks>
+    public Task<ConversionResult<IMemoryOwner<byte>>> ConvertToPooledAsync(
+        ReadOnlyMemory<byte> input,
+        DocumentFormat format,
+        ConversionOptions? options = null,
+        CancellationToken cancellationToken = default)
+    {
+        ThrowHelpers.ThrowIfDisposed(_disposed, this);
+
+        if (input.IsEmpty)
+            return Task.FromResult(ConversionResult<IMemoryOwner<byte>>.Fail(
+                "Input data is empty",
+                SlimLOErrorCode.InvalidArgument, null));
+
+        if (!PdfConverter.IsSupportedFormat(format))
+            return Task.FromResult(
+                PdfConverter.InvalidFormatFailure<IMemoryOwner<byte>>(format, "buffer conversion"));
+
+        return _thread.RunAsync(() =>
+        {
+            using var output = new PooledOutput();
+            var error = ConvertInto(input, format, options, output);
+            if (error != null)
+            {
+                output.Buffer?.Dispose();
+                return ConversionResult<IMemoryOwner<byte>>.Fail(
+                    error.Value.Message, error.Value.Code, null);
+            }
+            return ConversionResult<IMemoryOwner<byte>>.Ok(output.Buffer!, null);
+        }, cancellationToken);
+    }
+
+    /// <summary>
+    /// Convert an in-memory document and read the PDF where LibreOffice left it.
+    /// </summary>
+    /// <param name="input">Input document bytes.</param>
+    /// <param name="format">Document format (required — cannot auto-detect from bytes).</param>
+    /// <param name="reader">
+    /// Called with the PDF on the LibreOffice thread. The span points into native memory
+    /// that is freed when the reader returns: copy out anything needed afterwards, and
+    /// keep the reader short — the next conversion waits for it.
+    /// </param>
+    /// <param name="options">PDF conversion options. Null for defaults.</param>
+    /// <param name="cancellationToken">Withdraws the conversion if it has not started yet.</param>
+    /// <returns>
+    /// Conversion result with the reader's return value in <see cref="ConversionResult{T}.Data"/>.
+    /// The reader is not called if conversion failed. Exceptions from the reader fault the task.
+    /// </returns>
+    /// <remarks>
+    /// Zero managed allocation proportional to the PDF: for hashing, uploading from a
+    /// span, or writing to a stream that accepts spans.
+    /// </remarks>
+    public Task<ConversionResult<T>> ConvertAsync<T>(
+        ReadOnlyMemory<byte> input,
+        DocumentFormat format,
+        PdfReader<T> reader,
+        ConversionOptions? options = null,
+        CancellationToken cancellationToken = default)
+    {
+        ThrowHelpers.ThrowIfDisposed(_disposed, this);
+        ThrowHelpers.ThrowIfNull(reader);
+
+        if (input.IsEmpty)
+            return Task.FromResult(ConversionResult<T>.Fail(
+                "Input data is empty",
+                SlimLOErrorCode.InvalidArgument, null));
+
+        if (!PdfConverter.IsSupportedFormat(format))
+            return Task.FromResult(PdfConverter.InvalidFormatFailure<T>(format, "buffer conversion"));
+
+        return _thread.RunAsync(() => ConvertBorrowed(input, format, reader, options), cancellationToken);
+    }
+
+    /// <summary>
+    /// Register a font directory, for the conversions queued after this call. Only
+    /// LibreOffice's font lists and caches are rebuilt, and adding a directory twice
+    /// is a no-op.
+    /// </summary>
+    /// <param name="fontDirectory">Directory of .ttf/.otf/.ttc/.otc files (subdirectories included).</param>
+    /// <param name="cancellationToken">Withdraws the registration if it has not started yet.</param>
+    /// <returns>Result. Check <see cref="ConversionResult.Success"/>.</returns>
+    public Task<ConversionResult> AddFontDirectoryAsync(
+        string fontDirectory,
+        CancellationToken cancellationToken = default)
+    {
+        ThrowHelpers.ThrowIfDisposed(_disposed, this);
+        ThrowHelpers.ThrowIfNullOrEmpty(fontDirectory);
+
+        fontDirectory = Path.GetFullPath(fontDirectory);
+        if (!Directory.Exists(fontDirectory))
+            return Task.FromResult(ConversionResult.Fail(
+                $"Font directory not found: {fontDirectory}",
+                SlimLOErrorCode.FileNotFound, null));
+
+        return _thread.RunAsync(() =>
+        {
+            int rc = AddFontDirectory(_handle, fontDirectory);
+            return rc == 0
+                ? ConversionResult.Ok(null)
+                : ConversionResult.Fail(NativeMethods.GetErrorMessage(_handle), (SlimLOErrorCode)rc, null);
+        }, cancellationToken);
+    }
+
+    /// <summary>Shut LibreOffice down after the queued conversions finish.</summary>
+    public void Dispose()
+    {
+        if (_disposed)
+            return;
+        _disposed = true;
+        try
+        {
+            _thread.Run(() =>
+            {
+                NativeMethods.Destroy(_handle);
+                return true;
+            });
+        }
+        finally
+        {
+            _thread.Dispose();
+        }
+    }
+
+    // ---- On the LibreOffice thread ----
+
+    private static unsafe IntPtr Init(string resourcePath, int threads, IReadOnlyList<string> fontDirectories)
+    {
+        var init = new NativeInitOptions { Threads = threads };
+        var path = Utf8(resourcePath);
+        IntPtr handle;
+        fixed (byte* pPath = path)
+        {
+            handle = NativeMethods.InitEx(pPath, &init);
+        }
+        if (handle == IntPtr.Zero)
+        {
+            var message = NativeMethods.GetErrorMessage(IntPtr.Zero);
+            throw new SlimLOException(
+                string.IsNullOrEmpty(message) ? "LibreOffice failed to initialize" : message,
+                message.Contains("already initialized")
+                    ? SlimLOErrorCode.AlreadyInitialized
+                    : SlimLOErrorCode.InitFailed);
+        }
+
+        foreach (var directory in fontDirectories)
+        {
+            int rc = AddFontDirectory(handle, directory);
+            if (rc != 0)
+            {
+                var message = NativeMethods.GetErrorMessage(handle);
+                NativeMethods.Destroy(handle);
+                throw new SlimLOException(message, (SlimLOErrorCode)rc);
+            }
+        }
+        return handle;
+    }
+
+    private static unsafe int AddFontDirectory(IntPtr handle, string directory)
+    {
+        var path = Utf8(directory);
+        fixed (byte* pPath = path)
+        {
+            return NativeMethods.AddFontDirectory(handle, pPath);
+        }
+    }
+
+    private unsafe ConversionResult ConvertFile(
+        string inputPath, string outputPath, DocumentFormat format, ConversionOptions options)
+    {
+        using var strings = new NativeStrings();
+        var native = NativeOptions.FromConversionOptions(options, strings);
+        var input = Utf8(inputPath);
+        var output = Utf8(outputPath);
+        int rc;
+        fixed (byte* pInput = input)
+        fixed (byte* pOutput = output)
+        {
+            rc = NativeMethods.ConvertFile(_handle, pInput, pOutput, (int)format, &native);
+        }
+        return rc == 0
+            ? ConversionResult.Ok(null)
+            : ConversionResult.Fail(NativeMethods.GetErrorMessage(_handle), (SlimLOErrorCode)rc, null);
+    }
+
+    private unsafe (string Message, SlimLOErrorCode Code)? ConvertInto(
+        ReadOnlyMemory<byte> input, DocumentFormat format, ConversionOptions? options, PinnedOutput output)
+    {
+        using var strings = new NativeStrings();
+        var native = NativeOptions.FromConversionOptions(options ?? new ConversionOptions(), strings);
+        var allocator = output.Allocator();
+        byte* data = null;
+        nuint size = 0;
+        int rc;
+        using (var pin = input.Pin())
+        {
+            rc = NativeMethods.ConvertBufferAlloc(
+                _handle, (byte*)pin.Pointer, (nuint)input.Length, (int)format, &native,
+                &allocator, &data, &size);
+        }
+        return rc == 0 ? null : (NativeMethods.GetErrorMessage(_handle), (SlimLOErrorCode)rc);
+    }
+
+    private unsafe ConversionResult<T> ConvertBorrowed<T>(
+        ReadOnlyMemory<byte> input, DocumentFormat format, PdfReader<T> reader, ConversionOptions? options)
+    {
+        using var strings = new NativeStrings();
+        var native = NativeOptions.FromConversionOptions(options ?? new ConversionOptions(), strings);
+        byte* data = null;
+        nuint size = 0;
+        int rc;
+        using (var pin = input.Pin())
+        {
+            rc = NativeMethods.ConvertBuffer(
+                _handle, (byte*)pin.Pointer, (nuint)input.Length, (int)format, &native,
+                &data, &size);
+        }
+        if (rc != 0)
+            return ConversionResult<T>.Fail(NativeMethods.GetErrorMessage(_handle), (SlimLOErrorCode)rc, null);
+
+        try
+        {
+            return ConversionResult<T>.Ok(reader(new ReadOnlySpan<byte>(data, checked((int)size))), null);
+        }
+        finally
+        {
+            NativeMethods.FreeBuffer(data);
+        }
+    }
+
+    private static byte[] Utf8(string value)
+    {
+        var bytes = new byte[Encoding.UTF8.GetByteCount(value) + 1];
+        Encoding.UTF8.GetBytes(value, 0, value.Length, bytes, 0);
+        return bytes;
+    }
+}
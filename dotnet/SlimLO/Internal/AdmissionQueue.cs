@@ -0,0 +1,362 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace SlimLO.Internal;
+
+/// <summary>
+/// Admission gate of the worker pool: hands out one slot per worker, sharing
+/// them across tenants by weighted fair queuing. Each tenant (null = the
+/// default tenant) has its own queue, ordered earliest-deadline-first with
+/// requests without a deadline last, FIFO. A freed slot goes to the head of
+/// the eligible tenant with the least weighted service so far — a tenant of
+/// weight 2 gets twice the admissions of a tenant of weight 1 while both wait —
+/// and a tenant at its concurrency cap is passed over.
+/// A request that cannot finish before its deadline, estimated from recent
+/// service times, is shed instead of queued; one still queued when its
+/// deadline passes, or found infeasible when a slot frees, is shed as well.
+/// Deadlines are <see cref="Stopwatch"/> timestamps. Thread-safe.
+/// </summary>
+internal sealed class AdmissionQueue : IDisposable
+{
+    /// <summary>Deadline of requests that may wait indefinitely.</summary>
+    public const long NoDeadline = long.MaxValue;
+
+    private readonly int _slots;
+    private readonly IReadOnlyDictionary<string, int>? _weights;
+    private readonly int _maxPerTenant;
+    private readonly Dictionary<string, Tenant> _tenants = new(StringComparer.Ordinal);
+    private readonly object _sync = new();
+    private int _free;
+    private int _queued;
+    private long _sequence;
+    private long _shedCount;
+    private double _virtualTime; // virtual start time of the last admission
+    private double _serviceTicks; // moving average, 0 = no sample yet
+    private bool _disposed;
+
+    /// <summary>
+    /// Per-tenant state. Tenants exist only while they have requests queued or
+    /// running, so an idle tenant rejoins at the current virtual time and does
+    /// not bank credit for a later burst.
+    /// </summary>
+    private sealed class Tenant
+    {
+        public Tenant(string key, int weight)
+        {
+            Key = key;
+            Weight = weight;
+        }
+
+        public string Key { get; }
+        public int Weight { get; }
+        public SortedSet<Waiter> Waiters { get; } = new(WaiterComparer.Instance);
+        public int Running { get; set; }
+
+        /// <summary>Admissions so far divided by weight, in the queue's virtual time.</summary>
+        public double VirtualTime { get; set; }
+    }
+
+    private sealed class Waiter
+    {
+        public Waiter(Tenant tenant, long deadline, long sequence)
+        {
+            Tenant = tenant;
+            Deadline = deadline;
+            Sequence = sequence;
+        }
+
+        public Tenant Tenant { get; }
+        public long Deadline { get; }
+        public long Sequence { get; }
+        public TaskCompletionSource<bool> Completion { get; } =
+            new(TaskCreationOptions.RunContinuationsAsynchronously);
+        public Timer? Timer { get; set; }
+    }
+
+    private sealed class WaiterComparer : IComparer<Waiter>
+    {
+        public static readonly WaiterComparer Instance = new();
+
+        public int Compare(Waiter? x, Waiter? y)
+        {
+            int c = x!.Deadline.CompareTo(y!.Deadline);
+            return c != 0 ? c : x.Sequence.CompareTo(y.Sequence);
+        }
+    }
+
+    /// <param name="slots">Requests admitted at once.</param>
+    /// <param name="weights">Tenant weights; tenants not listed weigh 1.</param>
+    /// <param name="maxPerTenant">Slots one tenant may hold at once, 0 = no cap.</param>
+    public AdmissionQueue(int slots, IReadOnlyDictionary<string, int>? weights = null, int maxPerTenant = 0)
+    {
+        _slots = slots;
+        _free = slots;
+        _weights = weights;
+        _maxPerTenant = maxPerTenant;
+    }
+
+    /// <summary>Requests waiting for a slot.</summary>
+    public int QueueLength
+    {
+        get { lock (_sync) return _queued; }
+    }
+
+    /// <summary>Requests of one tenant waiting for a slot.</summary>
+    public int QueueLengthOf(string? tenant)
+    {
+        lock (_sync)
+            return _tenants.TryGetValue(tenant ?? "", out var t) ? t.Waiters.Count : 0;
+    }
+
+    /// <summary>Requests rejected because they could not finish before their deadline.</summary>
+    public long ShedCount => Interlocked.Read(ref _shedCount);
+
+    /// <summary>Moving average of recent service times, or null before the first sample.</summary>
+    public TimeSpan? EstimatedServiceTime
+    {
+        get
+        {
+            lock (_sync)
+                return _serviceTicks > 0 ? StopwatchToTimeSpan((long)_serviceTicks) : null;
+        }
+    }
+
+    /// <summary>Absolute deadline for a request submitted now, or <see cref="NoDeadline"/>.</summary>
+    public static long DeadlineAfter(TimeSpan? timeout)
+    {
+        if (timeout is not { } t)
+            return NoDeadline;
+        if (t <= TimeSpan.Zero)
+            return Stopwatch.GetTimestamp();
+        double ticks = t.TotalSeconds * Stopwatch.Frequency;
+        long now = Stopwatch.GetTimestamp();
+        return ticks >= NoDeadline - now ? NoDeadline : now + (long)ticks;
+    }
+
+    /// <summary>
+    /// Wait for a slot. Returns true once admitted (the caller must call
+    /// <see cref="Release"/> with the same tenant), false if the request was shed.
+    /// </summary>
+    public Task<bool> WaitAsync(string? tenant, long deadline, CancellationToken ct)
+    {
+        ct.ThrowIfCancellationRequested();
+        Waiter waiter;
+        lock (_sync)
+        {
+            ThrowHelpers.ThrowIfDisposed(_disposed, this);
+            long now = Stopwatch.GetTimestamp();
+            var t = GetTenant(tenant ?? "");
+
+            double ahead = _free > 0 && _queued == 0 && !AtCap(t)
+                ? 0
+                : (deadline == NoDeadline ? _queued : CountAhead(deadline)) + 0.5;
+            if (!CanFinish(now, deadline, ahead))
+            {
+                RemoveIfIdle(t);
+                return Shed();
+            }
+
+            // A tenant starting a new backlog catches up with the others' virtual time
+            if (t.Waiters.Count == 0)
+                t.VirtualTime = Math.Max(t.VirtualTime, _virtualTime);
+            waiter = new Waiter(t, deadline, ++_sequence);
+            t.Waiters.Add(waiter);
+            _queued++;
+            Dispatch(now);
+
+            if (waiter.Completion.Task.IsCompleted)
+                return waiter.Completion.Task;
+            if (deadline != NoDeadline)
+                waiter.Timer = new Timer(_ => Expire(waiter), null, DueTime(deadline - now), Timeout.Infinite);
+        }
+
+        return ct.CanBeCanceled ? WaitQueuedAsync(waiter, ct) : waiter.Completion.Task;
+    }
+
+    // The registration is disposed by the waiting caller, never under _sync:
+    // disposing it waits for a running Cancel, which takes _sync.
+    private async Task<bool> WaitQueuedAsync(Waiter waiter, CancellationToken ct)
+    {
+        using (ct.Register(() => Cancel(waiter, ct)))
+            return await waiter.Completion.Task.ConfigureAwait(false);
+    }
+
+    /// <summary>Return a tenant's slot and admit the next feasible waiter.</summary>
+    public void Release(string? tenant)
+    {
+        lock (_sync)
+        {
+            if (_tenants.TryGetValue(tenant ?? "", out var t) && t.Running > 0)
+            {
+                t.Running--;
+                RemoveIfIdle(t);
+            }
+            _free++;
+            Dispatch(Stopwatch.GetTimestamp());
+        }
+    }
+
+    /// <summary>Feed the service-time estimate with one finished request.</summary>
+    public void RecordServiceTime(long elapsedTicks)
+    {
+        lock (_sync)
+            _serviceTicks = _serviceTicks > 0 ? 0.8 * _serviceTicks + 0.2 * elapsedTicks : elapsedTicks;
+    }
+
+    public void Dispose()
+    {
+        lock (_sync)
+        {
+            if (_disposed) return;
+            _disposed = true;
+            foreach (var t in _tenants.Values)
+            {
+                foreach (var waiter in t.Waiters)
+                {
+                    waiter.Timer?.Dispose();
+                    waiter.Completion.TrySetException(new ObjectDisposedException(nameof(WorkerPool)));
+                }
+            }
+            _tenants.Clear();
+            _queued = 0;
+        }
+    }
+
+    /// <summary>
+    /// Hand free slots to waiters: each goes to the head of the eligible tenant
+    /// with the lowest virtual time (ties to the longest waiting). Heads that can
+    /// no longer meet their deadline are shed on the way. Called under _sync.
+    /// </summary>
+    private void Dispatch(long now)
+    {
+        while (_free > 0 && _queued > 0)
+        {
+            Tenant? best = null;
+            foreach (var t in _tenants.Values)
+            {
+                if (t.Waiters.Count == 0 || AtCap(t))
+                    continue;
+                if (best == null || t.VirtualTime < best.VirtualTime ||
+                    (t.VirtualTime == best.VirtualTime && t.Waiters.Min!.Sequence < best.Waiters.Min!.Sequence))
+                    best = t;
+            }
+            if (best == null)
+                return; // everyone waiting is at their tenant's cap
+
+            var next = best.Waiters.Min!;
+            best.Waiters.Remove(next);
+            _queued--;
+            next.Timer?.Dispose();
+            if (!CanFinish(now, next.Deadline, 0))
+            {
+                Interlocked.Increment(ref _shedCount);
+                next.Completion.TrySetResult(false);
+                RemoveIfIdle(best);
+                continue;
+            }
+
+            _free--;
+            best.Running++;
+            _virtualTime = best.VirtualTime;
+            best.VirtualTime += 1.0 / best.Weight;
+            next.Completion.TrySetResult(true);
+        }
+    }
+
+    private Tenant GetTenant(string key)
+    {
+        if (!_tenants.TryGetValue(key, out var t))
+        {
+            int weight = _weights != null && _weights.TryGetValue(key, out var w) ? w : 1;
+            t = new Tenant(key, weight) { VirtualTime = _virtualTime };
+            _tenants.Add(key, t);
+        }
+        return t;
+    }
+
+    private bool AtCap(Tenant t) => _maxPerTenant > 0 && t.Running >= _maxPerTenant;
+
+    private void RemoveIfIdle(Tenant t)
+    {
+        if (t.Running == 0 && t.Waiters.Count == 0)
+            _tenants.Remove(t.Key);
+    }
+
+    /// <summary>
+    /// Whether a request starting after about <paramref name="queuedAhead"/> others can
+    /// finish by its deadline. Rough: the slots drain the queue at one request per
+    /// average service time each. Unknown service time is assumed feasible.
+    /// </summary>
+    private bool CanFinish(long now, long deadline, double queuedAhead)
+    {
+        if (deadline == NoDeadline)
+            return true;
+        if (now >= deadline)
+            return false;
+        return _serviceTicks <= 0 ||
+            now + _serviceTicks * (1 + queuedAhead / _slots) <= deadline;
+    }
+
+    /// <summary>Waiters of any tenant due no later than <paramref name="deadline"/>.</summary>
+    private int CountAhead(long deadline)
+    {
+        int count = 0;
+        foreach (var t in _tenants.Values)
+        {
+            foreach (var w in t.Waiters)
+            {
+                if (w.Deadline > deadline)
+                    break;
+                count++;
+            }
+        }
+        return count;
+    }
+
+    private Task<bool> Shed()
+    {
+        Interlocked.Increment(ref _shedCount);
+        return Task.FromResult(false);
+    }
+
+    private void Expire(Waiter waiter)
+    {
+        lock (_sync)
+        {
+            if (!Dequeue(waiter))
+                return;
+        }
+        Interlocked.Increment(ref _shedCount);
+        waiter.Completion.TrySetResult(false);
+    }
+
+    private void Cancel(Waiter waiter, CancellationToken ct)
+    {
+        lock (_sync)
+        {
+            if (!Dequeue(waiter))
+                return;
+        }
+        waiter.Completion.TrySetCanceled(ct);
+    }
+
+    /// <summary>Take a waiter out of its queue, if still queued. Called under _sync.</summary>
+    private bool Dequeue(Waiter waiter)
+    {
+        if (!waiter.Tenant.Waiters.Remove(waiter))
+            return false;
+        _queued--;
+        waiter.Timer?.Dispose();
+        RemoveIfIdle(waiter.Tenant);
+        return true;
+    }
+
+    private static long DueTime(long stopwatchTicks) =>
+        Math.Min((long)StopwatchToTimeSpan(stopwatchTicks).TotalMilliseconds + 1, uint.MaxValue - 1L);
+
+    private static TimeSpan StopwatchToTimeSpan(long stopwatchTicks) =>
+        TimeSpan.FromSeconds((double)stopwatchTicks / Stopwatch.Frequency);
+}
@@ -0,0 +1,133 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+using System.Linq;
+
+namespace SlimLO.Internal;
+
+/// <summary>
+/// CPUs available to this process grouped by NUMA node, read from sysfs
+/// (/sys/devices/system/node/node*/cpulist) and restricted to the process's
+/// affinity (Cpus_allowed_list in /proc/self/status), and the split of those
+/// CPUs between pool workers for <see cref="WorkerPlacement.Pinned"/>.
+/// Outside Linux, or when the files cannot be read, all CPUs form one node.
+/// </summary>
+internal static class CpuTopology
+{
+    public const string DefaultRoot = "/sys/devices/system/node";
+    public const string DefaultStatus = "/proc/self/status";
+
+    /// <summary>CPU ids of each NUMA node that has CPUs this process may use.</summary>
+    public static IReadOnlyList<IReadOnlyList<int>> Nodes(string root = DefaultRoot, string status = DefaultStatus)
+    {
+        var allowed = ReadAllowed(status);
+        var nodes = new List<(int Id, IReadOnlyList<int> Cpus)>();
+        try
+        {
+            if (Directory.Exists(root))
+            {
+                foreach (var dir in Directory.GetDirectories(root, "node*"))
+                {
+                    var name = Path.GetFileName(dir);
+                    if (!int.TryParse(name.Substring(4), NumberStyles.None, CultureInfo.InvariantCulture, out var id))
+                        continue;
+                    var cpuList = Path.Combine(dir, "cpulist");
+                    if (!File.Exists(cpuList))
+                        continue;
+                    var cpus = ParseCpuList(File.ReadAllText(cpuList));
+                    if (cpus == null)
+                        continue;
+                    if (allowed != null)
+                        cpus = cpus.Where(allowed.Contains).ToList();
+                    if (cpus.Count > 0)
+                        nodes.Add((id, cpus));
+                }
+            }
+        }
+        catch (IOException)
+        {
+            nodes.Clear();
+        }
+        catch (UnauthorizedAccessException)
+        {
+            nodes.Clear();
+        }
+
+        if (nodes.Count == 0)
+        {
+            IReadOnlyList<int> all = allowed?.OrderBy(c => c).ToList()
+                ?? Enumerable.Range(0, Environment.ProcessorCount).ToList();
+            return new[] { all };
+        }
+        return nodes.OrderBy(n => n.Id).Select(n => n.Cpus).ToList();
+    }
+
+    /// <summary>
+    /// Split the CPUs between <paramref name="workers"/> workers: worker i goes to
+    /// node i mod nodes, and each node's CPUs are divided into contiguous, equal
+    /// shares between the workers it holds. With more workers than CPUs on a node,
+    /// each worker gets one CPU, shared by neighbouring workers.
+    /// </summary>
+    public static IReadOnlyList<int>[] Partition(IReadOnlyList<IReadOnlyList<int>> nodes, int workers)
+    {
+        var sets = new IReadOnlyList<int>[workers];
+        for (int i = 0; i < workers; i++)
+        {
+            var cpus = nodes[i % nodes.Count];
+            int onNode = (workers - i % nodes.Count + nodes.Count - 1) / nodes.Count;
+            int rank = i / nodes.Count;
+            int start = rank * cpus.Count / onNode;
+            int end = (rank + 1) * cpus.Count / onNode;
+            sets[i] = onNode <= cpus.Count
+                ? cpus.Skip(start).Take(end - start).ToList()
+                : new[] { cpus[start] };
+        }
+        return sets;
+    }
+
+    /// <summary>Parse a kernel CPU list such as "0-3,8-11,16"; null if malformed.</summary>
+    internal static List<int>? ParseCpuList(string text)
+    {
+        var cpus = new List<int>();
+        foreach (var part in text.Trim().Split(new[] { ',' }, StringSplitOptions.RemoveEmptyEntries))
+        {
+            var range = part.Split('-');
+            if (!int.TryParse(range[0], NumberStyles.None, CultureInfo.InvariantCulture, out var first))
+                return null;
+            int last = first;
+            if (range.Length == 2
+                && !int.TryParse(range[1], NumberStyles.None, CultureInfo.InvariantCulture, out last))
+                return null;
+            if (range.Length > 2 || last < first)
+                return null;
+            for (int cpu = first; cpu <= last; cpu++)
+                cpus.Add(cpu);
+        }
+        return cpus;
+    }
+
+    private static HashSet<int>? ReadAllowed(string status)
+    {
+        try
+        {
+            if (!File.Exists(status))
+                return null;
+            foreach (var line in File.ReadLines(status))
+            {
+                if (line.StartsWith("Cpus_allowed_list:", StringComparison.Ordinal))
+                {
+                    var cpus = ParseCpuList(line.Substring("Cpus_allowed_list:".Length));
+                    return cpus is { Count: > 0 } ? new HashSet<int>(cpus) : null;
+                }
+            }
+        }
+        catch (IOException)
+        {
+        }
+        catch (UnauthorizedAccessException)
+        {
+        }
+        return null;
+    }
+}
@@ -0,0 +1,143 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Security.Cryptography;
+
+namespace SlimLO.Internal;
+
+/// <summary>
+/// Bounded record of documents that crashed a worker process, keyed by a
+/// SHA-256 of the document bytes. A document that crashed a worker
+/// <c>threshold</c> times is quarantined and refused before dispatch, so
+/// retries and duplicate submissions stop killing warm workers.
+/// Least recently seen entries are evicted once <c>capacity</c> is reached.
+/// Thread-safe.
+/// </summary>
+internal sealed class CrashQuarantine
+{
+    private readonly int _threshold;
+    private readonly int _capacity;
+    private readonly Dictionary<string, LinkedListNode<Entry>> _entries;
+    private readonly LinkedList<Entry> _lru = new();
+    private readonly object _sync = new();
+
+    private sealed class Entry
+    {
+        public Entry(string key) { Key = key; }
+        public string Key { get; }
+        public int Crashes { get; set; }
+    }
+
+    public CrashQuarantine(int threshold, int capacity)
+    {
+        _threshold = threshold;
+        _capacity = capacity;
+        _entries = new Dictionary<string, LinkedListNode<Entry>>(StringComparer.Ordinal);
+    }
+
+    /// <summary>Crashes after which a document is refused.</summary>
+    public int Threshold => _threshold;
+
+    /// <summary>Number of documents currently tracked (suspects and quarantined).</summary>
+    public int Count
+    {
+        get { lock (_sync) return _entries.Count; }
+    }
+
+    /// <summary>Key for an in-memory document.</summary>
+    public static string KeyOf(ReadOnlySpan<byte> data)
+    {
+        using var sha = SHA256.Create();
+#if NET5_0_OR_GREATER
+        Span<byte> hash = stackalloc byte[32];
+        sha.TryComputeHash(data, hash, out _);
+        return Convert.ToHexString(hash);
+#else
+        return ToHex(sha.ComputeHash(data.ToArray()));
+#endif
+    }
+
+    /// <summary>
+    /// Key for a document file, from its content so copies of the same attachment
+    /// under different paths share an entry. Null if the file cannot be read;
+    /// the worker then reports the error itself.
+    /// </summary>
+    public static string? KeyOfFile(string path)
+    {
+        try
+        {
+            using var stream = new FileStream(
+                path, FileMode.Open, FileAccess.Read, FileShare.ReadWrite, 81920, FileOptions.SequentialScan);
+            using var sha = SHA256.Create();
+            return ToHex(sha.ComputeHash(stream));
+        }
+        catch (IOException)
+        {
+            return null;
+        }
+        catch (UnauthorizedAccessException)
+        {
+            return null;
+        }
+    }
+
+    /// <summary>Crashes recorded for a document (0 if unknown).</summary>
+    public int CrashCount(string key)
+    {
+        lock (_sync)
+        {
+            return _entries.TryGetValue(key, out var node) ? node.Value.Crashes : 0;
+        }
+    }
+
+    /// <summary>Whether the document reached the crash threshold.</summary>
+    public bool IsQuarantined(string key) => CrashCount(key) >= _threshold;
+
+    /// <summary>
+    /// Record that the document crashed a worker.
+    /// Returns the document's crash count including this one.
+    /// </summary>
+    public int RecordCrash(string key)
+    {
+        lock (_sync)
+        {
+            if (_entries.TryGetValue(key, out var node))
+            {
+                _lru.Remove(node);
+            }
+            else
+            {
+                if (_entries.Count >= _capacity)
+                {
+                    var oldest = _lru.Last!;
+                    _lru.RemoveLast();
+                    _entries.Remove(oldest.Value.Key);
+                }
+                node = new LinkedListNode<Entry>(new Entry(key));
+                _entries[key] = node;
+            }
+            _lru.AddFirst(node);
+            return ++node.Value.Crashes;
+        }
+    }
+
+    private static string ToHex(byte[] hash)
+    {
+#if NET5_0_OR_GREATER
+        return Convert.ToHexString(hash);
+#else
+        var chars = new char[hash.Length * 2];
+        for (int i = 0; i < hash.Length; i++)
+        {
+            chars[i * 2] = GetHexChar(hash[i] >> 4);
+            chars[i * 2 + 1] = GetHexChar(hash[i] & 0xF);
+        }
+        return new string(chars);
+#endif
+    }
+
+#if !NET5_0_OR_GREATER
+    private static char GetHexChar(int nibble) =>
+        (char)(nibble < 10 ? '0' + nibble : 'A' + nibble - 10);
+#endif
+}
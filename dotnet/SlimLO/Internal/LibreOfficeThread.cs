@@ -0,0 +1,86 @@
+using System;
+using System.Collections.Concurrent;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace SlimLO.Internal;
+
+/// <summary>
+/// The one thread that calls into an in-process LibreOffice: it initializes
+/// the instance, runs every conversion in submission order, and destroys it.
+/// LibreOffice keeps thread-affine state (the solar mutex owner, its VCL main
+/// thread), so all calls stay on this thread instead of the callers' pool threads.
+/// </summary>
+internal sealed class LibreOfficeThread : IDisposable
+{
+    private readonly BlockingCollection<Action> _work = new();
+    private readonly Thread _thread;
+
+    public LibreOfficeThread(string name)
+    {
+        _thread = new Thread(Run)
+        {
+            Name = name,
+            IsBackground = true
+        };
+        _thread.Start();
+    }
+
+    /// <summary>
+    /// Run <paramref name="work"/> on the thread. A cancelled token only withdraws
+    /// work that has not started: a running conversion cannot be interrupted.
+    /// </summary>
+    public Task<T> RunAsync<T>(Func<T> work, CancellationToken cancellationToken = default)
+    {
+        var tcs = new TaskCompletionSource<T>(TaskCreationOptions.RunContinuationsAsynchronously);
+        if (cancellationToken.IsCancellationRequested)
+        {
+            tcs.SetCanceled();
+            return tcs.Task;
+        }
+
+        var registration = cancellationToken.CanBeCanceled
+            ? cancellationToken.Register(() => tcs.TrySetCanceled(cancellationToken))
+            : default;
+        try
+        {
+            _work.Add(() =>
+            {
+                registration.Dispose();
+                if (tcs.Task.IsCompleted)
+                    return;
+                try
+                {
+                    tcs.TrySetResult(work());
+                }
+                catch (Exception ex)
+                {
+                    tcs.TrySetException(ex);
+                }
+            });
+        }
+        catch (InvalidOperationException)
+        {
+            registration.Dispose();
+            throw new ObjectDisposedException(nameof(LibreOfficeThread));
+        }
+        return tcs.Task;
+    }
+
+    /// <summary>Run <paramref name="work"/> on the thread and wait for it.</summary>
+    public T Run<T>(Func<T> work) => RunAsync(work).GetAwaiter().GetResult();
+
+    /// <summary>Let queued work finish, then stop the thread.</summary>
+    public void Dispose()
+    {
+        _work.CompleteAdding();
+        if (Thread.CurrentThread != _thread)
+            _thread.Join();
+    }
+
+    private void Run()
+    {
+        foreach (var work in _work.GetConsumingEnumerable())
+            work();
+    }
+}
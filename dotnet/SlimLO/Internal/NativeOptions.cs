@@ -0,0 +1,75 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Text;
+
+namespace SlimLO.Internal;
+
+/// <summary>
+/// UTF-8 strings in unmanaged memory for one native call, freed on dispose.
+/// </summary>
+internal sealed class NativeStrings : IDisposable
+{
+    private readonly List<IntPtr> _allocated = new();
+
+    /// <summary>Copy <paramref name="value"/> as a NUL-terminated UTF-8 string (null stays null).</summary>
+    public IntPtr Add(string? value)
+    {
+        if (value == null)
+            return IntPtr.Zero;
+
+        var bytes = Encoding.UTF8.GetBytes(value);
+        var ptr = Marshal.AllocHGlobal(bytes.Length + 1);
+        Marshal.Copy(bytes, 0, ptr, bytes.Length);
+        Marshal.WriteByte(ptr, bytes.Length, 0);
+        _allocated.Add(ptr);
+        return ptr;
+    }
+
+    public void Dispose()
+    {
+        foreach (var ptr in _allocated)
+            Marshal.FreeHGlobal(ptr);
+        _allocated.Clear();
+    }
+}
+
+/// <summary>
+/// <see cref="ConversionOptions"/> as the native SlimLOPdfOptions, built the way
+/// the worker builds it from a request's "options" object.
+/// </summary>
+internal static class NativeOptions
+{
+    public static NativePdfOptions FromConversionOptions(ConversionOptions options, NativeStrings strings) =>
+        new()
+        {
+            PdfVersion = (int)options.PdfVersion,
+            JpegQuality = options.JpegQuality,
+            Dpi = options.Dpi,
+            TaggedPdf = options.TaggedPdf ? 1 : 0,
+            PageRange = strings.Add(options.PageRange),
+            Password = strings.Add(options.Password),
+            Preset = (int)options.Preset,
+            FilterOptions = strings.Add(FilterOptionsString(options.FilterProperties)),
+            LazyLayout = options.LazyLayout ? 1 : 0,
+            SkipFieldUpdate = options.SkipFieldUpdate ? 1 : 0
+        };
+
+    /// <summary>Filter properties in the "Key=Value,..." form of SlimLOPdfOptions.filter_options.</summary>
+    public static string? FilterOptionsString(IReadOnlyDictionary<string, string>? properties)
+    {
+        if (properties is not { Count: > 0 })
+            return null;
+
+        var sb = new StringBuilder();
+        foreach (var kv in properties)
+        {
+            if (string.IsNullOrEmpty(kv.Key))
+                continue;
+            if (sb.Length > 0)
+                sb.Append(',');
+            sb.Append(kv.Key).Append('=').Append(kv.Value);
+        }
+        return sb.Length > 0 ? sb.ToString() : null;
+    }
+}
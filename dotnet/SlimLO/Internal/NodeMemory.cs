@@ -0,0 +1,60 @@
+using System;
+using System.Globalization;
+using System.IO;
+
+namespace SlimLO.Internal;
+
+/// <summary>
+/// Memory limit and usage of the control group this process runs in, read from
+/// cgroup v2 (memory.max, memory.current) or v1 (memory.limit_in_bytes,
+/// memory.usage_in_bytes). Worker processes are children of this process and
+/// count against the same group. Values are null outside Linux, when no limit
+/// is set, or when the files cannot be read.
+/// </summary>
+internal static class NodeMemory
+{
+    public const string DefaultRoot = "/sys/fs/cgroup";
+
+    // v1 reports "no limit" as a page-aligned value near long.MaxValue
+    private const long UnlimitedV1 = long.MaxValue / 2;
+
+    /// <summary>Memory limit in bytes, or null if unlimited or unknown.</summary>
+    public static long? Limit(string root = DefaultRoot)
+    {
+        long? limit = ReadBytes(Path.Combine(root, "memory.max"))
+            ?? ReadBytes(Path.Combine(root, "memory", "memory.limit_in_bytes"));
+        return limit is { } l && l < UnlimitedV1 ? l : null;
+    }
+
+    /// <summary>Memory in use by the group in bytes, or null if unknown.</summary>
+    public static long? Usage(string root = DefaultRoot) =>
+        ReadBytes(Path.Combine(root, "memory.current"))
+            ?? ReadBytes(Path.Combine(root, "memory", "memory.usage_in_bytes"));
+
+    /// <summary>Parse a cgroup memory file: a byte count, or "max" for no limit.</summary>
+    internal static long? ParseBytes(string text)
+    {
+        text = text.Trim();
+        if (text == "max")
+            return long.MaxValue;
+        return long.TryParse(text, NumberStyles.None, CultureInfo.InvariantCulture, out var bytes)
+            ? bytes
+            : null;
+    }
+
+    private static long? ReadBytes(string path)
+    {
+        try
+        {
+            return File.Exists(path) ? ParseBytes(File.ReadAllText(path)) : null;
+        }
+        catch (IOException)
+        {
+            return null;
+        }
+        catch (UnauthorizedAccessException)
+        {
+            return null;
+        }
+    }
+}
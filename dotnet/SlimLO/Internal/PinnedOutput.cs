@@ -0,0 +1,143 @@
+using System;
+using System.Buffers;
+using System.Runtime.InteropServices;
+
+namespace SlimLO.Internal;
+
+/// <summary>
+/// A SlimLOAllocator that places the PDF in managed memory: slimlo_convert_buffer_alloc
+/// stages the output and asks for one block at its final size, which is created
+/// here and pinned until the conversion returns. The native code writes the PDF
+/// straight into the array the caller receives — no native buffer to copy out of.
+/// </summary>
+internal abstract class PinnedOutput : IDisposable
+{
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    private delegate IntPtr AllocCallback(IntPtr context, nuint size);
+
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    private delegate void FreeCallback(IntPtr context, IntPtr ptr, nuint size);
+
+    // Rooted for the process lifetime: native code holds the function pointers
+    private static readonly AllocCallback s_alloc = Alloc;
+    private static readonly FreeCallback s_free = Free;
+    private static readonly IntPtr s_allocPtr = Marshal.GetFunctionPointerForDelegate(s_alloc);
+    private static readonly IntPtr s_freePtr = Marshal.GetFunctionPointerForDelegate(s_free);
+
+    private GCHandle _self;
+    private MemoryHandle _pin;
+    private bool _pinned;
+
+    /// <summary>
+    /// The native allocator for this output. No realloc: managed arrays cannot
+    /// grow in place, so SlimLO allocates once at the final size.
+    /// </summary>
+    public NativeAllocator Allocator()
+    {
+        if (!_self.IsAllocated)
+            _self = GCHandle.Alloc(this);
+        return new NativeAllocator
+        {
+            Alloc = s_allocPtr,
+            Realloc = IntPtr.Zero,
+            Free = s_freePtr,
+            Context = GCHandle.ToIntPtr(_self)
+        };
+    }
+
+    /// <summary>Create the block of <paramref name="size"/> bytes the PDF is written into.</summary>
+    protected abstract Memory<byte> Create(int size);
+
+    /// <summary>Drop the block: the conversion failed after allocating it.</summary>
+    protected abstract void Discard();
+
+    /// <summary>Unpin the output; the block stays with the subclass.</summary>
+    public void Dispose()
+    {
+        Unpin();
+        if (_self.IsAllocated)
+            _self.Free();
+    }
+
+    private void Unpin()
+    {
+        if (_pinned)
+        {
+            _pin.Dispose();
+            _pinned = false;
+        }
+    }
+
+    // Exceptions must not cross into native code: a failure is a null block,
+    // which SlimLO reports as SLIMLO_ERROR_OUT_OF_MEMORY.
+    private static IntPtr Alloc(IntPtr context, nuint size)
+    {
+        try
+        {
+            var output = (PinnedOutput)GCHandle.FromIntPtr(context).Target!;
+            if (output._pinned || size > int.MaxValue)
+                return IntPtr.Zero;
+            output._pin = output.Create((int)size).Pin();
+            output._pinned = true;
+            unsafe
+            {
+                return (IntPtr)output._pin.Pointer;
+            }
+        }
+        catch
+        {
+            return IntPtr.Zero;
+        }
+    }
+
+    private static void Free(IntPtr context, IntPtr ptr, nuint size)
+    {
+        try
+        {
+            var output = (PinnedOutput)GCHandle.FromIntPtr(context).Target!;
+            output.Unpin();
+            output.Discard();
+        }
+        catch
+        {
+            // Nothing to report to native code
+        }
+    }
+}
+
+/// <summary>The PDF in a new <c>byte[]</c> of exactly its size.</summary>
+internal sealed class ArrayOutput : PinnedOutput
+{
+    public byte[]? Array { get; private set; }
+
+    protected override Memory<byte> Create(int size)
+    {
+#if NET8_0_OR_GREATER
+        // Every byte is written by SlimLO before the array is handed out
+        Array = GC.AllocateUninitializedArray<byte>(size);
+#else
+        Array = new byte[size];
+#endif
+        return Array;
+    }
+
+    protected override void Discard() => Array = null;
+}
+
+/// <summary>The PDF in an array rented from <see cref="ArrayPool{T}.Shared"/>.</summary>
+internal sealed class PooledOutput : PinnedOutput
+{
+    public PooledBuffer? Buffer { get; private set; }
+
+    protected override Memory<byte> Create(int size)
+    {
+        Buffer = new PooledBuffer(size);
+        return Buffer.Memory;
+    }
+
+    protected override void Discard()
+    {
+        Buffer?.Dispose();
+        Buffer = null;
+    }
+}
@@ -0,0 +1,90 @@
+using System;
+using System.Buffers;
+using System.IO;
+using System.Runtime.InteropServices;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace SlimLO.Internal;
+
+/// <summary>
+/// Polyfill for the Memory-based <see cref="Stream"/> overloads that don't exist on
+/// .NET Standard 2.0. Array-backed memory is passed straight through; anything else
+/// goes through a buffer rented from <see cref="ArrayPool{T}.Shared"/>, never a copy
+/// of the whole payload.
+/// </summary>
+internal static class StreamHelpers
+{
+    private const int ChunkSize = 81920; // below the large-object-heap threshold
+
+    /// <summary>Write <paramref name="data"/> to <paramref name="stream"/>.</summary>
+    public static async Task WriteAsync(Stream stream, ReadOnlyMemory<byte> data, CancellationToken ct)
+    {
+#if NET8_0_OR_GREATER
+        await stream.WriteAsync(data, ct).ConfigureAwait(false);
+#else
+        if (MemoryMarshal.TryGetArray(data, out var segment))
+        {
+            await stream.WriteAsync(segment.Array!, segment.Offset, segment.Count, ct).ConfigureAwait(false);
+            return;
+        }
+
+        var chunk = ArrayPool<byte>.Shared.Rent(Math.Min(data.Length, ChunkSize));
+        try
+        {
+            for (int offset = 0; offset < data.Length;)
+            {
+                int count = Math.Min(chunk.Length, data.Length - offset);
+                data.Slice(offset, count).CopyTo(chunk);
+                await stream.WriteAsync(chunk, 0, count, ct).ConfigureAwait(false);
+                offset += count;
+            }
+        }
+        finally
+        {
+            ArrayPool<byte>.Shared.Return(chunk);
+        }
+#endif
+    }
+
+    /// <summary>Read up to <c>buffer.Length</c> bytes; returns 0 at end of stream.</summary>
+    public static async Task<int> ReadAsync(Stream stream, Memory<byte> buffer, CancellationToken ct)
+    {
+#if NET8_0_OR_GREATER
+        return await stream.ReadAsync(buffer, ct).ConfigureAwait(false);
+#else
+        if (MemoryMarshal.TryGetArray<byte>(buffer, out var segment))
+            return await stream.ReadAsync(segment.Array!, segment.Offset, segment.Count, ct).ConfigureAwait(false);
+
+        var chunk = ArrayPool<byte>.Shared.Rent(Math.Min(buffer.Length, ChunkSize));
+        try
+        {
+            int read = await stream.ReadAsync(chunk, 0, Math.Min(chunk.Length, buffer.Length), ct)
+                .ConfigureAwait(false);
+            chunk.AsSpan(0, read).CopyTo(buffer.Span);
+            return read;
+        }
+        finally
+        {
+            ArrayPool<byte>.Shared.Return(chunk);
+        }
+#endif
+    }
+
+    /// <summary>
+    /// Fill <paramref name="buffer"/> from <paramref name="stream"/>.
+    /// Returns the number of bytes read, less than <c>buffer.Length</c> only at end of stream.
+    /// </summary>
+    public static async Task<int> ReadExactAsync(Stream stream, Memory<byte> buffer, CancellationToken ct)
+    {
+        int totalRead = 0;
+        while (totalRead < buffer.Length)
+        {
+            int read = await ReadAsync(stream, buffer.Slice(totalRead), ct).ConfigureAwait(false);
+            if (read == 0)
+                return totalRead; // EOF
+            totalRead += read;
+        }
+        return totalRead;
+    }
+}
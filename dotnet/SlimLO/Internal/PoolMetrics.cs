@@ -0,0 +1,120 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Diagnostics.Metrics;
+using System.Text.Json;
+
+namespace SlimLO.Internal;
+
+/// <summary>
+/// The <see cref="System.Diagnostics.Metrics"/> instruments of one worker pool,
+/// published under the <see cref="PdfConverter.MeterName"/> meter. Instruments
+/// with no listener attached reduce to a flag check, so they stay always on.
+/// Conversion phases and bytes come from the "metrics" object the worker adds
+/// to each convert result.
+/// </summary>
+internal sealed class PoolMetrics : IDisposable
+{
+    private readonly Meter _meter;
+    private readonly Histogram<double> _queueWait;
+    private readonly Histogram<double> _duration;
+    private readonly Counter<long> _bytesIn;
+    private readonly Counter<long> _bytesOut;
+    private readonly Counter<long> _workerStarts;
+    private readonly Counter<long> _workerRecycles;
+    private readonly Counter<long> _workerCrashes;
+    private readonly Counter<long> _timeouts;
+    private readonly Counter<long> _fontFallbacks;
+
+    public PoolMetrics(Func<int> queueDepth, Func<IEnumerable<Measurement<long>>> workerMemory)
+    {
+        _meter = new Meter(PdfConverter.MeterName, typeof(PoolMetrics).Assembly.GetName().Version?.ToString());
+        _meter.CreateObservableGauge("slimlo.queue.depth", queueDepth, "{request}",
+            "Requests waiting for a worker.");
+        _queueWait = _meter.CreateHistogram<double>("slimlo.queue.wait", "ms",
+            "Time requests spent waiting for a worker.");
+        _duration = _meter.CreateHistogram<double>("slimlo.conversion.duration", "ms",
+            "Conversion time measured by the worker, by phase (load, export, total).");
+        _bytesIn = _meter.CreateCounter<long>("slimlo.conversion.bytes_in", "By",
+            "Size of the documents converted.");
+        _bytesOut = _meter.CreateCounter<long>("slimlo.conversion.bytes_out", "By",
+            "Size of the PDFs produced.");
+        _workerStarts = _meter.CreateCounter<long>("slimlo.worker.starts", "{worker}",
+            "Worker processes started.");
+        _workerRecycles = _meter.CreateCounter<long>("slimlo.worker.recycles", "{worker}",
+            "Worker processes stopped by the pool, by reason (max_conversions, idle).");
+        _workerCrashes = _meter.CreateCounter<long>("slimlo.worker.crashes", "{worker}",
+            "Worker processes that exited during a request.");
+        _timeouts = _meter.CreateCounter<long>("slimlo.worker.timeouts", "{request}",
+            "Requests whose worker was killed for a timeout, by kind (deadline, stall).");
+        _meter.CreateObservableGauge("slimlo.worker.memory", workerMemory, "By",
+            "Resident memory of each worker process.");
+        _fontFallbacks = _meter.CreateCounter<long>("slimlo.font.fallbacks", "{font}",
+            "Fonts a conversion substituted or could not find.");
+    }
+
+    public Meter Meter => _meter;
+
+    public void RecordQueueWait(long elapsedTicks)
+    {
+        if (_queueWait.Enabled)
+            _queueWait.Record(elapsedTicks * 1000.0 / Stopwatch.Frequency);
+    }
+
+    public void RecordWorkerStart() => _workerStarts.Add(1);
+
+    public void RecordRecycle(string reason) =>
+        _workerRecycles.Add(1, new KeyValuePair<string, object?>("reason", reason));
+
+    public void RecordCrash() => _workerCrashes.Add(1);
+
+    public void RecordTimeout(bool stalled) =>
+        _timeouts.Add(1, new KeyValuePair<string, object?>("kind", stalled ? "stall" : "deadline"));
+
+    /// <summary>Record a convert result: phase timings, bytes and font fallbacks.</summary>
+    public void RecordConversion(JsonElement root, IReadOnlyList<ConversionDiagnostic> diagnostics)
+    {
+        if (_fontFallbacks.Enabled)
+        {
+            long fallbacks = 0;
+            for (int i = 0; i < diagnostics.Count; i++)
+            {
+                if (diagnostics[i].Category == DiagnosticCategory.Font)
+                    fallbacks++;
+            }
+            if (fallbacks > 0)
+                _fontFallbacks.Add(fallbacks);
+        }
+
+        if (!root.TryGetProperty("metrics", out var metrics) || metrics.ValueKind != JsonValueKind.Object)
+            return;
+        if (_duration.Enabled)
+        {
+            RecordPhase(metrics, "load_ms", "load");
+            RecordPhase(metrics, "export_ms", "export");
+            RecordPhase(metrics, "total_ms", "total");
+        }
+        if (GetNumber(metrics, "input_bytes") is { } input)
+            _bytesIn.Add((long)input);
+        if (GetNumber(metrics, "output_bytes") is { } output)
+            _bytesOut.Add((long)output);
+    }
+
+    /// <summary>The worker's resident set size from a convert result, or null if it did not report one.</summary>
+    public static long? ResidentBytes(JsonElement root) =>
+        root.TryGetProperty("metrics", out var metrics) && metrics.ValueKind == JsonValueKind.Object
+            && GetNumber(metrics, "rss_bytes") is { } rss
+            ? (long)rss
+            : null;
+
+    private void RecordPhase(JsonElement metrics, string name, string phase)
+    {
+        if (GetNumber(metrics, name) is { } ms)
+            _duration.Record(ms, new KeyValuePair<string, object?>("phase", phase));
+    }
+
+    private static double? GetNumber(JsonElement obj, string name) =>
+        obj.TryGetProperty(name, out var v) && v.ValueKind == JsonValueKind.Number ? v.GetDouble() : null;
+
+    public void Dispose() => _meter.Dispose();
+}
@@ -0,0 +1,33 @@
+using System;
+using System.Buffers;
+using System.Threading;
+
+namespace SlimLO.Internal;
+
+/// <summary>
+/// Bytes held in an array rented from <see cref="ArrayPool{T}.Shared"/>. Disposing
+/// returns the array to the pool; <see cref="Memory"/> must not be used afterwards.
+/// </summary>
+internal sealed class PooledBuffer : IMemoryOwner<byte>
+{
+    private byte[]? _array;
+    private readonly int _length;
+
+    public PooledBuffer(int length)
+    {
+        _array = ArrayPool<byte>.Shared.Rent(length);
+        _length = length;
+    }
+
+    public Memory<byte> Memory =>
+        _array is { } array
+            ? array.AsMemory(0, _length)
+            : throw new ObjectDisposedException(nameof(PooledBuffer));
+
+    public void Dispose()
+    {
+        var array = Interlocked.Exchange(ref _array, null);
+        if (array != null)
+            ArrayPool<byte>.Shared.Return(array);
+    }
+}
@@ -1,4 +1,5 @@
 using System;
+using System.Buffers;
 using System.Buffers.Binary;
 using System.Collections.Generic;
 using System.IO;
@@ -12,40 +13,53 @@ namespace SlimLO.Internal;
 /// <summary>
 /// IPC protocol for communication with the native slimlo_worker process.
 /// Messages are framed as: [4-byte LE uint32 length][UTF-8 JSON payload]
+/// Chunked bodies are a run of non-empty frames ended by a zero-length frame.
 /// </summary>
 internal static class Protocol
 {
     private const int MaxMessageSize = 256 * 1024 * 1024; // 256 MB (documents can be large)
 
+    // Frames up to this size are copied behind their length prefix and sent in one
+    // write; larger ones (documents) are written in place after a separate prefix
+    private const int SingleWriteLimit = 16 * 1024;
+
+    // Upper bound on one read into a caller's IBufferWriter
+    private const int ReadChunkSize = 64 * 1024;
+
+    // Frame size when sending a chunked body; the worker answers in 1 MB frames
+    private const int WriteChunkSize = 256 * 1024;
+
     /// <summary>Write a length-prefixed message to a stream (byte array).</summary>
-    public static async Task WriteMessageAsync(Stream stream, byte[] payload, CancellationToken ct)
-    {
-        var lengthBytes = new byte[4];
-        BinaryPrimitives.WriteUInt32LittleEndian(lengthBytes, (uint)payload.Length);
-#if NET8_0_OR_GREATER
-        await stream.WriteAsync(lengthBytes, ct).ConfigureAwait(false);
-        await stream.WriteAsync(payload, ct).ConfigureAwait(false);
-#else
-        await stream.WriteAsync(lengthBytes, 0, lengthBytes.Length, ct).ConfigureAwait(false);
-        await stream.WriteAsync(payload, 0, payload.Length, ct).ConfigureAwait(false);
-#endif
-        await stream.FlushAsync(ct).ConfigureAwait(false);
-    }
+    public static Task WriteMessageAsync(Stream stream, byte[] payload, CancellationToken ct) =>
+        WriteMessageAsync(stream, payload.AsMemory(), ct);
 
-    /// <summary>Write a length-prefixed binary frame to a stream (ReadOnlyMemory, avoids copying).</summary>
+    /// <summary>
+    /// Write a length-prefixed binary frame to a stream. The payload is never copied
+    /// into a new array; small frames go through a pooled buffer.
+    /// </summary>
     public static async Task WriteMessageAsync(Stream stream, ReadOnlyMemory<byte> payload, CancellationToken ct)
     {
-        var lengthBytes = new byte[4];
-        BinaryPrimitives.WriteUInt32LittleEndian(lengthBytes, (uint)payload.Length);
-#if NET8_0_OR_GREATER
-        await stream.WriteAsync(lengthBytes, ct).ConfigureAwait(false);
-        await stream.WriteAsync(payload, ct).ConfigureAwait(false);
-#else
-        await stream.WriteAsync(lengthBytes, 0, lengthBytes.Length, ct).ConfigureAwait(false);
-        // ReadOnlyMemory<byte> → byte[] for NS2.0 Stream.WriteAsync overload
-        var payloadArray = payload.ToArray();
-        await stream.WriteAsync(payloadArray, 0, payloadArray.Length, ct).ConfigureAwait(false);
-#endif
+        bool single = payload.Length <= SingleWriteLimit;
+        var buffer = ArrayPool<byte>.Shared.Rent(single ? 4 + payload.Length : 4);
+        try
+        {
+            BinaryPrimitives.WriteUInt32LittleEndian(buffer, (uint)payload.Length);
+            if (single)
+            {
+                payload.Span.CopyTo(buffer.AsSpan(4));
+                await StreamHelpers.WriteAsync(stream, buffer.AsMemory(0, 4 + payload.Length), ct)
+                    .ConfigureAwait(false);
+            }
+            else
+            {
+                await StreamHelpers.WriteAsync(stream, buffer.AsMemory(0, 4), ct).ConfigureAwait(false);
+                await StreamHelpers.WriteAsync(stream, payload, ct).ConfigureAwait(false);
+            }
+        }
+        finally
+        {
+            ArrayPool<byte>.Shared.Return(buffer);
+        }
         await stream.FlushAsync(ct).ConfigureAwait(false);
     }
 
@@ -55,40 +69,165 @@ internal static class Protocol
     /// </summary>
     public static async Task<byte[]?> ReadMessageAsync(Stream stream, CancellationToken ct)
     {
-        var lengthBytes = new byte[4];
-        int bytesRead = await ReadExactAsync(stream, lengthBytes, ct).ConfigureAwait(false);
-        if (bytesRead < 4)
+        int? length = await ReadLengthAsync(stream, ct).ConfigureAwait(false);
+        if (length is null)
             return null; // EOF — worker died
 
-        uint length = BinaryPrimitives.ReadUInt32LittleEndian(lengthBytes);
-        if (length > MaxMessageSize)
-            throw new InvalidOperationException($"Message too large: {length} bytes (max {MaxMessageSize})");
-
-        var payload = new byte[length];
-        bytesRead = await ReadExactAsync(stream, payload, ct).ConfigureAwait(false);
-        if (bytesRead < (int)length)
+        var payload = new byte[length.Value];
+        int bytesRead = await StreamHelpers.ReadExactAsync(stream, payload, ct).ConfigureAwait(false);
+        if (bytesRead < payload.Length)
             return null; // EOF — worker died mid-message
 
         return payload;
     }
 
-    private static async Task<int> ReadExactAsync(Stream stream, byte[] buffer, CancellationToken ct)
+    /// <summary>
+    /// Read a length-prefixed binary frame into an array rented from the shared pool,
+    /// so large frames do not land on the large object heap. The caller owns (and
+    /// must dispose) the result. Returns null on EOF (worker process died).
+    /// </summary>
+    public static async Task<PooledBuffer?> ReadPooledMessageAsync(Stream stream, CancellationToken ct)
+    {
+        int? length = await ReadLengthAsync(stream, ct).ConfigureAwait(false);
+        if (length is null)
+            return null;
+
+        var payload = new PooledBuffer(length.Value);
+        try
+        {
+            int bytesRead = await StreamHelpers.ReadExactAsync(stream, payload.Memory, ct).ConfigureAwait(false);
+            if (bytesRead == length.Value)
+                return payload;
+        }
+        catch
+        {
+            payload.Dispose();
+            throw;
+        }
+        payload.Dispose();
+        return null;
+    }
+
+    /// <summary>
+    /// Read a length-prefixed binary frame straight into <paramref name="writer"/>,
+    /// without an intermediate buffer. Returns false on EOF (worker process died);
+    /// the writer may then hold part of the frame.
+    /// </summary>
+    public static async Task<bool> ReadMessageIntoAsync(Stream stream, IBufferWriter<byte> writer, CancellationToken ct)
     {
-        int totalRead = 0;
-        while (totalRead < buffer.Length)
+        int? length = await ReadLengthAsync(stream, ct).ConfigureAwait(false);
+        if (length is null)
+            return false;
+
+        int remaining = length.Value;
+        while (remaining > 0)
         {
-#if NET8_0_OR_GREATER
-            int read = await stream.ReadAsync(
-                buffer.AsMemory(totalRead, buffer.Length - totalRead), ct).ConfigureAwait(false);
-#else
-            int read = await stream.ReadAsync(
-                buffer, totalRead, buffer.Length - totalRead, ct).ConfigureAwait(false);
-#endif
+            var memory = writer.GetMemory(Math.Min(remaining, ReadChunkSize));
+            if (memory.Length > remaining)
+                memory = memory.Slice(0, remaining);
+            int read = await StreamHelpers.ReadAsync(stream, memory, ct).ConfigureAwait(false);
             if (read == 0)
-                return totalRead; // EOF
-            totalRead += read;
+                return false;
+            writer.Advance(read);
+            remaining -= read;
+        }
+        return true;
+    }
+
+    /// <summary>
+    /// Send <paramref name="source"/> as a chunked body: one frame per read of up to
+    /// <c>WriteChunkSize</c> bytes, then a zero-length terminator. Returns the number of
+    /// bytes sent. Only one chunk is buffered at a time.
+    /// </summary>
+    public static async Task<long> WriteChunkedAsync(Stream stream, Stream source, CancellationToken ct)
+    {
+        var buffer = ArrayPool<byte>.Shared.Rent(4 + WriteChunkSize);
+        long total = 0;
+        try
+        {
+            while (true)
+            {
+                int read = await StreamHelpers.ReadExactAsync(source, buffer.AsMemory(4, WriteChunkSize), ct)
+                    .ConfigureAwait(false);
+                if (read > 0)
+                {
+                    BinaryPrimitives.WriteUInt32LittleEndian(buffer, (uint)read);
+                    await StreamHelpers.WriteAsync(stream, buffer.AsMemory(0, 4 + read), ct).ConfigureAwait(false);
+                    total += read;
+                }
+                if (read < WriteChunkSize)
+                    break;
+            }
+
+            BinaryPrimitives.WriteUInt32LittleEndian(buffer, 0);
+            await StreamHelpers.WriteAsync(stream, buffer.AsMemory(0, 4), ct).ConfigureAwait(false);
+        }
+        finally
+        {
+            ArrayPool<byte>.Shared.Return(buffer);
+        }
+        await stream.FlushAsync(ct).ConfigureAwait(false);
+        return total;
+    }
+
+    /// <summary>
+    /// Copy a chunked body to <paramref name="destination"/> frame by frame, as it
+    /// arrives. Returns false on EOF (worker process died); the destination may then
+    /// hold part of the body.
+    /// </summary>
+    public static async Task<bool> ReadChunkedAsync(Stream stream, Stream destination, CancellationToken ct)
+    {
+        var buffer = ArrayPool<byte>.Shared.Rent(ReadChunkSize);
+        try
+        {
+            while (true)
+            {
+                int? length = await ReadLengthAsync(stream, ct).ConfigureAwait(false);
+                if (length is null)
+                    return false;
+                if (length == 0)
+                    break;
+
+                for (int remaining = length.Value; remaining > 0;)
+                {
+                    int read = await StreamHelpers.ReadAsync(
+                        stream, buffer.AsMemory(0, Math.Min(remaining, buffer.Length)), ct).ConfigureAwait(false);
+                    if (read == 0)
+                        return false;
+                    await StreamHelpers.WriteAsync(destination, buffer.AsMemory(0, read), ct).ConfigureAwait(false);
+                    remaining -= read;
+                }
+            }
         }
-        return totalRead;
+        finally
+        {
+            ArrayPool<byte>.Shared.Return(buffer);
+        }
+        await destination.FlushAsync(ct).ConfigureAwait(false);
+        return true;
+    }
+
+    /// <summary>Read a frame's length prefix. Returns null on EOF.</summary>
+    private static async Task<int?> ReadLengthAsync(Stream stream, CancellationToken ct)
+    {
+        var lengthBytes = ArrayPool<byte>.Shared.Rent(4);
+        uint length;
+        try
+        {
+            int bytesRead = await StreamHelpers.ReadExactAsync(stream, lengthBytes.AsMemory(0, 4), ct)
+                .ConfigureAwait(false);
+            if (bytesRead < 4)
+                return null;
+            length = BinaryPrimitives.ReadUInt32LittleEndian(lengthBytes);
+        }
+        finally
+        {
+            ArrayPool<byte>.Shared.Return(lengthBytes);
+        }
+
+        if (length > MaxMessageSize)
+            throw new InvalidOperationException($"Message too large: {length} bytes (max {MaxMessageSize})");
+        return (int)length;
     }
 
     /// <summary>Serialize a message to a UTF-8 JSON byte array.</summary>
@@ -126,18 +265,35 @@ internal sealed class InitRequest
     [JsonPropertyName("font_paths")]
     [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
     public IReadOnlyList<string>? FontPaths { get; init; }
+
+    /// <summary>Thread budget for LibreOffice's internal pools (0 = one per core).</summary>
+    [JsonPropertyName("threads")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingDefault)]
+    public int Threads { get; init; }
+
+    /// <summary>CPUs to pin the worker to, or null to leave it unpinned.</summary>
+    [JsonPropertyName("cpus")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public IReadOnlyList<int>? Cpus { get; init; }
 }
 
 internal sealed class ConvertRequest
 {
     [JsonPropertyName("type")]
-    public string Type => "convert";
+    public string Type => Inputs is null ? "convert" : "combine";
 
     [JsonPropertyName("id")]
     public int Id { get; init; }
 
+    /// <summary>Input path; null for a "combine" request, which sends <see cref="Inputs"/>.</summary>
     [JsonPropertyName("input")]
-    public string Input { get; init; } = "";
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public string? Input { get; init; }
+
+    /// <summary>Documents to combine into one PDF, in order (a "combine" request).</summary>
+    [JsonPropertyName("inputs")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public IReadOnlyList<CombineRequestPart>? Inputs { get; init; }
 
     [JsonPropertyName("output")]
     public string Output { get; init; } = "";
@@ -148,6 +304,31 @@ internal sealed class ConvertRequest
     [JsonPropertyName("options")]
     [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
     public ConvertRequestOptions? Options { get; init; }
+
+    /// <summary>Ask the worker to stream "progress" frames before the result.</summary>
+    [JsonPropertyName("progress")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingDefault)]
+    public bool Progress { get; init; }
+
+    /// <summary>Pages to render from the loaded document; sent back as extra frames.</summary>
+    [JsonPropertyName("render")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public RenderRequestOptions? Render { get; init; }
+
+    /// <summary>Pages whose text to return inline in the result's "text" array.</summary>
+    [JsonPropertyName("text")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public TextRequestOptions? Text { get; init; }
+}
+
+internal sealed class CombineRequestPart
+{
+    [JsonPropertyName("input")]
+    public string Input { get; init; } = "";
+
+    [JsonPropertyName("bookmark")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public string? Bookmark { get; init; }
 }
 
 internal sealed class ConvertRequestOptions
@@ -172,6 +353,21 @@ internal sealed class ConvertRequestOptions
     [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
     public string? Password { get; init; }
 
+    [JsonPropertyName("preset")]
+    public int Preset { get; init; }
+
+    [JsonPropertyName("filter_properties")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public Dictionary<string, string>? FilterProperties { get; init; }
+
+    [JsonPropertyName("lazy_layout")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingDefault)]
+    public bool LazyLayout { get; init; }
+
+    [JsonPropertyName("skip_field_update")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingDefault)]
+    public bool SkipFieldUpdate { get; init; }
+
     public static ConvertRequestOptions? FromConversionOptions(ConversionOptions? options)
     {
         if (options is null)
@@ -184,9 +380,23 @@ internal sealed class ConvertRequestOptions
             Dpi = options.Dpi,
             TaggedPdf = options.TaggedPdf,
             PageRange = options.PageRange,
-            Password = options.Password
+            Password = options.Password,
+            Preset = (int)options.Preset,
+            FilterProperties = options.FilterProperties is { Count: > 0 } props
+                ? CopyProperties(props)
+                : null,
+            LazyLayout = options.LazyLayout,
+            SkipFieldUpdate = options.SkipFieldUpdate
         };
     }
+
+    private static Dictionary<string, string> CopyProperties(IReadOnlyDictionary<string, string> source)
+    {
+        var copy = new Dictionary<string, string>(source.Count);
+        foreach (var kv in source)
+            copy[kv.Key] = kv.Value;
+        return copy;
+    }
 }
 
 internal sealed class ConvertBufferRequest
@@ -203,9 +413,147 @@ internal sealed class ConvertBufferRequest
     [JsonPropertyName("data_size")]
     public long DataSize { get; init; }
 
+    /// <summary>
+    /// The document follows as a chunked body instead of one <see cref="DataSize"/>
+    /// frame, and the PDF comes back chunked too.
+    /// </summary>
+    [JsonPropertyName("chunked")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingDefault)]
+    public bool Chunked { get; init; }
+
     [JsonPropertyName("options")]
     [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
     public ConvertRequestOptions? Options { get; init; }
+
+    /// <summary>Ask the worker to stream "progress" frames before the result.</summary>
+    [JsonPropertyName("progress")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingDefault)]
+    public bool Progress { get; init; }
+
+    /// <summary>Pages to render from the loaded document; sent back as extra frames.</summary>
+    [JsonPropertyName("render")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public RenderRequestOptions? Render { get; init; }
+
+    /// <summary>Pages whose text to return inline in the result's "text" array.</summary>
+    [JsonPropertyName("text")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public TextRequestOptions? Text { get; init; }
+}
+
+/// <summary>
+/// Load + layout only, no export. Either <see cref="Input"/> (file path) is set,
+/// or <see cref="DataSize"/> announces a binary document frame that follows.
+/// </summary>
+internal sealed class InfoRequest
+{
+    [JsonPropertyName("type")]
+    public string Type => "info";
+
+    [JsonPropertyName("id")]
+    public int Id { get; init; }
+
+    [JsonPropertyName("input")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public string? Input { get; init; }
+
+    [JsonPropertyName("format")]
+    public int Format { get; init; }
+
+    [JsonPropertyName("data_size")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public long? DataSize { get; init; }
+}
+
+/// <summary>
+/// Page images without export. Document input works like <see cref="InfoRequest"/>.
+/// </summary>
+internal sealed class RenderRequest
+{
+    [JsonPropertyName("type")]
+    public string Type => "render";
+
+    [JsonPropertyName("id")]
+    public int Id { get; init; }
+
+    [JsonPropertyName("input")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public string? Input { get; init; }
+
+    [JsonPropertyName("format")]
+    public int Format { get; init; }
+
+    [JsonPropertyName("data_size")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public long? DataSize { get; init; }
+
+    [JsonPropertyName("render")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public RenderRequestOptions? Render { get; init; }
+}
+
+internal sealed class RenderRequestOptions
+{
+    [JsonPropertyName("format")]
+    public int Format { get; init; }
+
+    [JsonPropertyName("width")]
+    public int Width { get; init; }
+
+    [JsonPropertyName("page_range")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public string? PageRange { get; init; }
+
+    public static RenderRequestOptions? FromRenderOptions(RenderOptions? options)
+    {
+        if (options is null)
+            return null;
+
+        return new RenderRequestOptions
+        {
+            Format = (int)options.Format,
+            Width = options.Width,
+            PageRange = options.PageRange
+        };
+    }
+}
+
+internal sealed class TextRequestOptions
+{
+    [JsonPropertyName("words")]
+    public bool Words { get; init; }
+
+    [JsonPropertyName("page_range")]
+    [JsonIgnore(Condition = JsonIgnoreCondition.WhenWritingNull)]
+    public string? PageRange { get; init; }
+
+    public static TextRequestOptions? FromTextOptions(TextOptions? options)
+    {
+        if (options is null)
+            return null;
+
+        return new TextRequestOptions
+        {
+            Words = options.IncludeWords,
+            PageRange = options.PageRange
+        };
+    }
+}
+
+/// <summary>
+/// Register more font directories with a running worker. Answered with a
+/// "fonts_result" frame.
+/// </summary>
+internal sealed class AddFontsRequest
+{
+    [JsonPropertyName("type")]
+    public string Type => "add_fonts";
+
+    [JsonPropertyName("id")]
+    public int Id { get; init; }
+
+    [JsonPropertyName("paths")]
+    public IReadOnlyList<string> Paths { get; init; } = Array.Empty<string>();
 }
 
 internal sealed class QuitRequest
@@ -223,8 +571,14 @@ internal sealed class QuitRequest
     DefaultIgnoreCondition = JsonIgnoreCondition.WhenWritingNull)]
 [JsonSerializable(typeof(InitRequest))]
 [JsonSerializable(typeof(ConvertRequest))]
+[JsonSerializable(typeof(CombineRequestPart))]
 [JsonSerializable(typeof(ConvertBufferRequest))]
 [JsonSerializable(typeof(ConvertRequestOptions))]
+[JsonSerializable(typeof(InfoRequest))]
+[JsonSerializable(typeof(RenderRequest))]
+[JsonSerializable(typeof(RenderRequestOptions))]
+[JsonSerializable(typeof(TextRequestOptions))]
+[JsonSerializable(typeof(AddFontsRequest))]
 [JsonSerializable(typeof(QuitRequest))]
 internal partial class ProtocolJsonContext : JsonSerializerContext
 {
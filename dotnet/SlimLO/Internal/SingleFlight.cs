@@ -0,0 +1,124 @@
+using System;
+using System.Collections.Generic;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace SlimLO.Internal;
+
+/// <summary>
+/// Coalesces identical concurrent requests: the first caller for a key runs the
+/// operation, callers arriving while it is in flight wait for the same outcome
+/// (result or exception) instead of running it again. The shared operation is
+/// cancelled only once every caller waiting on it has cancelled. Keys are
+/// forgotten as soon as the operation completes; nothing is cached. Thread-safe.
+/// </summary>
+internal sealed class SingleFlight
+{
+    private readonly Dictionary<string, Flight> _flights = new(StringComparer.Ordinal);
+    private readonly object _sync = new();
+    private long _coalescedCount;
+
+    private sealed class Flight
+    {
+        // Not disposed: without a timer a CancellationTokenSource holds no resources,
+        // and late cancellations must not race a Dispose
+        public CancellationTokenSource Cancellation { get; } = new();
+        public Task? Task { get; set; }
+        public int Waiters { get; set; } = 1;
+        public int Callers { get; set; } = 1; // final once the task completes: the key is gone by then
+        public bool Abandoned { get; set; }   // every caller left; its cancellation is due or done
+    }
+
+    /// <summary>Requests that joined an in-flight operation instead of running their own.</summary>
+    public long CoalescedCount => Interlocked.Read(ref _coalescedCount);
+
+    /// <summary>Operations currently in flight.</summary>
+    public int Count
+    {
+        get { lock (_sync) return _flights.Count; }
+    }
+
+    /// <summary>
+    /// Run <paramref name="operation"/> for <paramref name="key"/>, or join the run
+    /// already in flight for it. The operation gets a token that fires when all
+    /// callers have cancelled; <paramref name="ct"/> only stops this caller's wait.
+    /// When the run had more than one caller and <paramref name="copy"/> is given,
+    /// each caller gets its own copy of the result rather than the shared one.
+    /// </summary>
+    public Task<T> RunAsync<T>(
+        string key, Func<CancellationToken, Task<T>> operation, CancellationToken ct, Func<T, T>? copy = null)
+    {
+        ct.ThrowIfCancellationRequested();
+        Flight flight;
+        lock (_sync)
+        {
+            // An abandoned flight is being cancelled: a new caller starts a fresh one
+            // rather than inherit a cancellation it never asked for
+            if (_flights.TryGetValue(key, out var existing) && existing.Task is Task<T> && !existing.Abandoned)
+            {
+                existing.Waiters++;
+                existing.Callers++;
+                Interlocked.Increment(ref _coalescedCount);
+                flight = existing;
+            }
+            else
+            {
+                flight = new Flight();
+                _flights[key] = flight;
+                flight.Task = RunFlightAsync(key, flight, operation);
+            }
+        }
+        return WaitAsync((Task<T>)flight.Task!, flight, copy, ct);
+    }
+
+    private async Task<T> RunFlightAsync<T>(string key, Flight flight, Func<CancellationToken, Task<T>> operation)
+    {
+        try
+        {
+            // Leave the lock first: the operation may complete synchronously
+            await Task.Yield();
+            return await operation(flight.Cancellation.Token).ConfigureAwait(false);
+        }
+        finally
+        {
+            lock (_sync)
+            {
+                if (_flights.TryGetValue(key, out var current) && current == flight)
+                    _flights.Remove(key);
+            }
+        }
+    }
+
+    private async Task<T> WaitAsync<T>(Task<T> task, Flight flight, Func<T, T>? copy, CancellationToken ct)
+    {
+        if (!ct.CanBeCanceled)
+            return Share(await task.ConfigureAwait(false), flight, copy);
+
+        var cancelled = new TaskCompletionSource<bool>(TaskCreationOptions.RunContinuationsAsynchronously);
+        using (ct.Register(() => cancelled.TrySetResult(true)))
+        {
+            if (await Task.WhenAny(task, cancelled.Task).ConfigureAwait(false) != task)
+            {
+                Leave(flight, task);
+                ct.ThrowIfCancellationRequested();
+            }
+        }
+        return Share(await task.ConfigureAwait(false), flight, copy);
+    }
+
+    private static T Share<T>(T result, Flight flight, Func<T, T>? copy) =>
+        copy != null && flight.Callers > 1 ? copy(result) : result;
+
+    private void Leave(Flight flight, Task task)
+    {
+        bool cancel;
+        lock (_sync)
+        {
+            cancel = --flight.Waiters == 0 && !task.IsCompleted;
+            // Set under the lock, so no caller joins between here and the Cancel below
+            flight.Abandoned = cancel;
+        }
+        if (cancel)
+            flight.Cancellation.Cancel();
+    }
+}
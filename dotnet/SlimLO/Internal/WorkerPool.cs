@@ -1,5 +1,9 @@
 using System;
 using System.Collections.Generic;
+using System.Diagnostics;
+using System.Diagnostics.Metrics;
+using System.IO;
+using System.Text;
 using System.Threading;
 using System.Threading.Tasks;
 
@@ -7,92 +11,509 @@ namespace SlimLO.Internal;
 
 /// <summary>
 /// Thread-safe pool of native worker processes.
-/// Provides round-robin dispatch, automatic crash recovery,
-/// and worker recycling.
+/// Provides deadline-aware, tenant-fair admission, elastic sizing between
+/// MinWorkers and MaxWorkers, automatic crash recovery, worker recycling,
+/// quarantine of documents that keep crashing workers and coalescing of
+/// identical concurrent conversions.
 /// </summary>
 internal sealed class WorkerPool : IAsyncDisposable
 {
     private readonly string _workerPath;
+    private readonly string? _serverSocket;
     private readonly string _resourcePath;
-    private readonly IReadOnlyList<string>? _fontDirectories;
+    private volatile IReadOnlyList<string>? _fontDirectories; // replaced, never mutated
+    private readonly object _fontSync = new();
     private readonly int _maxWorkers;
     private readonly int _maxConversionsPerWorker;
     private readonly TimeSpan _timeout;
-    private readonly SemaphoreSlim _gate;
+    private readonly TimeSpan? _stallTimeout;
+    private readonly int _threadsPerWorker;
+    private readonly CrashQuarantine? _quarantine;
+    private readonly bool _isolateSuspects;
+    private readonly SemaphoreSlim? _isolationLock; // one suspect at a time on the sacrificial worker
+    private readonly AdmissionQueue _gate;
     private readonly WorkerProcess?[] _workers;
     private readonly SemaphoreSlim[] _workerLocks;
+    private readonly int _minWorkers;
+    private readonly TimeSpan? _idleTimeout;
+    private readonly long? _memoryBudget;
+    private readonly Func<long?> _memoryUsage;
+    private readonly long _baselineMemory;
+    private readonly int[] _claimed;   // 1 while a request runs on the slot
+    // Signalled on release while requests wait for a slot; never disposed, as
+    // requests still running when the pool is disposed release their slots into it
+    private readonly SemaphoreSlim _slotFreed = new(0);
+    private int _slotWaiters;
+    private readonly int[] _starting;  // 1 while a spare worker starts in the slot
+    private readonly long[] _lastUsed; // Stopwatch timestamp of the slot's last release
+    private readonly Timer? _reaper;
+    private readonly SingleFlight? _flights;
+    private readonly PoolMetrics _metrics;
+    private readonly IReadOnlyList<int>[]? _cpuSets; // per pool slot when workers are pinned
+    private readonly object _scaleSync = new();
+    private long _lastArrival;
+    private double _arrivalRate;  // moving average, requests per second
+    private double _startupTicks; // moving average of worker start times, 0 = no sample yet
+    private int _reaping;
     private int _nextWorkerIndex;
     private volatile bool _disposed;
     private string? _version;
 
-    public WorkerPool(
-        string workerPath,
-        string resourcePath,
-        IReadOnlyList<string>? fontDirectories,
-        int maxWorkers,
-        int maxConversionsPerWorker,
-        TimeSpan timeout)
-    {
-        _workerPath = workerPath;
-        _resourcePath = resourcePath;
-        _fontDirectories = fontDirectories;
-        _maxWorkers = maxWorkers;
-        _maxConversionsPerWorker = maxConversionsPerWorker;
-        _timeout = timeout;
-        _gate = new SemaphoreSlim(maxWorkers, maxWorkers);
-        _workers = new WorkerProcess?[maxWorkers];
-        _workerLocks = new SemaphoreSlim[maxWorkers];
-        for (int i = 0; i < maxWorkers; i++)
+    /// <summary>Footprint assumed for a worker until running workers have been measured.</summary>
+    internal const long DefaultWorkerMemory = 256L * 1024 * 1024;
+
+    /// <summary>Worker start time assumed until one has been measured.</summary>
+    private static readonly TimeSpan DefaultStartupTime = TimeSpan.FromSeconds(1);
+
+    public WorkerPool(WorkerPoolSettings settings)
+    {
+        _workerPath = settings.WorkerPath;
+        _resourcePath = settings.ResourcePath;
+        _fontDirectories = settings.FontDirectories;
+        _maxWorkers = settings.MaxWorkers;
+        _maxConversionsPerWorker = settings.MaxConversionsPerWorker;
+        _timeout = settings.Timeout;
+        _stallTimeout = settings.StallTimeout;
+        _threadsPerWorker = settings.ThreadsPerWorker;
+        if (settings.QuarantineAfterCrashes > 0 && settings.QuarantineCapacity > 0)
+        {
+            _quarantine = new CrashQuarantine(settings.QuarantineAfterCrashes, settings.QuarantineCapacity);
+            _isolateSuspects = settings.IsolateSuspects;
+            if (_isolateSuspects)
+                _isolationLock = new SemaphoreSlim(1, 1);
+        }
+        _gate = new AdmissionQueue(_maxWorkers, settings.TenantWeights, settings.MaxWorkersPerTenant);
+
+        // With isolation, one extra slot past the pool holds the sacrificial worker
+        int slots = _isolateSuspects ? _maxWorkers + 1 : _maxWorkers;
+        _workers = new WorkerProcess?[slots];
+        _workerLocks = new SemaphoreSlim[slots];
+        for (int i = 0; i < slots; i++)
             _workerLocks[i] = new SemaphoreSlim(1, 1);
+
+        _minWorkers = settings.MinWorkers;
+        _idleTimeout = settings.IdleTimeout;
+        _memoryBudget = settings.MemoryBudget;
+        _memoryUsage = settings.MemoryUsage ?? (() => NodeMemory.Usage());
+        _baselineMemory = _memoryBudget != null ? _memoryUsage() ?? 0 : 0;
+        _claimed = new int[_maxWorkers];
+        _starting = new int[_maxWorkers];
+        _lastUsed = new long[_maxWorkers];
+        if (_idleTimeout is { } idle)
+        {
+            long period = Math.Min(Math.Max((long)idle.TotalMilliseconds / 2, 100), 30_000);
+            _reaper = new Timer(_ => ReapIdleWorkers(), null, period, period);
+        }
+        if (settings.CoalesceDuplicates)
+            _flights = new SingleFlight();
+        _metrics = new PoolMetrics(() => _gate.QueueLength, WorkerMemory);
+        _serverSocket = settings.ServerSocket;
+        // A server places its own workers
+        if (settings.Placement == WorkerPlacement.Pinned && _serverSocket == null)
+            _cpuSets = CpuTopology.Partition(CpuTopology.Nodes(), _maxWorkers);
     }
 
     public string? Version => _version;
 
+    /// <summary>Maximum silence between worker progress frames, or null if disabled.</summary>
+    public TimeSpan? StallTimeout => _stallTimeout;
+
+    /// <summary>Documents that crashed a worker, or null if quarantine is disabled.</summary>
+    internal CrashQuarantine? Quarantine => _quarantine;
+
+    /// <summary>Requests waiting for a worker.</summary>
+    public int QueueLength => _gate.QueueLength;
+
+    /// <summary>Requests rejected because they could not finish before their deadline.</summary>
+    public long ShedCount => _gate.ShedCount;
+
+    /// <summary>Whether identical concurrent conversions share one run.</summary>
+    public bool CoalescesDuplicates => _flights != null;
+
+    /// <summary>Requests that shared an identical in-flight conversion instead of running their own.</summary>
+    public long CoalescedCount => _flights?.CoalescedCount ?? 0;
+
+    /// <summary>Pool worker processes running or starting (the isolation worker excluded).</summary>
+    public int WorkerCount
+    {
+        get
+        {
+            int count = 0;
+            for (int i = 0; i < _maxWorkers; i++)
+            {
+                if (IsLive(i) || Volatile.Read(ref _starting[i]) != 0)
+                    count++;
+            }
+            return count;
+        }
+    }
+
+    /// <summary>Resident memory of each running worker, tagged with its slot.</summary>
+    private IEnumerable<Measurement<long>> WorkerMemory()
+    {
+        for (int i = 0; i < _workers.Length; i++)
+        {
+            if (_workers[i] is { } w && w.ResidentBytes is { } rss)
+                yield return new Measurement<long>(rss, new KeyValuePair<string, object?>("worker", i));
+        }
+    }
+
     /// <summary>
-    /// Pre-start all worker processes (for WarmUp mode).
+    /// Pre-start worker processes (for WarmUp mode): MinWorkers of them,
+    /// or all MaxWorkers when no minimum is set.
     /// </summary>
     public async Task WarmUpAsync(CancellationToken ct)
     {
-        var tasks = new Task[_maxWorkers];
-        for (int i = 0; i < _maxWorkers; i++)
+        int count = _minWorkers > 0 ? _minWorkers : _maxWorkers;
+        var tasks = new Task[count];
+        for (int i = 0; i < count; i++)
         {
             int index = i;
             tasks[i] = EnsureWorkerAsync(index, ct);
         }
         await Task.WhenAll(tasks).ConfigureAwait(false);
+        long now = Stopwatch.GetTimestamp();
+        for (int i = 0; i < count; i++)
+            Volatile.Write(ref _lastUsed[i], now);
     }
 
     /// <summary>
     /// Execute a conversion on the next available worker.
     /// Thread-safe: multiple threads can call this concurrently.
+    /// With coalescing on, a request identical to one in flight waits for that
+    /// conversion's result instead of running again (without progress reports).
     /// </summary>
-    public async Task<ConversionResult> ExecuteAsync(
+    /// <param name="deadline">Admission deadline from <see cref="AdmissionQueue.DeadlineAfter"/>.</param>
+    /// <param name="tenant">Fair-queuing key, null = the default tenant.</param>
+    public Task<ConversionResult> ExecuteAsync(
         ConvertRequest request,
+        IProgress<ConversionProgress>? progress,
+        long deadline,
+        string? tenant,
         CancellationToken ct)
+    {
+        Task<ConversionResult> Run(CancellationToken token) => RunOnWorkerAsync(
+            (worker, t) => worker.ConvertAsync(request, _timeout, _stallTimeout, progress, t),
+            (message, code) => ConversionResult.Fail(message, code, null),
+            DocumentKey(request.Input, null),
+            deadline,
+            tenant,
+            token);
+
+        return FlightKey(request) is { } key ? _flights!.RunAsync(key, Run, ct) : Run(ct);
+    }
+
+    /// <summary>
+    /// Execute a buffer conversion on the next available worker.
+    /// Thread-safe: multiple threads can call this concurrently.
+    /// With coalescing on, callers converting the same bytes with the same options
+    /// concurrently share one conversion, each receiving its own copy of the result.
+    /// </summary>
+    public Task<ConversionResult<byte[]>> ExecuteBufferAsync(
+        ConvertBufferRequest request,
+        ReadOnlyMemory<byte> documentData,
+        IProgress<ConversionProgress>? progress,
+        long deadline,
+        string? tenant,
+        CancellationToken ct)
+    {
+        // Hash the document once for both quarantine and coalescing
+        string? contentKey = _quarantine != null || _flights != null
+            ? CrashQuarantine.KeyOf(documentData.Span)
+            : null;
+
+        // A coalesced run outlives the caller that started it when that caller
+        // cancels, and the caller may then reuse its buffer: the run sends its own copy
+        if (_flights != null)
+            documentData = documentData.ToArray();
+
+        Task<ConversionResult<byte[]>> Run(CancellationToken token) => RunOnWorkerAsync(
+            (worker, t) => worker.ConvertBufferAsync(
+                request, documentData, _timeout, _stallTimeout, progress, t),
+            (message, code) => ConversionResult<byte[]>.Fail(message, code, null),
+            _quarantine != null ? contentKey : null,
+            deadline,
+            tenant,
+            token);
+
+        if (_flights == null)
+            return Run(ct);
+        var normalized = new ConvertBufferRequest
+        {
+            Format = request.Format,
+            DataSize = request.DataSize,
+            Options = request.Options,
+            Render = request.Render,
+            Text = request.Text,
+        };
+        return _flights.RunAsync("buffer:" + contentKey + ":" + RequestKey(normalized), Run, ct, CopyOf);
+    }
+
+    /// <summary>A coalesced caller's own copy of the shared result, so no caller sees another's writes.</summary>
+    private static ConversionResult<byte[]> CopyOf(ConversionResult<byte[]> shared)
+    {
+        if (!shared.Success)
+            return shared;
+        var images = new PageImage[shared.PageImages.Count];
+        for (int i = 0; i < images.Length; i++)
+        {
+            var image = shared.PageImages[i];
+            images[i] = new PageImage(
+                image.PageNumber, image.Width, image.Height, image.Format, (byte[])image.Data.Clone());
+        }
+        return ConversionResult<byte[]>.Ok(
+            (byte[])shared.Data!.Clone(), shared.Diagnostics, images, shared.PageText);
+    }
+
+    /// <summary>
+    /// Execute a buffer conversion whose PDF frame is consumed by <paramref name="readOutput"/>
+    /// (into a pooled buffer or the caller's writer). Never coalesced: the output
+    /// belongs to one caller.
+    /// </summary>
+    public Task<ConversionResult<T>> ExecuteBufferAsync<T>(
+        ConvertBufferRequest request,
+        ReadOnlyMemory<byte> documentData,
+        IProgress<ConversionProgress>? progress,
+        Func<Stream, CancellationToken, Task<T?>> readOutput,
+        long deadline,
+        string? tenant,
+        CancellationToken ct)
+        where T : class =>
+        RunOnWorkerAsync(
+            (worker, token) => worker.ConvertBufferAsync(
+                request, documentData, _timeout, _stallTimeout, progress, readOutput, token),
+            (message, code) => ConversionResult<T>.Fail(message, code, null),
+            DocumentKey(null, documentData),
+            deadline,
+            tenant,
+            ct);
+
+    /// <summary>
+    /// Execute a chunked conversion from <paramref name="input"/> to <paramref name="output"/>.
+    /// Neither quarantined nor coalesced: the document is only known once it has been sent.
+    /// </summary>
+    public Task<ConversionResult> ExecuteStreamAsync(
+        ConvertBufferRequest request,
+        Stream input,
+        Stream output,
+        IProgress<ConversionProgress>? progress,
+        long deadline,
+        string? tenant,
+        CancellationToken ct) =>
+        RunOnWorkerAsync(
+            (worker, token) => worker.ConvertStreamAsync(
+                request, input, output, _timeout, _stallTimeout, progress, token),
+            (message, code) => ConversionResult.Fail(message, code, null),
+            null,
+            deadline,
+            tenant,
+            ct);
+
+    /// <summary>
+    /// Query document metadata on the next available worker.
+    /// No progress frames are sent, so the stall timeout does not apply.
+    /// </summary>
+    public Task<ConversionResult<DocumentInfo>> ExecuteInfoAsync(
+        InfoRequest request,
+        ReadOnlyMemory<byte>? documentData,
+        CancellationToken ct) =>
+        RunOnWorkerAsync(
+            (worker, token) => worker.GetInfoAsync(request, documentData, _timeout, token),
+            (message, code) => ConversionResult<DocumentInfo>.Fail(message, code, null),
+            DocumentKey(request.Input, documentData),
+            AdmissionQueue.NoDeadline,
+            null,
+            ct);
+
+    /// <summary>
+    /// Render pages to images on the next available worker.
+    /// No progress frames are sent, so the stall timeout does not apply.
+    /// </summary>
+    public Task<ConversionResult> ExecuteRenderAsync(
+        RenderRequest request,
+        ReadOnlyMemory<byte>? documentData,
+        CancellationToken ct) =>
+        RunOnWorkerAsync(
+            (worker, token) => worker.RenderAsync(request, documentData, _timeout, token),
+            (message, code) => ConversionResult.Fail(message, code, null),
+            DocumentKey(request.Input, documentData),
+            AdmissionQueue.NoDeadline,
+            null,
+            ct);
+
+    /// <summary>
+    /// Quarantine key of the request's document, or null when quarantine is disabled.
+    /// </summary>
+    private string? DocumentKey(string? inputPath, ReadOnlyMemory<byte>? documentData)
+    {
+        if (_quarantine == null)
+            return null;
+        if (documentData is { } data)
+            return CrashQuarantine.KeyOf(data.Span);
+        return string.IsNullOrEmpty(inputPath) ? null : CrashQuarantine.KeyOfFile(inputPath!);
+    }
+
+    /// <summary>
+    /// Single-flight key of a file conversion: the request without its id and
+    /// progress flag, plus the full path, size and modification time of every
+    /// input, so a rewritten input starts a new conversion. The output path is
+    /// part of the key: callers writing elsewhere convert separately rather than
+    /// copy a file the first caller may already be moving. Null when coalescing
+    /// is off or an input cannot be read.
+    /// </summary>
+    private string? FlightKey(ConvertRequest request)
+    {
+        if (_flights == null)
+            return null;
+        var stamps = new StringBuilder("file:");
+        if (request.Input != null && !AppendStamp(stamps, request.Input))
+            return null;
+        if (request.Inputs != null)
+        {
+            foreach (var part in request.Inputs)
+            {
+                if (!AppendStamp(stamps, part.Input))
+                    return null;
+            }
+        }
+        var normalized = new ConvertRequest
+        {
+            Input = request.Input,
+            Inputs = request.Inputs,
+            Output = Path.GetFullPath(request.Output),
+            Format = request.Format,
+            Options = request.Options,
+            Render = request.Render,
+            Text = request.Text,
+        };
+        return stamps.Append(RequestKey(normalized)).ToString();
+    }
+
+    private static bool AppendStamp(StringBuilder key, string path)
+    {
+        try
+        {
+            var file = new FileInfo(path);
+            if (!file.Exists)
+                return false;
+            key.Append(file.FullName).Append('|')
+                .Append(file.Length).Append('|')
+                .Append(file.LastWriteTimeUtc.Ticks).Append(':');
+            return true;
+        }
+        catch (Exception e) when (e is IOException or UnauthorizedAccessException or ArgumentException or NotSupportedException)
+        {
+            return false;
+        }
+    }
+
+    private static string RequestKey<T>(T request) => Encoding.UTF8.GetString(Protocol.Serialize(request));
+
+    /// <summary>
+    /// Run one request on a worker: wait for a slot, pick a worker round-robin,
+    /// (re)start it if needed, then recycle or replace it afterwards.
+    /// Quarantined documents fail without reaching a worker; documents that
+    /// crashed a worker before run on the sacrificial worker when isolation is on.
+    /// Requests that cannot finish before their deadline are shed.
+    /// </summary>
+    private async Task<TResult> RunOnWorkerAsync<TResult>(
+        Func<WorkerProcess, CancellationToken, Task<TResult>> operation,
+        Func<string, SlimLOErrorCode, TResult> fail,
+        string? documentKey,
+        long deadline,
+        string? tenant,
+        CancellationToken ct)
+        where TResult : ConversionResult
     {
         ThrowHelpers.ThrowIfDisposed(_disposed, this);
 
-        // Wait for a worker slot
-        await _gate.WaitAsync(ct).ConfigureAwait(false);
+        int crashes = documentKey != null ? _quarantine!.CrashCount(documentKey) : 0;
+        if (documentKey != null && crashes >= _quarantine!.Threshold)
+        {
+            return fail(
+                $"Document quarantined: it crashed a worker process {crashes} time(s) " +
+                "and is no longer dispatched to workers.",
+                SlimLOErrorCode.Quarantined);
+        }
+
+        // Suspects skip the pool gate and take the sacrificial worker one at a time,
+        // from its start through its replacement, so none runs on a worker another crashed
+        bool isolated = _isolateSuspects && crashes > 0;
+        if (isolated)
+            await _isolationLock!.WaitAsync(ct).ConfigureAwait(false);
+        else if (!await WaitForAdmissionAsync(tenant, deadline, ct).ConfigureAwait(false))
+        {
+            var estimate = _gate.EstimatedServiceTime;
+            return fail(
+                "Request shed: it cannot finish before its deadline" +
+                (estimate is { } e ? $" (recent conversions take about {e.TotalMilliseconds:F0} ms)" : "") +
+                ".",
+                SlimLOErrorCode.DeadlineExceeded);
+        }
+        int index = _maxWorkers;
+        bool claimed = false;
         try
         {
-            // Pick a worker via round-robin
-            int index = (int)((uint)Interlocked.Increment(ref _nextWorkerIndex) % (uint)_maxWorkers);
+            // An identical suspect may have crashed the worker while this one waited
+            if (isolated && _quarantine!.CrashCount(documentKey!) >= _quarantine.Threshold)
+            {
+                return fail(
+                    "Document quarantined: it crashed a worker process while this request waited " +
+                    "and is no longer dispatched to workers.",
+                    SlimLOErrorCode.Quarantined);
+            }
+
+            if (!isolated)
+            {
+                index = await ClaimWorkerAsync(ct).ConfigureAwait(false);
+                claimed = true;
+                ScaleAhead();
+            }
 
             // Ensure worker is alive (start or restart if needed)
             await EnsureWorkerAsync(index, ct).ConfigureAwait(false);
 
             var worker = _workers[index];
             if (worker == null)
-                return ConversionResult.Fail("Failed to start worker", SlimLOErrorCode.InitFailed, null);
+                return fail("Failed to start worker", SlimLOErrorCode.InitFailed);
+
+            // Font directories added after this worker started
+            ConversionDiagnostic? fontWarning = null;
+            var fonts = _fontDirectories;
+            if (fonts != null && !ReferenceEquals(worker.RegisteredFonts, fonts))
+            {
+                var added = await worker.AddFontsAsync(fonts, _timeout, ct).ConfigureAwait(false);
+                if (!added.Success)
+                {
+                    // A worker that died meanwhile is replaced; its successor gets them at init
+                    bool replaced = !worker.IsAlive;
+                    if (replaced)
+                    {
+                        await EnsureWorkerAsync(index, ct).ConfigureAwait(false);
+                        worker = _workers[index];
+                        if (worker == null)
+                            return fail("Failed to start worker", SlimLOErrorCode.InitFailed);
+                    }
+                    fontWarning = FontCatchUpWarning(added, replaced);
+                }
+            }
 
-            // Execute conversion
-            var result = await worker.ConvertAsync(request, _timeout, ct).ConfigureAwait(false);
+            long started = Stopwatch.GetTimestamp();
+            var result = await operation(worker, ct).ConfigureAwait(false);
+            if (fontWarning != null)
+                result.AddDiagnostic(fontWarning);
+            if (!isolated)
+                _gate.RecordServiceTime(Stopwatch.GetTimestamp() - started);
+            // Only the request whose own exchange lost the worker is to blame
+            if (documentKey != null && result.WorkerLost)
+                _quarantine!.RecordCrash(documentKey);
+            if (result.WorkerLost && !worker.TimedOut)
+                _metrics.RecordCrash();
 
             // Check if worker needs recycling
             if (_maxConversionsPerWorker > 0 && worker.ConversionCount >= _maxConversionsPerWorker)
             {
-                await RecycleWorkerAsync(index).ConfigureAwait(false);
+                await RecycleWorkerAsync(index, "max_conversions").ConfigureAwait(false);
             }
 
             // If worker crashed during conversion, mark for replacement
@@ -117,64 +538,277 @@ internal sealed class WorkerPool : IAsyncDisposable
         }
         finally
         {
-            _gate.Release();
+            if (isolated)
+            {
+                _isolationLock!.Release();
+            }
+            else
+            {
+                // Not claimed when the wait for a slot was cancelled: index is no slot
+                if (claimed)
+                {
+                    Volatile.Write(ref _lastUsed[index], Stopwatch.GetTimestamp());
+                    ReleaseSlot(index);
+                }
+                _gate.Release(tenant);
+            }
         }
     }
 
     /// <summary>
-    /// Execute a buffer conversion on the next available worker.
-    /// Thread-safe: multiple threads can call this concurrently.
+    /// Add a font directory to the pool: workers started from now on get it at init,
+    /// and every live worker registers it without a restart, after the request it
+    /// is running (if any). Workers that miss the broadcast catch up before their
+    /// next request. Returns the first failure reported by a worker.
     /// </summary>
-    public async Task<ConversionResult<byte[]>> ExecuteBufferAsync(
-        ConvertBufferRequest request,
-        ReadOnlyMemory<byte> documentData,
-        CancellationToken ct)
+    public async Task<ConversionResult> AddFontDirectoryAsync(string path, CancellationToken ct)
     {
         ThrowHelpers.ThrowIfDisposed(_disposed, this);
 
-        await _gate.WaitAsync(ct).ConfigureAwait(false);
-        try
+        IReadOnlyList<string> fonts;
+        lock (_fontSync)
         {
-            int index = (int)((uint)Interlocked.Increment(ref _nextWorkerIndex) % (uint)_maxWorkers);
+            var current = _fontDirectories ?? Array.Empty<string>();
+            if (WorkerProcess.PendingFonts(current, new[] { path }).Count > 0)
+            {
+                var grown = new string[current.Count + 1];
+                for (int i = 0; i < current.Count; i++)
+                    grown[i] = current[i];
+                grown[current.Count] = path;
+                _fontDirectories = grown;
+            }
+            fonts = _fontDirectories!;
+        }
 
-            await EnsureWorkerAsync(index, ct).ConfigureAwait(false);
+        var tasks = new List<Task<ConversionResult>>();
+        foreach (var worker in _workers)
+        {
+            if (worker != null && worker.IsAlive && !ReferenceEquals(worker.RegisteredFonts, fonts))
+                tasks.Add(worker.AddFontsAsync(fonts, _timeout, ct));
+        }
 
-            var worker = _workers[index];
-            if (worker == null)
-                return ConversionResult<byte[]>.Fail("Failed to start worker", SlimLOErrorCode.InitFailed, null);
+        ConversionResult result = ConversionResult.Ok(null);
+        foreach (var task in tasks)
+        {
+            var r = await task.ConfigureAwait(false);
+            if (!r.Success && result.Success)
+                result = r;
+        }
+        return result;
+    }
 
-            var result = await worker.ConvertBufferAsync(request, documentData, _timeout, ct).ConfigureAwait(false);
+    private static ConversionDiagnostic FontCatchUpWarning(ConversionResult failure, bool replaced) =>
+        new(DiagnosticSeverity.Warning, DiagnosticCategory.Font,
+            replaced
+                ? $"The worker was lost registering added font directories and was replaced: {failure.ErrorMessage}"
+                : $"Added font directories could not be registered before this request: {failure.ErrorMessage}");
 
-            if (_maxConversionsPerWorker > 0 && worker.ConversionCount >= _maxConversionsPerWorker)
+    private async Task<bool> WaitForAdmissionAsync(string? tenant, long deadline, CancellationToken ct)
+    {
+        long queued = Stopwatch.GetTimestamp();
+        bool admitted = await _gate.WaitAsync(tenant, deadline, ct).ConfigureAwait(false);
+        _metrics.RecordQueueWait(Stopwatch.GetTimestamp() - queued);
+        return admitted;
+    }
+
+    /// <summary>
+    /// Claim a pool slot for an admitted request, waiting for one to be released
+    /// if none can be claimed. Admission never exceeds the slot count, so a slot is
+    /// normally free; when the memory budget stops the pool from growing, the
+    /// request waits for a running worker rather than sharing one, since a slot's
+    /// worker is recycled, replaced or reaped by the request or reaper holding it.
+    /// </summary>
+    private async Task<int> ClaimWorkerAsync(CancellationToken ct)
+    {
+        int index = TryClaimWorker();
+        if (index >= 0)
+            return index;
+
+        Interlocked.Increment(ref _slotWaiters);
+        try
+        {
+            // A release that lands between the attempt and the wait leaves a count behind
+            while ((index = TryClaimWorker()) < 0)
+                await _slotFreed.WaitAsync(ct).ConfigureAwait(false);
+            return index;
+        }
+        finally
+        {
+            Interlocked.Decrement(ref _slotWaiters);
+        }
+    }
+
+    /// <summary>
+    /// Claim an idle running worker, else one a spare start is warming, else an
+    /// empty slot if the memory budget allows another process; -1 if none.
+    /// </summary>
+    private int TryClaimWorker()
+    {
+        int start = (int)((uint)Interlocked.Increment(ref _nextWorkerIndex) % (uint)_maxWorkers);
+        for (int pass = 0; pass < 3; pass++)
+        {
+            if (pass == 2 && !CanSpawn())
+                break;
+            for (int n = 0; n < _maxWorkers; n++)
             {
-                await RecycleWorkerAsync(index).ConfigureAwait(false);
+                int i = (start + n) % _maxWorkers;
+                bool candidate = pass switch
+                {
+                    0 => IsLive(i),
+                    1 => Volatile.Read(ref _starting[i]) != 0,
+                    _ => !IsLive(i),
+                };
+                if (candidate && Interlocked.CompareExchange(ref _claimed[i], 1, 0) == 0)
+                    return i;
             }
+        }
+        return -1;
+    }
 
-            if (!worker.IsAlive)
+    private void ReleaseSlot(int index)
+    {
+        // Full fence: a waiter counted after this reads the slot as free
+        Interlocked.Exchange(ref _claimed[index], 0);
+        if (Volatile.Read(ref _slotWaiters) > 0)
+            _slotFreed.Release();
+    }
+
+    /// <summary>
+    /// Start spare workers ahead of demand, called on each admission: keep as many
+    /// idle workers as requests are expected to be admitted while a new worker
+    /// starts (admission rate times start time), so a burst does not pay cold
+    /// starts one by one.
+    /// </summary>
+    private void ScaleAhead()
+    {
+        double spare;
+        lock (_scaleSync)
+        {
+            long now = Stopwatch.GetTimestamp();
+            if (_lastArrival != 0)
             {
-                await _workerLocks[index].WaitAsync(ct).ConfigureAwait(false);
-                try
-                {
-                    if (_workers[index] == worker)
-                    {
-                        await worker.DisposeAsync().ConfigureAwait(false);
-                        _workers[index] = null;
-                    }
-                }
-                finally
-                {
-                    _workerLocks[index].Release();
-                }
+                double gap = Math.Max((double)(now - _lastArrival) / Stopwatch.Frequency, 1e-3);
+                _arrivalRate = _arrivalRate > 0 ? 0.8 * _arrivalRate + 0.2 / gap : 1 / gap;
             }
+            _lastArrival = now;
+            double startup = _startupTicks > 0
+                ? _startupTicks / Stopwatch.Frequency
+                : DefaultStartupTime.TotalSeconds;
+            spare = _arrivalRate * startup;
+        }
 
-            return result;
+        int idle = 0;
+        for (int i = 0; i < _maxWorkers; i++)
+        {
+            if ((IsLive(i) || Volatile.Read(ref _starting[i]) != 0) && Volatile.Read(ref _claimed[i]) == 0)
+                idle++;
+        }
+
+        int wanted = (int)Math.Min(spare, _maxWorkers) - idle;
+        for (int i = 0; i < _maxWorkers && wanted > 0; i++)
+        {
+            if (IsLive(i) || Volatile.Read(ref _claimed[i]) != 0 || !CanSpawn())
+                continue;
+            if (Interlocked.CompareExchange(ref _starting[i], 1, 0) != 0)
+                continue;
+            wanted--;
+            _ = StartSpareAsync(i);
+        }
+    }
+
+    private async Task StartSpareAsync(int index)
+    {
+        try
+        {
+            await EnsureWorkerAsync(index, CancellationToken.None).ConfigureAwait(false);
+            Volatile.Write(ref _lastUsed[index], Stopwatch.GetTimestamp());
+        }
+        catch (Exception)
+        {
+            // The request that picks this slot retries the start and reports the error
         }
         finally
         {
-            _gate.Release();
+            Volatile.Write(ref _starting[index], 0);
+        }
+    }
+
+    /// <summary>
+    /// Stop workers idle for longer than the idle timeout, down to MinWorkers.
+    /// A slot is claimed before its worker is stopped, so a request can not pick it meanwhile.
+    /// </summary>
+    private void ReapIdleWorkers()
+    {
+        if (_disposed || Interlocked.Exchange(ref _reaping, 1) != 0)
+            return;
+        _ = ReapAsync();
+
+        async Task ReapAsync()
+        {
+            try
+            {
+                long now = Stopwatch.GetTimestamp();
+                long idleTicks = (long)(_idleTimeout!.Value.TotalSeconds * Stopwatch.Frequency);
+                int live = WorkerCount;
+                for (int i = 0; i < _maxWorkers && live > _minWorkers && !_disposed; i++)
+                {
+                    if (!IsLive(i) || now - Volatile.Read(ref _lastUsed[i]) < idleTicks)
+                        continue;
+                    if (Interlocked.CompareExchange(ref _claimed[i], 1, 0) != 0)
+                        continue;
+                    try
+                    {
+                        if (Volatile.Read(ref _starting[i]) == 0)
+                        {
+                            await RecycleWorkerAsync(i, "idle").ConfigureAwait(false);
+                            live--;
+                        }
+                    }
+                    finally
+                    {
+                        ReleaseSlot(i);
+                    }
+                }
+            }
+            catch (ObjectDisposedException)
+            {
+            }
+            finally
+            {
+                Volatile.Write(ref _reaping, 0);
+            }
         }
     }
 
+    /// <summary>Whether one more worker process fits: always below MinWorkers (and for the first), else per the memory budget.</summary>
+    private bool CanSpawn()
+    {
+        int live = WorkerCount;
+        if (live < Math.Max(_minWorkers, 1))
+            return true;
+        return MemoryAllows(_memoryBudget, _memoryUsage(), _baselineMemory, live);
+    }
+
+    /// <summary>
+    /// Whether a further worker fits the memory budget. A worker's footprint is
+    /// estimated as the group's growth since the pool started, divided by the running
+    /// workers; without usage figures every worker counts as <see cref="DefaultWorkerMemory"/>.
+    /// </summary>
+    internal static bool MemoryAllows(long? budget, long? usage, long baseline, int liveWorkers)
+    {
+        if (budget is not { } limit)
+            return true;
+        long perWorker = usage is { } u && liveWorkers > 0
+            ? Math.Max((u - baseline) / liveWorkers, 0)
+            : DefaultWorkerMemory;
+        if (perWorker == 0)
+            perWorker = DefaultWorkerMemory;
+        long current = usage ?? liveWorkers * perWorker;
+        return current + perWorker <= limit;
+    }
+
+    private bool IsLive(int index) => _workers[index] is { } w && w.IsAlive;
+
     private async Task EnsureWorkerAsync(int index, CancellationToken ct)
     {
         var w = _workers[index];
@@ -197,10 +831,19 @@ internal sealed class WorkerPool : IAsyncDisposable
             }
 
             // Start new worker
-            var worker = new WorkerProcess(_workerPath, _resourcePath, _fontDirectories);
+            // The isolation slot stays unpinned; a pinned worker sizes its pools to its CPUs
+            var cpus = _cpuSets != null && index < _maxWorkers ? _cpuSets[index] : null;
+            int threads = _threadsPerWorker > 0 ? _threadsPerWorker : cpus?.Count ?? 0;
+            var worker = new WorkerProcess(
+                _workerPath, _resourcePath, _fontDirectories, threads, _metrics, cpus, _serverSocket);
+            long started = Stopwatch.GetTimestamp();
             await worker.StartAsync(ct).ConfigureAwait(false);
+            long elapsed = Stopwatch.GetTimestamp() - started;
+            lock (_scaleSync)
+                _startupTicks = _startupTicks > 0 ? 0.8 * _startupTicks + 0.2 * elapsed : elapsed;
             _workers[index] = worker;
             _version ??= worker.Version;
+            _metrics.RecordWorkerStart();
         }
         finally
         {
@@ -208,7 +851,7 @@ internal sealed class WorkerPool : IAsyncDisposable
         }
     }
 
-    private async Task RecycleWorkerAsync(int index)
+    private async Task RecycleWorkerAsync(int index, string reason)
     {
         await _workerLocks[index].WaitAsync().ConfigureAwait(false);
         try
@@ -217,6 +860,7 @@ internal sealed class WorkerPool : IAsyncDisposable
             {
                 await _workers[index]!.DisposeAsync().ConfigureAwait(false);
                 _workers[index] = null;
+                _metrics.RecordRecycle(reason);
             }
         }
         finally
@@ -229,10 +873,11 @@ internal sealed class WorkerPool : IAsyncDisposable
     {
         if (_disposed) return;
         _disposed = true;
+        _reaper?.Dispose();
 
         // Dispose all workers in parallel
         var tasks = new List<ValueTask>();
-        for (int i = 0; i < _maxWorkers; i++)
+        for (int i = 0; i < _workers.Length; i++)
         {
             if (_workers[i] != null)
                 tasks.Add(_workers[i]!.DisposeAsync());
@@ -242,7 +887,9 @@ internal sealed class WorkerPool : IAsyncDisposable
             await task.ConfigureAwait(false);
 
         _gate.Dispose();
+        _metrics.Dispose();
         foreach (var l in _workerLocks)
             l.Dispose();
+        _isolationLock?.Dispose();
     }
 }
@@ -0,0 +1,67 @@
+using System;
+using System.Collections.Generic;
+
+namespace SlimLO.Internal;
+
+/// <summary>
+/// Everything a <see cref="WorkerPool"/> is built from: the resolved worker and
+/// resource paths plus the pool-related <see cref="PdfConverterOptions"/>.
+/// Defaults leave every optional feature off.
+/// </summary>
+internal sealed class WorkerPoolSettings
+{
+    public string WorkerPath { get; init; } = "";
+    public string ResourcePath { get; init; } = "";
+    public IReadOnlyList<string>? FontDirectories { get; init; }
+    public int MaxWorkers { get; init; } = 1;
+    public int MaxConversionsPerWorker { get; init; }
+    public TimeSpan Timeout { get; init; } = TimeSpan.FromMinutes(5);
+    public TimeSpan? StallTimeout { get; init; }
+    public int ThreadsPerWorker { get; init; }
+    public int QuarantineAfterCrashes { get; init; }
+    public int QuarantineCapacity { get; init; }
+    public bool IsolateSuspects { get; init; }
+    public IReadOnlyDictionary<string, int>? TenantWeights { get; init; }
+    public int MaxWorkersPerTenant { get; init; }
+    public int MinWorkers { get; init; }
+    public TimeSpan? IdleTimeout { get; init; }
+
+    /// <summary>Bytes the pool may fill before it stops growing; null = no budget.</summary>
+    public long? MemoryBudget { get; init; }
+
+    /// <summary>Memory usage of the pool's control group; null = <see cref="NodeMemory.Usage"/>.</summary>
+    public Func<long?>? MemoryUsage { get; init; }
+
+    public bool CoalesceDuplicates { get; init; }
+    public WorkerPlacement Placement { get; init; }
+    public string? ServerSocket { get; init; }
+
+    /// <summary>
+    /// Settings for a converter created with <paramref name="options"/>. Without a
+    /// memory budget of its own the pool takes the cgroup limit; connected to a
+    /// server it has none, as the server's workers are not in this control group.
+    /// </summary>
+    public static WorkerPoolSettings From(PdfConverterOptions options, string workerPath, string resourcePath) =>
+        new()
+        {
+            WorkerPath = workerPath,
+            ResourcePath = resourcePath,
+            FontDirectories = options.FontDirectories,
+            MaxWorkers = options.MaxWorkers,
+            MaxConversionsPerWorker = options.MaxConversionsPerWorker,
+            Timeout = options.ConversionTimeout,
+            StallTimeout = options.StallTimeout,
+            ThreadsPerWorker = options.ThreadsPerWorker,
+            QuarantineAfterCrashes = options.QuarantineAfterCrashes,
+            QuarantineCapacity = options.QuarantineCapacity,
+            IsolateSuspects = options.IsolateSuspectDocuments,
+            TenantWeights = options.TenantWeights,
+            MaxWorkersPerTenant = options.MaxWorkersPerTenant,
+            MinWorkers = options.MinWorkers,
+            IdleTimeout = options.IdleTimeout,
+            MemoryBudget = options.ServerSocket == null ? options.MemoryBudget ?? NodeMemory.Limit() : null,
+            CoalesceDuplicates = options.CoalesceDuplicates,
+            Placement = options.WorkerPlacement,
+            ServerSocket = options.ServerSocket,
+        };
+}
@@ -2,6 +2,7 @@ using System;
 using System.Collections.Generic;
 using System.Diagnostics;
 using System.IO;
+using System.Net.Sockets;
 using System.Runtime.InteropServices;
 using System.Text;
 using System.Text.Json;
@@ -13,38 +14,162 @@ namespace SlimLO.Internal;
 /// <summary>
 /// Manages the lifecycle of a single native slimlo_worker subprocess.
 /// Handles startup, message exchange, stderr capture, and crash detection.
+/// Given a server socket, it is instead one connection to a slimlo_server,
+/// which speaks the same protocol from its shared pool of workers.
 /// </summary>
 internal sealed class WorkerProcess : IAsyncDisposable
 {
     private readonly string _workerPath;
     private readonly string _resourcePath;
     private readonly IReadOnlyList<string>? _fontDirectories;
+    private IReadOnlyList<string> _registeredFonts; // font directories the worker has
+    private readonly int _threads;
+    private readonly IReadOnlyList<int>? _cpus;
+    private readonly string? _serverSocket;
     private Process? _process;
+    private Socket? _socket;
+    private Stream? _stdin;
+    private Stream? _stdout;
     private readonly SemaphoreSlim _lock = new(1, 1);
     private readonly StringBuilder _stderrBuffer = new();
     private volatile bool _disposed;
     private volatile bool _initialized;
     private int _conversionCount;
     private string? _version;
+    private readonly PoolMetrics? _metrics;
+    private long _residentBytes;
+    private volatile bool _timedOut;
 
-    public WorkerProcess(string workerPath, string resourcePath, IReadOnlyList<string>? fontDirectories)
+    public WorkerProcess(string workerPath, string resourcePath, IReadOnlyList<string>? fontDirectories,
+        int threads = 0, PoolMetrics? metrics = null, IReadOnlyList<int>? cpus = null,
+        string? serverSocket = null)
     {
         _workerPath = workerPath;
         _resourcePath = resourcePath;
         _fontDirectories = fontDirectories;
+        _registeredFonts = fontDirectories ?? Array.Empty<string>();
+        _threads = threads;
+        _metrics = metrics;
+        _cpus = cpus;
+        _serverSocket = serverSocket;
     }
 
     public int ConversionCount => _conversionCount;
-    public bool IsAlive => _process != null && !_process.HasExited;
+    // An exchange that lost the worker clears _initialized before the process is
+    // reaped, and a disposed worker's Process object no longer answers HasExited
+    public bool IsAlive => !_disposed && _initialized && (_socket != null || _process != null && !_process.HasExited);
     public string? Version => _version;
 
+    /// <summary>Font directories the worker has registered: at init, then through <see cref="AddFontsAsync"/>.</summary>
+    public IReadOnlyList<string> RegisteredFonts => _registeredFonts;
+
+    /// <summary>Whether the worker was killed because a request timed out or stalled.</summary>
+    public bool TimedOut => _timedOut;
+
+    /// <summary>
+    /// Resident memory of the worker: as reported with its last conversion where the
+    /// worker can measure it, else the process working set. Null if not running.
+    /// </summary>
+    public long? ResidentBytes
+    {
+        get
+        {
+            long reported = Interlocked.Read(ref _residentBytes);
+            if (reported > 0)
+                return reported;
+            try
+            {
+                var process = _process;
+                if (process == null || process.HasExited)
+                    return null;
+                process.Refresh();
+                return process.WorkingSet64;
+            }
+            catch (Exception ex) when (ex is InvalidOperationException or NotSupportedException)
+            {
+                return null;
+            }
+        }
+    }
+
     /// <summary>
-    /// Start the worker process and send the init message.
+    /// Start the worker process (or connect to the server) and send the init message.
     /// </summary>
     public async Task StartAsync(CancellationToken ct)
     {
         ThrowHelpers.ThrowIfDisposed(_disposed, this);
 
+        if (_serverSocket != null)
+            await ConnectAsync(_serverSocket, ct).ConfigureAwait(false);
+        else
+            StartProcess();
+
+        // Send init message
+        var initRequest = new InitRequest
+        {
+            ResourcePath = _resourcePath,
+            FontPaths = _fontDirectories,
+            Threads = _threads,
+            Cpus = _cpus
+        };
+        var initBytes = Protocol.Serialize(initRequest);
+        await Protocol.WriteMessageAsync(_stdin!, initBytes, ct).ConfigureAwait(false);
+
+        // Read init response
+        var responseBytes = await Protocol.ReadMessageAsync(_stdout!, ct).ConfigureAwait(false);
+
+        if (responseBytes is null && _socket != null)
+        {
+            throw new SlimLOException(
+                $"slimlo_server at {_serverSocket} closed the connection during initialization.",
+                SlimLOErrorCode.InitFailed);
+        }
+
+        if (responseBytes is null)
+        {
+            var exitCode = ExitCode;
+            var stderr = GetStderrOutput();
+            var message = $"Worker process died during initialization (exit code: {exitCode}).";
+
+            if (stderr.Contains("error while loading shared libraries"))
+            {
+                message += " Missing system library detected. On Ubuntu/Debian, install: " +
+                    "apt-get install libfontconfig1 libfreetype6 libexpat1 libcairo2 libpng16-16 " +
+                    "libjpeg-turbo8 libxml2 libxslt1.1 libicu74 libnss3 libnspr4. " +
+                    "See https://github.com/nicobao/libreoffice-to-pdf#linux-system-dependencies for details.";
+            }
+
+            message += $" Stderr: {stderr}";
+            throw new SlimLOException(message, SlimLOErrorCode.InitFailed);
+        }
+
+        using var doc = Protocol.Deserialize(responseBytes);
+        var root = doc.RootElement;
+        var type = root.GetProperty("type").GetString();
+
+        if (type == "error")
+        {
+            var message = root.TryGetProperty("message", out var m) ? m.GetString() : "Unknown error";
+            throw new SlimLOException(
+                $"Worker initialization failed: {message}",
+                SlimLOErrorCode.InitFailed);
+        }
+
+        if (type == "ready")
+        {
+            _version = root.TryGetProperty("version", out var v) ? v.GetString() : null;
+            _initialized = true;
+        }
+        else
+        {
+            throw new SlimLOException(
+                $"Unexpected init response type: {type}",
+                SlimLOErrorCode.InitFailed);
+        }
+    }
+
+    private void StartProcess()
+    {
         var psi = new ProcessStartInfo
         {
             FileName = _workerPath,
@@ -119,61 +244,31 @@ internal sealed class WorkerProcess : IAsyncDisposable
         _process.ErrorDataReceived += OnStderrData;
         _process.BeginErrorReadLine();
 
-        // Send init message
-        var initRequest = new InitRequest
-        {
-            ResourcePath = _resourcePath,
-            FontPaths = _fontDirectories
-        };
-        var initBytes = Protocol.Serialize(initRequest);
-        await Protocol.WriteMessageAsync(
-            _process.StandardInput.BaseStream, initBytes, ct).ConfigureAwait(false);
-
-        // Read init response
-        var responseBytes = await Protocol.ReadMessageAsync(
-            _process.StandardOutput.BaseStream, ct).ConfigureAwait(false);
-
-        if (responseBytes is null)
-        {
-            var exitCode = _process.HasExited ? _process.ExitCode : -1;
-            var stderr = GetStderrOutput();
-            var message = $"Worker process died during initialization (exit code: {exitCode}).";
-
-            if (stderr.Contains("error while loading shared libraries"))
-            {
-                message += " Missing system library detected. On Ubuntu/Debian, install: " +
-                    "apt-get install libfontconfig1 libfreetype6 libexpat1 libcairo2 libpng16-16 " +
-                    "libjpeg-turbo8 libxml2 libxslt1.1 libicu74 libnss3 libnspr4. " +
-                    "See https://github.com/nicobao/libreoffice-to-pdf#linux-system-dependencies for details.";
-            }
-
-            message += $" Stderr: {stderr}";
-            throw new SlimLOException(message, SlimLOErrorCode.InitFailed);
-        }
-
-        using var doc = Protocol.Deserialize(responseBytes);
-        var root = doc.RootElement;
-        var type = root.GetProperty("type").GetString();
-
-        if (type == "error")
-        {
-            var message = root.TryGetProperty("message", out var m) ? m.GetString() : "Unknown error";
-            throw new SlimLOException(
-                $"Worker initialization failed: {message}",
-                SlimLOErrorCode.InitFailed);
-        }
+        _stdin = _process.StandardInput.BaseStream;
+        _stdout = _process.StandardOutput.BaseStream;
+    }
 
-        if (type == "ready")
+    private async Task ConnectAsync(string path, CancellationToken ct)
+    {
+#if NET8_0_OR_GREATER
+        var socket = new Socket(AddressFamily.Unix, SocketType.Stream, ProtocolType.Unspecified);
+        try
         {
-            _version = root.TryGetProperty("version", out var v) ? v.GetString() : null;
-            _initialized = true;
+            await socket.ConnectAsync(new UnixDomainSocketEndPoint(path), ct).ConfigureAwait(false);
         }
-        else
+        catch (SocketException ex)
         {
+            socket.Dispose();
             throw new SlimLOException(
-                $"Unexpected init response type: {type}",
-                SlimLOErrorCode.InitFailed);
+                $"Cannot connect to slimlo_server at {path}: {ex.Message}",
+                SlimLOErrorCode.InitFailed, ex);
         }
+        _socket = socket;
+        _stdin = _stdout = new NetworkStream(socket, ownsSocket: true);
+#else
+        await Task.CompletedTask.ConfigureAwait(false);
+        throw new PlatformNotSupportedException("Connecting to slimlo_server requires .NET 8 or later.");
+#endif
     }
 
     /// <summary>
@@ -182,63 +277,79 @@ internal sealed class WorkerProcess : IAsyncDisposable
     public async Task<ConversionResult> ConvertAsync(
         ConvertRequest request,
         TimeSpan timeout,
+        TimeSpan? stallTimeout,
+        IProgress<ConversionProgress>? progress,
         CancellationToken ct)
     {
         ThrowHelpers.ThrowIfDisposed(_disposed, this);
 
-        if (!_initialized || _process == null || _process.HasExited)
-            return ConversionResult.Fail(
-                "Worker process is not running",
-                SlimLOErrorCode.NotInitialized, null);
-
         await _lock.WaitAsync(ct).ConfigureAwait(false);
         try
         {
+            // Checked under the lock: the worker may have died while this request waited
+            if (!_initialized || !IsAlive)
+                return ConversionResult.Fail(
+                    "Worker process is not running",
+                    SlimLOErrorCode.NotInitialized, null);
+
             // Clear stderr buffer before conversion
             lock (_stderrBuffer)
                 _stderrBuffer.Clear();
 
-            // Create a linked cancellation token with timeout
+            // Create a linked cancellation token with timeout. The stall token
+            // is re-armed by every progress frame the worker sends.
             using var timeoutCts = CancellationTokenSource.CreateLinkedTokenSource(ct);
             timeoutCts.CancelAfter(timeout);
-            var linkedCt = timeoutCts.Token;
+            using var stallCts = CancellationTokenSource.CreateLinkedTokenSource(timeoutCts.Token);
+            if (stallTimeout is { } stall)
+                stallCts.CancelAfter(stall);
+            var linkedCt = stallCts.Token;
 
             try
             {
                 // Send convert request
                 var requestBytes = Protocol.Serialize(request);
                 await Protocol.WriteMessageAsync(
-                    _process.StandardInput.BaseStream, requestBytes, linkedCt).ConfigureAwait(false);
+                    _stdin!, requestBytes, linkedCt).ConfigureAwait(false);
 
-                // Read response
-                var responseBytes = await Protocol.ReadMessageAsync(
-                    _process.StandardOutput.BaseStream, linkedCt).ConfigureAwait(false);
+                // Read response (forwarding any progress frames)
+                using var doc = await ReadResponseAsync(
+                    _stdout!, progress, stallCts, stallTimeout, linkedCt)
+                    .ConfigureAwait(false);
 
-                if (responseBytes is null)
+                if (doc is null)
                 {
                     // Worker died during conversion
-                    var exitCode = _process.HasExited ? _process.ExitCode : -1;
-                    _initialized = false;
-                    return ConversionResult.Fail(
+                    var exitCode = ExitCode;
+                    return Lost(ConversionResult.Fail(
                         $"Worker process crashed during conversion (exit code: {exitCode}). " +
                         "This typically indicates a malformed or corrupted document.",
-                        SlimLOErrorCode.Unknown, null);
+                        SlimLOErrorCode.Unknown, null));
                 }
 
                 // Parse response
-                using var doc = Protocol.Deserialize(responseBytes);
                 var root = doc.RootElement;
 
                 var diagnostics = root.TryGetProperty("diagnostics", out var diagArray)
                     ? StderrDiagnosticParser.ParseFromJson(diagArray)
                     : Array.Empty<ConversionDiagnostic>();
+                RecordConversion(root, diagnostics);
 
                 var success = root.TryGetProperty("success", out var s) && s.GetBoolean();
 
                 if (success)
                 {
+                    var pageImages = await ReadPageImagesAsync(
+                        _stdout!, root, linkedCt).ConfigureAwait(false);
+                    if (pageImages is null)
+                    {
+                        return Lost(ConversionResult.Fail(
+                            "Worker process crashed while sending page images",
+                            SlimLOErrorCode.Unknown, diagnostics));
+                    }
+
                     Interlocked.Increment(ref _conversionCount);
-                    return ConversionResult.Ok(diagnostics);
+                    return ConversionResult.Ok(diagnostics, pageImages, ParsePageText(root));
                 }
                 else
                 {
@@ -253,14 +364,14 @@ internal sealed class WorkerProcess : IAsyncDisposable
                     return ConversionResult.Fail(errorMessage, errorCode, diagnostics);
                 }
             }
-            catch (OperationCanceledException) when (timeoutCts.IsCancellationRequested && !ct.IsCancellationRequested)
+            catch (OperationCanceledException) when (stallCts.IsCancellationRequested && !ct.IsCancellationRequested)
             {
-                // Timeout — kill the worker
+                // Timeout or stall — kill the worker
                 KillProcess();
-                _initialized = false;
-                return ConversionResult.Fail(
-                    $"Conversion timed out after {timeout.TotalSeconds:F0} seconds",
-                    SlimLOErrorCode.Unknown, null);
+                RecordTimeout(stalled: !timeoutCts.IsCancellationRequested);
+                return Lost(ConversionResult.Fail(
+                    TimeoutMessage("Conversion", timeoutCts.IsCancellationRequested, timeout, stallTimeout),
+                    SlimLOErrorCode.Unknown, null));
             }
         }
         finally
@@ -273,77 +384,179 @@ internal sealed class WorkerProcess : IAsyncDisposable
     /// Execute a buffer conversion. Sends document bytes, receives PDF bytes.
     /// The caller must hold the pool semaphore.
     /// </summary>
-    public async Task<ConversionResult<byte[]>> ConvertBufferAsync(
+    public Task<ConversionResult<byte[]>> ConvertBufferAsync(
         ConvertBufferRequest request,
         ReadOnlyMemory<byte> documentData,
         TimeSpan timeout,
+        TimeSpan? stallTimeout,
+        IProgress<ConversionProgress>? progress,
+        CancellationToken ct) =>
+        ConvertBufferAsync(request, documentData, timeout, stallTimeout, progress, Protocol.ReadMessageAsync, ct);
+
+    /// <summary>
+    /// Execute a buffer conversion whose PDF frame is consumed by <paramref name="readOutput"/>
+    /// (into a pooled buffer or a caller's writer), which returns null on EOF.
+    /// A <see cref="PooledBuffer"/> output is disposed if the conversion fails after it was read.
+    /// The caller must hold the pool semaphore.
+    /// </summary>
+    public Task<ConversionResult<T>> ConvertBufferAsync<T>(
+        ConvertBufferRequest request,
+        ReadOnlyMemory<byte> documentData,
+        TimeSpan timeout,
+        TimeSpan? stallTimeout,
+        IProgress<ConversionProgress>? progress,
+        Func<Stream, CancellationToken, Task<T?>> readOutput,
+        CancellationToken ct)
+        where T : class =>
+        ConvertBufferCoreAsync(
+            request, (stdin, t) => Protocol.WriteMessageAsync(stdin, documentData, t),
+            timeout, stallTimeout, progress, readOutput, ct);
+
+    /// <summary>
+    /// Execute a chunked buffer conversion: <paramref name="input"/> is sent to the worker
+    /// as it is read, and the PDF is written to <paramref name="output"/> as it arrives.
+    /// The stall timeout only starts once the whole document has been sent.
+    /// The caller must hold the pool semaphore.
+    /// </summary>
+    public async Task<ConversionResult> ConvertStreamAsync(
+        ConvertBufferRequest request,
+        Stream input,
+        Stream output,
+        TimeSpan timeout,
+        TimeSpan? stallTimeout,
+        IProgress<ConversionProgress>? progress,
         CancellationToken ct)
     {
-        ThrowHelpers.ThrowIfDisposed(_disposed, this);
+        var result = await ConvertBufferCoreAsync(
+            request,
+            (stdin, t) => Protocol.WriteChunkedAsync(stdin, input, t),
+            timeout, stallTimeout, progress,
+            async (stdout, t) => await Protocol.ReadChunkedAsync(stdout, output, t).ConfigureAwait(false)
+                ? output
+                : null,
+            ct).ConfigureAwait(false);
+        return result.AsBase();
+    }
 
-        if (!_initialized || _process == null || _process.HasExited)
-            return ConversionResult<byte[]>.Fail(
-                "Worker process is not running",
-                SlimLOErrorCode.NotInitialized, null);
+    private async Task<ConversionResult<T>> ConvertBufferCoreAsync<T>(
+        ConvertBufferRequest request,
+        Func<Stream, CancellationToken, Task> writeDocument,
+        TimeSpan timeout,
+        TimeSpan? stallTimeout,
+        IProgress<ConversionProgress>? progress,
+        Func<Stream, CancellationToken, Task<T?>> readOutput,
+        CancellationToken ct)
+        where T : class
+    {
+        ThrowHelpers.ThrowIfDisposed(_disposed, this);
 
         await _lock.WaitAsync(ct).ConfigureAwait(false);
         try
         {
+            // Checked under the lock: the worker may have died while this request waited
+            if (!_initialized || !IsAlive)
+                return ConversionResult<T>.Fail(
+                    "Worker process is not running",
+                    SlimLOErrorCode.NotInitialized, null);
+
             lock (_stderrBuffer)
                 _stderrBuffer.Clear();
 
             using var timeoutCts = CancellationTokenSource.CreateLinkedTokenSource(ct);
             timeoutCts.CancelAfter(timeout);
-            var linkedCt = timeoutCts.Token;
+            using var stallCts = CancellationTokenSource.CreateLinkedTokenSource(timeoutCts.Token);
+            if (stallTimeout is { } stall && !request.Chunked)
+                stallCts.CancelAfter(stall);
+            var linkedCt = stallCts.Token;
 
             try
             {
-                var stdin = _process.StandardInput.BaseStream;
-                var stdout = _process.StandardOutput.BaseStream;
+                var stdin = _stdin!;
+                var stdout = _stdout!;
 
                 // Send JSON header frame
                 var requestBytes = Protocol.Serialize(request);
                 await Protocol.WriteMessageAsync(stdin, requestBytes, linkedCt).ConfigureAwait(false);
 
-                // Send binary document frame
-                await Protocol.WriteMessageAsync(stdin, documentData, linkedCt).ConfigureAwait(false);
+                // Send binary document frame(s)
+                try
+                {
+                    await writeDocument(stdin, linkedCt).ConfigureAwait(false);
+                }
+                catch
+                {
+                    // A partly sent document leaves the worker mid-frame
+                    KillProcess();
+                    _initialized = false;
+                    throw;
+                }
+                if (request.Chunked && stallTimeout is { } chunkedStall)
+                    stallCts.CancelAfter(chunkedStall);
 
-                // Read JSON response frame
-                var responseBytes = await Protocol.ReadMessageAsync(stdout, linkedCt).ConfigureAwait(false);
+                // Read JSON response frame (forwarding any progress frames)
+                using var doc = await ReadResponseAsync(stdout, progress, stallCts, stallTimeout, linkedCt)
+                    .ConfigureAwait(false);
 
-                if (responseBytes is null)
+                if (doc is null)
                 {
-                    var exitCode = _process.HasExited ? _process.ExitCode : -1;
-                    _initialized = false;
-                    return ConversionResult<byte[]>.Fail(
+                    var exitCode = ExitCode;
+                    return Lost(ConversionResult<T>.Fail(
                         $"Worker process crashed during buffer conversion (exit code: {exitCode}). " +
                         "This typically indicates a malformed or corrupted document.",
-                        SlimLOErrorCode.Unknown, null);
+                        SlimLOErrorCode.Unknown, null));
                 }
 
-                using var doc = Protocol.Deserialize(responseBytes);
                 var root = doc.RootElement;
 
                 var diagnostics = root.TryGetProperty("diagnostics", out var diagArray)
                     ? StderrDiagnosticParser.ParseFromJson(diagArray)
                     : Array.Empty<ConversionDiagnostic>();
+                RecordConversion(root, diagnostics);
 
                 var success = root.TryGetProperty("success", out var s) && s.GetBoolean();
 
                 if (success)
                 {
-                    // Read binary PDF frame
-                    var pdfBytes = await Protocol.ReadMessageAsync(stdout, linkedCt).ConfigureAwait(false);
-                    if (pdfBytes is null)
+                    // Read binary PDF frame(s)
+                    T? pdf;
+                    try
                     {
+                        pdf = await readOutput(stdout, linkedCt).ConfigureAwait(false);
+                    }
+                    catch
+                    {
+                        // A partly read body leaves the rest of it queued on stdout
+                        KillProcess();
                         _initialized = false;
-                        return ConversionResult<byte[]>.Fail(
+                        throw;
+                    }
+                    if (pdf is null)
+                    {
+                        return Lost(ConversionResult<T>.Fail(
                             "Worker process crashed while sending PDF data",
-                            SlimLOErrorCode.Unknown, diagnostics);
+                            SlimLOErrorCode.Unknown, diagnostics));
+                    }
+
+                    IReadOnlyList<PageImage>? pageImages;
+                    try
+                    {
+                        pageImages = await ReadPageImagesAsync(stdout, root, linkedCt).ConfigureAwait(false);
+                    }
+                    catch
+                    {
+                        (pdf as PooledBuffer)?.Dispose();
+                        throw;
+                    }
+                    if (pageImages is null)
+                    {
+                        (pdf as PooledBuffer)?.Dispose();
+                        return Lost(ConversionResult<T>.Fail(
+                            "Worker process crashed while sending page images",
+                            SlimLOErrorCode.Unknown, diagnostics));
                     }
 
                     Interlocked.Increment(ref _conversionCount);
-                    return ConversionResult<byte[]>.Ok(pdfBytes, diagnostics);
+                    return ConversionResult<T>.Ok(pdf, diagnostics, pageImages, ParsePageText(root));
                 }
                 else
                 {
@@ -355,16 +568,278 @@ internal sealed class WorkerProcess : IAsyncDisposable
                         : SlimLOErrorCode.Unknown;
 
                     Interlocked.Increment(ref _conversionCount);
-                    return ConversionResult<byte[]>.Fail(errorMessage, errorCode, diagnostics);
+                    return ConversionResult<T>.Fail(errorMessage, errorCode, diagnostics);
+                }
+            }
+            catch (OperationCanceledException) when (stallCts.IsCancellationRequested && !ct.IsCancellationRequested)
+            {
+                KillProcess();
+                RecordTimeout(stalled: !timeoutCts.IsCancellationRequested);
+                return Lost(ConversionResult<T>.Fail(
+                    TimeoutMessage("Buffer conversion", timeoutCts.IsCancellationRequested, timeout, stallTimeout),
+                    SlimLOErrorCode.Unknown, null));
+            }
+        }
+        finally
+        {
+            _lock.Release();
+        }
+    }
+
+    /// <summary>
+    /// Query document metadata (load + layout, no export). When
+    /// <paramref name="documentData"/> is set it is sent as a binary frame after the
+    /// request header. The caller must hold the pool semaphore.
+    /// </summary>
+    public async Task<ConversionResult<DocumentInfo>> GetInfoAsync(
+        InfoRequest request,
+        ReadOnlyMemory<byte>? documentData,
+        TimeSpan timeout,
+        CancellationToken ct)
+    {
+        ThrowHelpers.ThrowIfDisposed(_disposed, this);
+
+        await _lock.WaitAsync(ct).ConfigureAwait(false);
+        try
+        {
+            // Checked under the lock: the worker may have died while this request waited
+            if (!_initialized || !IsAlive)
+                return ConversionResult<DocumentInfo>.Fail(
+                    "Worker process is not running",
+                    SlimLOErrorCode.NotInitialized, null);
+
+            lock (_stderrBuffer)
+                _stderrBuffer.Clear();
+
+            using var timeoutCts = CancellationTokenSource.CreateLinkedTokenSource(ct);
+            timeoutCts.CancelAfter(timeout);
+            var linkedCt = timeoutCts.Token;
+
+            try
+            {
+                var stdin = _stdin!;
+
+                var requestBytes = Protocol.Serialize(request);
+                await Protocol.WriteMessageAsync(stdin, requestBytes, linkedCt).ConfigureAwait(false);
+                if (documentData is { } data)
+                    await Protocol.WriteMessageAsync(stdin, data, linkedCt).ConfigureAwait(false);
+
+                using var doc = await ReadResponseAsync(
+                    _stdout!, null, timeoutCts, null, linkedCt)
+                    .ConfigureAwait(false);
+
+                if (doc is null)
+                {
+                    var exitCode = ExitCode;
+                    return Lost(ConversionResult<DocumentInfo>.Fail(
+                        $"Worker process crashed while loading the document (exit code: {exitCode}). " +
+                        "This typically indicates a malformed or corrupted document.",
+                        SlimLOErrorCode.Unknown, null));
+                }
+
+                var root = doc.RootElement;
+
+                var diagnostics = root.TryGetProperty("diagnostics", out var diagArray)
+                    ? StderrDiagnosticParser.ParseFromJson(diagArray)
+                    : Array.Empty<ConversionDiagnostic>();
+
+                Interlocked.Increment(ref _conversionCount);
+
+                if (root.TryGetProperty("success", out var s) && s.GetBoolean())
+                    return ConversionResult<DocumentInfo>.Ok(ParseDocumentInfo(root), diagnostics);
+
+                var errorMessage = root.TryGetProperty("error_message", out var em)
+                    ? em.GetString() ?? "Document info failed"
+                    : "Document info failed";
+                var errorCode = root.TryGetProperty("error_code", out var ec) && ec.ValueKind == JsonValueKind.Number
+                    ? (SlimLOErrorCode)ec.GetInt32()
+                    : SlimLOErrorCode.Unknown;
+                return ConversionResult<DocumentInfo>.Fail(errorMessage, errorCode, diagnostics);
+            }
+            catch (OperationCanceledException) when (timeoutCts.IsCancellationRequested && !ct.IsCancellationRequested)
+            {
+                KillProcess();
+                RecordTimeout(stalled: false);
+                return Lost(ConversionResult<DocumentInfo>.Fail(
+                    TimeoutMessage("Document info", true, timeout, null),
+                    SlimLOErrorCode.Unknown, null));
+            }
+        }
+        finally
+        {
+            _lock.Release();
+        }
+    }
+
+    /// <summary>
+    /// Render pages to images (load, no export). When <paramref name="documentData"/>
+    /// is set it is sent as a binary frame after the request header. The caller must
+    /// hold the pool semaphore.
+    /// </summary>
+    public async Task<ConversionResult> RenderAsync(
+        RenderRequest request,
+        ReadOnlyMemory<byte>? documentData,
+        TimeSpan timeout,
+        CancellationToken ct)
+    {
+        ThrowHelpers.ThrowIfDisposed(_disposed, this);
+
+        await _lock.WaitAsync(ct).ConfigureAwait(false);
+        try
+        {
+            // Checked under the lock: the worker may have died while this request waited
+            if (!_initialized || !IsAlive)
+                return ConversionResult.Fail(
+                    "Worker process is not running",
+                    SlimLOErrorCode.NotInitialized, null);
+
+            lock (_stderrBuffer)
+                _stderrBuffer.Clear();
+
+            using var timeoutCts = CancellationTokenSource.CreateLinkedTokenSource(ct);
+            timeoutCts.CancelAfter(timeout);
+            var linkedCt = timeoutCts.Token;
+
+            try
+            {
+                var stdin = _stdin!;
+                var stdout = _stdout!;
+
+                var requestBytes = Protocol.Serialize(request);
+                await Protocol.WriteMessageAsync(stdin, requestBytes, linkedCt).ConfigureAwait(false);
+                if (documentData is { } data)
+                    await Protocol.WriteMessageAsync(stdin, data, linkedCt).ConfigureAwait(false);
+
+                using var doc = await ReadResponseAsync(stdout, null, timeoutCts, null, linkedCt)
+                    .ConfigureAwait(false);
+
+                if (doc is null)
+                {
+                    var exitCode = ExitCode;
+                    return Lost(ConversionResult.Fail(
+                        $"Worker process crashed while rendering pages (exit code: {exitCode}). " +
+                        "This typically indicates a malformed or corrupted document.",
+                        SlimLOErrorCode.Unknown, null));
+                }
+
+                var root = doc.RootElement;
+
+                var diagnostics = root.TryGetProperty("diagnostics", out var diagArray)
+                    ? StderrDiagnosticParser.ParseFromJson(diagArray)
+                    : Array.Empty<ConversionDiagnostic>();
+
+                Interlocked.Increment(ref _conversionCount);
+
+                if (root.TryGetProperty("success", out var s) && s.GetBoolean())
+                {
+                    var pageImages = await ReadPageImagesAsync(stdout, root, linkedCt).ConfigureAwait(false);
+                    if (pageImages is null)
+                    {
+                        return Lost(ConversionResult.Fail(
+                            "Worker process crashed while sending page images",
+                            SlimLOErrorCode.Unknown, diagnostics));
+                    }
+                    return ConversionResult.Ok(diagnostics, pageImages);
+                }
+
+                var errorMessage = root.TryGetProperty("error_message", out var em)
+                    ? em.GetString() ?? "Page rendering failed"
+                    : "Page rendering failed";
+                var errorCode = root.TryGetProperty("error_code", out var ec) && ec.ValueKind == JsonValueKind.Number
+                    ? (SlimLOErrorCode)ec.GetInt32()
+                    : SlimLOErrorCode.Unknown;
+                return ConversionResult.Fail(errorMessage, errorCode, diagnostics);
+            }
+            catch (OperationCanceledException) when (timeoutCts.IsCancellationRequested && !ct.IsCancellationRequested)
+            {
+                KillProcess();
+                RecordTimeout(stalled: false);
+                return Lost(ConversionResult.Fail(
+                    TimeoutMessage("Page rendering", true, timeout, null),
+                    SlimLOErrorCode.Unknown, null));
+            }
+        }
+        finally
+        {
+            _lock.Release();
+        }
+    }
+
+    /// <summary>
+    /// Bring the worker's fonts up to <paramref name="fontDirectories"/> with an
+    /// "add_fonts" request for the directories it does not have yet; no-op if it has
+    /// them all. Waits for a running request to finish first. A directory the worker
+    /// rejects is not retried.
+    /// </summary>
+    public async Task<ConversionResult> AddFontsAsync(
+        IReadOnlyList<string> fontDirectories,
+        TimeSpan timeout,
+        CancellationToken ct)
+    {
+        ThrowHelpers.ThrowIfDisposed(_disposed, this);
+
+        await _lock.WaitAsync(ct).ConfigureAwait(false);
+        try
+        {
+            // Checked under the lock: the worker may have died while this request waited
+            if (!_initialized || !IsAlive)
+                return ConversionResult.Fail(
+                    "Worker process is not running",
+                    SlimLOErrorCode.NotInitialized, null);
+
+            var pending = PendingFonts(_registeredFonts, fontDirectories);
+            if (pending.Count == 0)
+                return ConversionResult.Ok(null);
+
+            lock (_stderrBuffer)
+                _stderrBuffer.Clear();
+
+            using var timeoutCts = CancellationTokenSource.CreateLinkedTokenSource(ct);
+            timeoutCts.CancelAfter(timeout);
+            var linkedCt = timeoutCts.Token;
+
+            try
+            {
+                var requestBytes = Protocol.Serialize(new AddFontsRequest { Paths = pending });
+                await Protocol.WriteMessageAsync(_stdin!, requestBytes, linkedCt).ConfigureAwait(false);
+
+                using var doc = await ReadResponseAsync(
+                    _stdout!, null, timeoutCts, null, linkedCt)
+                    .ConfigureAwait(false);
+
+                if (doc is null)
+                {
+                    var exitCode = ExitCode;
+                    return Lost(ConversionResult.Fail(
+                        $"Worker process crashed while registering fonts (exit code: {exitCode}).",
+                        SlimLOErrorCode.Unknown, null));
                 }
+
+                _registeredFonts = fontDirectories;
+
+                var root = doc.RootElement;
+                var diagnostics = root.TryGetProperty("diagnostics", out var diagArray)
+                    ? StderrDiagnosticParser.ParseFromJson(diagArray)
+                    : Array.Empty<ConversionDiagnostic>();
+
+                if (root.TryGetProperty("success", out var s) && s.GetBoolean())
+                    return ConversionResult.Ok(diagnostics);
+
+                var errorMessage = root.TryGetProperty("error_message", out var em)
+                    ? em.GetString() ?? "Font registration failed"
+                    : "Font registration failed";
+                var errorCode = root.TryGetProperty("error_code", out var ec) && ec.ValueKind == JsonValueKind.Number
+                    ? (SlimLOErrorCode)ec.GetInt32()
+                    : SlimLOErrorCode.Unknown;
+                return ConversionResult.Fail(errorMessage, errorCode, diagnostics);
             }
             catch (OperationCanceledException) when (timeoutCts.IsCancellationRequested && !ct.IsCancellationRequested)
             {
                 KillProcess();
-                _initialized = false;
-                return ConversionResult<byte[]>.Fail(
-                    $"Buffer conversion timed out after {timeout.TotalSeconds:F0} seconds",
-                    SlimLOErrorCode.Unknown, null);
+                RecordTimeout(stalled: false);
+                return Lost(ConversionResult.Fail(
+                    TimeoutMessage("Font registration", true, timeout, null),
+                    SlimLOErrorCode.Unknown, null));
             }
         }
         finally
@@ -373,6 +848,213 @@ internal sealed class WorkerProcess : IAsyncDisposable
         }
     }
 
+    /// <summary>Entries of <paramref name="wanted"/> not in <paramref name="registered"/>, in order.</summary>
+    internal static IReadOnlyList<string> PendingFonts(IReadOnlyList<string> registered, IReadOnlyList<string> wanted)
+    {
+        if (ReferenceEquals(registered, wanted))
+            return Array.Empty<string>();
+
+        var pending = new List<string>();
+        foreach (var path in wanted)
+        {
+            bool known = false;
+            foreach (var existing in registered)
+            {
+                if (string.Equals(existing, path, StringComparison.Ordinal))
+                {
+                    known = true;
+                    break;
+                }
+            }
+            if (!known && !pending.Contains(path))
+                pending.Add(path);
+        }
+        return pending;
+    }
+
+    /// <summary>
+    /// Read the binary frames announced by a response's "images" array, one per image.
+    /// Returns null if the worker closed the pipe before sending all of them.
+    /// </summary>
+    private static async Task<IReadOnlyList<PageImage>?> ReadPageImagesAsync(
+        Stream stdout, JsonElement root, CancellationToken ct)
+    {
+        if (!root.TryGetProperty("images", out var images) || images.ValueKind != JsonValueKind.Array)
+            return Array.Empty<PageImage>();
+
+        var list = new List<PageImage>(images.GetArrayLength());
+        foreach (var meta in images.EnumerateArray())
+        {
+            var data = await Protocol.ReadMessageAsync(stdout, ct).ConfigureAwait(false);
+            if (data is null)
+                return null;
+            list.Add(ParsePageImage(meta, data));
+        }
+        return list;
+    }
+
+    /// <summary>Build a <see cref="PageImage"/> from an "images" entry and its frame.</summary>
+    internal static PageImage ParsePageImage(JsonElement meta, byte[] data) =>
+        new(GetInt32(meta, "page"),
+            GetInt32(meta, "width"),
+            GetInt32(meta, "height"),
+            (PageImageFormat)GetInt32(meta, "format"),
+            data);
+
+    /// <summary>Parse the "text" array of a successful conversion result.</summary>
+    internal static IReadOnlyList<PageText> ParsePageText(JsonElement root)
+    {
+        if (!root.TryGetProperty("text", out var pages) || pages.ValueKind != JsonValueKind.Array)
+            return Array.Empty<PageText>();
+
+        var list = new List<PageText>(pages.GetArrayLength());
+        foreach (var page in pages.EnumerateArray())
+        {
+            List<WordBox>? words = null;
+            if (page.TryGetProperty("words", out var wordArray) && wordArray.ValueKind == JsonValueKind.Array)
+            {
+                words = new List<WordBox>(wordArray.GetArrayLength());
+                foreach (var word in wordArray.EnumerateArray())
+                {
+                    if (word.ValueKind != JsonValueKind.Array || word.GetArrayLength() < 5)
+                        continue;
+                    words.Add(new WordBox(
+                        word[0].GetDouble(), word[1].GetDouble(),
+                        word[2].GetDouble(), word[3].GetDouble(),
+                        word[4].GetString() ?? string.Empty));
+                }
+            }
+
+            list.Add(new PageText(
+                GetInt32(page, "page"),
+                new PageSize(
+                    page.TryGetProperty("width", out var w) && w.ValueKind == JsonValueKind.Number ? w.GetDouble() : 0,
+                    page.TryGetProperty("height", out var h) && h.ValueKind == JsonValueKind.Number ? h.GetDouble() : 0),
+                page.TryGetProperty("text", out var t) ? t.GetString() ?? string.Empty : string.Empty,
+                words));
+        }
+        return list;
+    }
+
+    /// <summary>Parse a successful worker "info_result" frame.</summary>
+    internal static DocumentInfo ParseDocumentInfo(JsonElement root)
+    {
+        var pages = new List<PageSize>();
+        if (root.TryGetProperty("pages", out var pagesArray) && pagesArray.ValueKind == JsonValueKind.Array)
+        {
+            foreach (var page in pagesArray.EnumerateArray())
+            {
+                pages.Add(new PageSize(
+                    page.TryGetProperty("width", out var w) && w.ValueKind == JsonValueKind.Number ? w.GetDouble() : 0,
+                    page.TryGetProperty("height", out var h) && h.ValueKind == JsonValueKind.Number ? h.GetDouble() : 0));
+            }
+        }
+
+        return new DocumentInfo(
+            GetInt32(root, "page_count"),
+            pages,
+            GetInt32(root, "section_count"),
+            GetInt32(root, "image_count"),
+            GetInt32(root, "word_count"),
+            GetStrings(root, "fonts"),
+            GetStrings(root, "missing_fonts"));
+    }
+
+    private static IReadOnlyList<string> GetStrings(JsonElement root, string name)
+    {
+        if (!root.TryGetProperty(name, out var array) || array.ValueKind != JsonValueKind.Array)
+            return Array.Empty<string>();
+
+        var list = new List<string>(array.GetArrayLength());
+        foreach (var item in array.EnumerateArray())
+        {
+            if (item.ValueKind == JsonValueKind.String)
+                list.Add(item.GetString()!);
+        }
+        return list;
+    }
+
+    /// <summary>
+    /// Read frames until a non-progress response arrives. Progress frames are
+    /// forwarded to <paramref name="progress"/> and re-arm the stall timer.
+    /// Returns null if the worker closed the pipe.
+    /// </summary>
+    private static async Task<JsonDocument?> ReadResponseAsync(
+        Stream stdout,
+        IProgress<ConversionProgress>? progress,
+        CancellationTokenSource stallCts,
+        TimeSpan? stallTimeout,
+        CancellationToken ct)
+    {
+        while (true)
+        {
+            var bytes = await Protocol.ReadMessageAsync(stdout, ct).ConfigureAwait(false);
+            if (bytes is null)
+                return null;
+
+            var doc = Protocol.Deserialize(bytes);
+            var root = doc.RootElement;
+            if (!root.TryGetProperty("type", out var t) || t.GetString() != "progress")
+                return doc;
+
+            using (doc)
+            {
+                if (stallTimeout is { } stall)
+                    stallCts.CancelAfter(stall);
+                try
+                {
+                    progress?.Report(ParseProgress(root));
+                }
+                catch
+                {
+                    // A failing handler must not desynchronize the frame stream
+                }
+            }
+        }
+    }
+
+    /// <summary>Parse a worker "progress" frame.</summary>
+    internal static ConversionProgress ParseProgress(JsonElement root)
+    {
+        var phase = root.TryGetProperty("phase", out var p) ? p.GetString() : null;
+        return new ConversionProgress(
+            phase switch
+            {
+                "load" => ConversionPhase.Load,
+                "layout" => ConversionPhase.Layout,
+                "export" => ConversionPhase.Export,
+                "done" => ConversionPhase.Done,
+                _ => ConversionPhase.Unknown
+            },
+            GetInt32(root, "percent"),
+            GetInt32(root, "pages_laid_out"),
+            GetInt32(root, "pages_exported"),
+            root.TryGetProperty("bytes_written", out var b) && b.ValueKind == JsonValueKind.Number
+                ? b.GetInt64()
+                : 0);
+    }
+
+    private static int GetInt32(JsonElement root, string name) =>
+        root.TryGetProperty(name, out var v) && v.ValueKind == JsonValueKind.Number ? v.GetInt32() : 0;
+
+    private void RecordConversion(JsonElement root, IReadOnlyList<ConversionDiagnostic> diagnostics)
+    {
+        if (PoolMetrics.ResidentBytes(root) is { } rss)
+            Interlocked.Exchange(ref _residentBytes, rss);
+        _metrics?.RecordConversion(root, diagnostics);
+    }
+
+    private void RecordTimeout(bool stalled)
+    {
+        _timedOut = true;
+        _metrics?.RecordTimeout(stalled);
+    }
+
+    private static string TimeoutMessage(string operation, bool wallClock, TimeSpan timeout, TimeSpan? stallTimeout) =>
+        wallClock || stallTimeout is null
+            ? $"{operation} timed out after {timeout.TotalSeconds:F0} seconds"
+            : $"{operation} stalled: no progress from worker for {stallTimeout.Value.TotalSeconds:F0} seconds";
+
     private void OnStderrData(object sender, DataReceivedEventArgs e)
     {
         if (e.Data is null) return;
@@ -388,8 +1070,29 @@ internal sealed class WorkerProcess : IAsyncDisposable
             return _stderrBuffer.ToString();
     }
 
+    /// <summary>Exit code of the worker process, or -1 if running or remote.</summary>
+    private int ExitCode => _process is { HasExited: true } process ? process.ExitCode : -1;
+
+    /// <summary>
+    /// Mark the worker lost by the running exchange (crash, or kill on timeout or stall)
+    /// and flag the exchange's result, so the pool blames this request's document and
+    /// not one that merely queued behind it.
+    /// </summary>
+    private T Lost<T>(T result) where T : ConversionResult
+    {
+        _initialized = false;
+        result.WorkerLost = true;
+        return result;
+    }
+
     private void KillProcess()
     {
+        if (_socket != null)
+        {
+            // Dropping the connection makes the server kill the worker serving it
+            _stdout?.Dispose();
+            return;
+        }
         try
         {
             if (_process != null && !_process.HasExited)
@@ -410,6 +1113,26 @@ internal sealed class WorkerProcess : IAsyncDisposable
         if (_disposed) return;
         _disposed = true;
 
+        if (_socket != null)
+        {
+            try
+            {
+                if (_initialized)
+                {
+                    var quitBytes = Protocol.Serialize(new QuitRequest());
+                    await Protocol.WriteMessageAsync(_stdin!, quitBytes, CancellationToken.None)
+                        .ConfigureAwait(false);
+                }
+            }
+            catch
+            {
+                // Best effort — the server may already have closed the connection
+            }
+            _stdout?.Dispose();
+            _lock.Dispose();
+            return;
+        }
+
         if (_process != null && !_process.HasExited)
         {
             try
@@ -417,7 +1140,7 @@ internal sealed class WorkerProcess : IAsyncDisposable
                 // Try graceful shutdown first
                 var quitBytes = Protocol.Serialize(new QuitRequest());
                 await Protocol.WriteMessageAsync(
-                    _process.StandardInput.BaseStream, quitBytes, CancellationToken.None)
+                    _stdin!, quitBytes, CancellationToken.None)
                     .ConfigureAwait(false);
 
                 // Wait up to 5 seconds for graceful exit
@@ -5,13 +5,64 @@ using System.Runtime.InteropServices;
 namespace SlimLO.Internal;
 
 /// <summary>
-/// Minimal P/Invoke declarations for the SlimLO native library.
-/// Used only for version queries — all conversion goes through the worker process.
+/// P/Invoke declarations for the SlimLO native library: the version query, and
+/// the conversion calls <see cref="InProcessConverter"/> makes on its LibreOffice
+/// thread. <see cref="PdfConverter"/> converts through worker processes instead.
 /// </summary>
-internal static partial class NativeMethods
+internal static unsafe partial class NativeMethods
 {
     private const string LibraryName = "slimlo";
 
+    /// <summary>
+    /// Directory searched first for the library (the resource path's program/),
+    /// set by <see cref="InProcessConverter"/> before its first native call.
+    /// </summary>
+    internal static string? LibraryDirectory { get; set; }
+
+    // Blittable signatures need no marshalling stub, so one declaration serves
+    // both targets (the .NET 8 resolver below applies to DllImport as well).
+
+    [DllImport(LibraryName, EntryPoint = "slimlo_init_ex", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern IntPtr InitEx(byte* resourcePath, NativeInitOptions* options);
+
+    [DllImport(LibraryName, EntryPoint = "slimlo_destroy", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void Destroy(IntPtr handle);
+
+    [DllImport(LibraryName, EntryPoint = "slimlo_convert_file", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern int ConvertFile(
+        IntPtr handle, byte* inputPath, byte* outputPath, int format, NativePdfOptions* options);
+
+    [DllImport(LibraryName, EntryPoint = "slimlo_convert_buffer", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern int ConvertBuffer(
+        IntPtr handle, byte* input, nuint inputSize, int format, NativePdfOptions* options,
+        byte** output, nuint* outputSize);
+
+    [DllImport(LibraryName, EntryPoint = "slimlo_convert_buffer_alloc", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern int ConvertBufferAlloc(
+        IntPtr handle, byte* input, nuint inputSize, int format, NativePdfOptions* options,
+        NativeAllocator* allocator, byte** output, nuint* outputSize);
+
+    [DllImport(LibraryName, EntryPoint = "slimlo_add_font_directory", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern int AddFontDirectory(IntPtr handle, byte* path);
+
+    [DllImport(LibraryName, EntryPoint = "slimlo_free_buffer", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void FreeBuffer(byte* buffer);
+
+    [DllImport(LibraryName, EntryPoint = "slimlo_get_error_message", CallingConvention = CallingConvention.Cdecl)]
+    private static extern byte* GetErrorMessageUtf8(IntPtr handle);
+
+    /// <summary>Last error message for <paramref name="handle"/> (<see cref="IntPtr.Zero"/>: init errors).</summary>
+    internal static string GetErrorMessage(IntPtr handle)
+    {
+        var message = GetErrorMessageUtf8(handle);
+        if (message == null)
+            return "";
+        int length = 0;
+        while (message[length] != 0)
+            length++;
+        return System.Text.Encoding.UTF8.GetString(message, length);
+    }
+
 #if NET8_0_OR_GREATER
     static NativeMethods()
     {
@@ -30,12 +81,6 @@ internal static partial class NativeMethods
         if (libraryName != LibraryName)
             return IntPtr.Zero;
 
-        if (NativeLibrary.TryLoad(libraryName, assembly, searchPath, out var handle))
-            return handle;
-
-        var assemblyDir = Path.GetDirectoryName(assembly.Location)
-                          ?? AppContext.BaseDirectory;
-
         string libFileName;
         if (RuntimeInformation.IsOSPlatform(OSPlatform.Windows))
             libFileName = "slimlo.dll";
@@ -44,6 +89,17 @@ internal static partial class NativeMethods
         else
             libFileName = "libslimlo.so";
 
+        IntPtr handle;
+        if (LibraryDirectory != null &&
+            NativeLibrary.TryLoad(Path.Combine(LibraryDirectory, libFileName), out handle))
+            return handle;
+
+        if (NativeLibrary.TryLoad(libraryName, assembly, searchPath, out handle))
+            return handle;
+
+        var assemblyDir = Path.GetDirectoryName(assembly.Location)
+                          ?? AppContext.BaseDirectory;
+
         var rid = RuntimeInformation.RuntimeIdentifier;
         string[] searchPaths = new[]
         {
@@ -70,3 +126,36 @@ internal static partial class NativeMethods
     internal static extern string? GetVersion();
 #endif
 }
+
+/// <summary>SlimLOInitOptions (slimlo.h).</summary>
+[StructLayout(LayoutKind.Sequential)]
+internal struct NativeInitOptions
+{
+    public int Threads;
+}
+
+/// <summary>SlimLOPdfOptions (slimlo.h). Strings are UTF-8 in unmanaged memory.</summary>
+[StructLayout(LayoutKind.Sequential)]
+internal struct NativePdfOptions
+{
+    public int PdfVersion;
+    public int JpegQuality;
+    public int Dpi;
+    public int TaggedPdf;
+    public IntPtr PageRange;
+    public IntPtr Password;
+    public int Preset;
+    public IntPtr FilterOptions;
+    public int LazyLayout;
+    public int SkipFieldUpdate;
+}
+
+/// <summary>SlimLOAllocator (slimlo.h): function pointers and their context.</summary>
+[StructLayout(LayoutKind.Sequential)]
+internal struct NativeAllocator
+{
+    public IntPtr Alloc;
+    public IntPtr Realloc;
+    public IntPtr Free;
+    public IntPtr Context;
+}
@@ -0,0 +1,35 @@
+using System;
+
+namespace SlimLO;
+
+/// <summary>
+/// A document page rendered to an image.
+/// </summary>
+public sealed class PageImage
+{
+    public PageImage(int pageNumber, int width, int height, PageImageFormat format, byte[] data)
+    {
+        PageNumber = pageNumber;
+        Width = width;
+        Height = height;
+        Format = format;
+        Data = data ?? throw new ArgumentNullException(nameof(data));
+    }
+
+    /// <summary>1-based page number.</summary>
+    public int PageNumber { get; }
+
+    /// <summary>Image width in pixels.</summary>
+    public int Width { get; }
+
+    /// <summary>Image height in pixels.</summary>
+    public int Height { get; }
+
+    /// <summary>Format of <see cref="Data"/>.</summary>
+    public PageImageFormat Format { get; }
+
+    /// <summary>PNG bytes, or <c>Width * Height * 4</c> RGBA bytes.</summary>
+    public byte[] Data { get; }
+
+    public override string ToString() => $"page {PageNumber}: {Format} {Width}x{Height}, {Data.Length} bytes";
+}
@@ -0,0 +1,65 @@
+using System;
+using System.Collections.Generic;
+
+namespace SlimLO;
+
+/// <summary>
+/// Text of one page, taken from the layout the PDF was exported from.
+/// </summary>
+public sealed class PageText
+{
+    public PageText(int pageNumber, PageSize size, string text, IReadOnlyList<WordBox>? words)
+    {
+        PageNumber = pageNumber;
+        Size = size;
+        Text = text ?? throw new ArgumentNullException(nameof(text));
+        Words = words ?? Array.Empty<WordBox>();
+    }
+
+    /// <summary>1-based page number.</summary>
+    public int PageNumber { get; }
+
+    /// <summary>Page size in points.</summary>
+    public PageSize Size { get; }
+
+    /// <summary>Plain text in reading order, lines separated by <c>'\n'</c>.</summary>
+    public string Text { get; }
+
+    /// <summary>
+    /// Words with their bounding boxes, in paint order. Empty unless
+    /// <see cref="TextOptions.IncludeWords"/> was set.
+    /// </summary>
+    public IReadOnlyList<WordBox> Words { get; }
+
+    public override string ToString() => $"page {PageNumber}: {Text.Length} chars, {Words.Count} words";
+}
+
+/// <summary>A word and its bounding box, in points from the page's top-left corner.</summary>
+public readonly struct WordBox
+{
+    public WordBox(double x, double y, double width, double height, string text)
+    {
+        X = x;
+        Y = y;
+        Width = width;
+        Height = height;
+        Text = text;
+    }
+
+    /// <summary>Left edge in points.</summary>
+    public double X { get; }
+
+    /// <summary>Top edge in points.</summary>
+    public double Y { get; }
+
+    /// <summary>Width in points.</summary>
+    public double Width { get; }
+
+    /// <summary>Height in points.</summary>
+    public double Height { get; }
+
+    /// <summary>The word.</summary>
+    public string Text { get; }
+
+    public override string ToString() => $"\"{Text}\" at {X:0.#},{Y:0.#} ({Width:0.#}x{Height:0.#} pt)";
+}
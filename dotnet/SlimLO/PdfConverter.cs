@@ -1,4 +1,6 @@
 using System;
+using System.Buffers;
+using System.Collections.Generic;
 using System.IO;
 using System.Threading;
 using System.Threading.Tasks;
@@ -20,7 +22,8 @@ namespace SlimLO;
 /// is never affected.</para>
 ///
 /// <para><b>Font support:</b> Custom font directories can be specified via
-/// <see cref="PdfConverterOptions.FontDirectories"/>. Font substitution warnings
+/// <see cref="PdfConverterOptions.FontDirectories"/>, or added at runtime with
+/// <see cref="AddFontDirectoryAsync"/>. Font substitution warnings
 /// are reported in <see cref="ConversionResult.Diagnostics"/>.</para>
 ///
 /// <para><b>Conversion modes:</b> The converter uses two IPC strategies depending on the overload:
@@ -61,6 +64,14 @@ namespace SlimLO;
 /// </summary>
 public sealed class PdfConverter : IAsyncDisposable, IDisposable
 {
+    /// <summary>
+    /// Name of the <see cref="System.Diagnostics.Metrics.Meter"/> converters publish their
+    /// instruments under (queue depth and wait, conversion phase durations, bytes in and
+    /// out, worker starts, recycles, crashes and timeouts, worker memory, font fallbacks).
+    /// Subscribe with a <c>MeterListener</c> or OpenTelemetry's <c>AddMeter("SlimLO")</c>.
+    /// </summary>
+    public const string MeterName = "SlimLO";
+
     private readonly WorkerPool _pool;
     private volatile bool _disposed;
     private int _requestId;
@@ -86,17 +97,54 @@ public sealed class PdfConverter : IAsyncDisposable, IDisposable
         if (options.MaxWorkers < 1)
             throw new ArgumentOutOfRangeException(
                 nameof(options), "MaxWorkers must be at least 1");
+        if (options.MinWorkers < 0 || options.MinWorkers > options.MaxWorkers)
+            throw new ArgumentOutOfRangeException(
+                nameof(options), "MinWorkers must be between 0 and MaxWorkers");
+        if (options.IdleTimeout is { } idle && idle <= TimeSpan.Zero)
+            throw new ArgumentOutOfRangeException(
+                nameof(options), "IdleTimeout must be positive");
+        if (options.MemoryBudget is { } budget && budget <= 0)
+            throw new ArgumentOutOfRangeException(
+                nameof(options), "MemoryBudget must be positive");
+        if (options.StallTimeout is { } stall && stall <= TimeSpan.Zero)
+            throw new ArgumentOutOfRangeException(
+                nameof(options), "StallTimeout must be positive");
+        if (options.ThreadsPerWorker < 0)
+            throw new ArgumentOutOfRangeException(
+                nameof(options), "ThreadsPerWorker must not be negative");
+        if (options.QuarantineAfterCrashes < 0)
+            throw new ArgumentOutOfRangeException(
+                nameof(options), "QuarantineAfterCrashes must not be negative");
+        if (options.QuarantineAfterCrashes > 0 && options.QuarantineCapacity < 1)
+            throw new ArgumentOutOfRangeException(
+                nameof(options), "QuarantineCapacity must be at least 1");
+        if (options.MaxWorkersPerTenant < 0)
+            throw new ArgumentOutOfRangeException(
+                nameof(options), "MaxWorkersPerTenant must not be negative");
+        if (options.TenantWeights != null)
+        {
+            foreach (var weight in options.TenantWeights)
+            {
+                if (weight.Value < 1)
+                    throw new ArgumentOutOfRangeException(
+                        nameof(options), $"Weight of tenant '{weight.Key}' must be at least 1");
+            }
+        }
 
-        var workerPath = WorkerLocator.FindWorkerExecutable();
-        var resourcePath = options.ResourcePath ?? WorkerLocator.FindResourcePath();
+        // Connected to a slimlo_server, the pool holds connections, not processes
+        var serverSocket = options.ServerSocket;
+        if (serverSocket != null)
+        {
+            ThrowHelpers.ThrowIfNullOrEmpty(serverSocket);
+#if !NET8_0_OR_GREATER
+            throw new PlatformNotSupportedException("ServerSocket requires .NET 8 or later.");
+#endif
+        }
+        var workerPath = serverSocket == null ? WorkerLocator.FindWorkerExecutable() : "";
+        var resourcePath = options.ResourcePath
+            ?? (serverSocket == null ? WorkerLocator.FindResourcePath() : "");
 
-        var pool = new WorkerPool(
-            workerPath,
-            resourcePath,
-            options.FontDirectories,
-            options.MaxWorkers,
-            options.MaxConversionsPerWorker,
-            options.ConversionTimeout);
+        var pool = new WorkerPool(WorkerPoolSettings.From(options, workerPath, resourcePath));
 
         var converter = new PdfConverter(pool);
 
@@ -157,10 +205,16 @@ public sealed class PdfConverter : IAsyncDisposable, IDisposable
             Input = inputPath,
             Output = outputPath,
             Format = (int)format,
-            Options = ConvertRequestOptions.FromConversionOptions(options)
+            Options = ConvertRequestOptions.FromConversionOptions(options),
+            Progress = WantsProgress(options),
+            Render = RenderRequestOptions.FromRenderOptions(options?.PageImages),
+            Text = TextRequestOptions.FromTextOptions(options?.PageText)
         };
 
-        return await _pool.ExecuteAsync(request, cancellationToken).ConfigureAwait(false);
+        return await _pool.ExecuteAsync(
+            request, options?.Progress,
+            AdmissionQueue.DeadlineAfter(options?.Deadline), options?.Tenant, cancellationToken)
+            .ConfigureAwait(false);
     }
 
     /// <summary>
@@ -200,6 +254,87 @@ public sealed class PdfConverter : IAsyncDisposable, IDisposable
             .ConfigureAwait(false);
     }
 
+    /// <summary>
+    /// Convert an in-memory document to PDF, writing the PDF into a caller-supplied buffer.
+    /// </summary>
+    /// <param name="input">Input document bytes.</param>
+    /// <param name="output">Buffer writer that receives the PDF bytes.</param>
+    /// <param name="format">Document format (required — cannot auto-detect from bytes).</param>
+    /// <param name="options">PDF conversion options. Null for defaults.</param>
+    /// <param name="cancellationToken">Cancellation token.</param>
+    /// <returns>Conversion result with diagnostics. PDF bytes are written to <paramref name="output"/>.</returns>
+    /// <remarks>
+    /// Uses <b>buffer IPC</b>. The PDF frame is read from the worker straight into
+    /// <paramref name="output"/> in chunks, with no intermediate array: with a reused or
+    /// pooled writer, a conversion allocates nothing proportional to the PDF size. If the
+    /// worker dies mid-transfer the result fails and <paramref name="output"/> may hold
+    /// part of the PDF. Never coalesced with duplicate conversions.
+    /// </remarks>
+    public async Task<ConversionResult> ConvertAsync(
+        ReadOnlyMemory<byte> input,
+        IBufferWriter<byte> output,
+        DocumentFormat format,
+        ConversionOptions? options = null,
+        CancellationToken cancellationToken = default)
+    {
+        ThrowHelpers.ThrowIfDisposed(_disposed, this);
+        ThrowHelpers.ThrowIfNull(output);
+
+        if (input.IsEmpty)
+            return ConversionResult.Fail(
+                "Input data is empty",
+                SlimLOErrorCode.InvalidArgument, null);
+
+        if (!IsSupportedFormat(format))
+            return InvalidFormatFailureBytes(format, "buffer conversion").AsBase();
+
+        var result = await ConvertBufferCoreAsync<IBufferWriter<byte>>(
+            input, format, options,
+            async (stdout, ct) =>
+                await Protocol.ReadMessageIntoAsync(stdout, output, ct).ConfigureAwait(false) ? output : null,
+            cancellationToken).ConfigureAwait(false);
+        return result.AsBase();
+    }
+
+    /// <summary>
+    /// Convert an in-memory document to PDF bytes held in pooled memory.
+    /// </summary>
+    /// <param name="input">Input document bytes.</param>
+    /// <param name="format">Document format (required — cannot auto-detect from bytes).</param>
+    /// <param name="options">PDF conversion options. Null for defaults.</param>
+    /// <param name="cancellationToken">Cancellation token.</param>
+    /// <returns>
+    /// Conversion result with the PDF in <see cref="ConversionResult{T}.Data"/>; the caller
+    /// must dispose it to return the memory. Data is null if conversion failed.
+    /// </returns>
+    /// <remarks>
+    /// Uses <b>buffer IPC</b>, like <see cref="ConvertAsync(ReadOnlyMemory{byte}, DocumentFormat, ConversionOptions?, CancellationToken)"/>,
+    /// but the PDF is read into an array rented from <see cref="ArrayPool{T}.Shared"/>
+    /// instead of a new <c>byte[]</c>, so PDFs over 85 KB do not each become a
+    /// large-object-heap allocation. Never coalesced with duplicate conversions.
+    /// </remarks>
+    public async Task<ConversionResult<IMemoryOwner<byte>>> ConvertToPooledAsync(
+        ReadOnlyMemory<byte> input,
+        DocumentFormat format,
+        ConversionOptions? options = null,
+        CancellationToken cancellationToken = default)
+    {
+        ThrowHelpers.ThrowIfDisposed(_disposed, this);
+
+        if (input.IsEmpty)
+            return ConversionResult<IMemoryOwner<byte>>.Fail(
+                "Input data is empty",
+                SlimLOErrorCode.InvalidArgument, null);
+
+        if (!IsSupportedFormat(format))
+            return InvalidFormatFailure<IMemoryOwner<byte>>(format, "buffer conversion");
+
+        return await ConvertBufferCoreAsync<IMemoryOwner<byte>>(
+            input, format, options,
+            async (stdout, ct) => await Protocol.ReadPooledMessageAsync(stdout, ct).ConfigureAwait(false),
+            cancellationToken).ConfigureAwait(false);
+    }
+
     /// <summary>
     /// Convert a document stream to PDF, writing to an output stream.
     /// </summary>
@@ -236,19 +371,67 @@ public sealed class PdfConverter : IAsyncDisposable, IDisposable
             return InvalidFormatFailure(format, "stream conversion");
 
         var inputBytes = await ReadStreamToMemoryAsync(input, cancellationToken).ConfigureAwait(false);
-        var result = await ConvertBufferCoreAsync(inputBytes, format, options, cancellationToken)
-            .ConfigureAwait(false);
+        return await ConvertBufferAsync(
+            inputBytes, format, options,
+            pdf => StreamHelpers.WriteAsync(output, pdf, cancellationToken),
+            cancellationToken).ConfigureAwait(false);
+    }
 
-        if (result.Success && result.Data != null)
+    /// <summary>
+    /// Convert a document stream to PDF without holding either document in memory:
+    /// the input is sent to the worker in chunks as it is read, and the PDF is written
+    /// to <paramref name="output"/> in chunks as it arrives.
+    /// </summary>
+    /// <param name="input">Readable stream containing input document bytes.</param>
+    /// <param name="output">Writable stream where PDF bytes will be written.</param>
+    /// <param name="format">Document format (required — cannot auto-detect from a stream).</param>
+    /// <param name="options">PDF conversion options. Null for defaults.</param>
+    /// <param name="cancellationToken">Cancellation token.</param>
+    /// <returns>Conversion result with diagnostics. PDF bytes are written to <paramref name="output"/>.</returns>
+    /// <remarks>
+    /// Uses <b>chunked IPC</b>: at most one chunk of each document is buffered on the .NET
+    /// side, so request and response bodies of any size can be piped between, for example,
+    /// <c>Request.Body</c> and <c>Response.Body</c>. The worker still assembles the whole
+    /// document before loading it. Because the document is not known up front, streamed
+    /// conversions bypass crash quarantine and are never coalesced. If the worker fails
+    /// while sending the PDF, <paramref name="output"/> may already hold part of it. The
+    /// stall timeout starts once the whole input has been sent.
+    /// </remarks>
+    public async Task<ConversionResult> ConvertStreamingAsync(
+        Stream input,
+        Stream output,
+        DocumentFormat format,
+        ConversionOptions? options = null,
+        CancellationToken cancellationToken = default)
+    {
+        ThrowHelpers.ThrowIfDisposed(_disposed, this);
+        ThrowHelpers.ThrowIfNull(input);
+        ThrowHelpers.ThrowIfNull(output);
+
+        if (!input.CanRead)
+            return ConversionResult.Fail("Input stream is not readable",
+                SlimLOErrorCode.InvalidArgument, null);
+        if (!output.CanWrite)
+            return ConversionResult.Fail("Output stream is not writable",
+                SlimLOErrorCode.InvalidArgument, null);
+        if (!IsSupportedFormat(format))
+            return InvalidFormatFailure(format, "stream conversion");
+
+        var request = new ConvertBufferRequest
         {
-#if NET8_0_OR_GREATER
-            await output.WriteAsync(result.Data, cancellationToken).ConfigureAwait(false);
-#else
-            await output.WriteAsync(result.Data, 0, result.Data.Length, cancellationToken).ConfigureAwait(false);
-#endif
-        }
+            Id = Interlocked.Increment(ref _requestId),
+            Format = (int)format,
+            Chunked = true,
+            Options = ConvertRequestOptions.FromConversionOptions(options),
+            Progress = WantsProgress(options),
+            Render = RenderRequestOptions.FromRenderOptions(options?.PageImages),
+            Text = TextRequestOptions.FromTextOptions(options?.PageText)
+        };
 
-        return result.AsBase();
+        return await _pool.ExecuteStreamAsync(
+            request, input, output, options?.Progress,
+            AdmissionQueue.DeadlineAfter(options?.Deadline), options?.Tenant, cancellationToken)
+            .ConfigureAwait(false);
     }
 
     /// <summary>
@@ -283,21 +466,10 @@ public sealed class PdfConverter : IAsyncDisposable, IDisposable
             return InvalidFormatFailure(format, "stream conversion");
 
         var inputBytes = await ReadStreamToMemoryAsync(input, cancellationToken).ConfigureAwait(false);
-        var result = await ConvertBufferCoreAsync(inputBytes, format, options, cancellationToken)
-            .ConfigureAwait(false);
-
-        if (result.Success && result.Data != null)
-        {
-#if NET8_0_OR_GREATER
-            await File.WriteAllBytesAsync(outputPath, result.Data, cancellationToken)
-                .ConfigureAwait(false);
-#else
-            await Task.Run(() => File.WriteAllBytes(outputPath, result.Data), cancellationToken)
-                .ConfigureAwait(false);
-#endif
-        }
-
-        return result.AsBase();
+        return await ConvertBufferAsync(
+            inputBytes, format, options,
+            pdf => WriteFileAsync(outputPath, pdf, cancellationToken),
+            cancellationToken).ConfigureAwait(false);
     }
 
     /// <summary>
@@ -346,21 +518,299 @@ public sealed class PdfConverter : IAsyncDisposable, IDisposable
         var inputBytes = await Task.Run(() => File.ReadAllBytes(inputPath), cancellationToken)
             .ConfigureAwait(false);
 #endif
-        var result = await ConvertBufferCoreAsync(inputBytes, format, options, cancellationToken)
-            .ConfigureAwait(false);
+        return await ConvertBufferAsync(
+            inputBytes, format, options,
+            pdf => StreamHelpers.WriteAsync(output, pdf, cancellationToken),
+            cancellationToken).ConfigureAwait(false);
+    }
+
+    /// <summary>
+    /// Convert several documents, in order, into a single PDF.
+    /// </summary>
+    /// <param name="parts">Input documents (.docx only), with optional bookmark titles.</param>
+    /// <param name="outputPath">Path for output PDF file.</param>
+    /// <param name="options">PDF conversion options, applied to the combined document. Null for defaults.</param>
+    /// <param name="cancellationToken">Cancellation token.</param>
+    /// <returns>Conversion result with diagnostics.</returns>
+    /// <remarks>
+    /// The parts are loaded into one document on one worker and exported once, so fonts
+    /// and shared images are embedded once instead of once per part, and there is no
+    /// separate merge step. Each part starts on a new page; the first part provides the
+    /// styles and page setup. A part with a <see cref="CombinePart.Bookmark"/> gets a
+    /// top-level PDF outline entry. <see cref="ConversionOptions.PageRange"/>, page images
+    /// and page text refer to pages of the combined document.
+    /// Uses <b>file-path IPC</b>.
+    /// </remarks>
+    public async Task<ConversionResult> CombineAsync(
+        IReadOnlyList<CombinePart> parts,
+        string outputPath,
+        ConversionOptions? options = null,
+        CancellationToken cancellationToken = default)
+    {
+        ThrowHelpers.ThrowIfDisposed(_disposed, this);
+        ThrowHelpers.ThrowIfNull(parts);
+        ThrowHelpers.ThrowIfNullOrEmpty(outputPath);
+
+        if (parts.Count == 0)
+            return ConversionResult.Fail("At least one part is required",
+                SlimLOErrorCode.InvalidArgument, null);
 
-        if (result.Success && result.Data != null)
+        var inputs = new CombineRequestPart[parts.Count];
+        for (int i = 0; i < parts.Count; i++)
         {
-#if NET8_0_OR_GREATER
-            await output.WriteAsync(result.Data, cancellationToken).ConfigureAwait(false);
-#else
-            await output.WriteAsync(result.Data, 0, result.Data.Length, cancellationToken).ConfigureAwait(false);
-#endif
+            var part = parts[i];
+            if (part is null || string.IsNullOrEmpty(part.InputPath))
+                return ConversionResult.Fail($"Part {i + 1}: input path is required",
+                    SlimLOErrorCode.InvalidArgument, null);
+
+            var inputPath = Path.GetFullPath(part.InputPath);
+            if (!File.Exists(inputPath))
+                return ConversionResult.Fail(
+                    $"Part {i + 1}: input file not found: {inputPath}",
+                    SlimLOErrorCode.FileNotFound, null);
+
+            var format = DetectFormat(inputPath);
+            if (!IsSupportedFormat(format))
+                return InvalidFormatFailure(format, $"part {i + 1} of a combined conversion");
+
+            inputs[i] = new CombineRequestPart { Input = inputPath, Bookmark = part.Bookmark };
         }
 
-        return result.AsBase();
+        var request = new ConvertRequest
+        {
+            Id = Interlocked.Increment(ref _requestId),
+            Inputs = inputs,
+            Output = Path.GetFullPath(outputPath),
+            Format = (int)DocumentFormat.Docx,
+            Options = ConvertRequestOptions.FromConversionOptions(options),
+            Progress = WantsProgress(options),
+            Render = RenderRequestOptions.FromRenderOptions(options?.PageImages),
+            Text = TextRequestOptions.FromTextOptions(options?.PageText)
+        };
+
+        return await _pool.ExecuteAsync(
+            request, options?.Progress,
+            AdmissionQueue.DeadlineAfter(options?.Deadline), options?.Tenant, cancellationToken)
+            .ConfigureAwait(false);
+    }
+
+    /// <summary>
+    /// Read document metadata — page count, page sizes, sections, images and fonts —
+    /// without exporting a PDF.
+    /// </summary>
+    /// <param name="inputPath">Path to input document (.docx only).</param>
+    /// <param name="cancellationToken">Cancellation token.</param>
+    /// <returns>
+    /// Result with the metadata in <see cref="ConversionResult{T}.Data"/>.
+    /// Data is null if the document could not be loaded.
+    /// </returns>
+    /// <remarks>
+    /// The worker loads the document and finishes layout, then stops: no PDF export runs,
+    /// so this costs a fraction of a conversion. Useful for quotas, routing and preflight
+    /// checks (e.g. rejecting documents with <see cref="DocumentInfo.MissingFonts"/>).
+    /// Uses <b>file-path IPC</b>.
+    /// </remarks>
+    public async Task<ConversionResult<DocumentInfo>> GetDocumentInfoAsync(
+        string inputPath,
+        CancellationToken cancellationToken = default)
+    {
+        ThrowHelpers.ThrowIfDisposed(_disposed, this);
+        ThrowHelpers.ThrowIfNullOrEmpty(inputPath);
+
+        inputPath = Path.GetFullPath(inputPath);
+
+        if (!File.Exists(inputPath))
+            return ConversionResult<DocumentInfo>.Fail(
+                $"Input file not found: {inputPath}",
+                SlimLOErrorCode.FileNotFound, null);
+
+        var format = DetectFormat(inputPath);
+        if (!IsSupportedFormat(format))
+            return ConversionResult<DocumentInfo>.Fail(
+                InvalidFormatFailure(format, "document info").ErrorMessage!,
+                SlimLOErrorCode.InvalidFormat, null);
+
+        var request = new InfoRequest
+        {
+            Id = Interlocked.Increment(ref _requestId),
+            Input = inputPath,
+            Format = (int)format
+        };
+
+        return await _pool.ExecuteInfoAsync(request, null, cancellationToken)
+            .ConfigureAwait(false);
+    }
+
+    /// <summary>
+    /// Read metadata of an in-memory document without exporting a PDF.
+    /// </summary>
+    /// <param name="input">Input document bytes.</param>
+    /// <param name="format">Document format (required — cannot auto-detect from bytes).</param>
+    /// <param name="cancellationToken">Cancellation token.</param>
+    /// <returns>Result with the metadata in <see cref="ConversionResult{T}.Data"/>.</returns>
+    /// <remarks>Uses <b>buffer IPC</b>: the document bytes are sent as a binary frame.</remarks>
+    public async Task<ConversionResult<DocumentInfo>> GetDocumentInfoAsync(
+        ReadOnlyMemory<byte> input,
+        DocumentFormat format,
+        CancellationToken cancellationToken = default)
+    {
+        ThrowHelpers.ThrowIfDisposed(_disposed, this);
+
+        if (input.IsEmpty)
+            return ConversionResult<DocumentInfo>.Fail(
+                "Input data is empty",
+                SlimLOErrorCode.InvalidArgument, null);
+
+        if (!IsSupportedFormat(format))
+            return InvalidFormatFailure<DocumentInfo>(format, "document info");
+
+        var request = new InfoRequest
+        {
+            Id = Interlocked.Increment(ref _requestId),
+            Format = (int)format,
+            DataSize = input.Length
+        };
+
+        return await _pool.ExecuteInfoAsync(request, input, cancellationToken)
+            .ConfigureAwait(false);
     }
 
+    /// <summary>
+    /// Render document pages to images without exporting a PDF.
+    /// </summary>
+    /// <param name="inputPath">Path to input document (.docx only).</param>
+    /// <param name="options">Format, width and pages. Null = 256 px PNG of the first page.</param>
+    /// <param name="cancellationToken">Cancellation token.</param>
+    /// <returns>Result with the images in <see cref="ConversionResult.PageImages"/>.</returns>
+    /// <remarks>
+    /// Pages are painted by LibreOffice from the loaded document, so no PDF rasterizer
+    /// is needed. To get a thumbnail and the PDF from one load, set
+    /// <see cref="ConversionOptions.PageImages"/> on a conversion instead.
+    /// Uses <b>file-path IPC</b>.
+    /// </remarks>
+    public async Task<ConversionResult> RenderPagesAsync(
+        string inputPath,
+        RenderOptions? options = null,
+        CancellationToken cancellationToken = default)
+    {
+        ThrowHelpers.ThrowIfDisposed(_disposed, this);
+        ThrowHelpers.ThrowIfNullOrEmpty(inputPath);
+
+        inputPath = Path.GetFullPath(inputPath);
+
+        if (!File.Exists(inputPath))
+            return ConversionResult.Fail(
+                $"Input file not found: {inputPath}",
+                SlimLOErrorCode.FileNotFound, null);
+
+        var format = DetectFormat(inputPath);
+        if (!IsSupportedFormat(format))
+            return InvalidFormatFailure(format, "page rendering");
+
+        var request = new RenderRequest
+        {
+            Id = Interlocked.Increment(ref _requestId),
+            Input = inputPath,
+            Format = (int)format,
+            Render = RenderRequestOptions.FromRenderOptions(options)
+        };
+
+        return await _pool.ExecuteRenderAsync(request, null, cancellationToken)
+            .ConfigureAwait(false);
+    }
+
+    /// <summary>
+    /// Render pages of an in-memory document to images without exporting a PDF.
+    /// </summary>
+    /// <param name="input">Input document bytes.</param>
+    /// <param name="format">Document format (required — cannot auto-detect from bytes).</param>
+    /// <param name="options">Format, width and pages. Null = 256 px PNG of the first page.</param>
+    /// <param name="cancellationToken">Cancellation token.</param>
+    /// <returns>Result with the images in <see cref="ConversionResult.PageImages"/>.</returns>
+    /// <remarks>Uses <b>buffer IPC</b>: the document bytes are sent as a binary frame.</remarks>
+    public async Task<ConversionResult> RenderPagesAsync(
+        ReadOnlyMemory<byte> input,
+        DocumentFormat format,
+        RenderOptions? options = null,
+        CancellationToken cancellationToken = default)
+    {
+        ThrowHelpers.ThrowIfDisposed(_disposed, this);
+
+        if (input.IsEmpty)
+            return ConversionResult.Fail(
+                "Input data is empty",
+                SlimLOErrorCode.InvalidArgument, null);
+
+        if (!IsSupportedFormat(format))
+            return InvalidFormatFailure(format, "page rendering");
+
+        var request = new RenderRequest
+        {
+            Id = Interlocked.Increment(ref _requestId),
+            Format = (int)format,
+            DataSize = input.Length,
+            Render = RenderRequestOptions.FromRenderOptions(options)
+        };
+
+        return await _pool.ExecuteRenderAsync(request, input, cancellationToken)
+            .ConfigureAwait(false);
+    }
+
+    /// <summary>
+    /// Register a font directory with the running converter, without restarting
+    /// workers. Live workers register its fonts after the conversion they are
+    /// running (if any); workers started later get it with
+    /// <see cref="PdfConverterOptions.FontDirectories"/>. Only LibreOffice's font
+    /// lists and caches are rebuilt, and adding a directory twice is a no-op.
+    /// </summary>
+    /// <param name="fontDirectory">Directory of .ttf/.otf/.ttc/.otc files (subdirectories included).</param>
+    /// <param name="cancellationToken">Cancellation token.</param>
+    /// <returns>
+    /// Success, or the first failure reported by a worker. With a
+    /// <see cref="PdfConverterOptions.ServerSocket"/>, the server applies the
+    /// directory to all of its workers.
+    /// </returns>
+    public async Task<ConversionResult> AddFontDirectoryAsync(
+        string fontDirectory,
+        CancellationToken cancellationToken = default)
+    {
+        ThrowHelpers.ThrowIfDisposed(_disposed, this);
+        ThrowHelpers.ThrowIfNullOrEmpty(fontDirectory);
+
+        fontDirectory = Path.GetFullPath(fontDirectory);
+        if (!Directory.Exists(fontDirectory))
+            return ConversionResult.Fail(
+                $"Font directory not found: {fontDirectory}",
+                SlimLOErrorCode.FileNotFound, null);
+
+        return await _pool.AddFontDirectoryAsync(fontDirectory, cancellationToken)
+            .ConfigureAwait(false);
+    }
+
+    /// <summary>
+    /// Requests currently waiting for a worker. A load balancer can back off
+    /// from a node whose queue keeps growing.
+    /// </summary>
+    public int QueueLength => _pool.QueueLength;
+
+    /// <summary>
+    /// Requests rejected so far with <see cref="SlimLOErrorCode.DeadlineExceeded"/>
+    /// because they could not finish before their <see cref="ConversionOptions.Deadline"/>.
+    /// </summary>
+    public long ShedCount => _pool.ShedCount;
+
+    /// <summary>
+    /// Conversions that shared the result of an identical one already in flight
+    /// (see <see cref="PdfConverterOptions.CoalesceDuplicates"/>).
+    /// </summary>
+    public long CoalescedCount => _pool.CoalescedCount;
+
+    /// <summary>
+    /// Worker processes currently running or starting, between
+    /// <see cref="PdfConverterOptions.MinWorkers"/> and <see cref="PdfConverterOptions.MaxWorkers"/>.
+    /// </summary>
+    public int WorkerCount => _pool.WorkerCount;
+
     /// <summary>
     /// Get the SlimLO library version string.
     /// Falls back to native in-process call if no workers are running.
@@ -396,7 +846,7 @@ public sealed class PdfConverter : IAsyncDisposable, IDisposable
         _pool.DisposeAsync().AsTask().GetAwaiter().GetResult();
     }
 
-    private static DocumentFormat DetectFormat(string path)
+    internal static DocumentFormat DetectFormat(string path)
     {
         var ext = Path.GetExtension(path);
         return ext?.ToLowerInvariant() switch
@@ -408,10 +858,10 @@ public sealed class PdfConverter : IAsyncDisposable, IDisposable
         };
     }
 
-    private static bool IsSupportedFormat(DocumentFormat format) =>
+    internal static bool IsSupportedFormat(DocumentFormat format) =>
         format == DocumentFormat.Docx;
 
-    private static ConversionResult InvalidFormatFailure(DocumentFormat format, string context)
+    internal static ConversionResult InvalidFormatFailure(DocumentFormat format, string context)
     {
         var message = format switch
         {
@@ -424,7 +874,10 @@ public sealed class PdfConverter : IAsyncDisposable, IDisposable
         return ConversionResult.Fail(message, SlimLOErrorCode.InvalidFormat, null);
     }
 
-    private static ConversionResult<byte[]> InvalidFormatFailureBytes(DocumentFormat format, string context)
+    private static ConversionResult<byte[]> InvalidFormatFailureBytes(DocumentFormat format, string context) =>
+        InvalidFormatFailure<byte[]>(format, context);
+
+    internal static ConversionResult<T> InvalidFormatFailure<T>(DocumentFormat format, string context)
     {
         var message = format switch
         {
@@ -434,7 +887,7 @@ public sealed class PdfConverter : IAsyncDisposable, IDisposable
                 $"Unsupported format '{format}' for {context}. SlimLO currently supports DOCX (.docx) only."
         };
 
-        return ConversionResult<byte[]>.Fail(message, SlimLOErrorCode.InvalidFormat, null);
+        return ConversionResult<T>.Fail(message, SlimLOErrorCode.InvalidFormat, null);
     }
 
     /// <summary>Core buffer conversion via binary IPC (no temp files).</summary>
@@ -450,12 +903,85 @@ public sealed class PdfConverter : IAsyncDisposable, IDisposable
             Id = requestId,
             Format = (int)format,
             DataSize = input.Length,
-            Options = ConvertRequestOptions.FromConversionOptions(options)
+            Options = ConvertRequestOptions.FromConversionOptions(options),
+            Progress = WantsProgress(options),
+            Render = RenderRequestOptions.FromRenderOptions(options?.PageImages),
+            Text = TextRequestOptions.FromTextOptions(options?.PageText)
+        };
+
+        return await _pool.ExecuteBufferAsync(
+            request, input, options?.Progress,
+            AdmissionQueue.DeadlineAfter(options?.Deadline), options?.Tenant, ct)
+            .ConfigureAwait(false);
+    }
+
+    /// <summary>Buffer conversion whose PDF frame is consumed by <paramref name="readOutput"/>.</summary>
+    private async Task<ConversionResult<T>> ConvertBufferCoreAsync<T>(
+        ReadOnlyMemory<byte> input,
+        DocumentFormat format,
+        ConversionOptions? options,
+        Func<Stream, CancellationToken, Task<T?>> readOutput,
+        CancellationToken ct)
+        where T : class
+    {
+        var requestId = Interlocked.Increment(ref _requestId);
+        var request = new ConvertBufferRequest
+        {
+            Id = requestId,
+            Format = (int)format,
+            DataSize = input.Length,
+            Options = ConvertRequestOptions.FromConversionOptions(options),
+            Progress = WantsProgress(options),
+            Render = RenderRequestOptions.FromRenderOptions(options?.PageImages),
+            Text = TextRequestOptions.FromTextOptions(options?.PageText)
         };
 
-        return await _pool.ExecuteBufferAsync(request, input, ct).ConfigureAwait(false);
+        return await _pool.ExecuteBufferAsync(
+            request, input, options?.Progress, readOutput,
+            AdmissionQueue.DeadlineAfter(options?.Deadline), options?.Tenant, ct)
+            .ConfigureAwait(false);
+    }
+
+    /// <summary>
+    /// Buffer conversion whose PDF is handed to <paramref name="writePdf"/> on success.
+    /// The PDF is read into pooled memory, so it never becomes a large-object-heap array,
+    /// unless duplicates are coalesced, which needs a result the callers can share.
+    /// </summary>
+    private async Task<ConversionResult> ConvertBufferAsync(
+        ReadOnlyMemory<byte> input,
+        DocumentFormat format,
+        ConversionOptions? options,
+        Func<ReadOnlyMemory<byte>, Task> writePdf,
+        CancellationToken ct)
+    {
+        if (_pool.CoalescesDuplicates)
+        {
+            var shared = await ConvertBufferCoreAsync(input, format, options, ct).ConfigureAwait(false);
+            if (shared.Success && shared.Data != null)
+                await writePdf(shared.Data).ConfigureAwait(false);
+            return shared.AsBase();
+        }
+
+        var result = await ConvertBufferCoreAsync<PooledBuffer>(
+            input, format, options, Protocol.ReadPooledMessageAsync, ct).ConfigureAwait(false);
+        using (result.Data)
+        {
+            if (result.Success && result.Data != null)
+                await writePdf(result.Data.Memory).ConfigureAwait(false);
+        }
+        return result.AsBase();
     }
 
+    private static async Task WriteFileAsync(string path, ReadOnlyMemory<byte> data, CancellationToken ct)
+    {
+        using var file = new FileStream(path, FileMode.Create, FileAccess.Write, FileShare.None, 4096, useAsync: true);
+        await StreamHelpers.WriteAsync(file, data, ct).ConfigureAwait(false);
+    }
+
+    /// <summary>Progress frames are needed for a caller's IProgress or for stall detection.</summary>
+    private bool WantsProgress(ConversionOptions? options) =>
+        options?.Progress != null || _pool.StallTimeout != null;
+
     private static async Task<ReadOnlyMemory<byte>> ReadStreamToMemoryAsync(
         Stream stream, CancellationToken ct)
     {
@@ -30,6 +30,15 @@ public sealed class PdfConverterOptions
     /// </summary>
     public TimeSpan ConversionTimeout { get; init; } = TimeSpan.FromMinutes(5);
 
+    /// <summary>
+    /// Maximum time a conversion may go without reporting progress.
+    /// When set, workers stream progress for every conversion and a worker
+    /// that stays silent for this long is killed, so a slow but advancing
+    /// conversion is told apart from a hung one. <see cref="ConversionTimeout"/>
+    /// still caps the total time. Null (default) = no stall detection.
+    /// </summary>
+    public TimeSpan? StallTimeout { get; init; }
+
     /// <summary>
     /// Maximum number of worker processes. Each worker can handle one
     /// conversion at a time. More workers = more parallel conversions,
@@ -37,6 +46,57 @@ public sealed class PdfConverterOptions
     /// </summary>
     public int MaxWorkers { get; init; } = 1;
 
+    /// <summary>
+    /// Worker processes kept running through quiet periods when
+    /// <see cref="IdleTimeout"/> is set; also the number <see cref="WarmUp"/>
+    /// starts, if non-zero. Between this and <see cref="MaxWorkers"/> the pool
+    /// grows with demand, starting spare workers ahead of a rising request rate.
+    /// Default: 0.
+    /// </summary>
+    public int MinWorkers { get; init; }
+
+    /// <summary>
+    /// Stop a worker that has been idle this long, down to <see cref="MinWorkers"/>,
+    /// so quiet periods give its memory back. Null (default) = workers run until
+    /// the converter is disposed.
+    /// </summary>
+    public TimeSpan? IdleTimeout { get; init; }
+
+    /// <summary>
+    /// Memory in bytes the pool may fill before it stops starting workers beyond
+    /// <see cref="MinWorkers"/>; requests then wait for a running worker. Measured
+    /// against the usage of this process's control group. Null (default) = the
+    /// cgroup memory limit, if one is set.
+    /// </summary>
+    public long? MemoryBudget { get; init; }
+
+    /// <summary>
+    /// Thread budget for LibreOffice's internal pools in each worker (threaded XML
+    /// parsing, parallel rendering work). 0 (default) = one thread per core, which
+    /// oversubscribes the CPU once several workers run; set it to roughly
+    /// cores / <see cref="MaxWorkers"/>. 1 = single-threaded workers.
+    /// </summary>
+    public int ThreadsPerWorker { get; init; }
+
+    /// <summary>
+    /// CPU placement of pool workers. <see cref="WorkerPlacement.Pinned"/> gives each
+    /// worker its own share of the CPUs within one NUMA node, with node-local memory,
+    /// so the OS does not migrate its working set between cores and sockets; a pinned
+    /// worker's <see cref="ThreadsPerWorker"/> defaults to the size of its share.
+    /// Applied on Linux and Windows. Default: <see cref="WorkerPlacement.None"/>.
+    /// </summary>
+    public WorkerPlacement WorkerPlacement { get; init; }
+
+    /// <summary>
+    /// Unix socket of a running <c>slimlo_server</c> to convert on instead of starting
+    /// private workers, so every converter on the host shares the server's warm pool.
+    /// Each of <see cref="MaxWorkers"/> becomes a connection; the server's resource path,
+    /// fonts, thread budget and placement apply, and <see cref="MemoryBudget"/> is not
+    /// enforced. File-path conversions need paths the server can read and write.
+    /// Requires .NET 8 or later. Null (default) = start private workers.
+    /// </summary>
+    public string? ServerSocket { get; init; }
+
     /// <summary>
     /// Recycle a worker process after this many conversions to prevent
     /// memory leaks from accumulating. 0 = never recycle. Default: 0.
@@ -44,9 +104,59 @@ public sealed class PdfConverterOptions
     public int MaxConversionsPerWorker { get; init; }
 
     /// <summary>
-    /// If true, start worker processes eagerly during Create().
+    /// If true, start worker processes eagerly during Create(): <see cref="MinWorkers"/>
+    /// of them, or <see cref="MaxWorkers"/> when no minimum is set.
     /// If false (default), workers start lazily on first conversion.
     /// </summary>
     public bool WarmUp { get; init; }
 
+    /// <summary>
+    /// Refuse a document once it has crashed a worker process this many times.
+    /// Documents are identified by a SHA-256 of their content, so retries and
+    /// duplicate submissions of the same file are caught; a refused conversion
+    /// fails with <see cref="SlimLOErrorCode.Quarantined"/> without touching a
+    /// worker. 0 = disabled. Default: 2.
+    /// </summary>
+    public int QuarantineAfterCrashes { get; init; } = 2;
+
+    /// <summary>
+    /// Maximum number of crashing documents remembered for
+    /// <see cref="QuarantineAfterCrashes"/>; the least recently seen are
+    /// forgotten first. Default: 1024.
+    /// </summary>
+    public int QuarantineCapacity { get; init; } = 1024;
+
+    /// <summary>
+    /// If true, a document that already crashed a worker is retried on a
+    /// dedicated extra worker process instead of a pool worker, so a second
+    /// crash does not cost a warm worker. Default: false.
+    /// </summary>
+    public bool IsolateSuspectDocuments { get; init; }
+
+    /// <summary>
+    /// Relative worker shares of tenants (<see cref="ConversionOptions.Tenant"/>) while
+    /// several have conversions waiting: a tenant of weight 3 is admitted three times
+    /// as often as one of weight 1. Tenants not listed, including the default tenant
+    /// (key ""), weigh 1. Null (default) = all tenants equal.
+    /// </summary>
+    public IReadOnlyDictionary<string, int>? TenantWeights { get; init; }
+
+    /// <summary>
+    /// Maximum number of workers one tenant may occupy at once, so a bulk tenant
+    /// always leaves room for the others; its further conversions wait even when
+    /// workers are idle. 0 (default) = no cap.
+    /// </summary>
+    public int MaxWorkersPerTenant { get; init; }
+
+    /// <summary>
+    /// If true, a conversion identical to one already in flight (same document
+    /// bytes, or same input file, size and modification time with the same output
+    /// path, plus the same options) waits for that conversion instead of running
+    /// again, and receives its result. Useful when retries or fan-out submit the
+    /// same document many times at once. Only the first caller gets progress
+    /// reports; buffer results are shared between callers, not copied.
+    /// Default: false.
+    /// </summary>
+    public bool CoalesceDuplicates { get; init; }
+
 }
@@ -0,0 +1,22 @@
+namespace SlimLO;
+
+/// <summary>
+/// Options for rendering document pages to images.
+/// </summary>
+public sealed class RenderOptions
+{
+    /// <summary>Output format. Default: PNG.</summary>
+    public PageImageFormat Format { get; init; } = PageImageFormat.Png;
+
+    /// <summary>
+    /// Image width in pixels, 1-8192. 0 = default (256). The height follows the
+    /// page's aspect ratio.
+    /// </summary>
+    public int Width { get; init; }
+
+    /// <summary>
+    /// Pages to render, e.g. "1", "1-3,5" or "2-". Null = first page.
+    /// Pages past the end of the document are skipped.
+    /// </summary>
+    public string? PageRange { get; init; }
+}
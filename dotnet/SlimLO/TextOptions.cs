@@ -0,0 +1,16 @@
+namespace SlimLO;
+
+/// <summary>
+/// Options for extracting page text alongside a conversion.
+/// </summary>
+public sealed class TextOptions
+{
+    /// <summary>Also report a bounding box for every word. Default: false.</summary>
+    public bool IncludeWords { get; init; }
+
+    /// <summary>
+    /// Pages to extract, e.g. "1", "1-3,5" or "2-". Null = all pages.
+    /// Pages past the end of the document are skipped.
+    /// </summary>
+    public string? PageRange { get; init; }
+}
@@ -0,0 +1,66 @@
+package com.slimlo.benchmarks;
+
+import com.slimlo.ConversionResult;
+import com.slimlo.DocumentFormat;
+import com.slimlo.PdfConverter;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Per-request SDK cost on one worker. Run with SLIMLO_SIMULATE=latency=0 so
+ * the time measured is dispatch, framing and result handling alone, and with
+ * {@code -prof gc} for allocations per request.
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+public class SimulatedOverheadBenchmark {
+
+    private byte[] docx;
+    private PdfConverter converter;
+    private ByteArrayOutputStream output;
+
+    @Setup
+    public void setup() throws Exception {
+        docx = Simulation.document(16 * 1024);
+        converter = Simulation.createConverter(1);
+        output = new ByteArrayOutputStream();
+        converter.convert(docx, DocumentFormat.DOCX).throwIfFailed();
+    }
+
+    @TearDown
+    public void tearDown() {
+        converter.close();
+    }
+
+    @Benchmark
+    public int bytes() {
+        ConversionResult result = converter.convert(docx, DocumentFormat.DOCX);
+        return result.getData().length;
+    }
+
+    /** Into a reused stream: nothing allocated in proportion to the PDF. */
+    @Benchmark
+    public int stream() {
+        output.reset();
+        converter.convert(new ByteArrayInputStream(docx), output, DocumentFormat.DOCX).throwIfFailed();
+        return output.size();
+    }
+}
@@ -0,0 +1,88 @@
+package com.slimlo.benchmarks;
+
+import com.slimlo.DocumentFormat;
+import com.slimlo.PdfConverter;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OperationsPerInvocation;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Pool throughput: a fixed batch of requests from 1 to 256 concurrent callers
+ * (one thread each) against a fixed pool. Reported time is per request; with
+ * simulated latency, ideal scaling levels off at latency / workers once
+ * callers outnumber workers, and anything above that is queueing and dispatch
+ * cost. Pool size is SLIMLO_BENCH_WORKERS (default 4).
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+public class SimulatedPoolBenchmark {
+
+    private static final int REQUESTS = 256;
+
+    @Param({"1", "4", "16", "64", "256"})
+    public int callers;
+
+    private byte[] docx;
+    private PdfConverter converter;
+    private ExecutorService threads;
+
+    @Setup
+    public void setup() throws Exception {
+        String workers = System.getenv("SLIMLO_BENCH_WORKERS");
+        docx = Simulation.document(16 * 1024);
+        converter = Simulation.createConverter(workers != null ? Integer.parseInt(workers) : 4);
+        threads = Executors.newFixedThreadPool(callers);
+        converter.convert(docx, DocumentFormat.DOCX).throwIfFailed();
+    }
+
+    @TearDown
+    public void tearDown() {
+        threads.shutdownNow();
+        converter.close();
+    }
+
+    @Benchmark
+    @OperationsPerInvocation(REQUESTS)
+    public void throughput() throws Exception {
+        List<Future<Void>> pending = new ArrayList<Future<Void>>(callers);
+        for (int i = 0; i < callers; i++) {
+            // Spread the batch: the first REQUESTS % callers callers take one more
+            final int count = REQUESTS / callers + (i < REQUESTS % callers ? 1 : 0);
+            pending.add(threads.submit(new Callable<Void>() {
+                @Override
+                public Void call() {
+                    for (int n = 0; n < count; n++) {
+                        converter.convert(docx, DocumentFormat.DOCX).throwIfFailed();
+                    }
+                    return null;
+                }
+            }));
+        }
+        for (Future<Void> future : pending) {
+            future.get();
+        }
+    }
+}
@@ -0,0 +1,47 @@
+package com.slimlo.benchmarks;
+
+import com.slimlo.PdfConverter;
+import com.slimlo.PdfConverterOptions;
+
+import java.io.FileNotFoundException;
+import java.util.Random;
+
+/**
+ * Converters backed by simulated workers: slimlo_worker with SLIMLO_SIMULATE
+ * set speaks the full worker protocol with no LibreOffice behind it, so these
+ * suites run without a LibreOffice build and measure the SDK rather than the
+ * conversion.
+ *
+ * <p>Workers inherit the JVM's environment, which Java cannot change, so
+ * SLIMLO_SIMULATE must be set when the benchmarks are started (JMH forks
+ * inherit it).
+ */
+final class Simulation {
+
+    private Simulation() {
+    }
+
+    static PdfConverter createConverter(int workers) throws FileNotFoundException {
+        String spec = System.getenv("SLIMLO_SIMULATE");
+        if (spec == null || spec.isEmpty()) {
+            throw new IllegalStateException(
+                    "Set SLIMLO_SIMULATE (e.g. \"latency=0\") to benchmark against simulated workers");
+        }
+
+        // The simulated worker never opens the resource directory
+        String resourcePath = System.getenv("SLIMLO_RESOURCE_PATH");
+        return PdfConverter.create(PdfConverterOptions.builder()
+                .resourcePath(resourcePath != null ? resourcePath : System.getProperty("java.io.tmpdir"))
+                .maxWorkers(workers)
+                .minWorkers(workers)
+                .warmUp(true)
+                .build());
+    }
+
+    /** Input bytes; the simulated worker only needs them to be non-empty. */
+    static byte[] document(int size) {
+        byte[] data = new byte[size];
+        new Random(42).nextBytes(data);
+        return data;
+    }
+}
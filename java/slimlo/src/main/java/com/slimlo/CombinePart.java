@@ -0,0 +1,35 @@
+package com.slimlo;
+
+/**
+ * One input of {@link PdfConverter#combine(java.util.List, String, ConversionOptions)}.
+ */
+public final class CombinePart {
+
+    private final String inputPath;
+    private final String bookmark;
+
+    /**
+     * @param inputPath path to the input document (.docx).
+     * @param bookmark  title of a top-level PDF outline entry pointing at the start of
+     *                  this part, with the part's own headings nested below it; null for none.
+     */
+    public CombinePart(String inputPath, String bookmark) {
+        this.inputPath = inputPath;
+        this.bookmark = bookmark;
+    }
+
+    /** A part without an outline entry. */
+    public CombinePart(String inputPath) {
+        this(inputPath, null);
+    }
+
+    /** Path to the input document. */
+    public String getInputPath() {
+        return inputPath;
+    }
+
+    /** Title of the part's PDF outline entry, or null. */
+    public String getBookmark() {
+        return bookmark;
+    }
+}
@@ -0,0 +1,75 @@
+package com.slimlo;
+
+/**
+ * Timings and sizes of one conversion, as measured by the worker.
+ * Delivered to the {@link MetricsListener} set on {@link PdfConverterOptions}.
+ */
+public final class ConversionMetrics {
+
+    private final boolean success;
+    private final double loadMillis;
+    private final double exportMillis;
+    private final double totalMillis;
+    private final long inputBytes;
+    private final long outputBytes;
+    private final int fontFallbacks;
+
+    public ConversionMetrics(
+            boolean success,
+            double loadMillis,
+            double exportMillis,
+            double totalMillis,
+            long inputBytes,
+            long outputBytes,
+            int fontFallbacks) {
+        this.success = success;
+        this.loadMillis = loadMillis;
+        this.exportMillis = exportMillis;
+        this.totalMillis = totalMillis;
+        this.inputBytes = inputBytes;
+        this.outputBytes = outputBytes;
+        this.fontFallbacks = fontFallbacks;
+    }
+
+    /** Whether the conversion succeeded. */
+    public boolean isSuccess() {
+        return success;
+    }
+
+    /** Time spent loading and laying out the document (all parts, for combine). */
+    public double getLoadMillis() {
+        return loadMillis;
+    }
+
+    /** Time spent exporting the PDF and any page images or text. */
+    public double getExportMillis() {
+        return exportMillis;
+    }
+
+    /** Worker time for the whole conversion. */
+    public double getTotalMillis() {
+        return totalMillis;
+    }
+
+    /** Size of the document(s) converted. */
+    public long getInputBytes() {
+        return inputBytes;
+    }
+
+    /** Size of the PDF produced. 0 on failure. */
+    public long getOutputBytes() {
+        return outputBytes;
+    }
+
+    /** Font diagnostics: fonts substituted or not found. */
+    public int getFontFallbacks() {
+        return fontFallbacks;
+    }
+
+    @Override
+    public String toString() {
+        return (success ? "ok" : "failed") + " load " + loadMillis + " ms, export " + exportMillis
+                + " ms, total " + totalMillis + " ms, " + inputBytes + " -> " + outputBytes + " bytes, "
+                + fontFallbacks + " font fallback(s)";
+    }
+}
@@ -1,25 +1,54 @@
 package com.slimlo;
 
+import java.util.Collections;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.concurrent.TimeUnit;
+
 /**
  * Options for a single PDF conversion operation.
  * Use {@link #builder()} to create instances.
  */
 public final class ConversionOptions {
 
+    private final PdfPreset preset;
     private final PdfVersion pdfVersion;
     private final int jpegQuality;
     private final int dpi;
     private final boolean taggedPdf;
     private final String pageRange;
+    private final boolean lazyLayout;
+    private final boolean skipFieldUpdate;
+    private final long deadlineMillis;
+    private final String tenant;
     private final String password;
+    private final Map<String, String> filterProperties;
+    private final ProgressListener progressListener;
+    private final RenderOptions pageImages;
+    private final TextOptions pageText;
 
     private ConversionOptions(Builder builder) {
+        this.preset = builder.preset;
         this.pdfVersion = builder.pdfVersion;
         this.jpegQuality = builder.jpegQuality;
         this.dpi = builder.dpi;
         this.taggedPdf = builder.taggedPdf;
         this.pageRange = builder.pageRange;
+        this.lazyLayout = builder.lazyLayout;
+        this.skipFieldUpdate = builder.skipFieldUpdate;
+        this.deadlineMillis = builder.deadlineMillis;
+        this.tenant = builder.tenant;
         this.password = builder.password;
+        this.filterProperties = Collections.unmodifiableMap(
+                new LinkedHashMap<String, String>(builder.filterProperties));
+        this.progressListener = builder.progressListener;
+        this.pageImages = builder.pageImages;
+        this.pageText = builder.pageText;
+    }
+
+    /** Export preset applied before the explicit options. Default: none. */
+    public PdfPreset getPreset() {
+        return preset;
     }
 
     /** PDF version for the output. Default: PDF 1.7. */
@@ -47,25 +76,113 @@ public final class ConversionOptions {
         return pageRange;
     }
 
+    /**
+     * With a bounded page range (e.g. "1" or "1-3"), stop layout once the range's
+     * last page is final instead of formatting the whole document. Page count
+     * fields then show the number of laid-out pages; a diagnostic reports it.
+     */
+    public boolean isLazyLayout() {
+        return lazyLayout;
+    }
+
+    /**
+     * Keep the field results and linked content cached in the file: no link update
+     * on load and no field refresh before export. Faster for long reports with tables
+     * of contents and cross-references; fields edited without being updated stay stale.
+     */
+    public boolean isSkipFieldUpdate() {
+        return skipFieldUpdate;
+    }
+
     /** Password for password-protected documents. Null = none. */
     public String getPassword() {
         return password;
     }
 
+    /**
+     * Raw LibreOffice PDF filter properties, applied last so they override both
+     * the preset and the explicit options. Never null; empty = none.
+     */
+    public Map<String, String> getFilterProperties() {
+        return filterProperties;
+    }
+
+    /**
+     * Time from the call within which the conversion must finish to be of any use.
+     * Waiting requests of a tenant are admitted earliest deadline first; one that cannot
+     * finish in time, estimated from recent conversion times, fails at once with
+     * {@link SlimLOErrorCode#DEADLINE_EXCEEDED} instead of taking a worker, as does one
+     * still queued when its deadline passes. A conversion that has started is bounded
+     * by the converter's conversion timeout only.
+     * 0 (default) = no deadline; such requests queue behind those with one.
+     */
+    public long getDeadlineMillis() {
+        return deadlineMillis;
+    }
+
+    /**
+     * Fair-queuing key, typically the customer this conversion is for. Workers are
+     * shared across tenants in proportion to {@link PdfConverterOptions#getTenantWeights()},
+     * so one tenant's bulk submission does not starve the others' conversions.
+     * Null (default) = the shared default tenant.
+     */
+    public String getTenant() {
+        return tenant;
+    }
+
+    /**
+     * Receives progress while the worker loads, lays out and exports the document.
+     * Null = no progress reporting.
+     */
+    public ProgressListener getProgressListener() {
+        return progressListener;
+    }
+
+    /**
+     * Render page images from the same loaded document as the PDF, returned in
+     * {@link ConversionResult#getPageImages()}. Null = no images.
+     */
+    public RenderOptions getPageImages() {
+        return pageImages;
+    }
+
+    /**
+     * Extract the plain text (and optionally word boxes) of these pages from the
+     * conversion's own layout, returned in {@link ConversionResult#getPageText()}.
+     * Saves a separate parse of the PDF for indexing. Null = no text.
+     */
+    public TextOptions getPageText() {
+        return pageText;
+    }
+
     public static Builder builder() {
         return new Builder();
     }
 
     public static final class Builder {
+        private PdfPreset preset = PdfPreset.NONE;
         private PdfVersion pdfVersion = PdfVersion.DEFAULT;
         private int jpegQuality = 0;
         private int dpi = 0;
         private boolean taggedPdf = false;
         private String pageRange = null;
+        private boolean lazyLayout = false;
+        private boolean skipFieldUpdate = false;
+        private long deadlineMillis = 0;
+        private String tenant = null;
         private String password = null;
+        private final Map<String, String> filterProperties = new LinkedHashMap<String, String>();
+        private ProgressListener progressListener = null;
+        private RenderOptions pageImages = null;
+        private TextOptions pageText = null;
 
         private Builder() {}
 
+        public Builder preset(PdfPreset preset) {
+            this.preset = preset;
+            return this;
+        }
+
         public Builder pdfVersion(PdfVersion pdfVersion) {
             this.pdfVersion = pdfVersion;
             return this;
@@ -91,11 +208,72 @@ public final class ConversionOptions {
             return this;
         }
 
+        public Builder lazyLayout(boolean lazyLayout) {
+            this.lazyLayout = lazyLayout;
+            return this;
+        }
+
+        public Builder skipFieldUpdate(boolean skipFieldUpdate) {
+            this.skipFieldUpdate = skipFieldUpdate;
+            return this;
+        }
+
+        public Builder deadline(long duration, TimeUnit unit) {
+            return deadlineMillis(unit.toMillis(duration));
+        }
+
+        public Builder deadlineMillis(long millis) {
+            if (millis < 0) {
+                throw new IllegalArgumentException("deadline must not be negative");
+            }
+            this.deadlineMillis = millis;
+            return this;
+        }
+
+        public Builder tenant(String tenant) {
+            this.tenant = tenant;
+            return this;
+        }
+
         public Builder password(String password) {
             this.password = password;
             return this;
         }
 
+        /** Set a raw LibreOffice PDF filter property, e.g. ("ExportBookmarks", "false"). */
+        public Builder filterProperty(String name, String value) {
+            if (name == null || name.isEmpty()) {
+                throw new IllegalArgumentException("name must not be empty");
+            }
+            this.filterProperties.put(name, value);
+            return this;
+        }
+
+        /** Add all entries as raw LibreOffice PDF filter properties. */
+        public Builder filterProperties(Map<String, String> properties) {
+            if (properties != null) {
+                for (Map.Entry<String, String> e : properties.entrySet()) {
+                    filterProperty(e.getKey(), e.getValue());
+                }
+            }
+            return this;
+        }
+
+        public Builder progressListener(ProgressListener progressListener) {
+            this.progressListener = progressListener;
+            return this;
+        }
+
+        public Builder pageImages(RenderOptions pageImages) {
+            this.pageImages = pageImages;
+            return this;
+        }
+
+        public Builder pageText(TextOptions pageText) {
+            this.pageText = pageText;
+            return this;
+        }
+
         public ConversionOptions build() {
             return new ConversionOptions(this);
         }
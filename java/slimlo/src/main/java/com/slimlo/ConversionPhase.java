@@ -0,0 +1,28 @@
+package com.slimlo;
+
+/**
+ * Phase of a running conversion, as reported by {@link ConversionProgress}.
+ */
+public enum ConversionPhase {
+    /** Phase not reported by the worker. */
+    UNKNOWN,
+    /** Document import and initial layout. */
+    LOAD,
+    /** Layout finished; page count known. */
+    LAYOUT,
+    /** PDF export running. */
+    EXPORT,
+    /** Output written. */
+    DONE;
+
+    public static ConversionPhase fromString(String s) {
+        if (s == null) return UNKNOWN;
+        switch (s.toLowerCase()) {
+            case "load": return LOAD;
+            case "layout": return LAYOUT;
+            case "export": return EXPORT;
+            case "done": return DONE;
+            default: return UNKNOWN;
+        }
+    }
+}
@@ -0,0 +1,58 @@
+package com.slimlo;
+
+/**
+ * A progress snapshot streamed by the worker during a conversion.
+ * Delivered to the {@link ProgressListener} set on {@link ConversionOptions}.
+ */
+public final class ConversionProgress {
+
+    private final ConversionPhase phase;
+    private final int percent;
+    private final int pagesLaidOut;
+    private final int pagesExported;
+    private final long bytesWritten;
+
+    public ConversionProgress(
+            ConversionPhase phase,
+            int percent,
+            int pagesLaidOut,
+            int pagesExported,
+            long bytesWritten) {
+        this.phase = phase;
+        this.percent = percent;
+        this.pagesLaidOut = pagesLaidOut;
+        this.pagesExported = pagesExported;
+        this.bytesWritten = bytesWritten;
+    }
+
+    /** Current conversion phase. */
+    public ConversionPhase getPhase() {
+        return phase;
+    }
+
+    /** Completion of the current phase, 0-100. */
+    public int getPercent() {
+        return percent;
+    }
+
+    /** Pages laid out. 0 until the LAYOUT phase. */
+    public int getPagesLaidOut() {
+        return pagesLaidOut;
+    }
+
+    /** Pages exported. Estimated from the export percentage until DONE. */
+    public int getPagesExported() {
+        return pagesExported;
+    }
+
+    /** Output size in bytes. 0 until DONE. */
+    public long getBytesWritten() {
+        return bytesWritten;
+    }
+
+    @Override
+    public String toString() {
+        return phase + " " + percent + "% (pages " + pagesExported + "/" + pagesLaidOut
+                + ", " + bytesWritten + " bytes)";
+    }
+}
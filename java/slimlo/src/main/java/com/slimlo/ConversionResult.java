@@ -18,6 +18,8 @@ public class ConversionResult {
     private final SlimLOErrorCode errorCode;
     private final List<ConversionDiagnostic> diagnostics;
     private final byte[] data;
+    private final List<PageImage> pageImages;
+    private final List<PageText> pageText;
 
     ConversionResult(
             boolean success,
@@ -25,6 +27,17 @@ public class ConversionResult {
             SlimLOErrorCode errorCode,
             List<ConversionDiagnostic> diagnostics,
             byte[] data) {
+        this(success, errorMessage, errorCode, diagnostics, data, null, null);
+    }
+
+    ConversionResult(
+            boolean success,
+            String errorMessage,
+            SlimLOErrorCode errorCode,
+            List<ConversionDiagnostic> diagnostics,
+            byte[] data,
+            List<PageImage> pageImages,
+            List<PageText> pageText) {
         this.success = success;
         this.errorMessage = errorMessage;
         this.errorCode = errorCode;
@@ -32,6 +45,12 @@ public class ConversionResult {
                 ? Collections.unmodifiableList(diagnostics)
                 : Collections.<ConversionDiagnostic>emptyList();
         this.data = data;
+        this.pageImages = pageImages != null
+                ? Collections.unmodifiableList(pageImages)
+                : Collections.<PageImage>emptyList();
+        this.pageText = pageText != null
+                ? Collections.unmodifiableList(pageText)
+                : Collections.<PageText>emptyList();
     }
 
     /** Whether the conversion completed successfully. */
@@ -75,6 +94,23 @@ public class ConversionResult {
         return data;
     }
 
+    /**
+     * Page images rendered alongside the conversion when requested through
+     * {@link ConversionOptions.Builder#pageImages(RenderOptions)}, or by
+     * {@link PdfConverter#renderPages(String, RenderOptions)}. Empty otherwise.
+     */
+    public List<PageImage> getPageImages() {
+        return pageImages;
+    }
+
+    /**
+     * Text of each selected page, when requested through
+     * {@link ConversionOptions.Builder#pageText(TextOptions)}. Empty otherwise.
+     */
+    public List<PageText> getPageText() {
+        return pageText;
+    }
+
     /**
      * Throw a {@link SlimLOException} if the conversion failed.
      * Returns this result for fluent chaining on success.
@@ -100,6 +136,23 @@ public class ConversionResult {
         return new ConversionResult(true, null, null, diagnostics, data);
     }
 
+    /** Create a successful result with PDF data (null in file-path mode) and rendered page images. */
+    public static ConversionResult ok(
+            byte[] data,
+            List<ConversionDiagnostic> diagnostics,
+            List<PageImage> pageImages) {
+        return new ConversionResult(true, null, null, diagnostics, data, pageImages, null);
+    }
+
+    /** Create a successful result with PDF data (null in file-path mode), page images and page text. */
+    public static ConversionResult ok(
+            byte[] data,
+            List<ConversionDiagnostic> diagnostics,
+            List<PageImage> pageImages,
+            List<PageText> pageText) {
+        return new ConversionResult(true, null, null, diagnostics, data, pageImages, pageText);
+    }
+
     /** Create a failure result. */
     public static ConversionResult fail(
             String errorMessage,
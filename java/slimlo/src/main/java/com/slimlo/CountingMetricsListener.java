@@ -0,0 +1,151 @@
+package com.slimlo;
+
+import java.util.concurrent.atomic.DoubleAdder;
+import java.util.concurrent.atomic.LongAdder;
+
+/**
+ * A {@link MetricsListener} that keeps running totals in lock-free adders, cheap
+ * enough to leave installed permanently. Read the getters periodically (for
+ * example from a gauge callback) and export the deltas.
+ */
+public class CountingMetricsListener implements MetricsListener {
+
+    private final LongAdder queueWaits = new LongAdder();
+    private final DoubleAdder queueWaitMillis = new DoubleAdder();
+    private final LongAdder conversions = new LongAdder();
+    private final LongAdder failedConversions = new LongAdder();
+    private final DoubleAdder loadMillis = new DoubleAdder();
+    private final DoubleAdder exportMillis = new DoubleAdder();
+    private final DoubleAdder totalMillis = new DoubleAdder();
+    private final LongAdder bytesIn = new LongAdder();
+    private final LongAdder bytesOut = new LongAdder();
+    private final LongAdder fontFallbacks = new LongAdder();
+    private final LongAdder workerStarts = new LongAdder();
+    private final LongAdder workerRecycles = new LongAdder();
+    private final LongAdder workerCrashes = new LongAdder();
+    private final LongAdder timeouts = new LongAdder();
+    private final LongAdder stalls = new LongAdder();
+    private volatile long peakWorkerMemory;
+
+    @Override
+    public void onQueueWait(double waitMillis, int queueDepth) {
+        queueWaits.increment();
+        queueWaitMillis.add(waitMillis);
+    }
+
+    @Override
+    public void onConversion(ConversionMetrics metrics) {
+        conversions.increment();
+        if (!metrics.isSuccess()) {
+            failedConversions.increment();
+        }
+        loadMillis.add(metrics.getLoadMillis());
+        exportMillis.add(metrics.getExportMillis());
+        totalMillis.add(metrics.getTotalMillis());
+        bytesIn.add(metrics.getInputBytes());
+        bytesOut.add(metrics.getOutputBytes());
+        fontFallbacks.add(metrics.getFontFallbacks());
+    }
+
+    @Override
+    public void onWorkerStarted() {
+        workerStarts.increment();
+    }
+
+    @Override
+    public void onWorkerRecycled(String reason) {
+        workerRecycles.increment();
+    }
+
+    @Override
+    public void onWorkerCrashed() {
+        workerCrashes.increment();
+    }
+
+    @Override
+    public void onTimeout(boolean stalled) {
+        (stalled ? stalls : timeouts).increment();
+    }
+
+    @Override
+    public void onWorkerMemory(int worker, long residentBytes) {
+        // A racing update may lose a peak to a concurrent smaller one; good enough for a gauge
+        if (residentBytes > peakWorkerMemory) {
+            peakWorkerMemory = residentBytes;
+        }
+    }
+
+    /** Requests admitted to (or shed by) the queue. */
+    public long getQueueWaits() {
+        return queueWaits.sum();
+    }
+
+    /** Total time requests waited for a worker. */
+    public double getQueueWaitMillis() {
+        return queueWaitMillis.sum();
+    }
+
+    /** Convert requests that reached a worker and got a result from it. */
+    public long getConversions() {
+        return conversions.sum();
+    }
+
+    /** Of {@link #getConversions()}, those that failed. */
+    public long getFailedConversions() {
+        return failedConversions.sum();
+    }
+
+    /** Total worker time spent loading and laying out documents. */
+    public double getLoadMillis() {
+        return loadMillis.sum();
+    }
+
+    /** Total worker time spent exporting. */
+    public double getExportMillis() {
+        return exportMillis.sum();
+    }
+
+    /** Total worker conversion time. */
+    public double getTotalMillis() {
+        return totalMillis.sum();
+    }
+
+    public long getBytesIn() {
+        return bytesIn.sum();
+    }
+
+    public long getBytesOut() {
+        return bytesOut.sum();
+    }
+
+    public long getFontFallbacks() {
+        return fontFallbacks.sum();
+    }
+
+    public long getWorkerStarts() {
+        return workerStarts.sum();
+    }
+
+    public long getWorkerRecycles() {
+        return workerRecycles.sum();
+    }
+
+    public long getWorkerCrashes() {
+        return workerCrashes.sum();
+    }
+
+    /** Requests that hit the overall conversion timeout. */
+    public long getTimeouts() {
+        return timeouts.sum();
+    }
+
+    /** Requests whose worker stalled past the stall timeout. */
+    public long getStalls() {
+        return stalls.sum();
+    }
+
+    /** Largest worker resident set size reported so far; 0 if none was. */
+    public long getPeakWorkerMemory() {
+        return peakWorkerMemory;
+    }
+}
@@ -0,0 +1,83 @@
+package com.slimlo;
+
+import java.util.Collections;
+import java.util.List;
+
+/**
+ * Document metadata gathered after load and layout, without PDF export.
+ * Returned by {@link PdfConverter#getDocumentInfo(String)}.
+ */
+public final class DocumentInfo {
+
+    private final int pageCount;
+    private final List<PageSize> pages;
+    private final int sectionCount;
+    private final int imageCount;
+    private final int wordCount;
+    private final List<String> fonts;
+    private final List<String> missingFonts;
+
+    public DocumentInfo(
+            int pageCount,
+            List<PageSize> pages,
+            int sectionCount,
+            int imageCount,
+            int wordCount,
+            List<String> fonts,
+            List<String> missingFonts) {
+        this.pageCount = pageCount;
+        this.pages = pages != null
+                ? Collections.unmodifiableList(pages)
+                : Collections.<PageSize>emptyList();
+        this.sectionCount = sectionCount;
+        this.imageCount = imageCount;
+        this.wordCount = wordCount;
+        this.fonts = fonts != null
+                ? Collections.unmodifiableList(fonts)
+                : Collections.<String>emptyList();
+        this.missingFonts = missingFonts != null
+                ? Collections.unmodifiableList(missingFonts)
+                : Collections.<String>emptyList();
+    }
+
+    /** Number of pages after full layout. */
+    public int getPageCount() {
+        return pageCount;
+    }
+
+    /** Size of each page, in document order. */
+    public List<PageSize> getPages() {
+        return pages;
+    }
+
+    /** Number of text sections. */
+    public int getSectionCount() {
+        return sectionCount;
+    }
+
+    /** Number of images (inline and floating). */
+    public int getImageCount() {
+        return imageCount;
+    }
+
+    /** Word count as computed by the layout engine. */
+    public int getWordCount() {
+        return wordCount;
+    }
+
+    /** Font families used by the document; these are embedded into the PDF. */
+    public List<String> getFonts() {
+        return fonts;
+    }
+
+    /** Fonts used by the document that are not installed and will be substituted on export. */
+    public List<String> getMissingFonts() {
+        return missingFonts;
+    }
+
+    @Override
+    public String toString() {
+        return pageCount + " pages, " + sectionCount + " sections, " + imageCount + " images, "
+                + fonts.size() + " fonts (" + missingFonts.size() + " missing)";
+    }
+}
@@ -0,0 +1,48 @@
+package com.slimlo;
+
+import java.util.List;
+
+/**
+ * Result of a document info query. On success {@link #getInfo()} holds the metadata;
+ * {@link #getData()} is always null.
+ */
+public final class DocumentInfoResult extends ConversionResult {
+
+    private final DocumentInfo info;
+
+    DocumentInfoResult(
+            boolean success,
+            String errorMessage,
+            SlimLOErrorCode errorCode,
+            List<ConversionDiagnostic> diagnostics,
+            DocumentInfo info) {
+        super(success, errorMessage, errorCode, diagnostics, null);
+        this.info = info;
+    }
+
+    /** Document metadata. Null if the document could not be loaded. */
+    public DocumentInfo getInfo() {
+        return info;
+    }
+
+    @Override
+    public DocumentInfoResult throwIfFailed() {
+        super.throwIfFailed();
+        return this;
+    }
+
+    // --- Factory methods ---
+
+    /** Create a successful result. */
+    public static DocumentInfoResult ok(DocumentInfo info, List<ConversionDiagnostic> diagnostics) {
+        return new DocumentInfoResult(true, null, null, diagnostics, info);
+    }
+
+    /** Create a failure result. */
+    public static DocumentInfoResult fail(
+            String errorMessage,
+            SlimLOErrorCode errorCode,
+            List<ConversionDiagnostic> diagnostics) {
+        return new DocumentInfoResult(false, errorMessage, errorCode, diagnostics, null);
+    }
+}
@@ -0,0 +1,431 @@
+package com.slimlo;
+
+import com.slimlo.internal.NativeBridge;
+import com.slimlo.internal.WorkerLocator;
+
+import java.io.Closeable;
+import java.io.File;
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.ThreadFactory;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Converts documents with LibreOffice loaded into this JVM, calling the SlimLO
+ * native library through JNI instead of going through a worker process.
+ *
+ * <p><b>Trusted input only.</b> There is no crash isolation: a document that crashes
+ * LibreOffice takes the JVM with it, and a conversion that hangs cannot be timed out
+ * or killed. Use {@link PdfConverter} for documents from untrusted sources.</p>
+ *
+ * <p><b>Why:</b> no process spawn, JSON framing or pipe copies. The PDF is copied once
+ * into the returned array, or lent out as native memory to a {@link PdfReader} with no
+ * copy at all. For small documents this removes most of the per-conversion overhead.</p>
+ *
+ * <p><b>Threading:</b> LibreOffice allows one instance per process, bound to the
+ * thread that created it. The converter owns that thread; every call is handed to it
+ * and conversions run one at a time in submission order. All methods are thread-safe
+ * and block until their conversion finishes. Only one converter may exist per process,
+ * and LibreOffice cannot be started again once it is closed.</p>
+ *
+ * <p>Requires {@code libslimlo_jni} next to libslimlo in {@code program/} (built when
+ * a JDK is found). Page rendering, text extraction, progress, deadlines and tenants
+ * are worker-pool features and are ignored here; diagnostics are always empty.</p>
+ *
+ * <p><b>Usage:</b></p>
+ * <pre>{@code
+ * try (InProcessConverter converter = InProcessConverter.create()) {
+ *     byte[] pdf = converter.convert(docx, DocumentFormat.DOCX).throwIfFailed().getData();
+ *
+ *     // Borrowed: upload straight from native memory
+ *     converter.convert(docx, DocumentFormat.DOCX, null, pdf -> channel.write(pdf));
+ * }
+ * }</pre>
+ */
+public final class InProcessConverter implements Closeable {
+
+    private final ExecutorService thread;
+    private final long handle;
+    private volatile boolean disposed;
+
+    private InProcessConverter(ExecutorService thread, long handle) {
+        this.thread = thread;
+        this.handle = handle;
+    }
+
+    /**
+     * Load LibreOffice into this JVM with default options.
+     *
+     * @see #create(PdfConverterOptions)
+     */
+    public static InProcessConverter create() {
+        return create(PdfConverterOptions.builder().build());
+    }
+
+    /**
+     * Load LibreOffice into this JVM.
+     *
+     * @param options converter configuration. Only the resource path, font directories
+     *                and threads per worker (LibreOffice's thread budget) apply; pool
+     *                settings are ignored.
+     * @return the converter. Close it to shut LibreOffice down.
+     * @throws IllegalStateException if the resource path cannot be auto-detected.
+     * @throws UnsatisfiedLinkError if the JNI bridge cannot be loaded.
+     * @throws SlimLOException if a font directory does not exist
+     *                         ({@link SlimLOErrorCode#FILE_NOT_FOUND}) or cannot be
+     *                         registered, or LibreOffice fails to start or is already
+     *                         loaded ({@link SlimLOErrorCode#ALREADY_INITIALIZED}).
+     */
+    public static InProcessConverter create(PdfConverterOptions options) {
+        if (options == null) {
+            options = PdfConverterOptions.builder().build();
+        }
+        final List<String> fontDirectories = new ArrayList<String>();
+        if (options.getFontDirectories() != null) {
+            for (String path : options.getFontDirectories()) {
+                File directory = new File(path).getAbsoluteFile();
+                if (!directory.isDirectory()) {
+                    throw new SlimLOException("Font directory not found: " + directory.getPath(),
+                            SlimLOErrorCode.FILE_NOT_FOUND);
+                }
+                fontDirectories.add(directory.getPath());
+            }
+        }
+
+        final String resourcePath = options.getResourcePath() != null
+                ? options.getResourcePath()
+                : WorkerLocator.findResourcePath();
+        final int threads = options.getThreadsPerWorker();
+        NativeBridge.load(resourcePath);
+
+        ExecutorService thread = Executors.newSingleThreadExecutor(new ThreadFactory() {
+            @Override
+            public Thread newThread(Runnable r) {
+                Thread t = new Thread(r, "slimlo-libreoffice");
+                t.setDaemon(true);
+                return t;
+            }
+        });
+        try {
+            long handle = run(thread, new Callable<Long>() {
+                @Override
+                public Long call() {
+                    long h = NativeBridge.init(NativeBridge.utf8(resourcePath), threads);
+                    if (h == 0) {
+                        String message = NativeBridge.errorMessage(0);
+                        throw new SlimLOException(
+                                message.isEmpty() ? "LibreOffice failed to initialize" : message,
+                                message.contains("already initialized")
+                                        ? SlimLOErrorCode.ALREADY_INITIALIZED
+                                        : SlimLOErrorCode.INIT_FAILED);
+                    }
+                    for (String path : fontDirectories) {
+                        int rc = NativeBridge.addFontDirectory(h, NativeBridge.utf8(path));
+                        if (rc != 0) {
+                            String message = NativeBridge.errorMessage(h);
+                            NativeBridge.destroy(h);
+                            throw new SlimLOException(message, SlimLOErrorCode.fromValue(rc));
+                        }
+                    }
+                    return h;
+                }
+            });
+            return new InProcessConverter(thread, handle);
+        } catch (RuntimeException e) {
+            thread.shutdown();
+            throw e;
+        }
+    }
+
+    // ---- File-to-file conversion ----
+
+    /** Convert a document file to PDF with default options. */
+    public ConversionResult convert(String inputPath, String outputPath) {
+        return convert(inputPath, outputPath, null);
+    }
+
+    /**
+     * Convert a document file to PDF.
+     *
+     * @param inputPath  path to input document (.docx).
+     * @param outputPath path for output PDF file.
+     * @param options    PDF conversion options, or null for defaults.
+     * @return conversion result.
+     */
+    public ConversionResult convert(String inputPath, String outputPath, final ConversionOptions options) {
+        checkDisposed();
+        if (inputPath == null || inputPath.isEmpty()) {
+            throw new IllegalArgumentException("inputPath must not be null or empty");
+        }
+        if (outputPath == null || outputPath.isEmpty()) {
+            throw new IllegalArgumentException("outputPath must not be null or empty");
+        }
+
+        final File inputFile = new File(inputPath).getAbsoluteFile();
+        final File outputFile = new File(outputPath).getAbsoluteFile();
+        if (!inputFile.exists()) {
+            return ConversionResult.fail("Input file not found: " + inputFile.getAbsolutePath(),
+                    SlimLOErrorCode.FILE_NOT_FOUND, null);
+        }
+        final DocumentFormat format = DocumentFormat.fromExtension(inputPath);
+        if (format != DocumentFormat.DOCX) {
+            return invalidFormatFailure(format);
+        }
+
+        return run(thread, new Callable<ConversionResult>() {
+            @Override
+            public ConversionResult call() {
+                int rc = NativeBridge.convertFile(handle,
+                        NativeBridge.utf8(inputFile.getAbsolutePath()),
+                        NativeBridge.utf8(outputFile.getAbsolutePath()),
+                        format.getValue(), NativeBridge.options(options), NativeBridge.strings(options));
+                return rc == 0 ? ConversionResult.ok(null) : failure(rc);
+            }
+        });
+    }
+
+    // ---- Buffer conversion ----
+
+    /** Convert an in-memory document to PDF bytes with default options. */
+    public ConversionResult convert(byte[] input, DocumentFormat format) {
+        return convert(input, format, null);
+    }
+
+    /**
+     * Convert an in-memory document to PDF bytes.
+     *
+     * @param input   document bytes.
+     * @param format  document format (must be DOCX).
+     * @param options PDF conversion options, or null for defaults.
+     * @return conversion result; the PDF is in {@link ConversionResult#getData()}.
+     */
+    public ConversionResult convert(final byte[] input, DocumentFormat format, final ConversionOptions options) {
+        ConversionResult invalid = validate(input != null ? input.length : 0, format);
+        if (invalid != null) {
+            return invalid;
+        }
+        return convertCore(ByteBuffer.wrap(input), format, options, null, true);
+    }
+
+    /**
+     * Convert a document held in a ByteBuffer to PDF bytes. A direct buffer is read
+     * in place by the native code; a heap buffer is copied once.
+     *
+     * @param input   document bytes between position and limit.
+     * @param format  document format (must be DOCX).
+     * @param options PDF conversion options, or null for defaults.
+     * @return conversion result; the PDF is in {@link ConversionResult#getData()}.
+     */
+    public ConversionResult convert(ByteBuffer input, DocumentFormat format, ConversionOptions options) {
+        ConversionResult invalid = validate(input != null ? input.remaining() : 0, format);
+        if (invalid != null) {
+            return invalid;
+        }
+        return convertCore(input, format, options, null, true);
+    }
+
+    /**
+     * Convert an in-memory document and read the PDF where LibreOffice left it.
+     *
+     * @param input   document bytes.
+     * @param format  document format (must be DOCX).
+     * @param options PDF conversion options, or null for defaults.
+     * @param reader  called with the PDF on the LibreOffice thread. The buffer is native
+     *                memory freed when the reader returns: copy out anything needed
+     *                afterwards, and keep the reader short -- the next conversion waits for it.
+     * @return the reader's return value.
+     * @throws SlimLOException if the conversion fails (the reader is not called)
+     *                         or the reader throws (as the cause).
+     */
+    public <T> T convert(byte[] input, DocumentFormat format, ConversionOptions options,
+                         PdfReader<T> reader) {
+        if (reader == null) {
+            throw new IllegalArgumentException("reader must not be null");
+        }
+        ConversionResult invalid = validate(input != null ? input.length : 0, format);
+        if (invalid != null) {
+            throw new SlimLOException(invalid.getErrorMessage(), invalid.getErrorCode());
+        }
+        return convertCore(ByteBuffer.wrap(input), format, options, reader, false);
+    }
+
+    // ---- Fonts ----
+
+    /**
+     * Register a font directory with the loaded LibreOffice. Runs between
+     * conversions; only font lists and caches are rebuilt, and adding a
+     * directory twice is a no-op.
+     *
+     * @param fontDirectory directory of .ttf/.otf/.ttc/.otc files (subdirectories included).
+     * @return success, or the failure reported by LibreOffice.
+     */
+    public ConversionResult addFontDirectory(String fontDirectory) {
+        checkDisposed();
+        if (fontDirectory == null || fontDirectory.isEmpty()) {
+            throw new IllegalArgumentException("fontDirectory must not be null or empty");
+        }
+
+        final File directory = new File(fontDirectory).getAbsoluteFile();
+        if (!directory.isDirectory()) {
+            return ConversionResult.fail("Font directory not found: " + directory.getPath(),
+                    SlimLOErrorCode.FILE_NOT_FOUND, null);
+        }
+        return run(thread, new Callable<ConversionResult>() {
+            @Override
+            public ConversionResult call() {
+                int rc = NativeBridge.addFontDirectory(handle, NativeBridge.utf8(directory.getPath()));
+                return rc == 0 ? ConversionResult.ok(null) : failure(rc);
+            }
+        });
+    }
+
+    @Override
+    public void close() {
+        if (disposed) return;
+        disposed = true;
+        try {
+            run(thread, new Callable<Void>() {
+                @Override
+                public Void call() {
+                    NativeBridge.destroy(handle);
+                    return null;
+                }
+            });
+        } finally {
+            thread.shutdown();
+            try {
+                thread.awaitTermination(1, TimeUnit.MINUTES);
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+            }
+        }
+    }
+
+    // ---- Internal helpers ----
+
+    /**
+     * Run a buffer conversion on the LibreOffice thread. {@code asResult}: return a
+     * ConversionResult with the PDF copied into a byte[]; otherwise return what
+     * {@code reader} makes of the borrowed PDF, throwing on failure.
+     */
+    @SuppressWarnings("unchecked")
+    private <T> T convertCore(final ByteBuffer input, final DocumentFormat format,
+                              final ConversionOptions options, final PdfReader<T> reader,
+                              final boolean asResult) {
+        return run(thread, new Callable<T>() {
+            @Override
+            public T call() throws Exception {
+                long[] out = new long[2];
+                int[] opts = NativeBridge.options(options);
+                byte[][] strings = NativeBridge.strings(options);
+                int length = input.remaining();
+                int rc;
+                if (input.isDirect()) {
+                    rc = NativeBridge.convertDirect(handle, input, input.position(), length,
+                            format.getValue(), opts, strings, out);
+                } else if (input.hasArray()) {
+                    rc = NativeBridge.convertArray(handle, input.array(),
+                            input.arrayOffset() + input.position(), length,
+                            format.getValue(), opts, strings, out);
+                } else {
+                    // Read-only heap buffer: no accessible array
+                    byte[] copy = new byte[length];
+                    input.duplicate().get(copy);
+                    rc = NativeBridge.convertArray(handle, copy, 0, length,
+                            format.getValue(), opts, strings, out);
+                }
+                if (rc != 0) {
+                    ConversionResult failed = failure(rc);
+                    if (asResult) {
+                        return (T) failed;
+                    }
+                    throw new SlimLOException(failed.getErrorMessage(), failed.getErrorCode());
+                }
+
+                try {
+                    if (asResult) {
+                        return (T) ConversionResult.ok(NativeBridge.copy(out[0], out[1]), null);
+                    }
+                    return reader.read(NativeBridge.wrap(out[0], out[1]).asReadOnlyBuffer());
+                } finally {
+                    NativeBridge.freeBuffer(out[0]);
+                }
+            }
+        });
+    }
+
+    private ConversionResult validate(int length, DocumentFormat format) {
+        checkDisposed();
+        if (length == 0) {
+            return ConversionResult.fail("Input data is empty", SlimLOErrorCode.INVALID_ARGUMENT, null);
+        }
+        if (format != DocumentFormat.DOCX) {
+            return invalidFormatFailure(format);
+        }
+        return null;
+    }
+
+    private ConversionResult failure(int rc) {
+        return ConversionResult.fail(NativeBridge.errorMessage(handle), SlimLOErrorCode.fromValue(rc), null);
+    }
+
+    /** Run {@code work} on the LibreOffice thread and wait for it. */
+    private static <T> T run(ExecutorService thread, Callable<T> work) {
+        Future<T> future;
+        try {
+            future = thread.submit(work);
+        } catch (RejectedExecutionException e) {
+            throw new IllegalStateException("InProcessConverter has been closed", e);
+        }
+        boolean interrupted = false;
+        try {
+            while (true) {
+                try {
+                    return future.get();
+                } catch (InterruptedException e) {
+                    // A running conversion cannot be interrupted: wait it out
+                    interrupted = true;
+                }
+            }
+        } catch (ExecutionException e) {
+            Throwable cause = e.getCause();
+            if (cause instanceof SlimLOException) {
+                throw (SlimLOException) cause;
+            }
+            if (cause instanceof RuntimeException) {
+                throw (RuntimeException) cause;
+            }
+            if (cause instanceof Error) {
+                throw (Error) cause;
+            }
+            throw new SlimLOException("PDF reader failed: " + cause, SlimLOErrorCode.UNKNOWN, cause);
+        } finally {
+            if (interrupted) {
+                Thread.currentThread().interrupt();
+            }
+        }
+    }
+
+    private static ConversionResult invalidFormatFailure(DocumentFormat format) {
+        String message;
+        if (format == DocumentFormat.UNKNOWN) {
+            message = "Unsupported input format. SlimLO currently supports DOCX (.docx) only.";
+        } else {
+            message = "Unsupported format '" + format + "'. SlimLO currently supports DOCX (.docx) only.";
+        }
+        return ConversionResult.fail(message, SlimLOErrorCode.INVALID_FORMAT, null);
+    }
+
+    private void checkDisposed() {
+        if (disposed) {
+            throw new IllegalStateException("InProcessConverter has been closed");
+        }
+    }
+}
@@ -0,0 +1,52 @@
+package com.slimlo;
+
+/**
+ * Receives operational metrics from a converter's worker pool, for forwarding
+ * to a metrics library (Micrometer, OpenTelemetry, Dropwizard...). Set it with
+ * {@link PdfConverterOptions.Builder#metricsListener(MetricsListener)}; every
+ * method defaults to doing nothing, so implement only what you export.
+ * {@link CountingMetricsListener} keeps lock-free running totals.
+ *
+ * <p>Methods are called on the thread that ran the request, concurrently from
+ * several threads; implementations must be thread-safe and return quickly.
+ */
+public interface MetricsListener {
+
+    /** The listener used when none is set. */
+    MetricsListener NONE = new MetricsListener() {
+    };
+
+    /**
+     * A request was admitted to a worker (or shed) after waiting {@code waitMillis};
+     * {@code queueDepth} requests were still waiting at that point.
+     */
+    default void onQueueWait(double waitMillis, int queueDepth) {
+    }
+
+    /** A convert request finished on a worker (combine and streaming included). */
+    default void onConversion(ConversionMetrics metrics) {
+    }
+
+    /** A worker process was started. */
+    default void onWorkerStarted() {
+    }
+
+    /** The pool stopped a healthy worker; reason is "max_conversions" or "idle". */
+    default void onWorkerRecycled(String reason) {
+    }
+
+    /** A worker process exited during a request (timeouts excluded). */
+    default void onWorkerCrashed() {
+    }
+
+    /** A worker was killed because a request timed out, or stalled without progress. */
+    default void onTimeout(boolean stalled) {
+    }
+
+    /**
+     * Resident memory of the worker in pool slot {@code worker}, reported after each
+     * conversion. Only on platforms where the worker can measure it (Linux).
+     */
+    default void onWorkerMemory(int worker, long residentBytes) {
+    }
+}
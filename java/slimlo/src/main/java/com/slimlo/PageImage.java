@@ -0,0 +1,54 @@
+package com.slimlo;
+
+/**
+ * A document page rendered to an image.
+ */
+public final class PageImage {
+
+    private final int pageNumber;
+    private final int width;
+    private final int height;
+    private final PageImageFormat format;
+    private final byte[] data;
+
+    public PageImage(int pageNumber, int width, int height, PageImageFormat format, byte[] data) {
+        if (data == null) {
+            throw new IllegalArgumentException("data must not be null");
+        }
+        this.pageNumber = pageNumber;
+        this.width = width;
+        this.height = height;
+        this.format = format;
+        this.data = data;
+    }
+
+    /** 1-based page number. */
+    public int getPageNumber() {
+        return pageNumber;
+    }
+
+    /** Image width in pixels. */
+    public int getWidth() {
+        return width;
+    }
+
+    /** Image height in pixels. */
+    public int getHeight() {
+        return height;
+    }
+
+    /** Format of {@link #getData()}. */
+    public PageImageFormat getFormat() {
+        return format;
+    }
+
+    /** PNG bytes, or {@code width * height * 4} RGBA bytes. */
+    public byte[] getData() {
+        return data;
+    }
+
+    @Override
+    public String toString() {
+        return "page " + pageNumber + ": " + format + " " + width + "x" + height + ", " + data.length + " bytes";
+    }
+}
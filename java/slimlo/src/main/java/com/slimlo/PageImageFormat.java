@@ -0,0 +1,27 @@
+package com.slimlo;
+
+/**
+ * Pixel format of a rendered page image.
+ * Values match the native SlimLOImageFormat enum in slimlo.h.
+ */
+public enum PageImageFormat {
+    /** PNG-encoded image. */
+    PNG(0),
+    /** Raw 8-bit RGBA pixels, row-major, no padding. */
+    RGBA(1);
+
+    private final int value;
+
+    PageImageFormat(int value) {
+        this.value = value;
+    }
+
+    public int getValue() {
+        return value;
+    }
+
+    /** Map a native format value; unknown values map to PNG. */
+    public static PageImageFormat fromValue(int value) {
+        return value == 1 ? RGBA : PNG;
+    }
+}
@@ -0,0 +1,43 @@
+package com.slimlo;
+
+/**
+ * Page size in points (1/72 inch).
+ */
+public final class PageSize {
+
+    private final double width;
+    private final double height;
+
+    public PageSize(double width, double height) {
+        this.width = width;
+        this.height = height;
+    }
+
+    /** Page width in points. */
+    public double getWidth() {
+        return width;
+    }
+
+    /** Page height in points. */
+    public double getHeight() {
+        return height;
+    }
+
+    @Override
+    public boolean equals(Object obj) {
+        if (this == obj) return true;
+        if (!(obj instanceof PageSize)) return false;
+        PageSize other = (PageSize) obj;
+        return Double.compare(width, other.width) == 0 && Double.compare(height, other.height) == 0;
+    }
+
+    @Override
+    public int hashCode() {
+        return 31 * Double.hashCode(width) + Double.hashCode(height);
+    }
+
+    @Override
+    public String toString() {
+        return width + "x" + height + " pt";
+    }
+}
@@ -0,0 +1,55 @@
+package com.slimlo;
+
+import java.util.Collections;
+import java.util.List;
+
+/**
+ * Text of one page, taken from the layout the PDF was exported from.
+ */
+public final class PageText {
+
+    private final int pageNumber;
+    private final PageSize size;
+    private final String text;
+    private final List<WordBox> words;
+
+    public PageText(int pageNumber, PageSize size, String text, List<WordBox> words) {
+        if (text == null) {
+            throw new IllegalArgumentException("text must not be null");
+        }
+        this.pageNumber = pageNumber;
+        this.size = size;
+        this.text = text;
+        this.words = words != null
+                ? Collections.unmodifiableList(words)
+                : Collections.<WordBox>emptyList();
+    }
+
+    /** 1-based page number. */
+    public int getPageNumber() {
+        return pageNumber;
+    }
+
+    /** Page size in points. */
+    public PageSize getSize() {
+        return size;
+    }
+
+    /** Plain text in reading order, lines separated by '\n'. */
+    public String getText() {
+        return text;
+    }
+
+    /**
+     * Words with their bounding boxes, in paint order. Empty unless
+     * {@link TextOptions.Builder#includeWords(boolean)} was set.
+     */
+    public List<WordBox> getWords() {
+        return words;
+    }
+
+    @Override
+    public String toString() {
+        return "page " + pageNumber + ": " + text.length() + " chars, " + words.size() + " words";
+    }
+}
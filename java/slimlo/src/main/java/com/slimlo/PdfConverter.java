@@ -1,10 +1,14 @@
 package com.slimlo;
 
+import com.slimlo.internal.AdmissionQueue;
 import com.slimlo.internal.WorkerLocator;
 import com.slimlo.internal.WorkerPool;
+import com.slimlo.internal.WorkerPoolSettings;
 
 import java.io.*;
+import java.util.ArrayList;
 import java.util.HashMap;
+import java.util.List;
 import java.util.Map;
 import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.atomic.AtomicInteger;
@@ -73,18 +77,14 @@ public final class PdfConverter implements Closeable {
             options = PdfConverterOptions.builder().build();
         }
 
-        String workerPath = WorkerLocator.findWorkerExecutable();
+        // Connected to a slimlo_server, the pool holds connections, not processes
+        String serverSocket = options.getServerSocket();
+        String workerPath = serverSocket == null ? WorkerLocator.findWorkerExecutable() : "";
         String resourcePath = options.getResourcePath() != null
                 ? options.getResourcePath()
-                : WorkerLocator.findResourcePath();
+                : serverSocket == null ? WorkerLocator.findResourcePath() : "";
 
-        WorkerPool pool = new WorkerPool(
-                workerPath,
-                resourcePath,
-                options.getFontDirectories(),
-                options.getMaxWorkers(),
-                options.getMaxConversionsPerWorker(),
-                options.getConversionTimeoutMillis());
+        WorkerPool pool = new WorkerPool(WorkerPoolSettings.from(options, workerPath, resourcePath));
 
         PdfConverter converter = new PdfConverter(pool);
 
@@ -153,7 +153,81 @@ public final class PdfConverter implements Closeable {
         request.put("format", format.getValue());
         addOptions(request, options);
 
-        return pool.execute(request);
+        return pool.execute(request, progressListenerOf(options), deadlineOf(options), tenantOf(options));
+    }
+
+    // ---- Combined conversion (file-path IPC) ----
+
+    /**
+     * Convert several document files, in order, into a single PDF.
+     *
+     * @see #combine(List, String, ConversionOptions)
+     */
+    public ConversionResult combine(List<CombinePart> parts, String outputPath) {
+        return combine(parts, outputPath, null);
+    }
+
+    /**
+     * Convert several document files, in order, into a single PDF.
+     * The parts are loaded into one document on one worker and exported once, so fonts
+     * and shared images are embedded once and no separate merge step is needed.
+     * Each part starts on a new page; the first part provides the styles and page setup.
+     * A part with a bookmark title gets a top-level PDF outline entry. The page range,
+     * page images and page text of {@code options} refer to the combined document.
+     *
+     * @param parts      input documents (.docx), with optional bookmark titles.
+     * @param outputPath path for output PDF file.
+     * @param options    PDF conversion options, or null for defaults.
+     * @return conversion result with diagnostics.
+     */
+    public ConversionResult combine(List<CombinePart> parts, String outputPath, ConversionOptions options) {
+        checkDisposed();
+        if (parts == null) {
+            throw new IllegalArgumentException("parts must not be null");
+        }
+        if (outputPath == null || outputPath.isEmpty()) {
+            throw new IllegalArgumentException("outputPath must not be null or empty");
+        }
+        if (parts.isEmpty()) {
+            return ConversionResult.fail("At least one part is required",
+                    SlimLOErrorCode.INVALID_ARGUMENT, null);
+        }
+
+        List<Map<String, Object>> inputs = new ArrayList<Map<String, Object>>();
+        for (int i = 0; i < parts.size(); i++) {
+            CombinePart part = parts.get(i);
+            if (part == null || part.getInputPath() == null || part.getInputPath().isEmpty()) {
+                return ConversionResult.fail("Part " + (i + 1) + ": input path is required",
+                        SlimLOErrorCode.INVALID_ARGUMENT, null);
+            }
+            File inputFile = new File(part.getInputPath()).getAbsoluteFile();
+            if (!inputFile.exists()) {
+                return ConversionResult.fail("Part " + (i + 1) + ": input file not found: "
+                        + inputFile.getAbsolutePath(), SlimLOErrorCode.FILE_NOT_FOUND, null);
+            }
+            DocumentFormat format = DocumentFormat.fromExtension(part.getInputPath());
+            if (format != DocumentFormat.DOCX) {
+                return ConversionResult.fail("Part " + (i + 1) + ": "
+                        + invalidFormatFailure(format).getErrorMessage(), SlimLOErrorCode.INVALID_FORMAT, null);
+            }
+
+            Map<String, Object> input = new HashMap<String, Object>();
+            input.put("input", inputFile.getAbsolutePath());
+            if (part.getBookmark() != null) {
+                input.put("bookmark", part.getBookmark());
+            }
+            inputs.add(input);
+        }
+
+        Map<String, Object> request = new HashMap<String, Object>();
+        request.put("type", "combine");
+        request.put("id", requestId.incrementAndGet());
+        request.put("inputs", inputs);
+        request.put("output", new File(outputPath).getAbsolutePath());
+        request.put("format", DocumentFormat.DOCX.getValue());
+        addOptions(request, options);
+
+        return pool.execute(request, progressListenerOf(options), deadlineOf(options), tenantOf(options));
     }
 
     // ---- Buffer conversion (binary IPC) ----
@@ -232,7 +306,7 @@ public final class PdfConverter implements Closeable {
 
             // Return result without data (data was written to output stream)
             return result.isSuccess()
-                    ? ConversionResult.ok(result.getDiagnostics())
+                    ? ConversionResult.ok(null, result.getDiagnostics(), result.getPageImages(), result.getPageText())
                     : result;
         } catch (IOException e) {
             return ConversionResult.fail("I/O error: " + e.getMessage(),
@@ -240,6 +314,207 @@ public final class PdfConverter implements Closeable {
         }
     }
 
+    /**
+     * Convert a document stream to PDF without holding either document in memory.
+     *
+     * @param input  readable stream containing document bytes.
+     * @param output writable stream where PDF bytes will be written.
+     * @param format document format (must be DOCX).
+     * @return conversion result with diagnostics.
+     * @see #convertStreaming(InputStream, OutputStream, DocumentFormat, ConversionOptions)
+     */
+    public ConversionResult convertStreaming(InputStream input, OutputStream output, DocumentFormat format) {
+        return convertStreaming(input, output, format, null);
+    }
+
+    /**
+     * Convert a document stream to PDF without holding either document in memory:
+     * the input is sent to the worker in chunks as it is read, and the PDF is
+     * written to {@code output} in chunks as it arrives. The worker still
+     * assembles the whole document before loading it.
+     * <p>
+     * Because the document is not known up front, streamed conversions bypass
+     * crash quarantine and are never coalesced. If the worker fails while sending
+     * the PDF, {@code output} may already hold part of it. Reading the input counts
+     * as worker activity for the stall timeout.
+     *
+     * @param input   readable stream containing document bytes.
+     * @param output  writable stream where PDF bytes will be written.
+     * @param format  document format (must be DOCX).
+     * @param options PDF conversion options, or null for defaults.
+     * @return conversion result with diagnostics.
+     */
+    public ConversionResult convertStreaming(InputStream input, OutputStream output,
+                                             DocumentFormat format, ConversionOptions options) {
+        checkDisposed();
+        if (input == null) throw new IllegalArgumentException("input must not be null");
+        if (output == null) throw new IllegalArgumentException("output must not be null");
+        if (format != DocumentFormat.DOCX) {
+            return invalidFormatFailure(format);
+        }
+
+        Map<String, Object> request = new HashMap<String, Object>();
+        request.put("type", "convert_buffer");
+        request.put("id", requestId.incrementAndGet());
+        request.put("format", format.getValue());
+        request.put("chunked", true);
+        addOptions(request, options);
+
+        return pool.executeStream(request, input, output, progressListenerOf(options), deadlineOf(options),
+                tenantOf(options));
+    }
+
+    // ---- Document info (no PDF export) ----
+
+    /**
+     * Read document metadata (page count, page sizes, sections, images and fonts)
+     * without exporting a PDF. The worker loads the document, finishes layout and stops,
+     * so this costs a fraction of a conversion.
+     *
+     * @param inputPath path to input document (.docx).
+     * @return result with the metadata in {@link DocumentInfoResult#getInfo()}.
+     */
+    public DocumentInfoResult getDocumentInfo(String inputPath) {
+        checkDisposed();
+        if (inputPath == null || inputPath.isEmpty()) {
+            throw new IllegalArgumentException("inputPath must not be null or empty");
+        }
+
+        File inputFile = new File(inputPath).getAbsoluteFile();
+        if (!inputFile.exists()) {
+            return DocumentInfoResult.fail("Input file not found: " + inputFile.getAbsolutePath(),
+                    SlimLOErrorCode.FILE_NOT_FOUND, null);
+        }
+
+        DocumentFormat format = DocumentFormat.fromExtension(inputPath);
+        if (format != DocumentFormat.DOCX) {
+            return DocumentInfoResult.fail(invalidFormatFailure(format).getErrorMessage(),
+                    SlimLOErrorCode.INVALID_FORMAT, null);
+        }
+
+        Map<String, Object> request = new HashMap<String, Object>();
+        request.put("type", "info");
+        request.put("id", requestId.incrementAndGet());
+        request.put("input", inputFile.getAbsolutePath());
+        request.put("format", format.getValue());
+
+        return pool.executeInfo(request, null);
+    }
+
+    /**
+     * Read metadata of an in-memory document without exporting a PDF.
+     *
+     * @param input  input document bytes.
+     * @param format document format (must be DOCX).
+     * @return result with the metadata in {@link DocumentInfoResult#getInfo()}.
+     */
+    public DocumentInfoResult getDocumentInfo(byte[] input, DocumentFormat format) {
+        checkDisposed();
+        if (input == null || input.length == 0) {
+            return DocumentInfoResult.fail("Input data is empty", SlimLOErrorCode.INVALID_ARGUMENT, null);
+        }
+        if (format != DocumentFormat.DOCX) {
+            return DocumentInfoResult.fail(invalidFormatFailure(format).getErrorMessage(),
+                    SlimLOErrorCode.INVALID_FORMAT, null);
+        }
+
+        Map<String, Object> request = new HashMap<String, Object>();
+        request.put("type", "info");
+        request.put("id", requestId.incrementAndGet());
+        request.put("format", format.getValue());
+        request.put("data_size", (long) input.length);
+
+        return pool.executeInfo(request, input);
+    }
+
+    // ---- Page rendering (no PDF export) ----
+
+    /**
+     * Render pages of a document to images without exporting a PDF.
+     *
+     * @param inputPath path to input document (.docx).
+     * @param options   format, width and pages. Null = 256 px PNG of the first page.
+     * @return result with the images in {@link ConversionResult#getPageImages()}.
+     */
+    public ConversionResult renderPages(String inputPath, RenderOptions options) {
+        checkDisposed();
+        if (inputPath == null || inputPath.isEmpty()) {
+            throw new IllegalArgumentException("inputPath must not be null or empty");
+        }
+
+        File inputFile = new File(inputPath).getAbsoluteFile();
+        if (!inputFile.exists()) {
+            return ConversionResult.fail("Input file not found: " + inputFile.getAbsolutePath(),
+                    SlimLOErrorCode.FILE_NOT_FOUND, null);
+        }
+
+        DocumentFormat format = DocumentFormat.fromExtension(inputPath);
+        if (format != DocumentFormat.DOCX) {
+            return invalidFormatFailure(format);
+        }
+
+        Map<String, Object> request = new HashMap<String, Object>();
+        request.put("type", "render");
+        request.put("id", requestId.incrementAndGet());
+        request.put("input", inputFile.getAbsolutePath());
+        request.put("format", format.getValue());
+        request.put("render", renderMap(options));
+
+        return pool.executeRender(request, null);
+    }
+
+    /**
+     * Render pages of an in-memory document to images without exporting a PDF.
+     *
+     * @param input   input document bytes.
+     * @param format  document format (must be DOCX).
+     * @param options format, width and pages. Null = 256 px PNG of the first page.
+     * @return result with the images in {@link ConversionResult#getPageImages()}.
+     */
+    public ConversionResult renderPages(byte[] input, DocumentFormat format, RenderOptions options) {
+        checkDisposed();
+        if (input == null || input.length == 0) {
+            return ConversionResult.fail("Input data is empty", SlimLOErrorCode.INVALID_ARGUMENT, null);
+        }
+        if (format != DocumentFormat.DOCX) {
+            return invalidFormatFailure(format);
+        }
+
+        Map<String, Object> request = new HashMap<String, Object>();
+        request.put("type", "render");
+        request.put("id", requestId.incrementAndGet());
+        request.put("format", format.getValue());
+        request.put("data_size", (long) input.length);
+        request.put("render", renderMap(options));
+
+        return pool.executeRender(request, input);
+    }
+
+    /**
+     * Register a font directory with the running converter, without restarting
+     * workers. Live workers register its fonts after the conversion they are
+     * running (if any); workers started later get it with
+     * {@link PdfConverterOptions#getFontDirectories()}. Only LibreOffice's font
+     * lists and caches are rebuilt, and adding a directory twice is a no-op.
+     * With a server socket, the server applies the directory to all of its workers.
+     *
+     * @param fontDirectory directory of .ttf/.otf/.ttc/.otc files (subdirectories included).
+     * @return success, or the first failure reported by a worker.
+     */
+    public ConversionResult addFontDirectory(String fontDirectory) {
+        checkDisposed();
+        if (fontDirectory == null || fontDirectory.isEmpty()) {
+            throw new IllegalArgumentException("fontDirectory must not be null or empty");
+        }
+
+        File directory = new File(fontDirectory).getAbsoluteFile();
+        if (!directory.isDirectory()) {
+            return ConversionResult.fail("Font directory not found: " + directory.getPath(),
+                    SlimLOErrorCode.FILE_NOT_FOUND, null);
+        }
+        return pool.addFontDirectory(directory.getPath());
+    }
+
     // ---- Async variants ----
 
     /**
@@ -254,7 +529,7 @@ public final class PdfConverter implements Closeable {
      */
     public CompletableFuture<ConversionResult> convertAsync(
             final String inputPath, final String outputPath, final ConversionOptions options) {
-        return CompletableFuture.supplyAsync(new java.util.function.Supplier<ConversionResult>() {
+        return pool.submit(new java.util.function.Supplier<ConversionResult>() {
             @Override
             public ConversionResult get() {
                 return convert(inputPath, outputPath, options);
@@ -274,7 +549,7 @@ public final class PdfConverter implements Closeable {
      */
     public CompletableFuture<ConversionResult> convertAsync(
             final byte[] input, final DocumentFormat format, final ConversionOptions options) {
-        return CompletableFuture.supplyAsync(new java.util.function.Supplier<ConversionResult>() {
+        return pool.submit(new java.util.function.Supplier<ConversionResult>() {
             @Override
             public ConversionResult get() {
                 return convert(input, format, options);
@@ -282,6 +557,35 @@ public final class PdfConverter implements Closeable {
         });
     }
 
+    /**
+     * Requests currently waiting for a worker. A load balancer can back off
+     * from a node whose queue keeps growing.
+     */
+    public int getQueueLength() {
+        return pool.getQueueLength();
+    }
+
+    /**
+     * Requests rejected so far with {@link SlimLOErrorCode#DEADLINE_EXCEEDED} because
+     * they could not finish before their {@link ConversionOptions#getDeadlineMillis() deadline}.
+     */
+    public long getShedCount() {
+        return pool.getShedCount();
+    }
+
+    /**
+     * Conversions that shared the result of an identical one already in flight
+     * (see {@link PdfConverterOptions#isCoalesceDuplicates()}).
+     */
+    public long getCoalescedCount() {
+        return pool.getCoalescedCount();
+    }
+
+    /** Worker processes currently running or starting, between minWorkers and maxWorkers. */
+    public int getWorkerCount() {
+        return pool.getWorkerCount();
+    }
+
     @Override
     public void close() {
         if (disposed) return;
@@ -300,7 +604,20 @@ public final class PdfConverter implements Closeable {
         request.put("data_size", (long) input.length);
         addOptions(request, options);
 
-        return pool.executeBuffer(request, input);
+        return pool.executeBuffer(request, input, progressListenerOf(options), deadlineOf(options),
+                tenantOf(options));
+    }
+
+    private static ProgressListener progressListenerOf(ConversionOptions options) {
+        return options != null ? options.getProgressListener() : null;
+    }
+
+    private static String tenantOf(ConversionOptions options) {
+        return options != null ? options.getTenant() : null;
+    }
+
+    private static long deadlineOf(ConversionOptions options) {
+        return AdmissionQueue.deadlineAfter(options != null ? options.getDeadlineMillis() : 0);
     }
 
     private static void addOptions(Map<String, Object> request, ConversionOptions options) {
@@ -317,7 +634,42 @@ public final class PdfConverter implements Closeable {
         if (options.getPassword() != null) {
             opts.put("password", options.getPassword());
         }
+        opts.put("preset", options.getPreset().getValue());
+        if (!options.getFilterProperties().isEmpty()) {
+            opts.put("filter_properties", options.getFilterProperties());
+        }
+        if (options.isLazyLayout()) {
+            opts.put("lazy_layout", true);
+        }
+        if (options.isSkipFieldUpdate()) {
+            opts.put("skip_field_update", true);
+        }
         request.put("options", opts);
+
+        if (options.getPageImages() != null) {
+            request.put("render", renderMap(options.getPageImages()));
+        }
+        if (options.getPageText() != null) {
+            Map<String, Object> text = new HashMap<String, Object>();
+            text.put("words", options.getPageText().isIncludeWords());
+            if (options.getPageText().getPageRange() != null) {
+                text.put("page_range", options.getPageText().getPageRange());
+            }
+            request.put("text", text);
+        }
+    }
+
+    private static Map<String, Object> renderMap(RenderOptions options) {
+        if (options == null) {
+            options = RenderOptions.builder().build();
+        }
+        Map<String, Object> render = new HashMap<String, Object>();
+        render.put("format", options.getFormat().getValue());
+        render.put("width", options.getWidth());
+        if (options.getPageRange() != null) {
+            render.put("page_range", options.getPageRange());
+        }
+        return render;
     }
 
     private static ConversionResult invalidFormatFailure(DocumentFormat format) {
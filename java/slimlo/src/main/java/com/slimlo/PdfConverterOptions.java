@@ -1,6 +1,9 @@
 package com.slimlo;
 
+import java.util.Collections;
+import java.util.LinkedHashMap;
 import java.util.List;
+import java.util.Map;
 import java.util.concurrent.TimeUnit;
 
 /**
@@ -12,17 +15,46 @@ public final class PdfConverterOptions {
     private final String resourcePath;
     private final List<String> fontDirectories;
     private final long conversionTimeoutMillis;
+    private final long stallTimeoutMillis;
     private final int maxWorkers;
+    private final int minWorkers;
+    private final long idleTimeoutMillis;
+    private final long memoryBudget;
+    private final int threadsPerWorker;
+    private final WorkerPlacement workerPlacement;
+    private final String serverSocket;
     private final int maxConversionsPerWorker;
     private final boolean warmUp;
+    private final int quarantineAfterCrashes;
+    private final int quarantineCapacity;
+    private final boolean isolateSuspectDocuments;
+    private final Map<String, Integer> tenantWeights;
+    private final int maxWorkersPerTenant;
+    private final boolean coalesceDuplicates;
+    private final MetricsListener metricsListener;
 
     private PdfConverterOptions(Builder builder) {
         this.resourcePath = builder.resourcePath;
         this.fontDirectories = builder.fontDirectories;
         this.conversionTimeoutMillis = builder.conversionTimeoutMillis;
+        this.stallTimeoutMillis = builder.stallTimeoutMillis;
         this.maxWorkers = builder.maxWorkers;
+        this.minWorkers = builder.minWorkers;
+        this.idleTimeoutMillis = builder.idleTimeoutMillis;
+        this.memoryBudget = builder.memoryBudget;
+        this.threadsPerWorker = builder.threadsPerWorker;
+        this.workerPlacement = builder.workerPlacement;
+        this.serverSocket = builder.serverSocket;
         this.maxConversionsPerWorker = builder.maxConversionsPerWorker;
         this.warmUp = builder.warmUp;
+        this.quarantineAfterCrashes = builder.quarantineAfterCrashes;
+        this.quarantineCapacity = builder.quarantineCapacity;
+        this.isolateSuspectDocuments = builder.isolateSuspectDocuments;
+        this.tenantWeights = Collections.unmodifiableMap(
+                new LinkedHashMap<String, Integer>(builder.tenantWeights));
+        this.maxWorkersPerTenant = builder.maxWorkersPerTenant;
+        this.coalesceDuplicates = builder.coalesceDuplicates;
+        this.metricsListener = builder.metricsListener;
     }
 
     /**
@@ -47,6 +79,17 @@ public final class PdfConverterOptions {
         return conversionTimeoutMillis;
     }
 
+    /**
+     * Maximum time in milliseconds a conversion may go without reporting progress.
+     * When set, workers stream progress for every conversion and a worker that stays
+     * silent this long is killed, so a slow but advancing conversion is told apart
+     * from a hung one. The conversion timeout still caps the total time.
+     * 0 (default) = no stall detection.
+     */
+    public long getStallTimeoutMillis() {
+        return stallTimeoutMillis;
+    }
+
     /**
      * Maximum number of worker processes. Each worker handles one conversion at a time.
      * More workers = more parallel conversions, but more memory (~200 MB per worker).
@@ -56,6 +99,68 @@ public final class PdfConverterOptions {
         return maxWorkers;
     }
 
+    /**
+     * Worker processes kept running through quiet periods when an idle timeout is
+     * set; also the number warmUp starts, if non-zero. Between this and maxWorkers
+     * the pool grows with demand, starting spare workers ahead of a rising request
+     * rate. Default: 0.
+     */
+    public int getMinWorkers() {
+        return minWorkers;
+    }
+
+    /**
+     * Stop a worker that has been idle this long (milliseconds), down to minWorkers,
+     * so quiet periods give its memory back. 0 (default) = workers run until the
+     * converter is closed.
+     */
+    public long getIdleTimeoutMillis() {
+        return idleTimeoutMillis;
+    }
+
+    /**
+     * Memory in bytes the pool may fill before it stops starting workers beyond
+     * minWorkers; requests then wait for a running worker. Measured against the
+     * usage of this process's control group. 0 (default) = the cgroup memory
+     * limit, if one is set.
+     */
+    public long getMemoryBudget() {
+        return memoryBudget;
+    }
+
+    /**
+     * Thread budget for LibreOffice's internal pools in each worker (threaded XML
+     * parsing, parallel rendering work). 0 (default) = one thread per core, which
+     * oversubscribes the CPU once several workers run; set it to roughly
+     * cores / maxWorkers. 1 = single-threaded workers.
+     */
+    public int getThreadsPerWorker() {
+        return threadsPerWorker;
+    }
+
+    /**
+     * CPU placement of pool workers. {@link WorkerPlacement#PINNED} gives each worker
+     * its own share of the CPUs within one NUMA node, with node-local memory, so the
+     * OS does not migrate its working set between cores and sockets; a pinned
+     * worker's threadsPerWorker defaults to the size of its share. Applied on Linux
+     * and Windows. Default: {@link WorkerPlacement#NONE}.
+     */
+    public WorkerPlacement getWorkerPlacement() {
+        return workerPlacement;
+    }
+
+    /**
+     * Unix socket of a running slimlo_server to convert on instead of starting
+     * private workers, so every converter on the host shares the server's warm pool.
+     * Each of maxWorkers becomes a connection; the server's resource path, fonts,
+     * thread budget and placement apply, and memoryBudget is not enforced. File-path
+     * conversions need paths the server can read and write. Requires Java 16 or
+     * later at run time. Null (default) = start private workers.
+     */
+    public String getServerSocket() {
+        return serverSocket;
+    }
+
     /**
      * Recycle a worker process after this many conversions.
      * 0 = never recycle. Default: 0.
@@ -65,13 +170,82 @@ public final class PdfConverterOptions {
     }
 
     /**
-     * If true, start worker processes eagerly during create().
+     * If true, start worker processes eagerly during create(): minWorkers of them,
+     * or maxWorkers when no minimum is set.
      * If false (default), workers start lazily on first conversion.
      */
     public boolean isWarmUp() {
         return warmUp;
     }
 
+    /**
+     * Refuse a document once it has crashed a worker process this many times.
+     * Documents are identified by a SHA-256 of their content, so retries and
+     * duplicate submissions of the same file are caught; a refused conversion
+     * fails with {@link SlimLOErrorCode#QUARANTINED} without touching a worker.
+     * 0 = disabled. Default: 2.
+     */
+    public int getQuarantineAfterCrashes() {
+        return quarantineAfterCrashes;
+    }
+
+    /**
+     * Maximum number of crashing documents remembered for quarantine; the least
+     * recently seen are forgotten first. Default: 1024.
+     */
+    public int getQuarantineCapacity() {
+        return quarantineCapacity;
+    }
+
+    /**
+     * If true, a document that already crashed a worker is retried on a dedicated
+     * extra worker process instead of a pool worker, so a second crash does not
+     * cost a warm worker. Default: false.
+     */
+    public boolean isIsolateSuspectDocuments() {
+        return isolateSuspectDocuments;
+    }
+
+    /**
+     * Relative worker shares of tenants ({@link ConversionOptions#getTenant()}) while
+     * several have conversions waiting: a tenant of weight 3 is admitted three times
+     * as often as one of weight 1. Tenants not listed, including the default tenant
+     * (key ""), weigh 1. Empty (default) = all tenants equal.
+     */
+    public Map<String, Integer> getTenantWeights() {
+        return tenantWeights;
+    }
+
+    /**
+     * Maximum number of workers one tenant may occupy at once, so a bulk tenant
+     * always leaves room for the others; its further conversions wait even when
+     * workers are idle. 0 (default) = no cap.
+     */
+    public int getMaxWorkersPerTenant() {
+        return maxWorkersPerTenant;
+    }
+
+    /**
+     * If true, a conversion identical to one already in flight (same document
+     * bytes, or same input file, size and modification time with the same output
+     * path, plus the same options) waits for that conversion instead of running
+     * again, and receives its result. Useful when retries or fan-out submit the
+     * same document many times at once. Only the first caller gets progress
+     * reports; buffer results are shared between callers, not copied.
+     * Default: false.
+     */
+    public boolean isCoalesceDuplicates() {
+        return coalesceDuplicates;
+    }
+
+    /**
+     * Receives queue, conversion, worker and memory metrics from the pool.
+     * Default: {@link MetricsListener#NONE}.
+     */
+    public MetricsListener getMetricsListener() {
+        return metricsListener;
+    }
+
     public static Builder builder() {
         return new Builder();
     }
@@ -80,9 +254,23 @@ public final class PdfConverterOptions {
         private String resourcePath = null;
         private List<String> fontDirectories = null;
         private long conversionTimeoutMillis = 5 * 60 * 1000L; // 5 minutes
+        private long stallTimeoutMillis = 0;
         private int maxWorkers = 1;
+        private int minWorkers = 0;
+        private long idleTimeoutMillis = 0;
+        private long memoryBudget = 0;
+        private int threadsPerWorker = 0;
+        private WorkerPlacement workerPlacement = WorkerPlacement.NONE;
+        private String serverSocket = null;
         private int maxConversionsPerWorker = 0;
         private boolean warmUp = false;
+        private int quarantineAfterCrashes = 2;
+        private int quarantineCapacity = 1024;
+        private boolean isolateSuspectDocuments = false;
+        private final Map<String, Integer> tenantWeights = new LinkedHashMap<String, Integer>();
+        private int maxWorkersPerTenant = 0;
+        private boolean coalesceDuplicates = false;
+        private MetricsListener metricsListener = MetricsListener.NONE;
 
         private Builder() {}
 
@@ -106,11 +294,46 @@ public final class PdfConverterOptions {
             return this;
         }
 
+        public Builder stallTimeout(long duration, TimeUnit unit) {
+            this.stallTimeoutMillis = unit.toMillis(duration);
+            return this;
+        }
+
+        public Builder stallTimeoutMillis(long millis) {
+            this.stallTimeoutMillis = millis;
+            return this;
+        }
+
         public Builder maxWorkers(int maxWorkers) {
             this.maxWorkers = maxWorkers;
             return this;
         }
 
+        public Builder minWorkers(int minWorkers) {
+            this.minWorkers = minWorkers;
+            return this;
+        }
+
+        public Builder idleTimeout(long duration, TimeUnit unit) {
+            this.idleTimeoutMillis = unit.toMillis(duration);
+            return this;
+        }
+
+        public Builder idleTimeoutMillis(long millis) {
+            this.idleTimeoutMillis = millis;
+            return this;
+        }
+
+        public Builder memoryBudget(long bytes) {
+            this.memoryBudget = bytes;
+            return this;
+        }
+
+        public Builder threadsPerWorker(int threadsPerWorker) {
+            this.threadsPerWorker = threadsPerWorker;
+            return this;
+        }
+
         public Builder maxConversionsPerWorker(int maxConversionsPerWorker) {
             this.maxConversionsPerWorker = maxConversionsPerWorker;
             return this;
@@ -121,10 +344,85 @@ public final class PdfConverterOptions {
             return this;
         }
 
+        public Builder quarantineAfterCrashes(int quarantineAfterCrashes) {
+            this.quarantineAfterCrashes = quarantineAfterCrashes;
+            return this;
+        }
+
+        public Builder quarantineCapacity(int quarantineCapacity) {
+            this.quarantineCapacity = quarantineCapacity;
+            return this;
+        }
+
+        public Builder isolateSuspectDocuments(boolean isolateSuspectDocuments) {
+            this.isolateSuspectDocuments = isolateSuspectDocuments;
+            return this;
+        }
+
+        public Builder tenantWeight(String tenant, int weight) {
+            if (weight < 1) {
+                throw new IllegalArgumentException("weight of tenant '" + tenant + "' must be at least 1");
+            }
+            this.tenantWeights.put(tenant != null ? tenant : "", weight);
+            return this;
+        }
+
+        public Builder maxWorkersPerTenant(int maxWorkersPerTenant) {
+            this.maxWorkersPerTenant = maxWorkersPerTenant;
+            return this;
+        }
+
+        public Builder coalesceDuplicates(boolean coalesceDuplicates) {
+            this.coalesceDuplicates = coalesceDuplicates;
+            return this;
+        }
+
+        public Builder workerPlacement(WorkerPlacement workerPlacement) {
+            this.workerPlacement = workerPlacement != null ? workerPlacement : WorkerPlacement.NONE;
+            return this;
+        }
+
+        public Builder serverSocket(String serverSocket) {
+            this.serverSocket = serverSocket;
+            return this;
+        }
+
+        public Builder metricsListener(MetricsListener metricsListener) {
+            this.metricsListener = metricsListener != null ? metricsListener : MetricsListener.NONE;
+            return this;
+        }
+
         public PdfConverterOptions build() {
             if (maxWorkers < 1) {
                 throw new IllegalArgumentException("maxWorkers must be at least 1");
             }
+            if (serverSocket != null && serverSocket.isEmpty()) {
+                throw new IllegalArgumentException("serverSocket must not be empty");
+            }
+            if (minWorkers < 0 || minWorkers > maxWorkers) {
+                throw new IllegalArgumentException("minWorkers must be between 0 and maxWorkers");
+            }
+            if (idleTimeoutMillis < 0) {
+                throw new IllegalArgumentException("idleTimeout must not be negative");
+            }
+            if (memoryBudget < 0) {
+                throw new IllegalArgumentException("memoryBudget must not be negative");
+            }
+            if (stallTimeoutMillis < 0) {
+                throw new IllegalArgumentException("stallTimeout must not be negative");
+            }
+            if (threadsPerWorker < 0) {
+                throw new IllegalArgumentException("threadsPerWorker must not be negative");
+            }
+            if (quarantineAfterCrashes < 0) {
+                throw new IllegalArgumentException("quarantineAfterCrashes must not be negative");
+            }
+            if (quarantineAfterCrashes > 0 && quarantineCapacity < 1) {
+                throw new IllegalArgumentException("quarantineCapacity must be at least 1");
+            }
+            if (maxWorkersPerTenant < 0) {
+                throw new IllegalArgumentException("maxWorkersPerTenant must not be negative");
+            }
             return new PdfConverterOptions(this);
         }
     }
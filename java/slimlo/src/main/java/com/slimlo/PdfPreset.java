@@ -0,0 +1,29 @@
+package com.slimlo;
+
+/**
+ * PDF export preset: a bundle of filter settings tuned for a use case.
+ * Values match the native SlimLOPdfPreset enum in slimlo.h.
+ * Explicit {@link ConversionOptions} fields override the preset.
+ */
+public enum PdfPreset {
+    /** No preset: LibreOffice defaults plus explicit options. */
+    NONE(0),
+    /** Lowest latency: no bookmarks, tagging, form fields or image processing. */
+    FAST(1),
+    /** Smallest output: JPEG quality 60, images downsampled to 150 DPI. */
+    SMALL(2),
+    /** PDF/A-2b, tagged, with bookmarks and all fonts embedded. */
+    ARCHIVAL(3),
+    /** Print fidelity: lossless images at full resolution, all fonts embedded. */
+    PRINT(4);
+
+    private final int value;
+
+    PdfPreset(int value) {
+        this.value = value;
+    }
+
+    public int getValue() {
+        return value;
+    }
+}
@@ -0,0 +1,18 @@
+package com.slimlo;
+
+import java.nio.ByteBuffer;
+
+/**
+ * Reads a PDF that is only valid for the duration of the call.
+ * See {@link InProcessConverter#convert(byte[], DocumentFormat, ConversionOptions, PdfReader)}.
+ *
+ * @param <T> the value produced from the PDF.
+ */
+public interface PdfReader<T> {
+
+    /**
+     * @param pdf read-only direct buffer over native memory, released when this method
+     *            returns; do not keep a reference to it.
+     */
+    T read(ByteBuffer pdf) throws Exception;
+}
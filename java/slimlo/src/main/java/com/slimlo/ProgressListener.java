@@ -0,0 +1,10 @@
+package com.slimlo;
+
+/**
+ * Receives progress updates during a conversion.
+ * Called on the SDK's worker I/O thread; implementations should return quickly.
+ */
+public interface ProgressListener {
+
+    void onProgress(ConversionProgress progress);
+}
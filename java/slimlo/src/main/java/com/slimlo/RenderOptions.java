@@ -0,0 +1,70 @@
+package com.slimlo;
+
+/**
+ * Options for rendering document pages to images.
+ * Use {@link #builder()} to create instances.
+ */
+public final class RenderOptions {
+
+    private final PageImageFormat format;
+    private final int width;
+    private final String pageRange;
+
+    private RenderOptions(Builder builder) {
+        this.format = builder.format;
+        this.width = builder.width;
+        this.pageRange = builder.pageRange;
+    }
+
+    /** Output format. Default: PNG. */
+    public PageImageFormat getFormat() {
+        return format;
+    }
+
+    /**
+     * Image width in pixels, 1-8192. 0 = default (256). The height follows the
+     * page's aspect ratio.
+     */
+    public int getWidth() {
+        return width;
+    }
+
+    /**
+     * Pages to render, e.g. "1", "1-3,5" or "2-". Null = first page.
+     * Pages past the end of the document are skipped.
+     */
+    public String getPageRange() {
+        return pageRange;
+    }
+
+    public static Builder builder() {
+        return new Builder();
+    }
+
+    public static final class Builder {
+        private PageImageFormat format = PageImageFormat.PNG;
+        private int width = 0;
+        private String pageRange = null;
+
+        private Builder() {}
+
+        public Builder format(PageImageFormat format) {
+            this.format = format;
+            return this;
+        }
+
+        public Builder width(int width) {
+            this.width = width;
+            return this;
+        }
+
+        public Builder pageRange(String pageRange) {
+            this.pageRange = pageRange;
+            return this;
+        }
+
+        public RenderOptions build() {
+            return new RenderOptions(this);
+        }
+    }
+}
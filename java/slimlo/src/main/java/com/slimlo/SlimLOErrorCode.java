@@ -16,6 +16,10 @@ public enum SlimLOErrorCode {
     ALREADY_INITIALIZED(8),
     NOT_INITIALIZED(9),
     INVALID_ARGUMENT(10),
+    /** Refused by the worker pool: the document crashed a worker process too many times. */
+    QUARANTINED(11),
+    /** Shed by the worker pool: the request could not finish before its deadline. */
+    DEADLINE_EXCEEDED(12),
     UNKNOWN(99);
 
     private final int value;
@@ -0,0 +1,54 @@
+package com.slimlo;
+
+/**
+ * Options for extracting page text alongside a conversion.
+ * Use {@link #builder()} to create instances.
+ */
+public final class TextOptions {
+
+    private final boolean includeWords;
+    private final String pageRange;
+
+    private TextOptions(Builder builder) {
+        this.includeWords = builder.includeWords;
+        this.pageRange = builder.pageRange;
+    }
+
+    /** Whether a bounding box is reported for every word. Default: false. */
+    public boolean isIncludeWords() {
+        return includeWords;
+    }
+
+    /**
+     * Pages to extract, e.g. "1", "1-3,5" or "2-". Null = all pages.
+     * Pages past the end of the document are skipped.
+     */
+    public String getPageRange() {
+        return pageRange;
+    }
+
+    public static Builder builder() {
+        return new Builder();
+    }
+
+    public static final class Builder {
+        private boolean includeWords = false;
+        private String pageRange = null;
+
+        private Builder() {}
+
+        public Builder includeWords(boolean includeWords) {
+            this.includeWords = includeWords;
+            return this;
+        }
+
+        public Builder pageRange(String pageRange) {
+            this.pageRange = pageRange;
+            return this;
+        }
+
+        public TextOptions build() {
+            return new TextOptions(this);
+        }
+    }
+}
@@ -0,0 +1,51 @@
+package com.slimlo;
+
+/**
+ * A word and its bounding box, in points from the page's top-left corner.
+ */
+public final class WordBox {
+
+    private final double x;
+    private final double y;
+    private final double width;
+    private final double height;
+    private final String text;
+
+    public WordBox(double x, double y, double width, double height, String text) {
+        this.x = x;
+        this.y = y;
+        this.width = width;
+        this.height = height;
+        this.text = text;
+    }
+
+    /** Left edge in points. */
+    public double getX() {
+        return x;
+    }
+
+    /** Top edge in points. */
+    public double getY() {
+        return y;
+    }
+
+    /** Width in points. */
+    public double getWidth() {
+        return width;
+    }
+
+    /** Height in points. */
+    public double getHeight() {
+        return height;
+    }
+
+    /** The word. */
+    public String getText() {
+        return text;
+    }
+
+    @Override
+    public String toString() {
+        return "\"" + text + "\" at " + x + "," + y + " (" + width + "x" + height + " pt)";
+    }
+}
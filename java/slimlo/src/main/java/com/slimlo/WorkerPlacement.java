@@ -0,0 +1,14 @@
+package com.slimlo;
+
+/**
+ * How pool workers are placed on the machine's CPUs.
+ */
+public enum WorkerPlacement {
+    /** The OS scheduler may run and migrate workers on any CPU. */
+    NONE,
+    /**
+     * Each worker is pinned to its own share of the CPUs, taken from one NUMA node
+     * (workers alternate between nodes), with memory allocated on that node.
+     */
+    PINNED
+}
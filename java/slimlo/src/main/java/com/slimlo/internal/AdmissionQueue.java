@@ -0,0 +1,295 @@
+package com.slimlo.internal;
+
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.Map;
+import java.util.PriorityQueue;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicLong;
+
+/**
+ * Admission gate of the worker pool: hands out one slot per worker, sharing
+ * them across tenants by weighted fair queuing. Each tenant (null = the
+ * default tenant) has its own queue, ordered earliest-deadline-first with
+ * requests without a deadline last, FIFO. A freed slot goes to the head of
+ * the eligible tenant with the least weighted service so far (a tenant of
+ * weight 2 gets twice the admissions of a tenant of weight 1 while both wait),
+ * and a tenant at its concurrency cap is passed over.
+ * A request that cannot finish before its deadline, estimated from recent
+ * service times, is shed instead of queued; one still queued when its
+ * deadline passes, or found infeasible when a slot frees, is shed as well.
+ * Deadlines are {@link System#nanoTime()} values. Thread-safe.
+ */
+public final class AdmissionQueue {
+
+    /** Deadline of requests that may wait indefinitely. */
+    public static final long NO_DEADLINE = Long.MAX_VALUE;
+
+    private final int slots;
+    private final Map<String, Integer> weights;
+    private final int maxPerTenant;
+    private final Map<String, Tenant> tenants = new HashMap<String, Tenant>();
+    private final AtomicLong shedCount = new AtomicLong();
+    private int free;
+    private int queued;
+    private long sequence;
+    private double virtualTime; // virtual start time of the last admission
+    private double serviceNanos; // moving average, 0 = no sample yet
+
+    /**
+     * Per-tenant state. Tenants exist only while they have requests queued or
+     * running, so an idle tenant rejoins at the current virtual time and does
+     * not bank credit for a later burst.
+     */
+    private static final class Tenant {
+        final String key;
+        final int weight;
+        final PriorityQueue<Waiter> waiters = new PriorityQueue<Waiter>();
+        int running;
+        double virtualTime; // admissions so far divided by weight
+
+        Tenant(String key, int weight) {
+            this.key = key;
+            this.weight = weight;
+        }
+    }
+
+    private static final class Waiter implements Comparable<Waiter> {
+        final Tenant tenant;
+        final long deadline;
+        final long sequence;
+        boolean admitted;
+        boolean shed;
+
+        Waiter(Tenant tenant, long deadline, long sequence) {
+            this.tenant = tenant;
+            this.deadline = deadline;
+            this.sequence = sequence;
+        }
+
+        @Override
+        public int compareTo(Waiter other) {
+            // Deadlines are compared directly: nanoTime wrap-around is not a concern
+            // within a process's lifetime, and NO_DEADLINE must sort last
+            int c = Long.compare(deadline, other.deadline);
+            return c != 0 ? c : Long.compare(sequence, other.sequence);
+        }
+    }
+
+    public AdmissionQueue(int slots) {
+        this(slots, null, 0);
+    }
+
+    /**
+     * @param slots        requests admitted at once
+     * @param weights      tenant weights; tenants not listed weigh 1
+     * @param maxPerTenant slots one tenant may hold at once, 0 = no cap
+     */
+    public AdmissionQueue(int slots, Map<String, Integer> weights, int maxPerTenant) {
+        this.slots = slots;
+        this.free = slots;
+        this.weights = weights != null
+                ? new HashMap<String, Integer>(weights) : Collections.<String, Integer>emptyMap();
+        this.maxPerTenant = maxPerTenant;
+    }
+
+    /** Requests waiting for a slot. */
+    public synchronized int getQueueLength() {
+        return queued;
+    }
+
+    /** Requests of one tenant waiting for a slot. */
+    public synchronized int getQueueLength(String tenant) {
+        Tenant t = tenants.get(tenant != null ? tenant : "");
+        return t != null ? t.waiters.size() : 0;
+    }
+
+    /** Requests rejected because they could not finish before their deadline. */
+    public long getShedCount() {
+        return shedCount.get();
+    }
+
+    /** Moving average of recent service times in milliseconds, or 0 before the first sample. */
+    public synchronized long getEstimatedServiceMillis() {
+        return TimeUnit.NANOSECONDS.toMillis((long) serviceNanos);
+    }
+
+    /** Absolute deadline for a request submitted now, or {@link #NO_DEADLINE} for a timeout of 0. */
+    public static long deadlineAfter(long timeoutMillis) {
+        if (timeoutMillis <= 0) {
+            return NO_DEADLINE;
+        }
+        long now = System.nanoTime();
+        long nanos = TimeUnit.MILLISECONDS.toNanos(timeoutMillis);
+        return nanos >= NO_DEADLINE - now ? NO_DEADLINE : now + nanos;
+    }
+
+    /**
+     * Wait for a slot. Returns true once admitted (the caller must call
+     * {@link #release(String)} with the same tenant), false if the request was shed.
+     */
+    public synchronized boolean acquire(String tenant, long deadline) throws InterruptedException {
+        long now = System.nanoTime();
+        Tenant t = tenantOf(tenant != null ? tenant : "");
+
+        double ahead = free > 0 && queued == 0 && !atCap(t)
+                ? 0
+                : (deadline == NO_DEADLINE ? queued : countAhead(deadline)) + 0.5;
+        if (!canFinish(now, deadline, ahead)) {
+            removeIfIdle(t);
+            shedCount.incrementAndGet();
+            return false;
+        }
+
+        // A tenant starting a new backlog catches up with the others' virtual time
+        if (t.waiters.isEmpty()) {
+            t.virtualTime = Math.max(t.virtualTime, virtualTime);
+        }
+        Waiter waiter = new Waiter(t, deadline, ++sequence);
+        t.waiters.add(waiter);
+        queued++;
+        dispatch(now);
+        try {
+            while (!waiter.admitted && !waiter.shed) {
+                if (deadline == NO_DEADLINE) {
+                    wait();
+                    continue;
+                }
+                long remaining = deadline - System.nanoTime();
+                if (remaining <= 0) {
+                    dequeue(waiter);
+                    waiter.shed = true;
+                    shedCount.incrementAndGet();
+                    break;
+                }
+                TimeUnit.NANOSECONDS.timedWait(this, remaining);
+            }
+        } catch (InterruptedException e) {
+            if (waiter.admitted) {
+                // Admitted while being interrupted: hand the slot on
+                release(tenant);
+            } else {
+                dequeue(waiter);
+            }
+            throw e;
+        }
+        return waiter.admitted;
+    }
+
+    /** Return a tenant's slot and admit the next feasible waiter. */
+    public synchronized void release(String tenant) {
+        Tenant t = tenants.get(tenant != null ? tenant : "");
+        if (t != null && t.running > 0) {
+            t.running--;
+            removeIfIdle(t);
+        }
+        free++;
+        dispatch(System.nanoTime());
+    }
+
+    /** Feed the service-time estimate with one finished request. */
+    public synchronized void recordServiceTime(long elapsedNanos) {
+        serviceNanos = serviceNanos > 0 ? 0.8 * serviceNanos + 0.2 * elapsedNanos : elapsedNanos;
+    }
+
+    /**
+     * Whether a request starting after about {@code queuedAhead} others can finish
+     * by its deadline. Rough: the slots drain the queue at one request per average
+     * service time each. Unknown service time is assumed feasible.
+     */
+    private boolean canFinish(long now, long deadline, double queuedAhead) {
+        if (deadline == NO_DEADLINE) {
+            return true;
+        }
+        if (now - deadline >= 0) {
+            return false;
+        }
+        return serviceNanos <= 0 || serviceNanos * (1 + queuedAhead / slots) <= deadline - now;
+    }
+
+    /** Waiters of any tenant due no later than {@code deadline}. */
+    private int countAhead(long deadline) {
+        int count = 0;
+        for (Tenant t : tenants.values()) {
+            for (Waiter w : t.waiters) {
+                if (w.deadline <= deadline) {
+                    count++;
+                }
+            }
+        }
+        return count;
+    }
+
+    /**
+     * Hand free slots to waiters: each goes to the head of the eligible tenant
+     * with the lowest virtual time (ties to the longest waiting). Heads that can
+     * no longer meet their deadline are shed on the way.
+     */
+    private void dispatch(long now) {
+        boolean changed = false;
+        while (free > 0 && queued > 0) {
+            Tenant best = null;
+            for (Tenant t : tenants.values()) {
+                if (t.waiters.isEmpty() || atCap(t)) {
+                    continue;
+                }
+                if (best == null || t.virtualTime < best.virtualTime
+                        || (t.virtualTime == best.virtualTime
+                            && t.waiters.peek().sequence < best.waiters.peek().sequence)) {
+                    best = t;
+                }
+            }
+            if (best == null) {
+                break; // everyone waiting is at their tenant's cap
+            }
+
+            Waiter next = best.waiters.poll();
+            queued--;
+            changed = true;
+            if (!canFinish(now, next.deadline, 0)) {
+                next.shed = true;
+                shedCount.incrementAndGet();
+                removeIfIdle(best);
+                continue;
+            }
+
+            free--;
+            best.running++;
+            virtualTime = best.virtualTime;
+            best.virtualTime += 1.0 / best.weight;
+            next.admitted = true;
+        }
+        if (changed) {
+            notifyAll();
+        }
+    }
+
+    private Tenant tenantOf(String key) {
+        Tenant t = tenants.get(key);
+        if (t == null) {
+            Integer weight = weights.get(key);
+            t = new Tenant(key, weight != null ? weight : 1);
+            t.virtualTime = virtualTime;
+            tenants.put(key, t);
+        }
+        return t;
+    }
+
+    private boolean atCap(Tenant t) {
+        return maxPerTenant > 0 && t.running >= maxPerTenant;
+    }
+
+    private void removeIfIdle(Tenant t) {
+        if (t.running == 0 && t.waiters.isEmpty()) {
+            tenants.remove(t.key);
+        }
+    }
+
+    /** Take a waiter out of its queue, if still queued. */
+    private void dequeue(Waiter waiter) {
+        if (waiter.tenant.waiters.remove(waiter)) {
+            queued--;
+            removeIfIdle(waiter.tenant);
+        }
+    }
+}
@@ -0,0 +1,137 @@
+package com.slimlo.internal;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Set;
+import java.util.TreeMap;
+
+/**
+ * CPUs available to this process grouped by NUMA node, read from sysfs
+ * (/sys/devices/system/node/node*&#47;cpulist) and restricted to the process's
+ * affinity (Cpus_allowed_list in /proc/self/status), and the split of those
+ * CPUs between pool workers for {@link com.slimlo.WorkerPlacement#PINNED}.
+ * Outside Linux, or when the files cannot be read, all CPUs form one node.
+ */
+public final class CpuTopology {
+
+    public static final String DEFAULT_ROOT = "/sys/devices/system/node";
+    public static final String DEFAULT_STATUS = "/proc/self/status";
+
+    private CpuTopology() {}
+
+    /** CPU ids of each NUMA node that has CPUs this process may use. */
+    public static List<List<Integer>> nodes(String root, String status) {
+        Set<Integer> allowed = readAllowed(Paths.get(status));
+        TreeMap<Integer, List<Integer>> nodes = new TreeMap<Integer, List<Integer>>();
+        File[] dirs = new File(root).listFiles();
+        try {
+            for (int i = 0; dirs != null && i < dirs.length; i++) {
+                String name = dirs[i].getName();
+                if (!name.matches("node\\d+")) {
+                    continue;
+                }
+                Path cpuList = dirs[i].toPath().resolve("cpulist");
+                if (!Files.isRegularFile(cpuList)) {
+                    continue;
+                }
+                List<Integer> cpus = parseCpuList(new String(Files.readAllBytes(cpuList), StandardCharsets.US_ASCII));
+                if (cpus == null) {
+                    continue;
+                }
+                if (allowed != null) {
+                    cpus.retainAll(allowed);
+                }
+                if (!cpus.isEmpty()) {
+                    nodes.put(Integer.parseInt(name.substring(4)), cpus);
+                }
+            }
+        } catch (IOException | SecurityException | NumberFormatException e) {
+            nodes.clear();
+        }
+
+        if (nodes.isEmpty()) {
+            List<Integer> all = new ArrayList<Integer>();
+            if (allowed != null) {
+                all.addAll(allowed);
+                Collections.sort(all);
+            } else {
+                for (int cpu = 0; cpu < Runtime.getRuntime().availableProcessors(); cpu++) {
+                    all.add(cpu);
+                }
+            }
+            return Collections.singletonList(all);
+        }
+        return new ArrayList<List<Integer>>(nodes.values());
+    }
+
+    /**
+     * Split the CPUs between {@code workers} workers: worker i goes to node
+     * i mod nodes, and each node's CPUs are divided into contiguous, equal shares
+     * between the workers it holds. With more workers than CPUs on a node, each
+     * worker gets one CPU, shared by neighbouring workers.
+     */
+    public static List<List<Integer>> partition(List<List<Integer>> nodes, int workers) {
+        List<List<Integer>> sets = new ArrayList<List<Integer>>(workers);
+        int n = nodes.size();
+        for (int i = 0; i < workers; i++) {
+            List<Integer> cpus = nodes.get(i % n);
+            int onNode = (workers - i % n + n - 1) / n;
+            int rank = i / n;
+            int start = rank * cpus.size() / onNode;
+            int end = (rank + 1) * cpus.size() / onNode;
+            sets.add(onNode <= cpus.size()
+                    ? new ArrayList<Integer>(cpus.subList(start, end))
+                    : Collections.singletonList(cpus.get(start)));
+        }
+        return sets;
+    }
+
+    /** Parse a kernel CPU list such as "0-3,8-11,16"; null if malformed. */
+    static List<Integer> parseCpuList(String text) {
+        List<Integer> cpus = new ArrayList<Integer>();
+        for (String part : text.trim().split(",")) {
+            if (part.isEmpty()) {
+                continue;
+            }
+            String[] range = part.split("-", -1);
+            try {
+                int first = Integer.parseInt(range[0]);
+                int last = range.length == 2 ? Integer.parseInt(range[1]) : first;
+                if (range.length > 2 || first < 0 || last < first) {
+                    return null;
+                }
+                for (int cpu = first; cpu <= last; cpu++) {
+                    cpus.add(cpu);
+                }
+            } catch (NumberFormatException e) {
+                return null;
+            }
+        }
+        return cpus;
+    }
+
+    private static Set<Integer> readAllowed(Path status) {
+        try {
+            if (!Files.isRegularFile(status)) {
+                return null;
+            }
+            for (String line : Files.readAllLines(status, StandardCharsets.US_ASCII)) {
+                if (line.startsWith("Cpus_allowed_list:")) {
+                    List<Integer> cpus = parseCpuList(line.substring("Cpus_allowed_list:".length()));
+                    return cpus != null && !cpus.isEmpty() ? new HashSet<Integer>(cpus) : null;
+                }
+            }
+        } catch (IOException | SecurityException e) {
+            return null;
+        }
+        return null;
+    }
+}
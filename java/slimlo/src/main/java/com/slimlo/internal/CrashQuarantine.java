@@ -0,0 +1,110 @@
+package com.slimlo.internal;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.nio.file.Files;
+import java.nio.file.Paths;
+import java.security.MessageDigest;
+import java.security.NoSuchAlgorithmException;
+import java.util.LinkedHashMap;
+import java.util.Map;
+
+/**
+ * Bounded record of documents that crashed a worker process, keyed by a
+ * SHA-256 of the document bytes. A document that crashed a worker
+ * {@code threshold} times is quarantined and refused before dispatch, so
+ * retries and duplicate submissions stop killing warm workers.
+ * Least recently seen entries are evicted once {@code capacity} is reached.
+ * Thread-safe.
+ */
+public final class CrashQuarantine {
+
+    private final int threshold;
+    private final Map<String, Integer> crashes;
+
+    public CrashQuarantine(int threshold, final int capacity) {
+        this.threshold = threshold;
+        this.crashes = new LinkedHashMap<String, Integer>(16, 0.75f, true) {
+            @Override
+            protected boolean removeEldestEntry(Map.Entry<String, Integer> eldest) {
+                return size() > capacity;
+            }
+        };
+    }
+
+    /** Crashes after which a document is refused. */
+    public int getThreshold() {
+        return threshold;
+    }
+
+    /** Number of documents currently tracked (suspects and quarantined). */
+    public synchronized int size() {
+        return crashes.size();
+    }
+
+    /** Key for an in-memory document. */
+    public static String keyOf(byte[] data) {
+        MessageDigest sha = sha256();
+        return toHex(sha.digest(data));
+    }
+
+    /**
+     * Key for a document file, from its content so copies of the same attachment
+     * under different paths share an entry. Null if the file cannot be read;
+     * the worker then reports the error itself.
+     */
+    public static String keyOfFile(String path) {
+        MessageDigest sha = sha256();
+        byte[] buf = new byte[81920];
+        try (InputStream in = Files.newInputStream(Paths.get(path))) {
+            int n;
+            while ((n = in.read(buf)) > 0) {
+                sha.update(buf, 0, n);
+            }
+        } catch (IOException | RuntimeException e) {
+            return null;
+        }
+        return toHex(sha.digest());
+    }
+
+    /** Crashes recorded for a document (0 if unknown). */
+    public synchronized int crashCount(String key) {
+        Integer count = crashes.get(key);
+        return count != null ? count : 0;
+    }
+
+    /** Whether the document reached the crash threshold. */
+    public boolean isQuarantined(String key) {
+        return crashCount(key) >= threshold;
+    }
+
+    /**
+     * Record that the document crashed a worker.
+     * Returns the document's crash count including this one.
+     */
+    public synchronized int recordCrash(String key) {
+        Integer count = crashes.get(key);
+        int updated = count != null ? count + 1 : 1;
+        crashes.put(key, updated);
+        return updated;
+    }
+
+    private static MessageDigest sha256() {
+        try {
+            return MessageDigest.getInstance("SHA-256");
+        } catch (NoSuchAlgorithmException e) {
+            // Every Java platform is required to provide SHA-256
+            throw new IllegalStateException(e);
+        }
+    }
+
+    private static String toHex(byte[] hash) {
+        char[] digits = "0123456789ABCDEF".toCharArray();
+        char[] chars = new char[hash.length * 2];
+        for (int i = 0; i < hash.length; i++) {
+            chars[i * 2] = digits[(hash[i] >> 4) & 0xF];
+            chars[i * 2 + 1] = digits[hash[i] & 0xF];
+        }
+        return new String(chars);
+    }
+}
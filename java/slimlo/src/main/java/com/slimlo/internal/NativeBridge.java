@@ -0,0 +1,136 @@
+package com.slimlo.internal;
+
+import com.slimlo.ConversionOptions;
+
+import java.io.File;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.Map;
+
+/**
+ * JNI bindings to the SlimLO native library (slimlo_jni.c), used by
+ * {@link com.slimlo.InProcessConverter} on its LibreOffice thread.
+ * Strings cross as NUL-terminated UTF-8; options as the arrays packed by
+ * {@link #options(ConversionOptions)} and {@link #strings(ConversionOptions)}.
+ */
+public final class NativeBridge {
+
+    private static boolean loaded;
+
+    private NativeBridge() {}
+
+    /**
+     * Load libslimlo and the JNI bridge from {@code resourcePath/program}.
+     * libslimlo is loaded first so the bridge resolves it from there on every platform.
+     */
+    public static synchronized void load(String resourcePath) {
+        if (loaded) {
+            return;
+        }
+        File programDir = new File(resourcePath, "program");
+        File bridge = new File(programDir, System.mapLibraryName("slimlo_jni"));
+        if (!bridge.isFile()) {
+            throw new UnsatisfiedLinkError("JNI bridge not found: " + bridge.getAbsolutePath()
+                    + " (libslimlo_jni is built only when a JDK is found)");
+        }
+        System.load(new File(programDir, System.mapLibraryName("slimlo")).getAbsolutePath());
+        System.load(bridge.getAbsolutePath());
+        loaded = true;
+    }
+
+    // ---- Native methods (one thread at a time) ----
+
+    /** slimlo_init_ex; 0 on failure (see {@link #errorMessage(long)} with handle 0). */
+    public static native long init(byte[] resourcePath, int threads);
+
+    public static native void destroy(long handle);
+
+    public static native int convertFile(long handle, byte[] inputPath, byte[] outputPath,
+                                         int format, int[] options, byte[][] strings);
+
+    /** Converts a byte[] range; on success {@code out} = {PDF pointer, PDF size}. */
+    public static native int convertArray(long handle, byte[] input, int offset, int length,
+                                          int format, int[] options, byte[][] strings, long[] out);
+
+    /** Converts a direct ByteBuffer range in place; on success {@code out} = {PDF pointer, PDF size}. */
+    public static native int convertDirect(long handle, ByteBuffer input, int offset, int length,
+                                           int format, int[] options, byte[][] strings, long[] out);
+
+    /** A direct buffer over a converted PDF, valid until {@link #freeBuffer(long)}. */
+    public static native ByteBuffer wrap(long pointer, long size);
+
+    /** A converted PDF copied into a new array. */
+    public static native byte[] copy(long pointer, long size);
+
+    public static native void freeBuffer(long pointer);
+
+    /** slimlo_add_font_directory. */
+    public static native int addFontDirectory(long handle, byte[] path);
+
+    /** Last error message of {@code handle} as UTF-8 (0: init errors). */
+    private static native byte[] errorMessageUtf8(long handle);
+
+    public static String errorMessage(long handle) {
+        byte[] message = errorMessageUtf8(handle);
+        return message != null ? new String(message, StandardCharsets.UTF_8) : "";
+    }
+
+    // ---- Marshalling ----
+
+    /** NUL-terminated UTF-8, or null. */
+    public static byte[] utf8(String value) {
+        if (value == null) {
+            return null;
+        }
+        byte[] bytes = value.getBytes(StandardCharsets.UTF_8);
+        byte[] terminated = new byte[bytes.length + 1];
+        System.arraycopy(bytes, 0, terminated, 0, bytes.length);
+        return terminated;
+    }
+
+    /** pdf_version, jpeg_quality, dpi, tagged_pdf, preset, lazy_layout, skip_field_update. */
+    public static int[] options(ConversionOptions options) {
+        if (options == null) {
+            return new int[7];
+        }
+        return new int[] {
+                options.getPdfVersion().getValue(),
+                options.getJpegQuality(),
+                options.getDpi(),
+                options.isTaggedPdf() ? 1 : 0,
+                options.getPreset().getValue(),
+                options.isLazyLayout() ? 1 : 0,
+                options.isSkipFieldUpdate() ? 1 : 0
+        };
+    }
+
+    /** page_range, password, filter_options. */
+    public static byte[][] strings(ConversionOptions options) {
+        if (options == null) {
+            return new byte[3][];
+        }
+        return new byte[][] {
+                utf8(options.getPageRange()),
+                utf8(options.getPassword()),
+                utf8(filterOptions(options.getFilterProperties()))
+        };
+    }
+
+    /** Filter properties in the "Key=Value,..." form of SlimLOPdfOptions.filter_options, or null. */
+    public static String filterOptions(Map<String, String> properties) {
+        if (properties == null || properties.isEmpty()) {
+            return null;
+        }
+        StringBuilder sb = new StringBuilder();
+        for (Map.Entry<String, String> entry : properties.entrySet()) {
+            if (entry.getKey() == null || entry.getKey().isEmpty()) {
+                continue;
+            }
+            if (sb.length() > 0) {
+                sb.append(',');
+            }
+            sb.append(entry.getKey()).append('=').append(entry.getValue());
+        }
+        return sb.length() > 0 ? sb.toString() : null;
+    }
+}
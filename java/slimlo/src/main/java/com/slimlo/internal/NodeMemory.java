@@ -0,0 +1,64 @@
+package com.slimlo.internal;
+
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+
+/**
+ * Memory limit and usage of the control group this process runs in, read from
+ * cgroup v2 (memory.max, memory.current) or v1 (memory.limit_in_bytes,
+ * memory.usage_in_bytes). Worker processes are children of this process and
+ * count against the same group. Values are null outside Linux, when no limit
+ * is set, or when the files cannot be read.
+ */
+public final class NodeMemory {
+
+    public static final String DEFAULT_ROOT = "/sys/fs/cgroup";
+
+    // v1 reports "no limit" as a page-aligned value near Long.MAX_VALUE
+    private static final long UNLIMITED_V1 = Long.MAX_VALUE / 2;
+
+    private NodeMemory() {}
+
+    /** Memory limit in bytes, or null if unlimited or unknown. */
+    public static Long limit(String root) {
+        Long limit = readBytes(Paths.get(root, "memory.max"));
+        if (limit == null) {
+            limit = readBytes(Paths.get(root, "memory", "memory.limit_in_bytes"));
+        }
+        return limit != null && limit < UNLIMITED_V1 ? limit : null;
+    }
+
+    /** Memory in use by the group in bytes, or null if unknown. */
+    public static Long usage(String root) {
+        Long usage = readBytes(Paths.get(root, "memory.current"));
+        return usage != null ? usage : readBytes(Paths.get(root, "memory", "memory.usage_in_bytes"));
+    }
+
+    /** Parse a cgroup memory file: a byte count, or "max" for no limit. */
+    static Long parseBytes(String text) {
+        text = text.trim();
+        if (text.equals("max")) {
+            return Long.MAX_VALUE;
+        }
+        try {
+            long bytes = Long.parseLong(text);
+            return bytes >= 0 ? bytes : null;
+        } catch (NumberFormatException e) {
+            return null;
+        }
+    }
+
+    private static Long readBytes(Path path) {
+        try {
+            if (!Files.isRegularFile(path)) {
+                return null;
+            }
+            return parseBytes(new String(Files.readAllBytes(path), StandardCharsets.US_ASCII));
+        } catch (IOException | SecurityException e) {
+            return null;
+        }
+    }
+}
@@ -15,10 +15,14 @@ import java.nio.charset.StandardCharsets;
 /**
  * IPC protocol for communication with the native slimlo_worker process.
  * Messages are framed as: [4-byte LE uint32 length][UTF-8 JSON payload]
+ * Chunked bodies are a run of non-empty frames ended by a zero-length frame.
  */
 public final class Protocol {
 
     private static final int MAX_MESSAGE_SIZE = 256 * 1024 * 1024; // 256 MB
+    // Frame size when sending a chunked body; the worker answers in 1 MB frames
+    private static final int WRITE_CHUNK_SIZE = 256 * 1024;
+    private static final int READ_CHUNK_SIZE = 64 * 1024;
     private static final Gson GSON = new GsonBuilder()
             .disableHtmlEscaping()
             .create();
@@ -61,6 +65,42 @@ public final class Protocol {
         return payload;
     }
 
+    /**
+     * Send {@code source} as a chunked body: one frame per {@code WRITE_CHUNK_SIZE}
+     * bytes read, then a zero-length terminator. Only one chunk is buffered at a time.
+     *
+     * @return the number of bytes sent
+     */
+    public static long writeChunked(OutputStream out, InputStream source) throws IOException {
+        byte[] buffer = new byte[4 + WRITE_CHUNK_SIZE];
+        ByteBuffer header = ByteBuffer.wrap(buffer).order(ByteOrder.LITTLE_ENDIAN);
+        long total = 0;
+        while (true) {
+            int read = readExact(source, buffer, 4, WRITE_CHUNK_SIZE);
+            if (read > 0) {
+                header.putInt(0, read);
+                out.write(buffer, 0, 4 + read);
+                total += read;
+            }
+            if (read < WRITE_CHUNK_SIZE) {
+                break;
+            }
+        }
+        header.putInt(0, 0);
+        out.write(buffer, 0, 4);
+        out.flush();
+        return total;
+    }
+
+    /**
+     * Copy a chunked body to {@code destination} frame by frame, as it arrives.
+     * Returns false on EOF (worker process died); the destination may then hold
+     * part of the body.
+     */
+    public static boolean readChunked(InputStream in, OutputStream destination) throws IOException {
+        return new FrameReader(in).readChunked(destination);
+    }
+
     /**
      * Serialize an object to UTF-8 JSON bytes.
      */
@@ -72,7 +112,14 @@ public final class Protocol {
      * Deserialize UTF-8 JSON bytes to a JsonObject.
      */
     public static JsonObject deserialize(byte[] data) {
-        String json = new String(data, StandardCharsets.UTF_8);
+        return deserialize(data, 0, data.length);
+    }
+
+    /**
+     * Deserialize {@code length} bytes of UTF-8 JSON starting at {@code offset}.
+     */
+    public static JsonObject deserialize(byte[] data, int offset, int length) {
+        String json = new String(data, offset, length, StandardCharsets.UTF_8);
         return JsonParser.parseString(json).getAsJsonObject();
     }
 
@@ -83,10 +130,97 @@ public final class Protocol {
         return GSON;
     }
 
+    /**
+     * Reads frames from one stream through a reused buffer, so JSON frames that
+     * are parsed and dropped (responses, progress) need no array of their own.
+     * One per worker; not thread-safe.
+     */
+    public static final class FrameReader {
+        // A frame larger than this (long page text) gets a one-off array instead
+        private static final int MAX_RETAINED = 1024 * 1024;
+
+        private final InputStream in;
+        private final byte[] header = new byte[4];
+        private byte[] buffer = new byte[READ_CHUNK_SIZE];
+
+        public FrameReader(InputStream in) {
+            this.in = in;
+        }
+
+        /** Read the next frame as a JSON object. Returns null on EOF. */
+        public JsonObject readJson() throws IOException {
+            int length = readLength();
+            if (length < 0) {
+                return null;
+            }
+            if (length > buffer.length && length <= MAX_RETAINED) {
+                buffer = new byte[Math.max(length, Math.min(buffer.length * 2, MAX_RETAINED))];
+            }
+            byte[] target = length <= buffer.length ? buffer : new byte[length];
+            if (readExact(in, target, 0, length) < length) {
+                return null;
+            }
+            return deserialize(target, 0, length);
+        }
+
+        /** Read the next frame into a new array for the caller to keep. Returns null on EOF. */
+        public byte[] readBytes() throws IOException {
+            int length = readLength();
+            if (length < 0) {
+                return null;
+            }
+            byte[] payload = new byte[length];
+            return readExact(in, payload) < length ? null : payload;
+        }
+
+        /**
+         * Copy a chunked body to {@code destination} frame by frame, as it arrives.
+         * Returns false on EOF; the destination may then hold part of the body.
+         */
+        public boolean readChunked(OutputStream destination) throws IOException {
+            while (true) {
+                int length = readLength();
+                if (length < 0) {
+                    return false;
+                }
+                if (length == 0) {
+                    break;
+                }
+                while (length > 0) {
+                    int read = in.read(buffer, 0, Math.min(length, buffer.length));
+                    if (read == -1) {
+                        return false;
+                    }
+                    destination.write(buffer, 0, read);
+                    length -= read;
+                }
+            }
+            destination.flush();
+            return true;
+        }
+
+        /** Length of the next frame, or -1 on EOF. */
+        private int readLength() throws IOException {
+            if (readExact(in, header) < 4) {
+                return -1;
+            }
+            int length = (header[0] & 0xFF) | (header[1] & 0xFF) << 8
+                    | (header[2] & 0xFF) << 16 | (header[3] & 0xFF) << 24;
+            if (length < 0 || length > MAX_MESSAGE_SIZE) {
+                throw new IOException("Message too large: " + (length & 0xFFFFFFFFL) + " bytes (max " + MAX_MESSAGE_SIZE + ")");
+            }
+            return length;
+        }
+    }
+
     private static int readExact(InputStream in, byte[] buffer) throws IOException {
+        return readExact(in, buffer, 0, buffer.length);
+    }
+
+    private static int readExact(InputStream in, byte[] buffer, int offset, int length) throws IOException {
         int totalRead = 0;
-        while (totalRead < buffer.length) {
-            int read = in.read(buffer, totalRead, buffer.length - totalRead);
+        while (totalRead < length) {
+            int read = in.read(buffer, offset + totalRead, length - totalRead);
             if (read == -1) {
                 return totalRead; // EOF
             }
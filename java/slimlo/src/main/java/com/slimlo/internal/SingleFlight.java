@@ -0,0 +1,119 @@
+package com.slimlo.internal;
+
+import java.util.HashMap;
+import java.util.Map;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.function.UnaryOperator;
+
+/**
+ * Coalesces identical concurrent requests: the first caller for a key runs the
+ * operation on its own thread, callers arriving while it is in flight block
+ * until it finishes and receive the same outcome (result or exception) instead
+ * of running it again. Keys are forgotten as soon as the operation completes;
+ * nothing is cached. Thread-safe.
+ */
+public final class SingleFlight {
+
+    /** The work shared by callers of one key. */
+    public interface Operation<T> {
+        T run();
+    }
+
+    private static final class Flight {
+        final CountDownLatch done = new CountDownLatch(1);
+        Object result;
+        Throwable error;
+        int callers = 1; // guarded by flights; final once the key is removed
+    }
+
+    private final Map<String, Flight> flights = new HashMap<String, Flight>();
+    private final AtomicLong coalescedCount = new AtomicLong();
+
+    /** Requests that joined an in-flight operation instead of running their own. */
+    public long getCoalescedCount() {
+        return coalescedCount.get();
+    }
+
+    /** Operations currently in flight. */
+    public int size() {
+        synchronized (flights) {
+            return flights.size();
+        }
+    }
+
+    /**
+     * Run {@code operation} for {@code key}, or wait for the run already in flight
+     * for it. Callers of one key must expect the same result type.
+     *
+     * @throws InterruptedException if interrupted while waiting for another caller's run
+     */
+    public <T> T run(String key, Operation<T> operation) throws InterruptedException {
+        return run(key, operation, null);
+    }
+
+    /**
+     * As {@link #run(String, Operation)}; when the run had more than one caller and
+     * {@code copy} is given, each caller gets its own copy of the result rather than
+     * the shared one.
+     *
+     * @throws InterruptedException if interrupted while waiting for another caller's run
+     */
+    @SuppressWarnings("unchecked")
+    public <T> T run(String key, Operation<T> operation, UnaryOperator<T> copy) throws InterruptedException {
+        Flight flight;
+        boolean leader;
+        synchronized (flights) {
+            flight = flights.get(key);
+            leader = flight == null;
+            if (leader) {
+                flight = new Flight();
+                flights.put(key, flight);
+            } else {
+                flight.callers++;
+                coalescedCount.incrementAndGet();
+            }
+        }
+
+        if (leader) {
+            T result;
+            try {
+                result = operation.run();
+                flight.result = result;
+            } catch (RuntimeException e) {
+                flight.error = e;
+                throw e;
+            } catch (Error e) {
+                flight.error = e;
+                throw e;
+            } finally {
+                synchronized (flights) {
+                    flights.remove(key);
+                }
+                flight.done.countDown();
+            }
+            return share(result, flight, copy);
+        }
+
+        // The latch publishes the leader's writes to result and error
+        flight.done.await();
+        if (flight.error instanceof RuntimeException) {
+            throw (RuntimeException) flight.error;
+        }
+        if (flight.error instanceof Error) {
+            throw (Error) flight.error;
+        }
+        return share((T) flight.result, flight, copy);
+    }
+
+    private <T> T share(T result, Flight flight, UnaryOperator<T> copy) {
+        if (copy == null || result == null) {
+            return result;
+        }
+        int callers;
+        synchronized (flights) {
+            callers = flight.callers;
+        }
+        return callers > 1 ? copy.apply(result) : result;
+    }
+}
@@ -1,57 +1,128 @@
 package com.slimlo.internal;
 
+import com.slimlo.ConversionDiagnostic;
 import com.slimlo.ConversionResult;
+import com.slimlo.DiagnosticCategory;
+import com.slimlo.DiagnosticSeverity;
+import com.slimlo.DocumentInfoResult;
+import com.slimlo.MetricsListener;
+import com.slimlo.PageImage;
+import com.slimlo.ProgressListener;
 import com.slimlo.SlimLOErrorCode;
 import com.slimlo.SlimLOException;
+import com.slimlo.WorkerPlacement;
 
 import java.io.Closeable;
 import java.io.IOException;
+import java.io.File;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.util.ArrayList;
+import java.util.Collections;
 import java.util.List;
 import java.util.Map;
+import java.util.TreeMap;
+import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.ExecutorService;
 import java.util.concurrent.Executors;
+import java.util.concurrent.ScheduledExecutorService;
 import java.util.concurrent.Semaphore;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicBoolean;
 import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicIntegerArray;
+import java.util.concurrent.atomic.AtomicLongArray;
 import java.util.concurrent.locks.ReentrantLock;
+import java.util.function.Supplier;
+import java.util.function.UnaryOperator;
 
 /**
  * Thread-safe pool of native worker processes.
- * Provides round-robin dispatch, automatic crash recovery,
- * and worker recycling.
+ * Provides deadline-aware, tenant-fair admission, elastic sizing between
+ * minWorkers and maxWorkers, automatic crash recovery, worker recycling,
+ * quarantine of documents that keep crashing workers and coalescing of
+ * identical concurrent conversions.
  */
 public final class WorkerPool implements Closeable {
 
     private final String workerPath;
     private final String resourcePath;
-    private final List<String> fontDirectories;
+    private final String serverSocket;
+    private volatile List<String> fontDirectories; // replaced, never mutated
+    private final Object fontLock = new Object();
     private final int maxWorkers;
     private final int maxConversionsPerWorker;
     private final long timeoutMillis;
-    private final Semaphore gate;
+    private final long stallTimeoutMillis;
+    private final int threadsPerWorker;
+    private final CrashQuarantine quarantine;
+    private final boolean isolateSuspects;
+    private final ReentrantLock isolationLock = new ReentrantLock(); // one suspect at a time on the sacrificial worker
+    private final AdmissionQueue gate;
+    private final SingleFlight flights;
+    private final MetricsListener metrics;
+    private final List<List<Integer>> cpuSets; // per pool slot when workers are pinned
     private final WorkerProcess[] workers;
     private final ReentrantLock[] workerLocks;
+    private final int minWorkers;
+    private final long idleTimeoutMillis;
+    private final Long memoryBudget;
+    private final long baselineMemory;
+    private final AtomicIntegerArray claimed;  // 1 while a request runs on the slot
+    private final Semaphore slotFreed = new Semaphore(0); // released while requests wait for a slot
+    private final AtomicInteger slotWaiters = new AtomicInteger();
+    private final AtomicIntegerArray starting; // 1 while a spare worker starts in the slot
+    private final AtomicLongArray lastUsed;    // System.nanoTime() of the slot's last release
+    private final AtomicBoolean reaping = new AtomicBoolean();
+    private final Object scaleLock = new Object();
+    private long lastArrival;
+    private boolean anyArrival;
+    private double arrivalRate;  // moving average, requests per second
+    private double startupNanos; // moving average of worker start times, 0 = no sample yet
     private final AtomicInteger nextWorkerIndex = new AtomicInteger(0);
-    private final ExecutorService executor;
+    private final ExecutorService executor;    // spare-worker starts and async calls
+    private final ScheduledExecutorService watchdog; // exchange timeouts, one thread for all workers
+    private final ScheduledExecutorService reaper;
     private volatile boolean disposed;
     private volatile String version;
 
-    public WorkerPool(
-            String workerPath,
-            String resourcePath,
-            List<String> fontDirectories,
-            int maxWorkers,
-            int maxConversionsPerWorker,
-            long timeoutMillis) {
-        this.workerPath = workerPath;
-        this.resourcePath = resourcePath;
-        this.fontDirectories = fontDirectories;
-        this.maxWorkers = maxWorkers;
-        this.maxConversionsPerWorker = maxConversionsPerWorker;
-        this.timeoutMillis = timeoutMillis;
-        this.gate = new Semaphore(maxWorkers);
-        this.workers = new WorkerProcess[maxWorkers];
-        this.workerLocks = new ReentrantLock[maxWorkers];
-        for (int i = 0; i < maxWorkers; i++) {
+    /** Footprint assumed for a worker until running workers have been measured. */
+    public static final long DEFAULT_WORKER_MEMORY = 256L * 1024 * 1024;
+
+    /** Worker start time assumed until one has been measured. */
+    private static final double DEFAULT_STARTUP_SECONDS = 1.0;
+
+    public WorkerPool(WorkerPoolSettings settings) {
+        this.workerPath = settings.workerPath;
+        this.resourcePath = settings.resourcePath;
+        this.fontDirectories = settings.fontDirectories;
+        this.maxWorkers = settings.maxWorkers;
+        this.maxConversionsPerWorker = settings.maxConversionsPerWorker;
+        this.timeoutMillis = settings.timeoutMillis;
+        this.stallTimeoutMillis = settings.stallTimeoutMillis;
+        this.threadsPerWorker = settings.threadsPerWorker;
+        if (settings.quarantineAfterCrashes > 0 && settings.quarantineCapacity > 0) {
+            this.quarantine = new CrashQuarantine(settings.quarantineAfterCrashes, settings.quarantineCapacity);
+            this.isolateSuspects = settings.isolateSuspects;
+        } else {
+            this.quarantine = null;
+            this.isolateSuspects = false;
+        }
+        this.gate = new AdmissionQueue(maxWorkers, settings.tenantWeights, settings.maxWorkersPerTenant);
+        this.flights = settings.coalesceDuplicates ? new SingleFlight() : null;
+        this.metrics = settings.metrics != null ? settings.metrics : MetricsListener.NONE;
+        this.serverSocket = settings.serverSocket;
+        // A server places its own workers
+        this.cpuSets = settings.placement == WorkerPlacement.PINNED && serverSocket == null
+                ? CpuTopology.partition(
+                        CpuTopology.nodes(CpuTopology.DEFAULT_ROOT, CpuTopology.DEFAULT_STATUS), maxWorkers)
+                : null;
+
+        // With isolation, one extra slot past the pool holds the sacrificial worker
+        int slots = this.isolateSuspects ? maxWorkers + 1 : maxWorkers;
+        this.workers = new WorkerProcess[slots];
+        this.workerLocks = new ReentrantLock[slots];
+        for (int i = 0; i < slots; i++) {
             workerLocks[i] = new ReentrantLock();
         }
         this.executor = Executors.newCachedThreadPool(new java.util.concurrent.ThreadFactory() {
@@ -63,6 +134,42 @@ public final class WorkerPool implements Closeable {
                 return t;
             }
         });
+        this.watchdog = Executors.newSingleThreadScheduledExecutor(new java.util.concurrent.ThreadFactory() {
+            @Override
+            public Thread newThread(Runnable r) {
+                Thread t = new Thread(r, "slimlo-worker-watchdog");
+                t.setDaemon(true);
+                return t;
+            }
+        });
+
+        this.minWorkers = settings.minWorkers;
+        this.idleTimeoutMillis = settings.idleTimeoutMillis;
+        this.memoryBudget = settings.memoryBudget;
+        Long usage = memoryBudget != null ? NodeMemory.usage(NodeMemory.DEFAULT_ROOT) : null;
+        this.baselineMemory = usage != null ? usage : 0;
+        this.claimed = new AtomicIntegerArray(maxWorkers);
+        this.starting = new AtomicIntegerArray(maxWorkers);
+        this.lastUsed = new AtomicLongArray(maxWorkers);
+        if (idleTimeoutMillis > 0) {
+            long period = Math.min(Math.max(idleTimeoutMillis / 2, 100), 30000);
+            this.reaper = Executors.newSingleThreadScheduledExecutor(new java.util.concurrent.ThreadFactory() {
+                @Override
+                public Thread newThread(Runnable r) {
+                    Thread t = new Thread(r, "slimlo-worker-reaper");
+                    t.setDaemon(true);
+                    return t;
+                }
+            });
+            this.reaper.scheduleWithFixedDelay(new Runnable() {
+                @Override
+                public void run() {
+                    reapIdleWorkers();
+                }
+            }, period, period, TimeUnit.MILLISECONDS);
+        } else {
+            this.reaper = null;
+        }
     }
 
     public String getVersion() {
@@ -70,50 +177,496 @@ public final class WorkerPool implements Closeable {
     }
 
     /**
-     * Pre-start all worker processes (for warmUp mode).
+     * Run {@code call} on the pool's own threads. Async conversions block a thread
+     * on the worker's pipes (Java 8 process pipes cannot be polled), so they must
+     * not occupy {@link java.util.concurrent.ForkJoinPool#commonPool()}, whose
+     * parallelism would otherwise cap concurrent conversions below maxWorkers.
      */
-    public void warmUp() throws IOException {
+    public <T> CompletableFuture<T> submit(Supplier<T> call) {
+        return CompletableFuture.supplyAsync(call, executor);
+    }
+
+    /** Documents that crashed a worker, or null if quarantine is disabled. */
+    public CrashQuarantine getQuarantine() {
+        return quarantine;
+    }
+
+    /** Requests waiting for a worker. */
+    public int getQueueLength() {
+        return gate.getQueueLength();
+    }
+
+    /** Requests rejected because they could not finish before their deadline. */
+    public long getShedCount() {
+        return gate.getShedCount();
+    }
+
+    /** Requests that shared an identical in-flight conversion instead of running their own. */
+    public long getCoalescedCount() {
+        return flights != null ? flights.getCoalescedCount() : 0;
+    }
+
+    /** Pool worker processes running or starting (the isolation worker excluded). */
+    public int getWorkerCount() {
+        int count = 0;
         for (int i = 0; i < maxWorkers; i++) {
+            if (isLive(i) || starting.get(i) != 0) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * Pre-start worker processes (for warmUp mode): minWorkers of them,
+     * or all maxWorkers when no minimum is set.
+     */
+    public void warmUp() throws IOException {
+        int count = minWorkers > 0 ? minWorkers : maxWorkers;
+        for (int i = 0; i < count; i++) {
             ensureWorker(i);
+            lastUsed.set(i, System.nanoTime());
         }
     }
 
     /**
      * Execute a file-path conversion on the next available worker.
-     * Thread-safe.
+     * deadline comes from {@link AdmissionQueue#deadlineAfter(long)}; tenant is the
+     * fair-queuing key (null = default tenant). With coalescing on, a request
+     * identical to one in flight waits for that conversion's result instead of
+     * running again (without progress reports). Thread-safe.
      */
-    public ConversionResult execute(Map<String, Object> request) {
+    public ConversionResult execute(final Map<String, Object> request, final ProgressListener listener,
+                                    final long deadline, final String tenant) {
         if (disposed) {
             return ConversionResult.fail("Pool is disposed", SlimLOErrorCode.NOT_INITIALIZED, null);
         }
 
+        final WorkerCall<ConversionResult> call = new WorkerCall<ConversionResult>() {
+            @Override
+            public ConversionResult run(WorkerProcess worker) {
+                return worker.convert(request, timeoutMillis, stallTimeoutMillis, listener);
+            }
+
+            @Override
+            public ConversionResult fail(String message, SlimLOErrorCode code) {
+                return ConversionResult.fail(message, code, null);
+            }
+        };
+        final String key = flightKey(request);
+        requestProgress(request, listener);
+        return coalesce(key, call, new SingleFlight.Operation<ConversionResult>() {
+            @Override
+            public ConversionResult run() {
+                return runOnWorker(documentKey(request, null), deadline, tenant, call);
+            }
+        });
+    }
+
+    /**
+     * Execute a buffer conversion on the next available worker. With coalescing
+     * on, callers converting the same bytes with the same options concurrently
+     * share one conversion, each receiving its own copy of the result. Thread-safe.
+     */
+    public ConversionResult executeBuffer(final Map<String, Object> request, byte[] data,
+                                          final ProgressListener listener, final long deadline,
+                                          final String tenant) {
+        if (disposed) {
+            return ConversionResult.fail("Pool is disposed", SlimLOErrorCode.NOT_INITIALIZED, null);
+        }
+        // A coalesced run outlives an async caller that cancels, and that caller
+        // may then reuse its array: the run sends its own copy
+        final byte[] documentData = flights != null ? data.clone() : data;
+
+        final WorkerCall<ConversionResult> call = new WorkerCall<ConversionResult>() {
+            @Override
+            public ConversionResult run(WorkerProcess worker) {
+                return worker.convertBuffer(request, documentData, timeoutMillis, stallTimeoutMillis, listener);
+            }
+
+            @Override
+            public ConversionResult fail(String message, SlimLOErrorCode code) {
+                return ConversionResult.fail(message, code, null);
+            }
+        };
+        // Hash the document once for both quarantine and coalescing
+        final String contentKey = quarantine != null || flights != null ? CrashQuarantine.keyOf(documentData) : null;
+        final String key = flights != null ? "buffer:" + contentKey + ":" + requestKey(request) : null;
+        requestProgress(request, listener);
+        return coalesce(key, call, new SingleFlight.Operation<ConversionResult>() {
+            @Override
+            public ConversionResult run() {
+                return runOnWorker(quarantine != null ? contentKey : null, deadline, tenant, call);
+            }
+        }, WorkerPool::copyOf);
+    }
+
+    private static ConversionDiagnostic fontCatchUpWarning(ConversionResult failure, boolean replaced) {
+        return new ConversionDiagnostic(DiagnosticSeverity.WARNING, DiagnosticCategory.FONT,
+                replaced
+                        ? "The worker was lost registering added font directories and was replaced: "
+                                + failure.getErrorMessage()
+                        : "Added font directories could not be registered before this request: "
+                                + failure.getErrorMessage(),
+                null, null);
+    }
+
+    /** {@code result} rebuilt with {@code diagnostic} appended, through the factories of its type. */
+    @SuppressWarnings("unchecked")
+    private static <T> T withDiagnostic(T result, ConversionDiagnostic diagnostic) {
+        ConversionResult r = (ConversionResult) result;
+        List<ConversionDiagnostic> diagnostics = new ArrayList<ConversionDiagnostic>(r.getDiagnostics());
+        diagnostics.add(diagnostic);
+        if (r instanceof DocumentInfoResult) {
+            DocumentInfoResult info = (DocumentInfoResult) r;
+            return (T) (info.isSuccess()
+                    ? DocumentInfoResult.ok(info.getInfo(), diagnostics)
+                    : DocumentInfoResult.fail(info.getErrorMessage(), info.getErrorCode(), diagnostics));
+        }
+        return (T) (r.isSuccess()
+                ? ConversionResult.ok(r.getData(), diagnostics, r.getPageImages(), r.getPageText())
+                : ConversionResult.fail(r.getErrorMessage(), r.getErrorCode(), diagnostics));
+    }
+
+    /** A coalesced caller's own copy of the shared result, so no caller sees another's writes. */
+    private static ConversionResult copyOf(ConversionResult shared) {
+        if (!shared.isSuccess()) {
+            return shared;
+        }
+        List<PageImage> images = new ArrayList<PageImage>(shared.getPageImages().size());
+        for (PageImage image : shared.getPageImages()) {
+            images.add(new PageImage(image.getPageNumber(), image.getWidth(), image.getHeight(),
+                    image.getFormat(), image.getData().clone()));
+        }
+        return ConversionResult.ok(shared.getData() != null ? shared.getData().clone() : null,
+                shared.getDiagnostics(), images, shared.getPageText());
+    }
+
+    /**
+     * Execute a chunked conversion from input to output on the next available
+     * worker. Neither quarantined nor coalesced: the document is only known once
+     * it has been sent. Thread-safe.
+     */
+    public ConversionResult executeStream(final Map<String, Object> request, final InputStream input,
+                                          final OutputStream output, final ProgressListener listener,
+                                          final long deadline, final String tenant) {
+        if (disposed) {
+            return ConversionResult.fail("Pool is disposed", SlimLOErrorCode.NOT_INITIALIZED, null);
+        }
+
+        requestProgress(request, listener);
+        return runOnWorker(null, deadline, tenant, new WorkerCall<ConversionResult>() {
+            @Override
+            public ConversionResult run(WorkerProcess worker) {
+                return worker.convertStream(request, input, output, timeoutMillis, stallTimeoutMillis, listener);
+            }
+
+            @Override
+            public ConversionResult fail(String message, SlimLOErrorCode code) {
+                return ConversionResult.fail(message, code, null);
+            }
+        });
+    }
+
+    /**
+     * Query document metadata on the next available worker. documentData is null
+     * for file-path requests. No progress frames are sent, so the stall timeout
+     * does not apply. Thread-safe.
+     */
+    public DocumentInfoResult executeInfo(final Map<String, Object> request, final byte[] documentData) {
+        if (disposed) {
+            return DocumentInfoResult.fail("Pool is disposed", SlimLOErrorCode.NOT_INITIALIZED, null);
+        }
+
+        String documentKey = documentKey(request, documentData);
+        return runOnWorker(documentKey, AdmissionQueue.NO_DEADLINE, null, new WorkerCall<DocumentInfoResult>() {
+            @Override
+            public DocumentInfoResult run(WorkerProcess worker) {
+                return worker.getInfo(request, documentData, timeoutMillis);
+            }
+
+            @Override
+            public DocumentInfoResult fail(String message, SlimLOErrorCode code) {
+                return DocumentInfoResult.fail(message, code, null);
+            }
+        });
+    }
+
+    /**
+     * Render page images on the next available worker. documentData is null
+     * for file-path requests. Thread-safe.
+     */
+    public ConversionResult executeRender(final Map<String, Object> request, final byte[] documentData) {
+        if (disposed) {
+            return ConversionResult.fail("Pool is disposed", SlimLOErrorCode.NOT_INITIALIZED, null);
+        }
+
+        String documentKey = documentKey(request, documentData);
+        return runOnWorker(documentKey, AdmissionQueue.NO_DEADLINE, null, new WorkerCall<ConversionResult>() {
+            @Override
+            public ConversionResult run(WorkerProcess worker) {
+                return worker.render(request, documentData, timeoutMillis);
+            }
+
+            @Override
+            public ConversionResult fail(String message, SlimLOErrorCode code) {
+                return ConversionResult.fail(message, code, null);
+            }
+        });
+    }
+
+    /**
+     * Add a font directory to the pool: workers started from now on get it at init,
+     * and every live worker registers it without a restart, after the request it
+     * is running (if any). Workers that miss the broadcast catch up before their
+     * next request. Returns the first failure reported by a worker.
+     */
+    public ConversionResult addFontDirectory(String path) {
+        if (disposed) {
+            return ConversionResult.fail("Pool is disposed", SlimLOErrorCode.NOT_INITIALIZED, null);
+        }
+
+        final List<String> fonts;
+        synchronized (fontLock) {
+            List<String> current = fontDirectories != null ? fontDirectories : Collections.<String>emptyList();
+            if (!WorkerProcess.pendingFonts(current, Collections.singletonList(path)).isEmpty()) {
+                List<String> grown = new ArrayList<String>(current);
+                grown.add(path);
+                fontDirectories = Collections.unmodifiableList(grown);
+            }
+            fonts = fontDirectories;
+        }
+
+        List<CompletableFuture<ConversionResult>> pending = new ArrayList<CompletableFuture<ConversionResult>>();
+        for (final WorkerProcess worker : workers) {
+            if (worker != null && worker.isAlive() && worker.getRegisteredFonts() != fonts) {
+                pending.add(submit(() -> worker.addFonts(fonts, timeoutMillis)));
+            }
+        }
+
+        ConversionResult result = ConversionResult.ok(null);
+        for (CompletableFuture<ConversionResult> future : pending) {
+            ConversionResult r = future.join();
+            if (!r.isSuccess() && result.isSuccess()) {
+                result = r;
+            }
+        }
+        return result;
+    }
+
+    /** One request against a worker, plus how to report a failure before it runs. */
+    private interface WorkerCall<T> {
+        T run(WorkerProcess worker);
+
+        T fail(String message, SlimLOErrorCode code);
+    }
+
+    /** Run through the single-flight group when the request has a key, else directly. */
+    private <T> T coalesce(String key, WorkerCall<T> call, SingleFlight.Operation<T> operation) {
+        return coalesce(key, call, operation, null);
+    }
+
+    private <T> T coalesce(String key, WorkerCall<T> call, SingleFlight.Operation<T> operation,
+                           UnaryOperator<T> copy) {
+        if (key == null) {
+            return operation.run();
+        }
         try {
-            gate.acquire();
+            return flights.run(key, operation, copy);
         } catch (InterruptedException e) {
             Thread.currentThread().interrupt();
-            return ConversionResult.fail("Interrupted while waiting for worker", SlimLOErrorCode.UNKNOWN, null);
+            return call.fail("Interrupted while waiting for an identical conversion", SlimLOErrorCode.UNKNOWN);
+        }
+    }
+
+    /**
+     * Single-flight key of a file conversion: the request without its id and
+     * progress flag, plus the full path, size and modification time of every
+     * input, so a rewritten input starts a new conversion. The output path is
+     * part of the key: callers writing elsewhere convert separately rather than
+     * copy a file the first caller may already be moving. Null when coalescing
+     * is off or an input cannot be read.
+     */
+    private String flightKey(Map<String, Object> request) {
+        if (flights == null) {
+            return null;
+        }
+        StringBuilder key = new StringBuilder("file:");
+        Object input = request.get("input");
+        if (input instanceof String && !appendStamp(key, (String) input)) {
+            return null;
+        }
+        Object inputs = request.get("inputs");
+        if (inputs instanceof List) {
+            for (Object part : (List<?>) inputs) {
+                Object path = part instanceof Map ? ((Map<?, ?>) part).get("input") : null;
+                if (!(path instanceof String) || !appendStamp(key, (String) path)) {
+                    return null;
+                }
+            }
+        }
+        Object output = request.get("output");
+        if (output instanceof String) {
+            key.append(new File((String) output).getAbsolutePath()).append(':');
+        }
+        return key.append(requestKey(request)).toString();
+    }
+
+    private static boolean appendStamp(StringBuilder key, String path) {
+        try {
+            File file = new File(path).getAbsoluteFile();
+            if (!file.isFile()) {
+                return false;
+            }
+            key.append(file.getPath()).append('|')
+                    .append(file.length()).append('|')
+                    .append(file.lastModified()).append(':');
+            return true;
+        } catch (SecurityException e) {
+            return false;
+        }
+    }
+
+    /** The request as JSON with sorted keys, without its id and progress flag. */
+    private static String requestKey(Map<String, Object> request) {
+        Map<String, Object> normalized = new TreeMap<String, Object>(request);
+        normalized.remove("id");
+        normalized.remove("progress");
+        return Protocol.gson().toJson(normalized);
+    }
+
+    /**
+     * Quarantine key of the request's document, or null when quarantine is disabled.
+     * documentData is null for file-path requests.
+     */
+    private String documentKey(Map<String, Object> request, byte[] documentData) {
+        if (quarantine == null) {
+            return null;
+        }
+        if (documentData != null) {
+            return CrashQuarantine.keyOf(documentData);
+        }
+        Object input = request.get("input");
+        return input instanceof String ? CrashQuarantine.keyOfFile((String) input) : null;
+    }
+
+    /**
+     * Run one request on a worker: wait for a slot, pick a worker round-robin,
+     * (re)start it if needed, then recycle or replace it afterwards.
+     * Quarantined documents fail without reaching a worker; documents that
+     * crashed a worker before run on the sacrificial worker when isolation is on.
+     * Requests that cannot finish before their deadline are shed.
+     */
+    private <T> T runOnWorker(String documentKey, long deadline, String tenant, WorkerCall<T> call) {
+        int crashes = documentKey != null ? quarantine.crashCount(documentKey) : 0;
+        if (documentKey != null && crashes >= quarantine.getThreshold()) {
+            return call.fail("Document quarantined: it crashed a worker process " + crashes
+                    + " time(s) and is no longer dispatched to workers.", SlimLOErrorCode.QUARANTINED);
+        }
+
+        // Suspects skip the pool gate and take the sacrificial worker one at a time,
+        // from its start through its replacement, so none runs on a worker another crashed
+        boolean isolated = isolateSuspects && crashes > 0;
+        if (isolated) {
+            try {
+                isolationLock.lockInterruptibly();
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+                return call.fail("Interrupted while waiting for worker", SlimLOErrorCode.UNKNOWN);
+            }
+        } else {
+            boolean admitted;
+            long queued = System.nanoTime();
+            try {
+                admitted = gate.acquire(tenant, deadline);
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+                return call.fail("Interrupted while waiting for worker", SlimLOErrorCode.UNKNOWN);
+            }
+            metrics.onQueueWait((System.nanoTime() - queued) / 1e6, gate.getQueueLength());
+            if (!admitted) {
+                long estimate = gate.getEstimatedServiceMillis();
+                return call.fail("Request shed: it cannot finish before its deadline"
+                        + (estimate > 0 ? " (recent conversions take about " + estimate + " ms)" : "")
+                        + ".", SlimLOErrorCode.DEADLINE_EXCEEDED);
+            }
         }
 
+        int index = maxWorkers;
+        boolean claimedSlot = false;
         try {
-            int index = Math.abs(nextWorkerIndex.incrementAndGet()) % maxWorkers;
+            if (!isolated) {
+                try {
+                    index = claimWorker();
+                } catch (InterruptedException e) {
+                    Thread.currentThread().interrupt();
+                    return call.fail("Interrupted while waiting for worker", SlimLOErrorCode.UNKNOWN);
+                }
+                claimedSlot = true;
+                scaleAhead();
+            } else if (quarantine.crashCount(documentKey) >= quarantine.getThreshold()) {
+                return call.fail("Document quarantined: it crashed a worker process while this request waited"
+                        + " and is no longer dispatched to workers.", SlimLOErrorCode.QUARANTINED);
+            }
 
             try {
                 ensureWorker(index);
             } catch (IOException e) {
-                return ConversionResult.fail("Failed to start worker: " + e.getMessage(),
-                        SlimLOErrorCode.INIT_FAILED, null);
+                return call.fail("Failed to start worker: " + e.getMessage(), SlimLOErrorCode.INIT_FAILED);
             }
 
             WorkerProcess worker = workers[index];
             if (worker == null) {
-                return ConversionResult.fail("Failed to start worker", SlimLOErrorCode.INIT_FAILED, null);
+                return call.fail("Failed to start worker", SlimLOErrorCode.INIT_FAILED);
             }
 
-            ConversionResult result = worker.convert(request, timeoutMillis);
+            // Font directories added after this worker started
+            ConversionDiagnostic fontWarning = null;
+            List<String> fonts = fontDirectories;
+            if (fonts != null && worker.getRegisteredFonts() != fonts) {
+                ConversionResult added = worker.addFonts(fonts, timeoutMillis);
+                if (!added.isSuccess()) {
+                    // A worker that died meanwhile is replaced; its successor gets them at init
+                    boolean replaced = !worker.isAlive();
+                    if (replaced) {
+                        try {
+                            ensureWorker(index);
+                        } catch (IOException e) {
+                            return call.fail("Failed to start worker: " + e.getMessage(), SlimLOErrorCode.INIT_FAILED);
+                        }
+                        worker = workers[index];
+                        if (worker == null) {
+                            return call.fail("Failed to start worker", SlimLOErrorCode.INIT_FAILED);
+                        }
+                    }
+                    fontWarning = fontCatchUpWarning(added, replaced);
+                }
+            }
+
+            boolean alive = worker.isAlive();
+            long started = System.nanoTime();
+            T result = call.run(worker);
+            if (fontWarning != null) {
+                result = withDiagnostic(result, fontWarning);
+            }
+            if (!isolated) {
+                gate.recordServiceTime(System.nanoTime() - started);
+            }
+            // Only the request whose own exchange lost the worker is to blame
+            boolean lost = alive && worker.wasLostBy(Thread.currentThread());
+            if (documentKey != null && lost) {
+                quarantine.recordCrash(documentKey);
+            }
+            if (lost && !worker.isTimedOut()) {
+                metrics.onWorkerCrashed();
+            }
+            if (worker.getResidentBytes() > 0) {
+                metrics.onWorkerMemory(index, worker.getResidentBytes());
+            }
 
             // Check if worker needs recycling
             if (maxConversionsPerWorker > 0 && worker.getConversionCount() >= maxConversionsPerWorker) {
-                recycleWorker(index);
+                recycleWorker(index, "max_conversions");
             }
 
             // If worker crashed, mark for replacement
@@ -131,62 +684,203 @@ public final class WorkerPool implements Closeable {
 
             return result;
         } finally {
-            gate.release();
+            if (isolated) {
+                isolationLock.unlock();
+            } else {
+                // Not claimed when the wait for a slot was interrupted: index is no slot
+                if (claimedSlot) {
+                    lastUsed.set(index, System.nanoTime());
+                    releaseSlot(index);
+                }
+                gate.release(tenant);
+            }
         }
     }
 
     /**
-     * Execute a buffer conversion on the next available worker.
-     * Thread-safe.
+     * Claim a pool slot for an admitted request, waiting for one to be released
+     * if none can be claimed. Admission never exceeds the slot count, so a slot is
+     * normally free; when the memory budget stops the pool from growing, the
+     * request waits for a running worker rather than sharing one, since a slot's
+     * worker is recycled, replaced or reaped by the request or reaper holding it.
      */
-    public ConversionResult executeBuffer(Map<String, Object> request, byte[] documentData) {
-        if (disposed) {
-            return ConversionResult.fail("Pool is disposed", SlimLOErrorCode.NOT_INITIALIZED, null);
+    private int claimWorker() throws InterruptedException {
+        int index = tryClaimWorker();
+        if (index >= 0) {
+            return index;
         }
 
+        slotWaiters.incrementAndGet();
         try {
-            gate.acquire();
-        } catch (InterruptedException e) {
-            Thread.currentThread().interrupt();
-            return ConversionResult.fail("Interrupted while waiting for worker", SlimLOErrorCode.UNKNOWN, null);
+            // A release that lands between the attempt and the wait leaves a permit behind
+            while ((index = tryClaimWorker()) < 0) {
+                slotFreed.acquire();
+            }
+            return index;
+        } finally {
+            slotWaiters.decrementAndGet();
         }
+    }
 
-        try {
-            int index = Math.abs(nextWorkerIndex.incrementAndGet()) % maxWorkers;
-
-            try {
-                ensureWorker(index);
-            } catch (IOException e) {
-                return ConversionResult.fail("Failed to start worker: " + e.getMessage(),
-                        SlimLOErrorCode.INIT_FAILED, null);
+    /**
+     * Claim an idle running worker, else one a spare start is warming, else an
+     * empty slot if the memory budget allows another process; -1 if none.
+     */
+    private int tryClaimWorker() {
+        int start = (nextWorkerIndex.incrementAndGet() & Integer.MAX_VALUE) % maxWorkers;
+        for (int pass = 0; pass < 3; pass++) {
+            if (pass == 2 && !canSpawn()) {
+                break;
+            }
+            for (int n = 0; n < maxWorkers; n++) {
+                int i = (start + n) % maxWorkers;
+                boolean candidate = pass == 0 ? isLive(i) : pass == 1 ? starting.get(i) != 0 : !isLive(i);
+                if (candidate && claimed.compareAndSet(i, 0, 1)) {
+                    return i;
+                }
             }
+        }
+        return -1;
+    }
 
-            WorkerProcess worker = workers[index];
-            if (worker == null) {
-                return ConversionResult.fail("Failed to start worker", SlimLOErrorCode.INIT_FAILED, null);
+    private void releaseSlot(int index) {
+        claimed.set(index, 0); // volatile: a waiter counted after this reads the slot as free
+        if (slotWaiters.get() > 0) {
+            slotFreed.release();
+        }
+    }
+
+    /**
+     * Start spare workers ahead of demand, called on each admission: keep as many
+     * idle workers as requests are expected to be admitted while a new worker
+     * starts (admission rate times start time), so a burst does not pay cold
+     * starts one by one.
+     */
+    private void scaleAhead() {
+        double spare;
+        synchronized (scaleLock) {
+            long now = System.nanoTime();
+            if (anyArrival) {
+                double gap = Math.max((now - lastArrival) / 1e9, 1e-3);
+                arrivalRate = arrivalRate > 0 ? 0.8 * arrivalRate + 0.2 / gap : 1 / gap;
             }
+            anyArrival = true;
+            lastArrival = now;
+            double startup = startupNanos > 0 ? startupNanos / 1e9 : DEFAULT_STARTUP_SECONDS;
+            spare = arrivalRate * startup;
+        }
 
-            ConversionResult result = worker.convertBuffer(request, documentData, timeoutMillis);
+        int idle = 0;
+        for (int i = 0; i < maxWorkers; i++) {
+            if ((isLive(i) || starting.get(i) != 0) && claimed.get(i) == 0) {
+                idle++;
+            }
+        }
 
-            if (maxConversionsPerWorker > 0 && worker.getConversionCount() >= maxConversionsPerWorker) {
-                recycleWorker(index);
+        int wanted = (int) Math.min(spare, maxWorkers) - idle;
+        for (int i = 0; i < maxWorkers && wanted > 0; i++) {
+            if (isLive(i) || claimed.get(i) != 0 || !canSpawn()) {
+                continue;
+            }
+            if (!starting.compareAndSet(i, 0, 1)) {
+                continue;
             }
+            wanted--;
+            final int index = i;
+            try {
+                executor.execute(new Runnable() {
+                    @Override
+                    public void run() {
+                        startSpare(index);
+                    }
+                });
+            } catch (java.util.concurrent.RejectedExecutionException e) {
+                starting.set(i, 0); // pool closed
+            }
+        }
+    }
 
-            if (!worker.isAlive()) {
-                workerLocks[index].lock();
+    private void startSpare(int index) {
+        try {
+            ensureWorker(index);
+            lastUsed.set(index, System.nanoTime());
+        } catch (IOException | RuntimeException e) {
+            // The request that picks this slot retries the start and reports the error
+        } finally {
+            starting.set(index, 0);
+        }
+    }
+
+    /**
+     * Stop workers idle for longer than the idle timeout, down to minWorkers.
+     * A slot is claimed before its worker is stopped, so a request cannot pick it meanwhile.
+     */
+    private void reapIdleWorkers() {
+        if (disposed || !reaping.compareAndSet(false, true)) {
+            return;
+        }
+        try {
+            long now = System.nanoTime();
+            long idleNanos = TimeUnit.MILLISECONDS.toNanos(idleTimeoutMillis);
+            int live = getWorkerCount();
+            for (int i = 0; i < maxWorkers && live > minWorkers && !disposed; i++) {
+                if (!isLive(i) || now - lastUsed.get(i) < idleNanos) {
+                    continue;
+                }
+                if (!claimed.compareAndSet(i, 0, 1)) {
+                    continue;
+                }
                 try {
-                    if (workers[index] == worker) {
-                        worker.close();
-                        workers[index] = null;
+                    if (starting.get(i) == 0) {
+                        recycleWorker(i, "idle");
+                        live--;
                     }
                 } finally {
-                    workerLocks[index].unlock();
+                    releaseSlot(i);
                 }
             }
-
-            return result;
         } finally {
-            gate.release();
+            reaping.set(false);
+        }
+    }
+
+    /** Whether one more worker process fits: always below minWorkers (and for the first), else per the memory budget. */
+    private boolean canSpawn() {
+        int live = getWorkerCount();
+        if (live < Math.max(minWorkers, 1)) {
+            return true;
+        }
+        return memoryAllows(memoryBudget, NodeMemory.usage(NodeMemory.DEFAULT_ROOT), baselineMemory, live);
+    }
+
+    /**
+     * Whether a further worker fits the memory budget. A worker's footprint is
+     * estimated as the group's growth since the pool started, divided by the running
+     * workers; without usage figures every worker counts as {@link #DEFAULT_WORKER_MEMORY}.
+     */
+    public static boolean memoryAllows(Long budget, Long usage, long baseline, int liveWorkers) {
+        if (budget == null) {
+            return true;
+        }
+        long perWorker = usage != null && liveWorkers > 0
+                ? Math.max((usage - baseline) / liveWorkers, 0)
+                : DEFAULT_WORKER_MEMORY;
+        if (perWorker == 0) {
+            perWorker = DEFAULT_WORKER_MEMORY;
+        }
+        long current = usage != null ? usage : liveWorkers * perWorker;
+        return current + perWorker <= budget;
+    }
+
+    private boolean isLive(int index) {
+        WorkerProcess w = workers[index];
+        return w != null && w.isAlive();
+    }
+
+    /** Progress frames are needed for a caller's listener or for stall detection. */
+    private void requestProgress(Map<String, Object> request, ProgressListener listener) {
+        if (listener != null || stallTimeoutMillis > 0) {
+            request.put("progress", true);
         }
     }
 
@@ -209,23 +903,34 @@ public final class WorkerPool implements Closeable {
             }
 
             // Start new
-            WorkerProcess worker = new WorkerProcess(workerPath, resourcePath, fontDirectories, executor);
+            // The isolation slot stays unpinned; a pinned worker sizes its pools to its CPUs
+            List<Integer> cpus = cpuSets != null && index < maxWorkers ? cpuSets.get(index) : null;
+            int threads = threadsPerWorker > 0 ? threadsPerWorker : cpus != null ? cpus.size() : 0;
+            WorkerProcess worker = new WorkerProcess(
+                    workerPath, resourcePath, fontDirectories, threads, watchdog, metrics, cpus, serverSocket);
+            long started = System.nanoTime();
             worker.start();
+            long elapsed = System.nanoTime() - started;
+            synchronized (scaleLock) {
+                startupNanos = startupNanos > 0 ? 0.8 * startupNanos + 0.2 * elapsed : elapsed;
+            }
             workers[index] = worker;
             if (version == null) {
                 version = worker.getVersion();
             }
+            metrics.onWorkerStarted();
         } finally {
             workerLocks[index].unlock();
         }
     }
 
-    private void recycleWorker(int index) {
+    private void recycleWorker(int index, String reason) {
         workerLocks[index].lock();
         try {
             if (workers[index] != null) {
                 workers[index].close();
                 workers[index] = null;
+                metrics.onWorkerRecycled(reason);
             }
         } finally {
             workerLocks[index].unlock();
@@ -236,8 +941,11 @@ public final class WorkerPool implements Closeable {
     public void close() {
         if (disposed) return;
         disposed = true;
+        if (reaper != null) {
+            reaper.shutdownNow();
+        }
 
-        for (int i = 0; i < maxWorkers; i++) {
+        for (int i = 0; i < workers.length; i++) {
             if (workers[i] != null) {
                 workers[i].close();
                 workers[i] = null;
@@ -245,5 +953,6 @@ public final class WorkerPool implements Closeable {
         }
 
         executor.shutdown();
+        watchdog.shutdownNow();
     }
 }
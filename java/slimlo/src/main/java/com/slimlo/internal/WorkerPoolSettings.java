@@ -0,0 +1,166 @@
+package com.slimlo.internal;
+
+import com.slimlo.MetricsListener;
+import com.slimlo.PdfConverterOptions;
+import com.slimlo.WorkerPlacement;
+
+import java.util.List;
+import java.util.Map;
+
+/**
+ * Everything a {@link WorkerPool} is built from: the resolved worker and
+ * resource paths plus the pool-related {@link PdfConverterOptions}. Setters
+ * chain; defaults leave every optional feature off.
+ */
+public final class WorkerPoolSettings {
+
+    String workerPath = "";
+    String resourcePath = "";
+    List<String> fontDirectories;
+    int maxWorkers = 1;
+    int maxConversionsPerWorker;
+    long timeoutMillis = 5 * 60 * 1000L;
+    long stallTimeoutMillis;
+    int threadsPerWorker;
+    int quarantineAfterCrashes;
+    int quarantineCapacity;
+    boolean isolateSuspects;
+    Map<String, Integer> tenantWeights;
+    int maxWorkersPerTenant;
+    int minWorkers;
+    long idleTimeoutMillis;
+    Long memoryBudget; // null = no budget
+    boolean coalesceDuplicates;
+    MetricsListener metrics;
+    WorkerPlacement placement = WorkerPlacement.NONE;
+    String serverSocket;
+
+    /**
+     * Settings for a converter created with {@code options}. Without a memory
+     * budget of its own the pool takes the cgroup limit; connected to a server it
+     * has none, as the server's workers are not in this control group.
+     */
+    public static WorkerPoolSettings from(PdfConverterOptions options, String workerPath, String resourcePath) {
+        String serverSocket = options.getServerSocket();
+        return new WorkerPoolSettings()
+                .workerPath(workerPath)
+                .resourcePath(resourcePath)
+                .fontDirectories(options.getFontDirectories())
+                .maxWorkers(options.getMaxWorkers())
+                .maxConversionsPerWorker(options.getMaxConversionsPerWorker())
+                .timeoutMillis(options.getConversionTimeoutMillis())
+                .stallTimeoutMillis(options.getStallTimeoutMillis())
+                .threadsPerWorker(options.getThreadsPerWorker())
+                .quarantine(options.getQuarantineAfterCrashes(), options.getQuarantineCapacity())
+                .isolateSuspects(options.isIsolateSuspectDocuments())
+                .tenantWeights(options.getTenantWeights())
+                .maxWorkersPerTenant(options.getMaxWorkersPerTenant())
+                .minWorkers(options.getMinWorkers())
+                .idleTimeoutMillis(options.getIdleTimeoutMillis())
+                .memoryBudget(serverSocket != null ? null
+                        : options.getMemoryBudget() > 0
+                        ? Long.valueOf(options.getMemoryBudget())
+                        : NodeMemory.limit(NodeMemory.DEFAULT_ROOT))
+                .coalesceDuplicates(options.isCoalesceDuplicates())
+                .metrics(options.getMetricsListener())
+                .placement(options.getWorkerPlacement())
+                .serverSocket(serverSocket);
+    }
+
+    public WorkerPoolSettings workerPath(String path) {
+        this.workerPath = path;
+        return this;
+    }
+
+    public WorkerPoolSettings resourcePath(String path) {
+        this.resourcePath = path;
+        return this;
+    }
+
+    public WorkerPoolSettings fontDirectories(List<String> directories) {
+        this.fontDirectories = directories;
+        return this;
+    }
+
+    public WorkerPoolSettings maxWorkers(int count) {
+        this.maxWorkers = count;
+        return this;
+    }
+
+    public WorkerPoolSettings maxConversionsPerWorker(int count) {
+        this.maxConversionsPerWorker = count;
+        return this;
+    }
+
+    public WorkerPoolSettings timeoutMillis(long millis) {
+        this.timeoutMillis = millis;
+        return this;
+    }
+
+    public WorkerPoolSettings stallTimeoutMillis(long millis) {
+        this.stallTimeoutMillis = millis;
+        return this;
+    }
+
+    public WorkerPoolSettings threadsPerWorker(int threads) {
+        this.threadsPerWorker = threads;
+        return this;
+    }
+
+    /** Quarantine documents after {@code afterCrashes} crashes, remembering up to {@code capacity}; 0 = off. */
+    public WorkerPoolSettings quarantine(int afterCrashes, int capacity) {
+        this.quarantineAfterCrashes = afterCrashes;
+        this.quarantineCapacity = capacity;
+        return this;
+    }
+
+    public WorkerPoolSettings isolateSuspects(boolean isolate) {
+        this.isolateSuspects = isolate;
+        return this;
+    }
+
+    public WorkerPoolSettings tenantWeights(Map<String, Integer> weights) {
+        this.tenantWeights = weights;
+        return this;
+    }
+
+    public WorkerPoolSettings maxWorkersPerTenant(int count) {
+        this.maxWorkersPerTenant = count;
+        return this;
+    }
+
+    public WorkerPoolSettings minWorkers(int count) {
+        this.minWorkers = count;
+        return this;
+    }
+
+    public WorkerPoolSettings idleTimeoutMillis(long millis) {
+        this.idleTimeoutMillis = millis;
+        return this;
+    }
+
+    public WorkerPoolSettings memoryBudget(Long bytes) {
+        this.memoryBudget = bytes;
+        return this;
+    }
+
+    public WorkerPoolSettings coalesceDuplicates(boolean coalesce) {
+        this.coalesceDuplicates = coalesce;
+        return this;
+    }
+
+    public WorkerPoolSettings metrics(MetricsListener listener) {
+        this.metrics = listener;
+        return this;
+    }
+
+    public WorkerPoolSettings placement(WorkerPlacement placement) {
+        this.placement = placement;
+        return this;
+    }
+
+    public WorkerPoolSettings serverSocket(String socket) {
+        this.serverSocket = socket;
+        return this;
+    }
+}
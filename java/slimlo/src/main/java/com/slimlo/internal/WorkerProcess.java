@@ -1,71 +1,195 @@
 package com.slimlo.internal;
 
+import com.google.gson.JsonArray;
+import com.google.gson.JsonElement;
 import com.google.gson.JsonObject;
 import com.slimlo.*;
 
 import java.io.*;
+import java.net.ProtocolFamily;
+import java.net.SocketAddress;
+import java.net.StandardProtocolFamily;
+import java.nio.channels.Channels;
+import java.nio.channels.SocketChannel;
+import java.util.ArrayList;
 import java.util.Collections;
 import java.util.HashMap;
 import java.util.List;
 import java.util.Map;
-import java.util.concurrent.ExecutionException;
-import java.util.concurrent.ExecutorService;
-import java.util.concurrent.Future;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.ScheduledExecutorService;
+import java.util.concurrent.ScheduledFuture;
 import java.util.concurrent.TimeUnit;
-import java.util.concurrent.TimeoutException;
 import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
 import java.util.concurrent.locks.ReentrantLock;
 
 /**
  * Manages the lifecycle of a single native slimlo_worker subprocess.
  * Handles startup, message exchange, stderr capture, and crash detection.
+ * Exchanges run on the caller's thread; timeouts are enforced by the pool's
+ * shared watchdog, and stderr goes to a log file rather than a reader thread.
+ * Given a server socket, it is instead one connection to a slimlo_server,
+ * which speaks the same protocol from its shared pool of workers.
  */
 public final class WorkerProcess implements Closeable {
 
     private final String workerPath;
     private final String resourcePath;
     private final List<String> fontDirectories;
-    private final ExecutorService executor;
+    private volatile List<String> registeredFonts; // font directories the worker has
+    private final int threads;
+    private final ScheduledExecutorService watchdog;
+    private final MetricsListener metrics;
+    private final List<Integer> cpus;
+    private final String serverSocket;
+
+    // The worker only writes here outside conversions (it captures its own stderr
+    // during them), so the log is trimmed rather than read on every request
+    private static final long STDERR_LOG_LIMIT = 256 * 1024;
 
     private Process process;
+    private SocketChannel channel;
     private OutputStream stdin;
     private InputStream stdout;
+    private Protocol.FrameReader frames;
+    private File stderrLog;
     private final ReentrantLock lock = new ReentrantLock();
-    private final StringBuilder stderrBuffer = new StringBuilder();
     private volatile boolean disposed;
     private volatile boolean initialized;
     private final AtomicInteger conversionCount = new AtomicInteger(0);
     private String version;
+    private volatile boolean timedOut;
+    private volatile Thread lostBy; // thread of the exchange that lost the worker
+    private volatile long residentBytes;
 
     public WorkerProcess(
             String workerPath,
             String resourcePath,
             List<String> fontDirectories,
-            ExecutorService executor) {
+            int threads,
+            ScheduledExecutorService watchdog,
+            MetricsListener metrics,
+            List<Integer> cpus,
+            String serverSocket) {
         this.workerPath = workerPath;
         this.resourcePath = resourcePath;
         this.fontDirectories = fontDirectories;
-        this.executor = executor;
+        this.registeredFonts = fontDirectories != null ? fontDirectories : Collections.<String>emptyList();
+        this.threads = threads;
+        this.watchdog = watchdog;
+        this.metrics = metrics != null ? metrics : MetricsListener.NONE;
+        this.cpus = cpus;
+        this.serverSocket = serverSocket;
     }
 
     public int getConversionCount() {
         return conversionCount.get();
     }
 
+    /** Whether the worker was killed because a request timed out or stalled. */
+    public boolean isTimedOut() {
+        return timedOut;
+    }
+
+    /**
+     * Whether the exchange that crashed the worker, or had it killed on timeout or
+     * stall, ran on the given thread. Exchanges run on the calling thread, so the
+     * pool blames the request that lost the worker and not one queued behind it.
+     */
+    public boolean wasLostBy(Thread thread) {
+        return lostBy == thread;
+    }
+
+    /** Resident memory the worker reported with its last conversion; 0 if it did not report any. */
+    public long getResidentBytes() {
+        return residentBytes;
+    }
+
     public boolean isAlive() {
-        return process != null && process.isAlive();
+        // An exchange that lost the worker clears initialized before the process is reaped
+        return initialized && (channel != null || process != null && process.isAlive());
     }
 
     public String getVersion() {
         return version;
     }
 
+    /** Font directories the worker has registered: at init, then through {@link #addFonts}. */
+    public List<String> getRegisteredFonts() {
+        return registeredFonts;
+    }
+
     /**
-     * Start the worker process and send the init message.
+     * Start the worker process (or connect to the server) and send the init message.
      */
     public void start() throws IOException, SlimLOException {
         if (disposed) throw new IllegalStateException("WorkerProcess is disposed");
 
+        if (serverSocket != null) {
+            connect(serverSocket);
+        } else {
+            startProcess();
+        }
+        frames = new Protocol.FrameReader(stdout);
+
+        // Send init message
+        Map<String, Object> initRequest = new HashMap<String, Object>();
+        initRequest.put("type", "init");
+        initRequest.put("resource_path", resourcePath);
+        if (fontDirectories != null && !fontDirectories.isEmpty()) {
+            initRequest.put("font_paths", fontDirectories);
+        }
+        if (threads > 0) {
+            initRequest.put("threads", threads);
+        }
+        if (cpus != null) {
+            initRequest.put("cpus", cpus);
+        }
+
+        byte[] initBytes = Protocol.serialize(initRequest);
+        Protocol.writeMessage(stdin, initBytes);
+
+        // Read init response
+        JsonObject root = frames.readJson();
+        if (root == null && channel != null) {
+            throw new SlimLOException("slimlo_server at " + serverSocket
+                    + " closed the connection during initialization.", SlimLOErrorCode.INIT_FAILED);
+        }
+        if (root == null) {
+            int exitCode = -1;
+            try {
+                if (process.waitFor(1, TimeUnit.SECONDS)) {
+                    exitCode = process.exitValue();
+                }
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+            }
+            String stderr = getStderrOutput();
+            String message = "Worker process died during initialization (exit code: " + exitCode + ").";
+            if (stderr.contains("error while loading shared libraries")) {
+                message += " Missing system library detected. Check that all required native libraries are installed.";
+            }
+            message += " Stderr: " + stderr;
+            throw new SlimLOException(message, SlimLOErrorCode.INIT_FAILED);
+        }
+
+        String type = root.has("type") ? root.get("type").getAsString() : "";
+
+        if ("error".equals(type)) {
+            String message = root.has("message") ? root.get("message").getAsString() : "Unknown error";
+            throw new SlimLOException("Worker initialization failed: " + message, SlimLOErrorCode.INIT_FAILED);
+        }
+
+        if ("ready".equals(type)) {
+            version = root.has("version") ? root.get("version").getAsString() : null;
+            initialized = true;
+        } else {
+            throw new SlimLOException("Unexpected init response type: " + type, SlimLOErrorCode.INIT_FAILED);
+        }
+    }
+
+    private void startProcess() throws IOException {
         ProcessBuilder pb = new ProcessBuilder(workerPath);
         pb.redirectErrorStream(false);
 
@@ -116,117 +240,80 @@ public final class WorkerProcess implements Closeable {
         new File(profileDir).mkdirs();
         env.put("HOME", profileDir);
 
+        // Append mode, so trimming the log from here never leaves the worker writing past its end
+        stderrLog = new File(profileDir, "stderr.log");
+        stderrLog.delete();
+        pb.redirectError(ProcessBuilder.Redirect.appendTo(stderrLog));
+
         process = pb.start();
         stdin = process.getOutputStream();
         stdout = process.getInputStream();
+    }
 
-        // Start stderr gobbler daemon
-        startStderrGobbler();
-
-        // Send init message
-        Map<String, Object> initRequest = new HashMap<String, Object>();
-        initRequest.put("type", "init");
-        initRequest.put("resource_path", resourcePath);
-        if (fontDirectories != null && !fontDirectories.isEmpty()) {
-            initRequest.put("font_paths", fontDirectories);
-        }
-
-        byte[] initBytes = Protocol.serialize(initRequest);
-        Protocol.writeMessage(stdin, initBytes);
-
-        // Read init response
-        byte[] responseBytes = Protocol.readMessage(stdout);
-        if (responseBytes == null) {
-            int exitCode = -1;
-            try {
-                if (process.waitFor(1, TimeUnit.SECONDS)) {
-                    exitCode = process.exitValue();
-                }
-            } catch (InterruptedException e) {
-                Thread.currentThread().interrupt();
-            }
-            String stderr = getStderrOutput();
-            String message = "Worker process died during initialization (exit code: " + exitCode + ").";
-            if (stderr.contains("error while loading shared libraries")) {
-                message += " Missing system library detected. Check that all required native libraries are installed.";
-            }
-            message += " Stderr: " + stderr;
-            throw new SlimLOException(message, SlimLOErrorCode.INIT_FAILED);
-        }
-
-        JsonObject root = Protocol.deserialize(responseBytes);
-        String type = root.has("type") ? root.get("type").getAsString() : "";
-
-        if ("error".equals(type)) {
-            String message = root.has("message") ? root.get("message").getAsString() : "Unknown error";
-            throw new SlimLOException("Worker initialization failed: " + message, SlimLOErrorCode.INIT_FAILED);
+    /**
+     * Connect to a slimlo_server. Unix domain socket channels arrived in Java 16,
+     * so they are reached reflectively to keep the SDK on Java 8.
+     */
+    private void connect(String path) throws IOException, SlimLOException {
+        SocketChannel opened;
+        SocketAddress address;
+        try {
+            ProtocolFamily unix = StandardProtocolFamily.valueOf("UNIX");
+            opened = (SocketChannel) SocketChannel.class.getMethod("open", ProtocolFamily.class)
+                    .invoke(null, unix);
+            address = (SocketAddress) Class.forName("java.net.UnixDomainSocketAddress")
+                    .getMethod("of", String.class).invoke(null, path);
+        } catch (ReflectiveOperationException | IllegalArgumentException e) {
+            throw new SlimLOException("Connecting to slimlo_server requires Java 16 or later",
+                    SlimLOErrorCode.INIT_FAILED);
         }
-
-        if ("ready".equals(type)) {
-            version = root.has("version") ? root.get("version").getAsString() : null;
-            initialized = true;
-        } else {
-            throw new SlimLOException("Unexpected init response type: " + type, SlimLOErrorCode.INIT_FAILED);
+        try {
+            opened.connect(address);
+        } catch (IOException e) {
+            opened.close();
+            throw new SlimLOException("Cannot connect to slimlo_server at " + path + ": " + e.getMessage(),
+                    SlimLOErrorCode.INIT_FAILED);
         }
+        channel = opened;
+        stdin = Channels.newOutputStream(channel);
+        stdout = Channels.newInputStream(channel);
     }
 
     /**
      * Execute a file-path conversion.
      */
     public ConversionResult convert(
-            Map<String, Object> request,
-            long timeoutMillis) {
+            final Map<String, Object> request,
+            long timeoutMillis,
+            long stallTimeoutMillis,
+            final ProgressListener listener) {
         if (disposed) {
             return ConversionResult.fail("Worker is disposed", SlimLOErrorCode.NOT_INITIALIZED, null);
         }
-        if (!initialized || process == null || !process.isAlive()) {
-            return ConversionResult.fail("Worker process is not running", SlimLOErrorCode.NOT_INITIALIZED, null);
-        }
-
         lock.lock();
         try {
-            clearStderrBuffer();
+            // Checked under the lock: the worker may have died while this request waited
+            if (!initialized || !isAlive()) {
+                return ConversionResult.fail("Worker process is not running", SlimLOErrorCode.NOT_INITIALIZED, null);
+            }
+            trimStderrLog();
 
-            Future<ConversionResult> future = executor.submit(() -> {
+            final AtomicLong lastActivity = new AtomicLong(System.nanoTime());
+            return exchange("Conversion", timeoutMillis, stallTimeoutMillis, lastActivity, () -> {
                 byte[] requestBytes = Protocol.serialize(request);
                 Protocol.writeMessage(stdin, requestBytes);
 
-                byte[] responseBytes = Protocol.readMessage(stdout);
-                if (responseBytes == null) {
-                    initialized = false;
-                    int exitCode = process.isAlive() ? -1 : process.exitValue();
+                JsonObject response = readResponse(listener, lastActivity);
+                if (response == null) {
+                    lose();
+                    int exitCode = exitCode();
                     return ConversionResult.fail(
                             "Worker process crashed during conversion (exit code: " + exitCode + ").",
                             SlimLOErrorCode.UNKNOWN, null);
                 }
 
-                return parseConvertResponse(responseBytes, false);
-            });
-
-            try {
-                return future.get(timeoutMillis, TimeUnit.MILLISECONDS);
-            } catch (TimeoutException e) {
-                future.cancel(true);
-                killProcess();
-                initialized = false;
-                return ConversionResult.fail(
-                        "Conversion timed out after " + (timeoutMillis / 1000) + " seconds",
-                        SlimLOErrorCode.UNKNOWN, null);
-            } catch (ExecutionException e) {
-                Throwable cause = e.getCause();
-                if (cause instanceof IOException) {
-                    initialized = false;
-                    return ConversionResult.fail(
-                            "I/O error during conversion: " + cause.getMessage(),
-                            SlimLOErrorCode.UNKNOWN, null);
-                }
-                return ConversionResult.fail(
-                        "Conversion error: " + cause.getMessage(),
-                        SlimLOErrorCode.UNKNOWN, null);
-            } catch (InterruptedException e) {
-                Thread.currentThread().interrupt();
-                return ConversionResult.fail("Conversion interrupted", SlimLOErrorCode.UNKNOWN, null);
-            }
+                return parseConvertResponse(response, false);
+            }, CONVERSION_FAILURE);
         } finally {
             lock.unlock();
         }
@@ -236,21 +323,24 @@ public final class WorkerProcess implements Closeable {
      * Execute a buffer conversion. Sends document bytes, receives PDF bytes.
      */
     public ConversionResult convertBuffer(
-            Map<String, Object> request,
-            byte[] documentData,
-            long timeoutMillis) {
+            final Map<String, Object> request,
+            final byte[] documentData,
+            long timeoutMillis,
+            long stallTimeoutMillis,
+            final ProgressListener listener) {
         if (disposed) {
             return ConversionResult.fail("Worker is disposed", SlimLOErrorCode.NOT_INITIALIZED, null);
         }
-        if (!initialized || process == null || !process.isAlive()) {
-            return ConversionResult.fail("Worker process is not running", SlimLOErrorCode.NOT_INITIALIZED, null);
-        }
-
         lock.lock();
         try {
-            clearStderrBuffer();
+            // Checked under the lock: the worker may have died while this request waited
+            if (!initialized || !isAlive()) {
+                return ConversionResult.fail("Worker process is not running", SlimLOErrorCode.NOT_INITIALIZED, null);
+            }
+            trimStderrLog();
 
-            Future<ConversionResult> future = executor.submit(() -> {
+            final AtomicLong lastActivity = new AtomicLong(System.nanoTime());
+            return exchange("Buffer conversion", timeoutMillis, stallTimeoutMillis, lastActivity, () -> {
                 // Send JSON header frame
                 byte[] requestBytes = Protocol.serialize(request);
                 Protocol.writeMessage(stdin, requestBytes);
@@ -258,68 +348,542 @@ public final class WorkerProcess implements Closeable {
                 // Send binary document frame
                 Protocol.writeMessage(stdin, documentData);
 
-                // Read JSON response frame
-                byte[] responseBytes = Protocol.readMessage(stdout);
-                if (responseBytes == null) {
-                    initialized = false;
-                    int exitCode = process.isAlive() ? -1 : process.exitValue();
+                // Read JSON response frame (forwarding any progress frames)
+                JsonObject response = readResponse(listener, lastActivity);
+                if (response == null) {
+                    lose();
+                    int exitCode = exitCode();
                     return ConversionResult.fail(
                             "Worker process crashed during buffer conversion (exit code: " + exitCode + ").",
                             SlimLOErrorCode.UNKNOWN, null);
                 }
 
-                return parseConvertResponse(responseBytes, true);
-            });
+                return parseConvertResponse(response, true);
+            }, CONVERSION_FAILURE);
+        } finally {
+            lock.unlock();
+        }
+    }
 
-            try {
-                return future.get(timeoutMillis, TimeUnit.MILLISECONDS);
-            } catch (TimeoutException e) {
-                future.cancel(true);
-                killProcess();
-                initialized = false;
-                return ConversionResult.fail(
-                        "Buffer conversion timed out after " + (timeoutMillis / 1000) + " seconds",
-                        SlimLOErrorCode.UNKNOWN, null);
-            } catch (ExecutionException e) {
-                Throwable cause = e.getCause();
-                if (cause instanceof IOException) {
-                    initialized = false;
+    /**
+     * Execute a chunked buffer conversion: {@code input} is sent to the worker as it
+     * is read, and the PDF is written to {@code output} as it arrives. Reading the
+     * input counts as activity for the stall timeout. The request must carry
+     * {@code "chunked": true}.
+     */
+    public ConversionResult convertStream(
+            final Map<String, Object> request,
+            final InputStream input,
+            final OutputStream output,
+            long timeoutMillis,
+            long stallTimeoutMillis,
+            final ProgressListener listener) {
+        if (disposed) {
+            return ConversionResult.fail("Worker is disposed", SlimLOErrorCode.NOT_INITIALIZED, null);
+        }
+        lock.lock();
+        try {
+            // Checked under the lock: the worker may have died while this request waited
+            if (!initialized || !isAlive()) {
+                return ConversionResult.fail("Worker process is not running", SlimLOErrorCode.NOT_INITIALIZED, null);
+            }
+            trimStderrLog();
+
+            final AtomicLong lastActivity = new AtomicLong(System.nanoTime());
+            final InputStream source = new FilterInputStream(input) {
+                @Override
+                public int read(byte[] b, int off, int len) throws IOException {
+                    lastActivity.set(System.nanoTime());
+                    return super.read(b, off, len);
                 }
-                return ConversionResult.fail(
-                        "Buffer conversion error: " + (cause != null ? cause.getMessage() : "unknown"),
-                        SlimLOErrorCode.UNKNOWN, null);
-            } catch (InterruptedException e) {
-                Thread.currentThread().interrupt();
-                return ConversionResult.fail("Buffer conversion interrupted", SlimLOErrorCode.UNKNOWN, null);
+            };
+            return exchange("Buffer conversion", timeoutMillis, stallTimeoutMillis, lastActivity, () -> {
+                Protocol.writeMessage(stdin, Protocol.serialize(request));
+
+                // Send the document as chunk frames while it is read
+                Protocol.writeChunked(stdin, source);
+                lastActivity.set(System.nanoTime());
+
+                JsonObject response = readResponse(listener, lastActivity);
+                if (response == null) {
+                    lose();
+                    int exitCode = exitCode();
+                    return ConversionResult.fail(
+                            "Worker process crashed during buffer conversion (exit code: " + exitCode + ").",
+                            SlimLOErrorCode.UNKNOWN, null);
+                }
+
+                return parseConvertResponse(response, true, output);
+            }, CONVERSION_FAILURE);
+        } finally {
+            lock.unlock();
+        }
+    }
+
+    /**
+     * Query document metadata (load + layout, no export). When documentData is
+     * non-null it is sent as a binary frame after the request header.
+     */
+    public DocumentInfoResult getInfo(
+            final Map<String, Object> request,
+            final byte[] documentData,
+            long timeoutMillis) {
+        if (disposed) {
+            return DocumentInfoResult.fail("Worker is disposed", SlimLOErrorCode.NOT_INITIALIZED, null);
+        }
+        lock.lock();
+        try {
+            // Checked under the lock: the worker may have died while this request waited
+            if (!initialized || !isAlive()) {
+                return DocumentInfoResult.fail("Worker process is not running", SlimLOErrorCode.NOT_INITIALIZED, null);
+            }
+            trimStderrLog();
+
+            return exchange("Document info", timeoutMillis, 0, null, () -> {
+                Protocol.writeMessage(stdin, Protocol.serialize(request));
+                if (documentData != null) {
+                    Protocol.writeMessage(stdin, documentData);
+                }
+
+                JsonObject response = readResponse(null, new AtomicLong());
+                if (response == null) {
+                    lose();
+                    int exitCode = exitCode();
+                    return DocumentInfoResult.fail(
+                            "Worker process crashed while loading the document (exit code: " + exitCode + ").",
+                            SlimLOErrorCode.UNKNOWN, null);
+                }
+
+                return parseInfoResponse(response);
+            }, message -> DocumentInfoResult.fail(message, SlimLOErrorCode.UNKNOWN, null));
+        } finally {
+            lock.unlock();
+        }
+    }
+
+    /**
+     * Render page images (load + layout + paint, no export). When documentData
+     * is non-null it is sent as a binary frame after the request header.
+     */
+    public ConversionResult render(
+            final Map<String, Object> request,
+            final byte[] documentData,
+            long timeoutMillis) {
+        if (disposed) {
+            return ConversionResult.fail("Worker is disposed", SlimLOErrorCode.NOT_INITIALIZED, null);
+        }
+        lock.lock();
+        try {
+            // Checked under the lock: the worker may have died while this request waited
+            if (!initialized || !isAlive()) {
+                return ConversionResult.fail("Worker process is not running", SlimLOErrorCode.NOT_INITIALIZED, null);
+            }
+            trimStderrLog();
+
+            return exchange("Page rendering", timeoutMillis, 0, null, () -> {
+                Protocol.writeMessage(stdin, Protocol.serialize(request));
+                if (documentData != null) {
+                    Protocol.writeMessage(stdin, documentData);
+                }
+
+                JsonObject response = readResponse(null, new AtomicLong());
+                if (response == null) {
+                    lose();
+                    int exitCode = exitCode();
+                    return ConversionResult.fail(
+                            "Worker process crashed while rendering pages (exit code: " + exitCode + ").",
+                            SlimLOErrorCode.UNKNOWN, null);
+                }
+
+                return parseRenderResponse(response);
+            }, CONVERSION_FAILURE);
+        } finally {
+            lock.unlock();
+        }
+    }
+
+    /**
+     * Bring the worker's fonts up to fontDirectories with an "add_fonts" request
+     * for the directories it does not have yet; no-op if it has them all. Waits
+     * for a running request to finish first. A directory the worker rejects is
+     * not retried.
+     */
+    public ConversionResult addFonts(final List<String> fontDirectories, long timeoutMillis) {
+        if (disposed) {
+            return ConversionResult.fail("Worker is disposed", SlimLOErrorCode.NOT_INITIALIZED, null);
+        }
+        lock.lock();
+        try {
+            // Checked under the lock: the worker may have died while this request waited
+            if (!initialized || !isAlive()) {
+                return ConversionResult.fail("Worker process is not running", SlimLOErrorCode.NOT_INITIALIZED, null);
+            }
+            final List<String> pending = pendingFonts(registeredFonts, fontDirectories);
+            if (pending.isEmpty()) {
+                return ConversionResult.ok(null);
             }
+            trimStderrLog();
+
+            return exchange("Font registration", timeoutMillis, 0, null, () -> {
+                Map<String, Object> request = new HashMap<String, Object>();
+                request.put("type", "add_fonts");
+                request.put("id", 0);
+                request.put("paths", pending);
+                Protocol.writeMessage(stdin, Protocol.serialize(request));
+
+                JsonObject response = readResponse(null, new AtomicLong());
+                if (response == null) {
+                    lose();
+                    int exitCode = exitCode();
+                    return ConversionResult.fail(
+                            "Worker process crashed while registering fonts (exit code: " + exitCode + ").",
+                            SlimLOErrorCode.UNKNOWN, null);
+                }
+                registeredFonts = fontDirectories;
+                return parseFontsResponse(response);
+            }, CONVERSION_FAILURE);
         } finally {
             lock.unlock();
         }
     }
 
-    private ConversionResult parseConvertResponse(byte[] responseBytes, boolean isBuffer) throws IOException {
-        JsonObject root = Protocol.deserialize(responseBytes);
+    /** Entries of wanted not in registered, in order. */
+    public static List<String> pendingFonts(List<String> registered, List<String> wanted) {
+        if (registered == wanted) {
+            return Collections.emptyList();
+        }
+        List<String> pending = new ArrayList<String>();
+        for (String path : wanted) {
+            if (!registered.contains(path) && !pending.contains(path)) {
+                pending.add(path);
+            }
+        }
+        return pending;
+    }
+
+    /** One request/response exchange with the worker, run on the calling thread. */
+    private interface Exchange<T> {
+        T run() throws IOException;
+    }
+
+    /** Build an operation's result for a failed or expired exchange. */
+    private interface Failure<T> {
+        T fail(String message);
+    }
+
+    private static final Failure<ConversionResult> CONVERSION_FAILURE =
+            message -> ConversionResult.fail(message, SlimLOErrorCode.UNKNOWN, null);
+
+    /**
+     * Run an exchange on the calling thread under the pool's watchdog, which kills
+     * the worker when the overall timeout elapses or, if stallTimeoutMillis is
+     * positive, when lastActivity has not moved for that long. Killing the worker
+     * closes its pipes, so the blocked read returns instead of needing a thread
+     * of its own to abandon. A failed exchange also kills the worker: the frame
+     * stream is out of step and cannot carry another request.
+     */
+    private <T> T exchange(String operation, long timeoutMillis, long stallTimeoutMillis,
+                           AtomicLong lastActivity, Exchange<T> exchange, Failure<T> failure) {
+        Watch watch = new Watch(timeoutMillis, stallTimeoutMillis, lastActivity);
+        T result = null;
+        Exception error = null;
+        try {
+            result = exchange.run();
+        } catch (IOException | RuntimeException e) {
+            error = e;
+        }
+
+        if (watch.cancel()) {
+            timedOut = true;
+            lose();
+            metrics.onTimeout(watch.stalled);
+            return failure.fail(watch.stalled
+                    ? operation + " stalled: no progress from worker for " + (stallTimeoutMillis / 1000) + " seconds"
+                    : operation + " timed out after " + (timeoutMillis / 1000) + " seconds");
+        }
+        if (error != null) {
+            killProcess();
+            lose();
+            return failure.fail(operation + " error: " + error.getMessage());
+        }
+        return result;
+    }
+
+    /**
+     * Deadline and stall timer of one exchange. It holds a single task on the
+     * watchdog, rescheduled for the earliest moment either limit could expire,
+     * so a waiting exchange costs no thread.
+     */
+    private final class Watch implements Runnable {
+        private final long deadline;
+        private final long stallNanos;
+        private final AtomicLong lastActivity;
+        private ScheduledFuture<?> pending;
+        private boolean done;
+        private boolean expired;
+        volatile boolean stalled;
+
+        Watch(long timeoutMillis, long stallTimeoutMillis, AtomicLong lastActivity) {
+            this.deadline = System.nanoTime() + TimeUnit.MILLISECONDS.toNanos(timeoutMillis);
+            this.stallNanos = lastActivity != null ? TimeUnit.MILLISECONDS.toNanos(stallTimeoutMillis) : 0;
+            this.lastActivity = lastActivity;
+            run();
+        }
+
+        @Override
+        public void run() {
+            synchronized (this) {
+                if (done) {
+                    return;
+                }
+                long now = System.nanoTime();
+                long due = deadline;
+                boolean stall = false;
+                if (stallNanos > 0) {
+                    long stallDue = lastActivity.get() + stallNanos;
+                    if (stallDue - due < 0) {
+                        due = stallDue;
+                        stall = true;
+                    }
+                }
+                if (due - now > 0) {
+                    try {
+                        pending = watchdog.schedule(this, due - now, TimeUnit.NANOSECONDS);
+                    } catch (RejectedExecutionException e) {
+                        // Pool closed: the worker is being shut down anyway
+                    }
+                    return;
+                }
+                stalled = stall;
+                expired = true;
+                done = true;
+            }
+            killProcess();
+        }
+
+        /** Stop the timer. Returns true if it had already expired and killed the worker. */
+        synchronized boolean cancel() {
+            done = true;
+            if (pending != null) {
+                pending.cancel(false);
+            }
+            return expired;
+        }
+    }
+
+    /**
+     * Read frames until a non-progress response arrives. Progress frames are
+     * forwarded to the listener and re-arm the stall timer.
+     * Returns null if the worker closed the pipe.
+     */
+    private JsonObject readResponse(ProgressListener listener, AtomicLong lastActivity) throws IOException {
+        while (true) {
+            JsonObject root = frames.readJson();
+            if (root == null) {
+                return null;
+            }
+
+            String type = root.has("type") ? root.get("type").getAsString() : "";
+            if (!"progress".equals(type)) {
+                return root;
+            }
+
+            lastActivity.set(System.nanoTime());
+            if (listener != null) {
+                try {
+                    listener.onProgress(parseProgress(root));
+                } catch (RuntimeException e) {
+                    // A failing listener must not desynchronize the frame stream
+                }
+            }
+        }
+    }
+
+    /** Parse a worker "progress" frame. */
+    public static ConversionProgress parseProgress(JsonObject root) {
+        return new ConversionProgress(
+                ConversionPhase.fromString(root.has("phase") ? root.get("phase").getAsString() : null),
+                getInt(root, "percent"),
+                getInt(root, "pages_laid_out"),
+                getInt(root, "pages_exported"),
+                root.has("bytes_written") && root.get("bytes_written").isJsonPrimitive()
+                        ? root.get("bytes_written").getAsLong()
+                        : 0L);
+    }
+
+    /** Parse a successful worker "info_result" frame. */
+    public static DocumentInfo parseDocumentInfo(JsonObject root) {
+        List<PageSize> pages = new ArrayList<PageSize>();
+        if (root.has("pages") && root.get("pages").isJsonArray()) {
+            for (JsonElement element : root.getAsJsonArray("pages")) {
+                if (!element.isJsonObject()) continue;
+                JsonObject page = element.getAsJsonObject();
+                pages.add(new PageSize(getDouble(page, "width"), getDouble(page, "height")));
+            }
+        }
+
+        return new DocumentInfo(
+                getInt(root, "page_count"),
+                pages,
+                getInt(root, "section_count"),
+                getInt(root, "image_count"),
+                getInt(root, "word_count"),
+                getStrings(root, "fonts"),
+                getStrings(root, "missing_fonts"));
+    }
+
+    /** Build a page image from one entry of a response's "images" array and its binary frame. */
+    public static PageImage parsePageImage(JsonObject meta, byte[] data) {
+        return new PageImage(
+                getInt(meta, "page"),
+                getInt(meta, "width"),
+                getInt(meta, "height"),
+                PageImageFormat.fromValue(getInt(meta, "format")),
+                data);
+    }
+
+    /** Parse the "text" array of a successful conversion result. */
+    public static List<PageText> parsePageText(JsonObject root) {
+        List<PageText> pages = new ArrayList<PageText>();
+        if (!root.has("text") || !root.get("text").isJsonArray()) {
+            return pages;
+        }
+        for (JsonElement element : root.getAsJsonArray("text")) {
+            if (!element.isJsonObject()) continue;
+            JsonObject page = element.getAsJsonObject();
+
+            List<WordBox> words = new ArrayList<WordBox>();
+            if (page.has("words") && page.get("words").isJsonArray()) {
+                for (JsonElement w : page.getAsJsonArray("words")) {
+                    if (!w.isJsonArray() || w.getAsJsonArray().size() < 5) continue;
+                    JsonArray box = w.getAsJsonArray();
+                    words.add(new WordBox(
+                            box.get(0).getAsDouble(), box.get(1).getAsDouble(),
+                            box.get(2).getAsDouble(), box.get(3).getAsDouble(),
+                            box.get(4).getAsString()));
+                }
+            }
+
+            pages.add(new PageText(
+                    getInt(page, "page"),
+                    new PageSize(getDouble(page, "width"), getDouble(page, "height")),
+                    page.has("text") && page.get("text").isJsonPrimitive() ? page.get("text").getAsString() : "",
+                    words));
+        }
+        return pages;
+    }
+
+    /**
+     * Read the binary frames announced by a response's "images" array.
+     * Returns null if the worker closed the pipe part-way.
+     */
+    private List<PageImage> readPageImages(JsonObject root) throws IOException {
+        List<PageImage> images = new ArrayList<PageImage>();
+        if (!root.has("images") || !root.get("images").isJsonArray()) {
+            return images;
+        }
+        for (JsonElement element : root.getAsJsonArray("images")) {
+            byte[] data = frames.readBytes();
+            if (data == null) {
+                return null;
+            }
+            images.add(parsePageImage(element.getAsJsonObject(), data));
+        }
+        return images;
+    }
+
+    private static double getDouble(JsonObject root, String name) {
+        return root.has(name) && root.get(name).isJsonPrimitive() ? root.get(name).getAsDouble() : 0.0;
+    }
+
+    private static List<String> getStrings(JsonObject root, String name) {
+        List<String> list = new ArrayList<String>();
+        if (root.has(name) && root.get(name).isJsonArray()) {
+            for (JsonElement element : root.getAsJsonArray(name)) {
+                if (element.isJsonPrimitive()) {
+                    list.add(element.getAsString());
+                }
+            }
+        }
+        return list;
+    }
+
+    private static int getInt(JsonObject root, String name) {
+        return root.has(name) && root.get(name).isJsonPrimitive() ? root.get(name).getAsInt() : 0;
+    }
+
+    /** Report the "metrics" object of a convert result, if the worker sent one. */
+    private void recordConversion(JsonObject root, boolean success, List<ConversionDiagnostic> diagnostics) {
+        if (!root.has("metrics") || !root.get("metrics").isJsonObject()) {
+            return;
+        }
+        JsonObject m = root.getAsJsonObject("metrics");
+        long rss = (long) getDouble(m, "rss_bytes");
+        if (rss > 0) {
+            residentBytes = rss;
+        }
+
+        int fontFallbacks = 0;
+        for (ConversionDiagnostic d : diagnostics) {
+            if (d.getCategory() == DiagnosticCategory.FONT) {
+                fontFallbacks++;
+            }
+        }
+        metrics.onConversion(new ConversionMetrics(success,
+                getDouble(m, "load_ms"), getDouble(m, "export_ms"), getDouble(m, "total_ms"),
+                (long) getDouble(m, "input_bytes"), (long) getDouble(m, "output_bytes"), fontFallbacks));
+    }
+
+    private ConversionResult parseConvertResponse(JsonObject root, boolean isBuffer) throws IOException {
+        return parseConvertResponse(root, isBuffer, null);
+    }
+
+    /** With a non-null pdfSink the PDF arrives as a chunked body and is copied there. */
+    private ConversionResult parseConvertResponse(JsonObject root, boolean isBuffer, OutputStream pdfSink)
+            throws IOException {
 
         List<ConversionDiagnostic> diagnostics = root.has("diagnostics") && root.get("diagnostics").isJsonArray()
                 ? StderrDiagnosticParser.parseFromJson(root.getAsJsonArray("diagnostics"))
                 : Collections.<ConversionDiagnostic>emptyList();
 
         boolean success = root.has("success") && root.get("success").getAsBoolean();
+        recordConversion(root, success, diagnostics);
 
         if (success) {
             conversionCount.incrementAndGet();
             if (isBuffer) {
-                // Read binary PDF frame
-                byte[] pdfBytes = Protocol.readMessage(stdout);
-                if (pdfBytes == null) {
-                    initialized = false;
+                // Read binary PDF frame, or copy the chunked body to the sink
+                byte[] pdfBytes = null;
+                boolean received;
+                if (pdfSink != null) {
+                    received = frames.readChunked(pdfSink);
+                } else {
+                    pdfBytes = frames.readBytes();
+                    received = pdfBytes != null;
+                }
+                if (!received) {
+                    lose();
                     return ConversionResult.fail(
                             "Worker process crashed while sending PDF data",
                             SlimLOErrorCode.UNKNOWN, diagnostics);
                 }
-                return ConversionResult.ok(pdfBytes, diagnostics);
+                List<PageImage> images = readPageImages(root);
+                if (images == null) {
+                    lose();
+                    return ConversionResult.fail(
+                            "Worker process crashed while sending page images",
+                            SlimLOErrorCode.UNKNOWN, diagnostics);
+                }
+                return ConversionResult.ok(pdfBytes, diagnostics, images, parsePageText(root));
             }
-            return ConversionResult.ok(diagnostics);
+            List<PageImage> images = readPageImages(root);
+            if (images == null) {
+                lose();
+                return ConversionResult.fail(
+                        "Worker process crashed while sending page images",
+                        SlimLOErrorCode.UNKNOWN, diagnostics);
+            }
+            return ConversionResult.ok(null, diagnostics, images, parsePageText(root));
         } else {
             String errorMessage = root.has("error_message") && !root.get("error_message").isJsonNull()
                     ? root.get("error_message").getAsString()
@@ -333,40 +897,118 @@ public final class WorkerProcess implements Closeable {
         }
     }
 
-    private void startStderrGobbler() {
-        final InputStream stderr = process.getErrorStream();
-        Thread gobbler = new Thread(new Runnable() {
-            @Override
-            public void run() {
-                try (BufferedReader reader = new BufferedReader(new InputStreamReader(stderr))) {
-                    String line;
-                    while ((line = reader.readLine()) != null) {
-                        synchronized (stderrBuffer) {
-                            stderrBuffer.append(line).append('\n');
-                        }
-                    }
-                } catch (IOException e) {
-                    // Process ended
-                }
+    private DocumentInfoResult parseInfoResponse(JsonObject root) {
+        List<ConversionDiagnostic> diagnostics = root.has("diagnostics") && root.get("diagnostics").isJsonArray()
+                ? StderrDiagnosticParser.parseFromJson(root.getAsJsonArray("diagnostics"))
+                : Collections.<ConversionDiagnostic>emptyList();
+
+        conversionCount.incrementAndGet();
+
+        if (root.has("success") && root.get("success").getAsBoolean()) {
+            return DocumentInfoResult.ok(parseDocumentInfo(root), diagnostics);
+        }
+
+        String errorMessage = root.has("error_message") && !root.get("error_message").isJsonNull()
+                ? root.get("error_message").getAsString()
+                : "Document info failed";
+        SlimLOErrorCode errorCode = root.has("error_code") && root.get("error_code").isJsonPrimitive()
+                ? SlimLOErrorCode.fromValue(root.get("error_code").getAsInt())
+                : SlimLOErrorCode.UNKNOWN;
+        return DocumentInfoResult.fail(errorMessage, errorCode, diagnostics);
+    }
+
+    private ConversionResult parseFontsResponse(JsonObject root) {
+        List<ConversionDiagnostic> diagnostics = root.has("diagnostics") && root.get("diagnostics").isJsonArray()
+                ? StderrDiagnosticParser.parseFromJson(root.getAsJsonArray("diagnostics"))
+                : Collections.<ConversionDiagnostic>emptyList();
+
+        if (root.has("success") && root.get("success").getAsBoolean()) {
+            return ConversionResult.ok(diagnostics);
+        }
+
+        String errorMessage = root.has("error_message") && !root.get("error_message").isJsonNull()
+                ? root.get("error_message").getAsString()
+                : "Font registration failed";
+        SlimLOErrorCode errorCode = root.has("error_code") && root.get("error_code").isJsonPrimitive()
+                ? SlimLOErrorCode.fromValue(root.get("error_code").getAsInt())
+                : SlimLOErrorCode.UNKNOWN;
+        return ConversionResult.fail(errorMessage, errorCode, diagnostics);
+    }
+
+    private ConversionResult parseRenderResponse(JsonObject root) throws IOException {
+        List<ConversionDiagnostic> diagnostics = root.has("diagnostics") && root.get("diagnostics").isJsonArray()
+                ? StderrDiagnosticParser.parseFromJson(root.getAsJsonArray("diagnostics"))
+                : Collections.<ConversionDiagnostic>emptyList();
+
+        conversionCount.incrementAndGet();
+
+        if (root.has("success") && root.get("success").getAsBoolean()) {
+            List<PageImage> images = readPageImages(root);
+            if (images == null) {
+                lose();
+                return ConversionResult.fail(
+                        "Worker process crashed while sending page images",
+                        SlimLOErrorCode.UNKNOWN, diagnostics);
             }
-        }, "slimlo-stderr-gobbler");
-        gobbler.setDaemon(true);
-        gobbler.start();
+            return ConversionResult.ok(null, diagnostics, images);
+        }
+
+        String errorMessage = root.has("error_message") && !root.get("error_message").isJsonNull()
+                ? root.get("error_message").getAsString()
+                : "Page rendering failed";
+        SlimLOErrorCode errorCode = root.has("error_code") && root.get("error_code").isJsonPrimitive()
+                ? SlimLOErrorCode.fromValue(root.get("error_code").getAsInt())
+                : SlimLOErrorCode.UNKNOWN;
+        return ConversionResult.fail(errorMessage, errorCode, diagnostics);
     }
 
-    private void clearStderrBuffer() {
-        synchronized (stderrBuffer) {
-            stderrBuffer.setLength(0);
+    /** Keep the stderr log bounded; the worker may write to it between requests. */
+    private void trimStderrLog() {
+        if (stderrLog == null || stderrLog.length() <= STDERR_LOG_LIMIT) {
+            return;
+        }
+        try (RandomAccessFile file = new RandomAccessFile(stderrLog, "rw")) {
+            file.setLength(0);
+        } catch (IOException e) {
+            // Best effort — some platforms refuse while the worker holds the file
         }
     }
 
+    /** The last STDERR_LOG_LIMIT bytes of the worker's stderr. */
     private String getStderrOutput() {
-        synchronized (stderrBuffer) {
-            return stderrBuffer.toString();
+        if (stderrLog == null) {
+            return "";
+        }
+        try (RandomAccessFile file = new RandomAccessFile(stderrLog, "r")) {
+            long start = Math.max(0, file.length() - STDERR_LOG_LIMIT);
+            byte[] tail = new byte[(int) (file.length() - start)];
+            file.seek(start);
+            file.readFully(tail);
+            return new String(tail, java.nio.charset.StandardCharsets.UTF_8);
+        } catch (IOException e) {
+            return "";
+        }
+    }
+
+    /** Exit code of the worker process, or -1 if running or remote. */
+    private int exitCode() {
+        return process != null && !process.isAlive() ? process.exitValue() : -1;
+    }
+
+    /** Mark the worker lost by the running exchange; the first loss is the one recorded. */
+    private void lose() {
+        if (initialized) {
+            lostBy = Thread.currentThread();
+            initialized = false;
         }
     }
 
     private void killProcess() {
+        if (channel != null) {
+            // Dropping the connection makes the server kill the worker serving it
+            closeChannel();
+            return;
+        }
         try {
             if (process != null && process.isAlive()) {
                 process.destroyForcibly();
@@ -376,11 +1018,33 @@ public final class WorkerProcess implements Closeable {
         }
     }
 
+    private void closeChannel() {
+        try {
+            channel.close();
+        } catch (IOException e) {
+            // Best effort
+        }
+    }
+
     @Override
     public void close() {
         if (disposed) return;
         disposed = true;
 
+        if (channel != null) {
+            if (initialized) {
+                try {
+                    Map<String, Object> quitRequest = new HashMap<String, Object>();
+                    quitRequest.put("type", "quit");
+                    Protocol.writeMessage(stdin, Protocol.serialize(quitRequest));
+                } catch (Exception e) {
+                    // Best effort — the server may already have closed the connection
+                }
+            }
+            closeChannel();
+            return;
+        }
+
         if (process != null && process.isAlive()) {
             try {
                 // Try graceful shutdown
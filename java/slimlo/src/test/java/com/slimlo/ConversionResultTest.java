@@ -5,6 +5,7 @@ import org.junit.jupiter.api.Test;
 import java.util.Arrays;
 import java.util.Collections;
 import java.util.List;
+import java.util.concurrent.TimeUnit;
 
 import static org.junit.jupiter.api.Assertions.*;
 
@@ -124,6 +125,8 @@ class ConversionResultTest {
     void slimLOErrorCode_fromValue() {
         assertEquals(SlimLOErrorCode.OK, SlimLOErrorCode.fromValue(0));
         assertEquals(SlimLOErrorCode.INIT_FAILED, SlimLOErrorCode.fromValue(1));
+        assertEquals(SlimLOErrorCode.QUARANTINED, SlimLOErrorCode.fromValue(11));
+        assertEquals(SlimLOErrorCode.DEADLINE_EXCEEDED, SlimLOErrorCode.fromValue(12));
         assertEquals(SlimLOErrorCode.UNKNOWN, SlimLOErrorCode.fromValue(99));
         assertEquals(SlimLOErrorCode.UNKNOWN, SlimLOErrorCode.fromValue(999));
     }
@@ -155,6 +158,29 @@ class ConversionResultTest {
         assertFalse(opts.isTaggedPdf());
         assertNull(opts.getPageRange());
         assertNull(opts.getPassword());
+        assertEquals(PdfPreset.NONE, opts.getPreset());
+        assertTrue(opts.getFilterProperties().isEmpty());
+        assertNull(opts.getProgressListener());
+        assertFalse(opts.isLazyLayout());
+        assertFalse(opts.isSkipFieldUpdate());
+    }
+
+    @Test
+    void conversionOptions_presetAndFilterProperties() {
+        ConversionOptions opts = ConversionOptions.builder()
+                .preset(PdfPreset.SMALL)
+                .filterProperty("ExportBookmarks", "false")
+                .filterProperty("Quality", "70")
+                .build();
+
+        assertEquals(PdfPreset.SMALL, opts.getPreset());
+        assertEquals(2, opts.getPreset().getValue());
+        assertEquals("false", opts.getFilterProperties().get("ExportBookmarks"));
+        assertEquals("70", opts.getFilterProperties().get("Quality"));
+        assertThrows(UnsupportedOperationException.class, () ->
+                opts.getFilterProperties().put("X", "y"));
+        assertThrows(IllegalArgumentException.class, () ->
+                ConversionOptions.builder().filterProperty("", "v"));
     }
 
     @Test
@@ -165,6 +191,9 @@ class ConversionResultTest {
                 .dpi(150)
                 .taggedPdf(true)
                 .pageRange("1-3")
+                .lazyLayout(true)
+                .skipFieldUpdate(true)
+                .deadlineMillis(30000)
                 .password("secret")
                 .build();
 
@@ -173,6 +202,9 @@ class ConversionResultTest {
         assertEquals(150, opts.getDpi());
         assertTrue(opts.isTaggedPdf());
         assertEquals("1-3", opts.getPageRange());
+        assertTrue(opts.isLazyLayout());
+        assertTrue(opts.isSkipFieldUpdate());
+        assertEquals(30000, opts.getDeadlineMillis());
         assertEquals("secret", opts.getPassword());
     }
 
@@ -185,6 +217,83 @@ class ConversionResultTest {
         assertEquals(1, opts.getMaxWorkers());
         assertEquals(0, opts.getMaxConversionsPerWorker());
         assertFalse(opts.isWarmUp());
+        assertEquals(0, opts.getStallTimeoutMillis());
+        assertEquals(0, opts.getThreadsPerWorker());
+        assertEquals(2, opts.getQuarantineAfterCrashes());
+        assertEquals(1024, opts.getQuarantineCapacity());
+        assertFalse(opts.isIsolateSuspectDocuments());
+    }
+
+    @Test
+    void pdfConverterOptions_quarantine() {
+        PdfConverterOptions opts = PdfConverterOptions.builder()
+                .quarantineAfterCrashes(3)
+                .quarantineCapacity(10)
+                .isolateSuspectDocuments(true)
+                .build();
+        assertEquals(3, opts.getQuarantineAfterCrashes());
+        assertEquals(10, opts.getQuarantineCapacity());
+        assertTrue(opts.isIsolateSuspectDocuments());
+        assertThrows(IllegalArgumentException.class, () ->
+                PdfConverterOptions.builder().quarantineAfterCrashes(-1).build());
+        assertThrows(IllegalArgumentException.class, () ->
+                PdfConverterOptions.builder().quarantineCapacity(0).build());
+        // Capacity is irrelevant once quarantine is off
+        assertEquals(0, PdfConverterOptions.builder()
+                .quarantineAfterCrashes(0).quarantineCapacity(0).build().getQuarantineAfterCrashes());
+    }
+
+    @Test
+    void pdfConverterOptions_tenants() {
+        PdfConverterOptions opts = PdfConverterOptions.builder()
+                .tenantWeight("interactive", 4)
+                .maxWorkersPerTenant(2)
+                .build();
+        assertEquals(Integer.valueOf(4), opts.getTenantWeights().get("interactive"));
+        assertEquals(2, opts.getMaxWorkersPerTenant());
+        assertTrue(PdfConverterOptions.builder().build().getTenantWeights().isEmpty());
+        assertThrows(IllegalArgumentException.class, () ->
+                PdfConverterOptions.builder().tenantWeight("bulk", 0));
+        assertThrows(IllegalArgumentException.class, () ->
+                PdfConverterOptions.builder().maxWorkersPerTenant(-1).build());
+        assertEquals("acme", ConversionOptions.builder().tenant("acme").build().getTenant());
+    }
+
+    @Test
+    void pdfConverterOptions_elasticSizing() {
+        PdfConverterOptions opts = PdfConverterOptions.builder()
+                .maxWorkers(4)
+                .minWorkers(1)
+                .idleTimeout(2, TimeUnit.MINUTES)
+                .memoryBudget(4L << 30)
+                .build();
+        assertEquals(1, opts.getMinWorkers());
+        assertEquals(120000, opts.getIdleTimeoutMillis());
+        assertEquals(4L << 30, opts.getMemoryBudget());
+        assertEquals(0, PdfConverterOptions.builder().build().getMinWorkers());
+        assertThrows(IllegalArgumentException.class, () ->
+                PdfConverterOptions.builder().maxWorkers(2).minWorkers(3).build());
+        assertThrows(IllegalArgumentException.class, () ->
+                PdfConverterOptions.builder().idleTimeoutMillis(-1).build());
+    }
+
+    @Test
+    void pdfConverterOptions_coalesceDuplicates() {
+        assertFalse(PdfConverterOptions.builder().build().isCoalesceDuplicates());
+        assertTrue(PdfConverterOptions.builder().coalesceDuplicates(true).build().isCoalesceDuplicates());
+    }
+
+    @Test
+    void pdfConverterOptions_threadsPerWorker() {
+        assertEquals(2, PdfConverterOptions.builder().threadsPerWorker(2).build().getThreadsPerWorker());
+        assertThrows(IllegalArgumentException.class, () ->
+                PdfConverterOptions.builder().threadsPerWorker(-1).build());
+    }
+
+    @Test
+    void pdfConverterOptions_rejectsNegativeStallTimeout() {
+        assertThrows(IllegalArgumentException.class, () ->
+                PdfConverterOptions.builder().stallTimeoutMillis(-1).build());
     }
 
     @Test
@@ -193,6 +302,16 @@ class ConversionResultTest {
                 PdfConverterOptions.builder().maxWorkers(0).build());
     }
 
+    @Test
+    void conversionPhase_fromString() {
+        assertEquals(ConversionPhase.LOAD, ConversionPhase.fromString("load"));
+        assertEquals(ConversionPhase.LAYOUT, ConversionPhase.fromString("layout"));
+        assertEquals(ConversionPhase.EXPORT, ConversionPhase.fromString("export"));
+        assertEquals(ConversionPhase.DONE, ConversionPhase.fromString("done"));
+        assertEquals(ConversionPhase.UNKNOWN, ConversionPhase.fromString("other"));
+        assertEquals(ConversionPhase.UNKNOWN, ConversionPhase.fromString(null));
+    }
+
     // --- SlimLOException ---
 
     @Test
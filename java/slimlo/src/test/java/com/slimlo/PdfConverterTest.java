@@ -1,13 +1,32 @@
 package com.slimlo;
 
+import com.slimlo.internal.AdmissionQueue;
+import com.slimlo.internal.CpuTopology;
+import com.slimlo.internal.CrashQuarantine;
+import com.slimlo.internal.NativeBridge;
+import com.slimlo.internal.NodeMemory;
+import com.slimlo.internal.Protocol;
+import com.slimlo.internal.SingleFlight;
+import com.slimlo.internal.WorkerPool;
+import com.slimlo.internal.WorkerPoolSettings;
+import com.slimlo.internal.WorkerProcess;
 import org.junit.jupiter.api.Test;
 import org.junit.jupiter.api.condition.EnabledIfEnvironmentVariable;
 import org.junit.jupiter.api.io.TempDir;
 
 import java.io.*;
+import java.nio.ByteBuffer;
 import java.nio.file.Files;
 import java.nio.file.Path;
 import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.atomic.AtomicInteger;
 
 import static org.junit.jupiter.api.Assertions.*;
 
@@ -32,6 +51,586 @@ class PdfConverterTest {
         assertEquals(SlimLOErrorCode.INVALID_ARGUMENT, result.getErrorCode());
     }
 
+    @Test
+    void quarantine_refusesDocumentAtThreshold() {
+        CrashQuarantine q = new CrashQuarantine(2, 8);
+        String key = CrashQuarantine.keyOf(new byte[] {1, 2, 3});
+        assertFalse(q.isQuarantined(key));
+        assertEquals(1, q.recordCrash(key));
+        assertFalse(q.isQuarantined(key));
+        assertEquals(2, q.recordCrash(key));
+        assertTrue(q.isQuarantined(key));
+    }
+
+    @Test
+    void quarantine_evictsLeastRecentlySeen() {
+        CrashQuarantine q = new CrashQuarantine(1, 2);
+        q.recordCrash("a");
+        q.recordCrash("b");
+        q.recordCrash("a"); // "b" is now the oldest
+        q.recordCrash("c");
+        assertEquals(2, q.size());
+        assertTrue(q.isQuarantined("a"));
+        assertFalse(q.isQuarantined("b"));
+        assertTrue(q.isQuarantined("c"));
+    }
+
+    @Test
+    void quarantine_fileKeyMatchesBufferKey(@TempDir Path tempDir) throws Exception {
+        byte[] data = "attachment bytes".getBytes("UTF-8");
+        Path file = tempDir.resolve("a.docx");
+        Files.write(file, data);
+        assertEquals(CrashQuarantine.keyOf(data), CrashQuarantine.keyOfFile(file.toString()));
+        assertEquals(64, CrashQuarantine.keyOf(data).length());
+        assertNull(CrashQuarantine.keyOfFile(tempDir.resolve("missing.docx").toString()));
+    }
+
+    @Test
+    void pool_failsQuarantinedDocumentWithoutStartingWorker() {
+        // The worker path does not exist: reaching a worker would fail with INIT_FAILED
+        WorkerPool pool = new WorkerPool(new WorkerPoolSettings()
+                .workerPath("/nonexistent/slimlo_worker")
+                .resourcePath("/nonexistent")
+                .timeoutMillis(5000)
+                .quarantine(2, 16));
+        try {
+            byte[] data = {0x50, 0x4B, 0x03, 0x04, (byte) 0xFF};
+            String key = CrashQuarantine.keyOf(data);
+            pool.getQuarantine().recordCrash(key);
+            pool.getQuarantine().recordCrash(key);
+
+            Map<String, Object> request = new HashMap<>();
+            request.put("type", "convert_buffer");
+            ConversionResult result = pool.executeBuffer(request, data, null, AdmissionQueue.NO_DEADLINE, null);
+            assertFalse(result.isSuccess());
+            assertEquals(SlimLOErrorCode.QUARANTINED, result.getErrorCode());
+        } finally {
+            pool.close();
+        }
+    }
+
+    @Test
+    void admission_admitsEarliestDeadlineFirst() throws Exception {
+        final AdmissionQueue queue = new AdmissionQueue(1);
+        assertTrue(queue.acquire(null, AdmissionQueue.NO_DEADLINE));
+
+        final List<String> order = Collections.synchronizedList(new ArrayList<String>());
+        Thread none = waiterThread(queue, AdmissionQueue.NO_DEADLINE, "none", order);
+        Thread late = waiterThread(queue, AdmissionQueue.deadlineAfter(600000), "late", order);
+        Thread soon = waiterThread(queue, AdmissionQueue.deadlineAfter(60000), "soon", order);
+        while (queue.getQueueLength() < 3) {
+            Thread.sleep(5);
+        }
+
+        queue.release(null);
+        none.join();
+        late.join();
+        soon.join();
+        assertEquals(Arrays.asList("soon", "late", "none"), order);
+    }
+
+    private static Thread waiterThread(final AdmissionQueue queue, final long deadline,
+                                       final String name, final List<String> order) throws Exception {
+        int expected = queue.getQueueLength() + 1;
+        Thread t = new Thread(new Runnable() {
+            @Override
+            public void run() {
+                try {
+                    if (queue.acquire(null, deadline)) {
+                        order.add(name);
+                        queue.release(null);
+                    }
+                } catch (InterruptedException e) {
+                    Thread.currentThread().interrupt();
+                }
+            }
+        });
+        t.start();
+        // Enqueue in a known order
+        while (queue.getQueueLength() < expected) {
+            Thread.sleep(5);
+        }
+        return t;
+    }
+
+    @Test
+    void admission_shedsWhenRecentServiceTimesExceedDeadline() throws Exception {
+        AdmissionQueue queue = new AdmissionQueue(1);
+        queue.recordServiceTime(10000000000L); // 10 s
+        assertEquals(10000, queue.getEstimatedServiceMillis());
+
+        assertFalse(queue.acquire(null, AdmissionQueue.deadlineAfter(1000)));
+        assertTrue(queue.acquire(null, AdmissionQueue.deadlineAfter(60000)));
+        assertEquals(1, queue.getShedCount());
+    }
+
+    @Test
+    void admission_shedsQueuedRequestWhenDeadlinePasses() throws Exception {
+        AdmissionQueue queue = new AdmissionQueue(1);
+        assertTrue(queue.acquire(null, AdmissionQueue.NO_DEADLINE));
+
+        assertFalse(queue.acquire(null, AdmissionQueue.deadlineAfter(50)));
+        assertEquals(0, queue.getQueueLength());
+        assertEquals(1, queue.getShedCount());
+    }
+
+    @Test
+    void admission_sharesSlotsAcrossTenantsByWeight() throws Exception {
+        Map<String, Integer> weights = new HashMap<>();
+        weights.put("interactive", 3);
+        final AdmissionQueue queue = new AdmissionQueue(1, weights, 0);
+        assertTrue(queue.acquire("bulk", AdmissionQueue.NO_DEADLINE));
+
+        // Bulk queued first; interactive still gets three admissions per bulk one
+        final List<String> order = Collections.synchronizedList(new ArrayList<String>());
+        for (int i = 0; i < 4; i++) {
+            tenantThread(queue, "bulk", order);
+        }
+        for (int i = 0; i < 6; i++) {
+            tenantThread(queue, "interactive", order);
+        }
+
+        queue.release("bulk");
+        while (order.size() < 10) {
+            Thread.sleep(5);
+        }
+        assertEquals(Arrays.asList("interactive", "interactive", "interactive", "bulk",
+                "interactive", "interactive", "interactive", "bulk"), order.subList(0, 8));
+    }
+
+    /** Queue one request for the tenant; once admitted it is recorded and released at once. */
+    private static void tenantThread(final AdmissionQueue queue, final String tenant,
+                                     final List<String> order) throws Exception {
+        int expected = queue.getQueueLength() + 1;
+        Thread t = new Thread(new Runnable() {
+            @Override
+            public void run() {
+                try {
+                    if (queue.acquire(tenant, AdmissionQueue.NO_DEADLINE)) {
+                        order.add(tenant);
+                        queue.release(tenant);
+                    }
+                } catch (InterruptedException e) {
+                    Thread.currentThread().interrupt();
+                }
+            }
+        });
+        t.setDaemon(true);
+        t.start();
+        while (queue.getQueueLength() < expected) {
+            Thread.sleep(5);
+        }
+    }
+
+    @Test
+    void admission_tenantCapLeavesSlotsForOthers() throws Exception {
+        final AdmissionQueue queue = new AdmissionQueue(3, null, 2);
+        assertTrue(queue.acquire("bulk", AdmissionQueue.NO_DEADLINE));
+        assertTrue(queue.acquire("bulk", AdmissionQueue.NO_DEADLINE));
+
+        // A free slot exists, but bulk is at its cap
+        final List<String> order = Collections.synchronizedList(new ArrayList<String>());
+        tenantThread(queue, "bulk", order);
+        assertEquals(1, queue.getQueueLength("bulk"));
+
+        assertTrue(queue.acquire("interactive", AdmissionQueue.NO_DEADLINE));
+        assertTrue(order.isEmpty());
+
+        queue.release("bulk");
+        while (order.isEmpty()) {
+            Thread.sleep(5);
+        }
+        assertEquals(0, queue.getQueueLength());
+    }
+
+    @Test
+    void nodeMemory_readsCgroupV2AndV1(@TempDir Path tempDir) throws Exception {
+        Path v2 = Files.createDirectories(tempDir.resolve("v2"));
+        Files.write(v2.resolve("memory.max"), "2147483648\n".getBytes("US-ASCII"));
+        Files.write(v2.resolve("memory.current"), "536870912\n".getBytes("US-ASCII"));
+        assertEquals(Long.valueOf(2147483648L), NodeMemory.limit(v2.toString()));
+        assertEquals(Long.valueOf(536870912L), NodeMemory.usage(v2.toString()));
+        Files.write(v2.resolve("memory.max"), "max\n".getBytes("US-ASCII"));
+        assertNull(NodeMemory.limit(v2.toString()));
+
+        Path v1 = Files.createDirectories(tempDir.resolve("v1").resolve("memory"));
+        Files.write(v1.resolve("memory.limit_in_bytes"), "9223372036854771712\n".getBytes("US-ASCII"));
+        Files.write(v1.resolve("memory.usage_in_bytes"), "104857600\n".getBytes("US-ASCII"));
+        assertNull(NodeMemory.limit(v1.getParent().toString()));
+        assertEquals(Long.valueOf(104857600L), NodeMemory.usage(v1.getParent().toString()));
+
+        assertNull(NodeMemory.limit(tempDir.resolve("none").toString()));
+    }
+
+    @Test
+    void cpuTopology_readsNodesRestrictedToAllowedCpus(@TempDir Path tempDir) throws Exception {
+        Files.write(Files.createDirectories(tempDir.resolve("node1")).resolve("cpulist"), "4-7\n".getBytes("US-ASCII"));
+        Files.write(Files.createDirectories(tempDir.resolve("node0")).resolve("cpulist"), "0-3\n".getBytes("US-ASCII"));
+        Files.createDirectories(tempDir.resolve("node2")); // memory-only node: no cpulist
+        Path status = tempDir.resolve("status");
+        Files.write(status, "Name:\tjava\nCpus_allowed_list:\t1-6\n".getBytes("US-ASCII"));
+
+        List<List<Integer>> nodes = CpuTopology.nodes(tempDir.toString(), status.toString());
+        assertEquals(Arrays.asList(Arrays.asList(1, 2, 3), Arrays.asList(4, 5, 6)), nodes);
+
+        List<List<Integer>> fallback = CpuTopology.nodes(
+                tempDir.resolve("none").toString(), tempDir.resolve("none").toString());
+        assertEquals(1, fallback.size());
+        assertEquals(Runtime.getRuntime().availableProcessors(), fallback.get(0).size());
+    }
+
+    @Test
+    void cpuTopology_partitionAlternatesNodesAndSplitsEachNode() {
+        List<List<Integer>> nodes = Arrays.asList(Arrays.asList(0, 1, 2, 3), Arrays.asList(4, 5, 6, 7));
+        assertEquals(Arrays.asList(Arrays.asList(0, 1), Arrays.asList(4, 5), Arrays.asList(2, 3), Arrays.asList(6, 7)),
+                CpuTopology.partition(nodes, 4));
+        // Odd counts: node 0 holds two workers, node 1 one
+        assertEquals(Arrays.asList(Arrays.asList(0, 1), Arrays.asList(4, 5, 6, 7), Arrays.asList(2, 3)),
+                CpuTopology.partition(nodes, 3));
+        // More workers than CPUs: neighbours share one
+        assertEquals(Arrays.asList(Arrays.asList(0), Arrays.asList(0), Arrays.asList(1), Arrays.asList(1)),
+                CpuTopology.partition(Collections.singletonList(Arrays.asList(0, 1)), 4));
+    }
+
+    @Test
+    void memoryAllows_estimatesWorkerFootprintFromGrowth() {
+        long mb = 1024 * 1024;
+        assertTrue(WorkerPool.memoryAllows(null, 10000 * mb, 0, 8));
+        // Two workers grew the group from 100 MB to 700 MB: 300 MB each
+        assertTrue(WorkerPool.memoryAllows(1000 * mb, 700 * mb, 100 * mb, 2));
+        assertFalse(WorkerPool.memoryAllows(900 * mb, 700 * mb, 100 * mb, 2));
+        // Without usage figures each worker counts as the default footprint
+        assertTrue(WorkerPool.memoryAllows(3 * WorkerPool.DEFAULT_WORKER_MEMORY, null, 0, 2));
+        assertFalse(WorkerPool.memoryAllows(3 * WorkerPool.DEFAULT_WORKER_MEMORY - 1, null, 0, 2));
+    }
+
+    @Test
+    void pool_shedsRequestWithoutStartingWorker() {
+        CountingMetricsListener metrics = new CountingMetricsListener();
+        WorkerPool pool = new WorkerPool(new WorkerPoolSettings()
+                .workerPath("/nonexistent/slimlo_worker")
+                .resourcePath("/nonexistent")
+                .timeoutMillis(5000)
+                .metrics(metrics));
+        try {
+            // Expired deadline: shed before reaching the (missing) worker
+            ConversionResult result = pool.executeBuffer(
+                    new HashMap<>(), new byte[] {0x50, 0x4B}, null, System.nanoTime() - 1, null);
+            assertFalse(result.isSuccess());
+            assertEquals(SlimLOErrorCode.DEADLINE_EXCEEDED, result.getErrorCode());
+            assertEquals(1, pool.getShedCount());
+            assertEquals(1, metrics.getQueueWaits());
+            assertEquals(0, metrics.getWorkerStarts());
+        } finally {
+            pool.close();
+        }
+    }
+
+    @Test
+    void pool_serverSocketWithoutServerFailsToInitialize(@TempDir Path tempDir) {
+        // No worker path needed: the pool connects instead of spawning
+        String socket = tempDir.resolve("slimlo.sock").toString();
+        WorkerPool pool = new WorkerPool(new WorkerPoolSettings()
+                .timeoutMillis(5000)
+                .serverSocket(socket));
+        try {
+            SlimLOException e = assertThrows(SlimLOException.class, () -> pool.executeBuffer(
+                    new HashMap<>(), new byte[] {0x50, 0x4B}, null, AdmissionQueue.NO_DEADLINE, null));
+            assertEquals(SlimLOErrorCode.INIT_FAILED, e.getErrorCode());
+        } finally {
+            pool.close();
+        }
+    }
+
+    @Test
+    void options_rejectEmptyServerSocket() {
+        assertNull(PdfConverterOptions.builder().build().getServerSocket());
+        assertThrows(IllegalArgumentException.class,
+                () -> PdfConverterOptions.builder().serverSocket("").build());
+    }
+
+    @Test
+    void singleFlight_runsConcurrentDuplicatesOnce() throws Exception {
+        final SingleFlight flights = new SingleFlight();
+        final CountDownLatch release = new CountDownLatch(1);
+        final AtomicInteger runs = new AtomicInteger();
+        final SingleFlight.Operation<String> convert = new SingleFlight.Operation<String>() {
+            @Override
+            public String run() {
+                runs.incrementAndGet();
+                try {
+                    release.await();
+                } catch (InterruptedException e) {
+                    throw new IllegalStateException(e);
+                }
+                return "pdf";
+            }
+        };
+
+        final List<String> results = Collections.synchronizedList(new ArrayList<String>());
+        List<Thread> callers = new ArrayList<>();
+        for (int i = 0; i < 4; i++) {
+            callers.add(flightThread(flights, "doc", convert, results));
+            // The first caller must be in flight before the others join it
+            while (flights.size() == 0) {
+                Thread.sleep(5);
+            }
+        }
+        while (flights.getCoalescedCount() < 3) {
+            Thread.sleep(5);
+        }
+        release.countDown();
+        for (Thread t : callers) {
+            t.join(5000);
+        }
+
+        assertEquals(1, runs.get());
+        assertEquals(Arrays.asList("pdf", "pdf", "pdf", "pdf"), results);
+        assertEquals(3, flights.getCoalescedCount());
+        assertEquals(0, flights.size());
+    }
+
+    @Test
+    void singleFlight_forgetsCompletedFlights() throws Exception {
+        SingleFlight flights = new SingleFlight();
+        final AtomicInteger runs = new AtomicInteger();
+        SingleFlight.Operation<Integer> convert = new SingleFlight.Operation<Integer>() {
+            @Override
+            public Integer run() {
+                return runs.incrementAndGet();
+            }
+        };
+        assertEquals(1, (int) flights.run("doc", convert));
+        assertEquals(2, (int) flights.run("doc", convert));
+        assertEquals(0, flights.getCoalescedCount());
+    }
+
+    @Test
+    void singleFlight_givesEachCoalescedCallerItsOwnCopy() throws Exception {
+        final SingleFlight flights = new SingleFlight();
+        final CountDownLatch release = new CountDownLatch(1);
+        final byte[] pdf = {1, 2, 3};
+        final SingleFlight.Operation<byte[]> convert = new SingleFlight.Operation<byte[]>() {
+            @Override
+            public byte[] run() {
+                try {
+                    release.await();
+                } catch (InterruptedException e) {
+                    Thread.currentThread().interrupt();
+                }
+                return pdf;
+            }
+        };
+        final List<byte[]> results = Collections.synchronizedList(new ArrayList<byte[]>());
+        List<Thread> callers = new ArrayList<>();
+        for (int i = 0; i < 2; i++) {
+            Thread t = new Thread(new Runnable() {
+                @Override
+                public void run() {
+                    try {
+                        results.add(flights.run("doc", convert, byte[]::clone));
+                    } catch (InterruptedException e) {
+                        Thread.currentThread().interrupt();
+                    }
+                }
+            });
+            t.start();
+            callers.add(t);
+            while (flights.size() == 0) {
+                Thread.sleep(5);
+            }
+        }
+        while (flights.getCoalescedCount() < 1) {
+            Thread.sleep(5);
+        }
+        release.countDown();
+        for (Thread t : callers) {
+            t.join(5000);
+        }
+
+        assertEquals(2, results.size());
+        for (byte[] r : results) {
+            assertArrayEquals(pdf, r);
+            assertNotSame(pdf, r);
+        }
+        assertNotSame(results.get(0), results.get(1));
+        // A caller that ran alone gets the result itself
+        assertSame(pdf, flights.run("solo", new SingleFlight.Operation<byte[]>() {
+            @Override
+            public byte[] run() {
+                return pdf;
+            }
+        }, byte[]::clone));
+    }
+
+    @Test
+    void singleFlight_rethrowsLeaderFailureToFollowers() throws Exception {
+        final SingleFlight flights = new SingleFlight();
+        final CountDownLatch release = new CountDownLatch(1);
+        final SingleFlight.Operation<String> convert = new SingleFlight.Operation<String>() {
+            @Override
+            public String run() {
+                try {
+                    release.await();
+                } catch (InterruptedException e) {
+                    Thread.currentThread().interrupt();
+                }
+                throw new IllegalStateException("worker died");
+            }
+        };
+        final List<String> results = Collections.synchronizedList(new ArrayList<String>());
+        Thread leader = flightThread(flights, "doc", convert, results);
+        while (flights.size() == 0) {
+            Thread.sleep(5);
+        }
+        Thread follower = flightThread(flights, "doc", convert, results);
+        while (flights.getCoalescedCount() < 1) {
+            Thread.sleep(5);
+        }
+        release.countDown();
+        leader.join(5000);
+        follower.join(5000);
+        assertEquals(Arrays.asList("worker died", "worker died"), results);
+    }
+
+    /** Run the operation on a new thread, recording its result or exception message. */
+    private static Thread flightThread(final SingleFlight flights, final String key,
+                                       final SingleFlight.Operation<String> operation,
+                                       final List<String> results) {
+        Thread t = new Thread(new Runnable() {
+            @Override
+            public void run() {
+                try {
+                    results.add(flights.run(key, operation));
+                } catch (InterruptedException e) {
+                    Thread.currentThread().interrupt();
+                } catch (RuntimeException e) {
+                    results.add(e.getMessage());
+                }
+            }
+        });
+        t.setDaemon(true);
+        t.start();
+        return t;
+    }
+
+    @Test
+    void protocol_chunkedBodyRoundTripsInSeveralFrames() throws Exception {
+        byte[] payload = new byte[600 * 1024];
+        new java.util.Random(42).nextBytes(payload);
+        ByteArrayOutputStream wire = new ByteArrayOutputStream();
+        assertEquals(payload.length, Protocol.writeChunked(wire, new ByteArrayInputStream(payload)));
+        Protocol.writeMessage(wire, new byte[] {0x42});
+
+        // Three data frames, then the terminator
+        ByteArrayInputStream frames = new ByteArrayInputStream(wire.toByteArray());
+        List<Integer> sizes = new ArrayList<Integer>();
+        while (true) {
+            byte[] frame = Protocol.readMessage(frames);
+            sizes.add(frame.length);
+            if (frame.length == 0) break;
+        }
+        assertEquals(Arrays.asList(262144, 262144, 90112, 0), sizes);
+
+        ByteArrayInputStream in = new ByteArrayInputStream(wire.toByteArray());
+        ByteArrayOutputStream body = new ByteArrayOutputStream();
+        assertTrue(Protocol.readChunked(in, body));
+        assertArrayEquals(payload, body.toByteArray());
+        // The next frame is left untouched
+        assertArrayEquals(new byte[] {0x42}, Protocol.readMessage(in));
+    }
+
+    @Test
+    void protocol_frameReaderReusesBufferAcrossFrameKinds() throws Exception {
+        ByteArrayOutputStream wire = new ByteArrayOutputStream();
+        Protocol.writeMessage(wire, "{\"type\":\"progress\",\"percent\":50}".getBytes("UTF-8"));
+        StringBuilder big = new StringBuilder("{\"type\":\"result\",\"text\":\"");
+        for (int i = 0; i < 200000; i++) big.append('x');
+        Protocol.writeMessage(wire, big.append("\"}").toString().getBytes("UTF-8"));
+        Protocol.writeMessage(wire, new byte[] {1, 2, 3});
+        Protocol.writeMessage(wire, "{\"type\":\"done\"}".getBytes("UTF-8"));
+
+        Protocol.FrameReader reader = new Protocol.FrameReader(new ByteArrayInputStream(wire.toByteArray()));
+        assertEquals(50, reader.readJson().get("percent").getAsInt());
+        assertEquals(200000, reader.readJson().get("text").getAsString().length());
+        assertArrayEquals(new byte[] {1, 2, 3}, reader.readBytes());
+        assertEquals("done", reader.readJson().get("type").getAsString());
+        assertNull(reader.readJson());
+    }
+
+    @Test
+    void protocol_chunkedBodyWithoutTerminatorReportsEof() throws Exception {
+        ByteArrayOutputStream wire = new ByteArrayOutputStream();
+        Protocol.writeMessage(wire, new byte[] {1, 2, 3});
+
+        ByteArrayOutputStream body = new ByteArrayOutputStream();
+        assertFalse(Protocol.readChunked(new ByteArrayInputStream(wire.toByteArray()), body));
+        assertEquals(3, body.size());
+    }
+
+    @Test
+    void nativeBridge_utf8IsNulTerminated() {
+        assertNull(NativeBridge.utf8(null));
+        byte[] bytes = NativeBridge.utf8("caf\u00e9");
+        assertEquals(6, bytes.length);
+        assertEquals(0, bytes[5]);
+        assertEquals("caf\u00e9", new String(bytes, 0, 5, java.nio.charset.StandardCharsets.UTF_8));
+    }
+
+    @Test
+    void nativeBridge_packsOptionsInNativeOrder() {
+        ConversionOptions options = ConversionOptions.builder()
+                .pdfVersion(PdfVersion.PDF_A2)
+                .jpegQuality(80)
+                .dpi(150)
+                .taggedPdf(true)
+                .preset(PdfPreset.ARCHIVAL)
+                .skipFieldUpdate(true)
+                .pageRange("1-3")
+                .filterProperty("ExportNotes", "true")
+                .filterProperty("IsSkipEmptyPages", "false")
+                .build();
+
+        assertArrayEquals(new int[] {PdfVersion.PDF_A2.getValue(), 80, 150, 1,
+                PdfPreset.ARCHIVAL.getValue(), 0, 1}, NativeBridge.options(options));
+        byte[][] strings = NativeBridge.strings(options);
+        assertArrayEquals(NativeBridge.utf8("1-3"), strings[0]);
+        assertNull(strings[1]);
+        assertArrayEquals(NativeBridge.utf8("ExportNotes=true,IsSkipEmptyPages=false"), strings[2]);
+
+        assertArrayEquals(new int[7], NativeBridge.options(null));
+        assertEquals(3, NativeBridge.strings(null).length);
+    }
+
+    @Test
+    void nativeBridge_filterOptionsSkipsEmptyKeys() {
+        assertNull(NativeBridge.filterOptions(null));
+        assertNull(NativeBridge.filterOptions(Collections.<String, String>emptyMap()));
+        Map<String, String> properties = new java.util.LinkedHashMap<String, String>();
+        properties.put("", "ignored");
+        properties.put("ExportNotes", "true");
+        assertEquals("ExportNotes=true", NativeBridge.filterOptions(properties));
+    }
+
+    @Test
+    void inProcess_missingFontDirectory_failsBeforeLoading() {
+        SlimLOException e = assertThrows(SlimLOException.class, () -> InProcessConverter.create(
+                PdfConverterOptions.builder()
+                        .resourcePath("/nonexistent")
+                        .fontDirectories(Collections.singletonList("/nonexistent/slimlo-fonts"))
+                        .build()));
+        assertEquals(SlimLOErrorCode.FILE_NOT_FOUND, e.getErrorCode());
+    }
+
+    @Test
+    void pendingFonts_returnsNewDirectoriesInOrder() {
+        List<String> registered = Arrays.asList("/fonts/a", "/fonts/b");
+        assertEquals(Arrays.asList("/fonts/c", "/fonts/d"), WorkerProcess.pendingFonts(
+                registered, Arrays.asList("/fonts/a", "/fonts/c", "/fonts/b", "/fonts/d", "/fonts/c")));
+        assertTrue(WorkerProcess.pendingFonts(registered, registered).isEmpty());
+        assertTrue(WorkerProcess.pendingFonts(registered, Collections.<String>emptyList()).isEmpty());
+    }
+
     @Test
     void convert_rejectsUnsupportedFormat() {
         // XLSX is not supported
@@ -109,6 +708,56 @@ class PdfConverterTest {
         }
     }
 
+    @Test
+    @EnabledIfEnvironmentVariable(named = "SLIMLO_RESOURCE_PATH", matches = ".+")
+    void integration_convertStreaming() throws Exception {
+        Path testDocx = findTestDocx();
+        if (testDocx == null) {
+            System.err.println("Skipping: test.docx not found");
+            return;
+        }
+
+        try (PdfConverter converter = PdfConverter.create()) {
+            for (int i = 0; i < 2; i++) {
+                ByteArrayOutputStream output = new ByteArrayOutputStream();
+                try (InputStream input = Files.newInputStream(testDocx)) {
+                    ConversionResult result = converter.convertStreaming(input, output, DocumentFormat.DOCX);
+                    assertTrue(result.isSuccess(), "Streaming conversion failed: " + result.getErrorMessage());
+                }
+                assertEquals("%PDF", new String(output.toByteArray(), 0, 4, "US-ASCII"));
+            }
+        }
+    }
+
+    @Test
+    @EnabledIfEnvironmentVariable(named = "SLIMLO_RESOURCE_PATH", matches = ".+")
+    void integration_metricsListenerSeesConversion() throws Exception {
+        Path testDocx = findTestDocx();
+        if (testDocx == null) {
+            System.err.println("Skipping: test.docx not found");
+            return;
+        }
+
+        CountingMetricsListener metrics = new CountingMetricsListener();
+        PdfConverterOptions options = PdfConverterOptions.builder()
+                .metricsListener(metrics)
+                .build();
+        byte[] docx = Files.readAllBytes(testDocx);
+        try (PdfConverter converter = PdfConverter.create(options)) {
+            ConversionResult result = converter.convert(docx, DocumentFormat.DOCX);
+            assertTrue(result.isSuccess(), "Conversion failed: " + result.getErrorMessage());
+
+            assertEquals(1, metrics.getWorkerStarts());
+            assertEquals(1, metrics.getQueueWaits());
+            assertEquals(1, metrics.getConversions());
+            assertEquals(docx.length, metrics.getBytesIn());
+            assertEquals(result.getData().length, metrics.getBytesOut());
+            assertTrue(metrics.getTotalMillis() > 0);
+            assertTrue(metrics.getLoadMillis() + metrics.getExportMillis() <= metrics.getTotalMillis() + 1);
+            assertEquals(0, metrics.getWorkerCrashes());
+        }
+    }
+
     @Test
     @EnabledIfEnvironmentVariable(named = "SLIMLO_RESOURCE_PATH", matches = ".+")
     void integration_convertWithOptions(@TempDir Path tempDir) throws Exception {
@@ -149,6 +798,206 @@ class PdfConverterTest {
         }
     }
 
+    @Test
+    @EnabledIfEnvironmentVariable(named = "SLIMLO_RESOURCE_PATH", matches = ".+")
+    void integration_documentInfo_matchesConvertedPageCount() throws Exception {
+        Path testDocx = findTestDocx();
+        if (testDocx == null) {
+            System.err.println("Skipping: test.docx not found");
+            return;
+        }
+
+        final int[] pagesLaidOut = new int[1];
+        ConversionOptions options = ConversionOptions.builder()
+                .progressListener(new ProgressListener() {
+                    @Override
+                    public void onProgress(ConversionProgress progress) {
+                        pagesLaidOut[0] = Math.max(pagesLaidOut[0], progress.getPagesLaidOut());
+                    }
+                })
+                .build();
+
+        try (PdfConverter converter = PdfConverter.create()) {
+            DocumentInfoResult info = converter.getDocumentInfo(testDocx.toAbsolutePath().toString());
+            assertTrue(info.isSuccess(), "Document info failed: " + info.getErrorMessage());
+            assertNotNull(info.getInfo());
+            assertEquals(info.getInfo().getPageCount(), info.getInfo().getPages().size());
+            assertTrue(info.getInfo().getPages().get(0).getWidth() > 0);
+
+            ConversionResult result = converter.convert(Files.readAllBytes(testDocx), DocumentFormat.DOCX, options);
+            assertTrue(result.isSuccess(), "Buffer conversion failed: " + result.getErrorMessage());
+            assertEquals(pagesLaidOut[0], info.getInfo().getPageCount());
+        }
+    }
+
+    @Test
+    @EnabledIfEnvironmentVariable(named = "SLIMLO_RESOURCE_PATH", matches = ".+")
+    void integration_combine_twoParts(@TempDir Path tempDir) throws Exception {
+        Path testDocx = findTestDocx();
+        if (testDocx == null) {
+            System.err.println("Skipping: test.docx not found");
+            return;
+        }
+
+        String input = testDocx.toAbsolutePath().toString();
+        Path outputPdf = tempDir.resolve("combined.pdf");
+
+        try (PdfConverter converter = PdfConverter.create()) {
+            DocumentInfoResult info = converter.getDocumentInfo(input);
+            assertTrue(info.isSuccess(), "Document info failed: " + info.getErrorMessage());
+
+            ConversionResult result = converter.combine(
+                    Arrays.asList(new CombinePart(input, "First"), new CombinePart(input, "Second")),
+                    outputPdf.toAbsolutePath().toString(),
+                    ConversionOptions.builder().pageText(TextOptions.builder().build()).build());
+
+            assertTrue(result.isSuccess(), "Combine failed: " + result.getErrorMessage());
+            assertTrue(Files.exists(outputPdf));
+            assertEquals(2 * info.getInfo().getPageCount(), result.getPageText().size());
+        }
+    }
+
+    @Test
+    @EnabledIfEnvironmentVariable(named = "SLIMLO_RESOURCE_PATH", matches = ".+")
+    void integration_combine_missingPart() throws Exception {
+        try (PdfConverter converter = PdfConverter.create()) {
+            ConversionResult result = converter.combine(
+                    Collections.singletonList(new CombinePart("/nonexistent/file.docx")),
+                    "/tmp/output.pdf");
+
+            assertFalse(result.isSuccess());
+            assertEquals(SlimLOErrorCode.FILE_NOT_FOUND, result.getErrorCode());
+            assertTrue(result.getErrorMessage().startsWith("Part 1:"));
+        }
+    }
+
+    @Test
+    @EnabledIfEnvironmentVariable(named = "SLIMLO_RESOURCE_PATH", matches = ".+")
+    void integration_documentInfo_nonExistentFile() throws Exception {
+        try (PdfConverter converter = PdfConverter.create()) {
+            DocumentInfoResult result = converter.getDocumentInfo("/nonexistent/file.docx");
+
+            assertFalse(result.isSuccess());
+            assertNull(result.getInfo());
+            assertEquals(SlimLOErrorCode.FILE_NOT_FOUND, result.getErrorCode());
+        }
+    }
+
+    @Test
+    @EnabledIfEnvironmentVariable(named = "SLIMLO_RESOURCE_PATH", matches = ".+")
+    void integration_renderPages_firstPagePng() throws Exception {
+        Path testDocx = findTestDocx();
+        if (testDocx == null) {
+            System.err.println("Skipping: test.docx not found");
+            return;
+        }
+
+        try (PdfConverter converter = PdfConverter.create()) {
+            ConversionResult result = converter.renderPages(testDocx.toAbsolutePath().toString(), null);
+            assertTrue(result.isSuccess(), "Render failed: " + result.getErrorMessage());
+            assertEquals(1, result.getPageImages().size());
+
+            PageImage image = result.getPageImages().get(0);
+            assertEquals(1, image.getPageNumber());
+            assertEquals(256, image.getWidth());
+            assertEquals((byte) 0x89, image.getData()[0]);
+            assertEquals((byte) 'P', image.getData()[1]);
+        }
+    }
+
+    @Test
+    @EnabledIfEnvironmentVariable(named = "SLIMLO_RESOURCE_PATH", matches = ".+")
+    void integration_convertBuffer_withPageImages() throws Exception {
+        Path testDocx = findTestDocx();
+        if (testDocx == null) {
+            System.err.println("Skipping: test.docx not found");
+            return;
+        }
+
+        ConversionOptions options = ConversionOptions.builder()
+                .pageImages(RenderOptions.builder().format(PageImageFormat.RGBA).width(64).build())
+                .build();
+
+        try (PdfConverter converter = PdfConverter.create()) {
+            ConversionResult result = converter.convert(Files.readAllBytes(testDocx), DocumentFormat.DOCX, options);
+            assertTrue(result.isSuccess(), "Buffer conversion failed: " + result.getErrorMessage());
+            assertEquals('%', (char) result.getData()[0]);
+            assertEquals(1, result.getPageImages().size());
+
+            PageImage image = result.getPageImages().get(0);
+            assertEquals(64 * image.getHeight() * 4, image.getData().length);
+        }
+    }
+
+    @Test
+    @EnabledIfEnvironmentVariable(named = "SLIMLO_RESOURCE_PATH", matches = ".+")
+    void integration_convert_withPageText() throws Exception {
+        Path testDocx = findTestDocx();
+        if (testDocx == null) {
+            System.err.println("Skipping: test.docx not found");
+            return;
+        }
+
+        ConversionOptions options = ConversionOptions.builder()
+                .pageText(TextOptions.builder().includeWords(true).build())
+                .build();
+
+        try (PdfConverter converter = PdfConverter.create()) {
+            ConversionResult result = converter.convert(Files.readAllBytes(testDocx), DocumentFormat.DOCX, options);
+            assertTrue(result.isSuccess(), "Buffer conversion failed: " + result.getErrorMessage());
+
+            DocumentInfoResult info = converter.getDocumentInfo(testDocx.toAbsolutePath().toString());
+            assertTrue(info.isSuccess(), "Document info failed: " + info.getErrorMessage());
+            assertEquals(info.getInfo().getPageCount(), result.getPageText().size());
+
+            int words = 0;
+            for (PageText page : result.getPageText()) {
+                for (WordBox word : page.getWords()) {
+                    assertFalse(word.getText().isEmpty());
+                    assertTrue(word.getX() + word.getWidth() <= page.getSize().getWidth() + 1);
+                    words++;
+                }
+            }
+            assertTrue(words > 0);
+        }
+    }
+
+    @Test
+    @EnabledIfEnvironmentVariable(named = "SLIMLO_RESOURCE_PATH", matches = ".+")
+    void integration_inProcessBufferAndBorrowed() throws Exception {
+        Path testDocx = findTestDocx();
+        File bridge = new File(new File(System.getenv("SLIMLO_RESOURCE_PATH"), "program"),
+                System.mapLibraryName("slimlo_jni"));
+        if (testDocx == null || !bridge.isFile()) {
+            System.err.println("Skipping: test.docx or libslimlo_jni not found");
+            return;
+        }
+
+        byte[] inputBytes = Files.readAllBytes(testDocx);
+
+        try (InProcessConverter converter = InProcessConverter.create(PdfConverterOptions.builder()
+                .resourcePath(System.getenv("SLIMLO_RESOURCE_PATH"))
+                .build())) {
+            ConversionResult result = converter.convert(inputBytes, DocumentFormat.DOCX);
+            assertTrue(result.isSuccess(), "In-process conversion failed: " + result.getErrorMessage());
+            assertEquals('%', (char) result.getData()[0]);
+
+            ByteBuffer direct = ByteBuffer.allocateDirect(inputBytes.length);
+            direct.put(inputBytes).flip();
+            ConversionResult fromDirect = converter.convert(direct, DocumentFormat.DOCX, null);
+            assertTrue(fromDirect.isSuccess(), "Direct buffer conversion failed: " + fromDirect.getErrorMessage());
+
+            Integer borrowed = converter.convert(inputBytes, DocumentFormat.DOCX, null,
+                    pdf -> pdf.isDirect() && pdf.get(0) == '%' ? pdf.remaining() : -1);
+            assertTrue(borrowed > 0, "Reader should see a direct buffer holding the PDF");
+
+            ConversionResult invalid = converter.convert(new byte[] {1, 2, 3}, DocumentFormat.DOCX);
+            assertFalse(invalid.isSuccess());
+            assertThrows(SlimLOException.class, () -> converter.convert(
+                    new byte[] {1, 2, 3}, DocumentFormat.DOCX, null, pdf -> pdf.remaining()));
+        }
+    }
+
     // --- Helpers ---
 
     private static Path findTestDocx() {
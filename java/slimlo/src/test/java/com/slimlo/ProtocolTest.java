@@ -2,6 +2,7 @@ package com.slimlo;
 
 import com.google.gson.JsonObject;
 import com.slimlo.internal.Protocol;
+import com.slimlo.internal.WorkerProcess;
 import org.junit.jupiter.api.Test;
 
 import java.io.ByteArrayInputStream;
@@ -11,6 +12,7 @@ import java.nio.ByteBuffer;
 import java.nio.ByteOrder;
 import java.nio.charset.StandardCharsets;
 import java.util.HashMap;
+import java.util.List;
 import java.util.Map;
 
 import static org.junit.jupiter.api.Assertions.*;
@@ -129,4 +131,93 @@ class ProtocolTest {
         assertNotNull(result);
         assertArrayEquals(payload, result);
     }
+
+    @Test
+    void parseProgress_readsAllFields() throws IOException {
+        JsonObject root = Protocol.deserialize(("{\"type\":\"progress\",\"id\":7,\"phase\":\"export\","
+                + "\"percent\":40,\"pages_laid_out\":10,\"pages_exported\":4,\"bytes_written\":0}")
+                .getBytes(StandardCharsets.UTF_8));
+        ConversionProgress progress = WorkerProcess.parseProgress(root);
+
+        assertEquals(ConversionPhase.EXPORT, progress.getPhase());
+        assertEquals(40, progress.getPercent());
+        assertEquals(10, progress.getPagesLaidOut());
+        assertEquals(4, progress.getPagesExported());
+        assertEquals(0L, progress.getBytesWritten());
+    }
+
+    @Test
+    void parseProgress_unknownPhaseAndMissingFields_defaultToZero() throws IOException {
+        JsonObject root = Protocol.deserialize("{\"type\":\"progress\",\"phase\":\"future\"}"
+                .getBytes(StandardCharsets.UTF_8));
+        ConversionProgress progress = WorkerProcess.parseProgress(root);
+
+        assertEquals(ConversionPhase.UNKNOWN, progress.getPhase());
+        assertEquals(0, progress.getPercent());
+        assertEquals(0, progress.getPagesLaidOut());
+        assertEquals(0L, progress.getBytesWritten());
+    }
+
+    @Test
+    void parseDocumentInfo_readsAllFields() throws IOException {
+        JsonObject root = Protocol.deserialize(("{\"type\":\"info_result\",\"id\":3,\"success\":true,"
+                + "\"page_count\":2,\"pages\":[{\"width\":595.3,\"height\":841.9},{\"width\":841.9,\"height\":595.3}],"
+                + "\"section_count\":1,\"image_count\":4,\"word_count\":250,"
+                + "\"fonts\":[\"Liberation Serif\",\"Corporate Sans\"],\"missing_fonts\":[\"Corporate Sans\"]}")
+                .getBytes(StandardCharsets.UTF_8));
+        DocumentInfo info = WorkerProcess.parseDocumentInfo(root);
+
+        assertEquals(2, info.getPageCount());
+        assertEquals(new PageSize(595.3, 841.9), info.getPages().get(0));
+        assertEquals(new PageSize(841.9, 595.3), info.getPages().get(1));
+        assertEquals(1, info.getSectionCount());
+        assertEquals(4, info.getImageCount());
+        assertEquals(250, info.getWordCount());
+        assertEquals(2, info.getFonts().size());
+        assertEquals("Corporate Sans", info.getMissingFonts().get(0));
+    }
+
+    @Test
+    void parseDocumentInfo_missingFields_defaultToEmpty() throws IOException {
+        JsonObject root = Protocol.deserialize("{\"type\":\"info_result\",\"success\":true}"
+                .getBytes(StandardCharsets.UTF_8));
+        DocumentInfo info = WorkerProcess.parseDocumentInfo(root);
+
+        assertEquals(0, info.getPageCount());
+        assertTrue(info.getPages().isEmpty());
+        assertTrue(info.getFonts().isEmpty());
+        assertTrue(info.getMissingFonts().isEmpty());
+    }
+
+    @Test
+    void parsePageImage_readsMetadata() throws IOException {
+        JsonObject meta = Protocol.deserialize("{\"page\":3,\"width\":256,\"height\":362,\"format\":1,\"size\":4}"
+                .getBytes(StandardCharsets.UTF_8));
+        PageImage image = WorkerProcess.parsePageImage(meta, new byte[] {1, 2, 3, 4});
+
+        assertEquals(3, image.getPageNumber());
+        assertEquals(256, image.getWidth());
+        assertEquals(362, image.getHeight());
+        assertEquals(PageImageFormat.RGBA, image.getFormat());
+        assertEquals(4, image.getData().length);
+    }
+
+    @Test
+    void parsePageText_readsPagesAndWords() throws IOException {
+        JsonObject root = Protocol.deserialize(("{\"success\":true,\"text\":["
+                + "{\"page\":1,\"width\":595.3,\"height\":841.9,\"text\":\"Hello world\\nNext\","
+                + "\"words\":[[72,70.5,30.2,14,\"Hello\"],[105.1,70.5,33,14,\"world\"]]},"
+                + "{\"page\":2,\"width\":595.3,\"height\":841.9,\"text\":\"\"}]}")
+                .getBytes(StandardCharsets.UTF_8));
+        List<PageText> pages = WorkerProcess.parsePageText(root);
+
+        assertEquals(2, pages.size());
+        assertEquals(1, pages.get(0).getPageNumber());
+        assertEquals(new PageSize(595.3, 841.9), pages.get(0).getSize());
+        assertEquals("Hello world\nNext", pages.get(0).getText());
+        assertEquals(2, pages.get(0).getWords().size());
+        assertEquals("world", pages.get(0).getWords().get(1).getText());
+        assertEquals(105.1, pages.get(0).getWords().get(1).getX());
+        assertTrue(pages.get(1).getWords().isEmpty());
+    }
 }
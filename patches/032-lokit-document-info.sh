@@ -0,0 +1,345 @@
+#!/bin/bash
+# 032-lokit-document-info.sh
+#
+# Add a document statistics query to the LibreOfficeKit C API, so SlimLO can
+# report page count, sections, images and fonts without running PDF export.
+#
+# LOKit can already report the page count (getParts) and page rectangles
+# (getPartPageRectangles), but nothing about the document content. The new
+# getDocumentInfo() call finishes layout, walks the Writer model via UNO and
+# returns a malloc'd string of tab-separated lines:
+#
+#   pages<TAB>N
+#   sections<TAB>N
+#   images<TAB>N
+#   words<TAB>N
+#   font<TAB>1|0<TAB>Family name      (1 = installed, 0 = will be substituted)
+#
+# Patches three files:
+#   1. include/LibreOfficeKit/LibreOfficeKit.h  — extend document vtable
+#   2. include/LibreOfficeKit/LibreOfficeKit.hxx — C++ wrapper method
+#   3. desktop/source/lib/init.cxx              — implement + wire vtable
+#
+# Must run after 017 (inserts after saveToBuffer).
+# Idempotent: safe to re-run.
+
+set -euo pipefail
+
+LO_SRC="${1:?Missing LO source dir}"
+
+LOK_H="$LO_SRC/include/LibreOfficeKit/LibreOfficeKit.h"
+LOK_HXX="$LO_SRC/include/LibreOfficeKit/LibreOfficeKit.hxx"
+INIT_CXX="$LO_SRC/desktop/source/lib/init.cxx"
+
+for f in "$LOK_H" "$LOK_HXX" "$INIT_CXX"; do
+    if [ ! -f "$f" ]; then
+        echo "    ERROR: $f not found"
+        exit 1
+    fi
+done
+
+if ! grep -q 'saveToBuffer' "$LOK_H"; then
+    echo "    032: ERROR: saveToBuffer not found — run 017-lokit-buffer-api.sh first"
+    exit 1
+fi
+
+# ==========================================================================
+# Part 1: LibreOfficeKit.h — add getDocumentInfo after saveToBuffer
+# ==========================================================================
+if ! grep -q 'getDocumentInfo' "$LOK_H"; then
+    echo "    032: Adding getDocumentInfo to _LibreOfficeKitDocumentClass..."
+    awk '
+    /int \(\*saveToBuffer\)/ && !added_doc {
+        print
+        while ($0 !~ /;[[:space:]]*$/) {
+            getline
+            print
+        }
+        print ""
+        print "    /// @see lok::Document::getDocumentInfo"
+        print "    /// SlimLO: page/section/image/font statistics without export"
+        print "    char* (*getDocumentInfo)(LibreOfficeKitDocument* pThis);"
+        added_doc = 1
+        next
+    }
+    { print }
+    ' "$LOK_H" > "$LOK_H.tmp" && mv "$LOK_H.tmp" "$LOK_H"
+else
+    echo "    032: getDocumentInfo already in LibreOfficeKit.h"
+fi
+
+# ==========================================================================
+# Part 2: LibreOfficeKit.hxx — add C++ wrapper after saveToBuffer()
+# ==========================================================================
+if ! grep -q 'getDocumentInfo' "$LOK_HXX"; then
+    echo "    032: Adding getDocumentInfo to lok::Document..."
+    awk '
+    /inline bool saveToBuffer\(/ && !added_doc {
+        print
+        while ($0 !~ /^[[:space:]]*\}/) {
+            getline
+            print
+        }
+        print ""
+        print "    /// Document statistics as tab-separated lines (SlimLO)."
+        print "    /// Caller frees the result with free()."
+        print "    inline char* getDocumentInfo()"
+        print "    {"
+        print "        return mpDoc->pClass->getDocumentInfo(mpDoc);"
+        print "    }"
+        added_doc = 1
+        next
+    }
+    { print }
+    ' "$LOK_HXX" > "$LOK_HXX.tmp" && mv "$LOK_HXX.tmp" "$LOK_HXX"
+else
+    echo "    032: getDocumentInfo already in LibreOfficeKit.hxx"
+fi
+
+# ==========================================================================
+# Part 3: init.cxx — includes, forward decl, implementation, vtable wiring
+# ==========================================================================
+
+# 3a. UNO headers used by the implementation (init.cxx already has most)
+for inc in \
+    com/sun/star/drawing/XDrawPageSupplier.hpp \
+    com/sun/star/lang/XServiceInfo.hpp \
+    com/sun/star/style/XAutoStylesSupplier.hpp \
+    com/sun/star/style/XAutoStyleFamily.hpp \
+    com/sun/star/style/XStyle.hpp \
+    com/sun/star/style/XStyleFamiliesSupplier.hpp \
+    com/sun/star/beans/XMultiPropertySet.hpp \
+    com/sun/star/beans/XMultiPropertyStates.hpp \
+    com/sun/star/container/XEnumerationAccess.hpp \
+    com/sun/star/text/XPageCursor.hpp \
+    com/sun/star/text/XTextSectionsSupplier.hpp \
+    com/sun/star/text/XTextViewCursorSupplier.hpp \
+    vcl/outdev.hxx \
+    set; do
+    if ! grep -q "#include <$inc>" "$INIT_CXX"; then
+        awk -v inc="$inc" '
+        /^#include <com\/sun\/star\// && !added { print "#include <" inc ">"; added = 1 }
+        { print }
+        ' "$INIT_CXX" > "$INIT_CXX.tmp" && mv "$INIT_CXX.tmp" "$INIT_CXX"
+    fi
+done
+
+# 3b. Forward declaration next to doc_saveToBuffer's
+if ! grep -q '^static char\* doc_getDocumentInfo(LibreOfficeKitDocument\* pThis);' "$INIT_CXX"; then
+    echo "    032: Adding forward declaration for doc_getDocumentInfo..."
+    awk '
+    /^static int doc_saveToBuffer\(/ && /;.*$/ && !added_fwd {
+        print
+        print "static char* doc_getDocumentInfo(LibreOfficeKitDocument* pThis); // SlimLO"
+        added_fwd = 1
+        next
+    }
+    { print }
+    ' "$INIT_CXX" > "$INIT_CXX.tmp" && mv "$INIT_CXX.tmp" "$INIT_CXX"
+fi
+
+# 3c. Implementation, inserted before doc_saveAs like doc_saveToBuffer
+if ! grep -q '// SlimLO: Document statistics without export' "$INIT_CXX"; then
+    echo "    032: Adding doc_getDocumentInfo implementation..."
+
+    SAVEAS_DEF_LINE=$(grep -n 'doc_saveAs(' "$INIT_CXX" | grep -v 'doc_saveToBuffer\|;' | head -1 | cut -d: -f1)
+    if [ -z "$SAVEAS_DEF_LINE" ]; then
+        echo "    032: ERROR: Could not find doc_saveAs definition in init.cxx"
+        exit 1
+    fi
+
+    cat > "$INIT_CXX.impl_docinfo" << 'IMPL_EOF'
+// SlimLO: Document statistics without export
+namespace {
+
+// Font name properties may hold a ';'-separated fallback list; the first
+// entry is the family the document asks for.
+void slimloAddFont(std::set<OUString>& rFonts, const uno::Any& rValue)
+{
+    OUString aName;
+    if (!(rValue >>= aName))
+        return;
+    sal_Int32 nSep = aName.indexOf(';');
+    if (nSep >= 0)
+        aName = aName.copy(0, nSep);
+    aName = aName.trim();
+    if (!aName.isEmpty())
+        rFonts.insert(aName);
+}
+
+// Western font families referenced by in-use styles and by automatic
+// (direct) formatting. Asian/complex fonts are left out: every document
+// carries defaults for them whether or not any such text exists.
+void slimloCollectFonts(const uno::Reference<lang::XComponent>& xComponent,
+                        std::set<OUString>& rFonts)
+{
+    uno::Reference<style::XStyleFamiliesSupplier> xFamilies(xComponent, uno::UNO_QUERY);
+    if (xFamilies.is())
+    {
+        for (const OUString& rFamily : { u"ParagraphStyles"_ustr, u"CharacterStyles"_ustr })
+        {
+            uno::Reference<container::XNameAccess> xStyles;
+            if (!(xFamilies->getStyleFamilies()->getByName(rFamily) >>= xStyles))
+                continue;
+            for (const OUString& rName : xStyles->getElementNames())
+            {
+                uno::Reference<style::XStyle> xStyle(xStyles->getByName(rName), uno::UNO_QUERY);
+                uno::Reference<beans::XPropertySet> xProps(xStyle, uno::UNO_QUERY);
+                if (xStyle.is() && xProps.is() && xStyle->isInUse())
+                    slimloAddFont(rFonts, xProps->getPropertyValue(u"CharFontName"_ustr));
+            }
+        }
+    }
+
+    uno::Reference<style::XAutoStylesSupplier> xAutoSupplier(xComponent, uno::UNO_QUERY);
+    if (!xAutoSupplier.is())
+        return;
+    uno::Reference<style::XAutoStyles> xAutoStyles = xAutoSupplier->getAutoStyles();
+    const uno::Sequence<OUString> aFontProp{ u"CharFontName"_ustr };
+    for (const OUString& rFamily : { u"ParagraphStyles"_ustr, u"CharacterStyles"_ustr })
+    {
+        uno::Reference<container::XEnumerationAccess> xFamily;
+        if (!xAutoStyles->hasByName(rFamily) || !(xAutoStyles->getByName(rFamily) >>= xFamily))
+            continue;
+        uno::Reference<container::XEnumeration> xEnum = xFamily->createEnumeration();
+        while (xEnum->hasMoreElements())
+        {
+            uno::Reference<beans::XMultiPropertyStates> xStates(xEnum->nextElement(), uno::UNO_QUERY);
+            uno::Reference<beans::XMultiPropertySet> xValues(xStates, uno::UNO_QUERY);
+            if (!xStates.is() || !xValues.is())
+                continue;
+            if (xStates->getPropertyStates(aFontProp)[0] != beans::PropertyState_DIRECT_VALUE)
+                continue;
+            slimloAddFont(rFonts, xValues->getPropertyValues(aFontProp)[0]);
+        }
+    }
+}
+
+} // namespace
+
+static char* doc_getDocumentInfo(LibreOfficeKitDocument* pThis)
+{
+    comphelper::ProfileZone aZone("doc_getDocumentInfo");
+    SolarMutexGuard aGuard;
+    SetLastExceptionMsg();
+
+    LibLODocument_Impl* pDocument = static_cast<LibLODocument_Impl*>(pThis);
+    if (doc_getDocumentType(pThis) != LOK_DOCTYPE_TEXT)
+    {
+        SetLastExceptionMsg(u"getDocumentInfo supports text documents only"_ustr);
+        return nullptr;
+    }
+
+    try
+    {
+        // Jumping the view cursor to the last page formats every page, so the
+        // page count (and getPartPageRectangles afterwards) is final.
+        sal_Int32 nPages = 0;
+        uno::Reference<frame::XModel> xModel(pDocument->mxComponent, uno::UNO_QUERY_THROW);
+        uno::Reference<text::XTextViewCursorSupplier> xCursorSupplier(
+            xModel->getCurrentController(), uno::UNO_QUERY);
+        if (xCursorSupplier.is())
+        {
+            uno::Reference<text::XPageCursor> xPageCursor(
+                xCursorSupplier->getViewCursor(), uno::UNO_QUERY);
+            if (xPageCursor.is())
+            {
+                xPageCursor->jumpToLastPage();
+                nPages = xPageCursor->getPage();
+                xPageCursor->jumpToFirstPage();
+            }
+        }
+
+        sal_Int32 nSections = 0;
+        uno::Reference<text::XTextSectionsSupplier> xSections(xModel, uno::UNO_QUERY);
+        if (xSections.is())
+            nSections = xSections->getTextSections()->getElementNames().getLength();
+
+        // Writer graphics and drawing-layer pictures both live on the draw page
+        sal_Int32 nImages = 0;
+        uno::Reference<drawing::XDrawPageSupplier> xDrawPageSupplier(xModel, uno::UNO_QUERY);
+        if (xDrawPageSupplier.is())
+        {
+            uno::Reference<container::XIndexAccess> xShapes(
+                xDrawPageSupplier->getDrawPage(), uno::UNO_QUERY);
+            for (sal_Int32 i = 0; xShapes.is() && i < xShapes->getCount(); ++i)
+            {
+                uno::Reference<lang::XServiceInfo> xInfo(xShapes->getByIndex(i), uno::UNO_QUERY);
+                if (xInfo.is()
+                    && (xInfo->supportsService(u"com.sun.star.text.TextGraphicObject"_ustr)
+                        || xInfo->supportsService(u"com.sun.star.drawing.GraphicObjectShape"_ustr)))
+                    ++nImages;
+            }
+        }
+
+        sal_Int32 nWords = 0;
+        uno::Reference<beans::XPropertySet> xDocProps(xModel, uno::UNO_QUERY);
+        if (xDocProps.is())
+            xDocProps->getPropertyValue(u"WordCount"_ustr) >>= nWords;
+
+        std::set<OUString> aFonts;
+        slimloCollectFonts(pDocument->mxComponent, aFonts);
+
+        OStringBuffer aOut;
+        aOut.append("pages\t" + OString::number(nPages) + "\n"
+                    "sections\t" + OString::number(nSections) + "\n"
+                    "images\t" + OString::number(nImages) + "\n"
+                    "words\t" + OString::number(nWords) + "\n");
+
+        OutputDevice* pDevice = Application::GetDefaultDevice();
+        for (const OUString& rFont : aFonts)
+        {
+            bool bAvailable = pDevice && pDevice->IsFontAvailable(rFont);
+            aOut.append(OString::Concat("font\t") + (bAvailable ? "1" : "0") + "\t"
+                        + OUStringToOString(rFont, RTL_TEXTENCODING_UTF8) + "\n");
+        }
+
+        return convertOString(aOut.makeStringAndClear());
+    }
+    catch (const uno::Exception& exception)
+    {
+        SetLastExceptionMsg("exception: " + exception.Message);
+    }
+    return nullptr;
+}
+
+IMPL_EOF
+
+    head -n $((SAVEAS_DEF_LINE - 1)) "$INIT_CXX" > "$INIT_CXX.tmp"
+    cat "$INIT_CXX.impl_docinfo" >> "$INIT_CXX.tmp"
+    tail -n +$SAVEAS_DEF_LINE "$INIT_CXX" >> "$INIT_CXX.tmp"
+    mv "$INIT_CXX.tmp" "$INIT_CXX"
+    rm -f "$INIT_CXX.impl_docinfo"
+else
+    echo "    032: doc_getDocumentInfo already in init.cxx"
+fi
+
+# 3d. Wire into the document vtable
+if ! grep -q 'getDocumentInfo.*=.*doc_getDocumentInfo' "$INIT_CXX"; then
+    echo "    032: Wiring getDocumentInfo in document vtable..."
+    awk '
+    /saveToBuffer.*=.*doc_saveToBuffer/ && !wired_doc {
+        print
+        print "        m_pDocumentClass->getDocumentInfo = doc_getDocumentInfo; // SlimLO"
+        wired_doc = 1
+        next
+    }
+    { print }
+    ' "$INIT_CXX" > "$INIT_CXX.tmp" && mv "$INIT_CXX.tmp" "$INIT_CXX"
+fi
+
+# ==========================================================================
+# Verification
+# ==========================================================================
+
+FAIL=0
+grep -q 'getDocumentInfo' "$LOK_H" || { echo "    032: ERROR: getDocumentInfo not in LibreOfficeKit.h"; FAIL=1; }
+grep -q 'getDocumentInfo' "$LOK_HXX" || { echo "    032: ERROR: getDocumentInfo not in LibreOfficeKit.hxx"; FAIL=1; }
+grep -q '// SlimLO: Document statistics without export' "$INIT_CXX" || { echo "    032: ERROR: doc_getDocumentInfo not in init.cxx"; FAIL=1; }
+grep -q 'getDocumentInfo.*=.*doc_getDocumentInfo' "$INIT_CXX" || { echo "    032: ERROR: getDocumentInfo not wired in document vtable"; FAIL=1; }
+
+if [ "$FAIL" -eq 1 ]; then
+    exit 1
+fi
+
+echo "    032: LOKit document info API applied"
@@ -0,0 +1,477 @@
+#!/bin/bash
+# 033-lokit-page-text.sh
+#
+# Add a page text query to the LibreOfficeKit C API, so SlimLO can hand out
+# plain text and word bounding boxes from the document it already loaded for
+# PDF export, instead of callers re-parsing the PDF.
+#
+# getPageText() takes a document area in twips (a page rectangle from
+# getPartPageRectangles), paints it into a GDIMetaFile rather than pixels and
+# reads the recorded text actions: each carries the string, the font and the
+# per-character advances the layout produced. It returns a malloc'd string of
+# tab-separated lines, coordinates in twips relative to the area's top-left:
+#
+#   text<TAB>Page text            (lines separated by an escaped newline)
+#   word<TAB>x<TAB>y<TAB>w<TAB>h<TAB>Word     (only when bWords is set)
+#
+# Backslash, tab and newline inside text are escaped as \\, \t and \n.
+#
+# Patches three files:
+#   1. include/LibreOfficeKit/LibreOfficeKit.h  — extend document vtable
+#   2. include/LibreOfficeKit/LibreOfficeKit.hxx — C++ wrapper method
+#   3. desktop/source/lib/init.cxx              — implement + wire vtable
+#
+# Must run after 032 (inserts after getDocumentInfo).
+# Idempotent: safe to re-run.
+
+set -euo pipefail
+
+LO_SRC="${1:?Missing LO source dir}"
+
+LOK_H="$LO_SRC/include/LibreOfficeKit/LibreOfficeKit.h"
+LOK_HXX="$LO_SRC/include/LibreOfficeKit/LibreOfficeKit.hxx"
+INIT_CXX="$LO_SRC/desktop/source/lib/init.cxx"
+
+for f in "$LOK_H" "$LOK_HXX" "$INIT_CXX"; do
+    if [ ! -f "$f" ]; then
+        echo "    ERROR: $f not found"
+        exit 1
+    fi
+done
+
+if ! grep -q 'getDocumentInfo' "$LOK_H"; then
+    echo "    033: ERROR: getDocumentInfo not found — run 032-lokit-document-info.sh first"
+    exit 1
+fi
+
+# ==========================================================================
+# Part 1: LibreOfficeKit.h — add getPageText after getDocumentInfo
+# ==========================================================================
+if ! grep -q 'getPageText' "$LOK_H"; then
+    echo "    033: Adding getPageText to _LibreOfficeKitDocumentClass..."
+    awk '
+    /char\* \(\*getDocumentInfo\)/ && !added_doc {
+        print
+        print ""
+        print "    /// @see lok::Document::getPageText"
+        print "    /// SlimLO: text and word boxes of a document area, from the layout"
+        print "    char* (*getPageText)(LibreOfficeKitDocument* pThis,"
+        print "                         const int nTilePosX,"
+        print "                         const int nTilePosY,"
+        print "                         const int nTileWidth,"
+        print "                         const int nTileHeight,"
+        print "                         const int bWords);"
+        added_doc = 1
+        next
+    }
+    { print }
+    ' "$LOK_H" > "$LOK_H.tmp" && mv "$LOK_H.tmp" "$LOK_H"
+else
+    echo "    033: getPageText already in LibreOfficeKit.h"
+fi
+
+# ==========================================================================
+# Part 2: LibreOfficeKit.hxx — add C++ wrapper after getDocumentInfo()
+# ==========================================================================
+if ! grep -q 'getPageText' "$LOK_HXX"; then
+    echo "    033: Adding getPageText to lok::Document..."
+    awk '
+    /inline char\* getDocumentInfo\(/ && !added_doc {
+        print
+        while ($0 !~ /^[[:space:]]*\}/) {
+            getline
+            print
+        }
+        print ""
+        print "    /// Text (and optionally word boxes) of a document area in twips,"
+        print "    /// as tab-separated lines (SlimLO). Caller frees the result with free()."
+        print "    inline char* getPageText(const int nTilePosX, const int nTilePosY,"
+        print "                             const int nTileWidth, const int nTileHeight,"
+        print "                             bool bWords)"
+        print "    {"
+        print "        return mpDoc->pClass->getPageText(mpDoc, nTilePosX, nTilePosY,"
+        print "                                          nTileWidth, nTileHeight, bWords ? 1 : 0);"
+        print "    }"
+        added_doc = 1
+        next
+    }
+    { print }
+    ' "$LOK_HXX" > "$LOK_HXX.tmp" && mv "$LOK_HXX.tmp" "$LOK_HXX"
+else
+    echo "    033: getPageText already in LibreOfficeKit.hxx"
+fi
+
+# ==========================================================================
+# Part 3: init.cxx — includes, forward decl, implementation, vtable wiring
+# ==========================================================================
+
+# 3a. VCL headers used by the implementation
+for inc in \
+    vcl/gdimtf.hxx \
+    vcl/kernarray.hxx \
+    vcl/metaact.hxx \
+    vcl/metric.hxx \
+    vcl/virdev.hxx; do
+    if ! grep -q "#include <$inc>" "$INIT_CXX"; then
+        awk -v inc="$inc" '
+        /^#include <com\/sun\/star\// && !added { print "#include <" inc ">"; added = 1 }
+        { print }
+        ' "$INIT_CXX" > "$INIT_CXX.tmp" && mv "$INIT_CXX.tmp" "$INIT_CXX"
+    fi
+done
+
+# 3b. Forward declaration next to doc_getDocumentInfo's
+if ! grep -q '^static char\* doc_getPageText(' "$INIT_CXX"; then
+    echo "    033: Adding forward declaration for doc_getPageText..."
+    awk '
+    /^static char\* doc_getDocumentInfo\(/ && /;.*$/ && !added_fwd {
+        print
+        print "static char* doc_getPageText(LibreOfficeKitDocument* pThis, const int nTilePosX, const int nTilePosY,"
+        print "                             const int nTileWidth, const int nTileHeight, const int bWords); // SlimLO"
+        added_fwd = 1
+        next
+    }
+    { print }
+    ' "$INIT_CXX" > "$INIT_CXX.tmp" && mv "$INIT_CXX.tmp" "$INIT_CXX"
+fi
+
+# 3c. Implementation, inserted before doc_saveAs like doc_getDocumentInfo
+if ! grep -q '// SlimLO: Page text and word boxes' "$INIT_CXX"; then
+    echo "    033: Adding doc_getPageText implementation..."
+
+    SAVEAS_DEF_LINE=$(grep -n 'doc_saveAs(' "$INIT_CXX" | grep -v 'doc_saveToBuffer\|;' | head -1 | cut -d: -f1)
+    if [ -z "$SAVEAS_DEF_LINE" ]; then
+        echo "    033: ERROR: Could not find doc_saveAs definition in init.cxx"
+        exit 1
+    fi
+
+    cat > "$INIT_CXX.impl_pagetext" << 'IMPL_EOF'
+// SlimLO: Page text and word boxes
+namespace {
+
+bool slimloIsSpace(sal_Unicode c)
+{
+    return c == ' ' || c == '\t' || c == 0x00A0 || c == 0x3000 || (c >= 0x2000 && c <= 0x200B)
+           || c == 0x202F;
+}
+
+void slimloAppendEscaped(OStringBuffer& rOut, std::u16string_view aText)
+{
+    OString aUtf8 = OUStringToOString(aText, RTL_TEXTENCODING_UTF8);
+    for (sal_Int32 i = 0; i < aUtf8.getLength(); ++i)
+    {
+        char c = aUtf8[i];
+        switch (c)
+        {
+            case '\\': rOut.append("\\\\"); break;
+            case '\t': rOut.append("\\t"); break;
+            case '\n': rOut.append("\\n"); break;
+            default: rOut.append(c); break;
+        }
+    }
+}
+
+// Rebuilds reading text and word boxes from text runs in paint order. Runs
+// on a new baseline start a new line; a horizontal gap between runs on the
+// same line counts as a space, while touching runs (a font change inside a
+// word) continue the current word.
+class SlimLOTextCollector
+{
+public:
+    SlimLOTextCollector(const Point& rOrigin, bool bWords)
+        : maOrigin(rOrigin), mbWords(bWords)
+    {
+    }
+
+    // aBaseline is the run start on the baseline; pAdvance[i] is the x offset
+    // of the end of character i, relative to aBaseline.
+    void addRun(std::u16string_view aText, const double* pAdvance, const Point& aBaseline,
+                tools::Long nAscent, tools::Long nDescent)
+    {
+        if (aText.empty())
+            return;
+
+        tools::Long nTolerance = std::max<tools::Long>(nAscent / 4, 1);
+        if (mbHaveRun)
+        {
+            bool bNewLine = std::abs(aBaseline.Y() - mnBaseline) > nAscent / 2;
+            bool bGap = aBaseline.X() > mnRunEnd + nTolerance;
+            if (bNewLine || bGap)
+            {
+                closeWord();
+                if (bNewLine)
+                    maText.append('\n');
+                else if (!maText.isEmpty() && !slimloIsSpace(maText[maText.getLength() - 1]))
+                    maText.append(' ');
+            }
+        }
+
+        mbHaveRun = true;
+        mnBaseline = aBaseline.Y();
+        for (size_t i = 0; i < aText.size(); ++i)
+        {
+            sal_Unicode c = aText[i];
+            maText.append(c);
+            if (slimloIsSpace(c))
+            {
+                closeWord();
+                continue;
+            }
+            tools::Long nStart = aBaseline.X() + std::lround(i ? pAdvance[i - 1] : 0.0);
+            tools::Long nEnd = aBaseline.X() + std::lround(pAdvance[i]);
+            if (!mbInWord)
+            {
+                mbInWord = true;
+                maWordRect = tools::Rectangle(std::min(nStart, nEnd), aBaseline.Y() - nAscent,
+                                              std::max(nStart, nEnd), aBaseline.Y() + nDescent);
+            }
+            else
+            {
+                maWordRect.SetLeft(std::min({ maWordRect.Left(), nStart, nEnd }));
+                maWordRect.SetRight(std::max({ maWordRect.Right(), nStart, nEnd }));
+                maWordRect.SetTop(std::min(maWordRect.Top(), aBaseline.Y() - nAscent));
+                maWordRect.SetBottom(std::max(maWordRect.Bottom(), aBaseline.Y() + nDescent));
+            }
+            maWord.append(c);
+        }
+        mnRunEnd = aBaseline.X() + std::lround(pAdvance[aText.size() - 1]);
+    }
+
+    OString finish()
+    {
+        closeWord();
+        OStringBuffer aOut("text\t");
+        slimloAppendEscaped(aOut, maText);
+        aOut.append('\n');
+        aOut.append(maWords.makeStringAndClear());
+        return aOut.makeStringAndClear();
+    }
+
+private:
+    void closeWord()
+    {
+        if (!mbInWord)
+            return;
+        mbInWord = false;
+        if (mbWords)
+        {
+            maWords.append("word\t" + OString::number(maWordRect.Left() - maOrigin.X()) + "\t"
+                           + OString::number(maWordRect.Top() - maOrigin.Y()) + "\t"
+                           + OString::number(maWordRect.GetWidth()) + "\t"
+                           + OString::number(maWordRect.GetHeight()) + "\t");
+            slimloAppendEscaped(maWords, maWord);
+            maWords.append('\n');
+        }
+        maWord.setLength(0);
+    }
+
+    Point maOrigin;
+    bool mbWords;
+    OUStringBuffer maText;
+    OStringBuffer maWords;
+    OUStringBuffer maWord;
+    tools::Rectangle maWordRect;
+    bool mbInWord = false;
+    bool mbHaveRun = false;
+    tools::Long mnBaseline = 0;
+    tools::Long mnRunEnd = 0;
+};
+
+} // namespace
+
+static char* doc_getPageText(LibreOfficeKitDocument* pThis, const int nTilePosX, const int nTilePosY,
+                             const int nTileWidth, const int nTileHeight, const int bWords)
+{
+    comphelper::ProfileZone aZone("doc_getPageText");
+    SolarMutexGuard aGuard;
+    SetLastExceptionMsg();
+
+    ITiledRenderable* pDoc = getTiledRenderable(pThis);
+    if (!pDoc)
+    {
+        SetLastExceptionMsg(u"Document doesn't support tiled rendering"_ustr);
+        return nullptr;
+    }
+    if (nTileWidth <= 0 || nTileHeight <= 0)
+    {
+        SetLastExceptionMsg(u"getPageText: empty area"_ustr);
+        return nullptr;
+    }
+
+    // Paint the area at 96 DPI while recording: the metafile keeps the text
+    // actions in document twips, whatever the device resolution.
+    GDIMetaFile aMtf;
+    {
+        ScopedVclPtrInstance<VirtualDevice> pDevice(DeviceFormat::WITHOUT_ALPHA);
+        int nCanvasWidth = std::max(nTileWidth / 15, 1);
+        int nCanvasHeight = std::max(nTileHeight / 15, 1);
+        pDevice->SetOutputSizePixel(Size(nCanvasWidth, nCanvasHeight));
+        aMtf.Record(pDevice.get());
+        comphelper::LibreOfficeKit::setTiledPainting(true);
+        pDoc->paintTile(*pDevice, nCanvasWidth, nCanvasHeight, nTilePosX, nTilePosY, nTileWidth,
+                        nTileHeight);
+        comphelper::LibreOfficeKit::setTiledPainting(false);
+        aMtf.Stop();
+    }
+
+    // Reference device for font metrics and for runs recorded without advances
+    ScopedVclPtrInstance<VirtualDevice> pRef;
+    pRef->SetMapMode(MapMode(MapUnit::MapTwip));
+
+    struct State
+    {
+        vcl::Font aFont;
+        TextAlign eAlign = ALIGN_TOP;
+    };
+    State aState;
+    std::vector<State> aStack;
+    SlimLOTextCollector aCollector(Point(nTilePosX, nTilePosY), bWords != 0);
+    std::vector<double> aAdvance;
+
+    for (MetaAction* pAction = aMtf.FirstAction(); pAction; pAction = aMtf.NextAction())
+    {
+        const OUString* pText = nullptr;
+        sal_Int32 nIndex = 0, nLen = 0;
+        Point aPos;
+        switch (pAction->GetType())
+        {
+            case MetaActionType::FONT:
+                aState.aFont = static_cast<MetaFontAction*>(pAction)->GetFont();
+                aState.eAlign = aState.aFont.GetAlignment();
+                continue;
+            case MetaActionType::TEXTALIGN:
+                aState.eAlign = static_cast<MetaTextAlignAction*>(pAction)->GetTextAlign();
+                continue;
+            case MetaActionType::PUSH:
+                aStack.push_back(aState);
+                continue;
+            case MetaActionType::POP:
+                if (!aStack.empty())
+                {
+                    aState = aStack.back();
+                    aStack.pop_back();
+                }
+                continue;
+            case MetaActionType::TEXT:
+            {
+                auto* pTextAction = static_cast<MetaTextAction*>(pAction);
+                pText = &pTextAction->GetText();
+                nIndex = pTextAction->GetIndex();
+                nLen = pTextAction->GetLen();
+                aPos = pTextAction->GetPoint();
+                break;
+            }
+            case MetaActionType::TEXTARRAY:
+            {
+                auto* pTextAction = static_cast<MetaTextArrayAction*>(pAction);
+                pText = &pTextAction->GetText();
+                nIndex = pTextAction->GetIndex();
+                nLen = pTextAction->GetLen();
+                aPos = pTextAction->GetPoint();
+                break;
+            }
+            case MetaActionType::STRETCHTEXT:
+            {
+                auto* pTextAction = static_cast<MetaStretchTextAction*>(pAction);
+                pText = &pTextAction->GetText();
+                nIndex = pTextAction->GetIndex();
+                nLen = pTextAction->GetLen();
+                aPos = pTextAction->GetPoint();
+                break;
+            }
+            default:
+                continue;
+        }
+
+        if (nIndex < 0 || nIndex >= pText->getLength())
+            continue;
+        nLen = std::min(nLen, pText->getLength() - nIndex);
+        if (nLen <= 0)
+            continue;
+
+        pRef->SetFont(aState.aFont);
+        FontMetric aMetric = pRef->GetFontMetric();
+        tools::Long nAscent = aMetric.GetAscent();
+        tools::Long nDescent = aMetric.GetDescent();
+
+        // Advances as laid out where recorded, measured otherwise
+        aAdvance.assign(nLen, 0.0);
+        bool bHaveAdvance = false;
+        if (pAction->GetType() == MetaActionType::TEXTARRAY)
+        {
+            const auto& rDX = static_cast<MetaTextArrayAction*>(pAction)->GetDXArray();
+            if (rDX.size() >= static_cast<size_t>(nLen))
+            {
+                for (sal_Int32 i = 0; i < nLen; ++i)
+                    aAdvance[i] = rDX[i];
+                bHaveAdvance = true;
+            }
+        }
+        if (!bHaveAdvance)
+        {
+            KernArray aKern;
+            pRef->GetTextArray(*pText, &aKern, nIndex, nLen);
+            for (sal_Int32 i = 0; i < nLen && i < static_cast<sal_Int32>(aKern.size()); ++i)
+                aAdvance[i] = aKern[i];
+            if (pAction->GetType() == MetaActionType::STRETCHTEXT && aAdvance[nLen - 1] > 0)
+            {
+                double fScale = static_cast<MetaStretchTextAction*>(pAction)->GetWidth()
+                                / aAdvance[nLen - 1];
+                for (double& rAdvance : aAdvance)
+                    rAdvance *= fScale;
+            }
+        }
+
+        // Runs are collected on their baseline
+        if (aState.eAlign == ALIGN_TOP)
+            aPos.AdjustY(nAscent);
+        else if (aState.eAlign == ALIGN_BOTTOM)
+            aPos.AdjustY(-nDescent);
+
+        aCollector.addRun(std::u16string_view(*pText).substr(nIndex, nLen), aAdvance.data(), aPos,
+                          nAscent, nDescent);
+    }
+
+    return convertOString(aCollector.finish());
+}
+
+IMPL_EOF
+
+    head -n $((SAVEAS_DEF_LINE - 1)) "$INIT_CXX" > "$INIT_CXX.tmp"
+    cat "$INIT_CXX.impl_pagetext" >> "$INIT_CXX.tmp"
+    tail -n +$SAVEAS_DEF_LINE "$INIT_CXX" >> "$INIT_CXX.tmp"
+    mv "$INIT_CXX.tmp" "$INIT_CXX"
+    rm -f "$INIT_CXX.impl_pagetext"
+else
+    echo "    033: doc_getPageText already in init.cxx"
+fi
+
+# 3d. Wire into the document vtable
+if ! grep -q 'getPageText.*=.*doc_getPageText' "$INIT_CXX"; then
+    echo "    033: Wiring getPageText in document vtable..."
+    awk '
+    /getDocumentInfo.*=.*doc_getDocumentInfo/ && !wired_doc {
+        print
+        print "        m_pDocumentClass->getPageText = doc_getPageText; // SlimLO"
+        wired_doc = 1
+        next
+    }
+    { print }
+    ' "$INIT_CXX" > "$INIT_CXX.tmp" && mv "$INIT_CXX.tmp" "$INIT_CXX"
+fi
+
+# ==========================================================================
+# Verification
+# ==========================================================================
+
+FAIL=0
+grep -q 'getPageText' "$LOK_H" || { echo "    033: ERROR: getPageText not in LibreOfficeKit.h"; FAIL=1; }
+grep -q 'getPageText' "$LOK_HXX" || { echo "    033: ERROR: getPageText not in LibreOfficeKit.hxx"; FAIL=1; }
+grep -q '// SlimLO: Page text and word boxes' "$INIT_CXX" || { echo "    033: ERROR: doc_getPageText not in init.cxx"; FAIL=1; }
+grep -q 'getPageText.*=.*doc_getPageText' "$INIT_CXX" || { echo "    033: ERROR: getPageText not wired in document vtable"; FAIL=1; }
+
+if [ "$FAIL" -eq 1 ]; then
+    exit 1
+fi
+
+echo "    033: LOKit page text API applied"
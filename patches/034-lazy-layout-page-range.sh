@@ -0,0 +1,188 @@
+#!/bin/bash
+# 034-lazy-layout-page-range.sh
+#
+# Let PDF export of a leading page range ("1", "1-3") stop Writer's layout
+# once those pages are final, instead of formatting the whole document first.
+#
+# SlimLO passes the number of leading pages as the PDF filter property
+# SlimLOLayoutPages=N. The PDF exporter forwards it to the renderable's
+# getRendererCount() options, where Writer normally runs CalcLayout() over the
+# entire document and then CalcPagesForPrint(<all pages>). With N > 0 it only
+# calls CalcPagesForPrint(N), which formats page frames up to page N.
+#
+# Pages past N are never laid out, so fields that depend on the full layout
+# (page count, statistics) expand to the count of the pages formatted so far.
+# When such fields are present a "warn:" line is written to stderr, which the
+# SlimLO worker reports as a diagnostic.
+#
+# Patches two files:
+#   1. filter/source/pdf/pdfexport.cxx   — read + forward SlimLOLayoutPages
+#   2. sw/source/uibase/uno/unotxdoc.cxx — bounded layout in getRendererCount
+#
+# Idempotent: safe to re-run.
+
+set -euo pipefail
+
+LO_SRC="${1:?Missing LO source dir}"
+
+PDF_EXPORT="$LO_SRC/filter/source/pdf/pdfexport.cxx"
+UNOTXDOC="$LO_SRC/sw/source/uibase/uno/unotxdoc.cxx"
+
+for f in "$PDF_EXPORT" "$UNOTXDOC"; do
+    if [ ! -f "$f" ]; then
+        echo "    ERROR: $f not found"
+        exit 1
+    fi
+done
+
+# ==========================================================================
+# Part 1: pdfexport.cxx — read SlimLOLayoutPages from FilterData and pass it
+#         through the render options
+# ==========================================================================
+if ! grep -q 'SlimLOLayoutPages' "$PDF_EXPORT"; then
+    echo "    034: Forwarding SlimLOLayoutPages in PDFExport::Export..."
+    awk '
+    /OUString[[:space:]]+aPageRange;/ && !declared {
+        print
+        print "            sal_Int32               nSlimLOLayoutPages = 0; // SlimLO"
+        declared = 1
+        next
+    }
+    /^[[:space:]]*if[[:space:]]*\([[:space:]]*rProp\.Name == "PageRange"/ && declared && !parsed {
+        match($0, /^[[:space:]]*/)
+        indent = substr($0, 1, RLENGTH)
+        print indent "if ( rProp.Name == \"SlimLOLayoutPages\" ) // SlimLO"
+        print indent "{"
+        print indent "    OUString aPages;"
+        print indent "    if ( !( rProp.Value >>= nSlimLOLayoutPages ) && ( rProp.Value >>= aPages ) )"
+        print indent "        nSlimLOLayoutPages = aPages.toInt32();"
+        print indent "}"
+        print indent "else " substr($0, RLENGTH + 1)
+        parsed = 1
+        next
+    }
+    /makePropertyValue\(u"PageRange"_ustr, aPageRange\),/ && parsed && !forwarded {
+        print
+        match($0, /^[[:space:]]*/)
+        print substr($0, 1, RLENGTH) "comphelper::makePropertyValue(u\"SlimLOLayoutPages\"_ustr, nSlimLOLayoutPages), // SlimLO"
+        forwarded = 1
+        next
+    }
+    { print }
+    ' "$PDF_EXPORT" > "$PDF_EXPORT.tmp" && mv "$PDF_EXPORT.tmp" "$PDF_EXPORT"
+else
+    echo "    034: SlimLOLayoutPages already in pdfexport.cxx"
+fi
+
+# ==========================================================================
+# Part 2: unotxdoc.cxx — format only the leading pages in getRendererCount
+# ==========================================================================
+
+# 2a. Headers for the field check
+for inc in cstdio fmtfld.hxx IDocumentFieldsAccess.hxx; do
+    if ! grep -q "#include <$inc>" "$UNOTXDOC"; then
+        awk -v inc="$inc" '
+        /^#include <unotxdoc\.hxx>/ && !added { print; print "#include <" inc ">"; added = 1; next }
+        { print }
+        ' "$UNOTXDOC" > "$UNOTXDOC.tmp" && mv "$UNOTXDOC.tmp" "$UNOTXDOC"
+    fi
+done
+
+# 2b. Helpers, before SwXTextDocument::getRendererCount
+if ! grep -q '// SlimLO: lazy layout helpers' "$UNOTXDOC"; then
+    echo "    034: Adding lazy layout helpers..."
+    cat > "$UNOTXDOC.impl_lazy" << 'IMPL_EOF'
+// SlimLO: lazy layout helpers
+// Leading pages to format before export (0 = whole document).
+static sal_Int32 lcl_SlimLOLayoutPages(const uno::Sequence<beans::PropertyValue>& rOptions)
+{
+    sal_Int32 nPages = 0;
+    for (const beans::PropertyValue& rOption : rOptions)
+    {
+        if (rOption.Name == "SlimLOLayoutPages")
+            rOption.Value >>= nPages;
+    }
+    return nPages > 0 ? nPages : 0;
+}
+
+// Page count and statistics fields expand from the layout, which stops early
+// in lazy mode: say so on stderr so the caller sees it in its diagnostics.
+static void lcl_SlimLOWarnLayoutFields(SwDoc& rDoc, sal_Int32 nPages)
+{
+    SwFieldType* pType = rDoc.getIDocumentFieldsAccess().GetSysFieldType(SwFieldIds::DocStat);
+    if (!pType)
+        return;
+    std::vector<SwFormatField*> aFields;
+    pType->GatherFields(aFields);
+    if (aFields.empty())
+        return;
+    fprintf(stderr,
+            "warn:slimlo.layout:0: lazy layout stopped after %d page(s); %zu page count/"
+            "statistics field(s) reflect the laid-out pages only\n",
+            static_cast<int>(nPages), aFields.size());
+}
+
+IMPL_EOF
+
+    DEF_LINE=$(grep -n '^sal_Int32 SAL_CALL SwXTextDocument::getRendererCount' "$UNOTXDOC" | head -1 | cut -d: -f1)
+    if [ -z "$DEF_LINE" ]; then
+        echo "    034: ERROR: SwXTextDocument::getRendererCount not found"
+        rm -f "$UNOTXDOC.impl_lazy"
+        exit 1
+    fi
+
+    head -n $((DEF_LINE - 1)) "$UNOTXDOC" > "$UNOTXDOC.tmp"
+    cat "$UNOTXDOC.impl_lazy" >> "$UNOTXDOC.tmp"
+    tail -n +$DEF_LINE "$UNOTXDOC" >> "$UNOTXDOC.tmp"
+    mv "$UNOTXDOC.tmp" "$UNOTXDOC"
+    rm -f "$UNOTXDOC.impl_lazy"
+fi
+
+# 2c. Bounded layout: CalcLayout() + CalcPagesForPrint(all) become
+#     CalcPagesForPrint(N) when SlimLOLayoutPages is set
+if ! grep -q 'nSlimLOLayoutPages' "$UNOTXDOC"; then
+    echo "    034: Bounding layout in getRendererCount..."
+    awk '
+    /^sal_Int32 SAL_CALL SwXTextDocument::getRendererCount/ { in_count = 1 }
+    in_count && /^[[:space:]]*pViewShell->CalcLayout\(\);/ && !calc {
+        match($0, /^[[:space:]]*/)
+        indent = substr($0, 1, RLENGTH)
+        print indent "// SlimLO: a leading page range only needs its own pages formatted"
+        print indent "const sal_Int32 nSlimLOLayoutPages = lcl_SlimLOLayoutPages(rxOptions);"
+        print indent "if (nSlimLOLayoutPages > 0)"
+        print indent "    lcl_SlimLOWarnLayoutFields(*pDoc, nSlimLOLayoutPages);"
+        print indent "else"
+        print indent "    pViewShell->CalcLayout();"
+        calc = 1
+        next
+    }
+    in_count && calc && /CalcPagesForPrint\([[:space:]]*pViewShell->GetPageCount\(\)[[:space:]]*\)/ && !pages {
+        match($0, /^[[:space:]]*/)
+        indent = substr($0, 1, RLENGTH)
+        print indent "pViewShell->CalcPagesForPrint(nSlimLOLayoutPages > 0"
+        print indent "    ? o3tl::narrowing<sal_uInt16>(std::min<sal_Int32>(nSlimLOLayoutPages, SAL_MAX_UINT16))"
+        print indent "    : pViewShell->GetPageCount());"
+        pages = 1
+        in_count = 0
+        next
+    }
+    { print }
+    ' "$UNOTXDOC" > "$UNOTXDOC.tmp" && mv "$UNOTXDOC.tmp" "$UNOTXDOC"
+fi
+
+# ==========================================================================
+# Verification
+# ==========================================================================
+
+FAIL=0
+grep -q 'rProp.Name == "SlimLOLayoutPages"' "$PDF_EXPORT" || { echo "    034: ERROR: SlimLOLayoutPages not read in pdfexport.cxx"; FAIL=1; }
+grep -q 'u"SlimLOLayoutPages"_ustr' "$PDF_EXPORT" || { echo "    034: ERROR: SlimLOLayoutPages not forwarded in pdfexport.cxx"; FAIL=1; }
+grep -q '// SlimLO: lazy layout helpers' "$UNOTXDOC" || { echo "    034: ERROR: lazy layout helpers not in unotxdoc.cxx"; FAIL=1; }
+grep -q 'lcl_SlimLOLayoutPages(rxOptions)' "$UNOTXDOC" || { echo "    034: ERROR: CalcLayout not bounded in getRendererCount"; FAIL=1; }
+grep -q 'CalcPagesForPrint(nSlimLOLayoutPages > 0' "$UNOTXDOC" || { echo "    034: ERROR: CalcPagesForPrint not bounded in getRendererCount"; FAIL=1; }
+
+if [ "$FAIL" -eq 1 ]; then
+    exit 1
+fi
+
+echo "    034: Lazy layout for leading page ranges applied"
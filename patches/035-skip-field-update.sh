@@ -0,0 +1,197 @@
+#!/bin/bash
+# 035-skip-field-update.sh
+#
+# Let SlimLO load and export a document without refreshing its links and
+# fields, trusting the results Word cached in the file.
+#
+# Load side: a "SlimLOSkipUpdate" key in the JSON load options (documentLoad
+# and documentLoadFromBuffer) loads with UpdateDocMode=NO_UPDATE, so linked
+# images, OLE/DDE links and linked sections keep their stored content.
+# documentLoadFromBuffer also starts honouring the other JSON load options
+# (e.g. Password) as media descriptor properties; it ignored them before.
+#
+# Export side: Writer's getRendererCount() forces UpdateFields(true) before
+# PDF export, re-expanding every field (cross-references, page references,
+# document statistics) over the whole document. The PDF filter property
+# SlimLOSkipFieldUpdate=true is forwarded through the render options and
+# skips that pass.
+#
+# Patches three files:
+#   1. desktop/source/lib/init.cxx       — load option → UpdateDocMode
+#   2. filter/source/pdf/pdfexport.cxx   — read + forward SlimLOSkipFieldUpdate
+#   3. sw/source/uibase/uno/unotxdoc.cxx — skip UpdateFields in getRendererCount
+#
+# Must run after 017 (documentLoadFromBuffer) and 034 (SlimLOLayoutPages).
+# Idempotent: safe to re-run.
+
+set -euo pipefail
+
+LO_SRC="${1:?Missing LO source dir}"
+
+INIT_CXX="$LO_SRC/desktop/source/lib/init.cxx"
+PDF_EXPORT="$LO_SRC/filter/source/pdf/pdfexport.cxx"
+UNOTXDOC="$LO_SRC/sw/source/uibase/uno/unotxdoc.cxx"
+
+for f in "$INIT_CXX" "$PDF_EXPORT" "$UNOTXDOC"; do
+    if [ ! -f "$f" ]; then
+        echo "    ERROR: $f not found"
+        exit 1
+    fi
+done
+
+if ! grep -q 'nSlimLOLayoutPages = 0; // SlimLO' "$PDF_EXPORT"; then
+    echo "    035: ERROR: SlimLOLayoutPages not found — run 034-lazy-layout-page-range.sh first"
+    exit 1
+fi
+
+# ==========================================================================
+# Part 1: init.cxx — SlimLOSkipUpdate load option
+# ==========================================================================
+
+for inc in com/sun/star/document/UpdateDocMode.hpp comphelper/propertysequence.hxx comphelper/sequence.hxx; do
+    if ! grep -q "#include <$inc>" "$INIT_CXX"; then
+        awk -v inc="$inc" '
+        /^#include <com\/sun\/star\// && !added { print "#include <" inc ">"; added = 1 }
+        { print }
+        ' "$INIT_CXX" > "$INIT_CXX.tmp" && mv "$INIT_CXX.tmp" "$INIT_CXX"
+    fi
+done
+
+# 1a. documentLoadFromBuffer: JSON load options → media descriptor
+if ! grep -q '// SlimLO: JSON load options' "$INIT_CXX"; then
+    echo "    035: Applying JSON load options in lo_documentLoadFromBuffer..."
+    awk '
+    /^static LibreOfficeKitDocument\* lo_documentLoadFromBuffer\(/ && !/;/ { in_buf = 1 }
+    in_buf && /aProps\.push_back\(comphelper::makePropertyValue\(u"FilterName"_ustr, aFilterName\)\);/ && !done {
+        print
+        print ""
+        print "        // SlimLO: JSON load options ({\"Password\":..., \"SlimLOSkipUpdate\":...})"
+        print "        if (pOptions && pOptions[0] == '\''{'\'')"
+        print "        {"
+        print "            for (const beans::PropertyValue& rProp : comphelper::JsonToPropertyValues(pOptions))"
+        print "            {"
+        print "                bool bSkip = false;"
+        print "                if (rProp.Name == \"SlimLOSkipUpdate\")"
+        print "                {"
+        print "                    if ((rProp.Value >>= bSkip) && bSkip)"
+        print "                        aProps.push_back(comphelper::makePropertyValue(u\"UpdateDocMode\"_ustr,"
+        print "                            css::document::UpdateDocMode::NO_UPDATE));"
+        print "                }"
+        print "                else"
+        print "                    aProps.push_back(rProp);"
+        print "            }"
+        print "        }"
+        done = 1
+        in_buf = 0
+        next
+    }
+    { print }
+    ' "$INIT_CXX" > "$INIT_CXX.tmp" && mv "$INIT_CXX.tmp" "$INIT_CXX"
+fi
+
+# 1b. documentLoad (lo_documentLoadWithOptions): same option, added to the
+#     load arguments right before loadComponentFromURL
+if ! grep -q '// SlimLO: SlimLOSkipUpdate load option' "$INIT_CXX"; then
+    echo "    035: Applying SlimLOSkipUpdate in lo_documentLoadWithOptions..."
+    awk '
+    /^static LibreOfficeKitDocument\* lo_documentLoadWithOptions\(/ && !/;/ { in_load = 1 }
+    in_load && /^}/ { in_load = 0 }
+    in_load && /loadComponentFromURL\(/ && !done {
+        match($0, /^[[:space:]]*/)
+        indent = substr($0, 1, RLENGTH)
+        print indent "// SlimLO: SlimLOSkipUpdate load option — keep cached link/field content"
+        print indent "if (pOptions && pOptions[0] == '\''{'\'')"
+        print indent "{"
+        print indent "    for (const beans::PropertyValue& rProp : comphelper::JsonToPropertyValues(pOptions))"
+        print indent "    {"
+        print indent "        bool bSkip = false;"
+        print indent "        if (rProp.Name == \"SlimLOSkipUpdate\" && (rProp.Value >>= bSkip) && bSkip)"
+        print indent "            aFilterOptions = comphelper::concatSequences(aFilterOptions,"
+        print indent "                uno::Sequence<beans::PropertyValue>{ comphelper::makePropertyValue("
+        print indent "                    u\"UpdateDocMode\"_ustr, css::document::UpdateDocMode::NO_UPDATE) });"
+        print indent "    }"
+        print indent "}"
+        print
+        done = 1
+        next
+    }
+    { print }
+    ' "$INIT_CXX" > "$INIT_CXX.tmp" && mv "$INIT_CXX.tmp" "$INIT_CXX"
+fi
+
+# ==========================================================================
+# Part 2: pdfexport.cxx — forward SlimLOSkipFieldUpdate
+# ==========================================================================
+if ! grep -q 'SlimLOSkipFieldUpdate' "$PDF_EXPORT"; then
+    echo "    035: Forwarding SlimLOSkipFieldUpdate in PDFExport::Export..."
+    awk '
+    /nSlimLOLayoutPages = 0; \/\/ SlimLO/ && !declared {
+        print
+        match($0, /^[[:space:]]*/)
+        print substr($0, 1, RLENGTH) "bool                    bSlimLOSkipFieldUpdate = false; // SlimLO"
+        declared = 1
+        next
+    }
+    /if \( rProp\.Name == "SlimLOLayoutPages" \) \/\/ SlimLO/ && declared && !parsed {
+        match($0, /^[[:space:]]*/)
+        indent = substr($0, 1, RLENGTH)
+        print indent "if ( rProp.Name == \"SlimLOSkipFieldUpdate\" ) // SlimLO"
+        print indent "{"
+        print indent "    OUString aSkip;"
+        print indent "    if ( !( rProp.Value >>= bSlimLOSkipFieldUpdate ) && ( rProp.Value >>= aSkip ) )"
+        print indent "        bSlimLOSkipFieldUpdate = aSkip.equalsIgnoreAsciiCase(\"true\");"
+        print indent "}"
+        print indent "else " substr($0, RLENGTH + 1)
+        parsed = 1
+        next
+    }
+    /makePropertyValue\(u"SlimLOLayoutPages"_ustr, nSlimLOLayoutPages\),/ && parsed && !forwarded {
+        print
+        match($0, /^[[:space:]]*/)
+        print substr($0, 1, RLENGTH) "comphelper::makePropertyValue(u\"SlimLOSkipFieldUpdate\"_ustr, bSlimLOSkipFieldUpdate), // SlimLO"
+        forwarded = 1
+        next
+    }
+    { print }
+    ' "$PDF_EXPORT" > "$PDF_EXPORT.tmp" && mv "$PDF_EXPORT.tmp" "$PDF_EXPORT"
+else
+    echo "    035: SlimLOSkipFieldUpdate already in pdfexport.cxx"
+fi
+
+# ==========================================================================
+# Part 3: unotxdoc.cxx — skip the forced field update before export
+# ==========================================================================
+if ! grep -q 'SlimLOSkipFieldUpdate' "$UNOTXDOC"; then
+    echo "    035: Guarding UpdateFields in getRendererCount..."
+    awk '
+    /^sal_Int32 SAL_CALL SwXTextDocument::getRendererCount/ { in_count = 1 }
+    in_count && /^[[:space:]]*pViewShell->SwViewShell::UpdateFields\(true\);/ && !done {
+        match($0, /^[[:space:]]*/)
+        indent = substr($0, 1, RLENGTH)
+        print indent "// SlimLO: SlimLOSkipFieldUpdate keeps the cached field results"
+        print indent "if (!lcl_GetBoolProperty(rxOptions, \"SlimLOSkipFieldUpdate\"))"
+        print indent "    pViewShell->SwViewShell::UpdateFields(true);"
+        done = 1
+        in_count = 0
+        next
+    }
+    { print }
+    ' "$UNOTXDOC" > "$UNOTXDOC.tmp" && mv "$UNOTXDOC.tmp" "$UNOTXDOC"
+fi
+
+# ==========================================================================
+# Verification
+# ==========================================================================
+
+FAIL=0
+grep -q '// SlimLO: JSON load options' "$INIT_CXX" || { echo "    035: ERROR: JSON load options not applied in lo_documentLoadFromBuffer"; FAIL=1; }
+grep -q '// SlimLO: SlimLOSkipUpdate load option' "$INIT_CXX" || { echo "    035: ERROR: SlimLOSkipUpdate not applied in lo_documentLoadWithOptions"; FAIL=1; }
+grep -q 'rProp.Name == "SlimLOSkipFieldUpdate"' "$PDF_EXPORT" || { echo "    035: ERROR: SlimLOSkipFieldUpdate not read in pdfexport.cxx"; FAIL=1; }
+grep -q 'u"SlimLOSkipFieldUpdate"_ustr' "$PDF_EXPORT" || { echo "    035: ERROR: SlimLOSkipFieldUpdate not forwarded in pdfexport.cxx"; FAIL=1; }
+grep -q 'lcl_GetBoolProperty(rxOptions, "SlimLOSkipFieldUpdate")' "$UNOTXDOC" || { echo "    035: ERROR: UpdateFields not guarded in getRendererCount"; FAIL=1; }
+
+if [ "$FAIL" -eq 1 ]; then
+    exit 1
+fi
+
+echo "    035: Skip field update applied"
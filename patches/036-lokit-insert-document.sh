@@ -0,0 +1,477 @@
+#!/bin/bash
+# 036-lokit-insert-document.sh
+#
+# Add an insert-document call to the LibreOfficeKit C API, so SlimLO can build
+# one PDF from several documents in a single load + export, instead of
+# converting each part and merging the PDFs afterwards.
+#
+# insertDocument(pURL, pBookmark, pOptions) appends the document at pURL to a
+# Writer document, on a new page. The part is imported through the Writer
+# filter in insert mode (the path Insert > Text from File takes), so it shares
+# the target's styles, fonts and images. pOptions are JSON load options as
+# for documentLoad (Password, SlimLOSkipUpdate).
+#
+# With pBookmark set, a bookmark "__SlimLOPart<n>:<title>" is placed at the
+# start of the part; a null pURL only places the bookmark at the start of the
+# document (for the first part). PDF export turns these bookmarks into
+# top-level outline entries, with each part's headings nested below its entry.
+#
+# Patches four files:
+#   1. include/LibreOfficeKit/LibreOfficeKit.h       — extend document vtable
+#   2. include/LibreOfficeKit/LibreOfficeKit.hxx      — C++ wrapper method
+#   3. desktop/source/lib/init.cxx                   — implement + wire vtable
+#   4. sw/source/core/text/EnhancedPDFExportHelper.cxx — part outline entries
+#
+# Must run after 033 (inserts after getPageText).
+# Idempotent: safe to re-run.
+
+set -euo pipefail
+
+LO_SRC="${1:?Missing LO source dir}"
+
+LOK_H="$LO_SRC/include/LibreOfficeKit/LibreOfficeKit.h"
+LOK_HXX="$LO_SRC/include/LibreOfficeKit/LibreOfficeKit.hxx"
+INIT_CXX="$LO_SRC/desktop/source/lib/init.cxx"
+PDF_HELPER="$LO_SRC/sw/source/core/text/EnhancedPDFExportHelper.cxx"
+
+for f in "$LOK_H" "$LOK_HXX" "$INIT_CXX" "$PDF_HELPER"; do
+    if [ ! -f "$f" ]; then
+        echo "    ERROR: $f not found"
+        exit 1
+    fi
+done
+
+if ! grep -q 'getPageText' "$LOK_H"; then
+    echo "    036: ERROR: getPageText not found — run 033-lokit-page-text.sh first"
+    exit 1
+fi
+
+# ==========================================================================
+# Part 1: LibreOfficeKit.h — add insertDocument after getPageText
+# ==========================================================================
+if ! grep -q 'insertDocument' "$LOK_H"; then
+    echo "    036: Adding insertDocument to _LibreOfficeKitDocumentClass..."
+    awk '
+    /char\* \(\*getPageText\)/ && !added_doc {
+        print
+        while ($0 !~ /\);/) {
+            getline
+            print
+        }
+        print ""
+        print "    /// @see lok::Document::insertDocument"
+        print "    /// SlimLO: append a document on a new page, optionally bookmarked"
+        print "    int (*insertDocument)(LibreOfficeKitDocument* pThis,"
+        print "                          const char* pURL,"
+        print "                          const char* pBookmark,"
+        print "                          const char* pOptions);"
+        added_doc = 1
+        next
+    }
+    { print }
+    ' "$LOK_H" > "$LOK_H.tmp" && mv "$LOK_H.tmp" "$LOK_H"
+else
+    echo "    036: insertDocument already in LibreOfficeKit.h"
+fi
+
+# ==========================================================================
+# Part 2: LibreOfficeKit.hxx — add C++ wrapper after getPageText()
+# ==========================================================================
+if ! grep -q 'insertDocument' "$LOK_HXX"; then
+    echo "    036: Adding insertDocument to lok::Document..."
+    awk '
+    /inline char\* getPageText\(/ && !added_doc {
+        print
+        while ($0 !~ /^[[:space:]]*\}/) {
+            getline
+            print
+        }
+        print ""
+        print "    /// Append the document at pURL on a new page (SlimLO). pBookmark, if set,"
+        print "    /// names a PDF outline entry for it; a null pURL only bookmarks the"
+        print "    /// start of this document. pOptions: JSON load options."
+        print "    inline bool insertDocument(const char* pURL, const char* pBookmark,"
+        print "                               const char* pOptions = nullptr)"
+        print "    {"
+        print "        return mpDoc->pClass->insertDocument(mpDoc, pURL, pBookmark, pOptions) != 0;"
+        print "    }"
+        added_doc = 1
+        next
+    }
+    { print }
+    ' "$LOK_HXX" > "$LOK_HXX.tmp" && mv "$LOK_HXX.tmp" "$LOK_HXX"
+else
+    echo "    036: insertDocument already in LibreOfficeKit.hxx"
+fi
+
+# ==========================================================================
+# Part 3: init.cxx — includes, forward decl, implementation, vtable wiring
+# ==========================================================================
+
+# 3a. UNO headers used by the implementation
+for inc in \
+    com/sun/star/container/XEnumerationAccess.hpp \
+    com/sun/star/container/XNamed.hpp \
+    com/sun/star/document/XFilter.hpp \
+    com/sun/star/document/XImporter.hpp \
+    com/sun/star/style/BreakType.hpp \
+    com/sun/star/text/ControlCharacter.hpp \
+    com/sun/star/text/XBookmarksSupplier.hpp \
+    com/sun/star/text/XTextDocument.hpp \
+    com/sun/star/text/XTextTable.hpp \
+    unotools/mediadescriptor.hxx; do
+    if ! grep -q "#include <$inc>" "$INIT_CXX"; then
+        awk -v inc="$inc" '
+        /^#include <com\/sun\/star\// && !added { print "#include <" inc ">"; added = 1 }
+        { print }
+        ' "$INIT_CXX" > "$INIT_CXX.tmp" && mv "$INIT_CXX.tmp" "$INIT_CXX"
+    fi
+done
+
+# 3b. Forward declaration next to doc_getPageText's
+if ! grep -q '^static int doc_insertDocument(' "$INIT_CXX"; then
+    echo "    036: Adding forward declaration for doc_insertDocument..."
+    awk '
+    /const int nTileWidth, const int nTileHeight, const int bWords\); \/\/ SlimLO/ && !added_fwd {
+        print
+        print "static int doc_insertDocument(LibreOfficeKitDocument* pThis, const char* pURL,"
+        print "                              const char* pBookmark, const char* pOptions); // SlimLO"
+        added_fwd = 1
+        next
+    }
+    { print }
+    ' "$INIT_CXX" > "$INIT_CXX.tmp" && mv "$INIT_CXX.tmp" "$INIT_CXX"
+fi
+
+# 3c. Implementation, inserted before doc_saveAs like doc_getPageText
+if ! grep -q '// SlimLO: Insert document' "$INIT_CXX"; then
+    echo "    036: Adding doc_insertDocument implementation..."
+
+    SAVEAS_DEF_LINE=$(grep -n 'doc_saveAs(' "$INIT_CXX" | grep -v 'doc_saveToBuffer\|;' | head -1 | cut -d: -f1)
+    if [ -z "$SAVEAS_DEF_LINE" ]; then
+        echo "    036: ERROR: Could not find doc_saveAs definition in init.cxx"
+        exit 1
+    fi
+
+    cat > "$INIT_CXX.impl_insert" << 'IMPL_EOF'
+// SlimLO: Insert document
+namespace {
+
+uno::Reference<text::XTextContent> slimloBodyElement(const uno::Reference<text::XText>& xText,
+                                                     sal_Int32 nIndex)
+{
+    uno::Reference<container::XEnumerationAccess> xAccess(xText, uno::UNO_QUERY_THROW);
+    uno::Reference<container::XEnumeration> xEnum = xAccess->createEnumeration();
+    for (sal_Int32 i = 0; xEnum->hasMoreElements(); ++i)
+    {
+        uno::Reference<text::XTextContent> xElement(xEnum->nextElement(), uno::UNO_QUERY);
+        if (i == nIndex)
+            return xElement;
+    }
+    return {};
+}
+
+sal_Int32 slimloBodyElementCount(const uno::Reference<text::XText>& xText)
+{
+    uno::Reference<container::XEnumerationAccess> xAccess(xText, uno::UNO_QUERY_THROW);
+    uno::Reference<container::XEnumeration> xEnum = xAccess->createEnumeration();
+    sal_Int32 nCount = 0;
+    for (; xEnum->hasMoreElements(); xEnum->nextElement())
+        ++nCount;
+    return nCount;
+}
+
+// Bookmark "__SlimLOPart<n>:<title>" at the start of the body element nIndex
+// (a paragraph, or the first cell of a table)
+void slimloBookmarkPart(const uno::Reference<lang::XComponent>& xComponent,
+                        const uno::Reference<text::XText>& xText, sal_Int32 nIndex,
+                        const OUString& rTitle)
+{
+    uno::Reference<text::XTextContent> xElement = slimloBodyElement(xText, nIndex);
+    uno::Reference<text::XTextRange> xStart;
+    uno::Reference<text::XText> xTarget = xText;
+    if (uno::Reference<text::XTextTable> xTable{ xElement, uno::UNO_QUERY })
+    {
+        xTarget.set(xTable->getCellByName(u"A1"_ustr), uno::UNO_QUERY_THROW);
+        xStart = xTarget->getStart();
+    }
+    else if (uno::Reference<text::XTextRange> xParagraph{ xElement, uno::UNO_QUERY })
+        xStart = xParagraph->getStart();
+    else
+        xStart = xText->getEnd();
+
+    sal_Int32 nPart = 0;
+    uno::Reference<text::XBookmarksSupplier> xBookmarksSupplier(xComponent, uno::UNO_QUERY_THROW);
+    for (const OUString& rName : xBookmarksSupplier->getBookmarks()->getElementNames())
+    {
+        if (rName.startsWith("__SlimLOPart"))
+            ++nPart;
+    }
+
+    uno::Reference<lang::XMultiServiceFactory> xFactory(xComponent, uno::UNO_QUERY_THROW);
+    uno::Reference<text::XTextContent> xBookmark(
+        xFactory->createInstance(u"com.sun.star.text.Bookmark"_ustr), uno::UNO_QUERY_THROW);
+    uno::Reference<container::XNamed>(xBookmark, uno::UNO_QUERY_THROW)
+        ->setName("__SlimLOPart" + OUString::number(nPart + 1) + ":" + rTitle);
+    xTarget->insertTextContent(xStart, xBookmark, false);
+}
+
+} // namespace
+
+static int doc_insertDocument(LibreOfficeKitDocument* pThis, const char* pURL,
+                              const char* pBookmark, const char* pOptions)
+{
+    comphelper::ProfileZone aZone("doc_insertDocument");
+    SolarMutexGuard aGuard;
+    SetLastExceptionMsg();
+
+    LibLODocument_Impl* pDocument = static_cast<LibLODocument_Impl*>(pThis);
+    if (doc_getDocumentType(pThis) != LOK_DOCTYPE_TEXT)
+    {
+        SetLastExceptionMsg(u"insertDocument supports text documents only"_ustr);
+        return 0;
+    }
+
+    try
+    {
+        uno::Reference<text::XTextDocument> xTextDocument(pDocument->mxComponent,
+                                                          uno::UNO_QUERY_THROW);
+        uno::Reference<text::XText> xText = xTextDocument->getText();
+
+        // The part becomes body element nPartStart: the paragraph added below,
+        // or a table the import puts in front of it
+        sal_Int32 nPartStart = 0;
+        if (pURL)
+        {
+            nPartStart = slimloBodyElementCount(xText);
+
+            uno::Reference<text::XTextCursor> xCursor
+                = xText->createTextCursorByRange(xText->getEnd());
+            xText->insertControlCharacter(xCursor, text::ControlCharacter::PARAGRAPH_BREAK, false);
+            uno::Reference<beans::XPropertySet>(xCursor, uno::UNO_QUERY_THROW)
+                ->setPropertyValue(u"BreakType"_ustr, uno::Any(style::BreakType_PAGE_BEFORE));
+
+            utl::MediaDescriptor aDescriptor;
+            if (pOptions && pOptions[0] == '{')
+            {
+                for (const beans::PropertyValue& rProp : comphelper::JsonToPropertyValues(pOptions))
+                {
+                    bool bSkip = false;
+                    if (rProp.Name == "SlimLOSkipUpdate")
+                    {
+                        if ((rProp.Value >>= bSkip) && bSkip)
+                            aDescriptor[u"UpdateDocMode"_ustr]
+                                <<= css::document::UpdateDocMode::NO_UPDATE;
+                    }
+                    else
+                        aDescriptor[rProp.Name] = rProp.Value;
+                }
+            }
+            aDescriptor[utl::MediaDescriptor::PROP_URL] <<= OUString::fromUtf8(pURL);
+            aDescriptor[utl::MediaDescriptor::PROP_FILTERNAME] <<= u"MS Word 2007 XML"_ustr;
+            aDescriptor[u"InsertMode"_ustr] <<= true;
+            aDescriptor[u"TextInsertModeRange"_ustr]
+                <<= uno::Reference<text::XTextRange>(xCursor, uno::UNO_QUERY_THROW);
+            if (!aDescriptor.addInputStream())
+            {
+                SetLastExceptionMsg("insertDocument: cannot open " + OUString::fromUtf8(pURL));
+                return 0;
+            }
+
+            uno::Reference<document::XFilter> xFilter(
+                comphelper::getProcessServiceFactory()->createInstance(
+                    u"com.sun.star.comp.Writer.WriterFilter"_ustr),
+                uno::UNO_QUERY_THROW);
+            uno::Reference<document::XImporter>(xFilter, uno::UNO_QUERY_THROW)
+                ->setTargetDocument(pDocument->mxComponent);
+            if (!xFilter->filter(aDescriptor.getAsConstPropertyValueList()))
+            {
+                SetLastExceptionMsg("insertDocument: failed to import " + OUString::fromUtf8(pURL));
+                return 0;
+            }
+        }
+
+        if (pBookmark)
+            slimloBookmarkPart(pDocument->mxComponent, xText, nPartStart,
+                               OUString::fromUtf8(pBookmark));
+        return 1;
+    }
+    catch (const uno::Exception& exception)
+    {
+        SetLastExceptionMsg("insertDocument: " + exception.Message);
+    }
+    return 0;
+}
+
+IMPL_EOF
+
+    head -n $((SAVEAS_DEF_LINE - 1)) "$INIT_CXX" > "$INIT_CXX.tmp"
+    cat "$INIT_CXX.impl_insert" >> "$INIT_CXX.tmp"
+    tail -n +$SAVEAS_DEF_LINE "$INIT_CXX" >> "$INIT_CXX.tmp"
+    mv "$INIT_CXX.tmp" "$INIT_CXX"
+    rm -f "$INIT_CXX.impl_insert"
+else
+    echo "    036: doc_insertDocument already in init.cxx"
+fi
+
+# 3d. Wire into the document vtable
+if ! grep -q 'insertDocument.*=.*doc_insertDocument' "$INIT_CXX"; then
+    echo "    036: Wiring insertDocument in document vtable..."
+    awk '
+    /getPageText.*=.*doc_getPageText/ && !wired_doc {
+        print
+        print "        m_pDocumentClass->insertDocument = doc_insertDocument; // SlimLO"
+        wired_doc = 1
+        next
+    }
+    { print }
+    ' "$INIT_CXX" > "$INIT_CXX.tmp" && mv "$INIT_CXX.tmp" "$INIT_CXX"
+fi
+
+# ==========================================================================
+# Part 4: EnhancedPDFExportHelper.cxx — one outline entry per part
+# ==========================================================================
+
+# 4a. Mark names are OUString or SwMarkName depending on the LO version
+if ! grep -q '// SlimLO: part bookmark names' "$PDF_HELPER"; then
+    echo "    036: Adding part bookmark helper..."
+    cat > "$PDF_HELPER.impl_parts" << 'IMPL_EOF'
+// SlimLO: part bookmark names
+template <class T> static OUString lcl_SlimLOMarkName(const T& rName)
+{
+    if constexpr (std::is_same_v<T, OUString>)
+        return rName;
+    else
+        return rName.toString();
+}
+
+IMPL_EOF
+
+    DEF_LINE=$(grep -n '^void SwEnhancedPDFExportHelper::EnhancedPDFExport' "$PDF_HELPER" | head -1 | cut -d: -f1)
+    if [ -z "$DEF_LINE" ]; then
+        echo "    036: ERROR: SwEnhancedPDFExportHelper::EnhancedPDFExport not found"
+        rm -f "$PDF_HELPER.impl_parts"
+        exit 1
+    fi
+
+    head -n $((DEF_LINE - 1)) "$PDF_HELPER" > "$PDF_HELPER.tmp"
+    cat "$PDF_HELPER.impl_parts" >> "$PDF_HELPER.tmp"
+    tail -n +$DEF_LINE "$PDF_HELPER" >> "$PDF_HELPER.tmp"
+    mv "$PDF_HELPER.tmp" "$PDF_HELPER"
+    rm -f "$PDF_HELPER.impl_parts"
+
+    if ! grep -q '#include <type_traits>' "$PDF_HELPER"; then
+        awk '
+        /^#include </ && !added { print "#include <type_traits>"; added = 1 }
+        { print }
+        ' "$PDF_HELPER" > "$PDF_HELPER.tmp" && mv "$PDF_HELPER.tmp" "$PDF_HELPER"
+    fi
+fi
+
+# 4b. In the outline loop: emit each part's entry before the first heading
+#     that follows it and nest that part's headings below it; parts after
+#     the last heading are emitted once the loop is done
+if ! grep -q 'aSlimLOParts' "$PDF_HELPER"; then
+    echo "    036: Adding part entries to the PDF outline..."
+    awk '
+    /aOutlineStack\.push\( StackEntry\( -1, -1 \) \);/ && !collected {
+        print
+        match($0, /^[[:space:]]*/)
+        ind = substr($0, 1, RLENGTH)
+        print ""
+        print ind "// SlimLO: parts of a combined document (\"__SlimLOPart<n>:<title>\" bookmarks"
+        print ind "// from LOKit insertDocument) become top-level entries"
+        print ind "IDocumentMarkAccess* const pSlimLOMarks = mrSh.GetDoc()->getIDocumentMarkAccess();"
+        print ind "std::vector<std::decay_t<decltype(*pSlimLOMarks->getBookmarksBegin())>> aSlimLOParts;"
+        print ind "for (auto ppMark = pSlimLOMarks->getBookmarksBegin(); ppMark != pSlimLOMarks->getBookmarksEnd(); ++ppMark)"
+        print ind "{"
+        print ind "    if (lcl_SlimLOMarkName((*ppMark)->GetName()).startsWith(\"__SlimLOPart\"))"
+        print ind "        aSlimLOParts.push_back(*ppMark);"
+        print ind "}"
+        print ind "std::stable_sort(aSlimLOParts.begin(), aSlimLOParts.end(), [](auto pA, auto pB)"
+        print ind "    { return pA->GetMarkStart().GetNodeIndex() < pB->GetMarkStart().GetNodeIndex(); });"
+        print ind "size_t nSlimLOPart = 0;"
+        print ind "auto aSlimLOEmitPart = [&]() -> sal_Int32"
+        print ind "{"
+        print ind "    const auto pMark = aSlimLOParts[nSlimLOPart++];"
+        print ind "    const OUString aName = lcl_SlimLOMarkName(pMark->GetName());"
+        print ind "    sal_Int32 nPartDestId = -1;"
+        print ind "    if (mrSh.GotoMark(pMark, true))"
+        print ind "    {"
+        print ind "        const SwRect& rPartRect = mrSh.GetCharRect();"
+        print ind "        const SwPageFrame* pPartPage ="
+        print ind "            static_cast<const SwPageFrame*>( mrSh.GetLayout()->Lower() );"
+        print ind "        const sal_Int32 nPartPageNum = CalcOutputPageNum( rPartRect );"
+        print ind "        if ( -1 != nPartPageNum )"
+        print ind "        {"
+        print ind "            tools::Rectangle aPartRect(SwRectToPDFRect(pPartPage, rPartRect.SVRect()));"
+        print ind "            nPartDestId = pPDFExtOutDevData->CreateDest(aPartRect, nPartPageNum);"
+        print ind "        }"
+        print ind "    }"
+        print ind "    return pPDFExtOutDevData->CreateOutlineItem("
+        print ind "        -1, aName.copy(aName.indexOf(\x27:\x27) + 1), nPartDestId);"
+        print ind "};"
+        collected = 1
+        next
+    }
+    collected && !in_loop && !loop_done && /for \( SwOutlineNodes::size_type i = 0; i < nOutlineCount; \+\+i \)/ {
+        in_loop = 1
+        depth = 0
+        opened = 0
+    }
+    in_loop && /\/\/ Get parent id from stack:/ && !nested {
+        match($0, /^[[:space:]]*/)
+        ind = substr($0, 1, RLENGTH)
+        print ind "// SlimLO: part entries that start before this heading; the"
+        print ind "// heading and those after it nest below the last one"
+        print ind "while ( nSlimLOPart < aSlimLOParts.size() &&"
+        print ind "        aSlimLOParts[nSlimLOPart]->GetMarkStart().GetNodeIndex() <= pTNd->GetIndex() )"
+        print ind "{"
+        print ind "    const sal_Int32 nPartId = aSlimLOEmitPart();"
+        print ind "    while ( !aOutlineStack.empty() )"
+        print ind "        aOutlineStack.pop();"
+        print ind "    aOutlineStack.push( StackEntry( -1, nPartId ) );"
+        print ind "}"
+        print ""
+        nested = 1
+    }
+    in_loop {
+        line = $0
+        opens = gsub(/\{/, "{", line)
+        closes = gsub(/\}/, "}", line)
+        depth += opens - closes
+        if (opens > 0) opened = 1
+        print
+        if (opened && depth == 0) {
+            match($0, /^[[:space:]]*/)
+            ind = substr($0, 1, RLENGTH)
+            print ind "// SlimLO: parts after the last heading"
+            print ind "while ( nSlimLOPart < aSlimLOParts.size() )"
+            print ind "    aSlimLOEmitPart();"
+            in_loop = 0
+            loop_done = 1
+        }
+        next
+    }
+    { print }
+    ' "$PDF_HELPER" > "$PDF_HELPER.tmp" && mv "$PDF_HELPER.tmp" "$PDF_HELPER"
+fi
+
+# ==========================================================================
+# Verification
+# ==========================================================================
+
+FAIL=0
+grep -q 'insertDocument' "$LOK_H" || { echo "    036: ERROR: insertDocument not in LibreOfficeKit.h"; FAIL=1; }
+grep -q 'insertDocument' "$LOK_HXX" || { echo "    036: ERROR: insertDocument not in LibreOfficeKit.hxx"; FAIL=1; }
+grep -q '// SlimLO: Insert document' "$INIT_CXX" || { echo "    036: ERROR: doc_insertDocument not in init.cxx"; FAIL=1; }
+grep -q 'insertDocument.*=.*doc_insertDocument' "$INIT_CXX" || { echo "    036: ERROR: insertDocument not wired in document vtable"; FAIL=1; }
+grep -q 'std::vector<std::decay_t<decltype(\*pSlimLOMarks' "$PDF_HELPER" || { echo "    036: ERROR: part bookmarks not collected in EnhancedPDFExportHelper.cxx"; FAIL=1; }
+grep -q 'aOutlineStack.push( StackEntry( -1, nPartId ) );' "$PDF_HELPER" || { echo "    036: ERROR: part entries not nested into the outline loop"; FAIL=1; }
+grep -q '// SlimLO: parts after the last heading' "$PDF_HELPER" || { echo "    036: ERROR: trailing part entries not emitted"; FAIL=1; }
+
+if [ "$FAIL" -eq 1 ]; then
+    exit 1
+fi
+
+echo "    036: LOKit insert document + part outline applied"
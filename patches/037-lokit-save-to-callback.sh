@@ -0,0 +1,298 @@
+#!/bin/bash
+# 037-lokit-save-to-callback.sh
+#
+# Add a callback-based save to the LibreOfficeKit C API, so SlimLO can write
+# an exported PDF straight into memory chosen by its caller.
+#
+# saveToBuffer (017) exports into an SvMemoryStream, then mallocs a buffer of
+# the final size and copies the stream into it; callers with their own memory
+# (arenas, pooled response buffers) copy it a second time. saveToCallback
+# hands every block the filter writes to pWrite(pData, pBytes, nSize)
+# instead, with no intermediate stream. pWrite returns nonzero to continue;
+# zero aborts the export and saveToCallback returns 0. Filter selection and
+# filter options are the same as for saveToBuffer.
+#
+# Patches three files:
+#   1. include/LibreOfficeKit/LibreOfficeKit.h  — extend document vtable
+#   2. include/LibreOfficeKit/LibreOfficeKit.hxx — C++ wrapper method
+#   3. desktop/source/lib/init.cxx              — implement + wire vtable
+#
+# Must run after 036 (inserts after insertDocument).
+# Idempotent: safe to re-run.
+
+set -euo pipefail
+
+LO_SRC="${1:?Missing LO source dir}"
+
+LOK_H="$LO_SRC/include/LibreOfficeKit/LibreOfficeKit.h"
+LOK_HXX="$LO_SRC/include/LibreOfficeKit/LibreOfficeKit.hxx"
+INIT_CXX="$LO_SRC/desktop/source/lib/init.cxx"
+
+for f in "$LOK_H" "$LOK_HXX" "$INIT_CXX"; do
+    if [ ! -f "$f" ]; then
+        echo "    ERROR: $f not found"
+        exit 1
+    fi
+done
+
+if ! grep -q 'insertDocument' "$LOK_H"; then
+    echo "    037: ERROR: insertDocument not found — run 036-lokit-insert-document.sh first"
+    exit 1
+fi
+
+# ==========================================================================
+# Part 1: LibreOfficeKit.h — add saveToCallback after insertDocument
+# ==========================================================================
+if ! grep -q 'saveToCallback' "$LOK_H"; then
+    echo "    037: Adding saveToCallback to _LibreOfficeKitDocumentClass..."
+    awk '
+    /int \(\*insertDocument\)/ && !added_doc {
+        print
+        while ($0 !~ /\);/) {
+            getline
+            print
+        }
+        print ""
+        print "    /// @see lok::Document::saveToCallback"
+        print "    /// SlimLO: save document through a write callback via private:stream"
+        print "    int (*saveToCallback)(LibreOfficeKitDocument* pThis,"
+        print "                          int (*pWrite)(void* pData, const unsigned char* pBytes,"
+        print "                                        unsigned long nSize),"
+        print "                          void* pData,"
+        print "                          const char* pFormat,"
+        print "                          const char* pFilterOptions);"
+        added_doc = 1
+        next
+    }
+    { print }
+    ' "$LOK_H" > "$LOK_H.tmp" && mv "$LOK_H.tmp" "$LOK_H"
+else
+    echo "    037: saveToCallback already in LibreOfficeKit.h"
+fi
+
+# ==========================================================================
+# Part 2: LibreOfficeKit.hxx — add C++ wrapper after insertDocument()
+# ==========================================================================
+if ! grep -q 'saveToCallback' "$LOK_HXX"; then
+    echo "    037: Adding saveToCallback to lok::Document..."
+    awk '
+    /inline bool insertDocument\(/ && !added_doc {
+        print
+        while ($0 !~ /^[[:space:]]*\}/) {
+            getline
+            print
+        }
+        print ""
+        print "    /// Save document through a write callback (SlimLO). pWrite receives the"
+        print "    /// output in order and returns nonzero to continue, zero to abort."
+        print "    inline bool saveToCallback("
+        print "        int (*pWrite)(void* pData, const unsigned char* pBytes, unsigned long nSize),"
+        print "        void* pData, const char* pFormat, const char* pFilterOptions = nullptr)"
+        print "    {"
+        print "        return mpDoc->pClass->saveToCallback(mpDoc, pWrite, pData, pFormat, pFilterOptions) != 0;"
+        print "    }"
+        added_doc = 1
+        next
+    }
+    { print }
+    ' "$LOK_HXX" > "$LOK_HXX.tmp" && mv "$LOK_HXX.tmp" "$LOK_HXX"
+else
+    echo "    037: saveToCallback already in LibreOfficeKit.hxx"
+fi
+
+# ==========================================================================
+# Part 3: init.cxx — includes, forward decl, implementation, vtable wiring
+# ==========================================================================
+
+# 3a. Headers used by the implementation
+for inc in \
+    com/sun/star/io/IOException.hpp \
+    com/sun/star/io/XOutputStream.hpp \
+    cppuhelper/implbase.hxx; do
+    if ! grep -q "#include <$inc>" "$INIT_CXX"; then
+        awk -v inc="$inc" '
+        /^#include <com\/sun\/star\// && !added { print "#include <" inc ">"; added = 1 }
+        { print }
+        ' "$INIT_CXX" > "$INIT_CXX.tmp" && mv "$INIT_CXX.tmp" "$INIT_CXX"
+    fi
+done
+
+# 3b. Forward declaration next to doc_insertDocument's
+if ! grep -q '^static int doc_saveToCallback(' "$INIT_CXX"; then
+    echo "    037: Adding forward declaration for doc_saveToCallback..."
+    awk '
+    /const char\* pBookmark, const char\* pOptions\); \/\/ SlimLO/ && !added_fwd {
+        print
+        print "static int doc_saveToCallback(LibreOfficeKitDocument* pThis,"
+        print "                              int (*pWrite)(void*, const unsigned char*, unsigned long),"
+        print "                              void* pData, const char* pFormat,"
+        print "                              const char* pFilterOptions); // SlimLO"
+        added_fwd = 1
+        next
+    }
+    { print }
+    ' "$INIT_CXX" > "$INIT_CXX.tmp" && mv "$INIT_CXX.tmp" "$INIT_CXX"
+fi
+
+# 3c. Implementation, inserted before doc_saveAs like doc_saveToBuffer
+if ! grep -q '// SlimLO: Save document through a write callback' "$INIT_CXX"; then
+    echo "    037: Adding doc_saveToCallback implementation..."
+
+    SAVEAS_DEF_LINE=$(grep -n 'doc_saveAs(' "$INIT_CXX" | grep -v 'doc_saveToBuffer\|;' | head -1 | cut -d: -f1)
+    if [ -z "$SAVEAS_DEF_LINE" ]; then
+        echo "    037: ERROR: Could not find doc_saveAs definition in init.cxx"
+        exit 1
+    fi
+
+    cat > "$INIT_CXX.impl_savecb" << 'IMPL_EOF'
+// SlimLO: Save document through a write callback via private:stream
+namespace {
+
+// Output stream forwarding each block to the caller; a failed write throws so
+// the filter stops exporting
+class SlimLOCallbackOutputStream : public cppu::WeakImplHelper<io::XOutputStream>
+{
+    int (*mpWrite)(void*, const unsigned char*, unsigned long);
+    void* mpData;
+
+public:
+    SlimLOCallbackOutputStream(int (*pWrite)(void*, const unsigned char*, unsigned long),
+                               void* pData)
+        : mpWrite(pWrite)
+        , mpData(pData)
+    {
+    }
+
+    void SAL_CALL writeBytes(const uno::Sequence<sal_Int8>& rData) override
+    {
+        if (rData.hasElements()
+            && !mpWrite(mpData, reinterpret_cast<const unsigned char*>(rData.getConstArray()),
+                        static_cast<unsigned long>(rData.getLength())))
+            throw io::IOException(u"saveToCallback: write callback failed"_ustr);
+    }
+    void SAL_CALL flush() override {}
+    void SAL_CALL closeOutput() override {}
+};
+
+} // namespace
+
+static int doc_saveToCallback(LibreOfficeKitDocument* pThis,
+                              int (*pWrite)(void*, const unsigned char*, unsigned long),
+                              void* pData, const char* pFormat,
+                              const char* pFilterOptions)
+{
+    comphelper::ProfileZone aZone("doc_saveToCallback");
+    SolarMutexGuard aGuard;
+    SetLastExceptionMsg();
+
+    if (!pWrite)
+    {
+        SetLastExceptionMsg(u"pWrite is required"_ustr);
+        return false;
+    }
+
+    LibLODocument_Impl* pDocument = static_cast<LibLODocument_Impl*>(pThis);
+    uno::Reference<frame::XStorable> xStorable(pDocument->mxComponent, uno::UNO_QUERY_THROW);
+
+    try
+    {
+        OUString sFormat = getUString(pFormat);
+
+        // Output filter from document type + format, as in doc_saveToBuffer
+        std::span<const ExtensionMap> pMap;
+        switch (doc_getDocumentType(pThis))
+        {
+        case LOK_DOCTYPE_SPREADSHEET: pMap = aCalcExtensionMap; break;
+        case LOK_DOCTYPE_PRESENTATION: pMap = aImpressExtensionMap; break;
+        case LOK_DOCTYPE_DRAWING: pMap = aDrawExtensionMap; break;
+        case LOK_DOCTYPE_TEXT: pMap = aWriterExtensionMap; break;
+        default:
+            SetLastExceptionMsg(u"Unsupported document type for callback save"_ustr);
+            return false;
+        }
+
+        OUString aFilterName;
+        for (const auto& item : pMap)
+        {
+            if (sFormat.equalsIgnoreAsciiCaseAscii(item.extn))
+            {
+                aFilterName = item.filterName;
+                break;
+            }
+        }
+        if (aFilterName.isEmpty())
+        {
+            SetLastExceptionMsg(u"No output filter found for format"_ustr);
+            return false;
+        }
+
+        uno::Reference<io::XOutputStream> xOut = new SlimLOCallbackOutputStream(pWrite, pData);
+
+        MediaDescriptor aSaveMediaDescriptor;
+        aSaveMediaDescriptor[u"OutputStream"_ustr] <<= xOut;
+        aSaveMediaDescriptor[u"FilterName"_ustr] <<= aFilterName;
+
+        OUString aFilterOptions = getUString(pFilterOptions);
+        if (!aFilterOptions.isEmpty())
+        {
+            comphelper::SequenceAsHashMap aFilterDataMap;
+            if (!aFilterOptions.startsWith("{"))
+                setFormatSpecificFilterData(sFormat, aFilterDataMap);
+
+            aSaveMediaDescriptor[MediaDescriptor::PROP_FILTEROPTIONS] <<= aFilterOptions;
+            if (!aFilterDataMap.empty())
+                aSaveMediaDescriptor[u"FilterData"_ustr] <<=
+                    aFilterDataMap.getAsConstPropertyValueList();
+        }
+
+        xStorable->storeToURL(u"private:stream"_ustr,
+            aSaveMediaDescriptor.getAsConstPropertyValueList());
+        return true;
+    }
+    catch (const uno::Exception& exception)
+    {
+        SetLastExceptionMsg("exception: " + exception.Message);
+    }
+    return false;
+}
+
+IMPL_EOF
+
+    head -n $((SAVEAS_DEF_LINE - 1)) "$INIT_CXX" > "$INIT_CXX.tmp"
+    cat "$INIT_CXX.impl_savecb" >> "$INIT_CXX.tmp"
+    tail -n +$SAVEAS_DEF_LINE "$INIT_CXX" >> "$INIT_CXX.tmp"
+    mv "$INIT_CXX.tmp" "$INIT_CXX"
+    rm -f "$INIT_CXX.impl_savecb"
+else
+    echo "    037: doc_saveToCallback already in init.cxx"
+fi
+
+# 3d. Wire into the document vtable
+if ! grep -q 'saveToCallback.*=.*doc_saveToCallback' "$INIT_CXX"; then
+    echo "    037: Wiring saveToCallback in document vtable..."
+    awk '
+    /insertDocument.*=.*doc_insertDocument/ && !wired_doc {
+        print
+        print "        m_pDocumentClass->saveToCallback = doc_saveToCallback; // SlimLO"
+        wired_doc = 1
+        next
+    }
+    { print }
+    ' "$INIT_CXX" > "$INIT_CXX.tmp" && mv "$INIT_CXX.tmp" "$INIT_CXX"
+fi
+
+# ==========================================================================
+# Verification
+# ==========================================================================
+
+FAIL=0
+grep -q 'saveToCallback' "$LOK_H" || { echo "    037: ERROR: saveToCallback not in LibreOfficeKit.h"; FAIL=1; }
+grep -q 'saveToCallback' "$LOK_HXX" || { echo "    037: ERROR: saveToCallback not in LibreOfficeKit.hxx"; FAIL=1; }
+grep -q '// SlimLO: Save document through a write callback' "$INIT_CXX" || { echo "    037: ERROR: doc_saveToCallback not in init.cxx"; FAIL=1; }
+grep -q 'saveToCallback.*=.*doc_saveToCallback' "$INIT_CXX" || { echo "    037: ERROR: saveToCallback not wired in document vtable"; FAIL=1; }
+
+if [ "$FAIL" -eq 1 ]; then
+    exit 1
+fi
+
+echo "    037: LOKit save to callback applied"
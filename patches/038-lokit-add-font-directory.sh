@@ -0,0 +1,281 @@
+#!/bin/bash
+# 038-lokit-add-font-directory.sh
+#
+# Add runtime font registration to the LibreOfficeKit C API, so a running
+# SlimLO instance can pick up a new font directory without a restart.
+#
+# Fonts are otherwise only read at startup (SAL_FONTPATH, fontconfig, or
+# CoreText registration on macOS). addFontDirectory walks pPath recursively
+# and hands every .ttf/.otf/.ttc/.otc file to OutputDevice::AddTempDevFont —
+# the same path EmbeddedFontsHelper uses for fonts embedded in documents, and
+# which every VCL backend implements (fontconfig app fonts, CoreText,
+# AddFontResourceEx). Afterwards only the font data is rebuilt
+# (ImplUpdateAllFontData): font lists, the font collection and the
+# substitution/fallback caches. Files registered by an earlier call are
+# skipped, and nothing is rebuilt when no file is new.
+#
+# ImplUpdateAllFontData is SAL_DLLPRIVATE to vcl; SlimLO builds with
+# --enable-mergelibs, so vcl and desktop share libmergedlo and it resolves.
+#
+# Returns the number of newly registered files, or -1 with getError() set.
+#
+# Patches three files:
+#   1. include/LibreOfficeKit/LibreOfficeKit.h  — extend office vtable
+#   2. include/LibreOfficeKit/LibreOfficeKit.hxx — C++ wrapper method
+#   3. desktop/source/lib/init.cxx              — implement + wire vtable
+#
+# Must run after 017 (inserts after documentLoadFromBuffer).
+# Idempotent: safe to re-run.
+
+set -euo pipefail
+
+LO_SRC="${1:?Missing LO source dir}"
+
+LOK_H="$LO_SRC/include/LibreOfficeKit/LibreOfficeKit.h"
+LOK_HXX="$LO_SRC/include/LibreOfficeKit/LibreOfficeKit.hxx"
+INIT_CXX="$LO_SRC/desktop/source/lib/init.cxx"
+
+for f in "$LOK_H" "$LOK_HXX" "$INIT_CXX"; do
+    if [ ! -f "$f" ]; then
+        echo "    ERROR: $f not found"
+        exit 1
+    fi
+done
+
+if ! grep -q 'documentLoadFromBuffer' "$LOK_H"; then
+    echo "    038: ERROR: documentLoadFromBuffer not found — run 017-lokit-buffer-api.sh first"
+    exit 1
+fi
+
+# ==========================================================================
+# Part 1: LibreOfficeKit.h — add addFontDirectory after documentLoadFromBuffer
+# ==========================================================================
+if ! grep -q 'addFontDirectory' "$LOK_H"; then
+    echo "    038: Adding addFontDirectory to _LibreOfficeKitClass..."
+    awk '
+    /\(\*documentLoadFromBuffer\)/ && !added_office {
+        print
+        while ($0 !~ /\);/) {
+            getline
+            print
+        }
+        print ""
+        print "    /// @see lok::Office::addFontDirectory"
+        print "    /// SlimLO: register the fonts in a directory at runtime"
+        print "    int (*addFontDirectory)(LibreOfficeKit* pThis, const char* pPath);"
+        added_office = 1
+        next
+    }
+    { print }
+    ' "$LOK_H" > "$LOK_H.tmp" && mv "$LOK_H.tmp" "$LOK_H"
+else
+    echo "    038: addFontDirectory already in LibreOfficeKit.h"
+fi
+
+# ==========================================================================
+# Part 2: LibreOfficeKit.hxx — add C++ wrapper after documentLoadFromBuffer()
+# ==========================================================================
+if ! grep -q 'addFontDirectory' "$LOK_HXX"; then
+    echo "    038: Adding addFontDirectory to lok::Office..."
+    awk '
+    /inline Document\* documentLoadFromBuffer\(/ && !added_office {
+        print
+        while ($0 !~ /^[[:space:]]*\}/) {
+            getline
+            print
+        }
+        print ""
+        print "    /// Register the fonts in a directory (SlimLO). Returns the number of"
+        print "    /// newly registered font files, or -1 on error (see getError())."
+        print "    inline int addFontDirectory(const char* pPath)"
+        print "    {"
+        print "        return mpThis->pClass->addFontDirectory(mpThis, pPath);"
+        print "    }"
+        added_office = 1
+        next
+    }
+    { print }
+    ' "$LOK_HXX" > "$LOK_HXX.tmp" && mv "$LOK_HXX.tmp" "$LOK_HXX"
+else
+    echo "    038: addFontDirectory already in LibreOfficeKit.hxx"
+fi
+
+# ==========================================================================
+# Part 3: init.cxx — includes, forward decl, implementation, vtable wiring
+# ==========================================================================
+
+# 3a. Headers used by the implementation
+for inc in \
+    algorithm \
+    unordered_set \
+    o3tl/string_view.hxx \
+    osl/file.hxx \
+    vcl/outdev.hxx \
+    vcl/svapp.hxx; do
+    if ! grep -q "#include <$inc>" "$INIT_CXX"; then
+        awk -v inc="$inc" '
+        /^#include <com\/sun\/star\// && !added { print "#include <" inc ">"; added = 1 }
+        { print }
+        ' "$INIT_CXX" > "$INIT_CXX.tmp" && mv "$INIT_CXX.tmp" "$INIT_CXX"
+    fi
+done
+
+# 3b. Forward declaration next to lo_documentLoadFromBuffer's
+if ! grep -q '^static int lo_addFontDirectory(' "$INIT_CXX"; then
+    echo "    038: Adding forward declaration for lo_addFontDirectory..."
+    awk '
+    /^static LibreOfficeKitDocument\* lo_documentLoadFromBuffer\(.*; \/\/ SlimLO/ && !added_fwd {
+        print
+        print "static int lo_addFontDirectory(LibreOfficeKit* pThis, const char* pPath); // SlimLO"
+        added_fwd = 1
+        next
+    }
+    { print }
+    ' "$INIT_CXX" > "$INIT_CXX.tmp" && mv "$INIT_CXX.tmp" "$INIT_CXX"
+fi
+
+# 3c. Implementation, inserted before lo_documentLoad like lo_documentLoadFromBuffer
+if ! grep -q '// SlimLO: Register the fonts in a directory at runtime' "$INIT_CXX"; then
+    echo "    038: Adding lo_addFontDirectory implementation..."
+
+    LOAD_DEF_LINE=$(grep -n 'lo_documentLoad(' "$INIT_CXX" | grep -v 'FromBuffer\|LoadWithOptions\|;' | head -1 | cut -d: -f1)
+    if [ -z "$LOAD_DEF_LINE" ]; then
+        echo "    038: ERROR: Could not find lo_documentLoad definition in init.cxx"
+        exit 1
+    fi
+
+    cat > "$INIT_CXX.impl_fontdir" << 'IMPL_EOF'
+// SlimLO: Register the fonts in a directory at runtime
+namespace {
+
+bool slimloIsFontFile(std::u16string_view aName)
+{
+    for (std::u16string_view aExt : { u".ttf", u".otf", u".ttc", u".otc" })
+    {
+        if (aName.size() > aExt.size()
+            && o3tl::equalsIgnoreAsciiCase(aName.substr(aName.size() - aExt.size()), aExt))
+            return true;
+    }
+    return false;
+}
+
+// Font file URLs below rDirUrl, subdirectories included (as fontconfig
+// scans a SAL_FONTPATH entry)
+bool slimloCollectFontFiles(const OUString& rDirUrl, std::vector<OUString>& rFiles)
+{
+    osl::Directory aDir(rDirUrl);
+    if (aDir.open() != osl::FileBase::E_None)
+        return false;
+
+    osl::DirectoryItem aItem;
+    while (aDir.getNextItem(aItem) == osl::FileBase::E_None)
+    {
+        osl::FileStatus aStatus(osl_FileStatus_Mask_Type | osl_FileStatus_Mask_FileName
+                                | osl_FileStatus_Mask_FileURL);
+        if (aItem.getFileStatus(aStatus) != osl::FileBase::E_None)
+            continue;
+        if (aStatus.getFileType() == osl::FileStatus::Directory)
+            slimloCollectFontFiles(aStatus.getFileURL(), rFiles);
+        else if (slimloIsFontFile(aStatus.getFileName()))
+            rFiles.push_back(aStatus.getFileURL());
+    }
+    return true;
+}
+
+} // namespace
+
+static int lo_addFontDirectory(LibreOfficeKit* pThis, const char* pPath)
+{
+    comphelper::ProfileZone aZone("lo_addFontDirectory");
+    SolarMutexGuard aGuard;
+
+    // Registered files, for the lifetime of the process
+    static std::unordered_set<OUString> aRegistered;
+
+    LibLibreOffice_Impl* pLib = static_cast<LibLibreOffice_Impl*>(pThis);
+    pLib->maLastExceptionMsg.clear();
+
+    if (!pPath || pPath[0] == 0)
+    {
+        pLib->maLastExceptionMsg = u"Font directory path is empty"_ustr;
+        return -1;
+    }
+
+    OUString aDirUrl;
+    if (osl::FileBase::getFileURLFromSystemPath(OUString::fromUtf8(pPath), aDirUrl)
+        != osl::FileBase::E_None)
+    {
+        pLib->maLastExceptionMsg = "Invalid font directory path: " + OUString::fromUtf8(pPath);
+        return -1;
+    }
+
+    std::vector<OUString> aFiles;
+    if (!slimloCollectFontFiles(aDirUrl, aFiles))
+    {
+        pLib->maLastExceptionMsg = "Cannot open font directory: " + OUString::fromUtf8(pPath);
+        return -1;
+    }
+    std::sort(aFiles.begin(), aFiles.end());
+
+    OutputDevice* pDevice = Application::GetDefaultDevice();
+    int nAdded = 0;
+    for (const OUString& rUrl : aFiles)
+    {
+        if (aRegistered.count(rUrl))
+            continue;
+        // Family names come from the file itself
+        if (pDevice->AddTempDevFont(rUrl, OUString()))
+        {
+            aRegistered.insert(rUrl);
+            ++nAdded;
+        }
+        else
+            SAL_WARN("lok", "addFontDirectory: cannot register " << rUrl);
+    }
+
+    // Rebuild font lists and font caches only; documents are not touched
+    if (nAdded > 0)
+        OutputDevice::ImplUpdateAllFontData(true);
+    return nAdded;
+}
+
+IMPL_EOF
+
+    head -n $((LOAD_DEF_LINE - 1)) "$INIT_CXX" > "$INIT_CXX.tmp"
+    cat "$INIT_CXX.impl_fontdir" >> "$INIT_CXX.tmp"
+    tail -n +$LOAD_DEF_LINE "$INIT_CXX" >> "$INIT_CXX.tmp"
+    mv "$INIT_CXX.tmp" "$INIT_CXX"
+    rm -f "$INIT_CXX.impl_fontdir"
+else
+    echo "    038: lo_addFontDirectory already in init.cxx"
+fi
+
+# 3d. Wire into the office vtable
+if ! grep -q 'addFontDirectory.*=.*lo_addFontDirectory' "$INIT_CXX"; then
+    echo "    038: Wiring addFontDirectory in office vtable..."
+    awk '
+    /documentLoadFromBuffer.*=.*lo_documentLoadFromBuffer/ && !wired_office {
+        print
+        print "        m_pOfficeClass->addFontDirectory = lo_addFontDirectory; // SlimLO"
+        wired_office = 1
+        next
+    }
+    { print }
+    ' "$INIT_CXX" > "$INIT_CXX.tmp" && mv "$INIT_CXX.tmp" "$INIT_CXX"
+fi
+
+# ==========================================================================
+# Verification
+# ==========================================================================
+
+FAIL=0
+grep -q 'addFontDirectory' "$LOK_H" || { echo "    038: ERROR: addFontDirectory not in LibreOfficeKit.h"; FAIL=1; }
+grep -q 'addFontDirectory' "$LOK_HXX" || { echo "    038: ERROR: addFontDirectory not in LibreOfficeKit.hxx"; FAIL=1; }
+grep -q '// SlimLO: Register the fonts in a directory at runtime' "$INIT_CXX" || { echo "    038: ERROR: lo_addFontDirectory not in init.cxx"; FAIL=1; }
+grep -q 'addFontDirectory.*=.*lo_addFontDirectory' "$INIT_CXX" || { echo "    038: ERROR: addFontDirectory not wired in office vtable"; FAIL=1; }
+
+if [ "$FAIL" -eq 1 ]; then
+    exit 1
+fi
+
+echo "    038: LOKit add font directory applied"
@@ -551,12 +551,18 @@ if [ -f "$PROJECT_DIR/slimlo-api/CMakeLists.txt" ] && command -v cmake >/dev/nul
     # Copy worker executable (needed by .NET SDK for out-of-process conversion)
     cp -a "$PROJECT_DIR/slimlo-api/build"/slimlo_worker "$OUTPUT_DIR/program/" 2>/dev/null || true
     cp -a "$PROJECT_DIR/slimlo-api/build"/slimlo_worker.exe "$OUTPUT_DIR/program/" 2>/dev/null || true
+    # Copy the shared-pool daemon (SDK "connect" mode; not built on Windows)
+    cp -a "$PROJECT_DIR/slimlo-api/build"/slimlo_server "$OUTPUT_DIR/program/" 2>/dev/null || true
+    # Copy the JNI bridge (Java in-process mode; built only when a JDK is found)
+    cp -a "$PROJECT_DIR/slimlo-api/build"/libslimlo_jni.so "$OUTPUT_DIR/program/" 2>/dev/null || true
+    cp -a "$PROJECT_DIR/slimlo-api/build"/slimlo_jni.dll "$OUTPUT_DIR/program/" 2>/dev/null || true
     mkdir -p "$OUTPUT_DIR/include"
     cp "$PROJECT_DIR/slimlo-api/include/slimlo.h" "$OUTPUT_DIR/include/"
+    cp "$PROJECT_DIR/slimlo-api/include/slimlo.hpp" "$OUTPUT_DIR/include/"
     # Fix RPATH on macOS: replace stale build RPATHs with @loader_path
     if [ "$PLATFORM" = "macos" ]; then
         echo "    Fixing RPATH for macOS binaries..."
-        for bin in "$OUTPUT_DIR/program/slimlo_worker" "$OUTPUT_DIR/program"/libslimlo*.dylib; do
+        for bin in "$OUTPUT_DIR/program/slimlo_worker" "$OUTPUT_DIR/program/slimlo_server" "$OUTPUT_DIR/program"/libslimlo*.dylib; do
             [ -f "$bin" ] || continue
             # Remove stale build RPATHs
             for rp in $(otool -l "$bin" | awk '/cmd LC_RPATH/{getline;getline;print $2}'); do
@@ -60,6 +60,8 @@ typedef enum {
     SLIMLO_ERROR_ALREADY_INIT      = 8,
     SLIMLO_ERROR_NOT_INIT          = 9,
     SLIMLO_ERROR_INVALID_ARGUMENT  = 10,
+    SLIMLO_ERROR_QUARANTINED       = 11, /* SDK worker pools: document crashed workers before */
+    SLIMLO_ERROR_DEADLINE_EXCEEDED = 12, /* SDK worker pools: request shed, cannot meet its deadline */
     SLIMLO_ERROR_UNKNOWN           = 99
 } SlimLOError;
 
@@ -79,6 +81,27 @@ typedef enum {
     SLIMLO_PDF_A3      = 3
 } SlimLOPdfVersion;
 
+/*
+ * Named export presets. A preset seeds the PDF filter properties; any field
+ * set explicitly in SlimLOPdfOptions (and any entry in filter_options)
+ * overrides the preset's value for that property.
+ *
+ *   FAST      No bookmarks, comments, form fields or tagging; images are
+ *             passed through without downsampling. Lowest export cost.
+ *   SMALL     JPEG quality 60, images downsampled to 150 DPI, standard
+ *             fonts not embedded, no comments or form fields.
+ *   ARCHIVAL  PDF/A-2b, tagged, bookmarks, standard fonts embedded.
+ *   PRINT     Lossless images at full resolution, standard fonts embedded,
+ *             no bookmarks, comments or form fields.
+ */
+typedef enum {
+    SLIMLO_PRESET_NONE     = 0,
+    SLIMLO_PRESET_FAST     = 1,
+    SLIMLO_PRESET_SMALL    = 2,
+    SLIMLO_PRESET_ARCHIVAL = 3,
+    SLIMLO_PRESET_PRINT    = 4
+} SlimLOPdfPreset;
+
 /* PDF conversion options */
 typedef struct {
     SlimLOPdfVersion pdf_version;   /* PDF version (0 = default) */
@@ -87,8 +110,139 @@ typedef struct {
     int              tagged_pdf;    /* 0 = no, 1 = yes */
     const char*      page_range;    /* Page range, e.g. "1-3" (NULL = all) */
     const char*      password;      /* Document password (NULL = none) */
+    SlimLOPdfPreset  preset;        /* Export preset (0 = none) */
+    const char*      filter_options; /* Raw PDF filter properties appended last,
+                                       e.g. "ExportNotes=true,IsSkipEmptyPages=true"
+                                       (NULL = none) */
+    int              lazy_layout;   /* 0 = lay out the whole document (default),
+                                       1 = with a bounded page_range, stop layout
+                                       after its last page; page count fields
+                                       then reflect the laid-out pages only */
+    int              skip_field_update; /* 0 = refresh links and fields (default),
+                                       1 = keep the results cached in the file:
+                                       no link update on load, no field update
+                                       before export (see README) */
 } SlimLOPdfOptions;
 
+/* Conversion progress phases, reported in order */
+typedef enum {
+    SLIMLO_PROGRESS_LOAD   = 1,  /* Import and initial layout */
+    SLIMLO_PROGRESS_LAYOUT = 2,  /* Layout finished; page count known */
+    SLIMLO_PROGRESS_EXPORT = 3,  /* PDF export running */
+    SLIMLO_PROGRESS_DONE   = 4   /* Output written */
+} SlimLOProgressPhase;
+
+/* Progress snapshot passed to SlimLOProgressCallback */
+typedef struct {
+    SlimLOProgressPhase phase;
+    int      percent;         /* 0-100 within the current phase */
+    int      pages_laid_out;  /* Pages laid out (0 until LAYOUT) */
+    int      pages_exported;  /* Pages exported; estimated from the export
+                                 percentage until DONE */
+    uint64_t bytes_written;   /* Output size in bytes (0 until DONE) */
+} SlimLOProgress;
+
+/*
+ * Progress callback. Invoked on the converting thread while the conversion
+ * mutex is held; it must not call back into SlimLO. Percent updates are
+ * coalesced: the callback fires only when phase or percent changes.
+ */
+typedef void (*SlimLOProgressCallback)(const SlimLOProgress* progress, void* user_data);
+
+/* Page size in points (1/72 inch) */
+typedef struct {
+    double width;
+    double height;
+} SlimLOPageSize;
+
+/*
+ * Document metadata gathered after load and layout, without PDF export.
+ * Filled by slimlo_document_info*(); release with slimlo_free_document_info().
+ */
+typedef struct {
+    int             page_count;
+    SlimLOPageSize* pages;              /* page_count entries */
+    int             section_count;
+    int             image_count;
+    int             word_count;
+    int             font_count;
+    char**          fonts;              /* Font families the document uses
+                                           (embedded into the PDF on export) */
+    int             missing_font_count;
+    char**          missing_fonts;      /* Subset of fonts that are not
+                                           installed and will be substituted */
+} SlimLODocumentInfo;
+
+/* Raster format for rendered pages */
+typedef enum {
+    SLIMLO_IMAGE_PNG  = 0,  /* PNG file bytes */
+    SLIMLO_IMAGE_RGBA = 1   /* Raw pixels: 4 bytes per pixel (straight alpha),
+                               rows top-down, no padding */
+} SlimLOImageFormat;
+
+/* Page rendering options */
+typedef struct {
+    SlimLOImageFormat format;
+    int               width;       /* Pixel width (0 = 256, max 8192); the height
+                                      follows the page's aspect ratio */
+    const char*       page_range;  /* Pages to render, e.g. "1", "1-3,5" or "2-"
+                                      (NULL = first page). Pages past the end
+                                      of the document are skipped. */
+} SlimLORenderOptions;
+
+/* One rendered page */
+typedef struct {
+    int               page;    /* 1-based page number */
+    int               width;   /* Pixels */
+    int               height;  /* Pixels */
+    SlimLOImageFormat format;
+    uint8_t*          data;    /* PNG bytes, or width * height * 4 RGBA bytes */
+    size_t            size;
+} SlimLOPageImage;
+
+/*
+ * Page image callback for rendering as a side output of a conversion. Invoked
+ * on the converting thread, after load and before PDF export, while the
+ * conversion mutex is held; it must not call back into SlimLO. The image and
+ * its data are only valid for the duration of the call.
+ */
+typedef void (*SlimLOPageImageCallback)(const SlimLOPageImage* image, void* user_data);
+
+/* Text extraction options */
+typedef struct {
+    int         include_words;  /* Non-zero: also report word bounding boxes */
+    const char* page_range;     /* Pages to extract, e.g. "1-3,5" or "2-"
+                                   (NULL = all pages) */
+} SlimLOTextOptions;
+
+/* A word and its bounding box, in points from the page's top-left corner */
+typedef struct {
+    double      x;
+    double      y;
+    double      width;
+    double      height;
+    const char* text;   /* UTF-8 */
+} SlimLOWordBox;
+
+/* Text of one page, as laid out */
+typedef struct {
+    int                  page;        /* 1-based page number */
+    SlimLOPageSize       size;
+    const char*          text;        /* UTF-8, lines separated by '\n' */
+    const SlimLOWordBox* words;       /* In paint order; NULL unless
+                                         include_words was set */
+    int                  word_count;
+} SlimLOPageText;
+
+/*
+ * Page text callback for text extraction as a side output of a conversion.
+ * Invoked on the converting thread, once per selected page, after the PDF has
+ * been written (layout is final by then) and while the conversion mutex is
+ * held; it must not call back into SlimLO. The page text and everything it
+ * points to are only valid for the duration of the call.
+ */
+typedef void (*SlimLOPageTextCallback)(const SlimLOPageText* page, void* user_data);
+
 /**
  * Initialize the SlimLO library. Call once per process.
  *
@@ -100,6 +254,28 @@ typedef struct {
  */
 SLIMLO_API SlimLOHandle slimlo_init(const char* resource_path);
 
+/* Process-wide initialization options (slimlo_init_ex) */
+typedef struct {
+    int threads;    /* Thread budget for LibreOffice's internal pools
+                       (comphelper::ThreadPool, threaded XML parsing).
+                       0 = LibreOffice default (one thread per core);
+                       1 = single-threaded, also parses XML parts inline.
+                       Size it as cores / workers when running several
+                       SlimLO processes on one machine. */
+} SlimLOInitOptions;
+
+/**
+ * Initialize the SlimLO library with options. Call once per process,
+ * instead of slimlo_init().
+ *
+ * @param resource_path  As for slimlo_init().
+ * @param options        Initialization options (NULL = defaults).
+ * @return Handle on success, NULL on failure.
+ *         Call slimlo_get_error_message(NULL) for details on failure.
+ */
+SLIMLO_API SlimLOHandle slimlo_init_ex(const char* resource_path,
+                                       const SlimLOInitOptions* options);
+
 /**
  * Destroy the SlimLO instance and free all resources.
  *
@@ -148,8 +324,245 @@ SLIMLO_API SlimLOError slimlo_convert_buffer(
     size_t* output_size
 );
 
+/*
+ * Caller-supplied memory for the PDF of slimlo_convert_buffer_alloc().
+ * All functions are called on the converting thread, during the call only.
+ *
+ *   alloc    Return size bytes, or NULL on failure.
+ *   realloc  Optional. Resize ptr (old_size bytes) to new_size bytes, keeping
+ *            its contents, or return NULL on failure (ptr stays valid). With
+ *            realloc the PDF is written straight into one growing block, then
+ *            shrunk to its final size; allocators that can extend their last
+ *            block in place (arenas) then never copy it. Without it, the
+ *            output is staged in library memory and copied once into a
+ *            single alloc of the final size.
+ *   free     Release ptr (size bytes). Used only on failure.
+ *   ctx      Passed through to the functions above.
+ */
+typedef struct {
+    void* (*alloc)(void* ctx, size_t size);
+    void* (*realloc)(void* ctx, void* ptr, size_t old_size, size_t new_size);
+    void  (*free)(void* ctx, void* ptr, size_t size);
+    void* ctx;
+} SlimLOAllocator;
+
+/**
+ * Convert a document from memory buffer to PDF in caller-allocated memory.
+ * As slimlo_convert_buffer(), but the exported bytes are written directly
+ * into memory from allocator instead of a buffer to copy out of.
+ *
+ * @param allocator    Output allocator (alloc and free required).
+ * @param output_data  Receives the PDF, owned by the caller: a block of
+ *                     exactly *output_size bytes from allocator.
+ * @param output_size  Receives size of output PDF data.
+ * @return SLIMLO_OK on success, error code on failure
+ *         (SLIMLO_ERROR_OUT_OF_MEMORY if the allocator failed).
+ */
+SLIMLO_API SlimLOError slimlo_convert_buffer_alloc(
+    SlimLOHandle handle,
+    const uint8_t* input_data,
+    size_t input_size,
+    SlimLOFormat format_hint,
+    const SlimLOPdfOptions* options,
+    const SlimLOAllocator* allocator,
+    uint8_t** output_data,
+    size_t* output_size
+);
+
+/* One input of slimlo_combine_to_pdf() */
+typedef struct {
+    const char* input_path;  /* Path to input document (.docx only) */
+    const char* bookmark;    /* Title of a top-level PDF outline entry for this
+                                part, with the part's own headings nested below
+                                it (NULL = no entry) */
+} SlimLOCombinePart;
+
+/**
+ * Convert several documents into one PDF. The first part is loaded as usual;
+ * every further part is appended to it on a new page, and the result is
+ * exported once, so fonts and images shared between parts are embedded once.
+ *
+ * Parts are merged into the first document: a style defined in several parts
+ * keeps the first part's definition. options apply to every part (password,
+ * skip_field_update) and to the export; a page_range selects pages of the
+ * combined document.
+ *
+ * @param handle       Handle from slimlo_init().
+ * @param parts        Parts in output order.
+ * @param part_count   Number of parts (at least 1).
+ * @param output_path  Path for output PDF file.
+ * @param options      PDF options (NULL for defaults).
+ * @return SLIMLO_OK on success, error code on failure.
+ */
+SLIMLO_API SlimLOError slimlo_combine_to_pdf(
+    SlimLOHandle handle,
+    const SlimLOCombinePart* parts,
+    int part_count,
+    const char* output_path,
+    const SlimLOPdfOptions* options
+);
+
+/**
+ * Load a document, finish its layout and report page count, page sizes,
+ * sections, images and fonts. No PDF export is performed, so this is
+ * considerably cheaper than a conversion.
+ *
+ * @param handle      Handle from slimlo_init().
+ * @param input_path  Path to input document (.docx only).
+ * @param info        Receives the metadata. Release with
+ *                    slimlo_free_document_info(), also on failure.
+ * @return SLIMLO_OK on success, error code on failure.
+ */
+SLIMLO_API SlimLOError slimlo_document_info(
+    SlimLOHandle handle,
+    const char* input_path,
+    SlimLODocumentInfo* info
+);
+
+/**
+ * Same as slimlo_document_info(), for a document held in memory.
+ *
+ * @param handle       Handle from slimlo_init().
+ * @param input_data   Input document bytes.
+ * @param input_size   Size of input data.
+ * @param format_hint  Format hint (required; SLIMLO_FORMAT_DOCX only).
+ * @param info         Receives the metadata.
+ * @return SLIMLO_OK on success, error code on failure.
+ */
+SLIMLO_API SlimLOError slimlo_document_info_buffer(
+    SlimLOHandle handle,
+    const uint8_t* input_data,
+    size_t input_size,
+    SlimLOFormat format_hint,
+    SlimLODocumentInfo* info
+);
+
+/**
+ * Free the arrays owned by a SlimLODocumentInfo and zero it.
+ *
+ * @param info  Structure filled by slimlo_document_info*(). Safe with NULL.
+ */
+SLIMLO_API void slimlo_free_document_info(SlimLODocumentInfo* info);
+
+/**
+ * Load a document and render selected pages to images via LOKit tile
+ * painting. No PDF export is performed.
+ *
+ * @param handle       Handle from slimlo_init().
+ * @param input_path   Path to input document (.docx only).
+ * @param options      Render options (NULL = first page, 256 px wide PNG).
+ * @param images       Receives an array of rendered pages in page order.
+ *                     Release with slimlo_free_page_images().
+ * @param image_count  Receives the number of entries in *images.
+ * @return SLIMLO_OK on success, error code on failure.
+ */
+SLIMLO_API SlimLOError slimlo_render_pages(
+    SlimLOHandle handle,
+    const char* input_path,
+    const SlimLORenderOptions* options,
+    SlimLOPageImage** images,
+    int* image_count
+);
+
+/**
+ * Same as slimlo_render_pages(), for a document held in memory.
+ *
+ * @param handle       Handle from slimlo_init().
+ * @param input_data   Input document bytes.
+ * @param input_size   Size of input data.
+ * @param format_hint  Format hint (required; SLIMLO_FORMAT_DOCX only).
+ * @param options      Render options (NULL for defaults).
+ * @param images       Receives the rendered pages.
+ * @param image_count  Receives the number of entries in *images.
+ * @return SLIMLO_OK on success, error code on failure.
+ */
+SLIMLO_API SlimLOError slimlo_render_pages_buffer(
+    SlimLOHandle handle,
+    const uint8_t* input_data,
+    size_t input_size,
+    SlimLOFormat format_hint,
+    const SlimLORenderOptions* options,
+    SlimLOPageImage** images,
+    int* image_count
+);
+
+/**
+ * Free an image array returned by slimlo_render_pages*().
+ *
+ * @param images  Array from slimlo_render_pages*(). Safe to call with NULL.
+ * @param count   Number of entries.
+ */
+SLIMLO_API void slimlo_free_page_images(SlimLOPageImage* images, int count);
+
+/**
+ * Install (or clear) a page image callback for subsequent conversions.
+ * Each conversion then also renders the selected pages from the document it
+ * has already loaded, so a thumbnail costs no second load.
+ *
+ * @param handle     Handle from slimlo_init().
+ * @param options    Render options, copied (NULL for defaults).
+ * @param callback   Callback, or NULL to stop rendering.
+ * @param user_data  Opaque pointer passed back to the callback.
+ * @return SLIMLO_OK, or SLIMLO_ERROR_INVALID_ARGUMENT for bad options.
+ */
+SLIMLO_API SlimLOError slimlo_set_page_image_callback(
+    SlimLOHandle handle,
+    const SlimLORenderOptions* options,
+    SlimLOPageImageCallback callback,
+    void* user_data
+);
+
+/**
+ * Install (or clear) a page text callback for subsequent conversions.
+ * Each conversion then also reports the plain text (and optionally word
+ * boxes) of the selected pages, taken from the same load and layout as the
+ * PDF, so indexing needs no second parse of the output.
+ *
+ * @param handle     Handle from slimlo_init().
+ * @param options    Text options, copied (NULL = all pages, no word boxes).
+ * @param callback   Callback, or NULL to stop extracting.
+ * @param user_data  Opaque pointer passed back to the callback.
+ * @return SLIMLO_OK, or SLIMLO_ERROR_INVALID_ARGUMENT for bad options.
+ */
+SLIMLO_API SlimLOError slimlo_set_page_text_callback(
+    SlimLOHandle handle,
+    const SlimLOTextOptions* options,
+    SlimLOPageTextCallback callback,
+    void* user_data
+);
+
+/**
+ * Install (or clear) the progress callback for subsequent conversions.
+ *
+ * @param handle     Handle from slimlo_init().
+ * @param callback   Callback, or NULL to disable progress reporting.
+ * @param user_data  Opaque pointer passed back to the callback.
+ */
+SLIMLO_API void slimlo_set_progress_callback(
+    SlimLOHandle handle,
+    SlimLOProgressCallback callback,
+    void* user_data
+);
+
+/**
+ * Register the fonts in a directory with a running instance.
+ *
+ * Font files (.ttf, .otf, .ttc, .otc) in the directory and its
+ * subdirectories become available to subsequent conversions, with no
+ * restart. Only LibreOffice's font lists and font caches are rebuilt, and
+ * only if a file is new: registering the same directory again is cheap.
+ * Registered fonts stay for the lifetime of the process.
+ *
+ * @param handle  Handle from slimlo_init().
+ * @param path    Font directory.
+ * @return SLIMLO_OK on success, SLIMLO_ERROR_FILE_NOT_FOUND if the
+ *         directory cannot be read, or another error code.
+ */
+SLIMLO_API SlimLOError slimlo_add_font_directory(SlimLOHandle handle, const char* path);
+
 /**
- * Free a buffer allocated by slimlo_convert_buffer().
+ * Free a buffer allocated by slimlo_convert_buffer() (not by
+ * slimlo_convert_buffer_alloc(), whose output belongs to its allocator).
  *
  * @param buffer  Pointer returned via output_data. Safe to call with NULL.
  */
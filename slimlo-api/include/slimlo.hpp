@@ -0,0 +1,179 @@
+/*
+ * slimlo.hpp — Header-only C++ wrapper for the SlimLO C API
+ *
+ * RAII ownership of the instance and of output buffers, std::span inputs,
+ * and PDFs written straight into a std::pmr::memory_resource through
+ * slimlo_convert_buffer_alloc() — no malloc'ed buffer to copy out of.
+ * Errors are thrown as slimlo::Error. Requires C++20.
+ *
+ * Usage:
+ *   slimlo::Instance lo("/path/to/slimlo/resources");
+ *   std::pmr::monotonic_buffer_resource arena(64 << 20);
+ *   slimlo::Buffer pdf = lo.convert(std::as_bytes(std::span(docx)),
+ *                                   SLIMLO_FORMAT_DOCX, nullptr, &arena);
+ *   send(pdf.bytes());
+ *
+ * Same thread safety as slimlo.h: calls on one instance are serialized.
+ */
+
+#ifndef SLIMLO_HPP
+#define SLIMLO_HPP
+
+#include "slimlo.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace slimlo {
+
+/* A failed SlimLO call: its error code and message */
+class Error : public std::runtime_error {
+public:
+    Error(SlimLOError code, const std::string& message)
+        : std::runtime_error(message), code_(code) {}
+
+    SlimLOError code() const noexcept { return code_; }
+
+private:
+    SlimLOError code_;
+};
+
+/* A PDF in memory from a std::pmr::memory_resource, returned to it on destruction */
+class Buffer {
+public:
+    Buffer() noexcept = default;
+    Buffer(Buffer&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          resource_(std::exchange(other.resource_, nullptr)) {}
+    Buffer& operator=(Buffer&& other) noexcept {
+        if (this != &other) {
+            reset();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            resource_ = std::exchange(other.resource_, nullptr);
+        }
+        return *this;
+    }
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+    ~Buffer() { reset(); }
+
+    const std::byte* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    std::span<const std::byte> bytes() const noexcept { return { data_, size_ }; }
+    std::pmr::memory_resource* resource() const noexcept { return resource_; }
+
+    void reset() noexcept {
+        if (data_) resource_->deallocate(data_, size_, alignof(std::max_align_t));
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+private:
+    friend class Instance;
+    Buffer(std::byte* data, std::size_t size, std::pmr::memory_resource* resource) noexcept
+        : data_(data), size_(size), resource_(resource) {}
+
+    std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::pmr::memory_resource* resource_ = nullptr;
+};
+
+namespace detail {
+
+/* SlimLOAllocator over a memory_resource (ctx). memory_resource cannot grow a
+ * block, so there is no realloc: SlimLO stages the PDF and allocates it once
+ * at its final size. Exceptions must not cross the C API. */
+inline void* resource_alloc(void* ctx, std::size_t size) {
+    try {
+        return static_cast<std::pmr::memory_resource*>(ctx)->allocate(
+            size, alignof(std::max_align_t));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+inline void resource_free(void* ctx, void* ptr, std::size_t size) {
+    static_cast<std::pmr::memory_resource*>(ctx)->deallocate(
+        ptr, size, alignof(std::max_align_t));
+}
+
+} // namespace detail
+
+/* The process-wide SlimLO instance (slimlo_init_ex / slimlo_destroy) */
+class Instance {
+public:
+    /* resource_path as for slimlo_init(); nullptr auto-detects */
+    explicit Instance(const char* resource_path = nullptr,
+                      const SlimLOInitOptions* options = nullptr)
+        : handle_(slimlo_init_ex(resource_path, options)) {
+        if (!handle_)
+            throw Error(SLIMLO_ERROR_INIT_FAILED, slimlo_get_error_message(nullptr));
+    }
+    explicit Instance(const std::string& resource_path,
+                      const SlimLOInitOptions* options = nullptr)
+        : Instance(resource_path.c_str(), options) {}
+
+    Instance(Instance&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    Instance& operator=(Instance&& other) noexcept {
+        if (this != &other) {
+            slimlo_destroy(handle_);
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    Instance(const Instance&) = delete;
+    Instance& operator=(const Instance&) = delete;
+    ~Instance() { slimlo_destroy(handle_); }
+
+    /* For the C calls not wrapped here (info, render, callbacks, combine) */
+    SlimLOHandle native_handle() const noexcept { return handle_; }
+
+    void convert_file(const std::string& input_path, const std::string& output_path,
+                      SlimLOFormat format_hint = SLIMLO_FORMAT_UNKNOWN,
+                      const SlimLOPdfOptions* options = nullptr) {
+        check(slimlo_convert_file(handle_, input_path.c_str(), output_path.c_str(),
+                                  format_hint, options));
+    }
+
+    /* Convert a document in memory; the PDF is allocated from resource */
+    Buffer convert(std::span<const std::byte> input,
+                   SlimLOFormat format_hint = SLIMLO_FORMAT_DOCX,
+                   const SlimLOPdfOptions* options = nullptr,
+                   std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+        SlimLOAllocator allocator = {
+            detail::resource_alloc, nullptr, detail::resource_free, resource
+        };
+        uint8_t* data = nullptr;
+        std::size_t size = 0;
+        check(slimlo_convert_buffer_alloc(
+            handle_, reinterpret_cast<const uint8_t*>(input.data()), input.size(),
+            format_hint, options, &allocator, &data, &size));
+        return Buffer(reinterpret_cast<std::byte*>(data), size, resource);
+    }
+
+    Buffer convert(std::span<const uint8_t> input,
+                   SlimLOFormat format_hint = SLIMLO_FORMAT_DOCX,
+                   const SlimLOPdfOptions* options = nullptr,
+                   std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+        return convert(std::as_bytes(input), format_hint, options, resource);
+    }
+
+private:
+    void check(SlimLOError err) const {
+        if (err != SLIMLO_OK) throw Error(err, slimlo_get_error_message(handle_));
+    }
+
+    SlimLOHandle handle_;
+};
+
+} // namespace slimlo
+
+#endif /* SLIMLO_HPP */
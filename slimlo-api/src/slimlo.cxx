@@ -12,21 +12,36 @@
 
 #include "slimlo.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <mutex>
+#include <new>
 #include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/types.h>
+#include <sys/stat.h>
 
 #ifdef _WIN32
   #include <windows.h>
 #else
-  #include <sys/stat.h>
   #include <unistd.h>
   #include <ftw.h>
 #endif
 
+// Progress callbacks, part counts, page rectangles and tile painting are only
+// declared with the unstable LOKit API enabled
+#ifndef LOK_USE_UNSTABLE_API
+#define LOK_USE_UNSTABLE_API
+#endif
+
 // LibreOfficeKit C++ header (thin wrapper over the C API)
 #include <LibreOfficeKit/LibreOfficeKit.hxx>
+#include <LibreOfficeKit/LibreOfficeKitEnums.h>
 
 // Version info (set at build time)
 #ifndef SLIMLO_VERSION
@@ -47,6 +62,24 @@ struct SlimLOInstance {
     std::string  profile_path;   // temp profile dir, cleaned up on destroy
     std::string  last_error;
     std::mutex   convert_mutex;  // LibreOffice is single-threaded
+
+    // Progress reporting (guarded by convert_mutex while converting)
+    SlimLOProgressCallback progress_cb = nullptr;
+    void*                  progress_data = nullptr;
+    SlimLOProgress         progress = {};
+    bool                   office_callback_registered = false;
+
+    // Page images rendered alongside conversions (guarded by convert_mutex)
+    SlimLOPageImageCallback page_image_cb = nullptr;
+    void*                   page_image_data = nullptr;
+    SlimLORenderOptions     render_options = {};
+    std::string             render_page_range;
+
+    // Page text reported after export (guarded by convert_mutex)
+    SlimLOPageTextCallback page_text_cb = nullptr;
+    void*                  page_text_data = nullptr;
+    SlimLOTextOptions      text_options = {};
+    std::string            text_page_range;
 };
 
 // Thread-local error message for pre-init errors
@@ -141,6 +174,79 @@ static void remove_directory_recursive(const std::string& path) {
 }
 #endif
 
+// ---------------------------------------------------------------------------
+// Progress reporting
+// ---------------------------------------------------------------------------
+
+static void emit_progress(SlimLOHandle handle) {
+    if (handle->progress_cb)
+        handle->progress_cb(&handle->progress, handle->progress_data);
+}
+
+// Start a new phase (always reported)
+static void progress_phase(SlimLOHandle handle, SlimLOProgressPhase phase, int percent) {
+    if (!handle->progress_cb) return;
+    handle->progress.phase = phase;
+    handle->progress.percent = percent;
+    emit_progress(handle);
+}
+
+// Update the percentage within the current phase (reported on change only)
+static void progress_percent(SlimLOHandle handle, int percent) {
+    if (!handle->progress_cb || handle->progress.phase == 0) return;
+    if (percent < 0) percent = 0;
+    if (percent > 100) percent = 100;
+    if (percent == handle->progress.percent) return;
+
+    handle->progress.percent = percent;
+    if (handle->progress.phase == SLIMLO_PROGRESS_EXPORT)
+        handle->progress.pages_exported = handle->progress.pages_laid_out * percent / 100;
+    emit_progress(handle);
+}
+
+static void progress_reset(SlimLOHandle handle) {
+    handle->progress = SlimLOProgress{};
+}
+
+// LOKit office-level callback. During load and export, LibreOffice drives its
+// status indicator, which LOKit forwards as STATUS_INDICATOR_* events.
+static void office_callback(int type, const char* payload, void* data) {
+    auto* handle = static_cast<SlimLOHandle>(data);
+    switch (type) {
+        case LOK_CALLBACK_STATUS_INDICATOR_START:
+            progress_percent(handle, 0);
+            break;
+        case LOK_CALLBACK_STATUS_INDICATOR_SET_VALUE:
+            if (payload) progress_percent(handle, atoi(payload));
+            break;
+        case LOK_CALLBACK_STATUS_INDICATOR_FINISH:
+            progress_percent(handle, 100);
+            break;
+        default:
+            break;
+    }
+}
+
+// Report the page count once the document is loaded and laid out
+static void progress_loaded(SlimLOHandle handle, lok::Document* doc) {
+    if (!handle->progress_cb) return;
+    handle->progress.pages_laid_out = doc->getParts();
+    progress_phase(handle, SLIMLO_PROGRESS_LAYOUT, 100);
+}
+
+static void progress_done(SlimLOHandle handle, uint64_t bytes_written) {
+    if (!handle->progress_cb) return;
+    handle->progress.pages_exported = handle->progress.pages_laid_out;
+    handle->progress.bytes_written = bytes_written;
+    progress_phase(handle, SLIMLO_PROGRESS_DONE, 100);
+}
+
+static uint64_t file_size_of(const char* path) {
+    struct stat st;
+    if (stat(path, &st) != 0) return 0;
+    return static_cast<uint64_t>(st.st_size);
+}
+
 // Map SlimLOFormat to LOKit format string (file extension, not filter name)
 // LOKit's saveAs() maps extensions to internal filter names via aWriterExtensionMap etc.
 static const char* get_pdf_filter(SlimLOFormat format) {
@@ -156,48 +262,778 @@ static const char* get_format_string(SlimLOFormat format) {
     }
 }
 
-// Build PDF filter options string from SlimLOPdfOptions
-static std::string build_filter_options(const SlimLOPdfOptions* options) {
+// Ordered list of PDF filter properties. Later set() calls replace the value
+// of an existing key in place, so presets can be overridden field by field.
+class FilterProps {
+public:
+    void set(const std::string& key, const std::string& value) {
+        for (auto& kv : props_) {
+            if (kv.first == key) {
+                kv.second = value;
+                return;
+            }
+        }
+        props_.emplace_back(key, value);
+    }
+
+    void set(const std::string& key, int value) { set(key, std::to_string(value)); }
+    void set(const std::string& key, bool value) { set(key, std::string(value ? "true" : "false")); }
+    void set(const std::string& key, const char* value) { set(key, std::string(value)); }
+
+    // Parse a raw "Key=Value,Key2=Value2" string. Entries without '=' are ignored.
+    void merge_raw(const char* raw) {
+        if (!raw) return;
+        const char* p = raw;
+        while (*p) {
+            const char* end = strchr(p, ',');
+            size_t len = end ? static_cast<size_t>(end - p) : strlen(p);
+            std::string entry(p, len);
+            size_t eq = entry.find('=');
+            if (eq != std::string::npos && eq > 0)
+                set(entry.substr(0, eq), entry.substr(eq + 1));
+            if (!end) break;
+            p = end + 1;
+        }
+    }
+
+    std::string str() const {
+        std::string opts;
+        for (const auto& kv : props_) {
+            if (!opts.empty()) opts += ",";
+            opts += kv.first + "=" + kv.second;
+        }
+        return opts;
+    }
+
+private:
+    std::vector<std::pair<std::string, std::string>> props_;
+};
+
+// Seed filter properties for a named preset (see SlimLOPdfPreset in slimlo.h)
+static void apply_preset(FilterProps& props, SlimLOPdfPreset preset) {
+    switch (preset) {
+        case SLIMLO_PRESET_FAST:
+            props.set("ExportBookmarks", false);
+            props.set("ExportNotes", false);
+            props.set("ExportFormFields", false);
+            props.set("UseTaggedPDF", false);
+            props.set("ReduceImageResolution", false);
+            props.set("UseLosslessCompression", false);
+            props.set("EmbedStandardFonts", false);
+            break;
+        case SLIMLO_PRESET_SMALL:
+            props.set("ExportNotes", false);
+            props.set("ExportFormFields", false);
+            props.set("UseLosslessCompression", false);
+            props.set("Quality", 60);
+            props.set("ReduceImageResolution", true);
+            props.set("MaxImageResolution", 150);
+            props.set("EmbedStandardFonts", false);
+            break;
+        case SLIMLO_PRESET_ARCHIVAL:
+            props.set("SelectPdfVersion", static_cast<int>(SLIMLO_PDF_A2));
+            props.set("UseTaggedPDF", true);
+            props.set("ExportBookmarks", true);
+            props.set("EmbedStandardFonts", true);
+            break;
+        case SLIMLO_PRESET_PRINT:
+            props.set("ExportBookmarks", false);
+            props.set("ExportNotes", false);
+            props.set("ExportFormFields", false);
+            props.set("UseLosslessCompression", true);
+            props.set("ReduceImageResolution", false);
+            props.set("EmbedStandardFonts", true);
+            break;
+        default:
+            break;
+    }
+}
+
+// Highest page a bounded page range ("1", "1-3", "2-4,7") asks for, so layout
+// can stop there. Returns 0 for open ranges ("2-") and anything unparsed.
+static int last_page_of_range(const char* range) {
+    int last_page = 0;
+    const char* p = range;
+    while (p && *p) {
+        while (*p == ' ') ++p;
+        char* end = nullptr;
+        long first = strtol(p, &end, 10);
+        if (end == p || first < 1) return 0;
+        long last = first;
+        p = end;
+        while (*p == ' ') ++p;
+        if (*p == '-') {
+            ++p;
+            while (*p == ' ') ++p;
+            last = strtol(p, &end, 10);
+            if (end == p || last < first) return 0;  // open range: "2-"
+            p = end;
+        }
+        if (last > 65535) return 0;
+        if (last > last_page) last_page = static_cast<int>(last);
+        while (*p == ' ') ++p;
+        if (*p == ',') ++p;
+        else if (*p) return 0;
+    }
+    return last_page;
+}
+
+// Build PDF filter options string from SlimLOPdfOptions.
+// Precedence: preset < explicit fields < raw filter_options.
+// part_bookmarks: a combined document carries per-part outline entries, so
+// keep the outline even under presets that drop it.
+static std::string build_filter_options(const SlimLOPdfOptions* options,
+                                        bool part_bookmarks = false) {
     if (!options) return "";
 
-    std::string opts;
+    FilterProps props;
+    apply_preset(props, options->preset);
+
+    if (part_bookmarks) {
+        props.set("ExportBookmarks", true);
+    }
 
     if (options->pdf_version != SLIMLO_PDF_DEFAULT) {
         // Map to SelectPdfVersion values:
         // 0 = PDF 1.7, 1 = PDF/A-1, 2 = PDF/A-2, 3 = PDF/A-3
-        if (!opts.empty()) opts += ",";
-        opts += "SelectPdfVersion=" + std::to_string(static_cast<int>(options->pdf_version));
+        props.set("SelectPdfVersion", static_cast<int>(options->pdf_version));
     }
 
     if (options->jpeg_quality > 0 && options->jpeg_quality <= 100) {
-        if (!opts.empty()) opts += ",";
-        opts += "Quality=" + std::to_string(options->jpeg_quality);
+        props.set("Quality", options->jpeg_quality);
     }
 
     if (options->dpi > 0) {
-        if (!opts.empty()) opts += ",";
-        opts += "MaxImageResolution=" + std::to_string(options->dpi);
+        props.set("MaxImageResolution", options->dpi);
     }
 
     if (options->tagged_pdf) {
-        if (!opts.empty()) opts += ",";
-        opts += "UseTaggedPDF=true";
+        props.set("UseTaggedPDF", true);
     }
 
     if (options->page_range && options->page_range[0] != '\0') {
-        if (!opts.empty()) opts += ",";
-        opts += "PageRange=";
-        opts += options->page_range;
+        props.set("PageRange", options->page_range);
+
+        // Stop Writer's layout at the last requested page (patch 034)
+        int layout_pages = options->lazy_layout ? last_page_of_range(options->page_range) : 0;
+        if (layout_pages > 0)
+            props.set("SlimLOLayoutPages", layout_pages);
+    }
+
+    if (options->skip_field_update) {
+        props.set("SlimLOSkipFieldUpdate", true);  // patch 035
     }
 
-    return opts;
+    props.merge_raw(options->filter_options);
+
+    return props.str();
+}
+
+static void append_json_string(std::string& out, const char* s) {
+    out += '"';
+    for (const char* p = s; *p; ++p) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else if (c < 0x20) {
+            char esc[8];
+            snprintf(esc, sizeof(esc), "\\u%04x", c);
+            out += esc;
+        } else {
+            out += static_cast<char>(c);
+        }
+    }
+    out += '"';
+}
+
+// JSON load options for documentLoad / documentLoadFromBuffer, in the
+// {"Name":{"type":...,"value":...}} form. Empty when nothing is set.
+static std::string build_load_options(const SlimLOPdfOptions* options) {
+    if (!options) return "";
+
+    std::string json;
+    if (options->password && options->password[0] != '\0') {
+        json += "\"Password\":{\"type\":\"string\",\"value\":";
+        append_json_string(json, options->password);
+        json += "}";
+    }
+    if (options->skip_field_update) {
+        // Keep linked content as stored (patch 035: UpdateDocMode=NO_UPDATE)
+        if (!json.empty()) json += ",";
+        json += "\"SlimLOSkipUpdate\":{\"type\":\"boolean\",\"value\":\"true\"}";
+    }
+    return json.empty() ? json : "{" + json + "}";
+}
+
+// ---------------------------------------------------------------------------
+// Document info
+// ---------------------------------------------------------------------------
+
+static char* dup_string(const std::string& s) {
+    char* copy = static_cast<char*>(malloc(s.size() + 1));
+    if (copy) memcpy(copy, s.c_str(), s.size() + 1);
+    return copy;
+}
+
+static char** dup_string_array(const std::vector<std::string>& strings) {
+    if (strings.empty()) return nullptr;
+    auto** arr = static_cast<char**>(calloc(strings.size(), sizeof(char*)));
+    if (!arr) return nullptr;
+    for (size_t i = 0; i < strings.size(); ++i)
+        arr[i] = dup_string(strings[i]);
+    return arr;
+}
+
+static void free_string_array(char** arr, int count) {
+    if (!arr) return;
+    for (int i = 0; i < count; ++i) free(arr[i]);
+    free(arr);
+}
+
+// Parse getPartPageRectangles() output: "x, y, w, h; x, y, w, h; ..." in
+// twips. Returns the flat list of numbers, four per page.
+static std::vector<long> parse_rectangle_values(const char* rects) {
+    std::vector<long> values;
+    for (const char* p = rects; p && *p;) {
+        char* end = nullptr;
+        long v = strtol(p, &end, 10);
+        if (end == p) {
+            ++p;
+            continue;
+        }
+        values.push_back(v);
+        p = end;
+    }
+    return values;
+}
+
+// One size per page, in points
+static std::vector<SlimLOPageSize> parse_page_rectangles(const char* rects) {
+    std::vector<long> values = parse_rectangle_values(rects);
+
+    std::vector<SlimLOPageSize> pages;
+    for (size_t i = 0; i + 3 < values.size(); i += 4)
+        pages.push_back(SlimLOPageSize{ values[i + 2] / 20.0, values[i + 3] / 20.0 });
+    return pages;
+}
+
+// Fill info from a loaded document. The LOKit getDocumentInfo() query
+// (patches/032) finishes layout first, so the page rectangles read
+// afterwards cover the whole document.
+static SlimLOError collect_document_info(SlimLOHandle handle, lok::Document* doc,
+                                         SlimLODocumentInfo* info) {
+    char* stats = doc->getDocumentInfo();
+    if (!stats) {
+        const char* err = handle->office->getError();
+        set_error(handle, err && err[0] ? err : "Failed to query document info");
+        return SLIMLO_ERROR_LOAD_FAILED;
+    }
+
+    // Tab-separated lines: "pages\tN", ..., "font\t<1|0>\t<family>"
+    std::vector<std::string> fonts;
+    std::vector<std::string> missing;
+    for (const char* line = stats; *line;) {
+        const char* eol = strchr(line, '\n');
+        std::string entry(line, eol ? static_cast<size_t>(eol - line) : strlen(line));
+        size_t tab = entry.find('\t');
+        if (tab != std::string::npos) {
+            std::string key = entry.substr(0, tab);
+            std::string value = entry.substr(tab + 1);
+            if (key == "pages") info->page_count = atoi(value.c_str());
+            else if (key == "sections") info->section_count = atoi(value.c_str());
+            else if (key == "images") info->image_count = atoi(value.c_str());
+            else if (key == "words") info->word_count = atoi(value.c_str());
+            else if (key == "font" && value.size() > 2 && value[1] == '\t') {
+                fonts.push_back(value.substr(2));
+                if (value[0] == '0') missing.push_back(value.substr(2));
+            }
+        }
+        if (!eol) break;
+        line = eol + 1;
+    }
+    free(stats);
+
+    char* rects = doc->getPartPageRectangles();
+    std::vector<SlimLOPageSize> pages = parse_page_rectangles(rects);
+    free(rects);
+
+    if (info->page_count <= 0)
+        info->page_count = static_cast<int>(pages.size());
+    if (!pages.empty()) {
+        pages.resize(static_cast<size_t>(info->page_count), pages.back());
+        info->pages = static_cast<SlimLOPageSize*>(
+            malloc(pages.size() * sizeof(SlimLOPageSize)));
+        if (info->pages)
+            memcpy(info->pages, pages.data(), pages.size() * sizeof(SlimLOPageSize));
+    }
+
+    info->fonts = dup_string_array(fonts);
+    info->font_count = info->fonts ? static_cast<int>(fonts.size()) : 0;
+    info->missing_fonts = dup_string_array(missing);
+    info->missing_font_count = info->missing_fonts ? static_cast<int>(missing.size()) : 0;
+
+    if ((!pages.empty() && !info->pages) ||
+        (!fonts.empty() && !info->fonts) ||
+        (!missing.empty() && !info->missing_fonts)) {
+        set_error(handle, "Out of memory");
+        return SLIMLO_ERROR_OUT_OF_MEMORY;
+    }
+    return SLIMLO_OK;
+}
+
+// ---------------------------------------------------------------------------
+// Page rendering
+// ---------------------------------------------------------------------------
+
+static const int kDefaultRenderWidth = 256;
+static const int kMaxRenderWidth = 8192;
+
+// Parse a page selection ("1", "1-3,5", "2-") against page_count pages.
+// Returns false on a syntax error. Pages past page_count are dropped;
+// NULL or empty selects the first page.
+static bool parse_page_selection(const char* range, int page_count, std::vector<int>& pages) {
+    pages.clear();
+    if (!range || !range[0]) {
+        if (page_count > 0) pages.push_back(1);
+        return true;
+    }
+
+    std::vector<bool> selected(static_cast<size_t>(page_count > 0 ? page_count : 0), false);
+    const char* p = range;
+    while (*p) {
+        while (*p == ' ') ++p;
+        char* end = nullptr;
+        long first = strtol(p, &end, 10);
+        if (end == p || first < 1) return false;
+        long last = first;
+        p = end;
+        while (*p == ' ') ++p;
+        if (*p == '-') {
+            ++p;
+            while (*p == ' ') ++p;
+            if (*p == ',' || *p == '\0') {
+                last = page_count;  // open range: "2-"
+            } else {
+                last = strtol(p, &end, 10);
+                if (end == p || last < first) return false;
+                p = end;
+            }
+        }
+        for (long n = first; n <= last && n <= page_count; ++n)
+            selected[static_cast<size_t>(n - 1)] = true;
+        while (*p == ' ') ++p;
+        if (*p == ',') ++p;
+        else if (*p) return false;
+    }
+
+    for (int n = 1; n <= page_count; ++n)
+        if (selected[static_cast<size_t>(n - 1)]) pages.push_back(n);
+    return true;
+}
+
+static bool validate_render_options(SlimLOHandle handle, const SlimLORenderOptions* options) {
+    if (!options) return true;
+    if (options->format != SLIMLO_IMAGE_PNG && options->format != SLIMLO_IMAGE_RGBA) {
+        set_error(handle, "Unsupported image format");
+        return false;
+    }
+    if (options->width < 0 || options->width > kMaxRenderWidth) {
+        set_error(handle, "Render width must be between 1 and 8192 pixels");
+        return false;
+    }
+    std::vector<int> unused;
+    if (!parse_page_selection(options->page_range, 1, unused)) {
+        set_error(handle, std::string("Invalid page range: ") + options->page_range);
+        return false;
+    }
+    return true;
+}
+
+// Minimal PNG writer. Rows use the "Up" filter, which turns the large
+// uniform areas of a page into zero runs, and the deflate stream uses fixed
+// Huffman codes with distance-1 matches only (zlib's Z_RLE strategy). That
+// keeps page thumbnails small without pulling in zlib.
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+    void put(uint32_t value, int count) {
+        bits_ |= value << bit_count_;
+        bit_count_ += count;
+        while (bit_count_ >= 8) {
+            out_.push_back(static_cast<uint8_t>(bits_));
+            bits_ >>= 8;
+            bit_count_ -= 8;
+        }
+    }
+
+    // Huffman codes are stored most significant bit first
+    void put_code(uint32_t code, int length) {
+        uint32_t reversed = 0;
+        for (int i = 0; i < length; ++i)
+            reversed |= ((code >> i) & 1u) << (length - 1 - i);
+        put(reversed, length);
+    }
+
+    void flush() {
+        if (bit_count_ > 0) out_.push_back(static_cast<uint8_t>(bits_));
+        bits_ = 0;
+        bit_count_ = 0;
+    }
+
+private:
+    std::vector<uint8_t>& out_;
+    uint32_t bits_ = 0;
+    int bit_count_ = 0;
+};
+
+static void put_fixed_literal(BitWriter& bw, int symbol) {
+    if (symbol < 144) bw.put_code(0x30 + symbol, 8);
+    else if (symbol < 256) bw.put_code(0x190 + symbol - 144, 9);
+    else if (symbol < 280) bw.put_code(symbol - 256, 7);
+    else bw.put_code(0xC0 + symbol - 280, 8);
+}
+
+static void put_run(BitWriter& bw, int length) {
+    static const int kBase[] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    static const int kExtra[] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                  3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    int code = 28;
+    while (kBase[code] > length) --code;
+    put_fixed_literal(bw, 257 + code);
+    if (kExtra[code]) bw.put(static_cast<uint32_t>(length - kBase[code]), kExtra[code]);
+    bw.put_code(0, 5);  // distance code 0: distance 1
+}
+
+static void deflate_rle(const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+    out.push_back(0x78);  // zlib header: deflate, 32K window
+    out.push_back(0x01);
+
+    BitWriter bw(out);
+    bw.put(1, 1);  // BFINAL
+    bw.put(1, 2);  // BTYPE = fixed Huffman
+    size_t i = 0;
+    while (i < in.size()) {
+        size_t run = 0;
+        if (i > 0) {
+            while (run < 258 && i + run < in.size() && in[i + run] == in[i - 1]) ++run;
+        }
+        if (run >= 3) {
+            put_run(bw, static_cast<int>(run));
+            i += run;
+        } else {
+            put_fixed_literal(bw, in[i]);
+            ++i;
+        }
+    }
+    put_fixed_literal(bw, 256);  // end of block
+    bw.flush();
+
+    uint32_t a = 1, b = 0;
+    for (uint8_t byte : in) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    uint32_t adler = (b << 16) | a;
+    for (int shift = 24; shift >= 0; shift -= 8)
+        out.push_back(static_cast<uint8_t>(adler >> shift));
+}
+
+static uint32_t png_crc(const uint8_t* data, size_t size, uint32_t crc = 0xFFFFFFFFu) {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[n] = c;
+        }
+        return t;
+    }();
+    for (size_t i = 0; i < size; ++i)
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+static void png_chunk(std::vector<uint8_t>& png, const char* type, const std::vector<uint8_t>& data) {
+    uint32_t len = static_cast<uint32_t>(data.size());
+    for (int shift = 24; shift >= 0; shift -= 8)
+        png.push_back(static_cast<uint8_t>(len >> shift));
+    size_t start = png.size();
+    png.insert(png.end(), type, type + 4);
+    png.insert(png.end(), data.begin(), data.end());
+    uint32_t crc = png_crc(png.data() + start, png.size() - start) ^ 0xFFFFFFFFu;
+    for (int shift = 24; shift >= 0; shift -= 8)
+        png.push_back(static_cast<uint8_t>(crc >> shift));
+}
+
+static void encode_png(const uint8_t* rgba, int width, int height, std::vector<uint8_t>& png) {
+    static const uint8_t kSignature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    png.assign(kSignature, kSignature + sizeof(kSignature));
+
+    std::vector<uint8_t> ihdr = {
+        static_cast<uint8_t>(width >> 24), static_cast<uint8_t>(width >> 16),
+        static_cast<uint8_t>(width >> 8), static_cast<uint8_t>(width),
+        static_cast<uint8_t>(height >> 24), static_cast<uint8_t>(height >> 16),
+        static_cast<uint8_t>(height >> 8), static_cast<uint8_t>(height),
+        8, 6, 0, 0, 0  // 8-bit RGBA, deflate, adaptive filtering, no interlace
+    };
+    png_chunk(png, "IHDR", ihdr);
+
+    size_t stride = static_cast<size_t>(width) * 4;
+    std::vector<uint8_t> filtered;
+    filtered.reserve((stride + 1) * static_cast<size_t>(height));
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* row = rgba + stride * static_cast<size_t>(y);
+        const uint8_t* prev = y > 0 ? row - stride : nullptr;
+        filtered.push_back(prev ? 2 : 0);  // Up, or None for the first row
+        for (size_t x = 0; x < stride; ++x)
+            filtered.push_back(static_cast<uint8_t>(row[x] - (prev ? prev[x] : 0)));
+    }
+
+    std::vector<uint8_t> idat;
+    deflate_rle(filtered, idat);
+    png_chunk(png, "IDAT", idat);
+    png_chunk(png, "IEND", std::vector<uint8_t>());
+}
+
+// Render the selected pages of a loaded document. on_image is called once per
+// page and returns false on allocation failure; image data is only valid
+// during the call.
+template <typename OnImage>
+static SlimLOError render_document(SlimLOHandle handle, lok::Document* doc,
+                                   const SlimLORenderOptions* options, OnImage on_image) {
+    SlimLOImageFormat format = options ? options->format : SLIMLO_IMAGE_PNG;
+    int width = options && options->width > 0 ? options->width : kDefaultRenderWidth;
+
+    doc->initializeForRendering(nullptr);
+
+    char* rects = doc->getPartPageRectangles();
+    std::vector<long> values = parse_rectangle_values(rects);
+    free(rects);
+
+    int page_count = static_cast<int>(values.size() / 4);
+    std::vector<int> pages;
+    if (!parse_page_selection(options ? options->page_range : nullptr, page_count, pages)) {
+        set_error(handle, "Invalid page range");
+        return SLIMLO_ERROR_INVALID_ARGUMENT;
+    }
+
+    bool bgra = doc->getTileMode() == LOK_TILEMODE_BGRA;
+    std::vector<uint8_t> pixels;
+    std::vector<uint8_t> png;
+    for (int page : pages) {
+        const long* rect = &values[static_cast<size_t>(page - 1) * 4];
+        long tile_width = rect[2], tile_height = rect[3];
+        if (tile_width <= 0 || tile_height <= 0) continue;
+
+        long height = (static_cast<long long>(width) * tile_height + tile_width / 2) / tile_width;
+        if (height < 1) height = 1;
+        if (height > 4L * kMaxRenderWidth) height = 4L * kMaxRenderWidth;
+
+        try {
+            pixels.assign(static_cast<size_t>(width) * static_cast<size_t>(height) * 4, 0);
+        } catch (const std::bad_alloc&) {
+            set_error(handle, "Out of memory");
+            return SLIMLO_ERROR_OUT_OF_MEMORY;
+        }
+        doc->paintTile(pixels.data(), width, static_cast<int>(height),
+                       static_cast<int>(rect[0]), static_cast<int>(rect[1]),
+                       static_cast<int>(tile_width), static_cast<int>(tile_height));
+
+        // LOKit paints premultiplied BGRA/RGBA; hand out straight RGBA
+        for (size_t i = 0; i < pixels.size(); i += 4) {
+            if (bgra) std::swap(pixels[i], pixels[i + 2]);
+            uint8_t alpha = pixels[i + 3];
+            if (alpha != 0 && alpha != 255) {
+                for (int c = 0; c < 3; ++c)
+                    pixels[i + c] = static_cast<uint8_t>(std::min(255, pixels[i + c] * 255 / alpha));
+            }
+        }
+
+        SlimLOPageImage image = {};
+        image.page = page;
+        image.width = width;
+        image.height = static_cast<int>(height);
+        image.format = format;
+        if (format == SLIMLO_IMAGE_PNG) {
+            try {
+                encode_png(pixels.data(), width, image.height, png);
+            } catch (const std::bad_alloc&) {
+                set_error(handle, "Out of memory");
+                return SLIMLO_ERROR_OUT_OF_MEMORY;
+            }
+            image.data = png.data();
+            image.size = png.size();
+        } else {
+            image.data = pixels.data();
+            image.size = pixels.size();
+        }
+
+        if (!on_image(image)) {
+            set_error(handle, "Out of memory");
+            return SLIMLO_ERROR_OUT_OF_MEMORY;
+        }
+    }
+    return SLIMLO_OK;
+}
+
+// Render side output for a conversion, if a page image callback is installed
+static SlimLOError render_side_output(SlimLOHandle handle, lok::Document* doc) {
+    if (!handle->page_image_cb) return SLIMLO_OK;
+    return render_document(handle, doc, &handle->render_options,
+        [handle](const SlimLOPageImage& image) {
+            handle->page_image_cb(&image, handle->page_image_data);
+            return true;
+        });
+}
+
+// Collect rendered pages into a malloc'ed array for slimlo_render_pages*()
+static SlimLOError render_to_array(SlimLOHandle handle, lok::Document* doc,
+                                   const SlimLORenderOptions* options,
+                                   SlimLOPageImage** images, int* image_count) {
+    std::vector<SlimLOPageImage> collected;
+    SlimLOError result = render_document(handle, doc, options,
+        [&collected](const SlimLOPageImage& image) {
+            SlimLOPageImage copy = image;
+            copy.data = static_cast<uint8_t*>(malloc(image.size));
+            if (!copy.data) return false;
+            memcpy(copy.data, image.data, image.size);
+            collected.push_back(copy);
+            return true;
+        });
+
+    if (result == SLIMLO_OK && !collected.empty()) {
+        *images = static_cast<SlimLOPageImage*>(
+            malloc(collected.size() * sizeof(SlimLOPageImage)));
+        if (*images) {
+            memcpy(*images, collected.data(), collected.size() * sizeof(SlimLOPageImage));
+            *image_count = static_cast<int>(collected.size());
+            return SLIMLO_OK;
+        }
+        set_error(handle, "Out of memory");
+        result = SLIMLO_ERROR_OUT_OF_MEMORY;
+    }
+
+    for (SlimLOPageImage& image : collected) free(image.data);
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Text extraction
+// ---------------------------------------------------------------------------
+
+// Undo the escaping of LOKit getPageText() fields: \\, \t and \n
+static std::string unescape_field(const char* begin, const char* end) {
+    std::string out;
+    out.reserve(static_cast<size_t>(end - begin));
+    for (const char* p = begin; p < end; ++p) {
+        if (*p == '\\' && p + 1 < end) {
+            ++p;
+            out += *p == 't' ? '\t' : *p == 'n' ? '\n' : *p;
+        } else {
+            out += *p;
+        }
+    }
+    return out;
+}
+
+// Report the text of the selected pages to the page text callback. Called
+// after export: layout is final then, so the page rectangles cover the whole
+// document and extraction adds no layout work.
+static SlimLOError text_side_output(SlimLOHandle handle, lok::Document* doc) {
+    if (!handle->page_text_cb) return SLIMLO_OK;
+    const SlimLOTextOptions& options = handle->text_options;
+
+    char* rects = doc->getPartPageRectangles();
+    std::vector<long> values = parse_rectangle_values(rects);
+    free(rects);
+
+    int page_count = static_cast<int>(values.size() / 4);
+    std::vector<int> pages;
+    parse_page_selection(options.page_range ? options.page_range : "1-", page_count, pages);
+
+    std::string text;
+    std::vector<std::string> word_text;
+    std::vector<SlimLOWordBox> words;
+    for (int page : pages) {
+        const long* rect = &values[static_cast<size_t>(page - 1) * 4];
+        char* reply = doc->getPageText(static_cast<int>(rect[0]), static_cast<int>(rect[1]),
+                                       static_cast<int>(rect[2]), static_cast<int>(rect[3]),
+                                       options.include_words != 0);
+        if (!reply) {
+            const char* err = handle->office->getError();
+            set_error(handle, err && err[0] ? err : "Failed to extract page text");
+            return SLIMLO_ERROR_EXPORT_FAILED;
+        }
+
+        // "text\t<text>" then "word\t<x>\t<y>\t<w>\t<h>\t<word>" lines, in twips
+        text.clear();
+        word_text.clear();
+        words.clear();
+        for (const char* line = reply; *line;) {
+            const char* eol = strchr(line, '\n');
+            if (!eol) eol = line + strlen(line);
+            if (strncmp(line, "text\t", 5) == 0) {
+                text = unescape_field(line + 5, eol);
+            } else if (strncmp(line, "word\t", 5) == 0) {
+                const char* p = line + 5;
+                double box[4] = {};
+                for (double& v : box) {
+                    char* end = nullptr;
+                    v = strtol(p, &end, 10) / 20.0;
+                    p = *end == '\t' ? end + 1 : end;
+                }
+                word_text.push_back(unescape_field(p, eol));
+                words.push_back(SlimLOWordBox{ box[0], box[1], box[2], box[3], nullptr });
+            }
+            if (!*eol) break;
+            line = eol + 1;
+        }
+        free(reply);
+
+        // word_text no longer grows, so its strings stay put
+        for (size_t i = 0; i < words.size(); ++i)
+            words[i].text = word_text[i].c_str();
+
+        SlimLOPageText page_text = {};
+        page_text.page = page;
+        page_text.size = SlimLOPageSize{ rect[2] / 20.0, rect[3] / 20.0 };
+        page_text.text = text.c_str();
+        page_text.words = words.empty() ? nullptr : words.data();
+        page_text.word_count = static_cast<int>(words.size());
+        handle->page_text_cb(&page_text, handle->page_text_data);
+    }
+    return SLIMLO_OK;
 }
 
 // ---------------------------------------------------------------------------
 // Public API
 // ---------------------------------------------------------------------------
 
+// Bound LibreOffice's internal parallelism before it starts. comphelper's
+// ThreadPool sizes itself from MAX_CONCURRENCY (default: one per core), and
+// the fast SAX parser reads large XML parts on a second thread unless
+// SAX_DISABLE_THREADS is set.
+static void apply_thread_budget(int threads) {
+    if (threads <= 0) return;
+    std::string count = std::to_string(threads);
+#ifdef _WIN32
+    _putenv_s("MAX_CONCURRENCY", count.c_str());
+    if (threads == 1) _putenv_s("SAX_DISABLE_THREADS", "1");
+#else
+    setenv("MAX_CONCURRENCY", count.c_str(), 1);
+    if (threads == 1) setenv("SAX_DISABLE_THREADS", "1", 1);
+#endif
+}
+
 SLIMLO_API SlimLOHandle slimlo_init(const char* resource_path) {
+    return slimlo_init_ex(resource_path, nullptr);
+}
+
+SLIMLO_API SlimLOHandle slimlo_init_ex(const char* resource_path,
+                                       const SlimLOInitOptions* options) {
     std::lock_guard<std::mutex> lock(g_init_mutex);
 
     if (g_initialized) {
@@ -210,6 +1046,12 @@ SLIMLO_API SlimLOHandle slimlo_init(const char* resource_path) {
         return nullptr;
     }
 
+    if (options && options->threads < 0) {
+        g_init_error = "threads must not be negative";
+        return nullptr;
+    }
+    apply_thread_budget(options ? options->threads : 0);
+
     // Initialize LibreOfficeKit
     // lok_cpp_init expects the path to the directory containing libmergedlo.
     // This differs by platform/layout:
@@ -347,31 +1189,40 @@ SLIMLO_API SlimLOError slimlo_convert_file(
     std::string input_url = path_to_url(input_path);
     std::string output_url = path_to_url(output_path);
 
-    // Handle password-protected documents
-    const char* load_options = nullptr;
-    std::string load_opts_str;
-    if (options && options->password && options->password[0] != '\0') {
-        load_opts_str = std::string("{\"Password\":{\"type\":\"string\",\"value\":\"")
-                        + options->password + "\"}}";
-        load_options = load_opts_str.c_str();
-    }
+    // Password and update-on-load settings
+    std::string load_opts_str = build_load_options(options);
+    const char* load_options = load_opts_str.empty() ? nullptr : load_opts_str.c_str();
 
     // Load document
+    progress_reset(handle);
+    progress_phase(handle, SLIMLO_PROGRESS_LOAD, 0);
     lok::Document* doc = handle->office->documentLoad(input_url.c_str(), load_options);
     if (!doc) {
         const char* err = handle->office->getError();
         set_error(handle, err ? err : "Failed to load document");
         return SLIMLO_ERROR_LOAD_FAILED;
     }
+    progress_loaded(handle, doc);
+
+    // Page images from the same load (slimlo_set_page_image_callback)
+    SlimLOError render_err = render_side_output(handle, doc);
+    if (render_err != SLIMLO_OK) {
+        delete doc;
+        return render_err;
+    }
 
     // Build filter options
     std::string filter_options = build_filter_options(options);
     const char* filter_name = get_pdf_filter(format_hint);
 
     // Export to PDF
+    progress_phase(handle, SLIMLO_PROGRESS_EXPORT, 0);
     bool success = doc->saveAs(output_url.c_str(), filter_name,
                                filter_options.empty() ? nullptr : filter_options.c_str());
 
+    // Page text from the same layout (slimlo_set_page_text_callback)
+    SlimLOError text_err = success ? text_side_output(handle, doc) : SLIMLO_OK;
+
     delete doc;
 
     if (!success) {
@@ -379,17 +1230,221 @@ SLIMLO_API SlimLOError slimlo_convert_file(
         set_error(handle, err ? err : "Failed to export PDF");
         return SLIMLO_ERROR_EXPORT_FAILED;
     }
+    if (text_err != SLIMLO_OK) return text_err;
 
+    progress_done(handle, file_size_of(output_path));
     handle->last_error.clear();
     return SLIMLO_OK;
 }
 
-SLIMLO_API SlimLOError slimlo_convert_buffer(
+SLIMLO_API SlimLOError slimlo_combine_to_pdf(
+    SlimLOHandle handle,
+    const SlimLOCombinePart* parts,
+    int part_count,
+    const char* output_path,
+    const SlimLOPdfOptions* options
+) {
+    if (!handle || !handle->office) {
+        set_error(handle, "Not initialized");
+        return SLIMLO_ERROR_NOT_INIT;
+    }
+    if (!parts || part_count < 1 || !output_path) {
+        set_error(handle, "parts, part_count and output_path are required");
+        return SLIMLO_ERROR_INVALID_ARGUMENT;
+    }
+    for (int i = 0; i < part_count; i++) {
+        if (!parts[i].input_path) {
+            set_error(handle, "Part " + std::to_string(i + 1) + ": input_path is required");
+            return SLIMLO_ERROR_INVALID_ARGUMENT;
+        }
+        if (!has_docx_extension(parts[i].input_path)) {
+            set_error(handle, "Part " + std::to_string(i + 1) +
+                      ": unsupported input format, only .docx files are supported");
+            return SLIMLO_ERROR_INVALID_FORMAT;
+        }
+    }
+
+    // Serialize — LibreOffice cannot do concurrent conversions
+    std::lock_guard<std::mutex> lock(handle->convert_mutex);
+
+    std::string output_url = path_to_url(output_path);
+    std::string load_opts_str = build_load_options(options);
+    const char* load_options = load_opts_str.empty() ? nullptr : load_opts_str.c_str();
+
+    // Load the first part; it provides the styles and page setup
+    progress_reset(handle);
+    progress_phase(handle, SLIMLO_PROGRESS_LOAD, 0);
+    std::string first_url = path_to_url(parts[0].input_path);
+    lok::Document* doc = handle->office->documentLoad(first_url.c_str(), load_options);
+    if (!doc) {
+        const char* err = handle->office->getError();
+        set_error(handle, std::string("Part 1: ") + (err ? err : "Failed to load document"));
+        return SLIMLO_ERROR_LOAD_FAILED;
+    }
+
+    // Append the others, each on a new page (patch 036: insertDocument).
+    // Part 1 goes through insertDocument with a null URL, which only places
+    // its outline bookmark at the start of the document.
+    for (int i = 0; i < part_count; i++) {
+        if (i == 0 && !parts[0].bookmark) continue;
+        std::string part_url = i == 0 ? std::string() : path_to_url(parts[i].input_path);
+        if (!doc->insertDocument(i == 0 ? nullptr : part_url.c_str(),
+                                 parts[i].bookmark, load_options)) {
+            const char* err = handle->office->getError();
+            set_error(handle, "Part " + std::to_string(i + 1) + ": " +
+                      (err ? err : "Failed to insert document"));
+            delete doc;
+            return SLIMLO_ERROR_LOAD_FAILED;
+        }
+        progress_percent(handle, (i + 1) * 100 / part_count);
+    }
+    progress_loaded(handle, doc);
+
+    // Page images from the combined document (slimlo_set_page_image_callback)
+    SlimLOError render_err = render_side_output(handle, doc);
+    if (render_err != SLIMLO_OK) {
+        delete doc;
+        return render_err;
+    }
+
+    // Export once
+    bool part_bookmarks = false;
+    for (int i = 0; i < part_count; i++)
+        part_bookmarks = part_bookmarks || parts[i].bookmark != nullptr;
+    std::string filter_options = build_filter_options(options, part_bookmarks);
+    progress_phase(handle, SLIMLO_PROGRESS_EXPORT, 0);
+    bool success = doc->saveAs(output_url.c_str(), get_pdf_filter(SLIMLO_FORMAT_DOCX),
+                               filter_options.empty() ? nullptr : filter_options.c_str());
+
+    // Page text from the same layout (slimlo_set_page_text_callback)
+    SlimLOError text_err = success ? text_side_output(handle, doc) : SLIMLO_OK;
+
+    delete doc;
+
+    if (!success) {
+        const char* err = handle->office->getError();
+        set_error(handle, err ? err : "Failed to export PDF");
+        return SLIMLO_ERROR_EXPORT_FAILED;
+    }
+    if (text_err != SLIMLO_OK) return text_err;
+
+    progress_done(handle, file_size_of(output_path));
+    handle->last_error.clear();
+    return SLIMLO_OK;
+}
+
+// Output of slimlo_convert_buffer_alloc(), filled by saveToCallback. With
+// allocator->realloc the PDF grows in one block, doubling, then is shrunk to
+// its size; without it, it is staged in chunks and copied once into a single
+// alloc. Anything still owned on destruction goes back to the allocator.
+struct OutputSink {
+    static constexpr size_t kChunkSize = 1 << 20;
+
+    explicit OutputSink(const SlimLOAllocator& a) : allocator(a) {}
+    OutputSink(const OutputSink&) = delete;
+    OutputSink& operator=(const OutputSink&) = delete;
+    ~OutputSink() {
+        // Parenthesized: CRT debug builds define realloc/free as macros
+        if (data) (allocator.free)(allocator.ctx, data, capacity);
+    }
+
+    static int write(void* user_data, const unsigned char* bytes, unsigned long n) {
+        auto* sink = static_cast<OutputSink*>(user_data);
+        if (!sink->failed && !sink->append(bytes, n)) sink->failed = true;
+        return sink->failed ? 0 : 1;
+    }
+
+    bool append(const unsigned char* bytes, size_t n) {
+        if (!allocator.realloc) {
+            while (n > 0) {
+                if (chunks.empty() || chunks.back().size() == kChunkSize) {
+                    chunks.emplace_back();
+                    chunks.back().reserve(kChunkSize);
+                }
+                size_t take = std::min(n, kChunkSize - chunks.back().size());
+                chunks.back().insert(chunks.back().end(), bytes, bytes + take);
+                bytes += take;
+                n -= take;
+                size += take;
+            }
+            return true;
+        }
+        if (n > capacity - size) {
+            size_t wanted = std::max({ size + n, capacity * 2, kChunkSize });
+            void* grown = data ? (allocator.realloc)(allocator.ctx, data, capacity, wanted)
+                               : (allocator.alloc)(allocator.ctx, wanted);
+            if (!grown) return false;
+            data = static_cast<uint8_t*>(grown);
+            capacity = wanted;
+        }
+        memcpy(data + size, bytes, n);
+        size += n;
+        return true;
+    }
+
+    // Leave exactly size bytes in one block from the allocator
+    bool finish() {
+        if (failed || size == 0) return false;
+        if (!allocator.realloc) {
+            data = static_cast<uint8_t*>((allocator.alloc)(allocator.ctx, size));
+            if (!data) {
+                failed = true;
+                return false;
+            }
+            capacity = size;
+            size_t offset = 0;
+            for (const auto& chunk : chunks) {
+                memcpy(data + offset, chunk.data(), chunk.size());
+                offset += chunk.size();
+            }
+            chunks.clear();
+            return true;
+        }
+        if (capacity != size) {
+            void* shrunk = (allocator.realloc)(allocator.ctx, data, capacity, size);
+            if (!shrunk) {
+                failed = true;
+                return false;
+            }
+            data = static_cast<uint8_t*>(shrunk);
+            capacity = size;
+        }
+        return true;
+    }
+
+    uint8_t* release() {
+        uint8_t* out = data;
+        data = nullptr;
+        return out;
+    }
+
+    const SlimLOAllocator& allocator;
+    uint8_t* data = nullptr;
+    size_t size = 0;
+    size_t capacity = 0;
+    std::vector<std::vector<uint8_t>> chunks;
+    bool failed = false;
+};
+
+// slimlo_convert_buffer(): malloc'ed output, released by slimlo_free_buffer().
+// realloc lets large PDFs grow without copying where the C library remaps.
+static void* malloc_alloc(void*, size_t size) { return malloc(size); }
+static void* malloc_realloc(void*, void* ptr, size_t, size_t new_size) {
+    return realloc(ptr, new_size);
+}
+static void malloc_free(void*, void* ptr, size_t) { free(ptr); }
+
+static const SlimLOAllocator kMallocAllocator = {
+    malloc_alloc, malloc_realloc, malloc_free, nullptr
+};
+
+SLIMLO_API SlimLOError slimlo_convert_buffer_alloc(
     SlimLOHandle handle,
     const uint8_t* input_data,
     size_t input_size,
     SlimLOFormat format_hint,
     const SlimLOPdfOptions* options,
+    const SlimLOAllocator* allocator,
     uint8_t** output_data,
     size_t* output_size
 ) {
@@ -405,6 +1460,10 @@ SLIMLO_API SlimLOError slimlo_convert_buffer(
         set_error(handle, "output_data and output_size are required");
         return SLIMLO_ERROR_INVALID_ARGUMENT;
     }
+    if (!allocator || !allocator->alloc || !allocator->free) {
+        set_error(handle, "allocator with alloc and free is required");
+        return SLIMLO_ERROR_INVALID_ARGUMENT;
+    }
     if (format_hint == SLIMLO_FORMAT_UNKNOWN) {
         set_error(handle, "format_hint is required for buffer conversion (DOCX only)");
         return SLIMLO_ERROR_INVALID_FORMAT;
@@ -427,16 +1486,13 @@ SLIMLO_API SlimLOError slimlo_convert_buffer(
         return SLIMLO_ERROR_INVALID_FORMAT;
     }
 
-    // Handle password-protected documents
-    const char* load_options = nullptr;
-    std::string load_opts_str;
-    if (options && options->password && options->password[0] != '\0') {
-        load_opts_str = std::string("{\"Password\":{\"type\":\"string\",\"value\":\"")
-                        + options->password + "\"}}";
-        load_options = load_opts_str.c_str();
-    }
+    // Password and update-on-load settings
+    std::string load_opts_str = build_load_options(options);
+    const char* load_options = load_opts_str.empty() ? nullptr : load_opts_str.c_str();
 
     // Load document from buffer (uses private:stream internally — no temp files)
+    progress_reset(handle);
+    progress_phase(handle, SLIMLO_PROGRESS_LOAD, 0);
     lok::Document* doc = handle->office->documentLoadFromBuffer(
         input_data, input_size, format_str, load_options);
     if (!doc) {
@@ -444,27 +1500,359 @@ SLIMLO_API SlimLOError slimlo_convert_buffer(
         set_error(handle, err ? err : "Failed to load document from buffer");
         return SLIMLO_ERROR_LOAD_FAILED;
     }
+    progress_loaded(handle, doc);
+
+    // Page images from the same load (slimlo_set_page_image_callback)
+    SlimLOError render_err = render_side_output(handle, doc);
+    if (render_err != SLIMLO_OK) {
+        delete doc;
+        return render_err;
+    }
 
     // Build filter options
     std::string filter_options = build_filter_options(options);
 
-    // Save to buffer (uses private:stream internally — no temp files)
-    unsigned char* pdf_buf = nullptr;
-    unsigned long pdf_size = 0;  // LOKit API uses unsigned long, not size_t
-    bool success = doc->saveToBuffer(&pdf_buf, &pdf_size, "pdf",
+    // Export through the caller's allocator (patch 037: saveToCallback;
+    // private:stream internally — no temp files, no intermediate buffer)
+    progress_phase(handle, SLIMLO_PROGRESS_EXPORT, 0);
+    OutputSink sink(*allocator);
+    bool success = doc->saveToCallback(OutputSink::write, &sink, "pdf",
         filter_options.empty() ? nullptr : filter_options.c_str());
+    success = success && sink.finish();
+
+    // Page text from the same layout (slimlo_set_page_text_callback)
+    SlimLOError text_err = success ? text_side_output(handle, doc) : SLIMLO_OK;
 
     delete doc;
 
-    if (!success || !pdf_buf) {
+    if (!success) {
+        if (sink.failed) {
+            set_error(handle, "Output allocator failed");
+            return SLIMLO_ERROR_OUT_OF_MEMORY;
+        }
         const char* err = handle->office->getError();
-        set_error(handle, err ? err : "Failed to export PDF to buffer");
-        free(pdf_buf);
+        set_error(handle, err && *err ? err : "Failed to export PDF to buffer");
         return SLIMLO_ERROR_EXPORT_FAILED;
     }
+    if (text_err != SLIMLO_OK) {
+        return text_err;
+    }
+
+    *output_data = sink.release();
+    *output_size = sink.size;
+    progress_done(handle, *output_size);
+    handle->last_error.clear();
+    return SLIMLO_OK;
+}
+
+SLIMLO_API SlimLOError slimlo_convert_buffer(
+    SlimLOHandle handle,
+    const uint8_t* input_data,
+    size_t input_size,
+    SlimLOFormat format_hint,
+    const SlimLOPdfOptions* options,
+    uint8_t** output_data,
+    size_t* output_size
+) {
+    return slimlo_convert_buffer_alloc(handle, input_data, input_size, format_hint,
+                                       options, &kMallocAllocator,
+                                       output_data, output_size);
+}
+
+SLIMLO_API SlimLOError slimlo_document_info(
+    SlimLOHandle handle,
+    const char* input_path,
+    SlimLODocumentInfo* info
+) {
+    if (info) memset(info, 0, sizeof(*info));
+
+    if (!handle || !handle->office) {
+        set_error(handle, "Not initialized");
+        return SLIMLO_ERROR_NOT_INIT;
+    }
+    if (!input_path || !info) {
+        set_error(handle, "input_path and info are required");
+        return SLIMLO_ERROR_INVALID_ARGUMENT;
+    }
+    if (!has_docx_extension(input_path)) {
+        set_error(handle, "Unsupported input format: only .docx files are supported");
+        return SLIMLO_ERROR_INVALID_FORMAT;
+    }
+
+    std::lock_guard<std::mutex> lock(handle->convert_mutex);
+
+    std::string input_url = path_to_url(input_path);
+    lok::Document* doc = handle->office->documentLoad(input_url.c_str(), nullptr);
+    if (!doc) {
+        const char* err = handle->office->getError();
+        set_error(handle, err ? err : "Failed to load document");
+        return SLIMLO_ERROR_LOAD_FAILED;
+    }
+
+    SlimLOError result = collect_document_info(handle, doc, info);
+    delete doc;
+
+    if (result != SLIMLO_OK) return result;
+    handle->last_error.clear();
+    return SLIMLO_OK;
+}
+
+SLIMLO_API SlimLOError slimlo_document_info_buffer(
+    SlimLOHandle handle,
+    const uint8_t* input_data,
+    size_t input_size,
+    SlimLOFormat format_hint,
+    SlimLODocumentInfo* info
+) {
+    if (info) memset(info, 0, sizeof(*info));
+
+    if (!handle || !handle->office) {
+        set_error(handle, "Not initialized");
+        return SLIMLO_ERROR_NOT_INIT;
+    }
+    if (!input_data || input_size == 0 || !info) {
+        set_error(handle, "input_data, input_size and info are required");
+        return SLIMLO_ERROR_INVALID_ARGUMENT;
+    }
+    const char* format_str = get_format_string(format_hint);
+    if (!format_str) {
+        set_error(handle, "Unsupported format_hint: buffer input supports DOCX only");
+        return SLIMLO_ERROR_INVALID_FORMAT;
+    }
+
+    std::lock_guard<std::mutex> lock(handle->convert_mutex);
+
+    lok::Document* doc = handle->office->documentLoadFromBuffer(
+        input_data, input_size, format_str, nullptr);
+    if (!doc) {
+        const char* err = handle->office->getError();
+        set_error(handle, err ? err : "Failed to load document from buffer");
+        return SLIMLO_ERROR_LOAD_FAILED;
+    }
+
+    SlimLOError result = collect_document_info(handle, doc, info);
+    delete doc;
+
+    if (result != SLIMLO_OK) return result;
+    handle->last_error.clear();
+    return SLIMLO_OK;
+}
+
+SLIMLO_API void slimlo_free_document_info(SlimLODocumentInfo* info) {
+    if (!info) return;
+    free(info->pages);
+    free_string_array(info->fonts, info->font_count);
+    free_string_array(info->missing_fonts, info->missing_font_count);
+    memset(info, 0, sizeof(*info));
+}
+
+SLIMLO_API SlimLOError slimlo_render_pages(
+    SlimLOHandle handle,
+    const char* input_path,
+    const SlimLORenderOptions* options,
+    SlimLOPageImage** images,
+    int* image_count
+) {
+    if (images) *images = nullptr;
+    if (image_count) *image_count = 0;
+
+    if (!handle || !handle->office) {
+        set_error(handle, "Not initialized");
+        return SLIMLO_ERROR_NOT_INIT;
+    }
+    if (!input_path || !images || !image_count) {
+        set_error(handle, "input_path, images and image_count are required");
+        return SLIMLO_ERROR_INVALID_ARGUMENT;
+    }
+    if (!has_docx_extension(input_path)) {
+        set_error(handle, "Unsupported input format: only .docx files are supported");
+        return SLIMLO_ERROR_INVALID_FORMAT;
+    }
+    if (!validate_render_options(handle, options))
+        return SLIMLO_ERROR_INVALID_ARGUMENT;
+
+    std::lock_guard<std::mutex> lock(handle->convert_mutex);
+
+    std::string input_url = path_to_url(input_path);
+    lok::Document* doc = handle->office->documentLoad(input_url.c_str(), nullptr);
+    if (!doc) {
+        const char* err = handle->office->getError();
+        set_error(handle, err ? err : "Failed to load document");
+        return SLIMLO_ERROR_LOAD_FAILED;
+    }
+
+    SlimLOError result = render_to_array(handle, doc, options, images, image_count);
+    delete doc;
+
+    if (result != SLIMLO_OK) return result;
+    handle->last_error.clear();
+    return SLIMLO_OK;
+}
+
+SLIMLO_API SlimLOError slimlo_render_pages_buffer(
+    SlimLOHandle handle,
+    const uint8_t* input_data,
+    size_t input_size,
+    SlimLOFormat format_hint,
+    const SlimLORenderOptions* options,
+    SlimLOPageImage** images,
+    int* image_count
+) {
+    if (images) *images = nullptr;
+    if (image_count) *image_count = 0;
+
+    if (!handle || !handle->office) {
+        set_error(handle, "Not initialized");
+        return SLIMLO_ERROR_NOT_INIT;
+    }
+    if (!input_data || input_size == 0 || !images || !image_count) {
+        set_error(handle, "input_data, input_size, images and image_count are required");
+        return SLIMLO_ERROR_INVALID_ARGUMENT;
+    }
+    const char* format_str = get_format_string(format_hint);
+    if (!format_str) {
+        set_error(handle, "Unsupported format_hint: buffer input supports DOCX only");
+        return SLIMLO_ERROR_INVALID_FORMAT;
+    }
+    if (!validate_render_options(handle, options))
+        return SLIMLO_ERROR_INVALID_ARGUMENT;
+
+    std::lock_guard<std::mutex> lock(handle->convert_mutex);
+
+    lok::Document* doc = handle->office->documentLoadFromBuffer(
+        input_data, input_size, format_str, nullptr);
+    if (!doc) {
+        const char* err = handle->office->getError();
+        set_error(handle, err ? err : "Failed to load document from buffer");
+        return SLIMLO_ERROR_LOAD_FAILED;
+    }
+
+    SlimLOError result = render_to_array(handle, doc, options, images, image_count);
+    delete doc;
+
+    if (result != SLIMLO_OK) return result;
+    handle->last_error.clear();
+    return SLIMLO_OK;
+}
+
+SLIMLO_API void slimlo_free_page_images(SlimLOPageImage* images, int count) {
+    if (!images) return;
+    for (int i = 0; i < count; ++i) free(images[i].data);
+    free(images);
+}
+
+SLIMLO_API SlimLOError slimlo_set_page_image_callback(
+    SlimLOHandle handle,
+    const SlimLORenderOptions* options,
+    SlimLOPageImageCallback callback,
+    void* user_data
+) {
+    if (!handle || !handle->office) {
+        set_error(handle, "Not initialized");
+        return SLIMLO_ERROR_NOT_INIT;
+    }
+    if (callback && !validate_render_options(handle, options))
+        return SLIMLO_ERROR_INVALID_ARGUMENT;
+
+    std::lock_guard<std::mutex> lock(handle->convert_mutex);
+
+    handle->page_image_cb = callback;
+    handle->page_image_data = user_data;
+    handle->render_options = SlimLORenderOptions{};
+    handle->render_page_range.clear();
+    if (callback && options) {
+        handle->render_options = *options;
+        if (options->page_range) {
+            handle->render_page_range = options->page_range;
+            handle->render_options.page_range = handle->render_page_range.c_str();
+        }
+    }
+    return SLIMLO_OK;
+}
+
+SLIMLO_API SlimLOError slimlo_set_page_text_callback(
+    SlimLOHandle handle,
+    const SlimLOTextOptions* options,
+    SlimLOPageTextCallback callback,
+    void* user_data
+) {
+    if (!handle || !handle->office) {
+        set_error(handle, "Not initialized");
+        return SLIMLO_ERROR_NOT_INIT;
+    }
+    std::vector<int> unused;
+    if (callback && options && !parse_page_selection(options->page_range, 1, unused)) {
+        set_error(handle, std::string("Invalid page range: ") + options->page_range);
+        return SLIMLO_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::lock_guard<std::mutex> lock(handle->convert_mutex);
+
+    handle->page_text_cb = callback;
+    handle->page_text_data = user_data;
+    handle->text_options = SlimLOTextOptions{};
+    handle->text_page_range.clear();
+    if (callback && options) {
+        handle->text_options = *options;
+        if (options->page_range) {
+            handle->text_page_range = options->page_range;
+            handle->text_options.page_range = handle->text_page_range.c_str();
+        }
+    }
+    return SLIMLO_OK;
+}
+
+SLIMLO_API void slimlo_set_progress_callback(
+    SlimLOHandle handle,
+    SlimLOProgressCallback callback,
+    void* user_data
+) {
+    if (!handle || !handle->office) return;
+
+    std::lock_guard<std::mutex> lock(handle->convert_mutex);
+
+    // Register with LOKit lazily: only processes that ask for progress pay
+    // for status indicator callbacks.
+    if (callback && !handle->office_callback_registered) {
+        handle->office->registerCallback(office_callback, handle);
+        handle->office_callback_registered = true;
+    }
+
+    handle->progress_cb = callback;
+    handle->progress_data = user_data;
+    progress_reset(handle);
+}
+
+SLIMLO_API SlimLOError slimlo_add_font_directory(SlimLOHandle handle, const char* path) {
+    if (!handle || !handle->office) {
+        set_error(handle, "Not initialized");
+        return SLIMLO_ERROR_NOT_INIT;
+    }
+    if (!path || !*path) {
+        set_error(handle, "path is required");
+        return SLIMLO_ERROR_INVALID_ARGUMENT;
+    }
+
+    struct stat st;
+    if (stat(path, &st) != 0 || !S_ISDIR(st.st_mode)) {
+        set_error(handle, std::string("Font directory not found: ") + path);
+        return SLIMLO_ERROR_FILE_NOT_FOUND;
+    }
+
+    // Not during a conversion: the font lists are rebuilt under the solar mutex
+    std::lock_guard<std::mutex> lock(handle->convert_mutex);
+
+    // LOKit resolves the system path itself; hand it an absolute one
+    std::string abs_path = path_to_url(path).substr(sizeof("file://") - 1);
+#ifdef _WIN32
+    abs_path.erase(0, 1);  // "/C:/..." -> "C:/..."
+#endif
+    if (handle->office->addFontDirectory(abs_path.c_str()) < 0) {
+        const char* err = handle->office->getError();
+        set_error(handle, err && *err ? err : "Failed to register font directory");
+        return SLIMLO_ERROR_FILE_NOT_FOUND;
+    }
 
-    *output_data = pdf_buf;
-    *output_size = pdf_size;
     handle->last_error.clear();
     return SLIMLO_OK;
 }
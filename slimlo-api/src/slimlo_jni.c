@@ -0,0 +1,265 @@
+/*
+ * slimlo_jni.c — JNI bridge for the Java SDK's in-process mode
+ *
+ * Native methods of com.slimlo.internal.NativeBridge: argument marshalling
+ * around the public C API only. Threading is the Java side's job — every
+ * call arrives on the one thread that owns the SlimLO instance.
+ *
+ * Strings cross as NUL-terminated UTF-8 byte[] (built in Java), not jstring:
+ * GetStringUTFChars yields modified UTF-8, which mangles NUL and characters
+ * outside the BMP in paths and passwords.
+ *
+ * Output: convertArray()/convertDirect() return the malloc'ed PDF as
+ * {pointer, size}. Java either borrows it through a direct ByteBuffer (wrap)
+ * or copies it once into a byte[] (copy), then releases it with freeBuffer.
+ */
+
+#include <jni.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "slimlo.h"
+
+#define JNI_FN(name) Java_com_slimlo_internal_NativeBridge_##name
+
+/* Layout of the int[] and byte[][] option arrays packed by NativeBridge */
+enum {
+    OPT_PDF_VERSION,
+    OPT_JPEG_QUALITY,
+    OPT_DPI,
+    OPT_TAGGED_PDF,
+    OPT_PRESET,
+    OPT_LAZY_LAYOUT,
+    OPT_SKIP_FIELD_UPDATE,
+    OPT_COUNT
+};
+
+enum {
+    STR_PAGE_RANGE,
+    STR_PASSWORD,
+    STR_FILTER_OPTIONS,
+    STR_COUNT
+};
+
+/* Option strings pinned for one call */
+typedef struct {
+    jbyteArray array[STR_COUNT];
+    jbyte*     bytes[STR_COUNT];
+} OptionStrings;
+
+static void throw_oom(JNIEnv* env, const char* what) {
+    jclass cls = (*env)->FindClass(env, "java/lang/OutOfMemoryError");
+    if (cls) (*env)->ThrowNew(env, cls, what);
+}
+
+/* NULL for a null array; NULL with an exception pending on failure */
+static jbyte* get_bytes(JNIEnv* env, jbyteArray array) {
+    return array ? (*env)->GetByteArrayElements(env, array, NULL) : NULL;
+}
+
+static void release_bytes(JNIEnv* env, jbyteArray array, jbyte* bytes) {
+    if (array && bytes) (*env)->ReleaseByteArrayElements(env, array, bytes, JNI_ABORT);
+}
+
+static int read_options(JNIEnv* env, jintArray opts, jobjectArray strs,
+                        SlimLOPdfOptions* out, OptionStrings* held) {
+    jint values[OPT_COUNT];
+    int i;
+
+    memset(out, 0, sizeof(*out));
+    memset(held, 0, sizeof(*held));
+
+    if ((*env)->GetArrayLength(env, opts) < OPT_COUNT ||
+        (*env)->GetArrayLength(env, strs) < STR_COUNT)
+        return 0;
+    (*env)->GetIntArrayRegion(env, opts, 0, OPT_COUNT, values);
+
+    out->pdf_version = (SlimLOPdfVersion)values[OPT_PDF_VERSION];
+    out->jpeg_quality = values[OPT_JPEG_QUALITY];
+    out->dpi = values[OPT_DPI];
+    out->tagged_pdf = values[OPT_TAGGED_PDF];
+    out->preset = (SlimLOPdfPreset)values[OPT_PRESET];
+    out->lazy_layout = values[OPT_LAZY_LAYOUT];
+    out->skip_field_update = values[OPT_SKIP_FIELD_UPDATE];
+
+    for (i = 0; i < STR_COUNT; i++) {
+        held->array[i] = (jbyteArray)(*env)->GetObjectArrayElement(env, strs, i);
+        if (held->array[i] && !(held->bytes[i] = get_bytes(env, held->array[i])))
+            return 0;
+    }
+    out->page_range = (const char*)held->bytes[STR_PAGE_RANGE];
+    out->password = (const char*)held->bytes[STR_PASSWORD];
+    out->filter_options = (const char*)held->bytes[STR_FILTER_OPTIONS];
+    return 1;
+}
+
+static void release_options(JNIEnv* env, OptionStrings* held) {
+    int i;
+    for (i = 0; i < STR_COUNT; i++) {
+        release_bytes(env, held->array[i], held->bytes[i]);
+        if (held->array[i]) (*env)->DeleteLocalRef(env, held->array[i]);
+    }
+}
+
+/* Convert size bytes at data; on success out = {pdf pointer, pdf size} */
+static jint convert_bytes(JNIEnv* env, jlong handle, const uint8_t* data, size_t size,
+                          jint format, jintArray opts, jobjectArray strs, jlongArray out) {
+    SlimLOPdfOptions options;
+    OptionStrings held;
+    uint8_t* pdf = NULL;
+    size_t pdf_size = 0;
+    SlimLOError err;
+
+    if (!read_options(env, opts, strs, &options, &held)) {
+        release_options(env, &held);
+        return (*env)->ExceptionCheck(env) ? SLIMLO_ERROR_OUT_OF_MEMORY : SLIMLO_ERROR_INVALID_ARGUMENT;
+    }
+    err = slimlo_convert_buffer((SlimLOHandle)(intptr_t)handle, data, size,
+                                (SlimLOFormat)format, &options, &pdf, &pdf_size);
+    release_options(env, &held);
+
+    if (err == SLIMLO_OK) {
+        jlong result[2];
+        result[0] = (jlong)(intptr_t)pdf;
+        result[1] = (jlong)pdf_size;
+        (*env)->SetLongArrayRegion(env, out, 0, 2, result);
+    }
+    return err;
+}
+
+JNIEXPORT jlong JNICALL JNI_FN(init)(JNIEnv* env, jclass cls,
+                                     jbyteArray resourcePath, jint threads) {
+    SlimLOInitOptions options;
+    jbyte* path;
+    SlimLOHandle handle;
+    (void)cls;
+
+    if (!(path = get_bytes(env, resourcePath)))
+        return 0;
+    options.threads = threads;
+    handle = slimlo_init_ex((const char*)path, &options);
+    release_bytes(env, resourcePath, path);
+    return (jlong)(intptr_t)handle;
+}
+
+JNIEXPORT void JNICALL JNI_FN(destroy)(JNIEnv* env, jclass cls, jlong handle) {
+    (void)env; (void)cls;
+    slimlo_destroy((SlimLOHandle)(intptr_t)handle);
+}
+
+JNIEXPORT jint JNICALL JNI_FN(convertFile)(JNIEnv* env, jclass cls, jlong handle,
+                                           jbyteArray inputPath, jbyteArray outputPath,
+                                           jint format, jintArray opts, jobjectArray strs) {
+    SlimLOPdfOptions options;
+    OptionStrings held;
+    jbyte* input = NULL;
+    jbyte* output = NULL;
+    jint err = SLIMLO_ERROR_OUT_OF_MEMORY;
+    (void)cls;
+
+    if (!read_options(env, opts, strs, &options, &held)) {
+        release_options(env, &held);
+        return (*env)->ExceptionCheck(env) ? SLIMLO_ERROR_OUT_OF_MEMORY : SLIMLO_ERROR_INVALID_ARGUMENT;
+    }
+    if ((input = get_bytes(env, inputPath)) && (output = get_bytes(env, outputPath))) {
+        err = slimlo_convert_file((SlimLOHandle)(intptr_t)handle, (const char*)input,
+                                  (const char*)output, (SlimLOFormat)format, &options);
+    }
+    release_bytes(env, outputPath, output);
+    release_bytes(env, inputPath, input);
+    release_options(env, &held);
+    return err;
+}
+
+/* Input from a byte[] range: copied once, since pinning it with
+ * GetPrimitiveArrayCritical would stall the garbage collector for the
+ * whole conversion. */
+JNIEXPORT jint JNICALL JNI_FN(convertArray)(JNIEnv* env, jclass cls, jlong handle,
+                                            jbyteArray input, jint offset, jint length,
+                                            jint format, jintArray opts, jobjectArray strs,
+                                            jlongArray out) {
+    uint8_t* data;
+    jint err;
+    (void)cls;
+
+    if (length <= 0) return SLIMLO_ERROR_INVALID_ARGUMENT;
+    if (!(data = (uint8_t*)malloc((size_t)length))) {
+        throw_oom(env, "slimlo: input copy");
+        return SLIMLO_ERROR_OUT_OF_MEMORY;
+    }
+    (*env)->GetByteArrayRegion(env, input, offset, length, (jbyte*)data);
+    if ((*env)->ExceptionCheck(env)) {
+        free(data);
+        return SLIMLO_ERROR_INVALID_ARGUMENT;
+    }
+    err = convert_bytes(env, handle, data, (size_t)length, format, opts, strs, out);
+    free(data);
+    return err;
+}
+
+/* Input from a direct ByteBuffer range: read in place, no copy */
+JNIEXPORT jint JNICALL JNI_FN(convertDirect)(JNIEnv* env, jclass cls, jlong handle,
+                                             jobject input, jint offset, jint length,
+                                             jint format, jintArray opts, jobjectArray strs,
+                                             jlongArray out) {
+    uint8_t* base = (uint8_t*)(*env)->GetDirectBufferAddress(env, input);
+    (void)cls;
+
+    if (!base || length <= 0) return SLIMLO_ERROR_INVALID_ARGUMENT;
+    return convert_bytes(env, handle, base + offset, (size_t)length, format, opts, strs, out);
+}
+
+/* Borrow a converted PDF as a direct ByteBuffer (valid until freeBuffer) */
+JNIEXPORT jobject JNICALL JNI_FN(wrap)(JNIEnv* env, jclass cls, jlong pointer, jlong size) {
+    (void)cls;
+    return (*env)->NewDirectByteBuffer(env, (void*)(intptr_t)pointer, size);
+}
+
+/* Copy a converted PDF into a new byte[] */
+JNIEXPORT jbyteArray JNICALL JNI_FN(copy)(JNIEnv* env, jclass cls, jlong pointer, jlong size) {
+    jbyteArray array;
+    (void)cls;
+
+    if (size > INT32_MAX) {
+        throw_oom(env, "slimlo: PDF larger than a Java array");
+        return NULL;
+    }
+    if (!(array = (*env)->NewByteArray(env, (jsize)size)))
+        return NULL;
+    (*env)->SetByteArrayRegion(env, array, 0, (jsize)size, (const jbyte*)(intptr_t)pointer);
+    return array;
+}
+
+JNIEXPORT void JNICALL JNI_FN(freeBuffer)(JNIEnv* env, jclass cls, jlong pointer) {
+    (void)env; (void)cls;
+    slimlo_free_buffer((uint8_t*)(intptr_t)pointer);
+}
+
+JNIEXPORT jint JNICALL JNI_FN(addFontDirectory)(JNIEnv* env, jclass cls, jlong handle,
+                                                jbyteArray path) {
+    jbyte* bytes;
+    jint err;
+    (void)cls;
+
+    if (!(bytes = get_bytes(env, path)))
+        return (*env)->ExceptionCheck(env) ? SLIMLO_ERROR_OUT_OF_MEMORY : SLIMLO_ERROR_INVALID_ARGUMENT;
+    err = slimlo_add_font_directory((SlimLOHandle)(intptr_t)handle, (const char*)bytes);
+    release_bytes(env, path, bytes);
+    return err;
+}
+
+/* Last error as UTF-8 bytes (handle 0: init errors) */
+JNIEXPORT jbyteArray JNICALL JNI_FN(errorMessageUtf8)(JNIEnv* env, jclass cls, jlong handle) {
+    const char* message = slimlo_get_error_message((SlimLOHandle)(intptr_t)handle);
+    jsize length;
+    jbyteArray array;
+    (void)cls;
+
+    if (!message) message = "";
+    length = (jsize)strlen(message);
+    if (!(array = (*env)->NewByteArray(env, length)))
+        return NULL;
+    (*env)->SetByteArrayRegion(env, array, 0, length, (const jbyte*)message);
+    return array;
+}
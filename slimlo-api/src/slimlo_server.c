@@ -0,0 +1,1028 @@
+/*
+ * slimlo_server.c — Local conversion daemon sharing one warm worker pool.
+ *
+ * Built from slimlo_worker.c: the same executable is the supervisor and,
+ * re-executed with --worker, each of its pool workers. The supervisor
+ * accepts any number of clients on a Unix domain socket, and every
+ * connection speaks the worker protocol exactly as if it owned a
+ * slimlo_worker process, so the SDKs only swap pipes for a socket.
+ *
+ * Usage:
+ *   slimlo_server --socket PATH --resource-path DIR [--workers N]
+ *                 [--font-path DIR]... [--threads N]
+ *                 [--health-interval SEC] [--socket-mode OCTAL]
+ *
+ * Per connection:
+ *   - "init" is answered from the pool: the server's resource path, fonts
+ *     and thread budget apply, the client's are ignored
+ *   - "ping" is answered with "pong"; "quit" or EOF closes the connection
+ *   - "add_fonts" adds directories to the server's fonts: workers started
+ *     later get them at init, running ones before their next request
+ *   - any other request is read whole (so a slow client never holds a
+ *     worker), handed to an idle worker and the response relayed back
+ *
+ * Fairness: connections are grouped by client process (the peer pid where
+ * the platform reports it). A free worker goes to the waiting group served
+ * least recently, FIFO within a group, so a host with many connections
+ * cannot starve one with few.
+ *
+ * Health: idle workers are pinged every --health-interval seconds. Workers
+ * that exit, stop answering, or are abandoned mid-request (the client hung
+ * up, e.g. on its own timeout) are killed and restarted, with backoff if
+ * they fail to start. A worker lost mid-request closes its client's
+ * connection, which the SDKs already handle as a worker crash.
+ */
+
+#define SLIMLO_SERVER
+#include "slimlo_worker.c"
+
+#include <limits.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#define MAX_WORKERS       256
+#define HEALTH_TIMEOUT_MS 5000
+#define INIT_TIMEOUT_MS   (120 * 1000)
+#define MAX_BACKOFF_MS    (30 * 1000)
+#define COPY_SIZE         (64 * 1024)
+
+enum { W_DOWN, W_STARTING, W_IDLE, W_BUSY };
+
+/* Outcome of a relayed exchange */
+enum { RELAY_OK, RELAY_WORKER, RELAY_CLIENT };
+
+typedef struct {
+    pid_t pid;
+    int to_fd;          /* worker stdin */
+    int from_fd;        /* worker stdout */
+    int state;
+    int failures;       /* consecutive failed starts, for backoff */
+    double since;       /* when the current start began */
+    double next_start;  /* earliest restart while W_DOWN */
+    double last_check;  /* last proof of life while W_IDLE */
+    int fonts;          /* entries of g_font_paths the worker has registered */
+} Worker;
+
+/* The connections of one client process */
+typedef struct Group {
+    long key;
+    int refs;
+    unsigned long served;   /* turn of its last grant; 0 = never served */
+    struct Group* next;
+} Group;
+
+/* A request waiting for a worker, queued in arrival order */
+typedef struct Waiter {
+    Group* group;
+    int worker;             /* granted worker, -1 while waiting */
+    struct Waiter* next;
+} Waiter;
+
+typedef struct {
+    int fd;
+    Group* group;
+} Connection;
+
+/* A request read from a client, frames included, ready to forward */
+typedef struct {
+    char* data;
+    size_t len, cap;
+} Buffer;
+
+/* Configuration */
+static char g_self[PATH_MAX];
+static const char* g_socket_path;
+static const char* g_resource_path;
+static cJSON* g_font_paths;     /* grows with "add_fonts"; guarded by g_lock */
+static int g_threads;
+static int g_worker_count = 2;
+static int g_health_interval = 30;
+static int g_socket_mode = 0600;
+
+/* Pool state, guarded by g_lock. A W_BUSY worker belongs to the thread that
+ * took it; every other worker belongs to the supervisor (main) thread. */
+static Worker g_workers[MAX_WORKERS];
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_changed = PTHREAD_COND_INITIALIZER;
+static Group* g_groups;
+static Waiter* g_waiters;
+static unsigned long g_turn;
+static char g_version[64];      /* from the first "ready"; empty until then */
+static char g_init_error[256];  /* from the last failed start, cleared on "ready" */
+static int g_wake[2] = {-1, -1};
+static volatile sig_atomic_t g_stop;
+
+/* --------------------------------------------------------------------------
+ * Framing on arbitrary descriptors
+ * -------------------------------------------------------------------------- */
+
+static void set_cloexec(int fd) {
+    fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC);
+}
+
+static int frame_write(int fd, const char* data, size_t len) {
+    uint32_t wire_len = (uint32_t)len;
+    if (write_exact(fd, &wire_len, 4) != 0)
+        return -1;
+    return write_exact(fd, data, len);
+}
+
+/* Read one frame; caller must free() it. NULL on EOF, error or oversize. */
+static char* frame_read(int fd, size_t* out_len) {
+    uint32_t len;
+    if (read_exact(fd, &len, 4) != 0 || len > MAX_MSG_SIZE)
+        return NULL;
+    char* buf = (char*)malloc(len + 1);
+    if (!buf)
+        return NULL;
+    if (read_exact(fd, buf, len) != 0) {
+        free(buf);
+        return NULL;
+    }
+    buf[len] = '\0';
+    *out_len = len;
+    return buf;
+}
+
+static int json_write(int fd, cJSON* json) {
+    char* str = cJSON_PrintUnformatted(json);
+    cJSON_Delete(json);
+    if (!str) return -1;
+    int rc = frame_write(fd, str, strlen(str));
+    free(str);
+    return rc;
+}
+
+static int buffer_append(Buffer* b, const void* data, size_t n) {
+    if (b->len + n > b->cap) {
+        size_t cap = b->cap ? b->cap : 4096;
+        while (cap < b->len + n)
+            cap *= 2;
+        char* grown = (char*)realloc(b->data, cap);
+        if (!grown)
+            return -1;
+        b->data = grown;
+        b->cap = cap;
+    }
+    memcpy(b->data + b->len, data, n);
+    b->len += n;
+    return 0;
+}
+
+static int buffer_frame(Buffer* b, const char* data, size_t len) {
+    uint32_t wire_len = (uint32_t)len;
+    return buffer_append(b, &wire_len, 4) == 0 ? buffer_append(b, data, len) : -1;
+}
+
+/* --------------------------------------------------------------------------
+ * Worker lifecycle (supervisor thread, or the owner of a W_BUSY worker)
+ * -------------------------------------------------------------------------- */
+
+static void wake_supervisor(void) {
+    char c = 0;
+    if (write(g_wake[1], &c, 1) < 0) {
+        /* A full pipe already has a wake-up pending */
+    }
+}
+
+/* Start worker i and send it the pool's init message. */
+static int worker_spawn(int i) {
+    Worker* w = &g_workers[i];
+    int to[2], from[2];
+    if (pipe(to) != 0)
+        return -1;
+    if (pipe(from) != 0) {
+        close(to[0]);
+        close(to[1]);
+        return -1;
+    }
+    set_cloexec(to[0]); set_cloexec(to[1]);
+    set_cloexec(from[0]); set_cloexec(from[1]);
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(to[0]); close(to[1]);
+        close(from[0]); close(from[1]);
+        return -1;
+    }
+    if (pid == 0) {
+        /* dup2 clears close-on-exec on the worker's stdin/stdout */
+        dup2(to[0], 0);
+        dup2(from[1], 1);
+        signal(SIGPIPE, SIG_DFL);
+        char* argv[] = { g_self, (char*)"--worker", NULL };
+        execv(g_self, argv);
+        _exit(127);
+    }
+    close(to[0]);
+    close(from[1]);
+    w->pid = pid;
+    w->to_fd = to[1];
+    w->from_fd = from[0];
+    w->since = monotonic_ms();
+
+    cJSON* init = cJSON_CreateObject();
+    cJSON_AddStringToObject(init, "type", "init");
+    cJSON_AddStringToObject(init, "resource_path", g_resource_path);
+    pthread_mutex_lock(&g_lock);
+    w->fonts = cJSON_GetArraySize(g_font_paths);
+    if (g_font_paths)
+        cJSON_AddItemToObject(init, "font_paths", cJSON_Duplicate(g_font_paths, 1));
+    pthread_mutex_unlock(&g_lock);
+    if (g_threads > 0)
+        cJSON_AddNumberToObject(init, "threads", g_threads);
+    return json_write(w->to_fd, init);
+}
+
+/* Kill worker i, reap it and schedule its restart. The caller owns it. */
+static void worker_retire(int i, int start_failed) {
+    Worker* w = &g_workers[i];
+    if (w->pid > 0) {
+        kill(w->pid, SIGKILL);
+        while (waitpid(w->pid, NULL, 0) < 0 && errno == EINTR) {}
+    }
+    if (w->to_fd >= 0) close(w->to_fd);
+    if (w->from_fd >= 0) close(w->from_fd);
+    w->pid = 0;
+    w->to_fd = w->from_fd = -1;
+
+    pthread_mutex_lock(&g_lock);
+    double delay = 0;
+    if (start_failed) {
+        w->failures++;
+        delay = 500.0 * (1 << (w->failures < 6 ? w->failures : 6));
+        if (delay > MAX_BACKOFF_MS)
+            delay = MAX_BACKOFF_MS;
+    }
+    w->next_start = monotonic_ms() + delay;
+    w->state = W_DOWN;
+    pthread_cond_broadcast(&g_changed);
+    pthread_mutex_unlock(&g_lock);
+    wake_supervisor();
+}
+
+/* Whether worker i has exited; reaps it if so. The caller owns it. */
+static int worker_exited(int i) {
+    Worker* w = &g_workers[i];
+    if (w->pid <= 0 || waitpid(w->pid, NULL, WNOHANG) != w->pid)
+        return 0;
+    w->pid = 0;
+    return 1;
+}
+
+/* --------------------------------------------------------------------------
+ * Scheduling (g_lock held)
+ * -------------------------------------------------------------------------- */
+
+/* Hand idle workers to waiting requests, least recently served group first. */
+static void dispatch(void) {
+    for (;;) {
+        int idle = -1;
+        for (int i = 0; i < g_worker_count && idle < 0; i++)
+            if (g_workers[i].state == W_IDLE)
+                idle = i;
+        if (idle < 0 || !g_waiters)
+            return;
+
+        Waiter** best = &g_waiters;
+        for (Waiter** p = &g_waiters; *p; p = &(*p)->next)
+            if ((*p)->group->served < (*best)->group->served)
+                best = p;
+        Waiter* granted = *best;
+        *best = granted->next;
+        granted->worker = idle;
+        granted->group->served = ++g_turn;
+        g_workers[idle].state = W_BUSY;
+        pthread_cond_broadcast(&g_changed);
+    }
+}
+
+static Group* group_join(long key) {
+    Group* g;
+    for (g = g_groups; g; g = g->next)
+        if (g->key == key)
+            break;
+    if (!g) {
+        g = (Group*)calloc(1, sizeof(Group));
+        if (!g)
+            return NULL;
+        g->key = key;
+        g->next = g_groups;
+        g_groups = g;
+    }
+    g->refs++;
+    return g;
+}
+
+static void group_leave(Group* g) {
+    if (--g->refs > 0)
+        return;
+    for (Group** p = &g_groups; *p; p = &(*p)->next) {
+        if (*p == g) {
+            *p = g->next;
+            break;
+        }
+    }
+    free(g);
+}
+
+/* Wait for a worker; returns its index, or -1 when the server stops. */
+static int worker_acquire(Group* group) {
+    Waiter me = { group, -1, NULL };
+    pthread_mutex_lock(&g_lock);
+    Waiter** tail = &g_waiters;
+    while (*tail)
+        tail = &(*tail)->next;
+    *tail = &me;
+    dispatch();
+    while (me.worker < 0 && !g_stop)
+        pthread_cond_wait(&g_changed, &g_lock);
+    if (me.worker < 0) {
+        for (Waiter** p = &g_waiters; *p; p = &(*p)->next) {
+            if (*p == &me) {
+                *p = me.next;
+                break;
+            }
+        }
+    }
+    pthread_mutex_unlock(&g_lock);
+    return me.worker;
+}
+
+static void worker_release(int i) {
+    pthread_mutex_lock(&g_lock);
+    g_workers[i].state = W_IDLE;
+    g_workers[i].last_check = monotonic_ms();
+    dispatch();
+    pthread_mutex_unlock(&g_lock);
+}
+
+/* --------------------------------------------------------------------------
+ * Relaying
+ * -------------------------------------------------------------------------- */
+
+/* Read the body frames that follow a request header, as the worker would. */
+static int read_body(int fd, cJSON* msg, const char* type, Buffer* req, int* too_large) {
+    int chunked = cJSON_IsTrue(cJSON_GetObjectItem(msg, "chunked"));
+    int framed = strcmp(type, "convert_buffer") == 0
+        || ((strcmp(type, "info") == 0 || strcmp(type, "render") == 0)
+            && cJSON_IsNumber(cJSON_GetObjectItem(msg, "data_size")));
+    if (!framed)
+        return 0;
+    if (strcmp(type, "convert_buffer") != 0)
+        chunked = 0;
+
+    *too_large = 0;
+    size_t total = 0;
+    for (;;) {
+        size_t len = 0;
+        char* frame = frame_read(fd, &len);
+        if (!frame)
+            return -1;
+        total += len;
+        if (total > MAX_MSG_SIZE)
+            *too_large = 1;
+        int rc = *too_large ? 0 : buffer_frame(req, frame, len);
+        free(frame);
+        if (rc != 0)
+            return -1;
+        if (!chunked || len == 0)
+            return 0;
+    }
+}
+
+/* Until the worker has output, watch the client: as the protocol is one
+ * request at a time, a client that sends anything or hangs up meanwhile
+ * has abandoned its request. */
+static int await_worker(int wfd, int cfd) {
+    struct pollfd p[2] = { { wfd, POLLIN, 0 }, { cfd, POLLIN, 0 } };
+    for (;;) {
+        if (poll(p, 2, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            return RELAY_WORKER;
+        }
+        if (p[1].revents)
+            return RELAY_CLIENT;
+        if (p[0].revents)
+            return RELAY_OK;
+    }
+}
+
+/* Stream one binary frame from the worker to the client. */
+static int copy_frame(int wfd, int cfd, uint32_t* out_len) {
+    char buf[COPY_SIZE];
+    uint32_t n;
+    if (read_exact(wfd, &n, 4) != 0)
+        return RELAY_WORKER;
+    if (write_exact(cfd, &n, 4) != 0)
+        return RELAY_CLIENT;
+    *out_len = n;
+    while (n > 0) {
+        size_t step = n < sizeof(buf) ? n : sizeof(buf);
+        if (read_exact(wfd, buf, step) != 0)
+            return RELAY_WORKER;
+        if (write_exact(cfd, buf, step) != 0)
+            return RELAY_CLIENT;
+        n -= (uint32_t)step;
+    }
+    return RELAY_OK;
+}
+
+/* Relay progress frames, the result and the binary frames it announces. */
+static int relay_response(int wfd, int cfd) {
+    for (;;) {
+        int rc = await_worker(wfd, cfd);
+        if (rc != RELAY_OK)
+            return rc;
+        size_t len = 0;
+        char* raw = frame_read(wfd, &len);
+        if (!raw)
+            return RELAY_WORKER;
+        cJSON* resp = cJSON_Parse(raw);
+        rc = frame_write(cfd, raw, len) != 0 ? RELAY_CLIENT : RELAY_OK;
+        free(raw);
+        if (!resp)
+            return rc == RELAY_OK ? RELAY_WORKER : rc;
+        if (rc != RELAY_OK) {
+            cJSON_Delete(resp);
+            return rc;
+        }
+
+        cJSON* type_json = cJSON_GetObjectItem(resp, "type");
+        const char* type = cJSON_IsString(type_json) ? type_json->valuestring : "";
+        int success = cJSON_IsTrue(cJSON_GetObjectItem(resp, "success"));
+        int progress = strcmp(type, "progress") == 0;
+        int pdf = success && strcmp(type, "buffer_result") == 0;
+        int chunked = cJSON_IsTrue(cJSON_GetObjectItem(resp, "chunked"));
+        int images = success ? cJSON_GetArraySize(cJSON_GetObjectItem(resp, "images")) : 0;
+        cJSON_Delete(resp);
+        if (progress)
+            continue;
+
+        uint32_t n;
+        if (pdf) {
+            do {
+                if ((rc = copy_frame(wfd, cfd, &n)) != RELAY_OK)
+                    return rc;
+            } while (chunked && n > 0);
+        }
+        for (int i = 0; i < images; i++)
+            if ((rc = copy_frame(wfd, cfd, &n)) != RELAY_OK)
+                return rc;
+        return RELAY_OK;
+    }
+}
+
+/* Whether the client hung up while its request waited for a worker. */
+static int client_gone(int cfd) {
+    struct pollfd p = { cfd, POLLIN, 0 };
+    char c;
+    return poll(&p, 1, 0) > 0 && recv(cfd, &c, 1, MSG_PEEK) <= 0;
+}
+
+/* Register font directories added since worker i started. The caller owns
+ * it. A directory the worker rejects is logged; only I/O failure is fatal. */
+static int sync_fonts(int i) {
+    Worker* w = &g_workers[i];
+    cJSON* paths = cJSON_CreateArray();
+    pthread_mutex_lock(&g_lock);
+    int total = cJSON_GetArraySize(g_font_paths);
+    for (int n = w->fonts; n < total; n++)
+        cJSON_AddItemToArray(paths, cJSON_Duplicate(cJSON_GetArrayItem(g_font_paths, n), 0));
+    pthread_mutex_unlock(&g_lock);
+    if (cJSON_GetArraySize(paths) == 0) {
+        cJSON_Delete(paths);
+        return 0;
+    }
+
+    cJSON* msg = cJSON_CreateObject();
+    cJSON_AddStringToObject(msg, "type", "add_fonts");
+    cJSON_AddItemToObject(msg, "paths", paths);
+    if (json_write(w->to_fd, msg) != 0)
+        return -1;
+    size_t len = 0;
+    char* raw = frame_read(w->from_fd, &len);
+    if (!raw)
+        return -1;
+    cJSON* resp = cJSON_Parse(raw);
+    free(raw);
+    if (!cJSON_IsTrue(cJSON_GetObjectItem(resp, "success"))) {
+        cJSON* message = cJSON_GetObjectItem(resp, "error_message");
+        fprintf(stderr, "slimlo_server: worker %d: add_fonts: %s\n", i,
+                cJSON_IsString(message) ? message->valuestring : "failed");
+    }
+    cJSON_Delete(resp);
+    w->fonts = total;
+    return 0;
+}
+
+/* Run one buffered request on a pool worker. Returns a RELAY_* outcome. */
+static int run_request(Connection* c, const Buffer* req) {
+    for (;;) {
+        int i = worker_acquire(c->group);
+        if (i < 0)
+            return RELAY_CLIENT;
+        if (worker_exited(i)) {
+            /* Died while idle, before a health check noticed */
+            worker_retire(i, 0);
+            continue;
+        }
+        if (client_gone(c->fd)) {
+            worker_release(i);
+            return RELAY_CLIENT;
+        }
+        if (sync_fonts(i) != 0) {
+            worker_retire(i, 0);
+            continue;
+        }
+        Worker* w = &g_workers[i];
+        int rc = write_exact(w->to_fd, req->data, req->len) != 0
+            ? RELAY_WORKER
+            : relay_response(w->from_fd, c->fd);
+        if (rc == RELAY_OK)
+            worker_release(i);
+        else
+            worker_retire(i, 0);
+        return rc;
+    }
+}
+
+/* Whether every worker has failed to start at least once (g_lock held) */
+static int all_failed(void) {
+    for (int i = 0; i < g_worker_count; i++)
+        if (g_workers[i].failures == 0)
+            return 0;
+    return 1;
+}
+
+static int reply_init(int fd) {
+    cJSON* resp = cJSON_CreateObject();
+    pthread_mutex_lock(&g_lock);
+    while (!g_version[0] && !(g_init_error[0] && all_failed()) && !g_stop)
+        pthread_cond_wait(&g_changed, &g_lock);
+    if (g_version[0]) {
+        cJSON_AddStringToObject(resp, "type", "ready");
+        cJSON_AddStringToObject(resp, "version", g_version);
+    } else {
+        cJSON_AddStringToObject(resp, "type", "error");
+        cJSON_AddStringToObject(resp, "message",
+            g_init_error[0] ? g_init_error : "Server is shutting down");
+    }
+    pthread_mutex_unlock(&g_lock);
+    return json_write(fd, resp);
+}
+
+/* "add_fonts": check the directories and add the new ones to the pool's fonts;
+ * each worker registers them before its next request. */
+static int reply_add_fonts(int fd, cJSON* msg) {
+    cJSON* id_json = cJSON_GetObjectItem(msg, "id");
+    cJSON* paths = cJSON_GetObjectItem(msg, "paths");
+    cJSON* resp = cJSON_CreateObject();
+    cJSON_AddStringToObject(resp, "type", "fonts_result");
+    cJSON_AddNumberToObject(resp, "id", cJSON_IsNumber(id_json) ? id_json->valueint : 0);
+
+    const char* bad = NULL;
+    int count = cJSON_IsArray(paths) ? cJSON_GetArraySize(paths) : 0;
+    for (int n = 0; n < count && !bad; n++) {
+        cJSON* item = cJSON_GetArrayItem(paths, n);
+        struct stat st;
+        if (!cJSON_IsString(item) || item->valuestring[0] != '/'
+            || stat(item->valuestring, &st) != 0 || !S_ISDIR(st.st_mode))
+            bad = cJSON_IsString(item) ? item->valuestring : "";
+    }
+
+    if (!cJSON_IsArray(paths) || bad) {
+        char message[PATH_MAX + 64];
+        if (bad)
+            snprintf(message, sizeof(message), "Font directory not found (absolute path required): %s", bad);
+        else
+            snprintf(message, sizeof(message), "Missing paths in add_fonts message");
+        cJSON_AddBoolToObject(resp, "success", 0);
+        cJSON_AddNumberToObject(resp, "error_code",
+                                bad ? SLIMLO_ERROR_FILE_NOT_FOUND : SLIMLO_ERROR_INVALID_ARGUMENT);
+        cJSON_AddStringToObject(resp, "error_message", message);
+    } else {
+        pthread_mutex_lock(&g_lock);
+        if (!g_font_paths)
+            g_font_paths = cJSON_CreateArray();
+        for (int n = 0; n < count; n++) {
+            const char* path = cJSON_GetArrayItem(paths, n)->valuestring;
+            int known = 0;
+            for (int k = 0; k < cJSON_GetArraySize(g_font_paths) && !known; k++)
+                known = strcmp(cJSON_GetArrayItem(g_font_paths, k)->valuestring, path) == 0;
+            if (!known)
+                cJSON_AddItemToArray(g_font_paths, cJSON_CreateString(path));
+        }
+        pthread_mutex_unlock(&g_lock);
+        cJSON_AddBoolToObject(resp, "success", 1);
+        cJSON_AddNullToObject(resp, "error_code");
+        cJSON_AddNullToObject(resp, "error_message");
+    }
+    cJSON_AddItemToObject(resp, "diagnostics", cJSON_CreateArray());
+    return json_write(fd, resp);
+}
+
+static int reply_too_large(int fd, cJSON* msg) {
+    cJSON* id_json = cJSON_GetObjectItem(msg, "id");
+    cJSON* resp = cJSON_CreateObject();
+    cJSON_AddStringToObject(resp, "type", "buffer_result");
+    cJSON_AddNumberToObject(resp, "id", cJSON_IsNumber(id_json) ? id_json->valueint : 0);
+    cJSON_AddBoolToObject(resp, "success", 0);
+    cJSON_AddNumberToObject(resp, "error_code", SLIMLO_ERROR_INVALID_ARGUMENT);
+    cJSON_AddStringToObject(resp, "error_message", "Document exceeds the maximum message size");
+    cJSON_AddItemToObject(resp, "diagnostics", cJSON_CreateArray());
+    return json_write(fd, resp);
+}
+
+static long peer_key(int fd) {
+#if defined(SO_PEERCRED)
+    struct ucred cred;
+    socklen_t len = sizeof(cred);
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) == 0)
+        return (long)cred.pid;
+#elif defined(LOCAL_PEERPID)
+    pid_t pid;
+    socklen_t len = sizeof(pid);
+    if (getsockopt(fd, SOL_LOCAL, LOCAL_PEERPID, &pid, &len) == 0)
+        return (long)pid;
+#endif
+    /* Unknown peer: the connection is a group of its own */
+    return -(long)fd - 1;
+}
+
+static void* connection_main(void* arg) {
+    Connection* c = (Connection*)arg;
+    for (;;) {
+        size_t len = 0;
+        char* raw = frame_read(c->fd, &len);
+        if (!raw)
+            break;
+
+        cJSON* msg = cJSON_Parse(raw);
+        if (!msg) {
+            free(raw);
+            cJSON* resp = cJSON_CreateObject();
+            cJSON_AddStringToObject(resp, "type", "error");
+            cJSON_AddStringToObject(resp, "message", "Invalid JSON message");
+            if (json_write(c->fd, resp) != 0)
+                break;
+            continue;
+        }
+        cJSON* type_json = cJSON_GetObjectItem(msg, "type");
+        const char* type = cJSON_IsString(type_json) ? type_json->valuestring : "";
+
+        int rc = 0;
+        if (strcmp(type, "quit") == 0) {
+            rc = -1;
+        } else if (strcmp(type, "init") == 0) {
+            rc = reply_init(c->fd);
+        } else if (strcmp(type, "ping") == 0) {
+            cJSON* resp = cJSON_CreateObject();
+            cJSON_AddStringToObject(resp, "type", "pong");
+            rc = json_write(c->fd, resp);
+        } else if (strcmp(type, "add_fonts") == 0) {
+            rc = reply_add_fonts(c->fd, msg);
+        } else {
+            Buffer req = { NULL, 0, 0 };
+            int too_large = 0;
+            if (buffer_frame(&req, raw, len) != 0 || read_body(c->fd, msg, type, &req, &too_large) != 0)
+                rc = -1;
+            else if (too_large)
+                rc = reply_too_large(c->fd, msg);
+            else
+                rc = run_request(c, &req) == RELAY_OK ? 0 : -1;
+            free(req.data);
+        }
+        free(raw);
+        cJSON_Delete(msg);
+        if (rc != 0)
+            break;
+    }
+
+    close(c->fd);
+    pthread_mutex_lock(&g_lock);
+    group_leave(c->group);
+    pthread_mutex_unlock(&g_lock);
+    free(c);
+    return NULL;
+}
+
+/* --------------------------------------------------------------------------
+ * Supervisor
+ * -------------------------------------------------------------------------- */
+
+/* Read the init response of a starting worker. */
+static void finish_start(int i) {
+    Worker* w = &g_workers[i];
+    size_t len = 0;
+    char* raw = frame_read(w->from_fd, &len);
+    cJSON* resp = raw ? cJSON_Parse(raw) : NULL;
+    free(raw);
+    cJSON* type = cJSON_GetObjectItem(resp, "type");
+
+    if (cJSON_IsString(type) && strcmp(type->valuestring, "ready") == 0) {
+        cJSON* version = cJSON_GetObjectItem(resp, "version");
+        pthread_mutex_lock(&g_lock);
+        if (!g_version[0])
+            snprintf(g_version, sizeof(g_version), "%s",
+                     cJSON_IsString(version) ? version->valuestring : "unknown");
+        g_init_error[0] = '\0';
+        w->failures = 0;
+        w->state = W_IDLE;
+        w->last_check = monotonic_ms();
+        dispatch();
+        pthread_cond_broadcast(&g_changed);
+        pthread_mutex_unlock(&g_lock);
+    } else {
+        cJSON* message = cJSON_GetObjectItem(resp, "message");
+        pthread_mutex_lock(&g_lock);
+        snprintf(g_init_error, sizeof(g_init_error), "Worker initialization failed: %s",
+                 cJSON_IsString(message) ? message->valuestring : "worker exited during startup");
+        pthread_mutex_unlock(&g_lock);
+        fprintf(stderr, "slimlo_server: worker %d: %s\n", i, g_init_error);
+        worker_retire(i, 1);
+    }
+    cJSON_Delete(resp);
+}
+
+/* Ping an idle worker; the supervisor holds it W_BUSY meanwhile. */
+static int health_check(int i) {
+    Worker* w = &g_workers[i];
+    if (worker_exited(i))
+        return -1;
+    cJSON* ping = cJSON_CreateObject();
+    cJSON_AddStringToObject(ping, "type", "ping");
+    if (json_write(w->to_fd, ping) != 0)
+        return -1;
+    struct pollfd p = { w->from_fd, POLLIN, 0 };
+    if (poll(&p, 1, HEALTH_TIMEOUT_MS) <= 0)
+        return -1;
+    size_t len = 0;
+    char* raw = frame_read(w->from_fd, &len);
+    cJSON* resp = raw ? cJSON_Parse(raw) : NULL;
+    free(raw);
+    cJSON* type = cJSON_GetObjectItem(resp, "type");
+    int ok = cJSON_IsString(type) && strcmp(type->valuestring, "pong") == 0;
+    cJSON_Delete(resp);
+    return ok ? 0 : -1;
+}
+
+static void housekeeping(void) {
+    double now = monotonic_ms();
+    for (int i = 0; i < g_worker_count; i++) {
+        Worker* w = &g_workers[i];
+        pthread_mutex_lock(&g_lock);
+        int state = w->state;
+        int check = state == W_IDLE && g_health_interval > 0
+            && now - w->last_check >= g_health_interval * 1000.0;
+        if (check)
+            w->state = W_BUSY;
+        pthread_mutex_unlock(&g_lock);
+
+        if (state == W_DOWN && now >= w->next_start) {
+            pthread_mutex_lock(&g_lock);
+            w->state = W_STARTING;
+            pthread_mutex_unlock(&g_lock);
+            if (worker_spawn(i) != 0)
+                worker_retire(i, 1);
+        } else if (state == W_STARTING && now - w->since > INIT_TIMEOUT_MS) {
+            fprintf(stderr, "slimlo_server: worker %d did not start in time\n", i);
+            worker_retire(i, 1);
+        } else if (check) {
+            if (health_check(i) == 0) {
+                worker_release(i);
+            } else {
+                fprintf(stderr, "slimlo_server: worker %d failed its health check, restarting\n", i);
+                worker_retire(i, 0);
+            }
+        }
+    }
+}
+
+static void on_signal(int sig) {
+    (void)sig;
+    g_stop = 1;
+    wake_supervisor();
+}
+
+/* Refuse to take over a live server's socket; remove a stale one. */
+static int open_listener(void) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(g_socket_path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "slimlo_server: socket path too long: %s\n", g_socket_path);
+        return -1;
+    }
+    strcpy(addr.sun_path, g_socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == 0) {
+        fprintf(stderr, "slimlo_server: a server is already listening on %s\n", g_socket_path);
+        close(fd);
+        return -1;
+    }
+    close(fd);
+    struct stat st;
+    if (lstat(g_socket_path, &st) == 0 && S_ISSOCK(st.st_mode))
+        unlink(g_socket_path);
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+    set_cloexec(fd);
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0
+        || chmod(g_socket_path, (mode_t)g_socket_mode) != 0
+        || listen(fd, 64) != 0) {
+        fprintf(stderr, "slimlo_server: cannot listen on %s: %s\n", g_socket_path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void accept_client(int listen_fd) {
+    int fd = accept(listen_fd, NULL, NULL);
+    if (fd < 0)
+        return;
+    set_cloexec(fd);
+
+    Connection* c = (Connection*)calloc(1, sizeof(Connection));
+    pthread_mutex_lock(&g_lock);
+    Group* g = c ? group_join(peer_key(fd)) : NULL;
+    pthread_mutex_unlock(&g_lock);
+    if (!g) {
+        free(c);
+        close(fd);
+        return;
+    }
+    c->fd = fd;
+    c->group = g;
+
+    pthread_t thread;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    if (pthread_create(&thread, &attr, connection_main, c) != 0) {
+        close(fd);
+        pthread_mutex_lock(&g_lock);
+        group_leave(g);
+        pthread_mutex_unlock(&g_lock);
+        free(c);
+    }
+    pthread_attr_destroy(&attr);
+}
+
+/* Ask idle workers to quit so they remove their profiles; kill the rest. */
+static void shutdown_workers(void) {
+    pthread_mutex_lock(&g_lock);
+    g_stop = 1;
+    pthread_cond_broadcast(&g_changed);
+    for (int i = 0; i < g_worker_count; i++) {
+        Worker* w = &g_workers[i];
+        if (w->pid <= 0)
+            continue;
+        if (w->state == W_IDLE) {
+            cJSON* quit = cJSON_CreateObject();
+            cJSON_AddStringToObject(quit, "type", "quit");
+            json_write(w->to_fd, quit);
+        } else {
+            kill(w->pid, SIGKILL);
+        }
+    }
+    pthread_mutex_unlock(&g_lock);
+
+    double deadline = monotonic_ms() + 5000;
+    for (int i = 0; i < g_worker_count; i++) {
+        pid_t pid = g_workers[i].pid;
+        if (pid <= 0)
+            continue;
+        while (waitpid(pid, NULL, WNOHANG) == 0) {
+            if (monotonic_ms() > deadline) {
+                kill(pid, SIGKILL);
+                waitpid(pid, NULL, 0);
+                break;
+            }
+            struct timespec pause = { 0, 50 * 1000 * 1000 };
+            nanosleep(&pause, NULL);
+        }
+    }
+}
+
+static int usage(void) {
+    fprintf(stderr,
+        "usage: slimlo_server --socket PATH --resource-path DIR [--workers N]\n"
+        "                     [--font-path DIR]... [--threads N]\n"
+        "                     [--health-interval SEC] [--socket-mode OCTAL]\n");
+    return 2;
+}
+
+static void resolve_self(const char* argv0) {
+#ifdef __linux__
+    ssize_t n = readlink("/proc/self/exe", g_self, sizeof(g_self) - 1);
+    if (n > 0) {
+        g_self[n] = '\0';
+        return;
+    }
+#endif
+    if (!realpath(argv0, g_self))
+        snprintf(g_self, sizeof(g_self), "%s", argv0);
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "--worker") == 0)
+        return worker_main();
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!value)
+            return usage();
+        if (strcmp(arg, "--socket") == 0)
+            g_socket_path = value;
+        else if (strcmp(arg, "--resource-path") == 0)
+            g_resource_path = value;
+        else if (strcmp(arg, "--workers") == 0)
+            g_worker_count = atoi(value);
+        else if (strcmp(arg, "--threads") == 0)
+            g_threads = atoi(value);
+        else if (strcmp(arg, "--health-interval") == 0)
+            g_health_interval = atoi(value);
+        else if (strcmp(arg, "--socket-mode") == 0)
+            g_socket_mode = (int)strtol(value, NULL, 8);
+        else if (strcmp(arg, "--font-path") == 0) {
+            if (!g_font_paths)
+                g_font_paths = cJSON_CreateArray();
+            cJSON_AddItemToArray(g_font_paths, cJSON_CreateString(value));
+        } else
+            return usage();
+        i++;
+    }
+    if (!g_socket_path || !g_resource_path || g_worker_count < 1 || g_worker_count > MAX_WORKERS)
+        return usage();
+
+    resolve_self(argv[0]);
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGTERM, on_signal);
+    signal(SIGINT, on_signal);
+
+    if (pipe(g_wake) != 0)
+        return 1;
+    set_cloexec(g_wake[0]);
+    set_cloexec(g_wake[1]);
+    fcntl(g_wake[0], F_SETFL, O_NONBLOCK);
+    fcntl(g_wake[1], F_SETFL, O_NONBLOCK);
+
+    int listen_fd = open_listener();
+    if (listen_fd < 0)
+        return 1;
+    for (int i = 0; i < g_worker_count; i++) {
+        g_workers[i].to_fd = g_workers[i].from_fd = -1;
+        g_workers[i].state = W_DOWN;
+    }
+
+    while (!g_stop) {
+        housekeeping();
+
+        struct pollfd fds[2 + MAX_WORKERS];
+        int starting[MAX_WORKERS];
+        int n = 0, count = 0;
+        fds[n++] = (struct pollfd){ listen_fd, POLLIN, 0 };
+        fds[n++] = (struct pollfd){ g_wake[0], POLLIN, 0 };
+        pthread_mutex_lock(&g_lock);
+        for (int i = 0; i < g_worker_count; i++) {
+            if (g_workers[i].state == W_STARTING) {
+                starting[count++] = i;
+                fds[n++] = (struct pollfd){ g_workers[i].from_fd, POLLIN, 0 };
+            }
+        }
+        pthread_mutex_unlock(&g_lock);
+
+        if (poll(fds, (nfds_t)n, 1000) < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        if (fds[0].revents)
+            accept_client(listen_fd);
+        if (fds[1].revents) {
+            char drain[64];
+            while (read(g_wake[0], drain, sizeof(drain)) > 0) {}
+        }
+        for (int k = 0; k < count; k++)
+            if (fds[2 + k].revents)
+                finish_start(starting[k]);
+    }
+
+    close(listen_fd);
+    unlink(g_socket_path);
+    shutdown_workers();
+    return 0;
+}
@@ -0,0 +1,729 @@
+/*
+ * slimlo_simulate.c — Simulated SlimLO backend (slimlo_worker --simulate)
+ *
+ * Every call sleeps for a sampled latency instead of loading LibreOffice,
+ * then produces output of a sampled size: a PDF-shaped buffer or file,
+ * A4 page metadata, and page images (raw RGBA at the requested width, or a
+ * 1x1 placeholder PNG). Progress, page image and page text callbacks fire
+ * in the same order as the real API, so side outputs and progress frames
+ * cross the protocol as they would. Failures and crashes are injected with
+ * the configured probabilities.
+ *
+ * Single-threaded, like the worker: one instance, one request at a time.
+ */
+
+#include "slimlo_simulate.h"
+
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+  #include <windows.h>
+  #include <process.h>
+  #define getpid _getpid
+#else
+  #include <unistd.h>
+#endif
+
+typedef enum {
+    DIST_CONSTANT,
+    DIST_UNIFORM,
+    DIST_LOGNORMAL,
+    DIST_EXP
+} DistKind;
+
+typedef struct {
+    DistKind kind;
+    double a;  /* constant, min, median or mean */
+    double b;  /* max or sigma */
+} Dist;
+
+#define A4_WIDTH_PT  595.3
+#define A4_HEIGHT_PT 841.9
+
+static struct {
+    Dist latency;
+    Dist size;
+    Dist pages;
+    Dist startup;
+    double fail;
+    double crash;
+    uint64_t rng;
+    int initialized;
+    char error[256];
+
+    SlimLOProgressCallback on_progress;
+    void* progress_data;
+
+    SlimLOPageImageCallback on_image;
+    void* image_data;
+    SlimLORenderOptions image_opts;
+    char image_range[256];
+
+    SlimLOPageTextCallback on_text;
+    void* text_data;
+    int text_words;
+    int text_ranged;
+    char text_range[256];
+} g_sim;
+
+/* 1x1 transparent PNG */
+static const uint8_t PLACEHOLDER_PNG[] = {
+    0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D,
+    0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01,
+    0x08, 0x06, 0x00, 0x00, 0x00, 0x1F, 0x15, 0xC4, 0x89, 0x00, 0x00, 0x00,
+    0x0A, 0x49, 0x44, 0x41, 0x54, 0x78, 0x9C, 0x63, 0x00, 0x01, 0x00, 0x00,
+    0x05, 0x00, 0x01, 0x0D, 0x0A, 0x2D, 0xB4, 0x00, 0x00, 0x00, 0x00, 0x49,
+    0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82
+};
+
+static const char PDF_HEADER[] = "%PDF-1.7\n%\xE2\xE3\xCF\xD3\n";
+static const char PDF_TRAILER[] = "\n%%EOF\n";
+
+static void set_error(const char* message) {
+    snprintf(g_sim.error, sizeof(g_sim.error), "%s", message);
+}
+
+/* --------------------------------------------------------------------------
+ * Random sampling (xorshift64*)
+ * -------------------------------------------------------------------------- */
+
+static uint64_t next_u64(void) {
+    uint64_t x = g_sim.rng;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    g_sim.rng = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/* Uniform in [0, 1) */
+static double next_unit(void) {
+    return (double)(next_u64() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static double sample(const Dist* dist) {
+    double value;
+    switch (dist->kind) {
+        case DIST_UNIFORM:
+            value = dist->a + (dist->b - dist->a) * next_unit();
+            break;
+        case DIST_LOGNORMAL: {
+            /* Box-Muller; 1 - u keeps the log argument in (0, 1] */
+            double z = sqrt(-2.0 * log(1.0 - next_unit())) * cos(6.283185307179586 * next_unit());
+            value = dist->a * exp(dist->b * z);
+            break;
+        }
+        case DIST_EXP:
+            value = -dist->a * log(1.0 - next_unit());
+            break;
+        default:
+            value = dist->a;
+            break;
+    }
+    return value > 0 ? value : 0;
+}
+
+static int parse_dist(const char* text, Dist* dist) {
+    char* end;
+    memset(dist, 0, sizeof(*dist));
+    if (strncmp(text, "uniform:", 8) == 0) {
+        dist->kind = DIST_UNIFORM;
+        dist->a = strtod(text + 8, &end);
+        if (*end != ':') return 0;
+        dist->b = strtod(end + 1, &end);
+        return *end == '\0' && dist->b >= dist->a;
+    }
+    if (strncmp(text, "lognormal:", 10) == 0) {
+        dist->kind = DIST_LOGNORMAL;
+        dist->a = strtod(text + 10, &end);
+        if (*end != ':') return 0;
+        dist->b = strtod(end + 1, &end);
+        return *end == '\0' && dist->a > 0 && dist->b >= 0;
+    }
+    if (strncmp(text, "exp:", 4) == 0) {
+        dist->kind = DIST_EXP;
+        dist->a = strtod(text + 4, &end);
+        return *end == '\0' && dist->a >= 0;
+    }
+    dist->kind = DIST_CONSTANT;
+    dist->a = strtod(text, &end);
+    return end != text && *end == '\0' && dist->a >= 0;
+}
+
+static void sleep_ms(double ms) {
+    if (ms <= 0) return;
+#ifdef _WIN32
+    Sleep((DWORD)(ms + 0.5));
+#else
+    struct timespec ts;
+    ts.tv_sec = (time_t)(ms / 1000.0);
+    ts.tv_nsec = (long)((ms - (double)ts.tv_sec * 1000.0) * 1e6);
+    while (nanosleep(&ts, &ts) != 0) {}
+#endif
+}
+
+/* --------------------------------------------------------------------------
+ * Simulated documents
+ * -------------------------------------------------------------------------- */
+
+/* Whether 1-based page is in range ("1", "1-3,5", "2-"); an empty range
+ * selects every page if all is set, else the first */
+static int page_selected(const char* range, int page, int all) {
+    const char* p = range;
+    if (!p || !*p) return all || page == 1;
+    while (*p) {
+        char* end;
+        long from = strtol(p, &end, 10), to = from;
+        if (end == p) return 0;
+        p = end;
+        if (*p == '-') {
+            p++;
+            to = LONG_MAX;
+            if (*p >= '0' && *p <= '9') {
+                to = strtol(p, &end, 10);
+                p = end;
+            }
+        }
+        if (page >= from && page <= to) return 1;
+        while (*p == ',' || *p == ' ') p++;
+    }
+    return 0;
+}
+
+static void report(SlimLOProgressPhase phase, int percent, int laid_out,
+                   int exported, uint64_t bytes) {
+    SlimLOProgress progress;
+    if (!g_sim.on_progress) return;
+    memset(&progress, 0, sizeof(progress));
+    progress.phase = phase;
+    progress.percent = percent;
+    progress.pages_laid_out = laid_out;
+    progress.pages_exported = exported;
+    progress.bytes_written = bytes;
+    g_sim.on_progress(&progress, g_sim.progress_data);
+}
+
+/* Fill image with page rendered per opts; 0 if out of memory */
+static int make_image(int page, const SlimLORenderOptions* opts, SlimLOPageImage* image) {
+    memset(image, 0, sizeof(*image));
+    image->page = page;
+    image->format = opts ? opts->format : SLIMLO_IMAGE_PNG;
+    if (image->format == SLIMLO_IMAGE_RGBA) {
+        int width = opts && opts->width > 0 ? (opts->width < 8192 ? opts->width : 8192) : 256;
+        image->width = width;
+        image->height = (int)(width * A4_HEIGHT_PT / A4_WIDTH_PT + 0.5);
+        image->size = (size_t)image->width * (size_t)image->height * 4;
+        image->data = (uint8_t*)malloc(image->size);
+        if (image->data) memset(image->data, 0xFF, image->size);
+    } else {
+        image->width = image->height = 1;
+        image->size = sizeof(PLACEHOLDER_PNG);
+        image->data = (uint8_t*)malloc(image->size);
+        if (image->data) memcpy(image->data, PLACEHOLDER_PNG, image->size);
+    }
+    return image->data != NULL;
+}
+
+/* Page image callback, between layout and export */
+static SlimLOError emit_images(int pages) {
+    for (int page = 1; g_sim.on_image && page <= pages; page++) {
+        SlimLOPageImage image;
+        if (!page_selected(g_sim.image_opts.page_range, page, 0)) continue;
+        if (!make_image(page, &g_sim.image_opts, &image)) {
+            set_error("Out of memory rendering a page image");
+            return SLIMLO_ERROR_OUT_OF_MEMORY;
+        }
+        g_sim.on_image(&image, g_sim.image_data);
+        free(image.data);
+    }
+    return SLIMLO_OK;
+}
+
+/* Page text callback, after export */
+static void emit_text(int pages) {
+    for (int page = 1; g_sim.on_text && page <= pages; page++) {
+        char text[64];
+        SlimLOPageText page_text;
+        SlimLOWordBox word;
+        if (!page_selected(g_sim.text_ranged ? g_sim.text_range : NULL, page, 1)) continue;
+        snprintf(text, sizeof(text), "Simulated page %d", page);
+        memset(&page_text, 0, sizeof(page_text));
+        page_text.page = page;
+        page_text.size.width = A4_WIDTH_PT;
+        page_text.size.height = A4_HEIGHT_PT;
+        page_text.text = text;
+        if (g_sim.text_words) {
+            word.x = 72;
+            word.y = 72;
+            word.width = 80;
+            word.height = 12;
+            word.text = "Simulated";
+            page_text.words = &word;
+            page_text.word_count = 1;
+        }
+        g_sim.on_text(&page_text, g_sim.text_data);
+    }
+}
+
+/* Load and lay out one document: half the sampled latency when it will be
+ * exported (the export takes the other half), all of it otherwise */
+static SlimLOError simulate_load(int exporting, double* export_ms, int* pages) {
+    double latency;
+    if (!g_sim.initialized) {
+        set_error("Not initialized");
+        return SLIMLO_ERROR_NOT_INIT;
+    }
+    if (g_sim.crash > 0 && next_unit() < g_sim.crash)
+        abort();
+
+    latency = sample(&g_sim.latency);
+    *pages = (int)sample(&g_sim.pages);
+    if (*pages < 1) *pages = 1;
+    *export_ms = exporting ? latency / 2 : 0;
+
+    report(SLIMLO_PROGRESS_LOAD, 0, 0, 0, 0);
+    sleep_ms(latency - *export_ms);
+    if (g_sim.fail > 0 && next_unit() < g_sim.fail) {
+        set_error("Simulated load failure");
+        return SLIMLO_ERROR_LOAD_FAILED;
+    }
+    report(SLIMLO_PROGRESS_LAYOUT, 100, *pages, 0, 0);
+    return SLIMLO_OK;
+}
+
+static size_t pdf_size(void) {
+    size_t minimum = sizeof(PDF_HEADER) - 1 + sizeof(PDF_TRAILER) - 1;
+    size_t size = (size_t)sample(&g_sim.size);
+    return size > minimum ? size : minimum;
+}
+
+/* PDF-shaped bytes: header, padding, trailer */
+static uint8_t* make_pdf(size_t size) {
+    uint8_t* pdf = (uint8_t*)malloc(size);
+    if (!pdf) return NULL;
+    memset(pdf, ' ', size);
+    memcpy(pdf, PDF_HEADER, sizeof(PDF_HEADER) - 1);
+    memcpy(pdf + size - (sizeof(PDF_TRAILER) - 1), PDF_TRAILER, sizeof(PDF_TRAILER) - 1);
+    return pdf;
+}
+
+/* Export: images, the other half of the latency, then text */
+static SlimLOError simulate_export(double export_ms, int pages) {
+    SlimLOError err = emit_images(pages);
+    if (err != SLIMLO_OK) return err;
+    report(SLIMLO_PROGRESS_EXPORT, 0, pages, 0, 0);
+    sleep_ms(export_ms);
+    report(SLIMLO_PROGRESS_EXPORT, 100, pages, pages, 0);
+    return SLIMLO_OK;
+}
+
+static int file_exists(const char* path) {
+    struct stat st;
+    return path && stat(path, &st) == 0;
+}
+
+static SlimLOError write_pdf(const char* output_path, size_t size) {
+    uint8_t* pdf = make_pdf(size);
+    FILE* f;
+    int ok;
+    if (!pdf) {
+        set_error("Out of memory");
+        return SLIMLO_ERROR_OUT_OF_MEMORY;
+    }
+    f = fopen(output_path, "wb");
+    ok = f && fwrite(pdf, 1, size, f) == size;
+    if (f && fclose(f) != 0) ok = 0;
+    free(pdf);
+    if (!ok) {
+        set_error("Cannot write output file");
+        return SLIMLO_ERROR_EXPORT_FAILED;
+    }
+    return SLIMLO_OK;
+}
+
+/* --------------------------------------------------------------------------
+ * Backend entry points
+ * -------------------------------------------------------------------------- */
+
+static SlimLOHandle sim_init_ex(const char* resource_path, const SlimLOInitOptions* options) {
+    (void)resource_path; (void)options;
+    if (g_sim.initialized) {
+        set_error("SlimLO already initialized");
+        return NULL;
+    }
+    sleep_ms(sample(&g_sim.startup));
+    g_sim.initialized = 1;
+    g_sim.error[0] = '\0';
+    return (SlimLOHandle)(void*)&g_sim;
+}
+
+static void sim_destroy(SlimLOHandle handle) {
+    (void)handle;
+    g_sim.initialized = 0;
+    g_sim.on_progress = NULL;
+    g_sim.on_image = NULL;
+    g_sim.on_text = NULL;
+}
+
+static SlimLOError sim_combine_to_pdf(SlimLOHandle handle, const SlimLOCombinePart* parts,
+                                      int part_count, const char* output_path,
+                                      const SlimLOPdfOptions* options) {
+    double export_ms = 0;
+    int pages = 0;
+    size_t size = 0;
+    SlimLOError err;
+    (void)handle; (void)options;
+
+    if (!parts || part_count <= 0 || !output_path) {
+        set_error("Invalid arguments");
+        return SLIMLO_ERROR_INVALID_ARGUMENT;
+    }
+    for (int i = 0; i < part_count; i++) {
+        double part_export_ms;
+        int part_pages;
+        if (!file_exists(parts[i].input_path)) {
+            set_error("Input file not found");
+            return SLIMLO_ERROR_FILE_NOT_FOUND;
+        }
+        err = simulate_load(1, &part_export_ms, &part_pages);
+        if (err != SLIMLO_OK) return err;
+        export_ms += part_export_ms;
+        pages += part_pages;
+        size += pdf_size();
+    }
+
+    err = simulate_export(export_ms, pages);
+    if (err == SLIMLO_OK)
+        err = write_pdf(output_path, size);
+    if (err != SLIMLO_OK) return err;
+    report(SLIMLO_PROGRESS_DONE, 100, pages, pages, size);
+    emit_text(pages);
+    g_sim.error[0] = '\0';
+    return SLIMLO_OK;
+}
+
+static SlimLOError sim_convert_file(SlimLOHandle handle, const char* input_path,
+                                    const char* output_path, SlimLOFormat format_hint,
+                                    const SlimLOPdfOptions* options) {
+    SlimLOCombinePart part;
+    (void)format_hint;
+    part.input_path = input_path;
+    part.bookmark = NULL;
+    return sim_combine_to_pdf(handle, &part, 1, output_path, options);
+}
+
+static SlimLOError sim_convert_buffer(SlimLOHandle handle, const uint8_t* input_data,
+                                      size_t input_size, SlimLOFormat format_hint,
+                                      const SlimLOPdfOptions* options,
+                                      uint8_t** output_data, size_t* output_size) {
+    double export_ms;
+    int pages;
+    size_t size;
+    SlimLOError err;
+    (void)handle; (void)format_hint; (void)options;
+
+    if (!input_data || input_size == 0 || !output_data || !output_size) {
+        set_error("Invalid arguments");
+        return SLIMLO_ERROR_INVALID_ARGUMENT;
+    }
+    *output_data = NULL;
+    *output_size = 0;
+
+    err = simulate_load(1, &export_ms, &pages);
+    if (err == SLIMLO_OK)
+        err = simulate_export(export_ms, pages);
+    if (err != SLIMLO_OK) return err;
+
+    size = pdf_size();
+    if (!(*output_data = make_pdf(size))) {
+        set_error("Out of memory");
+        return SLIMLO_ERROR_OUT_OF_MEMORY;
+    }
+    *output_size = size;
+    report(SLIMLO_PROGRESS_DONE, 100, pages, pages, size);
+    emit_text(pages);
+    g_sim.error[0] = '\0';
+    return SLIMLO_OK;
+}
+
+static void sim_free_buffer(uint8_t* buffer) {
+    free(buffer);
+}
+
+static SlimLOError sim_document_info_buffer(SlimLOHandle handle, const uint8_t* input_data,
+                                            size_t input_size, SlimLOFormat format_hint,
+                                            SlimLODocumentInfo* info) {
+    double export_ms;
+    int pages;
+    SlimLOError err;
+    (void)handle; (void)format_hint;
+
+    if (!info) {
+        set_error("Invalid arguments");
+        return SLIMLO_ERROR_INVALID_ARGUMENT;
+    }
+    memset(info, 0, sizeof(*info));
+    if (!input_data || input_size == 0) {
+        set_error("Invalid arguments");
+        return SLIMLO_ERROR_INVALID_ARGUMENT;
+    }
+
+    err = simulate_load(0, &export_ms, &pages);
+    if (err != SLIMLO_OK) return err;
+
+    info->pages = (SlimLOPageSize*)malloc(sizeof(SlimLOPageSize) * (size_t)pages);
+    info->fonts = (char**)malloc(sizeof(char*));
+    if (!info->pages || !info->fonts || !(info->fonts[0] = (char*)malloc(sizeof("Liberation Serif")))) {
+        free(info->pages);
+        free(info->fonts);
+        memset(info, 0, sizeof(*info));
+        set_error("Out of memory");
+        return SLIMLO_ERROR_OUT_OF_MEMORY;
+    }
+    for (int i = 0; i < pages; i++) {
+        info->pages[i].width = A4_WIDTH_PT;
+        info->pages[i].height = A4_HEIGHT_PT;
+    }
+    memcpy(info->fonts[0], "Liberation Serif", sizeof("Liberation Serif"));
+    info->page_count = pages;
+    info->section_count = 1;
+    info->word_count = pages * 300;
+    info->font_count = 1;
+    g_sim.error[0] = '\0';
+    return SLIMLO_OK;
+}
+
+static SlimLOError sim_document_info(SlimLOHandle handle, const char* input_path,
+                                     SlimLODocumentInfo* info) {
+    static const uint8_t placeholder = 0;
+    if (info) memset(info, 0, sizeof(*info));
+    if (!file_exists(input_path)) {
+        set_error("Input file not found");
+        return SLIMLO_ERROR_FILE_NOT_FOUND;
+    }
+    return sim_document_info_buffer(handle, &placeholder, 1, SLIMLO_FORMAT_DOCX, info);
+}
+
+static void sim_free_document_info(SlimLODocumentInfo* info) {
+    if (!info) return;
+    free(info->pages);
+    for (int i = 0; info->fonts && i < info->font_count; i++)
+        free(info->fonts[i]);
+    free(info->fonts);
+    for (int i = 0; info->missing_fonts && i < info->missing_font_count; i++)
+        free(info->missing_fonts[i]);
+    free(info->missing_fonts);
+    memset(info, 0, sizeof(*info));
+}
+
+static void sim_free_page_images(SlimLOPageImage* images, int count) {
+    if (!images) return;
+    for (int i = 0; i < count; i++)
+        free(images[i].data);
+    free(images);
+}
+
+static SlimLOError sim_render_pages_buffer(SlimLOHandle handle, const uint8_t* input_data,
+                                           size_t input_size, SlimLOFormat format_hint,
+                                           const SlimLORenderOptions* options,
+                                           SlimLOPageImage** images, int* image_count) {
+    double export_ms;
+    int pages, count = 0;
+    SlimLOError err;
+    (void)handle; (void)format_hint;
+
+    if (!images || !image_count || !input_data || input_size == 0) {
+        set_error("Invalid arguments");
+        return SLIMLO_ERROR_INVALID_ARGUMENT;
+    }
+    *images = NULL;
+    *image_count = 0;
+
+    err = simulate_load(0, &export_ms, &pages);
+    if (err != SLIMLO_OK) return err;
+
+    *images = (SlimLOPageImage*)calloc((size_t)pages, sizeof(SlimLOPageImage));
+    for (int page = 1; *images && page <= pages; page++) {
+        if (!page_selected(options ? options->page_range : NULL, page, 0)) continue;
+        if (!make_image(page, options, &(*images)[count])) {
+            sim_free_page_images(*images, count);
+            *images = NULL;
+            break;
+        }
+        count++;
+    }
+    if (!*images) {
+        set_error("Out of memory rendering a page image");
+        return SLIMLO_ERROR_OUT_OF_MEMORY;
+    }
+    *image_count = count;
+    g_sim.error[0] = '\0';
+    return SLIMLO_OK;
+}
+
+static SlimLOError sim_render_pages(SlimLOHandle handle, const char* input_path,
+                                    const SlimLORenderOptions* options,
+                                    SlimLOPageImage** images, int* image_count) {
+    static const uint8_t placeholder = 0;
+    if (!file_exists(input_path)) {
+        if (images) *images = NULL;
+        if (image_count) *image_count = 0;
+        set_error("Input file not found");
+        return SLIMLO_ERROR_FILE_NOT_FOUND;
+    }
+    return sim_render_pages_buffer(handle, &placeholder, 1, SLIMLO_FORMAT_DOCX,
+                                   options, images, image_count);
+}
+
+static SlimLOError sim_set_page_image_callback(SlimLOHandle handle,
+                                               const SlimLORenderOptions* options,
+                                               SlimLOPageImageCallback callback,
+                                               void* user_data) {
+    (void)handle;
+    g_sim.on_image = callback;
+    g_sim.image_data = user_data;
+    memset(&g_sim.image_opts, 0, sizeof(g_sim.image_opts));
+    g_sim.image_range[0] = '\0';
+    if (options) {
+        g_sim.image_opts = *options;
+        if (options->page_range) {
+            snprintf(g_sim.image_range, sizeof(g_sim.image_range), "%s", options->page_range);
+            g_sim.image_opts.page_range = g_sim.image_range;
+        }
+    }
+    return SLIMLO_OK;
+}
+
+static SlimLOError sim_set_page_text_callback(SlimLOHandle handle,
+                                              const SlimLOTextOptions* options,
+                                              SlimLOPageTextCallback callback,
+                                              void* user_data) {
+    (void)handle;
+    g_sim.on_text = callback;
+    g_sim.text_data = user_data;
+    g_sim.text_words = options && options->include_words;
+    g_sim.text_ranged = options && options->page_range;
+    snprintf(g_sim.text_range, sizeof(g_sim.text_range), "%s",
+             g_sim.text_ranged ? options->page_range : "");
+    return SLIMLO_OK;
+}
+
+static void sim_set_progress_callback(SlimLOHandle handle, SlimLOProgressCallback callback,
+                                      void* user_data) {
+    (void)handle;
+    g_sim.on_progress = callback;
+    g_sim.progress_data = user_data;
+}
+
+static SlimLOError sim_add_font_directory(SlimLOHandle handle, const char* path) {
+    struct stat st;
+    (void)handle;
+    if (!path || !*path) {
+        set_error("Font directory path is empty");
+        return SLIMLO_ERROR_INVALID_ARGUMENT;
+    }
+    if (stat(path, &st) != 0 || !S_ISDIR(st.st_mode)) {
+        set_error("Font directory not found");
+        return SLIMLO_ERROR_FILE_NOT_FOUND;
+    }
+    g_sim.error[0] = '\0';
+    return SLIMLO_OK;
+}
+
+static const char* sim_get_error_message(SlimLOHandle handle) {
+    (void)handle;
+    return g_sim.error;
+}
+
+static const char* sim_version(void) {
+    return "SlimLO simulated";
+}
+
+static const SlimLOBackend SIMULATED_BACKEND = {
+    sim_init_ex,
+    sim_destroy,
+    sim_convert_file,
+    sim_combine_to_pdf,
+    sim_convert_buffer,
+    sim_free_buffer,
+    sim_document_info,
+    sim_document_info_buffer,
+    sim_free_document_info,
+    sim_render_pages,
+    sim_render_pages_buffer,
+    sim_free_page_images,
+    sim_set_page_image_callback,
+    sim_set_page_text_callback,
+    sim_set_progress_callback,
+    sim_add_font_directory,
+    sim_get_error_message,
+    sim_version
+};
+
+const SlimLOBackend* slimlo_simulate_backend(const char* spec, char* error, size_t error_size) {
+    char buf[1024];
+    char* item = buf;
+
+    memset(&g_sim, 0, sizeof(g_sim));
+    g_sim.size.a = 65536;
+    g_sim.pages.a = 1;
+    g_sim.rng = (uint64_t)time(NULL) * 0x9E3779B97F4A7C15ULL ^ (uint64_t)getpid();
+
+    if (!spec) spec = "";
+    if (strlen(spec) >= sizeof(buf)) {
+        snprintf(error, error_size, "simulation spec too long");
+        return NULL;
+    }
+    memcpy(buf, spec, strlen(spec) + 1);
+
+    while (item && *item) {
+        char* next = strchr(item, ',');
+        char* value;
+        int ok;
+        if (next) *next++ = '\0';
+        value = strchr(item, '=');
+        if (!value) {
+            snprintf(error, error_size, "expected key=value in simulation spec: '%s'", item);
+            return NULL;
+        }
+        *value++ = '\0';
+
+        if (strcmp(item, "latency") == 0) {
+            ok = parse_dist(value, &g_sim.latency);
+        } else if (strcmp(item, "size") == 0) {
+            ok = parse_dist(value, &g_sim.size);
+        } else if (strcmp(item, "pages") == 0) {
+            ok = parse_dist(value, &g_sim.pages);
+        } else if (strcmp(item, "startup") == 0) {
+            ok = parse_dist(value, &g_sim.startup);
+        } else if (strcmp(item, "fail") == 0 || strcmp(item, "crash") == 0) {
+            char* end;
+            double p = strtod(value, &end);
+            ok = end != value && *end == '\0' && p >= 0 && p <= 1;
+            if (item[0] == 'f') g_sim.fail = p;
+            else g_sim.crash = p;
+        } else if (strcmp(item, "seed") == 0) {
+            char* end;
+            g_sim.rng = (uint64_t)strtoull(value, &end, 10);
+            ok = end != value && *end == '\0';
+        } else {
+            snprintf(error, error_size, "unknown simulation key '%s'", item);
+            return NULL;
+        }
+        if (!ok) {
+            snprintf(error, error_size, "invalid simulation value %s=%s", item, value);
+            return NULL;
+        }
+        item = next;
+    }
+
+    /* xorshift must not start at zero */
+    if (g_sim.rng == 0) g_sim.rng = 0x9E3779B97F4A7C15ULL;
+    return &SIMULATED_BACKEND;
+}
@@ -0,0 +1,86 @@
+/*
+ * slimlo_simulate.h — Simulated SlimLO backend for slimlo_worker --simulate
+ *
+ * The worker reaches SlimLO through a SlimLOBackend table: the C API, or a
+ * simulation that answers every call from configurable latency and size
+ * distributions without loading LibreOffice. The worker protocol on top is
+ * unchanged, so SDK pools, framing and queueing can be benchmarked and
+ * tuned without a LibreOffice build, and without real conversions drowning
+ * out SDK overhead.
+ */
+
+#ifndef SLIMLO_SIMULATE_H
+#define SLIMLO_SIMULATE_H
+
+#include "slimlo.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The SlimLO entry points the worker uses, with the C API's signatures */
+typedef struct {
+    SlimLOHandle (*init_ex)(const char* resource_path, const SlimLOInitOptions* options);
+    void (*destroy)(SlimLOHandle handle);
+    SlimLOError (*convert_file)(SlimLOHandle handle, const char* input_path,
+                                const char* output_path, SlimLOFormat format_hint,
+                                const SlimLOPdfOptions* options);
+    SlimLOError (*combine_to_pdf)(SlimLOHandle handle, const SlimLOCombinePart* parts,
+                                  int part_count, const char* output_path,
+                                  const SlimLOPdfOptions* options);
+    SlimLOError (*convert_buffer)(SlimLOHandle handle, const uint8_t* input_data,
+                                  size_t input_size, SlimLOFormat format_hint,
+                                  const SlimLOPdfOptions* options,
+                                  uint8_t** output_data, size_t* output_size);
+    void (*free_buffer)(uint8_t* buffer);
+    SlimLOError (*document_info)(SlimLOHandle handle, const char* input_path,
+                                 SlimLODocumentInfo* info);
+    SlimLOError (*document_info_buffer)(SlimLOHandle handle, const uint8_t* input_data,
+                                        size_t input_size, SlimLOFormat format_hint,
+                                        SlimLODocumentInfo* info);
+    void (*free_document_info)(SlimLODocumentInfo* info);
+    SlimLOError (*render_pages)(SlimLOHandle handle, const char* input_path,
+                                const SlimLORenderOptions* options,
+                                SlimLOPageImage** images, int* image_count);
+    SlimLOError (*render_pages_buffer)(SlimLOHandle handle, const uint8_t* input_data,
+                                       size_t input_size, SlimLOFormat format_hint,
+                                       const SlimLORenderOptions* options,
+                                       SlimLOPageImage** images, int* image_count);
+    void (*free_page_images)(SlimLOPageImage* images, int count);
+    SlimLOError (*set_page_image_callback)(SlimLOHandle handle,
+                                           const SlimLORenderOptions* options,
+                                           SlimLOPageImageCallback callback, void* user_data);
+    SlimLOError (*set_page_text_callback)(SlimLOHandle handle,
+                                          const SlimLOTextOptions* options,
+                                          SlimLOPageTextCallback callback, void* user_data);
+    void (*set_progress_callback)(SlimLOHandle handle, SlimLOProgressCallback callback,
+                                  void* user_data);
+    SlimLOError (*add_font_directory)(SlimLOHandle handle, const char* path);
+    const char* (*get_error_message)(SlimLOHandle handle);
+    const char* (*version)(void);
+} SlimLOBackend;
+
+/**
+ * The simulated backend, configured by spec: comma-separated key=value
+ * pairs, all optional ("" = defaults):
+ *
+ *   latency=DIST   Milliseconds per conversion, info or render (default 0)
+ *   size=DIST      PDF bytes per conversion (default 65536)
+ *   pages=DIST     Pages per document (default 1)
+ *   startup=DIST   Milliseconds spent in init, as LibreOffice's start (default 0)
+ *   fail=P         Probability a request fails with SLIMLO_ERROR_LOAD_FAILED
+ *   crash=P        Probability the worker aborts mid-request
+ *   seed=N         Random seed (default: time and process id)
+ *
+ * DIST is a constant ("50"), "uniform:MIN:MAX", "lognormal:MEDIAN:SIGMA"
+ * or "exp:MEAN".
+ *
+ * @return The backend, or NULL with a message in error if spec is invalid.
+ */
+const SlimLOBackend* slimlo_simulate_backend(const char* spec, char* error, size_t error_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SLIMLO_SIMULATE_H */
@@ -8,20 +8,42 @@
  *
  * Protocol:
  *   Each message is framed as: [4-byte LE uint32 length][UTF-8 JSON]
+ *   Binary bodies follow their JSON header as one frame of "data_size"
+ *   bytes, or, for convert_buffer requests with "chunked": true, as any
+ *   number of non-empty frames terminated by a zero-length frame
  *
  * Lifecycle:
- *   1. Read "init" message → set SAL_FONTPATH → call slimlo_init()
+ *   1. Read "init" message → set SAL_FONTPATH, pin to "cpus" if given
+ *      → call slimlo_init()
  *   2. Loop: read "convert" → convert → capture stderr → write result
+ *      (requests with "progress": true also get "progress" frames first);
+ *      "info" loads and lays out the document and reports its metadata;
+ *      "render" loads the document and returns page images;
+ *      convert requests may also ask for page images and page text;
+ *      "combine" converts a list of "inputs" into one PDF;
+ *      "add_fonts" registers more font "paths" without a restart;
+ *      "ping" is answered with "pong" (slimlo_server health checks)
  *   3. On "quit" or stdin EOF → slimlo_destroy() → exit
+ *
+ * With --simulate[=SPEC], or SLIMLO_SIMULATE=SPEC in the environment, the
+ * same protocol is served by a simulated backend that never loads
+ * LibreOffice (see slimlo_simulate.h), for benchmarking the SDKs.
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+  #define _GNU_SOURCE /* sched_setaffinity, CPU_SET */
+#endif
+
 #include "slimlo.h"
+#include "slimlo_simulate.h"
 #include "cjson/cJSON.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
+#include <time.h>
+#include <sys/stat.h>
 
 #ifdef _WIN32
   #include <io.h>
@@ -48,6 +70,13 @@
   #define FILENO     fileno
   #define PIPE(fds)  pipe(fds)
   #define PATH_SEP   ":"
+  #ifdef __linux__
+    #include <sched.h>
+    #include <sys/syscall.h>
+    #ifndef MPOL_LOCAL
+      #define MPOL_LOCAL 4 /* linux/mempolicy.h */
+    #endif
+  #endif
 #endif
 
 #ifdef __APPLE__
@@ -62,6 +91,9 @@
 /* Maximum message size: 256 MB (documents can be large for buffer conversions) */
 #define MAX_MSG_SIZE (256 * 1024 * 1024)
 
+/* Frame size for chunked PDF output: 1 MB */
+#define CHUNK_SIZE (1024 * 1024)
+
 /* --------------------------------------------------------------------------
  * Binary I/O helpers
  * -------------------------------------------------------------------------- */
@@ -140,6 +172,79 @@ static int write_message(const char* data, size_t len) {
     return 0;
 }
 
+/* Discard exactly n bytes from stdin. Returns 0 on success, -1 on error/EOF. */
+static int skip_exact(size_t n) {
+    char scratch[64 * 1024];
+    while (n > 0) {
+        size_t step = n < sizeof(scratch) ? n : sizeof(scratch);
+        if (read_exact(stdin_fd, scratch, step) != 0)
+            return -1;
+        n -= step;
+    }
+    return 0;
+}
+
+/* Read a chunked body (frames up to a zero-length terminator) into one
+ * buffer. Caller must free() the returned buffer. Returns NULL on EOF or
+ * error; a body over MAX_MSG_SIZE is drained to its terminator, so the
+ * stream stays in sync, and reported by setting *too_large. */
+static char* read_chunked(size_t* out_len, int* too_large) {
+    char* buf = NULL;
+    size_t len = 0, cap = 0;
+    *too_large = 0;
+    for (;;) {
+        uint32_t n;
+        if (read_exact(stdin_fd, &n, 4) != 0)
+            goto fail;
+        if (n == 0)
+            break;
+        if (*too_large || n > MAX_MSG_SIZE - len) {
+            *too_large = 1;
+            if (skip_exact(n) != 0)
+                goto fail;
+            continue;
+        }
+        if (len + n > cap) {
+            size_t new_cap = cap ? cap * 2 : CHUNK_SIZE;
+            while (new_cap < len + n)
+                new_cap *= 2;
+            char* grown = (char*)realloc(buf, new_cap);
+            if (!grown)
+                goto fail;
+            buf = grown;
+            cap = new_cap;
+        }
+        if (read_exact(stdin_fd, buf + len, n) != 0)
+            goto fail;
+        len += n;
+    }
+    if (*too_large) {
+        free(buf);
+        return NULL;
+    }
+    if (!buf && !(buf = (char*)malloc(1)))
+        return NULL;
+    *out_len = len;
+    return buf;
+
+fail:
+    free(buf);
+    *too_large = 0;
+    return NULL;
+}
+
+/* Write data as CHUNK_SIZE frames plus a zero-length terminator. */
+static int write_chunked(const char* data, size_t len) {
+    while (len > 0) {
+        size_t n = len < CHUNK_SIZE ? len : CHUNK_SIZE;
+        if (write_message(data, n) != 0)
+            return -1;
+        data += n;
+        len -= n;
+    }
+    return write_message(data, 0);
+}
+
 /* Send a JSON object as a message. Frees the cJSON object. */
 static int send_json(cJSON* json) {
     char* str = cJSON_PrintUnformatted(json);
@@ -414,11 +519,542 @@ static void register_fonts_coretext(const char* dir_path) {
 }
 #endif
 
+/* Library handle, created by the "init" command */
+static SlimLOHandle g_handle = NULL;
+
+/* SlimLO entry points: the C API, or the simulated backend */
+static SlimLOBackend g_api;
+
+/* Filled at runtime: imported function addresses are not constant
+ * initializers for MSVC */
+static void use_native_backend(void) {
+    g_api.init_ex = slimlo_init_ex;
+    g_api.destroy = slimlo_destroy;
+    g_api.convert_file = slimlo_convert_file;
+    g_api.combine_to_pdf = slimlo_combine_to_pdf;
+    g_api.convert_buffer = slimlo_convert_buffer;
+    g_api.free_buffer = slimlo_free_buffer;
+    g_api.document_info = slimlo_document_info;
+    g_api.document_info_buffer = slimlo_document_info_buffer;
+    g_api.free_document_info = slimlo_free_document_info;
+    g_api.render_pages = slimlo_render_pages;
+    g_api.render_pages_buffer = slimlo_render_pages_buffer;
+    g_api.free_page_images = slimlo_free_page_images;
+    g_api.set_page_image_callback = slimlo_set_page_image_callback;
+    g_api.set_page_text_callback = slimlo_set_page_text_callback;
+    g_api.set_progress_callback = slimlo_set_progress_callback;
+    g_api.add_font_directory = slimlo_add_font_directory;
+    g_api.get_error_message = slimlo_get_error_message;
+    g_api.version = slimlo_version;
+}
+
+/* Simulate per spec (--simulate), else per a non-empty SLIMLO_SIMULATE,
+ * else use the C API. Returns 0, or -1 if the spec is invalid. */
+static int select_backend(const char* spec) {
+    const SlimLOBackend* sim;
+    char error[256];
+
+    if (!spec) {
+        spec = getenv("SLIMLO_SIMULATE");
+        if (spec && !*spec) spec = NULL;
+    }
+    if (!spec) {
+        use_native_backend();
+        return 0;
+    }
+    sim = slimlo_simulate_backend(spec, error, sizeof(error));
+    if (!sim) {
+        fprintf(stderr, "slimlo_worker: %s\n", error);
+        return -1;
+    }
+    g_api = *sim;
+    return 0;
+}
+
 /* --------------------------------------------------------------------------
- * Command handlers
+ * Option parsing
  * -------------------------------------------------------------------------- */
 
-static SlimLOHandle g_handle = NULL;
+/* Append "key=value" to a comma-separated filter options string.
+ * Returns the (possibly reallocated) buffer, or NULL on allocation failure. */
+static char* append_filter_option(char* buf, const char* key, const char* value) {
+    size_t cur = buf ? strlen(buf) : 0;
+    size_t add = strlen(key) + 1 + strlen(value) + (cur > 0 ? 1 : 0);
+    char* grown = (char*)realloc(buf, cur + add + 1);
+    if (!grown) {
+        free(buf);
+        return NULL;
+    }
+    if (cur == 0) grown[0] = '\0';
+    if (cur > 0) strcat(grown, ",");
+    strcat(grown, key);
+    strcat(grown, "=");
+    strcat(grown, value);
+    return grown;
+}
+
+/* Flatten the "filter_properties" object ({"Key": value, ...}) into the
+ * "Key=Value,..." form accepted by SlimLOPdfOptions.filter_options.
+ * Caller must free() the result. Returns NULL if there are no properties. */
+static char* build_filter_properties(cJSON* props) {
+    if (!props || !cJSON_IsObject(props)) return NULL;
+
+    char* buf = NULL;
+    char num[64];
+    cJSON* item;
+    cJSON_ArrayForEach(item, props) {
+        if (!item->string || item->string[0] == '\0') continue;
+
+        const char* value = NULL;
+        if (cJSON_IsString(item)) {
+            value = item->valuestring;
+        } else if (cJSON_IsBool(item)) {
+            value = cJSON_IsTrue(item) ? "true" : "false";
+        } else if (cJSON_IsNumber(item)) {
+            if (item->valuedouble == (double)item->valueint)
+                snprintf(num, sizeof(num), "%d", item->valueint);
+            else
+                snprintf(num, sizeof(num), "%.15g", item->valuedouble);
+            value = num;
+        }
+        if (!value) continue;
+
+        buf = append_filter_option(buf, item->string, value);
+        if (!buf) return NULL;
+    }
+    return buf;
+}
+
+/* Parse the "options" object of a convert/convert_buffer request into opts.
+ * Strings in opts point into msg, except *owned_filter_options which the
+ * caller must free() after the conversion.
+ * Returns opts, or NULL if the request carries no options. */
+static const SlimLOPdfOptions* parse_options(cJSON* msg, SlimLOPdfOptions* opts,
+                                             char** owned_filter_options) {
+    memset(opts, 0, sizeof(*opts));
+    *owned_filter_options = NULL;
+
+    cJSON* options = cJSON_GetObjectItem(msg, "options");
+    if (!options || !cJSON_IsObject(options))
+        return NULL;
+
+    cJSON* pv = cJSON_GetObjectItem(options, "pdf_version");
+    if (pv && cJSON_IsNumber(pv)) opts->pdf_version = (SlimLOPdfVersion)pv->valueint;
+
+    cJSON* jq = cJSON_GetObjectItem(options, "jpeg_quality");
+    if (jq && cJSON_IsNumber(jq)) opts->jpeg_quality = jq->valueint;
+
+    cJSON* dpi = cJSON_GetObjectItem(options, "dpi");
+    if (dpi && cJSON_IsNumber(dpi)) opts->dpi = dpi->valueint;
+
+    cJSON* tp = cJSON_GetObjectItem(options, "tagged_pdf");
+    if (tp) opts->tagged_pdf = cJSON_IsTrue(tp) ? 1 : 0;
+
+    cJSON* pr = cJSON_GetObjectItem(options, "page_range");
+    if (pr && cJSON_IsString(pr)) opts->page_range = pr->valuestring;
+
+    cJSON* pw = cJSON_GetObjectItem(options, "password");
+    if (pw && cJSON_IsString(pw)) opts->password = pw->valuestring;
+
+    cJSON* ps = cJSON_GetObjectItem(options, "preset");
+    if (ps && cJSON_IsNumber(ps)) opts->preset = (SlimLOPdfPreset)ps->valueint;
+
+    cJSON* ll = cJSON_GetObjectItem(options, "lazy_layout");
+    if (ll) opts->lazy_layout = cJSON_IsTrue(ll) ? 1 : 0;
+
+    cJSON* sf = cJSON_GetObjectItem(options, "skip_field_update");
+    if (sf) opts->skip_field_update = cJSON_IsTrue(sf) ? 1 : 0;
+
+    *owned_filter_options = build_filter_properties(
+        cJSON_GetObjectItem(options, "filter_properties"));
+    opts->filter_options = *owned_filter_options;
+
+    return opts;
+}
+
+/* --------------------------------------------------------------------------
+ * Progress frames and conversion metrics
+ *
+ * When a convert request carries "progress": true, the worker streams
+ * {"type":"progress","id":N,...} frames before the result frame so the
+ * host can tell a slow conversion from a hung one.
+ *
+ * The progress callback is installed for every conversion either way: the
+ * phase transitions it reports time the conversion, and the result carries
+ * them as a "metrics" object ({"load_ms","export_ms","total_ms",
+ * "input_bytes","output_bytes","rss_bytes"}) for the host's instruments.
+ * -------------------------------------------------------------------------- */
+
+static double monotonic_ms(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart * 1000.0 / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+#endif
+}
+
+typedef struct {
+    const int* id;
+    int send;                   /* stream progress frames to the host */
+    SlimLOProgressPhase phase;  /* phase being timed */
+    double since;               /* when it started */
+    double load_ms;             /* LOAD + LAYOUT, summed over combine parts */
+    double export_ms;           /* EXPORT + DONE (side outputs included) */
+    double started;
+    uint64_t output_bytes;
+} ProgressState;
+
+static ProgressState g_progress;
+
+/* Charge the time since the last transition to the phase being timed */
+static void progress_account(double now) {
+    double elapsed = now - g_progress.since;
+    if (g_progress.phase == SLIMLO_PROGRESS_EXPORT || g_progress.phase == SLIMLO_PROGRESS_DONE)
+        g_progress.export_ms += elapsed;
+    else
+        g_progress.load_ms += elapsed;
+    g_progress.since = now;
+}
+
+static const char* progress_phase_name(SlimLOProgressPhase phase) {
+    switch (phase) {
+        case SLIMLO_PROGRESS_LOAD:   return "load";
+        case SLIMLO_PROGRESS_LAYOUT: return "layout";
+        case SLIMLO_PROGRESS_EXPORT: return "export";
+        case SLIMLO_PROGRESS_DONE:   return "done";
+        default:                     return "unknown";
+    }
+}
+
+static void on_progress(const SlimLOProgress* progress, void* user_data) {
+    ProgressState* state = (ProgressState*)user_data;
+    if (progress->phase != state->phase) {
+        progress_account(monotonic_ms());
+        state->phase = progress->phase;
+    }
+    if (progress->phase == SLIMLO_PROGRESS_DONE)
+        state->output_bytes += progress->bytes_written;
+    if (!state->send)
+        return;
+
+    cJSON* frame = cJSON_CreateObject();
+    cJSON_AddStringToObject(frame, "type", "progress");
+    cJSON_AddNumberToObject(frame, "id", *state->id);
+    cJSON_AddStringToObject(frame, "phase", progress_phase_name(progress->phase));
+    cJSON_AddNumberToObject(frame, "percent", progress->percent);
+    cJSON_AddNumberToObject(frame, "pages_laid_out", progress->pages_laid_out);
+    cJSON_AddNumberToObject(frame, "pages_exported", progress->pages_exported);
+    cJSON_AddNumberToObject(frame, "bytes_written", (double)progress->bytes_written);
+    send_json(frame);
+}
+
+/* Start timing a conversion; stream progress frames if the request asked
+ * for them. *id must stay valid until progress_end(). */
+static void progress_begin(cJSON* msg, const int* id) {
+    memset(&g_progress, 0, sizeof(g_progress));
+    g_progress.id = id;
+    g_progress.send = cJSON_IsTrue(cJSON_GetObjectItem(msg, "progress"));
+    g_progress.phase = SLIMLO_PROGRESS_LOAD;
+    g_progress.started = g_progress.since = monotonic_ms();
+    g_api.set_progress_callback(g_handle, on_progress, &g_progress);
+}
+
+static void progress_end(void) {
+    g_api.set_progress_callback(g_handle, NULL, NULL);
+    progress_account(monotonic_ms());
+}
+
+/* Resident set size of this worker, or 0 where it isn't cheaply available */
+static uint64_t resident_bytes(void) {
+#ifdef __linux__
+    FILE* f = fopen("/proc/self/statm", "r");
+    unsigned long size = 0, resident = 0;
+    if (!f) return 0;
+    int n = fscanf(f, "%lu %lu", &size, &resident);
+    fclose(f);
+    return n == 2 ? (uint64_t)resident * (uint64_t)sysconf(_SC_PAGESIZE) : 0;
+#else
+    return 0;
+#endif
+}
+
+static uint64_t input_file_size(const char* path) {
+    struct stat st;
+    return path && stat(path, &st) == 0 ? (uint64_t)st.st_size : 0;
+}
+
+/* The "metrics" object for the conversion timed since progress_begin() */
+static cJSON* progress_metrics(uint64_t input_bytes) {
+    cJSON* metrics = cJSON_CreateObject();
+    cJSON_AddNumberToObject(metrics, "load_ms", g_progress.load_ms);
+    cJSON_AddNumberToObject(metrics, "export_ms", g_progress.export_ms);
+    cJSON_AddNumberToObject(metrics, "total_ms", g_progress.since - g_progress.started);
+    cJSON_AddNumberToObject(metrics, "input_bytes", (double)input_bytes);
+    cJSON_AddNumberToObject(metrics, "output_bytes", (double)g_progress.output_bytes);
+    uint64_t rss = resident_bytes();
+    if (rss > 0)
+        cJSON_AddNumberToObject(metrics, "rss_bytes", (double)rss);
+    return metrics;
+}
+
+/* --------------------------------------------------------------------------
+ * Page images
+ *
+ * A "render" object ({"format":0|1,"width":N,"page_range":"1"}) asks for
+ * page images. On convert requests they are rendered from the document the
+ * conversion already loaded. Image metadata goes into the response's
+ * "images" array; the image bytes follow as one binary frame per image,
+ * after the PDF frame if there is one.
+ * -------------------------------------------------------------------------- */
+
+typedef struct {
+    SlimLOPageImage* items;
+    int              count;
+    int              capacity;
+    int              failed;   /* an allocation failed; list is incomplete */
+} ImageList;
+
+/* Parse the "render" object of a request. Strings point into msg.
+ * Returns opts, or NULL if the request carries no render object. */
+static const SlimLORenderOptions* parse_render(cJSON* msg, SlimLORenderOptions* opts) {
+    memset(opts, 0, sizeof(*opts));
+
+    cJSON* render = cJSON_GetObjectItem(msg, "render");
+    if (!render || !cJSON_IsObject(render))
+        return NULL;
+
+    cJSON* fmt = cJSON_GetObjectItem(render, "format");
+    if (fmt && cJSON_IsNumber(fmt)) opts->format = (SlimLOImageFormat)fmt->valueint;
+
+    cJSON* width = cJSON_GetObjectItem(render, "width");
+    if (width && cJSON_IsNumber(width)) opts->width = width->valueint;
+
+    cJSON* pr = cJSON_GetObjectItem(render, "page_range");
+    if (pr && cJSON_IsString(pr)) opts->page_range = pr->valuestring;
+
+    return opts;
+}
+
+/* Page image callback: copy the image, it is only valid during the call */
+static void on_page_image(const SlimLOPageImage* image, void* user_data) {
+    ImageList* list = (ImageList*)user_data;
+    if (list->failed) return;
+
+    if (list->count == list->capacity) {
+        int capacity = list->capacity ? list->capacity * 2 : 4;
+        SlimLOPageImage* grown = (SlimLOPageImage*)realloc(
+            list->items, (size_t)capacity * sizeof(SlimLOPageImage));
+        if (!grown) {
+            list->failed = 1;
+            return;
+        }
+        list->items = grown;
+        list->capacity = capacity;
+    }
+
+    SlimLOPageImage copy = *image;
+    copy.data = (uint8_t*)malloc(image->size);
+    if (!copy.data) {
+        list->failed = 1;
+        return;
+    }
+    memcpy(copy.data, image->data, image->size);
+    list->items[list->count++] = copy;
+}
+
+static void image_list_free(ImageList* list) {
+    for (int i = 0; i < list->count; i++)
+        free(list->items[i].data);
+    free(list->items);
+    memset(list, 0, sizeof(*list));
+}
+
+/* Collect page images during the next conversion if the request asks for
+ * them. Returns SLIMLO_OK or the error from validating the render options. */
+static SlimLOError render_begin(cJSON* msg, ImageList* list) {
+    SlimLORenderOptions opts;
+    if (!parse_render(msg, &opts))
+        return SLIMLO_OK;
+    return g_api.set_page_image_callback(g_handle, &opts, on_page_image, list);
+}
+
+static void render_end(void) {
+    g_api.set_page_image_callback(g_handle, NULL, NULL, NULL);
+}
+
+static cJSON* images_json(const SlimLOPageImage* images, int count) {
+    cJSON* arr = cJSON_CreateArray();
+    for (int i = 0; i < count; i++) {
+        cJSON* item = cJSON_CreateObject();
+        cJSON_AddNumberToObject(item, "page", images[i].page);
+        cJSON_AddNumberToObject(item, "width", images[i].width);
+        cJSON_AddNumberToObject(item, "height", images[i].height);
+        cJSON_AddNumberToObject(item, "format", images[i].format);
+        cJSON_AddNumberToObject(item, "size", (double)images[i].size);
+        cJSON_AddItemToArray(arr, item);
+    }
+    return arr;
+}
+
+static int send_image_frames(const SlimLOPageImage* images, int count) {
+    for (int i = 0; i < count; i++) {
+        int rc = write_message((const char*)images[i].data, images[i].size);
+        if (rc != 0) return rc;
+    }
+    return 0;
+}
+
+/* --------------------------------------------------------------------------
+ * Page text
+ *
+ * A "text" object ({"words":true,"page_range":"1-3"}) on a convert request
+ * asks for the text of the selected pages (default: all), taken from the
+ * conversion's own layout after export. It comes back inline as the
+ * response's "text" array, one entry per page:
+ *   {"page":1,"width":pt,"height":pt,"text":"...","words":[[x,y,w,h,"w"],...]}
+ * with word boxes in points from the page's top-left corner.
+ * -------------------------------------------------------------------------- */
+
+typedef struct {
+    cJSON* pages;
+    int    failed;   /* an allocation failed; pages is incomplete */
+} TextList;
+
+/* Parse the "text" object of a request. Strings point into msg.
+ * Returns opts, or NULL if the request carries no text object. */
+static const SlimLOTextOptions* parse_text(cJSON* msg, SlimLOTextOptions* opts) {
+    memset(opts, 0, sizeof(*opts));
+
+    cJSON* text = cJSON_GetObjectItem(msg, "text");
+    if (!text || !cJSON_IsObject(text))
+        return NULL;
+
+    cJSON* words = cJSON_GetObjectItem(text, "words");
+    if (words && cJSON_IsBool(words)) opts->include_words = cJSON_IsTrue(words);
+
+    cJSON* pr = cJSON_GetObjectItem(text, "page_range");
+    if (pr && cJSON_IsString(pr)) opts->page_range = pr->valuestring;
+
+    return opts;
+}
+
+/* Page text callback: build the JSON entry, the page is only valid during the call */
+static void on_page_text(const SlimLOPageText* page, void* user_data) {
+    TextList* list = (TextList*)user_data;
+    if (list->failed) return;
+
+    if (!list->pages) list->pages = cJSON_CreateArray();
+    cJSON* item = cJSON_CreateObject();
+    if (!list->pages || !item) {
+        cJSON_Delete(item);
+        list->failed = 1;
+        return;
+    }
+    cJSON_AddItemToArray(list->pages, item);
+
+    cJSON_AddNumberToObject(item, "page", page->page);
+    cJSON_AddNumberToObject(item, "width", page->size.width);
+    cJSON_AddNumberToObject(item, "height", page->size.height);
+    if (!cJSON_AddStringToObject(item, "text", page->text)) {
+        list->failed = 1;
+        return;
+    }
+    if (!page->words) return;
+
+    cJSON* words = cJSON_AddArrayToObject(item, "words");
+    if (!words) {
+        list->failed = 1;
+        return;
+    }
+    for (int i = 0; i < page->word_count; i++) {
+        const SlimLOWordBox* box = &page->words[i];
+        cJSON* word = cJSON_CreateArray();
+        if (!word) {
+            list->failed = 1;
+            return;
+        }
+        cJSON_AddItemToArray(words, word);
+        cJSON_AddItemToArray(word, cJSON_CreateNumber(box->x));
+        cJSON_AddItemToArray(word, cJSON_CreateNumber(box->y));
+        cJSON_AddItemToArray(word, cJSON_CreateNumber(box->width));
+        cJSON_AddItemToArray(word, cJSON_CreateNumber(box->height));
+        cJSON_AddItemToArray(word, cJSON_CreateString(box->text));
+        if (cJSON_GetArraySize(word) != 5) {
+            list->failed = 1;
+            return;
+        }
+    }
+}
+
+/* Collect page text during the next conversion if the request asks for it.
+ * Returns SLIMLO_OK or the error from validating the text options. */
+static SlimLOError text_begin(cJSON* msg, TextList* list) {
+    SlimLOTextOptions opts;
+    if (!parse_text(msg, &opts))
+        return SLIMLO_OK;
+    return g_api.set_page_text_callback(g_handle, &opts, on_page_text, list);
+}
+
+static void text_end(void) {
+    g_api.set_page_text_callback(g_handle, NULL, NULL, NULL);
+}
+
+/* Error message for a failed conversion, naming side-output allocation failures */
+static const char* side_output_error(const ImageList* images, const TextList* text) {
+    if (images->failed) return "Out of memory while collecting page images";
+    if (text->failed) return "Out of memory while collecting page text";
+    return g_api.get_error_message(g_handle);
+}
+
+/* --------------------------------------------------------------------------
+ * CPU placement
+ *
+ * An init "cpus" array ([0,1,2,3]) pins the worker to those CPUs and has
+ * memory allocated on the NUMA node of the CPU that touches it, overriding
+ * any interleave policy inherited from the host. Both are per-thread
+ * attributes inherited by new threads, so they are applied before
+ * slimlo_init() starts LibreOffice's. Best effort: a failure is logged to
+ * stderr and the worker runs unpinned. macOS has no affinity API.
+ * -------------------------------------------------------------------------- */
+
+static void apply_cpu_placement(cJSON* cpus) {
+    if (!cpus || !cJSON_IsArray(cpus) || cJSON_GetArraySize(cpus) == 0)
+        return;
+    cJSON* item;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    cJSON_ArrayForEach(item, cpus) {
+        if (cJSON_IsNumber(item) && item->valueint >= 0 && item->valueint < CPU_SETSIZE)
+            CPU_SET(item->valueint, &set);
+    }
+    if (sched_setaffinity(0, sizeof(set), &set) != 0)
+        fprintf(stderr, "slimlo_worker: sched_setaffinity failed: %s\n", strerror(errno));
+    /* ENOSYS: kernel built without NUMA support, nothing to do */
+    if (syscall(SYS_set_mempolicy, MPOL_LOCAL, NULL, 0UL) != 0 && errno != ENOSYS)
+        fprintf(stderr, "slimlo_worker: set_mempolicy failed: %s\n", strerror(errno));
+#elif defined(_WIN32)
+    /* Windows already allocates from the ideal processor's node */
+    DWORD_PTR mask = 0;
+    cJSON_ArrayForEach(item, cpus) {
+        if (cJSON_IsNumber(item) && item->valueint >= 0 && item->valueint < (int)(sizeof(DWORD_PTR) * 8))
+            mask |= (DWORD_PTR)1 << item->valueint;
+    }
+    if (mask && !SetProcessAffinityMask(GetCurrentProcess(), mask))
+        fprintf(stderr, "slimlo_worker: SetProcessAffinityMask failed: %lu\n", (unsigned long)GetLastError());
+#else
+    (void)item;
+#endif
+}
+
+/* --------------------------------------------------------------------------
+ * Command handlers
+ * -------------------------------------------------------------------------- */
 
 static int handle_init(cJSON* msg) {
     cJSON* rp = cJSON_GetObjectItem(msg, "resource_path");
@@ -472,82 +1108,122 @@ static int handle_init(cJSON* msg) {
 #endif
     }
 
+    /* Thread budget for LibreOffice's internal pools (0 = one per core) */
+    SlimLOInitOptions init_opts;
+    memset(&init_opts, 0, sizeof(init_opts));
+    cJSON* th = cJSON_GetObjectItem(msg, "threads");
+    if (th && cJSON_IsNumber(th) && th->valueint > 0)
+        init_opts.threads = th->valueint;
+
+    apply_cpu_placement(cJSON_GetObjectItem(msg, "cpus"));
+
     /* Initialize SlimLO */
-    g_handle = slimlo_init(rp->valuestring);
+    g_handle = g_api.init_ex(rp->valuestring, &init_opts);
 
     cJSON* resp = cJSON_CreateObject();
     if (g_handle) {
         cJSON_AddStringToObject(resp, "type", "ready");
-        const char* ver = slimlo_version();
+        const char* ver = g_api.version();
         cJSON_AddStringToObject(resp, "version", ver ? ver : "unknown");
     } else {
         cJSON_AddStringToObject(resp, "type", "error");
-        const char* err = slimlo_get_error_message(NULL);
+        const char* err = g_api.get_error_message(NULL);
         cJSON_AddStringToObject(resp, "message", err ? err : "Failed to initialize");
     }
     return send_json(resp);
 }
 
+static int send_error_result(const char* type, int id, SlimLOError code, const char* message) {
+    cJSON* resp = cJSON_CreateObject();
+    cJSON_AddStringToObject(resp, "type", type);
+    cJSON_AddNumberToObject(resp, "id", id);
+    cJSON_AddBoolToObject(resp, "success", 0);
+    cJSON_AddNumberToObject(resp, "error_code", code);
+    cJSON_AddStringToObject(resp, "error_message", message);
+    cJSON_AddItemToObject(resp, "diagnostics", cJSON_CreateArray());
+    return send_json(resp);
+}
+
 static int handle_convert(cJSON* msg) {
     cJSON* id_json = cJSON_GetObjectItem(msg, "id");
     int id = id_json && cJSON_IsNumber(id_json) ? id_json->valueint : 0;
 
+    int combine = strcmp(cJSON_GetObjectItem(msg, "type")->valuestring, "combine") == 0;
     cJSON* input = cJSON_GetObjectItem(msg, "input");
+    cJSON* inputs = cJSON_GetObjectItem(msg, "inputs");
     cJSON* output = cJSON_GetObjectItem(msg, "output");
     cJSON* format_json = cJSON_GetObjectItem(msg, "format");
 
-    if (!input || !cJSON_IsString(input) || !output || !cJSON_IsString(output)) {
-        cJSON* resp = cJSON_CreateObject();
-        cJSON_AddStringToObject(resp, "type", "result");
-        cJSON_AddNumberToObject(resp, "id", id);
-        cJSON_AddBoolToObject(resp, "success", 0);
-        cJSON_AddNumberToObject(resp, "error_code", SLIMLO_ERROR_INVALID_ARGUMENT);
-        cJSON_AddStringToObject(resp, "error_message", "Missing input or output path");
-        cJSON_AddItemToObject(resp, "diagnostics", cJSON_CreateArray());
-        return send_json(resp);
+    if (!output || !cJSON_IsString(output))
+        return send_error_result("result", id, SLIMLO_ERROR_INVALID_ARGUMENT, "Missing output path");
+    if (combine && (!cJSON_IsArray(inputs) || cJSON_GetArraySize(inputs) == 0))
+        return send_error_result("result", id, SLIMLO_ERROR_INVALID_ARGUMENT,
+                                 "combine needs a non-empty \"inputs\" list");
+    if (!combine && inputs)
+        return send_error_result("result", id, SLIMLO_ERROR_INVALID_ARGUMENT,
+                                 "convert takes \"input\", not \"inputs\"");
+    if (!combine && (!input || !cJSON_IsString(input)))
+        return send_error_result("result", id, SLIMLO_ERROR_INVALID_ARGUMENT, "Missing input path");
+
+    /* "combine": [{"input":path,"bookmark":title},...] into one PDF */
+    SlimLOCombinePart* parts = NULL;
+    int part_count = 0;
+    if (combine) {
+        part_count = cJSON_GetArraySize(inputs);
+        parts = (SlimLOCombinePart*)calloc((size_t)part_count, sizeof(SlimLOCombinePart));
+        if (!parts)
+            return send_error_result("result", id, SLIMLO_ERROR_OUT_OF_MEMORY,
+                                     "Out of memory allocating combine parts");
+        for (int i = 0; i < part_count; i++) {
+            cJSON* part = cJSON_GetArrayItem(inputs, i);
+            cJSON* part_input = cJSON_GetObjectItem(part, "input");
+            cJSON* bookmark = cJSON_GetObjectItem(part, "bookmark");
+            if (part_input && cJSON_IsString(part_input))
+                parts[i].input_path = part_input->valuestring;
+            if (bookmark && cJSON_IsString(bookmark))
+                parts[i].bookmark = bookmark->valuestring;
+        }
     }
 
     int format = format_json && cJSON_IsNumber(format_json) ? format_json->valueint : 0;
 
     /* Parse options */
     SlimLOPdfOptions opts;
-    memset(&opts, 0, sizeof(opts));
-    const SlimLOPdfOptions* opts_ptr = NULL;
-
-    cJSON* options = cJSON_GetObjectItem(msg, "options");
-    if (options && cJSON_IsObject(options)) {
-        cJSON* pv = cJSON_GetObjectItem(options, "pdf_version");
-        if (pv && cJSON_IsNumber(pv)) opts.pdf_version = (SlimLOPdfVersion)pv->valueint;
-
-        cJSON* jq = cJSON_GetObjectItem(options, "jpeg_quality");
-        if (jq && cJSON_IsNumber(jq)) opts.jpeg_quality = jq->valueint;
-
-        cJSON* dpi = cJSON_GetObjectItem(options, "dpi");
-        if (dpi && cJSON_IsNumber(dpi)) opts.dpi = dpi->valueint;
-
-        cJSON* tp = cJSON_GetObjectItem(options, "tagged_pdf");
-        if (tp) opts.tagged_pdf = cJSON_IsTrue(tp) ? 1 : 0;
-
-        cJSON* pr = cJSON_GetObjectItem(options, "page_range");
-        if (pr && cJSON_IsString(pr)) opts.page_range = pr->valuestring;
-
-        cJSON* pw = cJSON_GetObjectItem(options, "password");
-        if (pw && cJSON_IsString(pw)) opts.password = pw->valuestring;
-
-        opts_ptr = &opts;
-    }
+    char* filter_options = NULL;
+    const SlimLOPdfOptions* opts_ptr = parse_options(msg, &opts, &filter_options);
 
     /* Start stderr capture */
     stderr_capture_start();
+    progress_begin(msg, &id);
+    ImageList images = {0};
+    TextList text = {0};
+    SlimLOError err = render_begin(msg, &images);
+    if (err == SLIMLO_OK)
+        err = text_begin(msg, &text);
 
     /* Perform conversion */
-    SlimLOError err = slimlo_convert_file(
-        g_handle,
-        input->valuestring,
-        output->valuestring,
-        (SlimLOFormat)format,
-        opts_ptr
-    );
+    if (err == SLIMLO_OK && parts)
+        err = g_api.combine_to_pdf(g_handle, parts, part_count, output->valuestring, opts_ptr);
+    else if (err == SLIMLO_OK)
+        err = g_api.convert_file(
+            g_handle,
+            input->valuestring,
+            output->valuestring,
+            (SlimLOFormat)format,
+            opts_ptr
+        );
+    uint64_t input_bytes = 0;
+    for (int i = 0; parts && i < part_count; i++)
+        input_bytes += input_file_size(parts[i].input_path);
+    if (!parts)
+        input_bytes = input_file_size(input->valuestring);
+    free(parts);
+    text_end();
+    render_end();
+    progress_end();
+    free(filter_options);
+    if (err == SLIMLO_OK && (images.failed || text.failed))
+        err = SLIMLO_ERROR_OUT_OF_MEMORY;
 
     /* Capture stderr and restore */
     stderr_capture_stop();
@@ -565,16 +1241,28 @@ static int handle_convert(cJSON* msg) {
         cJSON_AddBoolToObject(resp, "success", 1);
         cJSON_AddNullToObject(resp, "error_code");
         cJSON_AddNullToObject(resp, "error_message");
+        if (images.count > 0)
+            cJSON_AddItemToObject(resp, "images", images_json(images.items, images.count));
+        if (text.pages) {
+            cJSON_AddItemToObject(resp, "text", text.pages);
+            text.pages = NULL;
+        }
     } else {
         cJSON_AddBoolToObject(resp, "success", 0);
         cJSON_AddNumberToObject(resp, "error_code", (int)err);
-        const char* errmsg = slimlo_get_error_message(g_handle);
+        const char* errmsg = side_output_error(&images, &text);
         cJSON_AddStringToObject(resp, "error_message", errmsg ? errmsg : "Conversion failed");
     }
+    cJSON_Delete(text.pages);
 
     cJSON_AddItemToObject(resp, "diagnostics", diagnostics);
+    cJSON_AddItemToObject(resp, "metrics", progress_metrics(input_bytes));
 
-    return send_json(resp);
+    int rc = send_json(resp);
+    if (rc == 0 && err == SLIMLO_OK)
+        rc = send_image_frames(images.items, images.count);
+    image_list_free(&images);
+    return rc;
 }
 
 static int handle_convert_buffer(cJSON* msg) {
@@ -584,8 +1272,11 @@ static int handle_convert_buffer(cJSON* msg) {
     cJSON* format_json = cJSON_GetObjectItem(msg, "format");
     int format = format_json && cJSON_IsNumber(format_json) ? format_json->valueint : 0;
 
+    /* Chunked requests stream the document in and the PDF back out */
+    int chunked = cJSON_IsTrue(cJSON_GetObjectItem(msg, "chunked"));
+
     cJSON* data_size_json = cJSON_GetObjectItem(msg, "data_size");
-    if (!data_size_json || !cJSON_IsNumber(data_size_json)) {
+    if (!chunked && (!data_size_json || !cJSON_IsNumber(data_size_json))) {
         cJSON* resp = cJSON_CreateObject();
         cJSON_AddStringToObject(resp, "type", "buffer_result");
         cJSON_AddNumberToObject(resp, "id", id);
@@ -596,52 +1287,34 @@ static int handle_convert_buffer(cJSON* msg) {
         return send_json(resp);
     }
 
-    size_t data_size = (size_t)cJSON_GetNumberValue(data_size_json);
+    size_t data_size = chunked ? 0 : (size_t)cJSON_GetNumberValue(data_size_json);
 
     /* Parse options (same as handle_convert) */
     SlimLOPdfOptions opts;
-    memset(&opts, 0, sizeof(opts));
-    const SlimLOPdfOptions* opts_ptr = NULL;
-
-    cJSON* options = cJSON_GetObjectItem(msg, "options");
-    if (options && cJSON_IsObject(options)) {
-        cJSON* pv = cJSON_GetObjectItem(options, "pdf_version");
-        if (pv && cJSON_IsNumber(pv)) opts.pdf_version = (SlimLOPdfVersion)pv->valueint;
-
-        cJSON* jq = cJSON_GetObjectItem(options, "jpeg_quality");
-        if (jq && cJSON_IsNumber(jq)) opts.jpeg_quality = jq->valueint;
-
-        cJSON* dpi = cJSON_GetObjectItem(options, "dpi");
-        if (dpi && cJSON_IsNumber(dpi)) opts.dpi = dpi->valueint;
-
-        cJSON* tp = cJSON_GetObjectItem(options, "tagged_pdf");
-        if (tp) opts.tagged_pdf = cJSON_IsTrue(tp) ? 1 : 0;
-
-        cJSON* pr = cJSON_GetObjectItem(options, "page_range");
-        if (pr && cJSON_IsString(pr)) opts.page_range = pr->valuestring;
-
-        cJSON* pw = cJSON_GetObjectItem(options, "password");
-        if (pw && cJSON_IsString(pw)) opts.password = pw->valuestring;
-
-        opts_ptr = &opts;
-    }
+    char* filter_options = NULL;
+    const SlimLOPdfOptions* opts_ptr = parse_options(msg, &opts, &filter_options);
 
     /* Read the binary document frame (second length-prefixed frame) */
     size_t frame_len = 0;
-    char* doc_buf = read_message(&frame_len);
+    int too_large = 0;
+    char* doc_buf = chunked ? read_chunked(&frame_len, &too_large) : read_message(&frame_len);
     if (!doc_buf) {
+        free(filter_options);
         cJSON* resp = cJSON_CreateObject();
         cJSON_AddStringToObject(resp, "type", "buffer_result");
         cJSON_AddNumberToObject(resp, "id", id);
         cJSON_AddBoolToObject(resp, "success", 0);
         cJSON_AddNumberToObject(resp, "error_code", SLIMLO_ERROR_INVALID_ARGUMENT);
-        cJSON_AddStringToObject(resp, "error_message", "Failed to read document data frame");
+        cJSON_AddStringToObject(resp, "error_message", too_large
+            ? "Document exceeds the maximum message size"
+            : "Failed to read document data frame");
         cJSON_AddItemToObject(resp, "diagnostics", cJSON_CreateArray());
         return send_json(resp);
     }
 
-    if (frame_len != data_size) {
+    if (!chunked && frame_len != data_size) {
         free(doc_buf);
+        free(filter_options);
         cJSON* resp = cJSON_CreateObject();
         cJSON_AddStringToObject(resp, "type", "buffer_result");
         cJSON_AddNumberToObject(resp, "id", id);
@@ -654,19 +1327,35 @@ static int handle_convert_buffer(cJSON* msg) {
 
     /* Start stderr capture */
     stderr_capture_start();
+    progress_begin(msg, &id);
+    ImageList images = {0};
+    TextList text = {0};
+    SlimLOError err = render_begin(msg, &images);
+    if (err == SLIMLO_OK)
+        err = text_begin(msg, &text);
 
     /* Perform buffer conversion */
     uint8_t* pdf_buf = NULL;
     size_t pdf_size = 0;
-    SlimLOError err = slimlo_convert_buffer(
-        g_handle,
-        (const uint8_t*)doc_buf, frame_len,
-        (SlimLOFormat)format,
-        opts_ptr,
-        &pdf_buf, &pdf_size
-    );
+    if (err == SLIMLO_OK)
+        err = g_api.convert_buffer(
+            g_handle,
+            (const uint8_t*)doc_buf, frame_len,
+            (SlimLOFormat)format,
+            opts_ptr,
+            &pdf_buf, &pdf_size
+        );
+    text_end();
+    render_end();
+    progress_end();
+    if (err == SLIMLO_OK && (images.failed || text.failed)) {
+        g_api.free_buffer(pdf_buf);
+        pdf_buf = NULL;
+        err = SLIMLO_ERROR_OUT_OF_MEMORY;
+    }
 
     free(doc_buf);
+    free(filter_options);
 
     /* Capture stderr and restore */
     stderr_capture_stop();
@@ -683,39 +1372,277 @@ static int handle_convert_buffer(cJSON* msg) {
     if (err == SLIMLO_OK && pdf_buf) {
         cJSON_AddBoolToObject(resp, "success", 1);
         cJSON_AddNumberToObject(resp, "data_size", (double)pdf_size);
+        if (chunked)
+            cJSON_AddBoolToObject(resp, "chunked", 1);
         cJSON_AddNullToObject(resp, "error_code");
         cJSON_AddNullToObject(resp, "error_message");
+        if (images.count > 0)
+            cJSON_AddItemToObject(resp, "images", images_json(images.items, images.count));
+        if (text.pages) {
+            cJSON_AddItemToObject(resp, "text", text.pages);
+            text.pages = NULL;
+        }
     } else {
         cJSON_AddBoolToObject(resp, "success", 0);
         cJSON_AddNumberToObject(resp, "error_code", (int)err);
-        const char* errmsg = slimlo_get_error_message(g_handle);
+        const char* errmsg = side_output_error(&images, &text);
         cJSON_AddStringToObject(resp, "error_message", errmsg ? errmsg : "Buffer conversion failed");
     }
+    cJSON_Delete(text.pages);
 
     cJSON_AddItemToObject(resp, "diagnostics", diagnostics);
+    cJSON_AddItemToObject(resp, "metrics", progress_metrics(frame_len));
 
     /* Send JSON response frame */
     int rc = send_json(resp);
     if (rc != 0) {
-        slimlo_free_buffer(pdf_buf);
+        g_api.free_buffer(pdf_buf);
+        image_list_free(&images);
         return rc;
     }
 
-    /* Send binary PDF frame (only on success) */
+    /* Send binary PDF frame, then any page images (only on success) */
     if (err == SLIMLO_OK && pdf_buf) {
-        rc = write_message((const char*)pdf_buf, pdf_size);
-        slimlo_free_buffer(pdf_buf);
-        return rc;
+        rc = chunked
+            ? write_chunked((const char*)pdf_buf, pdf_size)
+            : write_message((const char*)pdf_buf, pdf_size);
+        if (rc == 0)
+            rc = send_image_frames(images.items, images.count);
     }
+    g_api.free_buffer(pdf_buf);
+    image_list_free(&images);
+    return rc;
+}
 
-    return 0;
+/* cJSON_CreateStringArray returns NULL for an empty list; always build an array */
+static cJSON* string_array(char** strings, int count) {
+    cJSON* arr = cJSON_CreateArray();
+    for (int i = 0; strings && i < count; i++)
+        cJSON_AddItemToArray(arr, cJSON_CreateString(strings[i]));
+    return arr;
+}
+
+/* Read the document of an info/render request: either "input" (path) or,
+ * like convert_buffer, "data_size" followed by a binary frame. On success
+ * *doc_buf holds the frame (NULL for path requests) and NULL is returned;
+ * otherwise the error message is returned. */
+static const char* read_document_input(cJSON* msg, char** doc_buf, size_t* frame_len) {
+    cJSON* input = cJSON_GetObjectItem(msg, "input");
+    cJSON* data_size_json = cJSON_GetObjectItem(msg, "data_size");
+
+    *doc_buf = NULL;
+    *frame_len = 0;
+    if (data_size_json && cJSON_IsNumber(data_size_json)) {
+        *doc_buf = read_message(frame_len);
+        if (!*doc_buf)
+            return "Failed to read document data frame";
+        if (*frame_len != (size_t)cJSON_GetNumberValue(data_size_json)) {
+            free(*doc_buf);
+            *doc_buf = NULL;
+            return "Data frame size mismatch";
+        }
+    } else if (!input || !cJSON_IsString(input)) {
+        return "Missing input path or data_size";
+    }
+    return NULL;
+}
+
+/* "info": load + layout only, no PDF export */
+static int handle_info(cJSON* msg) {
+    cJSON* id_json = cJSON_GetObjectItem(msg, "id");
+    int id = id_json && cJSON_IsNumber(id_json) ? id_json->valueint : 0;
+
+    cJSON* input = cJSON_GetObjectItem(msg, "input");
+    cJSON* format_json = cJSON_GetObjectItem(msg, "format");
+    int format = format_json && cJSON_IsNumber(format_json) ? format_json->valueint : 0;
+
+    char* doc_buf = NULL;
+    size_t frame_len = 0;
+    const char* input_error = read_document_input(msg, &doc_buf, &frame_len);
+    if (input_error)
+        return send_error_result("info_result", id, SLIMLO_ERROR_INVALID_ARGUMENT, input_error);
+
+    stderr_capture_start();
+
+    SlimLODocumentInfo info;
+    SlimLOError err = doc_buf
+        ? g_api.document_info_buffer(g_handle, (const uint8_t*)doc_buf, frame_len,
+                                      (SlimLOFormat)format, &info)
+        : g_api.document_info(g_handle, input->valuestring, &info);
+    free(doc_buf);
+
+    stderr_capture_stop();
+    size_t stderr_len = stderr_capture_read();
+    cJSON* diagnostics = parse_diagnostics(stderr_len > 0 ? stderr_buf : NULL);
+
+    cJSON* resp = cJSON_CreateObject();
+    cJSON_AddStringToObject(resp, "type", "info_result");
+    cJSON_AddNumberToObject(resp, "id", id);
+
+    if (err == SLIMLO_OK) {
+        cJSON_AddBoolToObject(resp, "success", 1);
+        cJSON_AddNullToObject(resp, "error_code");
+        cJSON_AddNullToObject(resp, "error_message");
+        cJSON_AddNumberToObject(resp, "page_count", info.page_count);
+
+        cJSON* pages = cJSON_AddArrayToObject(resp, "pages");
+        for (int i = 0; info.pages && i < info.page_count; i++) {
+            cJSON* page = cJSON_CreateObject();
+            cJSON_AddNumberToObject(page, "width", info.pages[i].width);
+            cJSON_AddNumberToObject(page, "height", info.pages[i].height);
+            cJSON_AddItemToArray(pages, page);
+        }
+
+        cJSON_AddNumberToObject(resp, "section_count", info.section_count);
+        cJSON_AddNumberToObject(resp, "image_count", info.image_count);
+        cJSON_AddNumberToObject(resp, "word_count", info.word_count);
+        cJSON_AddItemToObject(resp, "fonts",
+                              string_array(info.fonts, info.font_count));
+        cJSON_AddItemToObject(resp, "missing_fonts",
+                              string_array(info.missing_fonts, info.missing_font_count));
+    } else {
+        cJSON_AddBoolToObject(resp, "success", 0);
+        cJSON_AddNumberToObject(resp, "error_code", (int)err);
+        const char* errmsg = g_api.get_error_message(g_handle);
+        cJSON_AddStringToObject(resp, "error_message", errmsg ? errmsg : "Document info failed");
+    }
+    g_api.free_document_info(&info);
+
+    cJSON_AddItemToObject(resp, "diagnostics", diagnostics);
+    return send_json(resp);
+}
+
+/* "render": load the document and return page images, no PDF export.
+ * The "render_result" frame is followed by one binary frame per image. */
+static int handle_render(cJSON* msg) {
+    cJSON* id_json = cJSON_GetObjectItem(msg, "id");
+    int id = id_json && cJSON_IsNumber(id_json) ? id_json->valueint : 0;
+
+    cJSON* input = cJSON_GetObjectItem(msg, "input");
+    cJSON* format_json = cJSON_GetObjectItem(msg, "format");
+    int format = format_json && cJSON_IsNumber(format_json) ? format_json->valueint : 0;
+
+    char* doc_buf = NULL;
+    size_t frame_len = 0;
+    const char* input_error = read_document_input(msg, &doc_buf, &frame_len);
+    if (input_error)
+        return send_error_result("render_result", id, SLIMLO_ERROR_INVALID_ARGUMENT, input_error);
+
+    SlimLORenderOptions opts;
+    const SlimLORenderOptions* opts_ptr = parse_render(msg, &opts);
+
+    stderr_capture_start();
+
+    SlimLOPageImage* images = NULL;
+    int image_count = 0;
+    SlimLOError err = doc_buf
+        ? g_api.render_pages_buffer(g_handle, (const uint8_t*)doc_buf, frame_len,
+                                     (SlimLOFormat)format, opts_ptr, &images, &image_count)
+        : g_api.render_pages(g_handle, input->valuestring, opts_ptr, &images, &image_count);
+    free(doc_buf);
+
+    stderr_capture_stop();
+    size_t stderr_len = stderr_capture_read();
+    cJSON* diagnostics = parse_diagnostics(stderr_len > 0 ? stderr_buf : NULL);
+
+    cJSON* resp = cJSON_CreateObject();
+    cJSON_AddStringToObject(resp, "type", "render_result");
+    cJSON_AddNumberToObject(resp, "id", id);
+
+    if (err == SLIMLO_OK) {
+        cJSON_AddBoolToObject(resp, "success", 1);
+        cJSON_AddNullToObject(resp, "error_code");
+        cJSON_AddNullToObject(resp, "error_message");
+        cJSON_AddItemToObject(resp, "images", images_json(images, image_count));
+    } else {
+        cJSON_AddBoolToObject(resp, "success", 0);
+        cJSON_AddNumberToObject(resp, "error_code", (int)err);
+        const char* errmsg = g_api.get_error_message(g_handle);
+        cJSON_AddStringToObject(resp, "error_message", errmsg ? errmsg : "Page rendering failed");
+    }
+
+    cJSON_AddItemToObject(resp, "diagnostics", diagnostics);
+
+    int rc = send_json(resp);
+    if (rc == 0 && err == SLIMLO_OK)
+        rc = send_image_frames(images, image_count);
+    g_api.free_page_images(images, image_count);
+    return rc;
+}
+
+/* "add_fonts": register font directories with the running instance, no
+ * restart. Every path is tried; the first failure is reported. */
+static int handle_add_fonts(cJSON* msg) {
+    cJSON* id_json = cJSON_GetObjectItem(msg, "id");
+    int id = id_json && cJSON_IsNumber(id_json) ? id_json->valueint : 0;
+
+    cJSON* paths = cJSON_GetObjectItem(msg, "paths");
+    if (!paths || !cJSON_IsArray(paths))
+        return send_error_result("fonts_result", id, SLIMLO_ERROR_INVALID_ARGUMENT,
+                                 "Missing paths in add_fonts message");
+
+    stderr_capture_start();
+
+    SlimLOError err = SLIMLO_OK;
+    char errmsg[512] = "";
+    int count = cJSON_GetArraySize(paths);
+    for (int i = 0; i < count; i++) {
+        cJSON* item = cJSON_GetArrayItem(paths, i);
+        SlimLOError rc = cJSON_IsString(item)
+            ? g_api.add_font_directory(g_handle, item->valuestring)
+            : SLIMLO_ERROR_INVALID_ARGUMENT;
+        if (rc != SLIMLO_OK && err == SLIMLO_OK) {
+            err = rc;
+            const char* m = cJSON_IsString(item) ? g_api.get_error_message(g_handle) : NULL;
+            snprintf(errmsg, sizeof(errmsg), "%s", m && *m ? m : "Invalid font directory");
+        }
+    }
+
+    stderr_capture_stop();
+    size_t stderr_len = stderr_capture_read();
+    cJSON* diagnostics = parse_diagnostics(stderr_len > 0 ? stderr_buf : NULL);
+
+    cJSON* resp = cJSON_CreateObject();
+    cJSON_AddStringToObject(resp, "type", "fonts_result");
+    cJSON_AddNumberToObject(resp, "id", id);
+    if (err == SLIMLO_OK) {
+        cJSON_AddBoolToObject(resp, "success", 1);
+        cJSON_AddNullToObject(resp, "error_code");
+        cJSON_AddNullToObject(resp, "error_message");
+    } else {
+        cJSON_AddBoolToObject(resp, "success", 0);
+        cJSON_AddNumberToObject(resp, "error_code", (int)err);
+        cJSON_AddStringToObject(resp, "error_message", errmsg);
+    }
+    cJSON_AddItemToObject(resp, "diagnostics", diagnostics);
+    return send_json(resp);
 }
 
 /* --------------------------------------------------------------------------
  * Main loop
  * -------------------------------------------------------------------------- */
 
-int main(void) {
+#ifdef SLIMLO_SERVER
+/* slimlo_server.c includes this file and runs the loop in its --worker children */
+static int worker_main(void) {
+    if (select_backend(NULL) != 0)
+        return 2;
+#else
+int main(int argc, char** argv) {
+    const char* simulate = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--simulate") == 0) {
+            simulate = "";
+        } else if (strncmp(argv[i], "--simulate=", 11) == 0) {
+            simulate = argv[i] + 11;
+        } else {
+            fprintf(stderr, "usage: slimlo_worker [--simulate[=SPEC]]\n");
+            return 2;
+        }
+    }
+    if (select_backend(simulate) != 0)
+        return 2;
+#endif
     /* Set stdin/stdout to binary mode for length-prefixed protocol */
     set_binary_mode(stdin);
     set_binary_mode(stdout);
@@ -784,7 +1711,7 @@ int main(void) {
             cJSON_Delete(msg);
             if (rc != 0) break;
             /* If init failed, we can still accept quit but not convert */
-        } else if (strcmp(type_str, "convert") == 0) {
+        } else if (strcmp(type_str, "convert") == 0 || strcmp(type_str, "combine") == 0) {
             if (!g_handle) {
                 cJSON* resp = cJSON_CreateObject();
                 cJSON_AddStringToObject(resp, "type", "result");
@@ -801,6 +1728,13 @@ int main(void) {
             if (rc != 0) break;
         } else if (strcmp(type_str, "convert_buffer") == 0) {
             if (!g_handle) {
+                /* Drain the document so the stream stays in sync */
+                size_t skip_len = 0;
+                int too_large = 0;
+                if (cJSON_IsTrue(cJSON_GetObjectItem(msg, "chunked")))
+                    free(read_chunked(&skip_len, &too_large));
+                else if (cJSON_GetObjectItem(msg, "data_size"))
+                    free(read_message(&skip_len));
                 cJSON* resp = cJSON_CreateObject();
                 cJSON_AddStringToObject(resp, "type", "buffer_result");
                 cJSON_AddBoolToObject(resp, "success", 0);
@@ -814,6 +1748,41 @@ int main(void) {
             int rc = handle_convert_buffer(msg);
             cJSON_Delete(msg);
             if (rc != 0) break;
+        } else if (strcmp(type_str, "info") == 0 || strcmp(type_str, "render") == 0) {
+            int is_info = strcmp(type_str, "info") == 0;
+            if (!g_handle) {
+                /* Drain the data frame so the stream stays in sync */
+                if (cJSON_GetObjectItem(msg, "data_size")) {
+                    size_t skip_len = 0;
+                    free(read_message(&skip_len));
+                }
+                cJSON* id_json = cJSON_GetObjectItem(msg, "id");
+                send_error_result(is_info ? "info_result" : "render_result",
+                                  id_json && cJSON_IsNumber(id_json) ? id_json->valueint : 0,
+                                  SLIMLO_ERROR_NOT_INIT, "Worker not initialized");
+                cJSON_Delete(msg);
+                continue;
+            }
+            int rc = is_info ? handle_info(msg) : handle_render(msg);
+            cJSON_Delete(msg);
+            if (rc != 0) break;
+        } else if (strcmp(type_str, "add_fonts") == 0) {
+            if (!g_handle) {
+                cJSON* id_json = cJSON_GetObjectItem(msg, "id");
+                send_error_result("fonts_result",
+                                  id_json && cJSON_IsNumber(id_json) ? id_json->valueint : 0,
+                                  SLIMLO_ERROR_NOT_INIT, "Worker not initialized");
+                cJSON_Delete(msg);
+                continue;
+            }
+            int rc = handle_add_fonts(msg);
+            cJSON_Delete(msg);
+            if (rc != 0) break;
+        } else if (strcmp(type_str, "ping") == 0) {
+            cJSON_Delete(msg);
+            cJSON* resp = cJSON_CreateObject();
+            cJSON_AddStringToObject(resp, "type", "pong");
+            if (send_json(resp) != 0) break;
         } else if (strcmp(type_str, "quit") == 0) {
             cJSON_Delete(msg);
             break;
@@ -824,7 +1793,7 @@ int main(void) {
 
     /* Cleanup */
     if (g_handle) {
-        slimlo_destroy(g_handle);
+        g_api.destroy(g_handle);
         g_handle = NULL;
     }
 
@@ -0,0 +1,64 @@
+#!/bin/bash
+# bench_combine.sh — one combined conversion vs convert-then-merge
+#
+# Runs slimlo_bench --combine on a packet of documents, then merges the
+# separately converted PDFs it left behind with qpdf (or pdfunite) and
+# reports time and size for each approach. The combined PDF embeds fonts
+# and shared images once; merged PDFs carry one copy per part.
+#
+# Usage:
+#   ./tests/bench_combine.sh BENCH_BINARY RESOURCE_DIR input.docx [input2.docx ...]
+#
+# Environment variables:
+#   ITERATIONS   Timed runs per mode (default: 5)
+#
+# Output is one tab-separated line per approach:
+#   approach  median_ms  pdf_bytes
+# where "convert+merge" is the median of the separate conversions plus one
+# merge of their PDFs.
+set -euo pipefail
+
+BENCH="${1:?Usage: bench_combine.sh BENCH_BINARY RESOURCE_DIR input.docx...}"
+RESOURCE="${2:?Missing RESOURCE_DIR}"
+shift 2
+[ "$#" -ge 1 ] || { echo "Missing input documents" >&2; exit 1; }
+
+ITERATIONS="${ITERATIONS:-5}"
+
+if command -v qpdf >/dev/null 2>&1; then
+    merge() { qpdf --empty --pages "${@:2}" -- "$1"; }
+elif command -v pdfunite >/dev/null 2>&1; then
+    merge() { local out="$1"; shift; pdfunite "$@" "$out"; }
+else
+    echo "Need qpdf or pdfunite for the merge baseline" >&2
+    exit 1
+fi
+
+now_ms() {
+    date +%s%3N
+}
+
+OUT_DIR="$(mktemp -d)"
+trap 'rm -rf "$OUT_DIR"' EXIT
+
+RESULTS="$("$BENCH" --resource "$RESOURCE" --iterations "$ITERATIONS" \
+    --combine --out-dir "$OUT_DIR" "$@")"
+
+combine_ms=$(awk -F'\t' '$2 == "combine" { print $4 }' <<<"$RESULTS")
+combine_bytes=$(awk -F'\t' '$2 == "combine" { print $6 }' <<<"$RESULTS")
+separate_ms=$(awk -F'\t' '$2 == "separate" { print $4 }' <<<"$RESULTS")
+
+parts=()
+for i in $(seq 1 "$#"); do
+    parts+=("$OUT_DIR/part_$i.pdf")
+done
+start=$(now_ms)
+merge "$OUT_DIR/merged.pdf" "${parts[@]}"
+merge_ms=$(( $(now_ms) - start ))
+merged_bytes=$(wc -c < "$OUT_DIR/merged.pdf" | tr -d ' ')
+
+printf 'approach\tmedian_ms\tpdf_bytes\n'
+printf 'combine\t%s\t%s\n' "$combine_ms" "$combine_bytes"
+printf 'convert+merge\t%s\t%s\n' \
+    "$(awk -v a="$separate_ms" -v b="$merge_ms" 'BEGIN { printf "%.1f", a + b }')" \
+    "$merged_bytes"
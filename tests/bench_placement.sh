@@ -0,0 +1,118 @@
+#!/bin/bash
+# bench_placement.sh — pinned vs unpinned workers at full load (Linux)
+#
+# Runs WORKERS concurrent slimlo_bench processes (one SlimLO instance each,
+# like pool workers) twice: once left to the OS scheduler, once placed the
+# way WorkerPlacement.Pinned places pool workers — worker i on NUMA node
+# i mod nodes, each with its own contiguous share of that node's CPUs and
+# node-local memory — and reports conversion throughput for both. Wall time
+# includes each process's LibreOffice startup, so use enough ITERATIONS to
+# amortize it.
+#
+# Usage:
+#   ./tests/bench_placement.sh BENCH_BINARY RESOURCE_DIR input.docx [input2.docx ...]
+#
+# Environment variables:
+#   ITERATIONS   Conversions per input per process (default: 5)
+#   WORKERS      Concurrent processes (default: CPUs / THREADS)
+#   THREADS      Thread budget per process (default: 2)
+#   ROUNDS       Runs per placement, alternated to even out drift (default: 3)
+#
+# Pinning uses numactl when installed (CPUs + --localalloc), else taskset
+# (CPUs only). Output is one tab-separated line per run:
+#   placement  round  wall_ms  conversions  docs_per_sec
+set -euo pipefail
+
+BENCH="${1:?Usage: bench_placement.sh BENCH_BINARY RESOURCE_DIR input.docx...}"
+RESOURCE="${2:?Missing RESOURCE_DIR}"
+shift 2
+[ "$#" -ge 1 ] || { echo "Missing input documents" >&2; exit 1; }
+
+ITERATIONS="${ITERATIONS:-5}"
+THREADS="${THREADS:-2}"
+ROUNDS="${ROUNDS:-3}"
+CPUS=$(nproc)
+WORKERS="${WORKERS:-$(( CPUS / THREADS > 0 ? CPUS / THREADS : 1 ))}"
+
+now_ms() {
+    date +%s%3N
+}
+
+# "0-3,8" -> "0 1 2 3 8"
+expand_cpus() {
+    local part
+    for part in ${1//,/ }; do
+        if [[ "$part" == *-* ]]; then
+            seq -s ' ' "${part%-*}" "${part#*-}"
+        else
+            echo "$part"
+        fi
+    done | tr '\n' ' '
+}
+
+# CPU lists of the NUMA nodes that have CPUs; one node of all CPUs without sysfs
+nodes=()
+for dir in /sys/devices/system/node/node[0-9]*; do
+    [ -r "$dir/cpulist" ] || continue
+    list=$(expand_cpus "$(cat "$dir/cpulist")")
+    [ -n "${list// /}" ] && nodes+=("$list")
+done
+[ "${#nodes[@]}" -gt 0 ] || nodes=("$(seq -s ' ' 0 $((CPUS - 1)))")
+
+# CPU set of worker i, as a comma-separated list (same split as CpuTopology.Partition)
+cpu_set() {
+    local i=$1 n=${#nodes[@]}
+    local cpus=(${nodes[$((i % n))]})
+    local on_node=$(( (WORKERS - i % n + n - 1) / n ))
+    local rank=$(( i / n ))
+    local start=$(( rank * ${#cpus[@]} / on_node ))
+    local end=$(( (rank + 1) * ${#cpus[@]} / on_node ))
+    if [ "$on_node" -gt "${#cpus[@]}" ]; then
+        echo "${cpus[$start]}"
+    else
+        local set=("${cpus[@]:$start:$((end - start))}")
+        local IFS=,
+        echo "${set[*]}"
+    fi
+}
+
+run() {
+    local placement=$1 round=$2
+    shift 2
+    local start pids=() failed=0
+    start=$(now_ms)
+    for i in $(seq 0 $((WORKERS - 1))); do
+        local prefix=()
+        if [ "$placement" = pinned ]; then
+            if command -v numactl >/dev/null; then
+                prefix=(numactl --physcpubind="$(cpu_set "$i")" --localalloc)
+            else
+                prefix=(taskset -c "$(cpu_set "$i")")
+            fi
+        fi
+        # Presets "none" only: one timed conversion per iteration per input
+        "${prefix[@]}" "$BENCH" --resource "$RESOURCE" --iterations "$ITERATIONS" \
+            --threads "$THREADS" --preset none "$@" >/dev/null 2>&1 &
+        pids+=($!)
+    done
+    for pid in "${pids[@]}"; do
+        wait "$pid" || failed=1
+    done
+    local wall=$(( $(now_ms) - start ))
+    if [ "$failed" -ne 0 ]; then
+        echo "FAIL: placement=$placement round=$round" >&2
+        exit 1
+    fi
+    # Each process also runs one untimed warm-up conversion per input
+    local conversions=$(( WORKERS * (ITERATIONS + 1) * $# ))
+    local rate
+    rate=$(awk -v n="$conversions" -v ms="$wall" 'BEGIN { printf "%.2f", n * 1000 / ms }')
+    printf '%s\t%d\t%d\t%d\t%s\n' "$placement" "$round" "$wall" "$conversions" "$rate"
+}
+
+echo "# ${#nodes[@]} NUMA node(s), $CPUS CPUs, $WORKERS workers x $THREADS threads" >&2
+printf 'placement\tround\twall_ms\tconversions\tdocs_per_sec\n'
+for round in $(seq 1 "$ROUNDS"); do
+    run unpinned "$round" "$@"
+    run pinned "$round" "$@"
+done
@@ -0,0 +1,63 @@
+#!/bin/bash
+# bench_threads.sh — workers × threads-per-worker matrix for one node
+#
+# Runs W concurrent slimlo_bench processes (one SlimLO instance each, like
+# W pool workers) with a thread budget of T, for every W×T that fits the
+# CPU count, and reports conversion throughput. Use it to pick
+# MaxWorkers / ThreadsPerWorker for a node type. Wall time includes each
+# process's LibreOffice startup, so use enough ITERATIONS to amortize it.
+#
+# Usage:
+#   ./tests/bench_threads.sh BENCH_BINARY RESOURCE_DIR input.docx [input2.docx ...]
+#
+# Environment variables:
+#   ITERATIONS   Conversions per input per process (default: 5)
+#   CPUS         CPU count to split (default: nproc)
+#
+# Output is one tab-separated line per combination:
+#   workers  threads  wall_ms  conversions  docs_per_sec
+set -euo pipefail
+
+BENCH="${1:?Usage: bench_threads.sh BENCH_BINARY RESOURCE_DIR input.docx...}"
+RESOURCE="${2:?Missing RESOURCE_DIR}"
+shift 2
+[ "$#" -ge 1 ] || { echo "Missing input documents" >&2; exit 1; }
+
+ITERATIONS="${ITERATIONS:-5}"
+CPUS="${CPUS:-$(nproc 2>/dev/null || sysctl -n hw.ncpu)}"
+
+now_ms() {
+    date +%s%3N
+}
+
+printf 'workers\tthreads\twall_ms\tconversions\tdocs_per_sec\n'
+
+workers=1
+while [ "$workers" -le "$CPUS" ]; do
+    threads=1
+    while [ $((workers * threads)) -le "$CPUS" ]; do
+        start=$(now_ms)
+        pids=()
+        for _ in $(seq 1 "$workers"); do
+            # Presets "none" only: one timed conversion per iteration per input
+            "$BENCH" --resource "$RESOURCE" --iterations "$ITERATIONS" \
+                --threads "$threads" --preset none "$@" >/dev/null 2>&1 &
+            pids+=($!)
+        done
+        failed=0
+        for pid in "${pids[@]}"; do
+            wait "$pid" || failed=1
+        done
+        wall=$(( $(now_ms) - start ))
+        if [ "$failed" -ne 0 ]; then
+            echo "FAIL: workers=$workers threads=$threads" >&2
+            exit 1
+        fi
+        # Each process also runs one untimed warm-up conversion per input
+        conversions=$(( workers * (ITERATIONS + 1) * $# ))
+        rate=$(awk -v n="$conversions" -v ms="$wall" 'BEGIN { printf "%.2f", n * 1000 / ms }')
+        printf '%d\t%d\t%d\t%d\t%s\n' "$workers" "$threads" "$wall" "$conversions" "$rate"
+        threads=$((threads * 2))
+    done
+    workers=$((workers * 2))
+done
@@ -0,0 +1,231 @@
+#!/usr/bin/env python3
+"""Generate a field-heavy DOCX for load/field-update benchmarks.
+
+Creates tests/fixtures/toc_heavy.docx — a long report whose fields all carry
+cached results, the way Word saves them:
+  - Table of contents with one PAGEREF-backed entry per heading
+  - 120 chapters/sections (Heading 1-3), each bookmarked
+  - Cross-references (REF / PAGEREF) to other sections in the body
+  - "Page N of M" (PAGE / NUMPAGES) lines
+  - Index entries (XE) and an INDEX field at the end
+
+Used with slimlo_bench --skip-field-update to compare load and export time
+with and without field/TOC refresh.
+"""
+
+import os
+import zipfile
+import xml.sax.saxutils as saxutils
+
+W = "http://schemas.openxmlformats.org/wordprocessingml/2006/main"
+R = "http://schemas.openxmlformats.org/officeDocument/2006/relationships"
+RELS_NS = "http://schemas.openxmlformats.org/package/2006/relationships"
+
+CHAPTERS = 12
+SECTIONS_PER_CHAPTER = 5
+SUBSECTIONS_PER_SECTION = 1
+
+LOREM = [
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit. Sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.",
+    "Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat.",
+    "Duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur.",
+    "Excepteur sint occaecat cupidatat non proident, sunt in culpa qui officia deserunt mollit anim id est laborum.",
+]
+
+INDEX_TERMS = ["latency", "throughput", "layout", "fonts", "pagination", "rendering"]
+
+
+def esc(text):
+    return saxutils.escape(text)
+
+
+def run(text, bold=False):
+    rpr = "<w:rPr><w:b/></w:rPr>" if bold else ""
+    return f'<w:r>{rpr}<w:t xml:space="preserve">{esc(text)}</w:t></w:r>'
+
+
+def field(instr, cached):
+    """Complex field with a cached result, as Word writes it."""
+    return (
+        '<w:r><w:fldChar w:fldCharType="begin"/></w:r>'
+        f'<w:r><w:instrText xml:space="preserve"> {esc(instr)} </w:instrText></w:r>'
+        '<w:r><w:fldChar w:fldCharType="separate"/></w:r>'
+        + run(cached)
+        + '<w:r><w:fldChar w:fldCharType="end"/></w:r>'
+    )
+
+
+def para(content, style=None, page_break_before=False):
+    ppr = []
+    if style:
+        ppr.append(f'<w:pStyle w:val="{style}"/>')
+    if page_break_before:
+        ppr.append("<w:pageBreakBefore/>")
+    ppr_xml = f"<w:pPr>{''.join(ppr)}</w:pPr>" if ppr else ""
+    return f"<w:p>{ppr_xml}{content}</w:p>"
+
+
+def heading(level, text, bookmark, bm_id, page_break_before=False):
+    content = (
+        f'<w:bookmarkStart w:id="{bm_id}" w:name="{bookmark}"/>'
+        + run(text)
+        + f'<w:bookmarkEnd w:id="{bm_id}"/>'
+    )
+    return para(content, style=f"Heading{level}", page_break_before=page_break_before)
+
+
+def build_outline():
+    """(level, title, bookmark, cached page) for every heading."""
+    outline = []
+    page = 3  # title page + TOC pages
+    for c in range(1, CHAPTERS + 1):
+        outline.append((1, f"Chapter {c}", f"_Toc_c{c}", page))
+        for s in range(1, SECTIONS_PER_CHAPTER + 1):
+            outline.append((2, f"{c}.{s} Section", f"_Toc_c{c}s{s}", page))
+            for u in range(1, SUBSECTIONS_PER_SECTION + 1):
+                outline.append((3, f"{c}.{s}.{u} Detail", f"_Toc_c{c}s{s}u{u}", page))
+            page += 1
+    return outline, page
+
+
+def build_document():
+    outline, total_pages = build_outline()
+    paras = [para(run("Field-heavy report", bold=True))]
+
+    # Table of contents: cached entries with PAGEREF fields, wrapped in a TOC field
+    paras.append(
+        "<w:p>"
+        '<w:r><w:fldChar w:fldCharType="begin"/></w:r>'
+        '<w:r><w:instrText xml:space="preserve"> TOC \\o "1-3" \\h \\z \\u </w:instrText></w:r>'
+        '<w:r><w:fldChar w:fldCharType="separate"/></w:r>'
+        "</w:p>"
+    )
+    for level, title, bookmark, page in outline:
+        paras.append(para(
+            run(title) + '<w:r><w:tab/></w:r>' + field(f"PAGEREF {bookmark} \\h", str(page)),
+            style=f"TOC{level}",
+        ))
+    paras.append('<w:p><w:r><w:fldChar w:fldCharType="end"/></w:r></w:p>')
+
+    # Body
+    for i, (level, title, bookmark, page) in enumerate(outline):
+        paras.append(heading(level, title, bookmark, i + 1, page_break_before=(level == 1)))
+        target = outline[(i * 7 + 3) % len(outline)]
+        term = INDEX_TERMS[i % len(INDEX_TERMS)]
+        paras.append(para(
+            run(LOREM[i % len(LOREM)] + " See ")
+            + field(f"REF {target[2]} \\h", target[1])
+            + run(" on page ")
+            + field(f"PAGEREF {target[2]} \\h", str(target[3]))
+            + run(f". Notes on {term}.")
+            + field(f'XE "{term}"', "")
+        ))
+        if level == 2:
+            paras.append(para(
+                run("Page ") + field("PAGE", str(page))
+                + run(" of ") + field("NUMPAGES", str(total_pages))
+            ))
+        paras.append(para(run(LOREM[(i + 1) % len(LOREM)])))
+
+    # Index
+    paras.append(para(run("Index", bold=True), page_break_before=True))
+    paras.append(
+        "<w:p>"
+        '<w:r><w:fldChar w:fldCharType="begin"/></w:r>'
+        '<w:r><w:instrText xml:space="preserve"> INDEX \\e "\t" \\c "1" </w:instrText></w:r>'
+        '<w:r><w:fldChar w:fldCharType="separate"/></w:r>'
+        "</w:p>"
+    )
+    for n, term in enumerate(sorted(INDEX_TERMS)):
+        paras.append(para(run(f"{term}\t{3 + n}")))
+    paras.append('<w:p><w:r><w:fldChar w:fldCharType="end"/></w:r></w:p>')
+
+    return paras, len(outline), total_pages
+
+
+def build_styles_xml():
+    styles = []
+    for level, size in ((1, 40), (2, 32), (3, 26)):
+        styles.append(
+            f'  <w:style w:type="paragraph" w:styleId="Heading{level}">\n'
+            f'    <w:name w:val="heading {level}"/>\n'
+            f'    <w:pPr><w:keepNext/><w:outlineLvl w:val="{level - 1}"/></w:pPr>\n'
+            f'    <w:rPr><w:b/><w:sz w:val="{size}"/></w:rPr>\n'
+            '  </w:style>'
+        )
+        styles.append(
+            f'  <w:style w:type="paragraph" w:styleId="TOC{level}">\n'
+            f'    <w:name w:val="toc {level}"/>\n'
+            f'    <w:pPr><w:tabs><w:tab w:val="right" w:leader="dot" w:pos="9350"/></w:tabs>'
+            f'<w:ind w:left="{(level - 1) * 220}"/></w:pPr>\n'
+            '  </w:style>'
+        )
+    return (
+        '<?xml version="1.0" encoding="UTF-8" standalone="yes"?>\n'
+        f'<w:styles xmlns:w="{W}">\n' + "\n".join(styles) + "\n</w:styles>"
+    )
+
+
+def main():
+    script_dir = os.path.dirname(os.path.abspath(__file__))
+    fixtures_dir = os.path.join(script_dir, "fixtures")
+    os.makedirs(fixtures_dir, exist_ok=True)
+    out_path = os.path.join(fixtures_dir, "toc_heavy.docx")
+
+    print("Generating toc_heavy.docx ...")
+
+    paras, headings, pages = build_document()
+
+    sect_pr = (
+        '<w:sectPr>'
+        '<w:pgSz w:w="12240" w:h="15840"/>'
+        '<w:pgMar w:top="1440" w:right="1440" w:bottom="1440" w:left="1440" '
+        'w:header="720" w:footer="720" w:gutter="0"/>'
+        '</w:sectPr>'
+    )
+    body = "\n".join(paras) + "\n" + sect_pr
+    doc_xml = (
+        '<?xml version="1.0" encoding="UTF-8" standalone="yes"?>\n'
+        f'<w:document xmlns:w="{W}" xmlns:r="{R}">\n'
+        f'  <w:body>\n{body}\n  </w:body>\n'
+        f'</w:document>'
+    )
+
+    content_types = """\
+<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Types xmlns="http://schemas.openxmlformats.org/package/2006/content-types">
+  <Default Extension="rels" ContentType="application/vnd.openxmlformats-package.relationships+xml"/>
+  <Default Extension="xml" ContentType="application/xml"/>
+  <Override PartName="/word/document.xml" ContentType="application/vnd.openxmlformats-officedocument.wordprocessingml.document.main+xml"/>
+  <Override PartName="/word/styles.xml" ContentType="application/vnd.openxmlformats-officedocument.wordprocessingml.styles+xml"/>
+</Types>"""
+
+    rels = f"""\
+<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Relationships xmlns="{RELS_NS}">
+  <Relationship Id="rId1" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument" Target="word/document.xml"/>
+</Relationships>"""
+
+    doc_rels = f"""\
+<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Relationships xmlns="{RELS_NS}">
+  <Relationship Id="rId1" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/styles" Target="styles.xml"/>
+</Relationships>"""
+
+    with zipfile.ZipFile(out_path, "w", zipfile.ZIP_DEFLATED) as zf:
+        zf.writestr("[Content_Types].xml", content_types)
+        zf.writestr("_rels/.rels", rels)
+        zf.writestr("word/document.xml", doc_xml)
+        zf.writestr("word/_rels/document.xml.rels", doc_rels)
+        zf.writestr("word/styles.xml", build_styles_xml())
+
+    size = os.path.getsize(out_path)
+    print(f"  Created {out_path}")
+    print(f"  Size: {size:,} bytes")
+    print(f"  Headings: {headings}")
+    print(f"  Cached page count: {pages}")
+    print("Done.")
+
+
+if __name__ == "__main__":
+    main()
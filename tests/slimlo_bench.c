@@ -0,0 +1,934 @@
+/*
+ * slimlo_bench.c — SlimLO conversion benchmark
+ *
+ * Converts each input document once per PDF preset (in-memory, via
+ * slimlo_convert_buffer) and reports latency and output size, so the
+ * cost/size trade-off of each preset can be measured on real fixtures.
+ *
+ * Build:
+ *   gcc -O2 -o slimlo_bench slimlo_bench.c -I/opt/slimlo/include \
+ *       -L/opt/slimlo/program -lslimlo -Wl,-rpath,/opt/slimlo/program
+ *
+ * Run:
+ *   ./slimlo_bench [options] input.docx [input2.docx ...]
+ *
+ * Options:
+ *   --resource DIR     SlimLO resource directory (default: /opt/slimlo)
+ *   --iterations N     Timed conversions per input/preset (default: 5)
+ *   --preset NAME      none|fast|small|archival|print|all (default: all)
+ *   --threads N        Thread budget for LibreOffice's internal pools
+ *                      (slimlo_init_ex; default: 0 = one per core)
+ *   --info             Compare slimlo_document_info_buffer (load + layout)
+ *                      against a full conversion instead of presets
+ *   --first-page       Time exporting page 1 only, with full layout and with
+ *                      lazy_layout (layout stops after page 1)
+ *   --skip-field-update
+ *                      Time full conversions with and without
+ *                      skip_field_update (e.g. on fixtures/toc_heavy.docx from
+ *                      generate_toc_docx.py)
+ *   --combine          Treat all inputs as one packet: time
+ *                      slimlo_combine_to_pdf (one PDF, one bookmark per
+ *                      input) against converting each input separately
+ *   --out-dir DIR      Where --combine writes combined.pdf and the
+ *                      separate part_N.pdf files (default: /tmp); see
+ *                      bench_combine.sh for the convert-then-merge baseline
+ *   --allocator        Time getting the PDF into a caller-owned arena:
+ *                      slimlo_convert_buffer then a copy ("copy"), against
+ *                      slimlo_convert_buffer_alloc without realloc ("staged",
+ *                      as slimlo.hpp's memory_resource path) and with an
+ *                      in-place realloc ("direct"). The copy shows on large
+ *                      outputs, e.g. image-heavy documents with 50 MB PDFs
+ *   --soak             Convert the inputs in rotation, in one instance, until
+ *                      --duration or --conversions is reached (Ctrl-C stops
+ *                      early), sampling the process every --sample-every
+ *                      conversions. After --warmup conversions, fits growth
+ *                      slopes and fails if RSS grows more than --rss-budget
+ *                      per 1,000 conversions, window median latency drifts
+ *                      up more than --latency-drift percent, or a conversion
+ *                      fails. LibreOffice's TMPDIR is pointed at a fresh
+ *                      directory (--tmp-dir) so leaked temp files show up
+ *   --duration SECS    Soak for at most SECS seconds
+ *   --conversions N    Soak for at most N conversions (default without
+ *                      --duration: 10000)
+ *   --sample-every N   Conversions per sample and latency window (default: 100)
+ *   --warmup N         Conversions left out of the fits, while caches fill
+ *                      (default: 500)
+ *   --rss-budget KB    Allowed RSS growth per 1,000 conversions (default: 2048)
+ *   --latency-drift P  Allowed rise of the fitted median latency over the
+ *                      run, in percent (default: 10)
+ *   --rss-headroom MB  RSS growth a worker may accumulate before recycling,
+ *                      used to suggest MaxConversionsPerWorker (default: 512)
+ *   --tmp-dir DIR      TMPDIR for LibreOffice (default: a new
+ *                      /tmp/slimlo_soak_XXXXXX)
+ *
+ * Output is one tab-separated line per input/preset:
+ *   file  preset  min_ms  median_ms  max_ms  pdf_bytes
+ *
+ * With --info, one line per input/mode ("info" or "convert"):
+ *   file  mode  min_ms  median_ms  max_ms  pages
+ *
+ * With --first-page, one line per input/mode ("full" or "lazy"):
+ *   file  mode  min_ms  median_ms  max_ms  pdf_bytes
+ *
+ * With --skip-field-update, one line per input/mode ("update" or "cached"):
+ *   file  mode  min_ms  median_ms  max_ms  pdf_bytes
+ *
+ * With --combine, one line per mode ("combine" or "separate"), where
+ * separate times and sizes are summed over the inputs:
+ *   packet  mode  min_ms  median_ms  max_ms  pdf_bytes
+ *
+ * With --allocator, one line per input/mode ("copy", "staged", "direct"):
+ *   file  mode  min_ms  median_ms  max_ms  pdf_bytes
+ *
+ * With --soak, one line per sample (heap_kb: allocator bytes in use, 0
+ * where unavailable; tmp_*: contents of the soak's TMPDIR; median/p95 over
+ * the conversions since the previous sample), then the fitted slopes and
+ * the verdict on stderr:
+ *   conversions  elapsed_s  rss_kb  heap_kb  fds  tmp_files  tmp_kb
+ *   median_ms  p95_ms  failures
+ */
+
+#include <dirent.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <mach/mach.h>
+#include <malloc/malloc.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#include "slimlo.h"
+
+#define MAX_ITERATIONS 1000
+#define MAX_PARTS 256
+
+static const struct {
+    const char* name;
+    SlimLOPdfPreset preset;
+} PRESETS[] = {
+    { "none",     SLIMLO_PRESET_NONE },
+    { "fast",     SLIMLO_PRESET_FAST },
+    { "small",    SLIMLO_PRESET_SMALL },
+    { "archival", SLIMLO_PRESET_ARCHIVAL },
+    { "print",    SLIMLO_PRESET_PRINT },
+};
+#define PRESET_COUNT (sizeof(PRESETS) / sizeof(PRESETS[0]))
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+}
+
+static int cmp_double(const void* a, const void* b) {
+    double da = *(const double*)a, db = *(const double*)b;
+    return (da > db) - (da < db);
+}
+
+static uint8_t* read_file(const char* path, size_t* out_size) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long sz = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (sz <= 0) {
+        fclose(f);
+        return NULL;
+    }
+    uint8_t* buf = (uint8_t*)malloc((size_t)sz);
+    if (buf && fread(buf, 1, (size_t)sz, f) != (size_t)sz) {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(f);
+    *out_size = (size_t)sz;
+    return buf;
+}
+
+static size_t file_size(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return 0;
+    fseek(f, 0, SEEK_END);
+    long sz = ftell(f);
+    fclose(f);
+    return sz > 0 ? (size_t)sz : 0;
+}
+
+static const char* base_name(const char* path) {
+    const char* slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+/* Run one input through one preset. Returns 0 on success. */
+static int bench_preset(SlimLOHandle handle, const char* path,
+                        const uint8_t* data, size_t size,
+                        const char* preset_name, SlimLOPdfPreset preset,
+                        int iterations) {
+    SlimLOPdfOptions opts;
+    memset(&opts, 0, sizeof(opts));
+    opts.preset = preset;
+
+    double samples[MAX_ITERATIONS];
+    size_t pdf_size = 0;
+
+    for (int i = 0; i < iterations; i++) {
+        uint8_t* pdf = NULL;
+        size_t out_size = 0;
+        double start = now_ms();
+        SlimLOError err = slimlo_convert_buffer(
+            handle, data, size, SLIMLO_FORMAT_DOCX, &opts, &pdf, &out_size);
+        samples[i] = now_ms() - start;
+        if (err != SLIMLO_OK) {
+            fprintf(stderr, "FAIL: %s [%s]: error %d: %s\n",
+                    path, preset_name, err, slimlo_get_error_message(handle));
+            return 1;
+        }
+        pdf_size = out_size;
+        slimlo_free_buffer(pdf);
+    }
+
+    qsort(samples, (size_t)iterations, sizeof(double), cmp_double);
+    printf("%s\t%s\t%.1f\t%.1f\t%.1f\t%zu\n",
+           base_name(path), preset_name,
+           samples[0], samples[iterations / 2], samples[iterations - 1],
+           pdf_size);
+    fflush(stdout);
+    return 0;
+}
+
+/* Time document info against a default conversion. Returns 0 on success. */
+static int bench_info(SlimLOHandle handle, const char* path,
+                      const uint8_t* data, size_t size, int iterations) {
+    double info_samples[MAX_ITERATIONS];
+    double convert_samples[MAX_ITERATIONS];
+    int pages = 0;
+
+    for (int i = 0; i < iterations; i++) {
+        SlimLODocumentInfo info;
+        double start = now_ms();
+        SlimLOError err = slimlo_document_info_buffer(
+            handle, data, size, SLIMLO_FORMAT_DOCX, &info);
+        info_samples[i] = now_ms() - start;
+        pages = info.page_count;
+        slimlo_free_document_info(&info);
+        if (err != SLIMLO_OK) {
+            fprintf(stderr, "FAIL: %s [info]: error %d: %s\n",
+                    path, err, slimlo_get_error_message(handle));
+            return 1;
+        }
+
+        uint8_t* pdf = NULL;
+        size_t pdf_size = 0;
+        start = now_ms();
+        err = slimlo_convert_buffer(handle, data, size, SLIMLO_FORMAT_DOCX,
+                                    NULL, &pdf, &pdf_size);
+        convert_samples[i] = now_ms() - start;
+        slimlo_free_buffer(pdf);
+        if (err != SLIMLO_OK) {
+            fprintf(stderr, "FAIL: %s [convert]: error %d: %s\n",
+                    path, err, slimlo_get_error_message(handle));
+            return 1;
+        }
+    }
+
+    qsort(info_samples, (size_t)iterations, sizeof(double), cmp_double);
+    qsort(convert_samples, (size_t)iterations, sizeof(double), cmp_double);
+    printf("%s\tinfo\t%.1f\t%.1f\t%.1f\t%d\n", base_name(path),
+           info_samples[0], info_samples[iterations / 2],
+           info_samples[iterations - 1], pages);
+    printf("%s\tconvert\t%.1f\t%.1f\t%.1f\t%d\n", base_name(path),
+           convert_samples[0], convert_samples[iterations / 2],
+           convert_samples[iterations - 1], pages);
+    fflush(stdout);
+    return 0;
+}
+
+/* Time conversions with an option off (mode 0) and on (mode 1).
+ * Returns 0 on success. */
+static int bench_toggle(SlimLOHandle handle, const char* path,
+                        const uint8_t* data, size_t size, int iterations,
+                        const char* const modes[2],
+                        void (*apply)(SlimLOPdfOptions* opts, int on)) {
+    for (int on = 0; on <= 1; on++) {
+        SlimLOPdfOptions opts;
+        memset(&opts, 0, sizeof(opts));
+        apply(&opts, on);
+
+        double samples[MAX_ITERATIONS];
+        size_t pdf_size = 0;
+
+        for (int i = 0; i < iterations; i++) {
+            uint8_t* pdf = NULL;
+            size_t out_size = 0;
+            double start = now_ms();
+            SlimLOError err = slimlo_convert_buffer(
+                handle, data, size, SLIMLO_FORMAT_DOCX, &opts, &pdf, &out_size);
+            samples[i] = now_ms() - start;
+            if (err != SLIMLO_OK) {
+                fprintf(stderr, "FAIL: %s [%s]: error %d: %s\n",
+                        path, modes[on], err, slimlo_get_error_message(handle));
+                return 1;
+            }
+            pdf_size = out_size;
+            slimlo_free_buffer(pdf);
+        }
+
+        qsort(samples, (size_t)iterations, sizeof(double), cmp_double);
+        printf("%s\t%s\t%.1f\t%.1f\t%.1f\t%zu\n", base_name(path), modes[on],
+               samples[0], samples[iterations / 2], samples[iterations - 1],
+               pdf_size);
+    }
+    fflush(stdout);
+    return 0;
+}
+
+/* --first-page: export page 1 only, with full layout vs lazy_layout */
+static const char* const FIRST_PAGE_MODES[2] = { "full", "lazy" };
+
+static void apply_first_page(SlimLOPdfOptions* opts, int on) {
+    opts->page_range = "1";
+    opts->lazy_layout = on;
+}
+
+/* --skip-field-update: refresh fields/links vs keep cached results */
+static const char* const FIELD_UPDATE_MODES[2] = { "update", "cached" };
+
+static void apply_skip_field_update(SlimLOPdfOptions* opts, int on) {
+    opts->skip_field_update = on;
+}
+
+/* --combine: one combined PDF vs one PDF per input. Returns 0 on success. */
+static int bench_combine(SlimLOHandle handle, char** paths, int count,
+                         const char* out_dir, int iterations) {
+    SlimLOCombinePart parts[MAX_PARTS];
+    for (int p = 0; p < count; p++) {
+        parts[p].input_path = paths[p];
+        parts[p].bookmark = base_name(paths[p]);
+    }
+
+    char combined[4096];
+    snprintf(combined, sizeof(combined), "%s/combined.pdf", out_dir);
+
+    double combine_samples[MAX_ITERATIONS];
+    double separate_samples[MAX_ITERATIONS];
+    size_t separate_bytes = 0;
+
+    for (int i = 0; i < iterations; i++) {
+        double start = now_ms();
+        SlimLOError err = slimlo_combine_to_pdf(handle, parts, count, combined, NULL);
+        combine_samples[i] = now_ms() - start;
+        if (err != SLIMLO_OK) {
+            fprintf(stderr, "FAIL: [combine]: error %d: %s\n",
+                    err, slimlo_get_error_message(handle));
+            return 1;
+        }
+
+        separate_samples[i] = 0;
+        separate_bytes = 0;
+        for (int p = 0; p < count; p++) {
+            char part_pdf[4096];
+            snprintf(part_pdf, sizeof(part_pdf), "%s/part_%d.pdf", out_dir, p + 1);
+            start = now_ms();
+            err = slimlo_convert_file(handle, paths[p], part_pdf, SLIMLO_FORMAT_DOCX, NULL);
+            separate_samples[i] += now_ms() - start;
+            if (err != SLIMLO_OK) {
+                fprintf(stderr, "FAIL: %s [separate]: error %d: %s\n",
+                        paths[p], err, slimlo_get_error_message(handle));
+                return 1;
+            }
+            separate_bytes += file_size(part_pdf);
+        }
+    }
+
+    qsort(combine_samples, (size_t)iterations, sizeof(double), cmp_double);
+    qsort(separate_samples, (size_t)iterations, sizeof(double), cmp_double);
+    printf("%d files\tcombine\t%.1f\t%.1f\t%.1f\t%zu\n", count,
+           combine_samples[0], combine_samples[iterations / 2],
+           combine_samples[iterations - 1], file_size(combined));
+    printf("%d files\tseparate\t%.1f\t%.1f\t%.1f\t%zu\n", count,
+           separate_samples[0], separate_samples[iterations / 2],
+           separate_samples[iterations - 1], separate_bytes);
+    fflush(stdout);
+    return 0;
+}
+
+/* --allocator: a bump arena standing in for a service's response memory.
+ * The last block grows in place, as an arena can do for realloc. */
+typedef struct {
+    uint8_t* base;
+    size_t capacity;
+    size_t used;
+} BenchArena;
+
+static void* arena_alloc(void* ctx, size_t size) {
+    BenchArena* arena = (BenchArena*)ctx;
+    if (size > arena->capacity - arena->used) return NULL;
+    void* ptr = arena->base + arena->used;
+    arena->used += size;
+    return ptr;
+}
+
+static void* arena_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size) {
+    BenchArena* arena = (BenchArena*)ctx;
+    if ((uint8_t*)ptr + old_size == arena->base + arena->used &&
+        (new_size <= old_size || new_size - old_size <= arena->capacity - arena->used)) {
+        arena->used = arena->used - old_size + new_size;
+        return ptr;
+    }
+    void* grown = arena_alloc(ctx, new_size);
+    if (grown) memcpy(grown, ptr, old_size < new_size ? old_size : new_size);
+    return grown;
+}
+
+static void arena_free(void* ctx, void* ptr, size_t size) {
+    (void)ctx; (void)ptr; (void)size;  /* released with the arena */
+}
+
+static const char* const ALLOCATOR_MODES[3] = { "copy", "staged", "direct" };
+
+/* Time copy / staged / direct output into an arena. Returns 0 on success. */
+static int bench_allocator(SlimLOHandle handle, const char* path,
+                           const uint8_t* data, size_t size,
+                           size_t pdf_hint, int iterations) {
+    BenchArena arena;
+    /* Room for the copy or the realloc growth, touched up front so page
+     * faults are not timed */
+    arena.capacity = pdf_hint * 4 + (1 << 20);
+    arena.base = (uint8_t*)malloc(arena.capacity);
+    if (!arena.base) {
+        fprintf(stderr, "FAIL: %s [allocator]: cannot allocate arena\n", path);
+        return 1;
+    }
+    memset(arena.base, 0, arena.capacity);
+
+    for (int mode = 0; mode < 3; mode++) {
+        double samples[MAX_ITERATIONS];
+        size_t pdf_size = 0;
+
+        for (int i = 0; i < iterations; i++) {
+            arena.used = 0;
+            SlimLOError err;
+            double start = now_ms();
+            if (mode == 0) {
+                uint8_t* pdf = NULL;
+                err = slimlo_convert_buffer(handle, data, size, SLIMLO_FORMAT_DOCX,
+                                            NULL, &pdf, &pdf_size);
+                if (err == SLIMLO_OK) {
+                    void* copy = arena_alloc(&arena, pdf_size);
+                    if (copy) memcpy(copy, pdf, pdf_size);
+                    else err = SLIMLO_ERROR_OUT_OF_MEMORY;
+                }
+                slimlo_free_buffer(pdf);
+            } else {
+                SlimLOAllocator allocator = {
+                    arena_alloc, mode == 2 ? arena_realloc : NULL, arena_free, &arena
+                };
+                uint8_t* pdf = NULL;
+                err = slimlo_convert_buffer_alloc(handle, data, size, SLIMLO_FORMAT_DOCX,
+                                                  NULL, &allocator, &pdf, &pdf_size);
+            }
+            samples[i] = now_ms() - start;
+            if (err != SLIMLO_OK) {
+                fprintf(stderr, "FAIL: %s [%s]: error %d: %s\n",
+                        path, ALLOCATOR_MODES[mode], err,
+                        slimlo_get_error_message(handle));
+                free(arena.base);
+                return 1;
+            }
+        }
+
+        qsort(samples, (size_t)iterations, sizeof(double), cmp_double);
+        printf("%s\t%s\t%.1f\t%.1f\t%.1f\t%zu\n", base_name(path),
+               ALLOCATOR_MODES[mode], samples[0], samples[iterations / 2],
+               samples[iterations - 1], pdf_size);
+    }
+    fflush(stdout);
+    free(arena.base);
+    return 0;
+}
+
+/* --soak: process counters sampled every --sample-every conversions */
+typedef struct {
+    long conversions;
+    double elapsed_s;
+    double rss_kb;
+    double heap_kb;
+    double fds;
+    double tmp_files;
+    double tmp_kb;
+    double median_ms;
+    double p95_ms;
+    long failures;
+} SoakSample;
+
+typedef struct {
+    long max_conversions;   /* 0 = no limit */
+    double duration_s;      /* 0 = no limit */
+    int sample_every;
+    long warmup;
+    double rss_budget_kb;   /* per 1,000 conversions */
+    double latency_drift;   /* percent over the fitted run */
+    double rss_headroom_mb;
+    const char* tmp_dir;
+} SoakOptions;
+
+static volatile sig_atomic_t g_soak_stop;
+
+static void soak_on_signal(int sig) {
+    (void)sig;
+    g_soak_stop = 1;
+}
+
+static double resident_kb(void) {
+#ifdef __APPLE__
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  (task_info_t)&info, &count) != KERN_SUCCESS)
+        return 0;
+    return (double)info.resident_size / 1024.0;
+#else
+    FILE* f = fopen("/proc/self/statm", "r");
+    unsigned long size = 0, resident = 0;
+    if (!f) return 0;
+    int n = fscanf(f, "%lu %lu", &size, &resident);
+    fclose(f);
+    return n == 2 ? (double)resident * (double)sysconf(_SC_PAGESIZE) / 1024.0 : 0;
+#endif
+}
+
+/* Bytes the allocator has handed out and not had back: unlike RSS, this
+ * does not include freed memory the allocator keeps for reuse */
+static double heap_in_use_kb(void) {
+#ifdef __APPLE__
+    malloc_statistics_t stats;
+    malloc_zone_statistics(NULL, &stats);
+    return (double)stats.size_in_use / 1024.0;
+#elif defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return (double)(info.uordblks + info.hblkhd) / 1024.0;
+#else
+    return 0;
+#endif
+}
+
+static double open_fds(void) {
+#ifdef __APPLE__
+    DIR* dir = opendir("/dev/fd");
+#else
+    DIR* dir = opendir("/proc/self/fd");
+#endif
+    if (!dir) return 0;
+    long count = -1;  /* the directory's own descriptor */
+    while (readdir(dir)) count++;
+    closedir(dir);
+    return count > 2 ? (double)(count - 2) : 0;  /* minus . and .. */
+}
+
+/* Files and bytes below path, subdirectories included */
+static void dir_usage(const char* path, double* files, double* bytes, int depth) {
+    DIR* dir = opendir(path);
+    struct dirent* entry;
+    if (!dir) return;
+    while ((entry = readdir(dir))) {
+        char child[4096];
+        struct stat st;
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+            continue;
+        snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+        if (lstat(child, &st) != 0)
+            continue;
+        if (S_ISDIR(st.st_mode)) {
+            if (depth < 16) dir_usage(child, files, bytes, depth + 1);
+        } else {
+            *files += 1;
+            *bytes += (double)st.st_size;
+        }
+    }
+    closedir(dir);
+}
+
+/* Least-squares slope and intercept of y against conversions, over the
+ * samples from first on */
+static void fit_line(const SoakSample* samples, int first, int count,
+                     size_t field, double* slope, double* intercept) {
+    double mean_x = 0, mean_y = 0, sxx = 0, sxy = 0;
+    int n = count - first;
+    for (int i = first; i < count; i++) {
+        mean_x += (double)samples[i].conversions;
+        mean_y += *(const double*)((const char*)&samples[i] + field);
+    }
+    mean_x /= n;
+    mean_y /= n;
+    for (int i = first; i < count; i++) {
+        double dx = (double)samples[i].conversions - mean_x;
+        sxx += dx * dx;
+        sxy += dx * (*(const double*)((const char*)&samples[i] + field) - mean_y);
+    }
+    *slope = sxx > 0 ? sxy / sxx : 0;
+    *intercept = mean_y - *slope * mean_x;
+}
+
+/* Soak the inputs in rotation. Returns 0 if every budget held. */
+static int bench_soak(SlimLOHandle handle, uint8_t** data, size_t* sizes,
+                      char** paths, int count, const SoakOptions* opts) {
+    double* window = (double*)malloc(sizeof(double) * (size_t)opts->sample_every);
+    SoakSample* samples = NULL;
+    int sample_count = 0, sample_capacity = 0;
+    long conversions = 0, failures = 0;
+    int in_window = 0;
+    double start = now_ms();
+
+    if (!window) {
+        fprintf(stderr, "FAIL: [soak]: cannot allocate latency window\n");
+        return 1;
+    }
+    signal(SIGINT, soak_on_signal);
+    signal(SIGTERM, soak_on_signal);
+
+    printf("conversions\telapsed_s\trss_kb\theap_kb\tfds\ttmp_files\ttmp_kb"
+           "\tmedian_ms\tp95_ms\tfailures\n");
+    fflush(stdout);
+
+    while (!g_soak_stop &&
+           (opts->max_conversions == 0 || conversions < opts->max_conversions) &&
+           (opts->duration_s == 0 || (now_ms() - start) / 1000.0 < opts->duration_s)) {
+        int f = (int)(conversions % count);
+        uint8_t* pdf = NULL;
+        size_t pdf_size = 0;
+        double t0 = now_ms();
+        SlimLOError err = slimlo_convert_buffer(handle, data[f], sizes[f],
+                                                SLIMLO_FORMAT_DOCX, NULL, &pdf, &pdf_size);
+        window[in_window++] = now_ms() - t0;
+        slimlo_free_buffer(pdf);
+        conversions++;
+        if (err != SLIMLO_OK) {
+            failures++;
+            fprintf(stderr, "FAIL: %s [soak #%ld]: error %d: %s\n",
+                    paths[f], conversions, err, slimlo_get_error_message(handle));
+        }
+        if (in_window < opts->sample_every)
+            continue;
+
+        if (sample_count == sample_capacity) {
+            int grown = sample_capacity ? sample_capacity * 2 : 256;
+            SoakSample* more = (SoakSample*)realloc(samples, sizeof(SoakSample) * (size_t)grown);
+            if (!more) {
+                fprintf(stderr, "FAIL: [soak]: cannot allocate samples\n");
+                break;
+            }
+            samples = more;
+            sample_capacity = grown;
+        }
+        SoakSample* s = &samples[sample_count++];
+        memset(s, 0, sizeof(*s));
+        qsort(window, (size_t)in_window, sizeof(double), cmp_double);
+        s->conversions = conversions;
+        s->elapsed_s = (now_ms() - start) / 1000.0;
+        s->rss_kb = resident_kb();
+        s->heap_kb = heap_in_use_kb();
+        s->fds = open_fds();
+        dir_usage(opts->tmp_dir, &s->tmp_files, &s->tmp_kb, 0);
+        s->tmp_kb /= 1024.0;
+        s->median_ms = window[in_window / 2];
+        s->p95_ms = window[(in_window * 95) / 100 < in_window ? (in_window * 95) / 100 : in_window - 1];
+        s->failures = failures;
+        in_window = 0;
+
+        printf("%ld\t%.0f\t%.0f\t%.0f\t%.0f\t%.0f\t%.0f\t%.1f\t%.1f\t%ld\n",
+               s->conversions, s->elapsed_s, s->rss_kb, s->heap_kb, s->fds,
+               s->tmp_files, s->tmp_kb, s->median_ms, s->p95_ms, s->failures);
+        fflush(stdout);
+    }
+    free(window);
+
+    /* Fit only what follows the warm-up */
+    int first = 0;
+    while (first < sample_count && samples[first].conversions <= opts->warmup)
+        first++;
+    if (sample_count - first < 3) {
+        fprintf(stderr, "FAIL: [soak]: %d sample(s) after %ld warm-up conversions; "
+                "at least 3 are needed to fit a slope, soak longer\n",
+                sample_count - first, opts->warmup);
+        free(samples);
+        return 1;
+    }
+
+    double slope, intercept;
+    int failed = failures > 0;
+    const SoakSample* from = &samples[first];
+    const SoakSample* to = &samples[sample_count - 1];
+
+    fprintf(stderr, "soak: %ld conversions in %.0f s, fitted over conversions %ld-%ld "
+            "(%d samples)\n", conversions, to->elapsed_s, from->conversions,
+            to->conversions, sample_count - first);
+
+    fit_line(samples, first, sample_count, offsetof(SoakSample, rss_kb), &slope, &intercept);
+    double rss_per_1000 = slope * 1000.0;
+    int rss_over = rss_per_1000 > opts->rss_budget_kb;
+    fprintf(stderr, "soak: rss        %+10.1f KB / 1000 conversions (budget %.0f)%s\n",
+            rss_per_1000, opts->rss_budget_kb, rss_over ? "  FAIL" : "");
+    failed |= rss_over;
+    if (slope > 0)
+        fprintf(stderr, "soak: suggested MaxConversionsPerWorker: %.0f "
+                "(%.0f MB of RSS growth)\n",
+                opts->rss_headroom_mb * 1024.0 / slope, opts->rss_headroom_mb);
+    else
+        fprintf(stderr, "soak: suggested MaxConversionsPerWorker: 0 (no RSS growth)\n");
+
+    fit_line(samples, first, sample_count, offsetof(SoakSample, heap_kb), &slope, &intercept);
+    fprintf(stderr, "soak: heap       %+10.1f KB / 1000 conversions\n", slope * 1000.0);
+    fit_line(samples, first, sample_count, offsetof(SoakSample, fds), &slope, &intercept);
+    fprintf(stderr, "soak: fds        %+10.2f / 1000 conversions (%.0f -> %.0f)\n",
+            slope * 1000.0, from->fds, to->fds);
+    fit_line(samples, first, sample_count, offsetof(SoakSample, tmp_files), &slope, &intercept);
+    fprintf(stderr, "soak: tmp files  %+10.2f / 1000 conversions (%.0f -> %.0f in %s)\n",
+            slope * 1000.0, from->tmp_files, to->tmp_files, opts->tmp_dir);
+
+    /* Drift: rise of the fitted median latency from the first fitted sample
+     * to the last, relative to the first */
+    fit_line(samples, first, sample_count, offsetof(SoakSample, median_ms), &slope, &intercept);
+    double begin_ms = intercept + slope * (double)from->conversions;
+    double end_ms = intercept + slope * (double)to->conversions;
+    double drift = begin_ms > 0 ? (end_ms - begin_ms) / begin_ms * 100.0 : 0;
+    int drift_over = drift > opts->latency_drift;
+    fprintf(stderr, "soak: latency    %+10.1f %% (median %.1f -> %.1f ms, limit %.0f %%)%s\n",
+            drift, begin_ms, end_ms, opts->latency_drift, drift_over ? "  FAIL" : "");
+    failed |= drift_over;
+
+    if (failures > 0)
+        fprintf(stderr, "soak: %ld conversion(s) failed  FAIL\n", failures);
+    fprintf(stderr, "soak: %s\n", failed ? "FAIL" : "PASS");
+    free(samples);
+    return failed;
+}
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "Usage: %s [--resource DIR] [--iterations N] [--threads N] "
+            "[--preset none|fast|small|archival|print|all] "
+            "[--info | --first-page | --skip-field-update | --allocator | "
+            "--combine [--out-dir DIR] | "
+            "--soak [--duration SECS] [--conversions N] [--sample-every N] "
+            "[--warmup N] [--rss-budget KB] [--latency-drift PCT] "
+            "[--rss-headroom MB] [--tmp-dir DIR]] "
+            "input.docx...\n",
+            argv0);
+}
+
+int main(int argc, char** argv) {
+    const char* resource_path = "/opt/slimlo";
+    const char* preset_filter = "all";
+    int iterations = 5;
+    int threads = 0;
+    int info_mode = 0;
+    int first_page_mode = 0;
+    int field_update_mode = 0;
+    int combine_mode = 0;
+    int allocator_mode = 0;
+    int soak_mode = 0;
+    SoakOptions soak;
+    const char* out_dir = "/tmp";
+    int first_input = argc;
+
+    memset(&soak, 0, sizeof(soak));
+    soak.sample_every = 100;
+    soak.warmup = 500;
+    soak.rss_budget_kb = 2048;
+    soak.latency_drift = 10;
+    soak.rss_headroom_mb = 512;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--resource") == 0 && i + 1 < argc) {
+            resource_path = argv[++i];
+        } else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--preset") == 0 && i + 1 < argc) {
+            preset_filter = argv[++i];
+        } else if (strcmp(argv[i], "--info") == 0) {
+            info_mode = 1;
+        } else if (strcmp(argv[i], "--first-page") == 0) {
+            first_page_mode = 1;
+        } else if (strcmp(argv[i], "--skip-field-update") == 0) {
+            field_update_mode = 1;
+        } else if (strcmp(argv[i], "--combine") == 0) {
+            combine_mode = 1;
+        } else if (strcmp(argv[i], "--allocator") == 0) {
+            allocator_mode = 1;
+        } else if (strcmp(argv[i], "--out-dir") == 0 && i + 1 < argc) {
+            out_dir = argv[++i];
+        } else if (strcmp(argv[i], "--soak") == 0) {
+            soak_mode = 1;
+        } else if (strcmp(argv[i], "--duration") == 0 && i + 1 < argc) {
+            soak.duration_s = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--conversions") == 0 && i + 1 < argc) {
+            soak.max_conversions = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--sample-every") == 0 && i + 1 < argc) {
+            soak.sample_every = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            soak.warmup = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--rss-budget") == 0 && i + 1 < argc) {
+            soak.rss_budget_kb = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--latency-drift") == 0 && i + 1 < argc) {
+            soak.latency_drift = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--rss-headroom") == 0 && i + 1 < argc) {
+            soak.rss_headroom_mb = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--tmp-dir") == 0 && i + 1 < argc) {
+            soak.tmp_dir = argv[++i];
+        } else if (strncmp(argv[i], "--", 2) == 0) {
+            usage(argv[0]);
+            return 1;
+        } else {
+            first_input = i;
+            break;
+        }
+    }
+
+    if (first_input >= argc || iterations < 1 || iterations > MAX_ITERATIONS ||
+        threads < 0 || (combine_mode && argc - first_input > MAX_PARTS) ||
+        soak.sample_every < 1 || soak.max_conversions < 0 || soak.duration_s < 0 ||
+        (soak_mode && argc - first_input > MAX_PARTS)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    /* LibreOffice reads TMPDIR once at startup: point it at the soak's own
+     * directory before init */
+    char soak_tmp[] = "/tmp/slimlo_soak_XXXXXX";
+    if (soak_mode) {
+        if (soak.max_conversions == 0 && soak.duration_s == 0)
+            soak.max_conversions = 10000;
+        if (!soak.tmp_dir) {
+            if (!mkdtemp(soak_tmp)) {
+                fprintf(stderr, "FAIL: cannot create %s\n", soak_tmp);
+                return 1;
+            }
+            soak.tmp_dir = soak_tmp;
+        }
+        setenv("TMPDIR", soak.tmp_dir, 1);
+    }
+
+    fprintf(stderr, "SlimLO %s, resource %s, %d iteration(s), threads %d\n",
+            slimlo_version(), resource_path, iterations, threads);
+
+    SlimLOInitOptions init_opts;
+    memset(&init_opts, 0, sizeof(init_opts));
+    init_opts.threads = threads;
+    SlimLOHandle handle = slimlo_init_ex(resource_path, &init_opts);
+    if (!handle) {
+        fprintf(stderr, "FAIL: slimlo_init failed: %s\n",
+                slimlo_get_error_message(NULL));
+        return 1;
+    }
+
+    if (combine_mode) {
+        /* Warm-up: first load pays one-time font/filter initialization */
+        char warm_up[4096];
+        snprintf(warm_up, sizeof(warm_up), "%s/part_1.pdf", out_dir);
+        slimlo_convert_file(handle, argv[first_input], warm_up, SLIMLO_FORMAT_DOCX, NULL);
+
+        printf("packet\tmode\tmin_ms\tmedian_ms\tmax_ms\tpdf_bytes\n");
+        int failures = bench_combine(handle, argv + first_input, argc - first_input,
+                                     out_dir, iterations);
+        slimlo_destroy(handle);
+        return failures ? 1 : 0;
+    }
+
+    if (soak_mode) {
+        uint8_t* data[MAX_PARTS];
+        size_t sizes[MAX_PARTS];
+        int count = argc - first_input, failures = 0;
+        for (int f = 0; f < count; f++) {
+            data[f] = read_file(argv[first_input + f], &sizes[f]);
+            if (!data[f]) {
+                fprintf(stderr, "FAIL: cannot read %s\n", argv[first_input + f]);
+                failures++;
+            }
+        }
+        if (!failures) {
+            /* Warm-up: first load pays one-time font/filter initialization */
+            for (int f = 0; f < count; f++) {
+                uint8_t* pdf = NULL;
+                size_t pdf_size = 0;
+                if (slimlo_convert_buffer(handle, data[f], sizes[f], SLIMLO_FORMAT_DOCX,
+                                          NULL, &pdf, &pdf_size) == SLIMLO_OK)
+                    slimlo_free_buffer(pdf);
+            }
+            failures = bench_soak(handle, data, sizes, argv + first_input, count, &soak);
+        }
+        for (int f = 0; f < count; f++)
+            free(data[f]);
+        slimlo_destroy(handle);
+        return failures ? 1 : 0;
+    }
+
+    if (info_mode)
+        printf("file\tmode\tmin_ms\tmedian_ms\tmax_ms\tpages\n");
+    else if (first_page_mode || field_update_mode || allocator_mode)
+        printf("file\tmode\tmin_ms\tmedian_ms\tmax_ms\tpdf_bytes\n");
+    else
+        printf("file\tpreset\tmin_ms\tmedian_ms\tmax_ms\tpdf_bytes\n");
+
+    int failures = 0;
+    for (int f = first_input; f < argc; f++) {
+        size_t size = 0;
+        uint8_t* data = read_file(argv[f], &size);
+        if (!data) {
+            fprintf(stderr, "FAIL: cannot read %s\n", argv[f]);
+            failures++;
+            continue;
+        }
+
+        /* Warm-up: first load pays one-time font/filter initialization */
+        uint8_t* pdf = NULL;
+        size_t pdf_size = 0;
+        if (slimlo_convert_buffer(handle, data, size, SLIMLO_FORMAT_DOCX,
+                                  NULL, &pdf, &pdf_size) == SLIMLO_OK) {
+            slimlo_free_buffer(pdf);
+        }
+
+        if (allocator_mode) {
+            failures += bench_allocator(handle, argv[f], data, size, pdf_size,
+                                        iterations);
+            free(data);
+            continue;
+        }
+
+        if (info_mode) {
+            failures += bench_info(handle, argv[f], data, size, iterations);
+            free(data);
+            continue;
+        }
+
+        if (first_page_mode || field_update_mode) {
+            failures += first_page_mode
+                ? bench_toggle(handle, argv[f], data, size, iterations,
+                               FIRST_PAGE_MODES, apply_first_page)
+                : bench_toggle(handle, argv[f], data, size, iterations,
+                               FIELD_UPDATE_MODES, apply_skip_field_update);
+            free(data);
+            continue;
+        }
+
+        for (size_t p = 0; p < PRESET_COUNT; p++) {
+            if (strcmp(preset_filter, "all") != 0 &&
+                strcmp(preset_filter, PRESETS[p].name) != 0)
+                continue;
+            failures += bench_preset(handle, argv[f], data, size,
+                                     PRESETS[p].name, PRESETS[p].preset,
+                                     iterations);
+        }
+        free(data);
+    }
+
+    slimlo_destroy(handle);
+    return failures ? 1 : 0;
+}
@@ -34,6 +34,85 @@ static int check_pdf_magic(const char* path) {
     return 1;
 }
 
+typedef struct {
+    int events;
+    SlimLOProgressPhase last_phase;
+    int pages;
+    uint64_t bytes;
+} ProgressLog;
+
+static void record_progress(const SlimLOProgress* progress, void* user_data) {
+    ProgressLog* log = (ProgressLog*)user_data;
+    log->events++;
+    log->last_phase = progress->phase;
+    log->pages = progress->pages_laid_out;
+    log->bytes = progress->bytes_written;
+}
+
+typedef struct {
+    int images;
+    int page;
+    int width;
+    int height;
+    size_t size;
+} ImageLog;
+
+static void record_image(const SlimLOPageImage* image, void* user_data) {
+    ImageLog* log = (ImageLog*)user_data;
+    log->images++;
+    log->page = image->page;
+    log->width = image->width;
+    log->height = image->height;
+    log->size = image->size;
+}
+
+typedef struct {
+    int pages;
+    size_t chars;
+    int words;
+    int boxes_outside;   /* word boxes not within their page */
+} TextLog;
+
+static void record_text(const SlimLOPageText* page, void* user_data) {
+    TextLog* log = (TextLog*)user_data;
+    log->pages++;
+    log->chars += strlen(page->text);
+    log->words += page->word_count;
+    for (int i = 0; i < page->word_count; i++) {
+        const SlimLOWordBox* box = &page->words[i];
+        if (box->x < 0 || box->y < 0 || box->width < 0 || box->height <= 0 ||
+            box->x + box->width > page->size.width + 1 ||
+            box->y + box->height > page->size.height + 1 || !box->text[0])
+            log->boxes_outside++;
+    }
+}
+
+/* Caller allocator for slimlo_convert_buffer_alloc, tracking live bytes */
+typedef struct {
+    size_t live;
+    int reallocs;
+} AllocLog;
+
+static void* log_alloc(void* ctx, size_t size) {
+    void* ptr = malloc(size);
+    if (ptr) ((AllocLog*)ctx)->live += size;
+    return ptr;
+}
+
+static void* log_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size) {
+    void* grown = realloc(ptr, new_size);
+    if (grown) {
+        ((AllocLog*)ctx)->live += new_size - old_size;
+        ((AllocLog*)ctx)->reallocs++;
+    }
+    return grown;
+}
+
+static void log_free(void* ctx, void* ptr, size_t size) {
+    ((AllocLog*)ctx)->live -= size;
+    free(ptr);
+}
+
 static long file_size(const char* path) {
     FILE* f = fopen(path, "rb");
     if (!f) return -1;
@@ -66,7 +145,7 @@ int main(int argc, char** argv) {
     printf("\n");
 
     /* Initialize */
-    printf("[1/3] Initializing SlimLO...\n");
+    printf("[1/10] Initializing SlimLO...\n");
     SlimLOHandle handle = slimlo_init(resource_path);
     if (!handle) {
         fprintf(stderr, "FAIL: slimlo_init failed: %s\n",
@@ -76,7 +155,7 @@ int main(int argc, char** argv) {
     printf("  OK\n\n");
 
     /* Convert */
-    printf("[2/3] Converting docx -> PDF...\n");
+    printf("[2/10] Converting docx -> PDF...\n");
     SlimLOError err = slimlo_convert_file(
         handle, input_path, output_path,
         SLIMLO_FORMAT_DOCX, NULL
@@ -89,8 +168,108 @@ int main(int argc, char** argv) {
     }
     printf("  OK\n\n");
 
+    /* Validate progress reporting */
+    printf("[3/10] Verifying progress callback...\n");
+    ProgressLog log;
+    memset(&log, 0, sizeof(log));
+    slimlo_set_progress_callback(handle, record_progress, &log);
+    err = slimlo_convert_file(
+        handle, input_path, output_path,
+        SLIMLO_FORMAT_DOCX, NULL
+    );
+    slimlo_set_progress_callback(handle, NULL, NULL);
+    if (err != SLIMLO_OK || log.events == 0 || log.last_phase != SLIMLO_PROGRESS_DONE ||
+        log.pages <= 0 || (long)log.bytes != file_size(output_path)) {
+        fprintf(stderr, "FAIL: progress: err=%d events=%d last_phase=%d pages=%d bytes=%llu\n",
+                err, log.events, (int)log.last_phase, log.pages, (unsigned long long)log.bytes);
+        slimlo_destroy(handle);
+        return 1;
+    }
+    printf("  %d events, %d pages, %llu bytes\n\n",
+           log.events, log.pages, (unsigned long long)log.bytes);
+
+    /* Validate document info (no export) */
+    printf("[4/10] Querying document info...\n");
+    SlimLODocumentInfo info;
+    err = slimlo_document_info(handle, input_path, &info);
+    if (err != SLIMLO_OK || info.page_count != log.pages || !info.pages ||
+        info.pages[0].width <= 0 || info.pages[0].height <= 0) {
+        fprintf(stderr, "FAIL: document info: err=%d (%s) pages=%d (converted %d)\n",
+                err, slimlo_get_error_message(handle), info.page_count, log.pages);
+        slimlo_free_document_info(&info);
+        slimlo_destroy(handle);
+        return 1;
+    }
+    printf("  %d pages (first %.0fx%.0f pt), %d sections, %d images, %d fonts, %d missing\n\n",
+           info.page_count, info.pages[0].width, info.pages[0].height,
+           info.section_count, info.image_count, info.font_count, info.missing_font_count);
+    slimlo_free_document_info(&info);
+
+    /* Validate page rendering, standalone and alongside a conversion */
+    printf("[5/10] Rendering first-page thumbnail...\n");
+    SlimLOPageImage* images = NULL;
+    int image_count = 0;
+    err = slimlo_render_pages(handle, input_path, NULL, &images, &image_count);
+    if (err != SLIMLO_OK || image_count != 1 || images[0].page != 1 ||
+        images[0].width != 256 || images[0].height <= 0 || images[0].size < 8 ||
+        memcmp(images[0].data, "\x89PNG", 4) != 0) {
+        fprintf(stderr, "FAIL: render pages: err=%d (%s) images=%d\n",
+                err, slimlo_get_error_message(handle), image_count);
+        slimlo_free_page_images(images, image_count);
+        slimlo_destroy(handle);
+        return 1;
+    }
+    printf("  PNG %dx%d, %zu bytes\n", images[0].width, images[0].height, images[0].size);
+    slimlo_free_page_images(images, image_count);
+
+    SlimLORenderOptions render_opts;
+    memset(&render_opts, 0, sizeof(render_opts));
+    render_opts.format = SLIMLO_IMAGE_RGBA;
+    render_opts.width = 64;
+    render_opts.page_range = "1";
+    ImageLog image_log;
+    memset(&image_log, 0, sizeof(image_log));
+    slimlo_set_page_image_callback(handle, &render_opts, record_image, &image_log);
+    err = slimlo_convert_file(
+        handle, input_path, output_path,
+        SLIMLO_FORMAT_DOCX, NULL
+    );
+    slimlo_set_page_image_callback(handle, NULL, NULL, NULL);
+    if (err != SLIMLO_OK || image_log.images != 1 || image_log.page != 1 ||
+        image_log.width != 64 || image_log.size != (size_t)image_log.width * image_log.height * 4) {
+        fprintf(stderr, "FAIL: side-output render: err=%d images=%d %dx%d size=%zu\n",
+                err, image_log.images, image_log.width, image_log.height, image_log.size);
+        slimlo_destroy(handle);
+        return 1;
+    }
+    printf("  Side output: RGBA %dx%d during conversion\n\n", image_log.width, image_log.height);
+
+    /* Validate page text alongside a conversion */
+    printf("[6/10] Extracting page text during conversion...\n");
+    SlimLOTextOptions text_opts;
+    memset(&text_opts, 0, sizeof(text_opts));
+    text_opts.include_words = 1;
+    TextLog text_log;
+    memset(&text_log, 0, sizeof(text_log));
+    slimlo_set_page_text_callback(handle, &text_opts, record_text, &text_log);
+    err = slimlo_convert_file(
+        handle, input_path, output_path,
+        SLIMLO_FORMAT_DOCX, NULL
+    );
+    slimlo_set_page_text_callback(handle, NULL, NULL, NULL);
+    if (err != SLIMLO_OK || text_log.pages != log.pages || text_log.chars == 0 ||
+        text_log.words == 0 || text_log.boxes_outside != 0) {
+        fprintf(stderr, "FAIL: page text: err=%d (%s) pages=%d (converted %d) chars=%zu words=%d outside=%d\n",
+                err, slimlo_get_error_message(handle), text_log.pages, log.pages,
+                text_log.chars, text_log.words, text_log.boxes_outside);
+        slimlo_destroy(handle);
+        return 1;
+    }
+    printf("  %d pages, %zu bytes of text, %d word boxes\n\n",
+           text_log.pages, text_log.chars, text_log.words);
+
     /* Validate unsupported format guards */
-    printf("[3/4] Verifying unsupported formats are rejected...\n");
+    printf("[7/10] Verifying unsupported formats are rejected...\n");
     err = slimlo_convert_file(
         handle, input_path, output_path,
         SLIMLO_FORMAT_XLSX, NULL
@@ -114,8 +293,86 @@ int main(int argc, char** argv) {
     }
     printf("  OK\n\n");
 
+    /* Convert into caller memory, staged (no realloc) and grown in place */
+    printf("[8/10] Converting into a caller allocator...\n");
+    {
+        long input_size = file_size(input_path);
+        FILE* f = fopen(input_path, "rb");
+        uint8_t* input = input_size > 0 ? (uint8_t*)malloc((size_t)input_size) : NULL;
+        if (!f || !input || fread(input, 1, (size_t)input_size, f) != (size_t)input_size) {
+            fprintf(stderr, "FAIL: Cannot read input file: %s\n", input_path);
+            if (f) fclose(f);
+            free(input);
+            slimlo_destroy(handle);
+            return 1;
+        }
+        fclose(f);
+
+        for (int with_realloc = 0; with_realloc <= 1; with_realloc++) {
+            AllocLog alloc_log = {0, 0};
+            SlimLOAllocator allocator = {
+                log_alloc, with_realloc ? log_realloc : NULL, log_free, &alloc_log
+            };
+            uint8_t* pdf = NULL;
+            size_t pdf_size = 0;
+            err = slimlo_convert_buffer_alloc(handle, input, (size_t)input_size,
+                                              SLIMLO_FORMAT_DOCX, NULL, &allocator,
+                                              &pdf, &pdf_size);
+            if (err != SLIMLO_OK) {
+                fprintf(stderr, "FAIL: slimlo_convert_buffer_alloc returned %d: %s\n",
+                        err, slimlo_get_error_message(handle));
+                free(input);
+                slimlo_destroy(handle);
+                return 1;
+            }
+            if (pdf_size < 4 || memcmp(pdf, "%PDF", 4) != 0 || alloc_log.live != pdf_size ||
+                (!with_realloc && alloc_log.reallocs != 0)) {
+                fprintf(stderr, "FAIL: allocator output: %zu bytes, %zu live, %d reallocs\n",
+                        pdf_size, alloc_log.live, alloc_log.reallocs);
+                free(pdf);
+                free(input);
+                slimlo_destroy(handle);
+                return 1;
+            }
+            printf("  %s: %zu bytes, %d reallocs\n",
+                   with_realloc ? "realloc" : "staged", pdf_size, alloc_log.reallocs);
+            free(pdf);
+        }
+        free(input);
+    }
+    printf("  OK\n\n");
+
+    /* Runtime font registration: the input's directory (fonts or not) is
+     * accepted, again as a no-op, and a missing directory is reported */
+    printf("[9/10] Registering a font directory at runtime...\n");
+    {
+        char font_dir[4096];
+        snprintf(font_dir, sizeof(font_dir), "%s", input_path);
+        char* slash = strrchr(font_dir, '/');
+        if (slash) *slash = '\0';
+        else snprintf(font_dir, sizeof(font_dir), ".");
+
+        for (int pass = 0; pass < 2; pass++) {
+            err = slimlo_add_font_directory(handle, font_dir);
+            if (err != SLIMLO_OK) {
+                fprintf(stderr, "FAIL: slimlo_add_font_directory(%s) returned %d: %s\n",
+                        font_dir, err, slimlo_get_error_message(handle));
+                slimlo_destroy(handle);
+                return 1;
+            }
+        }
+        err = slimlo_add_font_directory(handle, "/nonexistent/slimlo-fonts");
+        if (err != SLIMLO_ERROR_FILE_NOT_FOUND) {
+            fprintf(stderr, "FAIL: expected FILE_NOT_FOUND for a missing font directory, got %d\n",
+                    err);
+            slimlo_destroy(handle);
+            return 1;
+        }
+    }
+    printf("  OK\n\n");
+
     /* Validate output */
-    printf("[4/4] Validating PDF output...\n");
+    printf("[10/10] Validating PDF output...\n");
     long sz = file_size(output_path);
     if (sz <= 0) {
         fprintf(stderr, "FAIL: Output file is empty or missing\n");